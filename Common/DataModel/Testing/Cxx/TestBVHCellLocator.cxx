@@ -0,0 +1,297 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the queries of vtkBVHCellLocator with brute force searches over
+// all the cells of a triangulated sphere and of a grid of voxels.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// A unit sphere made of triangles with outward normals. The triangles get
+// smaller towards the poles, which makes for an uneven distribution.
+void MakeSphere(vtkPolyData* pd, int nTheta, int nPhi)
+{
+  vtkNew<vtkPoints> pts;
+  vtkNew<vtkCellArray> tris;
+  pts->InsertNextPoint(0.0, 0.0, 1.0);
+  for (int i = 1; i < nTheta; ++i)
+  {
+    double theta = vtkMath::Pi() * i / nTheta;
+    for (int j = 0; j < nPhi; ++j)
+    {
+      double phi = 2.0 * vtkMath::Pi() * j / nPhi;
+      pts->InsertNextPoint(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+    }
+  }
+  vtkIdType south = pts->InsertNextPoint(0.0, 0.0, -1.0);
+
+  auto id = [nPhi](int i, int j) { return 1 + (i - 1) * nPhi + (j % nPhi); };
+  for (int j = 0; j < nPhi; ++j)
+  {
+    vtkIdType top[3] = { 0, id(1, j), id(1, j + 1) };
+    tris->InsertNextCell(3, top);
+    for (int i = 1; i < nTheta - 1; ++i)
+    {
+      vtkIdType t0[3] = { id(i, j), id(i + 1, j), id(i + 1, j + 1) };
+      vtkIdType t1[3] = { id(i, j), id(i + 1, j + 1), id(i, j + 1) };
+      tris->InsertNextCell(3, t0);
+      tris->InsertNextCell(3, t1);
+    }
+    vtkIdType bottom[3] = { id(nTheta - 1, j), south, id(nTheta - 1, j + 1) };
+    tris->InsertNextCell(3, bottom);
+  }
+  pd->SetPoints(pts);
+  pd->SetPolys(tris);
+}
+
+void RandomPoint(double x[3], double lo, double hi)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = vtkMath::Random(lo, hi);
+  }
+}
+
+double BruteForceDistance2(vtkDataSet* ds, const double x[3])
+{
+  vtkNew<vtkGenericCell> cell;
+  double closest[3], pcoords[3], weights[8], dist2, minDist2 = VTK_DOUBLE_MAX;
+  int subId;
+  for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+  {
+    ds->GetCell(cellId, cell);
+    cell->EvaluatePosition(const_cast<double*>(x), closest, subId, pcoords, dist2, weights);
+    minDist2 = std::min(minDist2, dist2);
+  }
+  return minDist2;
+}
+
+// Parametric coordinates of the intersections, merging the hits on shared
+// edges and vertices.
+std::vector<double> BruteForceIntersections(
+  vtkDataSet* ds, const double p1[3], const double p2[3], double tol)
+{
+  std::vector<double> hits;
+  vtkNew<vtkGenericCell> cell;
+  double t, x[3], pcoords[3];
+  int subId;
+  for (vtkIdType cellId = 0; cellId < ds->GetNumberOfCells(); ++cellId)
+  {
+    ds->GetCell(cellId, cell);
+    if (cell->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId))
+    {
+      hits.push_back(t);
+    }
+  }
+  std::sort(hits.begin(), hits.end());
+  hits.erase(std::unique(hits.begin(), hits.end(),
+               [](double a, double b) { return b - a < 1.0e-6; }),
+    hits.end());
+  return hits;
+}
+
+int TestSurface()
+{
+  int errors = 0;
+  const double eps = 1.0e-10;
+
+  vtkNew<vtkPolyData> sphere;
+  MakeSphere(sphere, 40, 60);
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(sphere);
+  locator->BuildLocator();
+  if (locator->GetNumberOfNodes() < 2 || locator->GetDepth() < 1)
+  {
+    cerr << "The hierarchy was not built" << endl;
+    return 1;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  double x[3], p1[3], p2[3], closest[3], pcoords[3], d2, t;
+  vtkIdType cellId;
+  int subId, inside;
+  vtkMath::RandomSeed(4242);
+
+  // Closest point and closest point within a radius
+  for (int i = 0; i < 300; ++i)
+  {
+    RandomPoint(x, -1.5, 1.5);
+    double expected = BruteForceDistance2(sphere, x);
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, d2);
+    if (std::abs(d2 - expected) > eps ||
+      std::abs(vtkMath::Distance2BetweenPoints(x, closest) - d2) > eps)
+    {
+      cerr << "FindClosestPoint mismatch: " << d2 << " vs " << expected << endl;
+      ++errors;
+    }
+    double radius = 0.2;
+    vtkIdType found = locator->FindClosestPointWithinRadius(
+      x, radius, closest, cell, cellId, subId, d2, inside);
+    if ((found != 0) != (expected <= radius * radius) ||
+      (found && std::abs(d2 - expected) > eps))
+    {
+      cerr << "FindClosestPointWithinRadius mismatch" << endl;
+      ++errors;
+    }
+  }
+
+  // First and all intersections along lines
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdList> cellIds;
+  const double tol = locator->GetTolerance();
+  for (int i = 0; i < 200; ++i)
+  {
+    RandomPoint(p1, -2.0, 2.0);
+    RandomPoint(p2, -2.0, 2.0);
+    std::vector<double> expected = BruteForceIntersections(sphere, p1, p2, 0.0);
+    int hit = locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell);
+    if ((hit != 0) != !expected.empty() ||
+      (hit && (std::abs(t - expected[0]) > 1.0e-6 || cell->GetNumberOfPoints() != 3)))
+    {
+      cerr << "IntersectWithLine mismatch for line " << i << endl;
+      ++errors;
+    }
+
+    expected = BruteForceIntersections(sphere, p1, p2, tol);
+    int ret = locator->IntersectWithLine(p1, p2, points, cellIds);
+    double len = sqrt(vtkMath::Distance2BetweenPoints(p1, p2));
+    std::vector<double> actual;
+    for (vtkIdType j = 0; j < points->GetNumberOfPoints(); ++j)
+    {
+      double tj = sqrt(vtkMath::Distance2BetweenPoints(p1, points->GetPoint(j))) / len;
+      if (actual.empty() || tj - actual.back() >= 1.0e-6)
+      {
+        actual.push_back(tj);
+      }
+    }
+    bool same = ((ret != 0) == !expected.empty()) && actual.size() == expected.size() &&
+      points->GetNumberOfPoints() == cellIds->GetNumberOfIds();
+    for (size_t j = 0; same && j < actual.size(); ++j)
+    {
+      same = std::abs(actual[j] - expected[j]) < 1.0e-6;
+    }
+    if (!same)
+    {
+      cerr << "IntersectWithLine (all hits) mismatch for line " << i << endl;
+      ++errors;
+    }
+  }
+
+  // Starting inside the sphere
+  double center[3] = { 0.01, 0.02, 0.03 };
+  double outside[3] = { 2.9, 0.37, 0.21 };
+  if (locator->IntersectWithLine(center, outside, points, nullptr) != -1 ||
+    locator->IntersectWithLine(outside, center, nullptr, cellIds) != 1)
+  {
+    cerr << "Wrong inside/outside classification of the line start" << endl;
+    ++errors;
+  }
+
+  // Cells within bounds
+  double bbox[6] = { 0.2, 0.8, -0.3, 0.4, 0.1, 1.1 };
+  vtkNew<vtkIdList> cells;
+  locator->FindCellsWithinBounds(bbox, cells);
+  vtkIdType expectedCount = 0;
+  for (vtkIdType id = 0; id < sphere->GetNumberOfCells(); ++id)
+  {
+    double b[6];
+    sphere->GetCellBounds(id, b);
+    if (b[0] <= bbox[1] && b[1] >= bbox[0] && b[2] <= bbox[3] && b[3] >= bbox[2] &&
+      b[4] <= bbox[5] && b[5] >= bbox[4])
+    {
+      ++expectedCount;
+    }
+  }
+  if (cells->GetNumberOfIds() != expectedCount)
+  {
+    cerr << "FindCellsWithinBounds found " << cells->GetNumberOfIds() << " cells instead of "
+         << expectedCount << endl;
+    ++errors;
+  }
+
+  // Representation of the leaves
+  vtkNew<vtkPolyData> rep;
+  locator->GenerateRepresentation(-1, rep);
+  if (rep->GetNumberOfPolys() < 6 * 2)
+  {
+    cerr << "GenerateRepresentation produced " << rep->GetNumberOfPolys() << " faces" << endl;
+    ++errors;
+  }
+
+  return errors;
+}
+
+int TestVolume()
+{
+  int errors = 0;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(23, 19, 11);
+  image->SetSpacing(0.1, 0.125, 0.2);
+
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(image);
+  locator->SetNumberOfBins(8);
+  locator->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  double x[3], pcoords[3], weights[8], closest[3], dist2;
+  vtkIdType cellId;
+  int subId;
+  vtkMath::RandomSeed(1234);
+  for (int i = 0; i < 500; ++i)
+  {
+    RandomPoint(x, -0.5, 2.5);
+    vtkIdType expected = image->FindCell(x, nullptr, 0, 0.0, subId, pcoords, weights);
+    vtkIdType found = locator->FindCell(x, 0.0, cell, pcoords, weights);
+    // points on the faces between voxels may be attributed to either voxel
+    if (found != expected && (found < 0 || expected < 0))
+    {
+      cerr << "FindCell mismatch: " << found << " vs " << expected << endl;
+      ++errors;
+    }
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    if (std::abs(dist2 - BruteForceDistance2(image, x)) > 1.0e-10)
+    {
+      cerr << "FindClosestPoint mismatch in the volume" << endl;
+      ++errors;
+    }
+  }
+
+  return errors;
+}
+
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  int errors = TestSurface();
+  errors += TestVolume();
+  return errors;
+}
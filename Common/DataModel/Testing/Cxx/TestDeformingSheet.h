@@ -0,0 +1,87 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDeformingSheet.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by the locator update test and timing driver: a wavy
+// triangulated sheet, and small deformations of it.
+
+#ifndef TestDeformingSheet_h
+#define TestDeformingSheet_h
+
+#include "vtkCellArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// A wavy triangulated dim x dim sheet. The boundary points never move, so
+// that the bounds of the surface do not change.
+void MakeSheet(vtkPolyData* pd, std::vector<double>& rest, int dim)
+{
+  vtkNew<vtkPoints> pts;
+  pts->SetDataTypeToDouble();
+  vtkNew<vtkCellArray> tris;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      double x = static_cast<double>(i) / (dim - 1);
+      double y = static_cast<double>(j) / (dim - 1);
+      pts->InsertNextPoint(x, y, 0.1 * std::sin(6.0 * x) * std::cos(4.0 * y));
+    }
+  }
+  for (int j = 0; j < dim - 1; ++j)
+  {
+    for (int i = 0; i < dim - 1; ++i)
+    {
+      vtkIdType p0 = i + j * dim;
+      vtkIdType t0[3] = { p0, p0 + 1, p0 + dim + 1 };
+      vtkIdType t1[3] = { p0, p0 + dim + 1, p0 + dim };
+      tris->InsertNextCell(3, t0);
+      tris->InsertNextCell(3, t1);
+    }
+  }
+  pd->SetPoints(pts);
+  pd->SetPolys(tris);
+  double* x = static_cast<double*>(pts->GetVoidPointer(0));
+  rest.assign(x, x + 3 * pts->GetNumberOfPoints());
+}
+
+// Small displacements of the interior points, within the sheet's bounds.
+void Deform(vtkPolyData* pd, const std::vector<double>& rest, int dim, int step)
+{
+  vtkPoints* pts = pd->GetPoints();
+  double* x = static_cast<double*>(pts->GetVoidPointer(0));
+  const double amplitude = 0.4 / (dim - 1);
+  for (int j = 1; j < dim - 1; ++j)
+  {
+    for (int i = 1; i < dim - 1; ++i)
+    {
+      vtkIdType id = i + j * dim;
+      double phase = 0.05 * step + 0.3 * i + 0.2 * j;
+      x[3 * id] = rest[3 * id] + amplitude * std::sin(phase);
+      x[3 * id + 1] = rest[3 * id + 1] + amplitude * std::cos(1.3 * phase);
+      x[3 * id + 2] = rest[3 * id + 2] * std::cos(0.01 * step);
+    }
+  }
+  pts->Modified();
+}
+
+}
+
+#endif
@@ -0,0 +1,288 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorBatchQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batched queries of the point and cell locators give the
+// same answers as the corresponding single queries, and that the base class
+// issues them one after the other.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticKdTreePointLocator.h"
+#include "vtkStaticPointLocator.h"
+
+#include <atomic>
+#include <cmath>
+
+namespace
+{
+
+// A locator whose single queries share scratch state, as locators outside
+// VTK may do. It forwards them to a vtkStaticCellLocator through its own
+// generic cell, and counts the queries which overlap another one.
+class vtkSharedScratchLocator : public vtkAbstractCellLocator
+{
+public:
+  static vtkSharedScratchLocator* New();
+  vtkTypeMacro(vtkSharedScratchLocator, vtkAbstractCellLocator);
+
+  using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::IntersectWithLine;
+
+  vtkIdType FindCell(double x[3], double tol2, vtkGenericCell*, double pcoords[3],
+    double* weights) override
+  {
+    this->Enter();
+    vtkIdType cellId = this->Locator->FindCell(x, tol2, this->GenericCell, pcoords, weights);
+    --this->Queries;
+    return cellId;
+  }
+
+  void FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell*,
+    vtkIdType& cellId, int& subId, double& dist2) override
+  {
+    this->Enter();
+    this->Locator->FindClosestPoint(x, closestPoint, this->GenericCell, cellId, subId, dist2);
+    --this->Queries;
+  }
+
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t,
+    double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell*) override
+  {
+    this->Enter();
+    int hit = this->Locator->IntersectWithLine(
+      p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
+    --this->Queries;
+    return hit;
+  }
+
+  void BuildLocator() override
+  {
+    this->Locator->SetDataSet(this->DataSet);
+    this->Locator->BuildLocator();
+  }
+  void FreeSearchStructure() override { this->Locator->FreeSearchStructure(); }
+  void GenerateRepresentation(int, vtkPolyData*) override {}
+
+  std::atomic<int> Overlaps;
+
+protected:
+  vtkSharedScratchLocator()
+    : Overlaps(0)
+    , Queries(0)
+  {
+  }
+  ~vtkSharedScratchLocator() override {}
+
+  void Enter()
+  {
+    if (this->Queries++ > 0)
+    {
+      ++this->Overlaps;
+    }
+  }
+
+  vtkNew<vtkStaticCellLocator> Locator;
+  std::atomic<int> Queries;
+
+private:
+  vtkSharedScratchLocator(const vtkSharedScratchLocator&) = delete;
+  void operator=(const vtkSharedScratchLocator&) = delete;
+};
+
+vtkStandardNewMacro(vtkSharedScratchLocator);
+
+void MakeQueryPoints(vtkPoints* pts, vtkIdType numPts, double lo, double hi, int seed)
+{
+  vtkMath::RandomSeed(seed);
+  pts->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    pts->SetPoint(i, vtkMath::Random(lo, hi), vtkMath::Random(lo, hi),
+      vtkMath::Random(lo, hi));
+  }
+}
+
+int TestPointLocator(vtkAbstractPointLocator* locator, vtkPoints* query)
+{
+  vtkNew<vtkIdList> ids;
+  locator->FindClosestPoints(query, ids);
+  if (ids->GetNumberOfIds() != query->GetNumberOfPoints())
+  {
+    cerr << locator->GetClassName() << ": wrong number of results" << endl;
+    return 1;
+  }
+
+  int errors = 0;
+  double x[3];
+  for (vtkIdType i = 0; i < query->GetNumberOfPoints(); ++i)
+  {
+    query->GetPoint(i, x);
+    vtkIdType id = locator->FindClosestPoint(x);
+    if (id != ids->GetId(i) &&
+      vtkMath::Distance2BetweenPoints(x, locator->GetDataSet()->GetPoint(id)) !=
+        vtkMath::Distance2BetweenPoints(x, locator->GetDataSet()->GetPoint(ids->GetId(i))))
+    {
+      ++errors;
+    }
+  }
+  if (errors)
+  {
+    cerr << locator->GetClassName() << ": " << errors
+         << " FindClosestPoints mismatches" << endl;
+  }
+  return errors;
+}
+
+int TestCellLocator(vtkAbstractCellLocator* locator, vtkPoints* query,
+  vtkPoints* starts, vtkPoints* ends)
+{
+  int errors = 0;
+  vtkNew<vtkGenericCell> cell;
+  double x[3], pcoords[3], weights[8], closest[3], dist2;
+  vtkIdType cellId;
+  int subId;
+
+  vtkNew<vtkIdList> cellIds;
+  locator->FindCells(query, cellIds);
+  for (vtkIdType i = 0; i < query->GetNumberOfPoints(); ++i)
+  {
+    query->GetPoint(i, x);
+    if (cellIds->GetId(i) != locator->FindCell(x, 0.0, cell, pcoords, weights))
+    {
+      ++errors;
+    }
+  }
+
+  vtkNew<vtkPoints> closestPoints;
+  closestPoints->SetDataTypeToDouble();
+  locator->FindClosestPoints(query, closestPoints, cellIds);
+  for (vtkIdType i = 0; i < query->GetNumberOfPoints(); ++i)
+  {
+    query->GetPoint(i, x);
+    locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    if (std::abs(vtkMath::Distance2BetweenPoints(x, closestPoints->GetPoint(i)) - dist2) >
+      1.0e-10)
+    {
+      ++errors;
+    }
+  }
+
+  vtkNew<vtkPoints> hits;
+  hits->SetDataTypeToDouble();
+  double tol = 1.0e-8, p1[3], p2[3], t;
+  locator->IntersectWithLines(starts, ends, tol, hits, cellIds);
+  for (vtkIdType i = 0; i < starts->GetNumberOfPoints(); ++i)
+  {
+    starts->GetPoint(i, p1);
+    ends->GetPoint(i, p2);
+    cellId = -1;
+    if (!locator->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell))
+    {
+      cellId = -1;
+      x[0] = p2[0];
+      x[1] = p2[1];
+      x[2] = p2[2];
+    }
+    if (cellId != cellIds->GetId(i) ||
+      vtkMath::Distance2BetweenPoints(x, hits->GetPoint(i)) > 1.0e-12)
+    {
+      ++errors;
+    }
+  }
+
+  if (errors)
+  {
+    cerr << locator->GetClassName() << ": " << errors << " batched query mismatches" << endl;
+  }
+  return errors;
+}
+
+}
+
+int TestLocatorBatchQueries(int, char*[])
+{
+  int errors = 0;
+
+  // A grid of voxels; most of the query points fall inside.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 17, 13);
+  image->SetSpacing(0.1, 0.125, 0.1667);
+  vtkNew<vtkPoints> query;
+  MakeQueryPoints(query, 1000, -0.5, 2.5, 314159);
+
+  // The point locators need explicit points.
+  vtkNew<vtkPoints> cloudPoints;
+  MakeQueryPoints(cloudPoints, 5000, 0.0, 2.0, 8675309);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(cloudPoints);
+
+  // The static locators issue the queries in parallel, the others serially.
+  vtkSmartPointer<vtkAbstractPointLocator> pointLocators[4] = {
+    vtkSmartPointer<vtkPointLocator>::New(), vtkSmartPointer<vtkStaticPointLocator>::New(),
+    vtkSmartPointer<vtkKdTreePointLocator>::New(),
+    vtkSmartPointer<vtkStaticKdTreePointLocator>::New()
+  };
+  for (int i = 0; i < 4; ++i)
+  {
+    pointLocators[i]->SetDataSet(cloud);
+    errors += TestPointLocator(pointLocators[i], query);
+  }
+
+  vtkNew<vtkPoints> starts;
+  vtkNew<vtkPoints> ends;
+  MakeQueryPoints(starts, 200, -1.0, 3.0, 271828);
+  MakeQueryPoints(ends, 200, -0.5, 2.0, 161803);
+
+  // These cell locators issue the queries in parallel.
+  vtkSmartPointer<vtkAbstractCellLocator> cellLocators[3] = {
+    vtkSmartPointer<vtkCellLocator>::New(), vtkSmartPointer<vtkStaticCellLocator>::New(),
+    vtkSmartPointer<vtkBVHCellLocator>::New()
+  };
+  for (int i = 0; i < 3; ++i)
+  {
+    cellLocators[i]->SetDataSet(image);
+    errors += TestCellLocator(cellLocators[i], query, starts, ends);
+  }
+
+  // A lazily built locator is built by the batched queries.
+  vtkNew<vtkCellLocator> lazy;
+  lazy->LazyEvaluationOn();
+  lazy->SetDataSet(image);
+  errors += TestCellLocator(lazy, query, starts, ends);
+
+  // The base class issues the queries of other locators serially.
+  vtkNew<vtkSharedScratchLocator> shared;
+  shared->SetDataSet(image);
+  errors += TestCellLocator(shared, query, starts, ends);
+  if (shared->Overlaps > 0)
+  {
+    cerr << "vtkAbstractCellLocator: " << shared->Overlaps << " overlapping queries" << endl;
+    ++errors;
+  }
+
+  return errors;
+}
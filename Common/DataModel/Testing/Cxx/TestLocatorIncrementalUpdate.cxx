@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorIncrementalUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Deform a surface over 1000 small steps and check that the incrementally
+// updated locators answer like freshly built ones.
+
+#include "TestDeformingSheet.h"
+
+#include "vtkBVHCellLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+const int Dim = 40;
+
+int CompareLocators(vtkPolyData* pd, vtkStaticPointLocator* pointLocator,
+  vtkAbstractCellLocator* cellLocator, vtkAbstractCellLocator* fresh, int step)
+{
+  int errors = 0;
+  vtkNew<vtkStaticPointLocator> freshPoints;
+  freshPoints->SetDataSet(pd);
+  fresh->SetDataSet(pd);
+  fresh->BuildLocator();
+
+  vtkNew<vtkGenericCell> cell;
+  double x[3], closest[3], dist2, freshDist2, t, pcoords[3], hit[3];
+  vtkIdType cellId;
+  int subId;
+  for (int i = 0; i < 50; ++i)
+  {
+    x[0] = vtkMath::Random(0.0, 1.0);
+    x[1] = vtkMath::Random(0.0, 1.0);
+    x[2] = vtkMath::Random(-0.2, 0.2);
+
+    vtkIdType id = pointLocator->FindClosestPoint(x);
+    vtkIdType freshId = freshPoints->FindClosestPoint(x);
+    if (vtkMath::Distance2BetweenPoints(x, pd->GetPoint(id)) !=
+      vtkMath::Distance2BetweenPoints(x, pd->GetPoint(freshId)))
+    {
+      cerr << "Step " << step << ": wrong closest point" << endl;
+      ++errors;
+    }
+
+    cellLocator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    fresh->FindClosestPoint(x, closest, cell, cellId, subId, freshDist2);
+    if (std::abs(dist2 - freshDist2) > 1.0e-12)
+    {
+      cerr << "Step " << step << ": " << cellLocator->GetClassName()
+           << " wrong closest point on the surface" << endl;
+      ++errors;
+    }
+
+    double p1[3] = { x[0], x[1], 1.0 };
+    double p2[3] = { x[0], x[1], -1.0 };
+    int found = cellLocator->IntersectWithLine(p1, p2, 0.0, t, hit, pcoords, subId, cellId, cell);
+    double freshT;
+    int freshFound =
+      fresh->IntersectWithLine(p1, p2, 0.0, freshT, hit, pcoords, subId, cellId, cell);
+    if (found != freshFound || (found && std::abs(t - freshT) > 1.0e-9))
+    {
+      cerr << "Step " << step << ": " << cellLocator->GetClassName()
+           << " wrong line intersection" << endl;
+      ++errors;
+    }
+  }
+  return errors;
+}
+
+}
+
+int TestLocatorIncrementalUpdate(int, char*[])
+{
+  int errors = 0;
+  const int numSteps = 1000;
+
+  vtkNew<vtkPolyData> sheet;
+  std::vector<double> rest;
+  MakeSheet(sheet, rest, Dim);
+
+  vtkNew<vtkStaticPointLocator> pointLocator;
+  vtkNew<vtkStaticCellLocator> cellLocator;
+  vtkNew<vtkBVHCellLocator> bvhLocator;
+  pointLocator->IncrementalUpdateOn();
+  cellLocator->IncrementalUpdateOn();
+  bvhLocator->IncrementalUpdateOn();
+  pointLocator->SetDataSet(sheet);
+  cellLocator->SetDataSet(sheet);
+  bvhLocator->SetDataSet(sheet);
+
+  vtkMath::RandomSeed(2718);
+  for (int step = 0; step < numSteps; ++step)
+  {
+    Deform(sheet, rest, Dim, step);
+    pointLocator->BuildLocator();
+    cellLocator->BuildLocator();
+    bvhLocator->BuildLocator();
+    if (step % 100 == 99)
+    {
+      vtkNew<vtkStaticCellLocator> freshStatic;
+      errors += CompareLocators(sheet, pointLocator, cellLocator, freshStatic, step);
+      vtkNew<vtkBVHCellLocator> freshBVH;
+      errors += CompareLocators(sheet, pointLocator, bvhLocator, freshBVH, step);
+    }
+  }
+
+  return errors;
+}
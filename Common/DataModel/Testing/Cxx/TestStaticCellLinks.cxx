@@ -15,6 +15,8 @@
 #include "vtkStaticCellLinks.h"
 #include "vtkStaticCellLinksTemplate.h"
 #include "vtkSmartPointer.h"
+#include "vtkCellArray.h"
+#include "vtkCellLinks.h"
 #include "vtkImageData.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkPolyData.h"
@@ -23,6 +25,49 @@
 #include "vtkSphereSource.h"
 #include "vtkTimerLog.h"
 
+namespace {
+
+// Compare the static links of a polydata with its editable links, which are
+// built serially by vtkCellLinks.
+int ComparePolyDataLinks(vtkPolyData *pd)
+{
+  vtkSmartPointer<vtkPolyData> editable =
+    vtkSmartPointer<vtkPolyData>::New();
+  editable->DeepCopy(pd);
+  editable->EditableOn();
+  editable->BuildLinks();
+  if ( vtkCellLinks::SafeDownCast(editable->GetCellLinks()) == nullptr ||
+       vtkStaticCellLinks::SafeDownCast(pd->GetCellLinks()) == nullptr )
+  {
+    cout << "Wrong type of links\n";
+    return 1;
+  }
+
+  unsigned short n1, n2;
+  vtkIdType *cells1, *cells2;
+  for (vtkIdType ptId=0; ptId < pd->GetNumberOfPoints(); ++ptId)
+  {
+    pd->GetPointCells(ptId, n1, cells1);
+    editable->GetPointCells(ptId, n2, cells2);
+    if ( n1 != n2 )
+    {
+      cout << "Wrong number of cells using point " << ptId << "\n";
+      return 1;
+    }
+    for (unsigned short i=0; i < n1; ++i)
+    {
+      if ( cells1[i] != cells2[i] )
+      {
+        cout << "Wrong cells using point " << ptId << "\n";
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+}
+
 // Test the building of static cell links in both unstructured and structured
 // grids.
 int TestStaticCellLinks( int, char *[] )
@@ -191,5 +236,91 @@ int TestStaticCellLinks( int, char *[] )
     return EXIT_FAILURE;
   }
 
+  //----------------------------------------------------------------------------
+  // Polydata with static links, mixing the four types of cells
+  vtkSmartPointer<vtkPolyData> mixed =
+    vtkSmartPointer<vtkPolyData>::New();
+  mixed->DeepCopy(pdata);
+  vtkIdType numPts = mixed->GetNumberOfPoints();
+  vtkSmartPointer<vtkCellArray> verts =
+    vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkCellArray> lines =
+    vtkSmartPointer<vtkCellArray>::New();
+  vtkSmartPointer<vtkCellArray> strips =
+    vtkSmartPointer<vtkCellArray>::New();
+  for (vtkIdType i=0; i < numPts; i+=3)
+  {
+    verts->InsertNextCell(1, &i);
+    vtkIdType line[3] = {i, (i+5)%numPts, (i+11)%numPts};
+    lines->InsertNextCell(3, line);
+    vtkIdType strip[4] = {i, (i+1)%numPts, (i+7)%numPts, (i+8)%numPts};
+    strips->InsertNextCell(4, strip);
+  }
+  mixed->SetVerts(verts);
+  mixed->SetLines(lines);
+  mixed->SetStrips(strips);
+  mixed->DeleteCells();
+  mixed->EditableOff();
+  mixed->BuildLinks();
+  cout << "\nPolydata with static links:\n";
+  if ( ComparePolyDataLinks(mixed) )
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The links are reused as long as the cells are not modified, and are
+  // shared with shallow copies.
+  vtkAbstractCellLinks *links = mixed->GetCellLinks();
+  mixed->BuildLinks();
+  vtkSmartPointer<vtkPolyData> copy =
+    vtkSmartPointer<vtkPolyData>::New();
+  copy->ShallowCopy(mixed);
+  copy->BuildLinks();
+  if ( mixed->GetCellLinks() != links || copy->GetCellLinks() != links )
+  {
+    cout << "   Static links were rebuilt\n";
+    return EXIT_FAILURE;
+  }
+  // Replacing a cell releases the links, which are then rebuilt; the copy
+  // keeps the old ones.
+  vtkIdType polyId = mixed->GetNumberOfVerts() + mixed->GetNumberOfLines();
+  vtkIdType tri[3] = {0, 1, 2};
+  mixed->ReplaceCell(polyId, 3, tri);
+  mixed->BuildLinks();
+  if ( mixed->GetCellLinks() == links || copy->GetCellLinks() != links ||
+       ComparePolyDataLinks(mixed) )
+  {
+    cout << "   Static links were not updated\n";
+    return EXIT_FAILURE;
+  }
+  cout << "   Reuse and update: OK\n";
+
+  // The editing methods turn static links into editable ones.
+  vtkSmartPointer<vtkPolyData> edited =
+    vtkSmartPointer<vtkPolyData>::New();
+  edited->DeepCopy(mixed);
+  edited->RemoveCellReference(polyId);
+  if ( !edited->GetEditable() ||
+       vtkCellLinks::SafeDownCast(edited->GetCellLinks()) == nullptr )
+  {
+    cout << "   Static links were edited\n";
+    return EXIT_FAILURE;
+  }
+  unsigned short numEdited;
+  vtkIdType *editedCells;
+  for (int i=0; i < 3; ++i)
+  {
+    edited->GetPointCells(tri[i], numEdited, editedCells);
+    for (unsigned short j=0; j < numEdited; ++j)
+    {
+      if ( editedCells[j] == polyId )
+      {
+        cout << "   Cell reference was not removed\n";
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  cout << "   Editing: OK\n";
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,261 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticCellLocatorQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the closest point and line intersection queries of
+// vtkStaticCellLocator with a brute force search over all the cells, both
+// serially and from concurrent vtkSMPTools workers.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticCellLocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// A unit sphere made of triangles with outward normals.
+void MakeSphere(vtkPolyData* pd, int nTheta, int nPhi)
+{
+  vtkNew<vtkPoints> pts;
+  vtkNew<vtkCellArray> tris;
+  pts->InsertNextPoint(0.0, 0.0, 1.0);
+  for (int i = 1; i < nTheta; ++i)
+  {
+    double theta = vtkMath::Pi() * i / nTheta;
+    for (int j = 0; j < nPhi; ++j)
+    {
+      double phi = 2.0 * vtkMath::Pi() * j / nPhi;
+      pts->InsertNextPoint(sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta));
+    }
+  }
+  vtkIdType south = pts->InsertNextPoint(0.0, 0.0, -1.0);
+
+  auto id = [nPhi](int i, int j) { return 1 + (i - 1) * nPhi + (j % nPhi); };
+  for (int j = 0; j < nPhi; ++j)
+  {
+    vtkIdType top[3] = { 0, id(1, j), id(1, j + 1) };
+    tris->InsertNextCell(3, top);
+    for (int i = 1; i < nTheta - 1; ++i)
+    {
+      vtkIdType t0[3] = { id(i, j), id(i + 1, j), id(i + 1, j + 1) };
+      vtkIdType t1[3] = { id(i, j), id(i + 1, j + 1), id(i, j + 1) };
+      tris->InsertNextCell(3, t0);
+      tris->InsertNextCell(3, t1);
+    }
+    vtkIdType bottom[3] = { id(nTheta - 1, j), south, id(nTheta - 1, j + 1) };
+    tris->InsertNextCell(3, bottom);
+  }
+  pd->SetPoints(pts);
+  pd->SetPolys(tris);
+}
+
+double BruteForceDistance2(vtkPolyData* pd, const double x[3])
+{
+  vtkNew<vtkGenericCell> cell;
+  double closest[3], pcoords[3], weights[3], dist2, minDist2 = VTK_DOUBLE_MAX;
+  int subId;
+  for (vtkIdType cellId = 0; cellId < pd->GetNumberOfCells(); ++cellId)
+  {
+    pd->GetCell(cellId, cell);
+    cell->EvaluatePosition(const_cast<double*>(x), closest, subId, pcoords, dist2, weights);
+    minDist2 = std::min(minDist2, dist2);
+  }
+  return minDist2;
+}
+
+// Parametric coordinates of the intersections, merging the hits on shared
+// edges and vertices.
+std::vector<double> BruteForceIntersections(
+  vtkPolyData* pd, const double p1[3], const double p2[3], double tol)
+{
+  std::vector<double> hits;
+  vtkNew<vtkGenericCell> cell;
+  double t, x[3], pcoords[3];
+  int subId;
+  for (vtkIdType cellId = 0; cellId < pd->GetNumberOfCells(); ++cellId)
+  {
+    pd->GetCell(cellId, cell);
+    if (cell->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId))
+    {
+      hits.push_back(t);
+    }
+  }
+  std::sort(hits.begin(), hits.end());
+  hits.erase(std::unique(hits.begin(), hits.end(),
+               [](double a, double b) { return b - a < 1.0e-6; }),
+    hits.end());
+  return hits;
+}
+
+void QueryPoint(vtkIdType i, double x[3])
+{
+  x[0] = -1.7 + 0.113 * (i % 31);
+  x[1] = -1.6 + 0.127 * ((i / 31) % 29);
+  x[2] = -1.5 + 0.371 * (i % 9);
+}
+
+// Closest point queries issued concurrently, one vtkGenericCell per thread.
+struct ClosestPointWorker
+{
+  vtkStaticCellLocator* Locator;
+  std::vector<double>* Dist2;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double x[3], closest[3], dist2;
+    vtkIdType cellId;
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      QueryPoint(i, x);
+      this->Locator->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+      (*this->Dist2)[i] = dist2;
+    }
+  }
+
+  void Reduce() {}
+};
+
+}
+
+int TestStaticCellLocatorQueries(int, char*[])
+{
+  int errors = 0;
+  const double eps = 1.0e-10;
+
+  vtkNew<vtkPolyData> sphere;
+  MakeSphere(sphere, 12, 24);
+
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(sphere);
+  locator->SetNumberOfCellsPerNode(4);
+  locator->BuildLocator();
+
+  // Closest point, serially and concurrently
+  const vtkIdType numQueries = 500;
+  std::vector<double> dist2(numQueries);
+  ClosestPointWorker worker;
+  worker.Locator = locator;
+  worker.Dist2 = &dist2;
+  vtkSMPTools::For(0, numQueries, worker);
+
+  vtkNew<vtkGenericCell> cell;
+  double x[3], closest[3], d2;
+  vtkIdType cellId;
+  int subId, inside;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    QueryPoint(i, x);
+    double expected = BruteForceDistance2(sphere, x);
+    locator->FindClosestPoint(x, closest, cellId, subId, d2);
+    if (std::abs(d2 - expected) > eps || std::abs(dist2[i] - expected) > eps ||
+      std::abs(vtkMath::Distance2BetweenPoints(x, closest) - d2) > eps)
+    {
+      cerr << "FindClosestPoint mismatch at query " << i << ": " << d2 << ", "
+           << dist2[i] << " vs " << expected << endl;
+      ++errors;
+    }
+
+    // Within radius: found if and only if the closest cell is close enough
+    double radius = 0.25;
+    vtkIdType found = locator->FindClosestPointWithinRadius(
+      x, radius, closest, cell, cellId, subId, d2, inside);
+    if ((found != 0) != (expected <= radius * radius) ||
+      (found && (std::abs(d2 - expected) > eps || cell->GetNumberOfPoints() != 3)))
+    {
+      cerr << "FindClosestPointWithinRadius mismatch at query " << i << endl;
+      ++errors;
+    }
+  }
+
+  // All intersections along lines
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdList> cellIds;
+  const double tol = locator->GetTolerance();
+  for (int i = 0; i < 50; ++i)
+  {
+    double p1[3] = { -2.0, -0.9 + 0.037 * i, 0.8 - 0.031 * i };
+    double p2[3] = { 2.0, 0.7 - 0.029 * i, -0.6 + 0.023 * i };
+    int ret = locator->IntersectWithLine(p1, p2, points, cellIds);
+
+    std::vector<double> expected = BruteForceIntersections(sphere, p1, p2, tol);
+    if (points->GetNumberOfPoints() != cellIds->GetNumberOfIds() ||
+      (ret != 0) != !expected.empty() || (!expected.empty() && ret != 1))
+    {
+      cerr << "IntersectWithLine returned " << ret << " for line " << i << endl;
+      ++errors;
+      continue;
+    }
+
+    // intersections are ordered along the line and match the brute force ones
+    double len = sqrt(vtkMath::Distance2BetweenPoints(p1, p2));
+    std::vector<double> actual;
+    for (vtkIdType j = 0; j < points->GetNumberOfPoints(); ++j)
+    {
+      double t = sqrt(vtkMath::Distance2BetweenPoints(p1, points->GetPoint(j))) / len;
+      if (!actual.empty() && t < actual.back() - 1.0e-12)
+      {
+        cerr << "IntersectWithLine points out of order for line " << i << endl;
+        ++errors;
+      }
+      if (actual.empty() || t - actual.back() >= 1.0e-6)
+      {
+        actual.push_back(t);
+      }
+    }
+    bool same = (actual.size() == expected.size());
+    for (size_t j = 0; same && j < actual.size(); ++j)
+    {
+      same = std::abs(actual[j] - expected[j]) < 1.0e-6;
+    }
+    if (!same)
+    {
+      cerr << "IntersectWithLine mismatch for line " << i << ": " << actual.size()
+           << " hits vs " << expected.size() << endl;
+      ++errors;
+    }
+  }
+
+  // Starting inside the sphere
+  double center[3] = { 0.01, 0.02, 0.03 };
+  double outside[3] = { 2.9, 0.37, 0.21 };
+  if (locator->IntersectWithLine(center, outside, points, nullptr) != -1 ||
+    points->GetNumberOfPoints() != 1)
+  {
+    cerr << "IntersectWithLine from inside should return -1 with one hit" << endl;
+    ++errors;
+  }
+  if (locator->IntersectWithLine(outside, center, nullptr, cellIds) != 1 ||
+    cellIds->GetNumberOfIds() != 1)
+  {
+    cerr << "IntersectWithLine from outside should return 1 with one hit" << endl;
+    ++errors;
+  }
+
+  return errors;
+}
@@ -0,0 +1,227 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticKdTreePointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the queries of vtkStaticKdTreePointLocator with brute force
+// searches on a strongly clustered point cloud, both serially and from
+// concurrent vtkSMPTools workers.
+
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticKdTreePointLocator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+// A few dense clusters, a sparse background and some duplicated points.
+void MakeCloud(vtkPoints* pts)
+{
+  vtkMath::RandomSeed(5551212);
+  const double centers[3][3] = { { 0.2, 0.3, 0.1 }, { 0.8, 0.7, 0.9 }, { 0.5, 0.1, 0.6 } };
+  const double sigma[3] = { 0.002, 0.01, 0.05 };
+  for (int c = 0; c < 3; ++c)
+  {
+    for (int i = 0; i < 3000; ++i)
+    {
+      pts->InsertNextPoint(vtkMath::Gaussian(centers[c][0], sigma[c]),
+        vtkMath::Gaussian(centers[c][1], sigma[c]), vtkMath::Gaussian(centers[c][2], sigma[c]));
+    }
+  }
+  for (int i = 0; i < 500; ++i)
+  {
+    pts->InsertNextPoint(
+      vtkMath::Random(0.0, 1.0), vtkMath::Random(0.0, 1.0), vtkMath::Random(0.0, 1.0));
+  }
+  for (int i = 0; i < 50; ++i)
+  {
+    pts->InsertNextPoint(pts->GetPoint(i * 7));
+  }
+}
+
+void QueryPoint(vtkIdType i, double x[3])
+{
+  // Half of the queries near the clusters, half anywhere
+  const double c[3] = { 0.2 + 0.6 * (i % 2), 0.3 + 0.4 * (i % 2), 0.1 + 0.8 * (i % 2) };
+  double scale = (i % 4 < 2 ? 0.01 : 0.8);
+  x[0] = c[0] + scale * std::sin(1.3 * i);
+  x[1] = c[1] + scale * std::cos(0.7 * i);
+  x[2] = c[2] + scale * std::sin(2.1 * i + 0.5);
+}
+
+std::vector<double> SortedDistances(vtkDataSet* ds, const double x[3])
+{
+  std::vector<double> d2(ds->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < ds->GetNumberOfPoints(); ++i)
+  {
+    d2[i] = vtkMath::Distance2BetweenPoints(x, ds->GetPoint(i));
+  }
+  std::sort(d2.begin(), d2.end());
+  return d2;
+}
+
+// N closest points queried concurrently, one vtkIdList per thread.
+struct ClosestNWorker
+{
+  vtkStaticKdTreePointLocator* Locator;
+  vtkDataSet* DataSet;
+  int N;
+  std::vector<double>* FarthestDist2;
+  vtkSMPThreadLocalObject<vtkIdList> Ids;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* ids = this->Ids.Local();
+    double x[3], p[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      QueryPoint(i, x);
+      this->Locator->FindClosestNPoints(this->N, x, ids);
+      this->DataSet->GetPoint(ids->GetId(ids->GetNumberOfIds() - 1), p);
+      (*this->FarthestDist2)[i] = vtkMath::Distance2BetweenPoints(x, p);
+    }
+  }
+
+  void Reduce() {}
+};
+
+int TestQueries(vtkDataSet* ds, vtkStaticKdTreePointLocator* locator, double radius)
+{
+  int errors = 0;
+  const int numQueries = 200;
+  const int N = 17;
+  locator->BuildLocator(); // before the concurrent queries
+
+  std::vector<double> farthest(numQueries);
+  ClosestNWorker worker;
+  worker.Locator = locator;
+  worker.DataSet = ds;
+  worker.N = N;
+  worker.FarthestDist2 = &farthest;
+  vtkSMPTools::For(0, numQueries, worker);
+
+  vtkNew<vtkIdList> ids;
+  double x[3], dist2;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    QueryPoint(i, x);
+    std::vector<double> expected = SortedDistances(ds, x);
+
+    vtkIdType id = locator->FindClosestPoint(x);
+    if (vtkMath::Distance2BetweenPoints(x, ds->GetPoint(id)) != expected[0])
+    {
+      cerr << "FindClosestPoint mismatch at query " << i << endl;
+      ++errors;
+    }
+
+    id = locator->FindClosestPointWithinRadius(radius, x, dist2);
+    if ((id >= 0) != (expected[0] <= radius * radius) || (id >= 0 && dist2 != expected[0]))
+    {
+      cerr << "FindClosestPointWithinRadius mismatch at query " << i << endl;
+      ++errors;
+    }
+
+    // closest N, sorted from closest to farthest
+    locator->FindClosestNPoints(N, x, ids);
+    bool same = (ids->GetNumberOfIds() == N) && farthest[i] == expected[N - 1];
+    for (vtkIdType j = 0; same && j < N; ++j)
+    {
+      same = vtkMath::Distance2BetweenPoints(x, ds->GetPoint(ids->GetId(j))) == expected[j];
+    }
+    if (!same)
+    {
+      cerr << "FindClosestNPoints mismatch at query " << i << endl;
+      ++errors;
+    }
+
+    locator->FindPointsWithinRadius(radius, x, ids);
+    vtkIdType count = static_cast<vtkIdType>(
+      std::upper_bound(expected.begin(), expected.end(), radius * radius) - expected.begin());
+    same = (ids->GetNumberOfIds() == count);
+    for (vtkIdType j = 0; same && j < count; ++j)
+    {
+      same = vtkMath::Distance2BetweenPoints(x, ds->GetPoint(ids->GetId(j))) <= radius * radius;
+    }
+    if (!same)
+    {
+      cerr << "FindPointsWithinRadius mismatch at query " << i << endl;
+      ++errors;
+    }
+  }
+
+  // Asking for more points than available returns them all
+  locator->FindClosestNPoints(static_cast<int>(ds->GetNumberOfPoints()) + 10, x, ids);
+  if (ids->GetNumberOfIds() != ds->GetNumberOfPoints())
+  {
+    cerr << "FindClosestNPoints returned " << ids->GetNumberOfIds() << " points" << endl;
+    ++errors;
+  }
+
+  return errors;
+}
+
+}
+
+int TestStaticKdTreePointLocator(int, char*[])
+{
+  int errors = 0;
+
+  vtkNew<vtkPoints> pts;
+  MakeCloud(pts);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(pts);
+
+  vtkNew<vtkStaticKdTreePointLocator> locator;
+  locator->SetDataSet(cloud);
+  locator->BuildLocator();
+  if (locator->GetNumberOfLevels() < 1 ||
+    locator->GetNumberOfBuckets() != (1 << locator->GetNumberOfLevels()))
+  {
+    cerr << "The tree was not built" << endl;
+    return 1;
+  }
+  errors += TestQueries(cloud, locator, 0.02);
+
+  // One point per leaf
+  locator->SetNumberOfPointsPerBucket(1);
+  errors += TestQueries(cloud, locator, 0.05);
+
+  vtkNew<vtkPolyData> rep;
+  locator->GenerateRepresentation(3, rep);
+  if (rep->GetNumberOfPolys() != 6 * 8)
+  {
+    cerr << "GenerateRepresentation produced " << rep->GetNumberOfPolys() << " faces" << endl;
+    ++errors;
+  }
+
+  // Implicit points
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(13, 11, 7);
+  image->SetSpacing(0.08, 0.1, 0.15);
+  vtkNew<vtkStaticKdTreePointLocator> imageLocator;
+  imageLocator->SetDataSet(image);
+  errors += TestQueries(image, imageLocator, 0.1);
+
+  return errors;
+}
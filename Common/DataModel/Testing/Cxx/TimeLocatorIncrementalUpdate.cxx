@@ -0,0 +1,82 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeLocatorIncrementalUpdate.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the incremental updates of the static and BVH locators of a
+// deforming sheet against rebuilding them at every step. This timing driver
+// is not run by ctest; run it with
+//   vtkCommonDataModelCxxTests TimeLocatorIncrementalUpdate [dimension] [steps]
+// The defaults (40, 1000) are the sheet and the steps of
+// TestLocatorIncrementalUpdate.
+
+#include "TestDeformingSheet.h"
+
+#include "vtkBVHCellLocator.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkStaticPointLocator.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+#include <vector>
+
+int TimeLocatorIncrementalUpdate(int argc, char* argv[])
+{
+  int dim = (argc > 1 ? atoi(argv[1]) : 40);
+  int numSteps = (argc > 2 ? atoi(argv[2]) : 1000);
+
+  vtkNew<vtkPolyData> sheet;
+  std::vector<double> rest;
+  MakeSheet(sheet, rest, dim);
+
+  vtkNew<vtkStaticPointLocator> pointLocator;
+  vtkNew<vtkStaticCellLocator> cellLocator;
+  vtkNew<vtkBVHCellLocator> bvhLocator;
+  pointLocator->SetDataSet(sheet);
+  cellLocator->SetDataSet(sheet);
+  bvhLocator->SetDataSet(sheet);
+
+  cout << "Timing " << sheet->GetNumberOfCells() << " triangles, " << numSteps << " steps\n";
+
+  // Run the steps with the incremental updates, then rebuilding from scratch
+  vtkNew<vtkTimerLog> timer;
+  double times[2][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
+  for (int rebuild = 0; rebuild < 2; ++rebuild)
+  {
+    pointLocator->SetIncrementalUpdate(!rebuild);
+    cellLocator->SetIncrementalUpdate(!rebuild);
+    bvhLocator->SetIncrementalUpdate(!rebuild);
+    for (int step = 0; step < numSteps; ++step)
+    {
+      Deform(sheet, rest, dim, step);
+      vtkLocator* locators[3] = { pointLocator, cellLocator, bvhLocator };
+      for (int i = 0; i < 3; ++i)
+      {
+        timer->StartTimer();
+        locators[i]->BuildLocator();
+        timer->StopTimer();
+        times[rebuild][i] += timer->GetElapsedTime();
+      }
+    }
+  }
+
+  const char* names[3] = { "vtkStaticPointLocator", "vtkStaticCellLocator",
+    "vtkBVHCellLocator" };
+  for (int i = 0; i < 3; ++i)
+  {
+    cout << names[i] << ": update " << times[0][i] << " s, rebuild " << times[1][i] << " s\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -22,6 +22,154 @@
 #include "vtkPoints.h"
 #include "vtkDataSet.h"
 #include "vtkMath.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+// The batched queries. Each thread has its own generic cell and weights; the
+// results are written directly into the (presized) output arrays.
+struct CellLocatorQueries
+{
+  vtkAbstractCellLocator *Locator;
+  vtkPoints *Points;
+  vtkPoints *Ends;
+  double Tol;
+  vtkPoints *OutPoints;
+  vtkIdType *CellIds;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  CellLocatorQueries(vtkAbstractCellLocator *locator, vtkPoints *pts,
+                     vtkPoints *outPts, vtkIdType *cellIds) :
+    Locator(locator), Points(pts), Ends(nullptr), Tol(0.0), OutPoints(outPts),
+    CellIds(cellIds)
+  {
+    this->MaxCellSize = locator->GetDataSet()->GetMaxCellSize();
+  }
+
+  void Initialize()
+  {
+    this->Weights.Local().resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+struct FindCellsWorker : public CellLocatorQueries
+{
+  FindCellsWorker(vtkAbstractCellLocator *locator, vtkPoints *pts,
+                  vtkIdType *cellIds) :
+    CellLocatorQueries(locator, pts, nullptr, cellIds) {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    double *weights = &this->Weights.Local()[0];
+    double x[3], pcoords[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      this->CellIds[ptId] =
+        this->Locator->FindCell(x, 0.0, cell, pcoords, weights);
+    }
+  }
+};
+
+struct FindClosestPointsWorker : public CellLocatorQueries
+{
+  FindClosestPointsWorker(vtkAbstractCellLocator *locator, vtkPoints *pts,
+                          vtkPoints *closestPts, vtkIdType *cellIds) :
+    CellLocatorQueries(locator, pts, closestPts, cellIds) {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkDataArray *closest = (this->OutPoints ? this->OutPoints->GetData() : nullptr);
+    double x[3], closestPoint[3], dist2;
+    int subId;
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      this->CellIds[ptId] = -1;
+      closestPoint[0] = x[0]; closestPoint[1] = x[1]; closestPoint[2] = x[2];
+      this->Locator->FindClosestPoint(x, closestPoint, cell,
+                                      this->CellIds[ptId], subId, dist2);
+      if ( closest )
+      {
+        closest->SetTuple(ptId, closestPoint);
+      }
+    }
+  }
+};
+
+struct IntersectWithLinesWorker : public CellLocatorQueries
+{
+  IntersectWithLinesWorker(vtkAbstractCellLocator *locator, vtkPoints *starts,
+                           vtkPoints *ends, double tol, vtkPoints *hits,
+                           vtkIdType *cellIds) :
+    CellLocatorQueries(locator, starts, hits, cellIds)
+  {
+    this->Ends = ends;
+    this->Tol = tol;
+  }
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    vtkDataArray *hits = (this->OutPoints ? this->OutPoints->GetData() : nullptr);
+    double p1[3], p2[3], x[3], pcoords[3], t;
+    int subId;
+    for ( ; lineId < endLineId; ++lineId)
+    {
+      this->Points->GetPoint(lineId, p1);
+      this->Ends->GetPoint(lineId, p2);
+      this->CellIds[lineId] = -1;
+      if ( ! this->Locator->IntersectWithLine(p1, p2, this->Tol, t, x, pcoords,
+                                              subId, this->CellIds[lineId], cell) )
+      {
+        this->CellIds[lineId] = -1;
+        x[0] = p2[0]; x[1] = p2[1]; x[2] = p2[2];
+      }
+      if ( hits )
+      {
+        hits->SetTuple(lineId, x);
+      }
+    }
+  }
+};
+
+// Build the locator and run the queries. When threaded, prepare the dataset
+// for concurrent GetCell() calls and run the first query serially: this
+// takes care of locators which build themselves lazily on the first query.
+// Then run the others in parallel.
+template <typename TWorker>
+void RunQueries(vtkAbstractCellLocator *locator, vtkIdType numQueries,
+                TWorker& worker, bool threaded)
+{
+  locator->BuildLocator();
+  worker.Initialize();
+  if ( ! threaded )
+  {
+    worker(0, numQueries);
+    return;
+  }
+  if ( locator->GetDataSet()->GetNumberOfCells() > 0 )
+  {
+    // dummy call required before multithreaded calls
+    static_cast<void>(locator->GetDataSet()->GetCellType(0));
+  }
+  worker(0, 1);
+  vtkSMPTools::For(1, numQueries, worker);
+}
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -211,6 +359,87 @@ bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
   return 0;
 }
 //----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, false);
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCellsInternal(vtkPoints *points,
+                                               vtkIdList *cellIds,
+                                               bool threaded)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numPts);
+  if ( numPts < 1 || ! this->DataSet )
+  {
+    return;
+  }
+  FindCellsWorker worker(this, points, cellIds->GetPointer(0));
+  RunQueries(this, numPts, worker, threaded);
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPoints(vtkPoints *points,
+                                               vtkPoints *closestPoints,
+                                               vtkIdList *cellIds)
+{
+  this->FindClosestPointsInternal(points, closestPoints, cellIds, false);
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindClosestPointsInternal(vtkPoints *points,
+                                                       vtkPoints *closestPoints,
+                                                       vtkIdList *cellIds,
+                                                       bool threaded)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  cellIds->SetNumberOfIds(numPts);
+  if ( closestPoints )
+  {
+    closestPoints->SetNumberOfPoints(numPts);
+  }
+  if ( numPts < 1 || ! this->DataSet )
+  {
+    return;
+  }
+  FindClosestPointsWorker worker(this, points, closestPoints,
+                                 cellIds->GetPointer(0));
+  RunQueries(this, numPts, worker, threaded);
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkPoints *starts,
+                                                vtkPoints *ends, double tol,
+                                                vtkPoints *points,
+                                                vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, false);
+}
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLinesInternal(vtkPoints *starts,
+                                                        vtkPoints *ends,
+                                                        double tol,
+                                                        vtkPoints *points,
+                                                        vtkIdList *cellIds,
+                                                        bool threaded)
+{
+  vtkIdType numLines = starts->GetNumberOfPoints();
+  if ( ends->GetNumberOfPoints() != numLines )
+  {
+    vtkErrorMacro(<<"The line starts and ends differ in number");
+    return;
+  }
+  cellIds->SetNumberOfIds(numLines);
+  if ( points )
+  {
+    points->SetNumberOfPoints(numLines);
+  }
+  if ( numLines < 1 || ! this->DataSet )
+  {
+    return;
+  }
+  IntersectWithLinesWorker worker(this, starts, ends, tol, points,
+                                  cellIds->GetPointer(0));
+  RunQueries(this, numLines, worker, threaded);
+}
+//----------------------------------------------------------------------------
 void vtkAbstractCellLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
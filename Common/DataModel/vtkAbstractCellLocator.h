@@ -267,10 +267,50 @@ public:
    */
   virtual bool InsideCellBounds(double x[3], vtkIdType cell_ID);
 
+  //@{
+  /**
+   * Batched queries. These issue one FindCell(), FindClosestPoint() or
+   * IntersectWithLine() query per point (or per line segment). The output
+   * lists are resized to the number of queries.
+   *
+   * FindCells() returns the id of the cell containing each point, or -1.
+   * FindClosestPoints() returns the closest point on the cells (closestPoints
+   * may be nullptr) and the id of the closest cell. IntersectWithLines()
+   * returns the first intersection of each segment (starts[i],ends[i]) and
+   * the id of the intersected cell, or -1 if the segment misses all the
+   * cells (the point is then set to ends[i]); points may be nullptr.
+   *
+   * The locator is built, if needed, then the queries are issued one after
+   * the other. Locators whose single queries are thread safe, such as
+   * vtkCellLocator or vtkStaticCellLocator, override these methods to issue
+   * them in parallel with vtkSMPTools, each thread using its own
+   * vtkGenericCell and weights.
+   */
+  virtual void FindCells(vtkPoints *points, vtkIdList *cellIds);
+  virtual void FindClosestPoints(vtkPoints *points, vtkPoints *closestPoints,
+                                 vtkIdList *cellIds);
+  virtual void IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                  double tol, vtkPoints *points,
+                                  vtkIdList *cellIds);
+  //@}
+
 protected:
    vtkAbstractCellLocator();
   ~vtkAbstractCellLocator() override;
 
+  //@{
+  /**
+   * Build the locator and issue the single queries of the batched queries,
+   * with vtkSMPTools when threaded is true.
+   */
+  void FindCellsInternal(vtkPoints *points, vtkIdList *cellIds, bool threaded);
+  void FindClosestPointsInternal(vtkPoints *points, vtkPoints *closestPoints,
+                                 vtkIdList *cellIds, bool threaded);
+  void IntersectWithLinesInternal(vtkPoints *starts, vtkPoints *ends,
+                                  double tol, vtkPoints *points,
+                                  vtkIdList *cellIds, bool threaded);
+  //@}
+
   //@{
   /**
    * This command is used internally by the locator to copy
@@ -16,6 +16,8 @@
 
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
 
 
 //-----------------------------------------------------------------------------
@@ -66,6 +68,64 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(double R, double x,
   this->FindPointsWithinRadius(R,p,result);
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// Issue FindClosestPoint() queries over a range of points.
+struct FindClosestPointsWorker
+{
+  vtkAbstractPointLocator *Locator;
+  vtkPoints *Points;
+  vtkIdType *ClosestIds;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      this->ClosestIds[ptId] = this->Locator->FindClosestPoint(x);
+    }
+  }
+};
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPoints(vtkPoints *points,
+                                                vtkIdList *closestIds)
+{
+  this->FindClosestPointsInternal(points, closestIds, false);
+}
+
+//-----------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPointsInternal(vtkPoints *points,
+                                                        vtkIdList *closestIds,
+                                                        bool threaded)
+{
+  vtkIdType numPts = points->GetNumberOfPoints();
+  closestIds->SetNumberOfIds(numPts);
+  if ( numPts < 1 )
+  {
+    return;
+  }
+
+  // Build the locator before threading
+  this->BuildLocator();
+
+  FindClosestPointsWorker worker;
+  worker.Locator = this;
+  worker.Points = points;
+  worker.ClosestIds = closestIds->GetPointer(0);
+  if ( threaded )
+  {
+    vtkSMPTools::For(0, numPts, worker);
+  }
+  else
+  {
+    worker(0, numPts);
+  }
+}
+
 //-----------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -34,6 +34,7 @@
 #include "vtkLocator.h"
 
 class vtkIdList;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -93,6 +94,16 @@ public:
                                       vtkIdList *result);
   //@}
 
+  /**
+   * Find the closest point to each of the given points. The ids are
+   * returned in closestIds, which is resized to the number of points. The
+   * queries are issued one after the other once the locator has been
+   * built. Locators whose FindClosestPoint() is thread safe, such as
+   * vtkStaticPointLocator, override this method to issue them in parallel
+   * with vtkSMPTools.
+   */
+  virtual void FindClosestPoints(vtkPoints *points, vtkIdList *closestIds);
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
@@ -113,6 +124,13 @@ protected:
   vtkAbstractPointLocator();
   ~vtkAbstractPointLocator() override;
 
+  /**
+   * Build the locator and issue the FindClosestPoint() queries of
+   * FindClosestPoints(), with vtkSMPTools when threaded is true.
+   */
+  void FindClosestPointsInternal(vtkPoints *points, vtkIdList *closestIds,
+                                 bool threaded);
+
   double Bounds[6]; // bounds of points
   vtkIdType NumberOfBuckets; // total size of locator
 
@@ -226,6 +226,19 @@ struct ArrayList
                  vtkDataSetAttributes *outPD, double nullValue=0.0,
                  vtkTypeBool promote=true);
 
+  // Return the data array of in that matches outArray by name, type and
+  // number of components, or nullptr if there is none, if several arrays of
+  // in have that name, or if either array is a bit array or does not have
+  // the standard memory layout. This is used by filters which process arrays
+  // allocated by CopyAllocate() or InterpolateAllocate() with their own
+  // (e.g. threaded) kernels.
+  static vtkDataArray* GetMatchingArray(vtkDataSetAttributes *in,
+                                        vtkAbstractArray *outArray);
+
+  // Return true if every array of out has a matching array in in (see
+  // GetMatchingArray()).
+  static bool CanCopyArrays(vtkDataSetAttributes *in, vtkDataSetAttributes *out);
+
   // Add an array that interpolates from its own attribute values
   void AddSelfInterpolatingArrays(vtkIdType numOutPts, vtkDataSetAttributes *attr,
                                   double nullValue=0.0);
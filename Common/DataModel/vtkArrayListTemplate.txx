@@ -20,6 +20,8 @@
 #ifndef vtkArrayListTemplate_txx
 #define vtkArrayListTemplate_txx
 
+#include <cstring>
+
 //----------------------------------------------------------------------------
 // Sort of a little object factory (in conjunction w/ vtkTemplateMacro())
 template <typename T>
@@ -45,6 +47,48 @@ void CreateRealArrayPair(ArrayList *list, T *inData, float *outData,
   list->Arrays.push_back(pair);
 }
 
+//----------------------------------------------------------------------------
+inline vtkDataArray* ArrayList::
+GetMatchingArray(vtkDataSetAttributes *in, vtkAbstractArray *outArray)
+{
+  const char *name = outArray->GetName();
+  vtkDataArray *inArray = nullptr;
+  int numMatches = 0;
+  for (int j = 0; name && j < in->GetNumberOfArrays(); ++j)
+  {
+    const char *inName = in->GetAbstractArray(j)->GetName();
+    if ( inName && !strcmp(name, inName) )
+    {
+      inArray = in->GetArray(j);
+      ++numMatches;
+    }
+  }
+  if ( numMatches != 1 || !inArray || !vtkDataArray::FastDownCast(outArray) ||
+       inArray->GetDataType() != outArray->GetDataType() ||
+       inArray->GetDataType() == VTK_BIT ||
+       inArray->GetNumberOfComponents() != outArray->GetNumberOfComponents() ||
+       !inArray->HasStandardMemoryLayout() ||
+       !outArray->HasStandardMemoryLayout() )
+  {
+    return nullptr;
+  }
+  return inArray;
+}
+
+//----------------------------------------------------------------------------
+inline bool ArrayList::
+CanCopyArrays(vtkDataSetAttributes *in, vtkDataSetAttributes *out)
+{
+  for (int i = 0; i < out->GetNumberOfArrays(); ++i)
+  {
+    if ( !ArrayList::GetMatchingArray(in, out->GetAbstractArray(i)) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //----------------------------------------------------------------------------
 // Indicate arrays not to process
 inline void ArrayList::
@@ -0,0 +1,1237 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellLocatorLineIntersections.h"
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+//-----------------------------------------------------------------------------
+// The nodes of the hierarchy are stored depth first in a single array: the
+// left child of an interior node immediately follows it, and the node keeps
+// the index of its right child. A leaf refers to a run of NumberOfCells ids
+// in CellIds starting at Offset. The bounds are stored in single precision,
+// rounded outwards, to keep the nodes small.
+struct vtkBVHNode
+{
+  float Bounds[6];
+  vtkIdType Offset; // first cell of a leaf, or right child of a node
+  int NumberOfCells; // zero for interior nodes
+
+  bool IsLeaf() const { return this->NumberOfCells > 0; }
+};
+
+struct vtkBVHTree
+{
+  std::vector<vtkBVHNode> Nodes;
+  std::vector<vtkIdType> CellIds;
+  std::vector<double> CellBounds; // six values per cell, in the order of CellIds
+  int Depth;
+  int MaxCellSize;
+
+  vtkBVHTree() : Depth(0), MaxCellSize(0) {}
+};
+
+namespace
+{
+
+// The depth of the hierarchy is limited, which bounds the size of the
+// traversal stacks. Nodes deeper than this become leaves.
+const int VTK_BVH_MAX_DEPTH = 64;
+
+// Nodes with more cells than this are binned in parallel.
+const vtkIdType VTK_BVH_PARALLEL_THRESHOLD = 32768;
+
+//-----------------------------------------------------------------------------
+inline float RoundDown(double x)
+{
+  float f = static_cast<float>(x);
+  return ( f > x ? std::nextafter(f, -std::numeric_limits<float>::max()) : f );
+}
+
+inline float RoundUp(double x)
+{
+  float f = static_cast<float>(x);
+  return ( f < x ? std::nextafter(f, std::numeric_limits<float>::max()) : f );
+}
+
+// Intersect the segment o + t*dir, 0 <= t <= tMax, with the bounds b
+// enlarged by pad. On success, tEnter is where the segment enters the box.
+template <typename T>
+inline bool IntersectSegment(const T b[6], const double o[3],
+                             const double dir[3], const double invDir[3],
+                             double pad, double tMax, double &tEnter)
+{
+  double t0 = 0.0, t1 = tMax;
+  for (int i=0; i < 3; ++i)
+  {
+    double lo = b[2*i] - pad;
+    double hi = b[2*i+1] + pad;
+    if ( dir[i] == 0.0 )
+    {
+      if ( o[i] < lo || o[i] > hi )
+      {
+        return false;
+      }
+      continue;
+    }
+    double tNear = (lo - o[i]) * invDir[i];
+    double tFar = (hi - o[i]) * invDir[i];
+    if ( tNear > tFar )
+    {
+      std::swap(tNear, tFar);
+    }
+    t0 = ( tNear > t0 ? tNear : t0 );
+    t1 = ( tFar < t1 ? tFar : t1 );
+    if ( t0 > t1 )
+    {
+      return false;
+    }
+  }
+  tEnter = t0;
+  return true;
+}
+
+// Squared distance from x to the bounds b (zero inside).
+template <typename T>
+inline double Distance2ToBounds(const double x[3], const T b[6])
+{
+  double d2 = 0.0, d;
+  for (int i=0; i < 3; ++i)
+  {
+    if ( x[i] < b[2*i] )
+    {
+      d = b[2*i] - x[i];
+      d2 += d*d;
+    }
+    else if ( x[i] > b[2*i+1] )
+    {
+      d = x[i] - b[2*i+1];
+      d2 += d*d;
+    }
+  }
+  return d2;
+}
+
+template <typename T, typename U>
+inline bool BoundsOverlap(const T a[6], const U b[6])
+{
+  return ( a[0] <= b[1] && a[1] >= b[0] && a[2] <= b[3] && a[3] >= b[2] &&
+           a[4] <= b[5] && a[5] >= b[4] );
+}
+
+template <typename T>
+inline bool PointInBounds(const double x[3], const T b[6])
+{
+  return ( x[0] >= b[0] && x[0] <= b[1] && x[1] >= b[2] && x[1] <= b[3] &&
+           x[2] >= b[4] && x[2] <= b[5] );
+}
+
+//-----------------------------------------------------------------------------
+// Axis aligned box used during construction.
+struct BVHBox
+{
+  double B[6];
+
+  void Reset()
+  {
+    this->B[0] = this->B[2] = this->B[4] = VTK_DOUBLE_MAX;
+    this->B[1] = this->B[3] = this->B[5] = -VTK_DOUBLE_MAX;
+  }
+
+  void AddBounds(const double b[6])
+  {
+    for (int i=0; i < 3; ++i)
+    {
+      this->B[2*i] = std::min(this->B[2*i], b[2*i]);
+      this->B[2*i+1] = std::max(this->B[2*i+1], b[2*i+1]);
+    }
+  }
+
+  void AddPoint(const double x[3])
+  {
+    for (int i=0; i < 3; ++i)
+    {
+      this->B[2*i] = std::min(this->B[2*i], x[i]);
+      this->B[2*i+1] = std::max(this->B[2*i+1], x[i]);
+    }
+  }
+
+  // Half of the surface area, enough to compare costs
+  double HalfArea() const
+  {
+    if ( this->B[0] > this->B[1] )
+    {
+      return 0.0;
+    }
+    double dx = this->B[1] - this->B[0];
+    double dy = this->B[3] - this->B[2];
+    double dz = this->B[5] - this->B[4];
+    return dx*dy + dy*dz + dz*dx;
+  }
+};
+
+struct BVHBin
+{
+  BVHBox Box;
+  vtkIdType Count;
+};
+
+//-----------------------------------------------------------------------------
+// During construction the cells are represented by their bounds and the
+// centers of their bounds. These records are partitioned in place, so each
+// node works on a contiguous run of memory.
+struct BVHPrimitive
+{
+  double Bounds[6];
+  double Center[3];
+  vtkIdType CellId;
+};
+
+// Compute the primitives of the cells.
+struct ComputePrimitives
+{
+  vtkDataSet *DataSet;
+  BVHPrimitive *Primitives;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    BVHPrimitive *prim = this->Primitives + cellId;
+    for ( ; cellId < endCellId; ++cellId, ++prim )
+    {
+      double *bds = prim->Bounds;
+      this->DataSet->GetCellBounds(cellId, bds);
+      prim->Center[0] = 0.5 * (bds[0] + bds[1]);
+      prim->Center[1] = 0.5 * (bds[2] + bds[3]);
+      prim->Center[2] = 0.5 * (bds[4] + bds[5]);
+      prim->CellId = cellId;
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// The bounds of a run of primitives, and the bounds of their centers.
+void AccumulateBounds(const BVHPrimitive *prim, const BVHPrimitive *end,
+                      BVHBox &box, BVHBox &centerBox)
+{
+  for ( ; prim != end; ++prim )
+  {
+    box.AddBounds(prim->Bounds);
+    centerBox.AddPoint(prim->Center);
+  }
+}
+
+// Sorts a run of primitives into bins along the three axes according to
+// their centers. Each bin accumulates the count and the bounds of its cells.
+struct BVHBinning
+{
+  int NumberOfBins;
+  double Origin[3];
+  double Scale[3];
+
+  int GetBin(const double *c, int axis) const
+  {
+    int bin = static_cast<int>((c[axis] - this->Origin[axis]) * this->Scale[axis]);
+    return ( bin < 0 ? 0 : (bin >= this->NumberOfBins ? this->NumberOfBins-1 : bin) );
+  }
+
+  void ResetBins(BVHBin *bins) const
+  {
+    for (int i=0; i < 3*this->NumberOfBins; ++i)
+    {
+      bins[i].Box.Reset();
+      bins[i].Count = 0;
+    }
+  }
+
+  void Accumulate(const BVHPrimitive *prim, const BVHPrimitive *end,
+                  BVHBin *bins) const
+  {
+    for ( ; prim != end; ++prim )
+    {
+      for (int axis=0; axis < 3; ++axis)
+      {
+        BVHBin &bin = bins[axis*this->NumberOfBins + this->GetBin(prim->Center,axis)];
+        bin.Box.AddBounds(prim->Bounds);
+        bin.Count++;
+      }
+    }
+  }
+};
+
+// Threaded versions of the above, used for the large nodes near the root.
+struct ComputeNodeBounds
+{
+  const BVHPrimitive *Primitives;
+  vtkSMPThreadLocal<BVHBox> LocalBox;
+  vtkSMPThreadLocal<BVHBox> LocalCenterBox;
+  BVHBox *Box;
+  BVHBox *CenterBox;
+
+  void Initialize()
+  {
+    this->LocalBox.Local().Reset();
+    this->LocalCenterBox.Local().Reset();
+  }
+
+  void operator()(vtkIdType i, vtkIdType end)
+  {
+    AccumulateBounds(this->Primitives + i, this->Primitives + end,
+                     this->LocalBox.Local(), this->LocalCenterBox.Local());
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<BVHBox>::iterator iter;
+    for ( iter=this->LocalBox.begin(); iter != this->LocalBox.end(); ++iter )
+    {
+      this->Box->AddBounds(iter->B);
+    }
+    for ( iter=this->LocalCenterBox.begin();
+          iter != this->LocalCenterBox.end(); ++iter )
+    {
+      this->CenterBox->AddBounds(iter->B);
+    }
+  }
+};
+
+struct BinPrimitives
+{
+  const BVHPrimitive *Primitives;
+  const BVHBinning *Binning;
+  vtkSMPThreadLocal<std::vector<BVHBin> > LocalBins;
+  BVHBin *Bins;
+
+  void Initialize()
+  {
+    std::vector<BVHBin> &bins = this->LocalBins.Local();
+    bins.resize(3*this->Binning->NumberOfBins);
+    this->Binning->ResetBins(bins.data());
+  }
+
+  void operator()(vtkIdType i, vtkIdType end)
+  {
+    this->Binning->Accumulate(this->Primitives + i, this->Primitives + end,
+                              this->LocalBins.Local().data());
+  }
+
+  void Reduce()
+  {
+    int size = 3*this->Binning->NumberOfBins;
+    vtkSMPThreadLocal<std::vector<BVHBin> >::iterator iter;
+    for ( iter=this->LocalBins.begin(); iter != this->LocalBins.end(); ++iter )
+    {
+      for (int i=0; i < size; ++i)
+      {
+        this->Bins[i].Box.AddBounds((*iter)[i].Box.B);
+        this->Bins[i].Count += (*iter)[i].Count;
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Top down construction of the hierarchy with the binned surface area
+// heuristic.
+struct BVHBuilder
+{
+  vtkBVHTree *Tree;
+  BVHPrimitive *Primitives;
+  int NumberOfBins;
+  int LeafSize;
+  std::vector<BVHBin> Bins; // scratch space, reused by all the nodes
+  std::vector<double> RightCost;
+
+  // Build the subtree of the primitives in [begin,end). Returns its root.
+  vtkIdType BuildNode(vtkIdType begin, vtkIdType end, int depth)
+  {
+    vtkIdType nodeId = static_cast<vtkIdType>(this->Tree->Nodes.size());
+    this->Tree->Nodes.push_back(vtkBVHNode());
+    this->Tree->Depth = std::max(this->Tree->Depth, depth);
+
+    BVHPrimitive *prims = this->Primitives;
+    vtkIdType numCells = end - begin;
+    bool parallel = ( numCells > VTK_BVH_PARALLEL_THRESHOLD );
+
+    BVHBox box, centerBox;
+    box.Reset();
+    centerBox.Reset();
+    if ( parallel )
+    {
+      ComputeNodeBounds bounder;
+      bounder.Primitives = prims + begin;
+      bounder.Box = &box;
+      bounder.CenterBox = &centerBox;
+      vtkSMPTools::For(0, numCells, bounder);
+    }
+    else
+    {
+      AccumulateBounds(prims + begin, prims + end, box, centerBox);
+    }
+
+    vtkBVHNode &node = this->Tree->Nodes[nodeId];
+    for (int i=0; i < 3; ++i)
+    {
+      node.Bounds[2*i] = RoundDown(box.B[2*i]);
+      node.Bounds[2*i+1] = RoundUp(box.B[2*i+1]);
+    }
+
+    const double *cb = centerBox.B;
+    if ( numCells <= this->LeafSize || depth >= VTK_BVH_MAX_DEPTH ||
+         (cb[0] >= cb[1] && cb[2] >= cb[3] && cb[4] >= cb[5]) )
+    {
+      // Small enough, or all the centers coincide: nothing to split
+      node.Offset = begin;
+      node.NumberOfCells = static_cast<int>(numCells);
+      return nodeId;
+    }
+
+    // Bin the primitives along the three axes
+    int numBins = this->NumberOfBins;
+    BVHBinning binning;
+    binning.NumberOfBins = numBins;
+    for (int i=0; i < 3; ++i)
+    {
+      double extent = cb[2*i+1] - cb[2*i];
+      binning.Origin[i] = cb[2*i];
+      binning.Scale[i] = ( extent > 0.0 ? numBins / extent : 0.0 );
+    }
+    BVHBin *bins = this->Bins.data();
+    binning.ResetBins(bins);
+    if ( parallel )
+    {
+      BinPrimitives binner;
+      binner.Primitives = prims + begin;
+      binner.Binning = &binning;
+      binner.Bins = bins;
+      vtkSMPTools::For(0, numCells, binner);
+    }
+    else
+    {
+      binning.Accumulate(prims + begin, prims + end, bins);
+    }
+
+    // Evaluate the cost of the splits between the bins: sweep from the
+    // right to accumulate the right hand sides, then from the left.
+    double *rightCost = this->RightCost.data();
+    int bestAxis = -1, bestBin = -1;
+    double bestCost = VTK_DOUBLE_MAX;
+    for (int axis=0; axis < 3; ++axis)
+    {
+      if ( binning.Scale[axis] == 0.0 )
+      {
+        continue;
+      }
+      const BVHBin *axisBins = bins + axis*numBins;
+      BVHBox side;
+      side.Reset();
+      vtkIdType count = 0;
+      for (int b=numBins-1; b > 0; --b)
+      {
+        side.AddBounds(axisBins[b].Box.B);
+        count += axisBins[b].Count;
+        rightCost[b] = ( count > 0 ? side.HalfArea() * count : 0.0 );
+      }
+      side.Reset();
+      count = 0;
+      for (int b=0; b < numBins-1; ++b)
+      {
+        side.AddBounds(axisBins[b].Box.B);
+        count += axisBins[b].Count;
+        if ( count == 0 || count == numCells )
+        {
+          continue;
+        }
+        double cost = side.HalfArea() * count + rightCost[b+1];
+        if ( cost < bestCost )
+        {
+          bestCost = cost;
+          bestAxis = axis;
+          bestBin = b;
+        }
+      }
+    }
+
+    vtkIdType mid;
+    if ( bestAxis >= 0 )
+    {
+      mid = std::partition(prims + begin, prims + end,
+                           [&](const BVHPrimitive &prim) {
+                             return binning.GetBin(prim.Center, bestAxis) <= bestBin;
+                           }) - prims;
+    }
+    else
+    {
+      // All the centers fall in a single bin: split at the median
+      int axis = 0;
+      for (int i=1; i < 3; ++i)
+      {
+        if ( cb[2*i+1] - cb[2*i] > cb[2*axis+1] - cb[2*axis] )
+        {
+          axis = i;
+        }
+      }
+      mid = begin + numCells/2;
+      std::nth_element(prims + begin, prims + mid, prims + end,
+                       [axis](const BVHPrimitive &a, const BVHPrimitive &b) {
+                         return a.Center[axis] < b.Center[axis];
+                       });
+    }
+
+    this->BuildNode(begin, mid, depth+1); // left child is nodeId+1
+    vtkIdType right = this->BuildNode(mid, end, depth+1);
+    this->Tree->Nodes[nodeId].Offset = right;
+    this->Tree->Nodes[nodeId].NumberOfCells = 0;
+    return nodeId;
+  }
+};
+
+// Store the cell ids and bounds in the order of the leaves.
+struct StoreLeafCells
+{
+  const BVHPrimitive *Primitives;
+  vtkIdType *CellIds;
+  double *CellBounds;
+
+  void operator()(vtkIdType i, vtkIdType end)
+  {
+    for ( ; i < end; ++i )
+    {
+      const BVHPrimitive &prim = this->Primitives[i];
+      this->CellIds[i] = prim.CellId;
+      std::copy(prim.Bounds, prim.Bounds + 6, this->CellBounds + 6*i);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Refit the leaves of an existing hierarchy to the current bounds of their
+// cells. The interior nodes are refitted afterwards, bottom up.
+struct RefitLeaves
+{
+  vtkDataSet *DataSet;
+  vtkBVHTree *Tree;
+
+  void operator()(vtkIdType nodeId, vtkIdType endNodeId)
+  {
+    const vtkIdType *ids = this->Tree->CellIds.data();
+    double *cellBounds = this->Tree->CellBounds.data();
+    BVHBox box;
+    for ( ; nodeId < endNodeId; ++nodeId )
+    {
+      vtkBVHNode &node = this->Tree->Nodes[nodeId];
+      if ( ! node.IsLeaf() )
+      {
+        continue;
+      }
+      box.Reset();
+      vtkIdType end = node.Offset + node.NumberOfCells;
+      for ( vtkIdType i=node.Offset; i < end; ++i )
+      {
+        this->DataSet->GetCellBounds(ids[i], cellBounds + 6*i);
+        box.AddBounds(cellBounds + 6*i);
+      }
+      for (int j=0; j < 3; ++j)
+      {
+        node.Bounds[2*j] = RoundDown(box.B[2*j]);
+        node.Bounds[2*j+1] = RoundUp(box.B[2*j+1]);
+      }
+    }
+  }
+};
+
+// Entries of the traversal stacks: a node and the parametric coordinate
+// (or squared distance) at which it is reached.
+struct StackEntry
+{
+  vtkIdType Node;
+  double T;
+};
+
+// Add the 8 corners and 6 faces of a box to the polydata
+void AddBox(vtkPoints *pts, vtkCellArray *polys, const float b[6])
+{
+  vtkIdType ids[8];
+  for (int k=0; k < 2; ++k)
+  {
+    for (int j=0; j < 2; ++j)
+    {
+      for (int i=0; i < 2; ++i)
+      {
+        ids[i + 2*j + 4*k] = pts->InsertNextPoint(b[i], b[2+j], b[4+k]);
+      }
+    }
+  }
+  const int faces[6][4] = { {0,4,6,2}, {1,3,7,5}, {0,1,5,4},
+                            {2,6,7,3}, {0,2,3,1}, {4,5,7,6} };
+  for (int f=0; f < 6; ++f)
+  {
+    vtkIdType face[4] = { ids[faces[f][0]], ids[faces[f][1]],
+                          ids[faces[f][2]], ids[faces[f][3]] };
+    polys->InsertNextCell(4, face);
+  }
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->CacheCellBounds = 1; //always cached
+  this->NumberOfCellsPerNode = 4;
+  this->NumberOfBins = 16;
+  this->IncrementalUpdate = false;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return ( this->Tree ? static_cast<vtkIdType>(this->Tree->Nodes.size()) : 0 );
+}
+
+//-----------------------------------------------------------------------------
+int vtkBVHCellLocator::GetDepth()
+{
+  return ( this->Tree ? this->Tree->Depth : 0 );
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  vtkDebugMacro( << "Building BVH cell locator" );
+
+  // Do we need to build?
+  if ( (this->Tree != nullptr) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+  {
+    return;
+  }
+
+  // Only the cells have changed: keep the hierarchy and refit its boxes
+  if ( this->IncrementalUpdate && (this->Tree != nullptr) &&
+       (this->BuildTime > this->MTime) &&
+       this->DataSet->GetNumberOfCells() ==
+         static_cast<vtkIdType>(this->Tree->CellIds.size()) )
+  {
+    vtkDebugMacro( << "Refitting BVH cell locator" );
+    this->RefitLocator();
+    this->BuildTime.Modified();
+    return;
+  }
+
+  vtkIdType numCells;
+  if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
+  {
+    vtkErrorMacro( << "No cells to build");
+    return;
+  }
+
+  this->FreeSearchStructure();
+  vtkBVHTree *tree = new vtkBVHTree;
+  tree->MaxCellSize = this->DataSet->GetMaxCellSize();
+
+  // Compute the bounds of the cells. This is done to cause non-thread safe
+  // initialization to occur due to side effects from GetCellBounds().
+  std::vector<BVHPrimitive> prims(numCells);
+  this->DataSet->GetCellBounds(0, prims[0].Bounds);
+  ComputePrimitives primitives;
+  primitives.DataSet = this->DataSet;
+  primitives.Primitives = prims.data();
+  vtkSMPTools::For(0, numCells, primitives);
+
+  // A binary tree with leaves of at least one cell has less than
+  // 2*numCells nodes; reserve a reasonable amount.
+  tree->Nodes.reserve(2*(numCells/this->NumberOfCellsPerNode) + 1);
+  BVHBuilder builder;
+  builder.Tree = tree;
+  builder.Primitives = prims.data();
+  builder.NumberOfBins = this->NumberOfBins;
+  builder.LeafSize = this->NumberOfCellsPerNode;
+  builder.Bins.resize(3*this->NumberOfBins);
+  builder.RightCost.resize(this->NumberOfBins);
+  builder.BuildNode(0, numCells, 0);
+
+  tree->CellIds.resize(numCells);
+  tree->CellBounds.resize(6*numCells);
+  StoreLeafCells store;
+  store.Primitives = prims.data();
+  store.CellIds = tree->CellIds.data();
+  store.CellBounds = tree->CellBounds.data();
+  vtkSMPTools::For(0, numCells, store);
+
+  this->Tree = tree;
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::RefitLocator()
+{
+  vtkBVHTree *tree = this->Tree;
+  tree->MaxCellSize = this->DataSet->GetMaxCellSize();
+
+  // This is done to cause non-thread safe initialization to occur due to
+  // side effects from GetCellBounds().
+  double bds[6];
+  this->DataSet->GetCellBounds(0, bds);
+  RefitLeaves refit{ this->DataSet, tree };
+  vtkIdType numNodes = static_cast<vtkIdType>(tree->Nodes.size());
+  vtkSMPTools::For(0, numNodes, refit);
+
+  // The children of a node follow it in the array
+  for ( vtkIdType nodeId=numNodes-1; nodeId >= 0; --nodeId )
+  {
+    vtkBVHNode &node = tree->Nodes[nodeId];
+    if ( node.IsLeaf() )
+    {
+      continue;
+    }
+    const float *left = tree->Nodes[nodeId+1].Bounds;
+    const float *right = tree->Nodes[node.Offset].Bounds;
+    for (int j=0; j < 3; ++j)
+    {
+      node.Bounds[2*j] = std::min(left[2*j], right[2*j]);
+      node.Bounds[2*j+1] = std::max(left[2*j+1], right[2*j+1]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::
+FindCell(double pos[3], double, vtkGenericCell *cell,
+         double pcoords[3], double* weights )
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return -1;
+  }
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  const vtkIdType *ids = this->Tree->CellIds.data();
+  const double *cellBounds = this->Tree->CellBounds.data();
+  vtkIdType stack[2*VTK_BVH_MAX_DEPTH+2];
+  int top = 0;
+  double dist2;
+  int subId;
+
+  stack[top++] = 0;
+  while ( top > 0 )
+  {
+    const vtkBVHNode &node = nodes[stack[--top]];
+    if ( ! PointInBounds(pos, node.Bounds) )
+    {
+      continue;
+    }
+    if ( ! node.IsLeaf() )
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - nodes) + 1;
+      continue;
+    }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.NumberOfCells; ++i)
+    {
+      vtkIdType cellId = ids[i];
+      if ( PointInBounds(pos, cellBounds + 6*i) )
+      {
+        this->DataSet->GetCell(cellId, cell);
+        if (cell->EvaluatePosition(pos, nullptr, subId, pcoords, dist2, weights) == 1)
+        {
+          return cellId;
+        }
+      }
+    }
+  }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+FindCellsWithinBounds(double *bbox, vtkIdList *cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  const vtkIdType *ids = this->Tree->CellIds.data();
+  const double *cellBounds = this->Tree->CellBounds.data();
+  vtkIdType stack[2*VTK_BVH_MAX_DEPTH+2];
+  int top = 0;
+
+  stack[top++] = 0;
+  while ( top > 0 )
+  {
+    const vtkBVHNode &node = nodes[stack[--top]];
+    if ( ! BoundsOverlap(node.Bounds, bbox) )
+    {
+      continue;
+    }
+    if ( ! node.IsLeaf() )
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - nodes) + 1;
+      continue;
+    }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.NumberOfCells; ++i)
+    {
+      if ( BoundsOverlap(cellBounds + 6*i, bbox) )
+      {
+        cells->InsertNextId(ids[i]);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+FindCellsAlongLine(const double p1[3], const double p2[3], double tol,
+                   vtkIdList *cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  const vtkIdType *ids = this->Tree->CellIds.data();
+  const double *cellBounds = this->Tree->CellBounds.data();
+  vtkIdType stack[2*VTK_BVH_MAX_DEPTH+2];
+  int top = 0;
+  double dir[3], invDir[3], tEnter;
+  vtkMath::Subtract(p2, p1, dir);
+  for (int i=0; i < 3; ++i)
+  {
+    invDir[i] = ( dir[i] != 0.0 ? 1.0 / dir[i] : 0.0 );
+  }
+
+  stack[top++] = 0;
+  while ( top > 0 )
+  {
+    const vtkBVHNode &node = nodes[stack[--top]];
+    if ( ! IntersectSegment(node.Bounds, p1, dir, invDir, tol, 1.0, tEnter) )
+    {
+      continue;
+    }
+    if ( ! node.IsLeaf() )
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - nodes) + 1;
+      continue;
+    }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.NumberOfCells; ++i)
+    {
+      if ( IntersectSegment(cellBounds + 6*i, p1, dir, invDir, tol,
+                            1.0, tEnter) )
+      {
+        cells->InsertNextId(ids[i]);
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+// The nodes are visited front to back: of the two children of a node, the
+// one the line enters first is visited first, and nodes entered beyond the
+// closest intersection found so far are skipped.
+int vtkBVHCellLocator::
+IntersectWithLine(const double a0[3], const double a1[3], double tol,
+                  double& t, double x[3], double pcoords[3],
+                  int &subId, vtkIdType &cellId, vtkGenericCell *cell)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  const vtkIdType *ids = this->Tree->CellIds.data();
+  const double *cellBounds = this->Tree->CellBounds.data();
+  StackEntry stack[2*VTK_BVH_MAX_DEPTH+2];
+  int top = 0;
+  double dir[3], invDir[3], tEnter;
+  vtkMath::Subtract(a1, a0, dir);
+  for (int i=0; i < 3; ++i)
+  {
+    invDir[i] = ( dir[i] != 0.0 ? 1.0 / dir[i] : 0.0 );
+  }
+
+  double tBest = VTK_DOUBLE_MAX, tHit, xHit[3], pcoordsHit[3];
+  int subIdHit;
+  vtkIdType bestCellId = -1;
+
+  if ( IntersectSegment(nodes[0].Bounds, a0, dir, invDir, tol, 1.0, tEnter) )
+  {
+    stack[top].Node = 0;
+    stack[top++].T = tEnter;
+  }
+  while ( top > 0 )
+  {
+    const StackEntry entry = stack[--top];
+    if ( entry.T > tBest )
+    {
+      continue;
+    }
+    const vtkBVHNode &node = nodes[entry.Node];
+    double tMax = ( tBest < 1.0 ? tBest : 1.0 );
+
+    if ( ! node.IsLeaf() )
+    {
+      vtkIdType left = entry.Node + 1, right = node.Offset;
+      double tLeft, tRight;
+      bool hitLeft = IntersectSegment(nodes[left].Bounds, a0, dir, invDir,
+                                      tol, tMax, tLeft);
+      bool hitRight = IntersectSegment(nodes[right].Bounds, a0, dir, invDir,
+                                       tol, tMax, tRight);
+      if ( hitLeft && hitRight )
+      {
+        // push the farther child first so that the nearer one is popped first
+        bool leftFirst = ( tLeft <= tRight );
+        stack[top].Node = ( leftFirst ? right : left );
+        stack[top++].T = ( leftFirst ? tRight : tLeft );
+        stack[top].Node = ( leftFirst ? left : right );
+        stack[top++].T = ( leftFirst ? tLeft : tRight );
+      }
+      else if ( hitLeft || hitRight )
+      {
+        stack[top].Node = ( hitLeft ? left : right );
+        stack[top++].T = ( hitLeft ? tLeft : tRight );
+      }
+      continue;
+    }
+
+    for (vtkIdType i=node.Offset; i < node.Offset + node.NumberOfCells; ++i)
+    {
+      vtkIdType cId = ids[i];
+      if ( ! IntersectSegment(cellBounds + 6*i, a0, dir, invDir, tol,
+                              ( tBest < 1.0 ? tBest : 1.0 ), tEnter) )
+      {
+        continue;
+      }
+      this->DataSet->GetCell(cId, cell);
+      if ( cell->IntersectWithLine(a0, a1, tol, tHit, xHit, pcoordsHit, subIdHit) &&
+           tHit < tBest )
+      {
+        tBest = tHit;
+        bestCellId = cId;
+        x[0] = xHit[0]; x[1] = xHit[1]; x[2] = xHit[2];
+        pcoords[0] = pcoordsHit[0];
+        pcoords[1] = pcoordsHit[1];
+        pcoords[2] = pcoordsHit[2];
+        subId = subIdHit;
+      }
+    }
+  }
+
+  if ( bestCellId < 0 )
+  {
+    return 0;
+  }
+
+  t = tBest;
+  cellId = bestCellId;
+  this->DataSet->GetCell(bestCellId, cell);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+int vtkBVHCellLocator::
+IntersectWithLine(const double p1[3], const double p2[3],
+                  vtkPoints *points, vtkIdList *cellIds)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  const vtkIdType *ids = this->Tree->CellIds.data();
+  const double *cellBounds = this->Tree->CellBounds.data();
+  vtkIdType stack[2*VTK_BVH_MAX_DEPTH+2];
+  int top = 0;
+  double tol = this->Tolerance;
+  double dir[3], invDir[3], tEnter, pcoords[3];
+  int subId;
+  vtkMath::Subtract(p2, p1, dir);
+  for (int i=0; i < 3; ++i)
+  {
+    invDir[i] = ( dir[i] != 0.0 ? 1.0 / dir[i] : 0.0 );
+  }
+
+  vtkGenericCell *cell = vtkGenericCell::New();
+  std::vector<vtkCellLocatorLineIntersection> hits;
+  vtkCellLocatorLineIntersection hit;
+
+  stack[top++] = 0;
+  while ( top > 0 )
+  {
+    const vtkBVHNode &node = nodes[stack[--top]];
+    if ( ! IntersectSegment(node.Bounds, p1, dir, invDir, tol, 1.0, tEnter) )
+    {
+      continue;
+    }
+    if ( ! node.IsLeaf() )
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - nodes) + 1;
+      continue;
+    }
+    for (vtkIdType i=node.Offset; i < node.Offset + node.NumberOfCells; ++i)
+    {
+      hit.CellId = ids[i];
+      if ( ! IntersectSegment(cellBounds + 6*i, p1, dir, invDir, tol,
+                              1.0, tEnter) )
+      {
+        continue;
+      }
+      this->DataSet->GetCell(hit.CellId, cell);
+      if ( cell->IntersectWithLine(p1, p2, tol, hit.T, hit.X, pcoords, subId) )
+      {
+        hits.push_back(hit);
+      }
+    }
+  }
+  int ret = vtkSortCellLocatorLineIntersections(hits, this->DataSet, p1, p2,
+                                                points, cellIds, cell);
+  cell->Delete();
+  return ret;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::
+FindClosestPoint(const double x[3], double closestPoint[3],
+                 vtkGenericCell *cell, vtkIdType &cellId, int &subId,
+                 double& dist2)
+{
+  int inside;
+  this->FindClosestPointWithinRadius2(x, VTK_DOUBLE_MAX, closestPoint, cell,
+                                      cellId, subId, dist2, inside);
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::
+FindClosestPointWithinRadius(double x[3], double radius,
+                             double closestPoint[3], vtkGenericCell *cell,
+                             vtkIdType &cellId, int &subId, double& dist2,
+                             int &inside)
+{
+  return this->FindClosestPointWithinRadius2(x, radius*radius, closestPoint,
+                                             cell, cellId, subId, dist2,
+                                             inside);
+}
+
+//-----------------------------------------------------------------------------
+// The nodes are visited nearest first, and the nodes farther away than the
+// closest point found so far are skipped.
+vtkIdType vtkBVHCellLocator::
+FindClosestPointWithinRadius2(const double x[3], double radius2,
+                              double closestPoint[3], vtkGenericCell *cell,
+                              vtkIdType &cellId, int &subId, double& dist2,
+                              int &inside)
+{
+  cellId = -1;
+  dist2 = -1.0;
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return 0;
+  }
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  const vtkIdType *ids = this->Tree->CellIds.data();
+  const double *cellBounds = this->Tree->CellBounds.data();
+  StackEntry stack[2*VTK_BVH_MAX_DEPTH+2];
+  int top = 0;
+
+  double weightsArray[8], *weights = weightsArray;
+  std::vector<double> moreWeights;
+  if ( this->Tree->MaxCellSize > 8 )
+  {
+    moreWeights.resize(this->Tree->MaxCellSize);
+    weights = moreWeights.data();
+  }
+
+  double minDist2 = radius2, d2, point[3], pcoords[3];
+  vtkIdType closestCell = -1;
+  int tmpInside, tmpSubId, closestSubId = 0, closestInside = 0;
+
+  stack[top].Node = 0;
+  stack[top++].T = Distance2ToBounds(x, nodes[0].Bounds);
+  while ( top > 0 )
+  {
+    const StackEntry entry = stack[--top];
+    if ( entry.T > minDist2 )
+    {
+      continue;
+    }
+    const vtkBVHNode &node = nodes[entry.Node];
+
+    if ( ! node.IsLeaf() )
+    {
+      vtkIdType left = entry.Node + 1, right = node.Offset;
+      double dLeft = Distance2ToBounds(x, nodes[left].Bounds);
+      double dRight = Distance2ToBounds(x, nodes[right].Bounds);
+      // push the farther child first so that the nearer one is popped first
+      bool leftFirst = ( dLeft <= dRight );
+      stack[top].Node = ( leftFirst ? right : left );
+      stack[top++].T = ( leftFirst ? dRight : dLeft );
+      stack[top].Node = ( leftFirst ? left : right );
+      stack[top++].T = ( leftFirst ? dLeft : dRight );
+      continue;
+    }
+
+    for (vtkIdType i=node.Offset; i < node.Offset + node.NumberOfCells; ++i)
+    {
+      vtkIdType cId = ids[i];
+      if ( Distance2ToBounds(x, cellBounds + 6*i) > minDist2 )
+      {
+        continue;
+      }
+      this->DataSet->GetCell(cId, cell);
+      tmpInside = cell->EvaluatePosition(const_cast<double*>(x), point,
+                                         tmpSubId, pcoords, d2, weights);
+      if ( tmpInside != -1 &&
+           (closestCell < 0 ? d2 <= minDist2 : d2 < minDist2) )
+      {
+        closestCell = cId;
+        closestSubId = tmpSubId;
+        closestInside = tmpInside;
+        minDist2 = d2;
+        closestPoint[0] = point[0];
+        closestPoint[1] = point[1];
+        closestPoint[2] = point[2];
+      }
+    }
+  }
+
+  if ( closestCell < 0 )
+  {
+    return 0;
+  }
+
+  cellId = closestCell;
+  subId = closestSubId;
+  inside = closestInside;
+  dist2 = minDist2;
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  this->BuildLocator();
+  if ( ! this->Tree )
+  {
+    return;
+  }
+
+  vtkPoints *pts = vtkPoints::New();
+  pts->SetDataTypeToFloat();
+  vtkCellArray *polys = vtkCellArray::New();
+
+  const vtkBVHNode *nodes = this->Tree->Nodes.data();
+  std::vector<std::pair<vtkIdType,int> > stack(1, std::make_pair(0, 0));
+  while ( ! stack.empty() )
+  {
+    vtkIdType nodeId = stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    const vtkBVHNode &node = nodes[nodeId];
+    if ( node.IsLeaf() || depth == level )
+    {
+      AddBox(pts, polys, node.Bounds);
+      continue;
+    }
+    stack.push_back(std::make_pair(node.Offset, depth+1));
+    stack.push_back(std::make_pair(nodeId+1, depth+1));
+  }
+
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+  pts->Delete();
+  polys->Delete();
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoints(vtkPoints *points,
+                                          vtkPoints *closestPoints,
+                                          vtkIdList *cellIds)
+{
+  this->FindClosestPointsInternal(points, closestPoints, cellIds, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                           double tol, vtkPoints *points,
+                                           vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  // Cell bounds are always cached
+  this->CacheCellBounds = 1;
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number Of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Number Of Nodes: " << this->GetNumberOfNodes() << "\n";
+  os << indent << "Depth: " << this->GetDepth() << "\n";
+  os << indent << "Incremental Update: "
+     << (this->IncrementalUpdate ? "On\n" : "Off\n");
+}
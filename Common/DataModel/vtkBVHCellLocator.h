@@ -0,0 +1,275 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator which organizes the
+ * cells of a dataset in a bounding volume hierarchy (BVH): a binary tree of
+ * axis aligned boxes, each leaf referring to a few cells. Unlike the bins of
+ * vtkStaticCellLocator, the boxes adapt to the distribution of the cells, so
+ * the locator performs well on surfaces with very uneven cell sizes, and
+ * is mostly suited to ray casting (IntersectWithLine()) and picking.
+ *
+ * The tree is built top down. Each node is split with the surface area
+ * heuristic (SAH): the centers of the cells are sorted into a number of bins
+ * along each axis, and the split which minimizes the expected cost of a ray
+ * query is retained. The binning of large nodes is threaded with
+ * vtkSMPTools. The nodes are stored depth first in a single array (the left
+ * child of a node immediately follows it) with single precision bounds,
+ * which keeps the traversal cache friendly.
+ *
+ * Line intersection visits the nodes front to back and stops as soon as the
+ * remaining nodes lie beyond the closest intersection found so far; closest
+ * point queries visit the nodes in order of increasing distance. Once the
+ * locator is built, the queries do not modify the locator and may be invoked
+ * concurrently from several threads (each with its own vtkGenericCell).
+ *
+ * @warning
+ * This class *always* caches cell bounds.
+ *
+ * @warning
+ * Incremental cell insertion is not supported; the locator is rebuilt when
+ * the dataset is modified.
+ *
+ * @sa
+ * vtkLocator vtkAbstractCellLocator vtkStaticCellLocator vtkCellLocator
+ * vtkCellTreeLocator vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractCellLocator.h"
+
+// Forward declarations for PIMPL
+struct vtkBVHTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator *New();
+  vtkTypeMacro(vtkBVHCellLocator,vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Set the number of bins used along each axis to evaluate the candidate
+   * splits of a node. More bins give better trees at the price of a slower
+   * construction. By default 16 bins are used.
+   */
+  vtkSetClampMacro(NumberOfBins,int,2,256);
+  vtkGetMacro(NumberOfBins,int);
+  //@}
+
+  //@{
+  /**
+   * Enable incremental updates of the locator (off by default). When
+   * enabled and only the cells of the dataset have changed since the
+   * locator was built (same number of cells, same locator parameters),
+   * BuildLocator() keeps the structure of the hierarchy and only refits its
+   * boxes to the new cell bounds. This is much cheaper than a full build,
+   * but the quality of the hierarchy degrades as the cells move away from
+   * their original positions; invoke Modified() on the locator to force a
+   * full build.
+   */
+  vtkSetMacro(IncrementalUpdate,bool);
+  vtkGetMacro(IncrementalUpdate,bool);
+  vtkBooleanMacro(IncrementalUpdate,bool);
+  //@}
+
+  /**
+   * Return the number of nodes and the depth of the hierarchy. These are
+   * only meaningful after the locator has been built.
+   */
+  vtkIdType GetNumberOfNodes();
+  int GetDepth();
+
+  /**
+   * Test a point to find if it is inside a cell. Returns the cellId if inside
+   * or -1 if not.
+   */
+  vtkIdType FindCell(double pos[3], double vtkNotUsed, vtkGenericCell *cell,
+                     double pcoords[3], double* weights ) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindCell(double x[3]) override
+    { return this->Superclass::FindCell(x); }
+
+  /**
+   * Return a list of unique cell ids whose bounds intersect the given
+   * bounding box. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double *bbox, vtkIdList *cells) override;
+
+  /**
+   * Given a finite line defined by the two points (p1,p2), return the list
+   * of unique cell ids whose bounds, enlarged by the tolerance, are crossed
+   * by the line. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsAlongLine(const double p1[3], const double p2[3],
+                          double tolerance, vtkIdList *cells) override;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell with the smallest parametric coordinate t is
+   * returned. The cell is returned as a cell id and as a generic cell. This
+   * method is thread safe once the locator has been built.
+   */
+  int IntersectWithLine(const double a0[3], const double a1[3], double tol,
+                        double& t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId,
+                        vtkGenericCell *cell) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                        double& t, double x[3], double pcoords[3], int &subId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol,
+                        double &t, double x[3], double pcoords[3],
+                        int &subId, vtkIdType &cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
+
+  /**
+   * Return all the intersection points and cells along the finite line
+   * (p1,p2), ordered from p1 to p2. Either of points and cellIds may be
+   * nullptr. Returns 0 if there is no intersection. For surfaces, -1 is
+   * returned if p1 is inside (the line leaves through the first
+   * intersected cell) and 1 otherwise; 1 is returned for other cells.
+   * This method is thread safe once the locator has been built.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3],
+                        vtkPoints *points, vtkIdList *cellIds) override;
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * This method is thread safe once the locator has been built.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3],
+                        vtkGenericCell *cell, vtkIdType &cellId,
+                        int &subId, double& dist2) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3],
+                        vtkIdType &cellId, int &subId, double& dist2) override
+  {
+    this->Superclass::FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. Returns 1 if a point is found within the radius,
+   * 0 otherwise. This method is thread safe once the locator has been built.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2, int &inside) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cell, cellId, subId, dist2);
+  }
+
+  //@{
+  /**
+   * Batched queries, issued in parallel with vtkSMPTools: the single
+   * queries of this locator are thread safe once it is built. See
+   * vtkAbstractCellLocator.
+   */
+  void FindCells(vtkPoints *points, vtkIdList *cellIds) override;
+  void FindClosestPoints(vtkPoints *points, vtkPoints *closestPoints,
+                         vtkIdList *cellIds) override;
+  void IntersectWithLines(vtkPoints *starts, vtkPoints *ends, double tol,
+                          vtkPoints *points, vtkIdList *cellIds) override;
+  //@}
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() produces
+   * the boxes of the nodes at the given level of the hierarchy (and of the
+   * leaves above it); a negative level produces the boxes of all the leaves.
+   */
+  void GenerateRepresentation(int level, vtkPolyData *pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  // Closest point query within the squared radius radius2 (which may be
+  // VTK_DOUBLE_MAX).
+  vtkIdType FindClosestPointWithinRadius2(const double x[3], double radius2,
+                                          double closestPoint[3],
+                                          vtkGenericCell *cell,
+                                          vtkIdType &cellId, int &subId,
+                                          double& dist2, int &inside);
+
+  // Refit the boxes of the hierarchy to the current cell bounds.
+  void RefitLocator();
+
+  int NumberOfBins; // Number of bins used to evaluate the splits
+  bool IncrementalUpdate; // Refit rather than rebuild if possible
+  vtkBVHTree *Tree; // The hierarchy
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
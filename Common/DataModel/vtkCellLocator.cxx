@@ -20,8 +20,11 @@
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkBox.h"
+#include "vtkSMPThreadLocal.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -36,7 +39,11 @@ class vtkNeighborCells
   public:
     vtkNeighborCells(const int sz, const int ext=1000)
       {this->P = vtkIntArray::New(); this->P->Allocate(3*sz,3*ext);};
+    vtkNeighborCells(const vtkNeighborCells& other)
+      {this->P = vtkIntArray::New(); this->P->DeepCopy(other.P);};
     ~vtkNeighborCells(){this->P->Delete();};
+    vtkNeighborCells& operator=(const vtkNeighborCells& other)
+      {this->P->DeepCopy(other.P); return *this;};
     int GetNumberOfNeighbors() {return (this->P->GetMaxId()+1)/3;};
     void Reset() {this->P->Reset();};
 
@@ -56,6 +63,43 @@ inline int vtkNeighborCells::InsertNextPoint(int *x)
   return id/3;
 }
 
+//----------------------------------------------------------------------------
+// The scratch space of a query: the buckets to search, and the marks of the
+// cells visited so far. The marks are only cleared when the query number
+// rolls over, which saves a number of calls to memset.
+struct vtkCellLocatorScratch
+{
+  vtkNeighborCells Buckets;
+  std::vector<unsigned char> CellHasBeenVisited;
+  unsigned char QueryNumber;
+
+  vtkCellLocatorScratch() : Buckets(10, 10), QueryNumber(0) {}
+
+  // Start a new query over numCells cells
+  void NewQuery(vtkIdType numCells)
+  {
+    if ( static_cast<vtkIdType>(this->CellHasBeenVisited.size()) != numCells )
+    {
+      this->CellHasBeenVisited.assign(numCells, 0);
+      this->QueryNumber = 0;
+    }
+    this->QueryNumber++;
+    if (this->QueryNumber == 0)
+    {
+      std::fill(this->CellHasBeenVisited.begin(),
+                this->CellHasBeenVisited.end(), 0);
+      this->QueryNumber++;    // can't use 0 as a marker
+    }
+  }
+};
+
+// Each thread issuing queries has its own scratch space, so that concurrent
+// queries (e.g., from vtkSMPTools) do not interfere.
+class vtkCellLocatorThreadScratch :
+  public vtkSMPThreadLocal<vtkCellLocatorScratch>
+{
+};
+
 //----------------------------------------------------------------------------
 // Construct with automatic computation of divisions, averaging
 // 25 cells per bucket.
@@ -65,32 +109,23 @@ vtkCellLocator::vtkCellLocator()
   this->Level                = 8;
   this->NumberOfCellsPerNode = 25;
   this->Tree                 = nullptr;
-  this->CellHasBeenVisited   = nullptr;
-  this->QueryNumber          = 0;
   this->NumberOfDivisions    = 1;
   this->H[0] = this->H[1] = this->H[2] = 1.0;
 
-  this->Buckets = new vtkNeighborCells(10, 10);
+  this->Scratch = new vtkCellLocatorThreadScratch;
   this->NumberOfOctants = 0;
   this->Bounds[0] = this->Bounds[2] = this->Bounds[4] = VTK_DOUBLE_MAX;
   this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = VTK_DOUBLE_MIN;
-  this->OctantBounds[0] = this->OctantBounds[2] =
-    this->OctantBounds[4] = VTK_DOUBLE_MAX;
-  this->OctantBounds[1] = this->OctantBounds[3] =
-    this->OctantBounds[5] = VTK_DOUBLE_MIN;
 }
 
 //----------------------------------------------------------------------------
 vtkCellLocator::~vtkCellLocator()
 {
-  delete this->Buckets;
-  this->Buckets = nullptr;
-
   this->FreeSearchStructure();
   this->FreeCellBounds();
 
-  delete [] this->CellHasBeenVisited;
-  this->CellHasBeenVisited = nullptr;
+  delete this->Scratch;
+  this->Scratch = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -138,27 +173,23 @@ int vtkCellLocator::GenerateIndex(int offset, int numDivs, int i, int j,
 
 
 //----------------------------------------------------------------------------
-void vtkCellLocator::ComputeOctantBounds(int i, int j, int k)
+void vtkCellLocator::ComputeOctantBounds(int i, int j, int k,
+                                         double octantBounds[6])
 {
-  this->OctantBounds[0] = this->Bounds[0] + i*H[0];
-  this->OctantBounds[1] = this->OctantBounds[0] + H[0];
-  this->OctantBounds[2] = this->Bounds[2] + j*H[1];
-  this->OctantBounds[3] = this->OctantBounds[2] + H[1];
-  this->OctantBounds[4] = this->Bounds[4] + k*H[2];
-  this->OctantBounds[5] = this->OctantBounds[4] + H[2];
+  octantBounds[0] = this->Bounds[0] + i*H[0];
+  octantBounds[1] = octantBounds[0] + H[0];
+  octantBounds[2] = this->Bounds[2] + j*H[1];
+  octantBounds[3] = octantBounds[2] + H[1];
+  octantBounds[4] = this->Bounds[4] + k*H[2];
+  octantBounds[5] = octantBounds[4] + H[2];
 }
 
 //----------------------------------------------------------------------------
 // Return intersection point (if any) AND the cell which was intersected by
 // finite line.
 //
-// NOTE: This method is not thread safe (i.e., when invoking this method on
-// the same instance of vtkCellLocator). This is the due to the use of the
-// data members QueryNumber and CellHasBeenVisited. These should be pulled
-// out of the class and made local to the appropriate methods that use
-// them. Since there may be a performance cost and possible effects on
-// output, this will be done TODO when more time is available. To see an
-// alternative implementation, see vtkStaticCellLocator which is thread safe.
+// The cells visited by the query are marked in the scratch space of the
+// calling thread, so concurrent queries do not interfere.
 //
 int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], double tol,
                                       double& t, double x[3], double pcoords[3],
@@ -183,8 +214,10 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
   double stopDist, currDist;
   double deltaT, pDistance, minPDistance=1.0e38;
   double length, maxLength=0.0;
+  double octantBounds[6];
 
   this->BuildLocatorIfNeeded();
+  vtkCellLocatorScratch &scratch = this->Scratch->Local();
 
   // convert the line into i,j,k coordinates
   tMax = 0.0;
@@ -225,12 +258,7 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
     // Clear the array that indicates whether we have visited this cell.
     // The array is only cleared when the query number rolls over.  This
     // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-    {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++;    // can't use 0 as a marker
-    }
+    scratch.NewQuery(this->DataSet->GetNumberOfCells());
 
     // set up curr and stop dist
     currDist = 0;
@@ -264,14 +292,14 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1);
+        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1, octantBounds);
         for (tMax = VTK_DOUBLE_MAX, cellId=0;
         cellId < this->Tree[idx]->GetNumberOfIds(); cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (scratch.CellHasBeenVisited[cId] != scratch.QueryNumber)
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
+            scratch.CellHasBeenVisited[cId] = scratch.QueryNumber;
             int hitCellBounds = 0;
 
             // check whether we intersect the cell bounds
@@ -296,9 +324,9 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
               this->DataSet->GetCell(cId, cell);
               if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) )
               {
-                if ( ! this->IsInOctantBounds(x, tol) )
+                if ( ! this->IsInOctantBounds(octantBounds, x, tol) )
                 {
-                  this->CellHasBeenVisited[cId] = 0; //mark the cell non-visited
+                  scratch.CellHasBeenVisited[cId] = 0; //mark the cell non-visited
                 }
                 else
                 {
@@ -316,7 +344,7 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
                 } //if within current parametric range
               } // if intersection
             } // if (hitCellBounds)
-          } // if (!this->CellHasBeenVisited[cId])
+          } // if (!scratch.CellHasBeenVisited[cId])
         }
       }
 
@@ -414,6 +442,7 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
   //int minStat=0; //save this variable it is used for debugging
 
   this->BuildLocatorIfNeeded();
+  vtkCellLocatorScratch &scratch = this->Scratch->Local();
 
   cachedPoint[0] = 0.0;
   cachedPoint[1] = 0.0;
@@ -425,12 +454,7 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
   // Clear the array that indicates whether we have visited this cell.
   // The array is only cleared when the query number rolls over.  This
   // saves a number of calls to memset.
-  this->QueryNumber++;
-  if (this->QueryNumber == 0)
-  {
-    this->ClearCellHasBeenVisited();
-    this->QueryNumber++;    // can't use 0 as a marker
-  }
+  scratch.NewQuery(this->DataSet->GetNumberOfCells());
 
   // init
   dist2 = -1.0;
@@ -460,11 +484,11 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
   for (closestCell=(-1),minDist2=VTK_DOUBLE_MAX,level=0;
   (closestCell == -1) && (level < this->NumberOfDivisions); level++)
   {
-    this->GetBucketNeighbors(ijk, this->NumberOfDivisions, level);
+    this->GetBucketNeighbors(&scratch.Buckets, ijk, this->NumberOfDivisions, level);
 
-    for (i=0; i<this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i=0; i<scratch.Buckets.GetNumberOfNeighbors(); i++)
     {
-      nei = this->Buckets->GetPoint(i);
+      nei = scratch.Buckets.GetPoint(i);
 
       // if a neighboring bucket has cells,
       if ( (cellIds =
@@ -481,9 +505,9 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
           {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch.CellHasBeenVisited[cellId] != scratch.QueryNumber)
             {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
+              scratch.CellHasBeenVisited[cellId] = scratch.QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -537,7 +561,7 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
 //                  minStat = stat;
                 }
               }
-            } // if (!this->CellHasBeenVisited[cellId])
+            } // if (!scratch.CellHasBeenVisited[cellId])
           }
         }
       }
@@ -570,12 +594,12 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
         prevMaxLevel[i] = this->NumberOfDivisions - 1;
       }
     }
-    this->GetOverlappingBuckets(x, ijk, sqrt(minDist2), prevMinLevel,
+    this->GetOverlappingBuckets(&scratch.Buckets, x, ijk, sqrt(minDist2), prevMinLevel,
                                 prevMaxLevel);
 
-    for (i=0; i<this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i=0; i<scratch.Buckets.GetNumberOfNeighbors(); i++)
     {
-      nei = this->Buckets->GetPoint(i);
+      nei = scratch.Buckets.GetPoint(i);
 
       if ( (cellIds =
           this->Tree[leafStart + nei[0] + nei[1]*this->NumberOfDivisions +
@@ -591,9 +615,9 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
           {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch.CellHasBeenVisited[cellId] != scratch.QueryNumber)
             {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
+              scratch.CellHasBeenVisited[cellId] = scratch.QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -689,6 +713,7 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
   int ii, radiusLevels[3], radiusLevel, prevMinLevel[3], prevMaxLevel[3];
 
   this->BuildLocatorIfNeeded();
+  vtkCellLocatorScratch &scratch = this->Scratch->Local();
 
   cachedPoint[0] = 0.0;
   cachedPoint[1] = 0.0;
@@ -700,12 +725,7 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
   // Clear the array that indicates whether we have visited this cell.
   // The array is only cleared when the query number rolls over.  This
   // saves a number of calls to memset.
-  this->QueryNumber++;
-  if (this->QueryNumber == 0)
-  {
-    this->ClearCellHasBeenVisited();
-    this->QueryNumber++;    // can't use 0 as a marker
-  }
+  scratch.NewQuery(this->DataSet->GetNumberOfCells());
 
   // init
   dist2 = -1.0;
@@ -742,9 +762,9 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
     {
       // get the cell
       cellId = cellIds->GetId(j);
-      if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+      if (scratch.CellHasBeenVisited[cellId] != scratch.QueryNumber)
       {
-        this->CellHasBeenVisited[cellId] = this->QueryNumber;
+        scratch.CellHasBeenVisited[cellId] = scratch.QueryNumber;
 
         // check whether we could be close enough to the cell by
         // testing the cell bounds
@@ -790,7 +810,7 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
             refinedRadius2 = dist2;
           }
         }
-      } // if (this->CellHasBeenVisited[cellId])
+      } // if (scratch.CellHasBeenVisited[cellId])
     }
   }
 
@@ -853,12 +873,12 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
     currentRadius = refinedRadius; // used in if at bottom of this for loop
 
     // Build up a list of buckets that are arranged in rings
-    this->GetOverlappingBuckets(x, ijk, refinedRadius/ii, prevMinLevel,
+    this->GetOverlappingBuckets(&scratch.Buckets, x, ijk, refinedRadius/ii, prevMinLevel,
                                 prevMaxLevel);
 
-    for (i=0; i<this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i=0; i<scratch.Buckets.GetNumberOfNeighbors(); i++)
     {
-      nei = this->Buckets->GetPoint(i);
+      nei = scratch.Buckets.GetPoint(i);
 
       if ( (cellIds =
         this->Tree[leafStart + nei[0] + nei[1]*this->NumberOfDivisions +
@@ -874,9 +894,9 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
           {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch.CellHasBeenVisited[cellId] != scratch.QueryNumber)
             {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
+              scratch.CellHasBeenVisited[cellId] = scratch.QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -969,7 +989,8 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
 //  These indices must be offset by number of octants before the leaf node
 //  layer before they can be used. Only those buckets with cells are returned.
 //
-void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
+void vtkCellLocator::GetBucketNeighbors(vtkNeighborCells *buckets, int ijk[3],
+                                        int ndivs, int level)
 {
   int i, j, k, min, max, minLevel[3], maxLevel[3];
   int nei[3];
@@ -984,7 +1005,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
 
   //  Initialize
   //
-  this->Buckets->Reset();
+  buckets->Reset();
 
   //  If at this bucket, just place into list
   //
@@ -993,7 +1014,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
     if (this->Tree[leafStart + ijk[0] + ijk[1]*this->NumberOfDivisions
       + ijk[2]*numberOfBucketsPerPlane])
     {
-      this->Buckets->InsertNextPoint(ijk);
+      buckets->InsertNextPoint(ijk);
     }
     return;
   }
@@ -1023,7 +1044,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
             + k*numberOfBucketsPerPlane])
           {
             nei[0]=i; nei[1]=j; nei[2]=k;
-            this->Buckets->InsertNextPoint(nei);
+            buckets->InsertNextPoint(nei);
           }
         }
       }
@@ -1039,7 +1060,8 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
 // layer before they can be used. Only buckets that have cells are placed
 // in the bucket list.
 //
-void vtkCellLocator::GetOverlappingBuckets(const double x[3], int vtkNotUsed(ijk)[3],
+void vtkCellLocator::GetOverlappingBuckets(vtkNeighborCells *buckets,
+                                           const double x[3], int vtkNotUsed(ijk)[3],
                                            double dist,
                                            int prevMinLevel[3],
                                            int prevMaxLevel[3])
@@ -1055,7 +1077,7 @@ void vtkCellLocator::GetOverlappingBuckets(const double x[3], int vtkNotUsed(ijk
     - numberOfBucketsPerPlane*this->NumberOfDivisions;
 
   // Initialize
-  this->Buckets->Reset();
+  buckets->Reset();
 
   // Determine the range of indices in each direction
   for (i=0; i < 3; i++)
@@ -1125,7 +1147,7 @@ void vtkCellLocator::GetOverlappingBuckets(const double x[3], int vtkNotUsed(ijk
         if (this->Tree[leafStart + i + jFactor + kFactor])
         {
           nei[0]=i; nei[1]=j; nei[2]=k;
-          this->Buckets->InsertNextPoint(nei);
+          buckets->InsertNextPoint(nei);
         }
       }
     }
@@ -1227,8 +1249,6 @@ void vtkCellLocator::BuildLocatorInternal()
   {
     this->FreeSearchStructure();
   }
-  delete [] this->CellHasBeenVisited;
-  this->CellHasBeenVisited = nullptr;
   this->FreeCellBounds();
 
   //  Size the root cell.  Initialize cell data structure, compute
@@ -1269,10 +1289,6 @@ void vtkCellLocator::BuildLocatorInternal()
   this->Tree = new vtkIdListPtr[numOctants];
   memset (this->Tree, 0, numOctants*sizeof(vtkIdListPtr));
 
-  this->CellHasBeenVisited = new unsigned char [ numCells ];
-  this->ClearCellHasBeenVisited();
-  this->QueryNumber = 0;
-
   if (this->CacheCellBounds)
   {
     this->StoreCellBounds();
@@ -1565,25 +1581,6 @@ void vtkCellLocator::GenerateFace(int face, int numDivs, int i, int j, int k,
   polys->InsertNextCell(4,ids);
 }
 
-//----------------------------------------------------------------------------
-void vtkCellLocator::ClearCellHasBeenVisited()
-{
-  if (this->CellHasBeenVisited && this->DataSet)
-  {
-    memset(this->CellHasBeenVisited, 0, this->DataSet->GetNumberOfCells());
-  }
-}
-
-//----------------------------------------------------------------------------
-void vtkCellLocator::ClearCellHasBeenVisited(int id)
-{
-  if (this->CellHasBeenVisited
-      && this->DataSet && id < this->DataSet->GetNumberOfCells())
-  {
-    this->CellHasBeenVisited[id] = 0;
-  }
-}
-
 //----------------------------------------------------------------------------
 // Calculate the distance between the point x to the bucket "nei".
 //
@@ -1809,6 +1806,7 @@ void vtkCellLocator::FindCellsAlongLine(const double p1[3], const double p2[3],
                                         vtkIdList *cells)
 {
   this->BuildLocatorIfNeeded();
+  vtkCellLocatorScratch &scratch = this->Scratch->Local();
 
   cells->Reset();
 
@@ -1830,6 +1828,7 @@ void vtkCellLocator::FindCellsAlongLine(const double p1[3], const double p2[3],
   int bestDir;
   double stopDist, currDist;
   double length, maxLength=0.0;
+  double octantBounds[6];
 
   // convert the line into i,j,k coordinates
   tMax = 0.0;
@@ -1866,12 +1865,7 @@ void vtkCellLocator::FindCellsAlongLine(const double p1[3], const double p2[3],
     // Clear the array that indicates whether we have visited this cell.
     // The array is only cleared when the query number rolls over.  This
     // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-    {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++;    // can't use 0 as a marker
-    }
+    scratch.NewQuery(this->DataSet->GetNumberOfCells());
 
     // set up curr and stop dist
     currDist = 0;
@@ -1905,13 +1899,13 @@ void vtkCellLocator::FindCellsAlongLine(const double p1[3], const double p2[3],
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1);
+        this->ComputeOctantBounds(pos[0]-1,pos[1]-1,pos[2]-1, octantBounds);
         for (cellId=0; cellId < this->Tree[idx]->GetNumberOfIds(); cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (scratch.CellHasBeenVisited[cId] != scratch.QueryNumber)
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
+            scratch.CellHasBeenVisited[cId] = scratch.QueryNumber;
 
             // check whether we intersect the cell bounds
             if (this->CacheCellBounds)
@@ -1932,7 +1926,7 @@ void vtkCellLocator::FindCellsAlongLine(const double p1[3], const double p2[3],
             {
               cells->InsertUniqueId(cId);
             } // if (hitCellBounds)
-          } // if (!this->CellHasBeenVisited[cId])
+          } // if (!scratch.CellHasBeenVisited[cId])
         }
       }
 
@@ -1995,6 +1989,28 @@ void vtkCellLocator::FindCellsAlongLine(const double p1[3], const double p2[3],
 }
 
 
+//----------------------------------------------------------------------------
+void vtkCellLocator::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, true);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLocator::FindClosestPoints(vtkPoints *points,
+                                       vtkPoints *closestPoints,
+                                       vtkIdList *cellIds)
+{
+  this->FindClosestPointsInternal(points, closestPoints, cellIds, true);
+}
+
+//----------------------------------------------------------------------------
+void vtkCellLocator::IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                        double tol, vtkPoints *points,
+                                        vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, true);
+}
+
 //----------------------------------------------------------------------------
 void vtkCellLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -25,6 +25,11 @@
  * candidate cells, or intersection with another vtkCellLocator to return
  * candidate cells.
  *
+ * Once the locator is built, the queries keep their scratch space (the
+ * buckets searched and the cells visited) per thread, so that they may be
+ * issued concurrently, e.g., from vtkSMPTools or the batched queries of
+ * vtkAbstractCellLocator.
+ *
  * @warning
  * Many other types of spatial locators have been developed, such as
  * variable depth octrees and kd-trees. These are often more efficient
@@ -42,6 +47,7 @@
 #include "vtkAbstractCellLocator.h"
 
 class vtkNeighborCells;
+class vtkCellLocatorThreadScratch;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkCellLocator : public vtkAbstractCellLocator
 {
@@ -155,6 +161,19 @@ public:
   void FindCellsAlongLine(const double p1[3], const double p2[3],
                           double tolerance, vtkIdList *cells) override;
 
+  //@{
+  /**
+   * Batched queries, issued in parallel with vtkSMPTools: the single
+   * queries of this locator are thread safe once it is built. See
+   * vtkAbstractCellLocator.
+   */
+  void FindCells(vtkPoints *points, vtkIdList *cellIds) override;
+  void FindClosestPoints(vtkPoints *points, vtkPoints *closestPoints,
+                         vtkIdList *cellIds) override;
+  void IntersectWithLines(vtkPoints *starts, vtkPoints *ends, double tol,
+                          vtkPoints *points, vtkIdList *cellIds) override;
+  //@}
+
   //@{
   /**
    * Satisfy vtkLocator abstract interface.
@@ -171,13 +190,12 @@ protected:
   vtkCellLocator();
   ~vtkCellLocator() override;
 
-  void GetBucketNeighbors(int ijk[3], int ndivs, int level);
-  void GetOverlappingBuckets(const double x[3], int ijk[3], double dist,
+  void GetBucketNeighbors(vtkNeighborCells *buckets, int ijk[3], int ndivs,
+                          int level);
+  void GetOverlappingBuckets(vtkNeighborCells *buckets, const double x[3],
+                             int ijk[3], double dist,
                              int prevMinLevel[3], int prevMaxLevel[3]);
 
-  void ClearCellHasBeenVisited();
-  void ClearCellHasBeenVisited(int id);
-
   double Distance2ToBucket(const double x[3], int nei[3]);
   double Distance2ToBounds(const double x[3], double bounds[6]);
 
@@ -195,17 +213,16 @@ protected:
   void GenerateFace(int face, int numDivs, int i, int j, int k,
                     vtkPoints *pts, vtkCellArray *polys);
 
-  vtkNeighborCells *Buckets;
-  unsigned char *CellHasBeenVisited;
-  unsigned char QueryNumber;
+  // The per-thread scratch space of the queries
+  vtkCellLocatorThreadScratch *Scratch;
 
-  void ComputeOctantBounds(int i, int j, int k);
-  double OctantBounds[6]; //the bounds of the current octant
-  int IsInOctantBounds(const double x[3], double tol = 0.0)
+  void ComputeOctantBounds(int i, int j, int k, double octantBounds[6]);
+  int IsInOctantBounds(const double octantBounds[6], const double x[3],
+                       double tol = 0.0)
   {
-    if ( this->OctantBounds[0]-tol <= x[0] && x[0] <= this->OctantBounds[1]+tol &&
-         this->OctantBounds[2]-tol <= x[1] && x[1] <= this->OctantBounds[3]+tol &&
-         this->OctantBounds[4]-tol <= x[2] && x[2] <= this->OctantBounds[5]+tol )
+    if ( octantBounds[0]-tol <= x[0] && x[0] <= octantBounds[1]+tol &&
+         octantBounds[2]-tol <= x[1] && x[1] <= octantBounds[3]+tol &&
+         octantBounds[4]-tol <= x[2] && x[2] <= octantBounds[5]+tol )
     {
       return 1;
     }
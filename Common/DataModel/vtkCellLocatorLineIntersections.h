@@ -0,0 +1,98 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkCellLocatorLineIntersections.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkCellLocatorLineIntersections
+ * @brief   private helpers of the cell locators
+ *
+ * Helpers shared by the all-hits IntersectWithLine() of
+ * vtkStaticCellLocator and vtkBVHCellLocator. The locators gather the
+ * intersections of the line with their candidate cells, and the helpers
+ * order them along the line. This header is not installed.
+*/
+
+#ifndef vtkCellLocatorLineIntersections_h
+#define vtkCellLocatorLineIntersections_h
+
+#include "vtkDataSet.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+
+#include <algorithm>
+#include <vector>
+
+// An intersection of a line with a cell, ordered along the line.
+struct vtkCellLocatorLineIntersection
+{
+  double T;
+  double X[3];
+  vtkIdType CellId;
+
+  bool operator<(const vtkCellLocatorLineIntersection& hit) const
+  {
+    return this->T < hit.T;
+  }
+};
+
+// Sort the intersections of the line p1-p2 along the line and return them
+// in points and cellIds, either of which may be nullptr. Return 0 if there
+// is no intersection. For surfaces, the first intersection tells whether
+// the line starts inside (leaving through the first cell), in which case
+// -1 is returned, or outside. Otherwise 1 is returned.
+inline int vtkSortCellLocatorLineIntersections(
+  std::vector<vtkCellLocatorLineIntersection>& hits, vtkDataSet *dataSet,
+  const double p1[3], const double p2[3], vtkPoints *points,
+  vtkIdList *cellIds, vtkGenericCell *cell)
+{
+  std::sort(hits.begin(), hits.end());
+
+  vtkIdType numHits = static_cast<vtkIdType>(hits.size());
+  if ( points )
+  {
+    points->SetNumberOfPoints(numHits);
+    for (vtkIdType i=0; i < numHits; ++i)
+    {
+      points->SetPoint(i, hits[i].X);
+    }
+  }
+  if ( cellIds )
+  {
+    cellIds->SetNumberOfIds(numHits);
+    for (vtkIdType i=0; i < numHits; ++i)
+    {
+      cellIds->SetId(i, hits[i].CellId);
+    }
+  }
+
+  if ( numHits == 0 )
+  {
+    return 0;
+  }
+
+  dataSet->GetCell(hits[0].CellId, cell);
+  if ( cell->GetCellDimension() == 2 )
+  {
+    double normal[3], rayDir[3];
+    vtkMath::Subtract(p2, p1, rayDir);
+    vtkPolygon::ComputeNormal(cell->GetPoints(), normal);
+    return ( vtkMath::Dot(normal, rayDir) > 0.0 ? -1 : 1 );
+  }
+  return 1;
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkCellLocatorLineIntersections.h
@@ -65,13 +65,24 @@ vtkStandardNewMacro(vtkGenericCell);
 // Construct cell.
 vtkGenericCell::vtkGenericCell()
 {
-  this->Cell = vtkEmptyCell::New();
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+  {
+    this->CellStore[i] = nullptr;
+  }
+  this->CellStore[VTK_EMPTY_CELL] = vtkEmptyCell::New();
+  this->Cell = this->CellStore[VTK_EMPTY_CELL];
 }
 
 //----------------------------------------------------------------------------
 vtkGenericCell::~vtkGenericCell()
 {
-  this->Cell->Delete();
+  for (int i = 0; i < VTK_NUMBER_OF_CELL_TYPES; ++i)
+  {
+    if (this->CellStore[i])
+    {
+      this->CellStore[i]->Delete();
+    }
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -384,21 +395,35 @@ void vtkGenericCell::SetCellType(int cellType)
 {
   if ( this->Cell->GetCellType() != cellType )
   {
-    this->Points->UnRegister(this);
-    this->PointIds->UnRegister(this);
-    this->PointIds = nullptr;
-    this->Cell->Delete();
-
-    vtkCell *cell = vtkGenericCell::InstantiateCell(cellType);
-
-    if( !cell )
+    if ( cellType < 0 || cellType >= VTK_NUMBER_OF_CELL_TYPES )
     {
       vtkErrorMacro( << "Unsupported cell type: " << cellType
                      << " Setting to vtkEmptyCell" );
-      cell = vtkEmptyCell::New();
+      cellType = VTK_EMPTY_CELL;
+    }
+
+    // Keep the concrete cells around, they are reused when the cell type
+    // changes back.
+    if ( this->CellStore[cellType] == nullptr )
+    {
+      this->CellStore[cellType] = vtkGenericCell::InstantiateCell(cellType);
+      if ( this->CellStore[cellType] == nullptr )
+      {
+        vtkErrorMacro( << "Unsupported cell type: " << cellType
+                       << " Setting to vtkEmptyCell" );
+        cellType = VTK_EMPTY_CELL;
+      }
+    }
+    if ( this->Cell == this->CellStore[cellType] )
+    {
+      return;
     }
 
-    this->Cell = cell;
+    this->Points->UnRegister(this);
+    this->PointIds->UnRegister(this);
+    this->PointIds = nullptr;
+
+    this->Cell = this->CellStore[cellType];
     this->Points = this->Cell->Points;
     this->Points->Register(this);
     this->PointIds = this->Cell->PointIds;
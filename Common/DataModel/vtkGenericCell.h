@@ -116,7 +116,9 @@ public:
    * method. It allows vtkGenericCell to act like any cell type by
    * dereferencing an internal instance of a concrete cell type. When
    * you set the cell type, you are resetting a pointer to an internal
-   * cell which is then used for computation.
+   * cell which is then used for computation. The concrete cells are kept
+   * once instantiated, so that switching back and forth between cell types
+   * (e.g., when traversing a mesh with mixed cell types) does not allocate.
    */
   void SetCellType(int cellType);
   void SetCellTypeToEmptyCell() {this->SetCellType(VTK_EMPTY_CELL);}
@@ -182,6 +184,7 @@ protected:
   ~vtkGenericCell() override;
 
   vtkCell *Cell;
+  vtkCell *CellStore[VTK_NUMBER_OF_CELL_TYPES];
 
 private:
   vtkGenericCell(const vtkGenericCell&) = delete;
@@ -30,6 +30,7 @@
 #include "vtkPolyVertex.h"
 #include "vtkPolygon.h"
 #include "vtkQuad.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleStrip.h"
 #include "vtkVertex.h"
@@ -60,7 +61,7 @@ vtkPolyData::vtkPolyData () :
   Vertex(nullptr), PolyVertex(nullptr), Line(nullptr), PolyLine(nullptr),
   Triangle(nullptr), Quad(nullptr), Polygon(nullptr), TriangleStrip(nullptr),
   EmptyCell(nullptr), Verts(nullptr), Lines(nullptr), Polys(nullptr),
-  Strips(nullptr), Cells(nullptr), Links(nullptr)
+  Strips(nullptr), Cells(nullptr), Links(nullptr), Editable(true)
 {
   this->Information->Set(vtkDataObject::DATA_EXTENT_TYPE(), VTK_PIECES_EXTENT);
   this->Information->Set(vtkDataObject::DATA_PIECE_NUMBER(), -1);
@@ -1065,11 +1066,44 @@ void vtkPolyData::DeleteLinks()
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPolyData::SetEditable(bool editable)
+{
+  if ( this->Editable != editable )
+  {
+    this->DeleteLinks();
+    this->Editable = editable;
+    this->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+// The static links are valid as long as neither the points, the cell arrays
+// nor the polydata itself (e.g., SetPolys()) have been modified since they
+// were built. Attribute data modifications do not invalidate them.
+bool vtkPolyData::StaticLinksAreCurrent()
+{
+  if ( this->Editable || this->Links == nullptr )
+  {
+    return false;
+  }
+  vtkMTimeType time = vtkMath::Max(this->GetMeshMTime(),
+                                   this->vtkObject::GetMTime());
+  return this->LinksTime.GetMTime() > time;
+}
+
 //----------------------------------------------------------------------------
 // Create upward links from points to cells that use each point. Enables
 // topologically complex queries.
 void vtkPolyData::BuildLinks(int initialSize)
 {
+  // Static links may be shared with other polydata (see ShallowCopy()), so
+  // they are never rebuilt in place.
+  if ( this->StaticLinksAreCurrent() )
+  {
+    return;
+  }
+
   if ( this->Links )
   {
     this->DeleteLinks();
@@ -1080,19 +1114,68 @@ void vtkPolyData::BuildLinks(int initialSize)
     this->BuildCells();
   }
 
-  this->Links = vtkCellLinks::New();
+  if ( ! this->Editable )
+  {
+    vtkStaticCellLinks *links = vtkStaticCellLinks::New();
+    links->BuildLinks(this);
+    this->Links = links;
+    this->Links->Register(this);
+    this->Links->Delete();
+    this->LinksTime.Modified();
+    return;
+  }
+
+  vtkCellLinks *links = vtkCellLinks::New();
   if ( initialSize > 0 )
   {
-    this->Links->Allocate(initialSize);
+    links->Allocate(initialSize);
   }
   else
   {
-    this->Links->Allocate(this->GetNumberOfPoints());
+    links->Allocate(this->GetNumberOfPoints());
   }
+  this->Links = links;
   this->Links->Register(this);
   this->Links->Delete();
 
-  this->Links->BuildLinks(this);
+  links->BuildLinks(this);
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyData::GetStaticPointCells(vtkIdType ptId, unsigned short& ncells,
+                                      vtkIdType* &cells)
+{
+  vtkStaticCellLinks *links = static_cast<vtkStaticCellLinks*>(this->Links);
+  vtkIdType numCells = links->GetNcells(ptId);
+  if ( numCells > VTK_UNSIGNED_SHORT_MAX )
+  {
+    vtkWarningMacro("Point " << ptId << " is used by " << numCells
+                    << " cells; only the first " << VTK_UNSIGNED_SHORT_MAX
+                    << " are returned.");
+    numCells = VTK_UNSIGNED_SHORT_MAX;
+  }
+  ncells = static_cast<unsigned short>(numCells);
+  cells = const_cast<vtkIdType*>(links->GetCells(ptId));
+}
+
+//----------------------------------------------------------------------------
+// Static links, e.g. shared by a shallow copy of a polydata with Editable
+// off, cannot be edited. They are rebuilt as editable links first.
+vtkCellLinks *vtkPolyData::MakeLinksEditable()
+{
+  if ( ! this->Editable && this->Links )
+  {
+    vtkDebugMacro("Replacing the static links by editable links.");
+    this->SetEditable(true);
+    this->BuildLinks();
+  }
+  if ( ! this->Links )
+  {
+    vtkErrorMacro("The links must be built (BuildLinks()) before they are "
+                  "edited.");
+    return nullptr;
+  }
+  return static_cast<vtkCellLinks*>(this->Links);
 }
 
 //----------------------------------------------------------------------------
@@ -1127,7 +1210,7 @@ void vtkPolyData::GetCellPoints(vtkIdType cellId, vtkIdList *ptIds)
 void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
 {
   vtkIdType *cells;
-  vtkIdType numCells;
+  unsigned short numCells;
   vtkIdType i;
 
   if ( ! this->Links )
@@ -1136,8 +1219,7 @@ void vtkPolyData::GetPointCells(vtkIdType ptId, vtkIdList *cellIds)
   }
   cellIds->Reset();
 
-  numCells = this->Links->GetNcells(ptId);
-  cells = this->Links->GetCells(ptId);
+  this->GetPointCells(ptId, numCells, cells);
 
   for (i=0; i < numCells; i++)
   {
@@ -1467,7 +1549,8 @@ void vtkPolyData::ReverseCell(vtkIdType cellId)
 // use this method, make sure points are available and BuildLinks() has been invoked.)
 vtkIdType vtkPolyData::InsertNextLinkedPoint(int numLinks)
 {
-  return this->Links->InsertNextPoint(numLinks);
+  vtkCellLinks *links = this->GetEditableLinks();
+  return links ? links->InsertNextPoint(numLinks) : -1;
 }
 
 //----------------------------------------------------------------------------
@@ -1477,7 +1560,12 @@ vtkIdType vtkPolyData::InsertNextLinkedPoint(int numLinks)
 // and BuildLinks() has been invoked.)
 vtkIdType vtkPolyData::InsertNextLinkedPoint(double x[3], int numLinks)
 {
-  this->Links->InsertNextPoint(numLinks);
+  vtkCellLinks *links = this->GetEditableLinks();
+  if ( ! links )
+  {
+    return -1;
+  }
+  links->InsertNextPoint(numLinks);
   return this->Points->InsertNextPoint(x);
 }
 
@@ -1489,12 +1577,18 @@ vtkIdType vtkPolyData::InsertNextLinkedCell(int type, int npts, const vtkIdType
 {
   vtkIdType i, id;
 
+  vtkCellLinks *links = this->GetEditableLinks();
+  if ( ! links )
+  {
+    return -1;
+  }
+
   id = this->InsertNextCell(type,npts,pts);
 
   for (i=0; i<npts; i++)
   {
-    this->Links->ResizeCellList(pts[i],1);
-    this->Links->AddCellReference(id,pts[i]);
+    links->ResizeCellList(pts[i],1);
+    links->AddCellReference(id,pts[i]);
   }
 
   return id;
@@ -1507,7 +1601,10 @@ vtkIdType vtkPolyData::InsertNextLinkedCell(int type, int npts, const vtkIdType
 // operator ResizeCellList() to do this if necessary.
 void vtkPolyData::RemoveReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 {
-  this->Links->RemoveCellReference(cellId, ptId);
+  if ( vtkCellLinks *links = this->GetEditableLinks() )
+  {
+    links->RemoveCellReference(cellId, ptId);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1517,7 +1614,10 @@ void vtkPolyData::RemoveReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 // operator ResizeCellList() to do this if necessary.
 void vtkPolyData::AddReferenceToCell(vtkIdType ptId, vtkIdType cellId)
 {
-  this->Links->AddCellReference(cellId, ptId);
+  if ( vtkCellLinks *links = this->GetEditableLinks() )
+  {
+    links->AddCellReference(cellId, ptId);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1530,6 +1630,12 @@ void vtkPolyData::ReplaceCell(vtkIdType cellId, int npts, const vtkIdType pts[])
   vtkIdType loc;
   int type;
 
+  // Static links do not notice the change.
+  if ( ! this->Editable )
+  {
+    this->DeleteLinks();
+  }
+
   if ( this->Cells == nullptr )
   {
     this->BuildCells();
@@ -1569,6 +1675,12 @@ void vtkPolyData::ReplaceCell(vtkIdType cellId, int npts, const vtkIdType pts[])
 // link list is changing size.
 void vtkPolyData::ReplaceLinkedCell(vtkIdType cellId, int npts, const vtkIdType pts[])
 {
+  vtkCellLinks *links = this->GetEditableLinks();
+  if ( ! links )
+  {
+    return;
+  }
+
   vtkIdType loc = this->Cells->GetCellLocation(cellId);
   int type = this->Cells->GetCellType(cellId);
 
@@ -1596,7 +1708,7 @@ void vtkPolyData::ReplaceLinkedCell(vtkIdType cellId, int npts, const vtkIdType
 
   for (int i=0; i < npts; i++)
   {
-    this->Links->InsertNextCellReference(pts[i],cellId);
+    links->InsertNextCellReference(pts[i],cellId);
   }
 }
 
@@ -1609,14 +1721,13 @@ void vtkPolyData::GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1,
 {
   cellIds->Reset();
 
-  const vtkCellLinks::Link &link1(this->Links->GetLink(p1));
-  const vtkCellLinks::Link &link2(this->Links->GetLink(p2));
-
-  const vtkIdType *cells1 = link1.cells;
-  const vtkIdType *cells1End = cells1 + link1.ncells;
+  unsigned short ncells1, ncells2;
+  vtkIdType *cells1, *cells2;
+  this->GetPointCells(p1, ncells1, cells1);
+  this->GetPointCells(p2, ncells2, cells2);
 
-  const vtkIdType *cells2 = link2.cells;
-  const vtkIdType *cells2End = cells2 + link2.ncells;
+  const vtkIdType *cells1End = cells1 + ncells1;
+  const vtkIdType *cells2End = cells2 + ncells2;
 
   while (cells1 != cells1End)
   {
@@ -1653,8 +1764,9 @@ void vtkPolyData::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
 
   // load list with candidate cells, remove current cell
   vtkIdType ptId = ptIds->GetId(0);
-  int numPrime = this->Links->GetNcells(ptId);
-  vtkIdType *primeCells = this->Links->GetCells(ptId);
+  unsigned short numPrime;
+  vtkIdType *primeCells;
+  this->GetPointCells(ptId, numPrime, primeCells);
   numPts = ptIds->GetNumberOfIds();
 
   // for each potential cell
@@ -1667,8 +1779,9 @@ void vtkPolyData::GetCellNeighbors(vtkIdType cellId, vtkIdList *ptIds,
       for (allFound=1, i=1; i < numPts && allFound; i++)
       {
         ptId = ptIds->GetId(i);
-        int numCurrent = this->Links->GetNcells(ptId);
-        vtkIdType *currentCells = this->Links->GetCells(ptId);
+        unsigned short numCurrent;
+        vtkIdType *currentCells;
+        this->GetPointCells(ptId, numCurrent, currentCells);
         oneFound = 0;
         for (j = 0; j < numCurrent; j++)
         {
@@ -1792,7 +1905,14 @@ unsigned long vtkPolyData::GetActualMemorySize()
   }
   if ( this->Links )
   {
-    size += this->Links->GetActualMemorySize();
+    if ( this->Editable )
+    {
+      size += static_cast<vtkCellLinks*>(this->Links)->GetActualMemorySize();
+    }
+    else
+    {
+      size += static_cast<vtkStaticCellLinks*>(this->Links)->GetActualMemorySize();
+    }
   }
   return size;
 }
@@ -1824,17 +1944,25 @@ void vtkPolyData::ShallowCopy(vtkDataObject *dataObject)
 
     if (this->Links)
     {
-      this->Links->Delete();
+      this->Links->UnRegister(this);
     }
     this->Links = polyData->Links;
     if (this->Links)
     {
       this->Links->Register(this);
     }
+    this->Editable = polyData->Editable;
   }
 
   // Do superclass
   this->vtkPointSet::ShallowCopy(dataObject);
+
+  // Static links that are up to date are shared with the copy without
+  // being rebuilt.
+  if ( polyData != nullptr && polyData->StaticLinksAreCurrent() )
+  {
+    this->LinksTime.Modified();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -1885,6 +2013,7 @@ void vtkPolyData::DeepCopy(vtkDataObject *dataObject)
       this->Links->UnRegister(this);
       this->Links = nullptr;
     }
+    this->Editable = polyData->Editable;
     if (polyData->Links)
     {
       this->BuildLinks();
@@ -2106,6 +2235,7 @@ void vtkPolyData::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Number Of Pieces: " << this->GetNumberOfPieces() << endl;
   os << indent << "Piece: " << this->GetPiece() << endl;
   os << indent << "Ghost Level: " << this->GetGhostLevel() << endl;
+  os << indent << "Editable: " << (this->Editable ? "On" : "Off") << endl;
 }
 
 
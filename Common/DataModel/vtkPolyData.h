@@ -53,6 +53,20 @@
  * (vtkDecimatePro expects triangles or triangle strips; vtkTubeFilter
  * expects lines). Read the documentation for each filter carefully to
  * understand how each part of vtkPolyData is processed.
+ *
+ * @warning
+ * The upward links from points to cells (see BuildLinks()) are either
+ * editable (vtkCellLinks), which supports the topological editing methods
+ * such as InsertNextLinkedCell() or RemoveCellReference(), or static
+ * (vtkStaticCellLinks), which are built in parallel and use much less
+ * memory. Filters which only query the topology should turn Editable off.
+ * The editing methods replace static links by editable ones, turning
+ * Editable back on.
+ *
+ * @warning
+ * The protected Links member is a vtkAbstractCellLinks rather than a
+ * vtkCellLinks. Subclasses which accessed it directly must check Editable
+ * before casting it to vtkCellLinks.
 */
 
 #ifndef vtkPolyData_h
@@ -261,14 +275,38 @@ public:
    */
   bool NeedToBuildCells() { return this->Cells == nullptr; }
 
+  //@{
+  /**
+   * Specify whether the upward links built by BuildLinks() may be edited.
+   * If on (the default), the links are represented by a vtkCellLinks,
+   * which supports the topological editing methods (InsertNextLinkedCell(),
+   * ReplaceLinkedCell(), RemoveCellReference(), DeletePoint(), etc.). If
+   * off, the links are represented by a vtkStaticCellLinks, which is built
+   * in parallel, is more compact, and is reused by BuildLinks() as long as
+   * the points and cells are not modified. Changing this flag deletes the
+   * links.
+   */
+  void SetEditable(bool editable);
+  vtkGetMacro(Editable,bool);
+  vtkBooleanMacro(Editable,bool);
+  //@}
+
   /**
    * Create upward links from points to cells that use each point. Enables
    * topologically complex queries. Normally the links array is allocated
    * based on the number of points in the vtkPolyData. The optional
-   * initialSize parameter can be used to allocate a larger size initially.
+   * initialSize parameter can be used to allocate a larger size initially
+   * (editable links only). If the links are not editable and have already
+   * been built for the current points and cells, this method does nothing.
    */
   void BuildLinks(int initialSize=0);
 
+  /**
+   * Return the links built by BuildLinks(): a vtkCellLinks if Editable is
+   * on, a vtkStaticCellLinks otherwise. May be nullptr.
+   */
+  vtkAbstractCellLinks *GetCellLinks() {return this->Links;}
+
   /**
    * Release data structure that allows random access of the cells. This must
    * be done before a 2nd call to BuildLinks(). DeleteCells implicitly deletes
@@ -338,11 +376,13 @@ public:
    * operator is (typically) used when links from points to cells have not been
    * built (i.e., BuildLinks() has not been executed). Use the operator
    * ReplaceLinkedCell() to replace a cell when cell structure has been built.
+   * Static links (Editable off) are released, as they no longer match.
    */
   void ReplaceCell(vtkIdType cellId, int npts, const vtkIdType pts[]) VTK_SIZEHINT(pts, npts);
 
   /**
    * Replace a point in the cell connectivity list with a different point.
+   * Static links (Editable off) are released, as they no longer match.
    */
   void ReplaceCellPoint(vtkIdType cellId, vtkIdType oldPtId,
                         vtkIdType newPtId);
@@ -374,8 +414,9 @@ public:
    * Add a point to the cell data structure (after cell pointers have been
    * built). This method adds the point and then allocates memory for the
    * links to the cells.  (To use this method, make sure points are available
-   * and BuildLinks() has been invoked.) Of the two methods below, one inserts
-   * a point coordinate and the other just makes room for cell links.
+   * and BuildLinks() has been invoked with Editable on.) Of the two methods
+   * below, one inserts a point coordinate and the other just makes room for
+   * cell links.
    */
   vtkIdType InsertNextLinkedPoint(int numLinks);
   vtkIdType InsertNextLinkedPoint(double x[3], int numLinks);
@@ -384,7 +425,8 @@ public:
   /**
    * Add a new cell to the cell data structure (after cell pointers have been
    * built). This method adds the cell and then updates the links from the
-   * points to the cells. (Memory is allocated as necessary.)
+   * points to the cells. (Memory is allocated as necessary. The links must be
+   * editable.)
    */
   vtkIdType InsertNextLinkedCell(int type, int npts, const vtkIdType pts[]) VTK_SIZEHINT(pts, npts);
 
@@ -563,7 +605,9 @@ protected:
   // supporting structures for more complex topological operations
   // built only when necessary
   vtkCellTypes *Cells;
-  vtkCellLinks *Links;
+  vtkAbstractCellLinks *Links;
+  bool Editable;
+  vtkTimeStamp LinksTime;
 
 private:
   // Hide these from the user and the compiler.
@@ -576,6 +620,19 @@ private:
 
   void Cleanup();
 
+  // Access to the static links, which are not defined in this header.
+  void GetStaticPointCells(vtkIdType ptId, unsigned short& ncells,
+                           vtkIdType* &cells);
+
+  // Whether the links are static and still match the points and cells.
+  bool StaticLinksAreCurrent();
+
+  // The links as a vtkCellLinks, for the topological editing methods.
+  // Static links are first replaced by editable ones (see
+  // MakeLinksEditable()). Returns nullptr if the links were never built.
+  vtkCellLinks *GetEditableLinks();
+  vtkCellLinks *MakeLinksEditable();
+
 private:
   vtkPolyData(const vtkPolyData&) = delete;
   void operator=(const vtkPolyData&) = delete;
@@ -584,8 +641,25 @@ private:
 inline void vtkPolyData::GetPointCells(vtkIdType ptId, unsigned short& ncells,
                                        vtkIdType* &cells)
 {
-  ncells = this->Links->GetNcells(ptId);
-  cells = this->Links->GetCells(ptId);
+  if ( this->Editable )
+  {
+    vtkCellLinks *links = static_cast<vtkCellLinks*>(this->Links);
+    ncells = links->GetNcells(ptId);
+    cells = links->GetCells(ptId);
+  }
+  else
+  {
+    this->GetStaticPointCells(ptId, ncells, cells);
+  }
+}
+
+inline vtkCellLinks *vtkPolyData::GetEditableLinks()
+{
+  if ( this->Editable && this->Links )
+  {
+    return static_cast<vtkCellLinks*>(this->Links);
+  }
+  return this->MakeLinksEditable();
 }
 
 inline int vtkPolyData::IsTriangle(int v1, int v2, int v3)
@@ -636,7 +710,10 @@ inline int vtkPolyData::IsPointUsedByCell(vtkIdType ptId, vtkIdType cellId)
 
 inline void vtkPolyData::DeletePoint(vtkIdType ptId)
 {
-  this->Links->DeletePoint(ptId);
+  if ( vtkCellLinks *links = this->GetEditableLinks() )
+  {
+    links->DeletePoint(ptId);
+  }
 }
 
 inline void vtkPolyData::DeleteCell(vtkIdType cellId)
@@ -646,29 +723,42 @@ inline void vtkPolyData::DeleteCell(vtkIdType cellId)
 
 inline void vtkPolyData::RemoveCellReference(vtkIdType cellId)
 {
-  vtkIdType *pts, npts;
+  vtkCellLinks *links = this->GetEditableLinks();
+  if ( ! links )
+  {
+    return;
+  }
 
+  vtkIdType *pts, npts;
   this->GetCellPoints(cellId, npts, pts);
   for (vtkIdType i=0; i<npts; i++)
   {
-    this->Links->RemoveCellReference(cellId, pts[i]);
+    links->RemoveCellReference(cellId, pts[i]);
   }
 }
 
 inline void vtkPolyData::AddCellReference(vtkIdType cellId)
 {
-  vtkIdType *pts, npts;
+  vtkCellLinks *links = this->GetEditableLinks();
+  if ( ! links )
+  {
+    return;
+  }
 
+  vtkIdType *pts, npts;
   this->GetCellPoints(cellId, npts, pts);
   for (vtkIdType i=0; i<npts; i++)
   {
-    this->Links->AddCellReference(cellId, pts[i]);
+    links->AddCellReference(cellId, pts[i]);
   }
 }
 
 inline void vtkPolyData::ResizeCellList(vtkIdType ptId, int size)
 {
-  this->Links->ResizeCellList(ptId,size);
+  if ( vtkCellLinks *links = this->GetEditableLinks() )
+  {
+    links->ResizeCellList(ptId,size);
+  }
 }
 
 inline void vtkPolyData::ReplaceCellPoint(vtkIdType cellId, vtkIdType oldPtId,
@@ -677,6 +767,12 @@ inline void vtkPolyData::ReplaceCellPoint(vtkIdType cellId, vtkIdType oldPtId,
   int i;
   vtkIdType *verts, nverts;
 
+  // Static links do not notice the change.
+  if ( ! this->Editable )
+  {
+    this->DeleteLinks();
+  }
+
   this->GetCellPoints(cellId,nverts,verts);
   for ( i=0; i < nverts; i++ )
   {
@@ -95,6 +95,23 @@ public:
   void Initialize()
     {this->Impl->Initialize();}
 
+  //@{
+  /**
+   * Return the number of points and cells of the dataset the links were
+   * built from.
+   */
+  vtkIdType GetNumberOfPoints()
+    {return this->Impl->GetNumberOfPoints();}
+  vtkIdType GetNumberOfCells()
+    {return this->Impl->GetNumberOfCells();}
+  //@}
+
+  /**
+   * Return the memory in kibibytes (1024 bytes) consumed by the links.
+   */
+  unsigned long GetActualMemorySize()
+    {return this->Impl->GetActualMemorySize();}
+
 protected:
   vtkStaticCellLinks();
   ~vtkStaticCellLinks() override;
@@ -38,6 +38,11 @@
  * although it uses vtkIdType and thereby loses some speed and memory
  * advantage.
  *
+ * @warning
+ * The links are built in parallel using vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkCellLinks vtkStaticCellLinks
 */
@@ -45,6 +50,8 @@
 #ifndef vtkStaticCellLinksTemplate_h
 #define vtkStaticCellLinksTemplate_h
 
+#include "vtkType.h" // For vtkIdType
+
 class vtkDataSet;
 class vtkPolyData;
 class vtkUnstructuredGrid;
@@ -105,7 +112,32 @@ public:
       return this->Links + this->Offsets[ptId];
   }
 
+  //@{
+  /**
+   * Return the number of points and cells, and the total number of links,
+   * of the dataset the links were built from.
+   */
+  vtkIdType GetNumberOfPoints() const
+    { return static_cast<vtkIdType>(this->NumPts); }
+  vtkIdType GetNumberOfCells() const
+    { return static_cast<vtkIdType>(this->NumCells); }
+  vtkIdType GetLinksSize() const
+    { return static_cast<vtkIdType>(this->LinksSize); }
+  //@}
+
+  /**
+   * Return the memory in kibibytes (1024 bytes) consumed by the links.
+   */
+  unsigned long GetActualMemorySize() const
+  {
+    return static_cast<unsigned long>(
+      (sizeof(TIds)*(this->LinksSize + this->NumPts + 2) + 1023) / 1024);
+  }
+
 protected:
+  // Build the links through random access to the cells of a dataset.
+  template <typename TCells> void BuildLinksFromCells(TCells *cells);
+
   // The various templated data members
   TIds LinksSize;
   TIds NumPts;
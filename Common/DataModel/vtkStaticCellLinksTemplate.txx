@@ -17,16 +17,203 @@
 #ifndef vtkStaticCellLinksTemplate_txx
 #define vtkStaticCellLinksTemplate_txx
 
+#include "vtkAtomicTypes.h"
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <type_traits>
+
 //----------------------------------------------------------------------------
-// Note: this class is a faster, serial version of vtkCellLinks. Future work
-// to parallelize this class is possible. This includes:
-// = using a parallel prefix sum operation
-// = using atomics to update counts (i.e., number of cells using a point)
+// The links are built in parallel in three passes: the number of uses of
+// each point is counted with atomics, a prefix sum of the counts gives the
+// offsets, and then the cell ids are inserted using the counts as atomic
+// cursors. Since threads insert the cells in arbitrary order, each run of
+// cell ids is finally sorted so that the links are identical to a serial
+// build (i.e., cell ids in ascending order). When only one thread is
+// available, plain counters are used and the sort is skipped.
+namespace vtkSCLT_detail
+{
+
+// vtkAtomic only supports 32 and 64 bit integers.
+template <typename TIds> struct CountType
+{
+  typedef typename std::conditional<(sizeof(TIds) < 4),
+                                    vtkTypeInt32, TIds>::type Type;
+};
+
+// Random access to the cells of an unstructured grid.
+struct UGridCells
+{
+  const vtkIdType *Connectivity;
+  const vtkIdType *Locations;
+
+  UGridCells(vtkUnstructuredGrid *ugrid) :
+    Connectivity(ugrid->GetCells()->GetPointer()),
+    Locations(ugrid->GetCellLocationsArray()->GetPointer(0))
+  {
+  }
+
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts)
+  {
+    const vtkIdType *cell = this->Connectivity + this->Locations[cellId];
+    npts = *cell;
+    pts = cell + 1;
+  }
+};
+
+// Random access to the cells of a polydata. BuildCells() must have been
+// invoked.
+struct PolyCells
+{
+  vtkPolyData *PolyData;
+
+  PolyCells(vtkPolyData *pd) : PolyData(pd) {}
+
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts)
+  {
+    vtkIdType *cellPts;
+    this->PolyData->GetCellPoints(cellId, npts, cellPts);
+    pts = cellPts;
+  }
+};
+
+// Access to the cells of any dataset through a thread local id list.
+struct DataSetCells
+{
+  vtkDataSet *DataSet;
+  vtkSMPThreadLocalObject<vtkIdList> CellPts;
+
+  DataSetCells(vtkDataSet *ds) : DataSet(ds) {}
+
+  void GetCellPoints(vtkIdType cellId, vtkIdType &npts, const vtkIdType* &pts)
+  {
+    vtkIdList *cellPts = this->CellPts.Local();
+    this->DataSet->GetCellPoints(cellId, cellPts);
+    npts = cellPts->GetNumberOfIds();
+    pts = cellPts->GetPointer(0);
+  }
+};
+
+// Count the number of cells using each point.
+template <typename TCount, typename TCells>
+struct CountUses
+{
+  TCells *Cells;
+  TCount *Counts;
+
+  CountUses(TCells *cells, TCount *counts) : Cells(cells), Counts(counts) {}
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdType npts;
+    const vtkIdType *pts;
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      this->Cells->GetCellPoints(cellId, npts, pts);
+      for (vtkIdType i=0; i < npts; ++i)
+      {
+        ++this->Counts[pts[i]];
+      }
+    }
+  }
+};
+
+// Insert the cell ids into the runs of the points they use. The counts are
+// decremented as the cells are inserted, so that each run is filled from
+// its beginning.
+template <typename TIds, typename TCount, typename TCells>
+struct InsertLinks
+{
+  TCells *Cells;
+  TCount *Counts;
+  const TIds *Offsets;
+  TIds *Links;
+
+  InsertLinks(TCells *cells, TCount *counts, const TIds *offsets, TIds *links) :
+    Cells(cells), Counts(counts), Offsets(offsets), Links(links)
+  {
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdType npts, ptId;
+    const vtkIdType *pts;
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      this->Cells->GetCellPoints(cellId, npts, pts);
+      for (vtkIdType i=0; i < npts; ++i)
+      {
+        ptId = pts[i];
+        this->Links[this->Offsets[ptId+1] - (this->Counts[ptId]--)] =
+          static_cast<TIds>(cellId);
+      }
+    }
+  }
+};
+
+// Sort the runs of cell ids that were filled out of order.
+template <typename TIds>
+struct SortLinks
+{
+  const TIds *Offsets;
+  TIds *Links;
+
+  SortLinks(const TIds *offsets, TIds *links) : Offsets(offsets), Links(links) {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for ( ; ptId < endPtId; ++ptId )
+    {
+      TIds *begin = this->Links + this->Offsets[ptId];
+      TIds *end = this->Links + this->Offsets[ptId+1];
+      if ( ! std::is_sorted(begin, end) )
+      {
+        std::sort(begin, end);
+      }
+    }
+  }
+};
+
+// Build the offsets and links of the cells, using either atomic or plain
+// counters.
+template <typename TIds, typename TCount, typename TCells>
+void BuildLinks(TCells *cells, vtkIdType numPts, vtkIdType numCells,
+                TIds *offsets, TIds *links, bool sort)
+{
+  // Count number of point uses
+  TCount *counts = new TCount[numPts];
+  std::fill_n(counts, numPts, 0);
+  CountUses<TCount,TCells> count(cells, counts);
+  vtkSMPTools::For(0, numCells, count);
+
+  // Perform prefix sum
+  offsets[0] = 0;
+  for ( vtkIdType ptId=0; ptId < numPts; ++ptId )
+  {
+    offsets[ptId+1] = offsets[ptId] + static_cast<TIds>(counts[ptId]);
+  }
+
+  // Now build the links. The offsets indicate where the cells are to be
+  // inserted, the counts where in each run.
+  InsertLinks<TIds,TCount,TCells> insert(cells, counts, offsets, links);
+  vtkSMPTools::For(0, numCells, insert);
+  delete [] counts;
+
+  if ( sort )
+  {
+    SortLinks<TIds> sortLinks(offsets, links);
+    vtkSMPTools::For(0, numPts, sortLinks);
+  }
+}
+
+} //namespace vtkSCLT_detail
 
 //----------------------------------------------------------------------------
 // Clean up any previously allocated memory
@@ -43,6 +230,35 @@ Initialize()
     delete [] this->Offsets;
     this->Offsets = nullptr;
   }
+  this->LinksSize = 0;
+  this->NumPts = 0;
+  this->NumCells = 0;
+}
+
+//----------------------------------------------------------------------------
+// Build the links from random access to the cells. The size of the links
+// array (LinksSize) must have been set beforehand.
+template <typename TIds> template <typename TCells>
+void vtkStaticCellLinksTemplate<TIds>::
+BuildLinksFromCells(TCells *cells)
+{
+  typedef typename vtkSCLT_detail::CountType<TIds>::Type TCount;
+
+  // Extra one allocated to simplify later pointer manipulation
+  this->Links = new TIds[this->LinksSize+1];
+  this->Links[this->LinksSize] = this->NumPts;
+  this->Offsets = new TIds[this->NumPts+1];
+
+  if ( vtkSMPTools::GetEstimatedNumberOfThreads() > 1 )
+  {
+    vtkSCLT_detail::BuildLinks<TIds,vtkAtomic<TCount>,TCells>(
+      cells, this->NumPts, this->NumCells, this->Offsets, this->Links, true);
+  }
+  else
+  {
+    vtkSCLT_detail::BuildLinks<TIds,TCount,TCells>(
+      cells, this->NumPts, this->NumCells, this->Offsets, this->Links, false);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -65,57 +281,23 @@ BuildLinks(vtkDataSet *ds)
   // Any other type of dataset. Generally this is not called as datasets have
   // their own, more efficient ways of getting similar information.
   // Make sure that we clear out previous allocation.
+  this->Initialize();
   this->NumCells = ds->GetNumberOfCells();
   this->NumPts = ds->GetNumberOfPoints();
 
-  vtkIdType npts, ptId;
-  vtkIdType cellId, j;
+  // Traverse data to count the number of links to allocate. This also
+  // makes sure that GetCellPoints() is thread safe afterwards.
+  vtkIdType cellId;
   vtkIdList *cellPts = vtkIdList::New();
-
-  // Traverse data to determine number of uses of each point. Also count the
-  // number of links to allocate.
-  this->Offsets = new TIds[this->NumPts+1];
-  std::fill_n(this->Offsets, this->NumPts, 0);
-
   for (this->LinksSize=0, cellId=0; cellId < this->NumCells; cellId++)
   {
     ds->GetCellPoints(cellId,cellPts);
-    npts = cellPts->GetNumberOfIds();
-    for (j=0; j < npts; j++)
-    {
-      this->Offsets[cellPts->GetId(j)]++;
-      this->LinksSize++;
-    }
+    this->LinksSize += cellPts->GetNumberOfIds();
   }
-
-  // Allocate space for links. Perform prefix sum.
-  this->Links = new TIds[this->LinksSize+1];
-  this->Links[this->LinksSize] = this->NumPts;
-
-  for ( ptId=0; ptId < this->NumPts; ++ptId )
-  {
-    npts = this->Offsets[ptId+1];
-    this->Offsets[ptId+1] = this->Offsets[ptId] + npts;
-  }
-
-  // Now build the links. The summation from the prefix sum indicates where
-  // the cells are to be inserted. Each time a cell is inserted, the offset
-  // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for ( cellId=0; cellId < this->NumCells; ++cellId )
-  {
-    ds->GetCellPoints(cellId,cellPts);
-    npts = cellPts->GetNumberOfIds();
-    for (j=0; j<npts; ++j)
-    {
-      ptId = cellPts->GetId(j);
-      this->Offsets[ptId]--;
-      this->Links[this->Offsets[ptId]] = cellId;
-    }
-  }
-  this->Offsets[this->NumPts] = this->LinksSize;
-
   cellPts->Delete();
+
+  vtkSCLT_detail::DataSetCells cells(ds);
+  this->BuildLinksFromCells(&cells);
 }
 
 //----------------------------------------------------------------------------
@@ -124,150 +306,65 @@ template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
 BuildLinks(vtkUnstructuredGrid *ugrid)
 {
   // Basic information about the grid
+  this->Initialize();
   this->NumCells = ugrid->GetNumberOfCells();
   this->NumPts = ugrid->GetNumberOfPoints();
 
   // We're going to get into the guts of the class
   vtkCellArray *cellArray = ugrid->GetCells();
-  const vtkIdType *cells = cellArray->GetPointer();
+  if ( cellArray == nullptr || this->NumCells < 1 )
+  {
+    this->NumCells = 0;
+    vtkSCLT_detail::DataSetCells cells(ugrid);
+    this->BuildLinksFromCells(&cells);
+    return;
+  }
 
   // I love this trick: the size of the Links array is equal to
   // the size of the cell array, minus the number of cells.
   this->LinksSize =
     cellArray->GetNumberOfConnectivityEntries() - this->NumCells;
 
-  // Extra one allocated to simplify later pointer manipulation
-  this->Links = new TIds[this->LinksSize+1];
-  this->Links[this->LinksSize] = this->NumPts;
-  this->Offsets = new TIds[this->NumPts+1];
-  std::fill_n(this->Offsets, this->NumPts, 0);
-
-  // Now create the links.
-  vtkIdType npts, cellId, ptId;
-  const vtkIdType *cell=cells;
-  int i;
-
-  // Count number of point uses
-  for ( cellId=0; cellId < this->NumCells; ++cellId )
-  {
-    npts = *cell++;
-    for (i=0; i<npts; ++i)
-    {
-      this->Offsets[*cell++]++;
-    }
-  }
-
-  // Perform prefix sum
-  for ( ptId=0; ptId < this->NumPts; ++ptId )
-  {
-    npts = this->Offsets[ptId+1];
-    this->Offsets[ptId+1] = this->Offsets[ptId] + npts;
-  }
-
-  // Now build the links. The summation from the prefix sum indicates where
-  // the cells are to be inserted. Each time a cell is inserted, the offset
-  // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for ( cell=cells, cellId=0; cellId < this->NumCells; ++cellId )
-  {
-    npts = *cell++;
-    for (i=0; i<npts; ++i)
-    {
-      this->Offsets[*cell]--;
-      this->Links[this->Offsets[*cell++]] = cellId;
-    }
-  }
-  this->Offsets[this->NumPts] = this->LinksSize;
+  vtkSCLT_detail::UGridCells cells(ugrid);
+  this->BuildLinksFromCells(&cells);
 }
 
 //----------------------------------------------------------------------------
 // Build the link list array for poly data. This is more complex because there
-// are potentially fout different cell arrays to contend with.
+// are potentially four different cell arrays to contend with; they are
+// accessed through the polydata's cell types (see vtkPolyData::BuildCells()).
 template <typename TIds> void vtkStaticCellLinksTemplate<TIds>::
 BuildLinks(vtkPolyData *pd)
 {
   // Basic information about the grid
+  this->Initialize();
   this->NumCells = pd->GetNumberOfCells();
   this->NumPts = pd->GetNumberOfPoints();
 
   vtkCellArray *cellArrays[4];
-  vtkIdType numCells[4];
-  vtkIdType sizes[4];
-  int i, j;
-
   cellArrays[0] = pd->GetVerts();
   cellArrays[1] = pd->GetLines();
   cellArrays[2] = pd->GetPolys();
   cellArrays[3] = pd->GetStrips();
 
-  for (i=0; i<4; ++i)
+  this->LinksSize = 0;
+  for (int i=0; i<4; ++i)
   {
     if ( cellArrays[i] != nullptr )
     {
-      numCells[i] = cellArrays[i]->GetNumberOfCells();
-      sizes[i] = cellArrays[i]->GetNumberOfConnectivityEntries() - numCells[i];
-    }
-    else
-    {
-      numCells[i] = 0;
-      sizes[i] = 0;
+      this->LinksSize += cellArrays[i]->GetNumberOfConnectivityEntries() -
+        cellArrays[i]->GetNumberOfCells();
     }
   }//for the four polydata arrays
 
-  // Allocate
-  this->LinksSize = sizes[0] + sizes[1] + sizes[2] + sizes[3];
-  this->Links = new TIds[this->LinksSize+1];
-  this->Links[this->LinksSize] = this->NumPts;
-  this->Offsets = new TIds[this->NumPts+1];
-  this->Offsets[this->NumPts] = this->LinksSize;
-  std::fill_n(this->Offsets, this->NumPts, 0);
-
-  // Now create the links.
-  vtkIdType npts, cellId, CellId, ptId;
-  const vtkIdType *cell;
-
-  // Visit the four arrays
-  for ( CellId=0, j=0; j < 4; ++j )
-  {
-    // Count number of point uses
-    cell = cellArrays[j]->GetPointer();
-    for ( cellId=0; cellId < numCells[j]; ++cellId )
-    {
-      npts = *cell++;
-      for (i=0; i<npts; ++i)
-      {
-        this->Offsets[CellId+(*cell++)]++;
-      }
-    }
-    CellId += numCells[j];
-  } //for each of the four polydata cell arrays
-
-  // Perform prefix sum
-  for ( ptId=0; ptId < this->NumPts; ++ptId )
+  // Random access to the cells must be available before threading
+  if ( this->NumCells > 0 && pd->NeedToBuildCells() )
   {
-    npts = this->Offsets[ptId+1];
-    this->Offsets[ptId+1] = this->Offsets[ptId] + npts;
+    pd->BuildCells();
   }
 
-  // Now build the links. The summation from the prefix sum indicates where
-  // the cells are to be inserted. Each time a cell is inserted, the offset
-  // is decremented. In the end, the offset array is also constructed as it
-  // points to the beginning of each cell run.
-  for ( CellId=0, j=0; j < 4; ++j )
-  {
-    cell = cellArrays[j]->GetPointer();
-    for ( cellId=0; cellId < numCells[j]; ++cellId )
-    {
-      npts = *cell++;
-      for (i=0; i<npts; ++i)
-      {
-        this->Offsets[*cell]--;
-        this->Links[this->Offsets[*cell++]] = CellId+cellId;
-      }
-    }
-    CellId += numCells[j];
-  }//for each of the four polydata arrays
-  this->Offsets[this->NumPts] = this->LinksSize;
+  vtkSCLT_detail::PolyCells cells(pd);
+  this->BuildLinksFromCells(&cells);
 }
 
 #endif
@@ -15,12 +15,14 @@
 #include "vtkStaticCellLocator.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellLocatorLineIntersections.h"
 #include "vtkIdList.h"
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkPolygon.h"
 #include "vtkGenericCell.h"
 #include "vtkDoubleArray.h"
 #include "vtkMergePoints.h"
@@ -30,6 +32,10 @@
 #include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
 vtkStandardNewMacro(vtkStaticCellLocator);
 
 //----------------------------------------------------------------------------
@@ -203,6 +209,88 @@ struct vtkCellBinner
 
 }; //vtkCellBinner
 
+// Recompute the bounds of the cells after they have moved. Cells whose
+// range of bins has changed are flagged; cells which left the bounds of the
+// locator are detected.
+struct vtkCellRebinner
+{
+  vtkCellBinner *Binner;
+  double *NewBounds;
+  unsigned char *Changed;
+  vtkSMPThreadLocal<vtkIdType> NumChanged;
+  vtkSMPThreadLocal<unsigned char> Outside;
+  vtkIdType TotalChanged;
+  bool AnyOutside;
+
+  vtkCellRebinner(vtkCellBinner *cb, double *newBounds, unsigned char *changed) :
+    Binner(cb), NewBounds(newBounds), Changed(changed), TotalChanged(0),
+    AnyOutside(false)
+  {
+  }
+
+  void Initialize()
+  {
+    this->NumChanged.Local() = 0;
+    this->Outside.Local() = 0;
+  }
+
+  void operator() (vtkIdType cellId, vtkIdType endCellId)
+  {
+    const double *lb = this->Binner->Bounds;
+    const double *oldBds = this->Binner->CellBounds + cellId*6;
+    double *bds = this->NewBounds + cellId*6;
+    vtkIdType &numChanged = this->NumChanged.Local();
+    unsigned char &outside = this->Outside.Local();
+    double xmin[3], xmax[3];
+    int ijkMin[3], ijkMax[3], oldMin[3], oldMax[3];
+
+    for ( ; cellId < endCellId; ++cellId, bds+=6, oldBds+=6 )
+    {
+      this->Binner->DataSet->GetCellBounds(cellId,bds);
+      if ( bds[0] < lb[0] || bds[1] > lb[1] || bds[2] < lb[2] ||
+           bds[3] > lb[3] || bds[4] < lb[4] || bds[5] > lb[5] )
+      {
+        outside = 1;
+      }
+
+      xmin[0] = bds[0]; xmin[1] = bds[2]; xmin[2] = bds[4];
+      xmax[0] = bds[1]; xmax[1] = bds[3]; xmax[2] = bds[5];
+      this->Binner->GetBinIndices(xmin,ijkMin);
+      this->Binner->GetBinIndices(xmax,ijkMax);
+
+      xmin[0] = oldBds[0]; xmin[1] = oldBds[2]; xmin[2] = oldBds[4];
+      xmax[0] = oldBds[1]; xmax[1] = oldBds[3]; xmax[2] = oldBds[5];
+      this->Binner->GetBinIndices(xmin,oldMin);
+      this->Binner->GetBinIndices(xmax,oldMax);
+
+      this->Changed[cellId] = 0;
+      for (int i=0; i < 3; ++i)
+      {
+        if ( ijkMin[i] != oldMin[i] || ijkMax[i] != oldMax[i] )
+        {
+          this->Changed[cellId] = 1;
+          ++numChanged;
+          break;
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    for ( vtkSMPThreadLocal<vtkIdType>::iterator iter=this->NumChanged.begin();
+          iter != this->NumChanged.end(); ++iter )
+    {
+      this->TotalChanged += *iter;
+    }
+    for ( vtkSMPThreadLocal<unsigned char>::iterator iter=this->Outside.begin();
+          iter != this->Outside.end(); ++iter )
+    {
+      this->AnyOutside = this->AnyOutside || (*iter != 0);
+    }
+  }
+}; //vtkCellRebinner
+
 //-----------------------------------------------------------------------------
 // The following tuple is what is sorted in the map. Note that it is templated
 // because depending on the number of points / buckets to process we may want
@@ -264,8 +352,18 @@ struct vtkCellProcessor
                                 double& t, double x[3], double pcoords[3],
                                 int &subId, vtkIdType &cellId,
                                 vtkGenericCell *cell) = 0;
+  virtual int IntersectWithLine(const double a0[3], const double a1[3], double tol,
+                                vtkPoints *points, vtkIdList *cellIds,
+                                vtkGenericCell *cell) = 0;
+  virtual vtkIdType FindClosestPointWithinRadius(const double x[3], double radius2,
+                                                 double closestPoint[3],
+                                                 vtkGenericCell *cell,
+                                                 vtkIdType &cellId, int &subId,
+                                                 double& dist2, int &inside) = 0;
   // Convenience for computing
   virtual int IsEmpty(vtkIdType binId) = 0;
+  // Update the binning after the cells have moved
+  virtual bool UpdateLocator() = 0;
 };
 
 // Typed subclass
@@ -317,6 +415,19 @@ struct CellProcessor : public vtkCellProcessor
     binBounds[5] = binBounds[4] + h[2];
   }
 
+  // Squared distance from x to a box; zero if x is inside the box.
+  static double Distance2ToBounds(const double x[3], const double bds[6])
+  {
+    double d, dist2 = 0.0;
+    for (int i=0; i < 3; ++i)
+    {
+      d = ( x[i] < bds[2*i] ? bds[2*i] - x[i] :
+            (x[i] > bds[2*i+1] ? x[i] - bds[2*i+1] : 0.0) );
+      dist2 += d*d;
+    }
+    return dist2;
+  }
+
   int IsInBinBounds(double binBounds[6], double x[3], double binTol = 0.0)
   {
     if ( (binBounds[0]-binTol) <= x[0] && x[0] <= (binBounds[1]+binTol) &&
@@ -341,10 +452,19 @@ struct CellProcessor : public vtkCellProcessor
                                 double& t, double x[3], double pcoords[3],
                                 int &subId, vtkIdType &cellId,
                                 vtkGenericCell *cell) override;
+  int IntersectWithLine(const double a0[3], const double a1[3], double tol,
+                        vtkPoints *points, vtkIdList *cellIds,
+                        vtkGenericCell *cell) override;
+  vtkIdType FindClosestPointWithinRadius(const double x[3], double radius2,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2, int &inside) override;
   int IsEmpty(vtkIdType binId) override
   {
     return ( this->GetNumberOfIds(static_cast<T>(binId)) > 0 ? 0 : 1 );
   }
+  bool UpdateLocator() override;
 
   // This functor is used to perform the final cell binning
   void Initialize()
@@ -467,6 +587,107 @@ struct MapOffsets
 
 }; //MapOffsets
 
+//-----------------------------------------------------------------------------
+// Update the locator after the cells have moved, keeping the bounds and the
+// divisions of the locator. The cached cell bounds are refreshed; only the
+// cells whose range of bins has changed have their fragments replaced in
+// the sorted map (the new fragments are sorted separately and merged with
+// the others, which are already in order). Returns false (leaving the
+// locator unchanged) if a cell has left the bounds of the locator, in which
+// case it must be rebuilt.
+template <typename T> bool CellProcessor<T>::
+UpdateLocator()
+{
+  vtkIdType numCells = this->NumCells;
+  std::vector<double> newBounds(6*numCells);
+  std::vector<unsigned char> changed(numCells);
+  vtkCellRebinner rebinner(this->Binner, newBounds.data(), changed.data());
+  vtkSMPTools::For(0, numCells, rebinner);
+  if ( rebinner.AnyOutside )
+  {
+    return false;
+  }
+
+  if ( rebinner.TotalChanged > 0 )
+  {
+    // The new fragments of the cells which changed bins
+    std::vector<CellFragments<T> > fragments;
+    double xmin[3], xmax[3];
+    int ijkMin[3], ijkMax[3];
+    for ( vtkIdType cellId=0; cellId < numCells; ++cellId )
+    {
+      if ( ! changed[cellId] )
+      {
+        continue;
+      }
+      const double *bds = newBounds.data() + 6*cellId;
+      xmin[0] = bds[0]; xmin[1] = bds[2]; xmin[2] = bds[4];
+      xmax[0] = bds[1]; xmax[1] = bds[3]; xmax[2] = bds[5];
+      this->Binner->GetBinIndices(xmin,ijkMin);
+      this->Binner->GetBinIndices(xmax,ijkMax);
+      for (int k=ijkMin[2]; k <= ijkMax[2]; ++k)
+      {
+        for (int j=ijkMin[1]; j <= ijkMax[1]; ++j)
+        {
+          for (int i=ijkMin[0]; i <= ijkMax[0]; ++i)
+          {
+            CellFragments<T> t;
+            t.CellId = static_cast<T>(cellId);
+            t.BinId = static_cast<T>(i + j*xD + k*xyD);
+            fragments.push_back(t);
+          }
+        }
+      }
+    }
+    std::sort(fragments.begin(), fragments.end());
+
+    // Count the fragments which are kept
+    vtkIdType numFragments = static_cast<vtkIdType>(fragments.size());
+    for ( vtkIdType i=0; i < this->NumFragments; ++i )
+    {
+      numFragments += ( changed[this->Map[i].CellId] ? 0 : 1 );
+    }
+    if ( numFragments >= VTK_INT_MAX && sizeof(T) < sizeof(vtkIdType) )
+    {
+      return false; //needs larger ids
+    }
+
+    // Merge
+    CellFragments<T> *map = new CellFragments<T>[numFragments+1];
+    map[numFragments].BinId = this->NumBins;
+    CellFragments<T> *out = map;
+    typename std::vector<CellFragments<T> >::iterator f = fragments.begin();
+    for ( vtkIdType i=0; i < this->NumFragments; ++i )
+    {
+      if ( changed[this->Map[i].CellId] )
+      {
+        continue;
+      }
+      for ( ; f != fragments.end() && *f < this->Map[i]; ++f )
+      {
+        *out++ = *f;
+      }
+      *out++ = this->Map[i];
+    }
+    for ( ; f != fragments.end(); ++f )
+    {
+      *out++ = *f;
+    }
+    delete [] this->Map;
+    this->Map = map;
+
+    this->NumFragments = this->Binner->NumFragments = numFragments;
+    this->NumBatches = static_cast<int>(
+      ceil(static_cast<double>(this->NumFragments) / this->BatchSize));
+    this->Offsets[this->NumBins] = static_cast<T>(numFragments);
+    MapOffsets<T> mapOffsets(this);
+    vtkSMPTools::For(0, this->NumBatches, mapOffsets);
+  }
+
+  std::copy(newBounds.begin(), newBounds.end(), this->CellBounds);
+  return true;
+}
+
 
 //-----------------------------------------------------------------------------
 template <typename T> vtkIdType CellProcessor<T>::
@@ -613,9 +834,11 @@ FindCellsAlongLine(const double a0[3], const double a1[3], double vtkNotUsed(tol
     next[1] = bounds[2] + h[1]*(rayDir[1] >= 0.0 ? (ijk[1] + step[1]) : ijk[1]);
     next[2] = bounds[4] + h[2]*(rayDir[2] >= 0.0 ? (ijk[2] + step[2]) : ijk[2]);
 
-    tMax[0] = (rayDir[0] != 0.0 ) ? (next[0] - curPos[0])/rayDir[0] : VTK_FLOAT_MAX;
-    tMax[1] = (rayDir[1] != 0.0 ) ? (next[1] - curPos[1])/rayDir[1] : VTK_FLOAT_MAX;
-    tMax[2] = (rayDir[2] != 0.0 ) ? (next[2] - curPos[2])/rayDir[2] : VTK_FLOAT_MAX;
+    // The parametric coordinates are measured from a0, not from the point
+    // where the line enters the locator.
+    tMax[0] = (rayDir[0] != 0.0 ) ? curT + (next[0] - curPos[0])/rayDir[0] : VTK_FLOAT_MAX;
+    tMax[1] = (rayDir[1] != 0.0 ) ? curT + (next[1] - curPos[1])/rayDir[1] : VTK_FLOAT_MAX;
+    tMax[2] = (rayDir[2] != 0.0 ) ? curT + (next[2] - curPos[2])/rayDir[2] : VTK_FLOAT_MAX;
 
     tDelta[0] = (rayDir[0] != 0.0) ? (h[0]/rayDir[0])*step[0] : VTK_FLOAT_MAX;
     tDelta[1] = (rayDir[1] != 0.0) ? (h[1]/rayDir[1])*step[1] : VTK_FLOAT_MAX;
@@ -755,9 +978,11 @@ IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t,
     next[1] = bounds[2] + h[1]*(rayDir[1] >= 0.0 ? (ijk[1] + step[1]) : ijk[1]);
     next[2] = bounds[4] + h[2]*(rayDir[2] >= 0.0 ? (ijk[2] + step[2]) : ijk[2]);
 
-    tMax[0] = (rayDir[0] != 0.0 ) ? (next[0] - curPos[0])/rayDir[0] : VTK_FLOAT_MAX;
-    tMax[1] = (rayDir[1] != 0.0 ) ? (next[1] - curPos[1])/rayDir[1] : VTK_FLOAT_MAX;
-    tMax[2] = (rayDir[2] != 0.0 ) ? (next[2] - curPos[2])/rayDir[2] : VTK_FLOAT_MAX;
+    // The parametric coordinates are measured from a0, not from the point
+    // where the line enters the locator.
+    tMax[0] = (rayDir[0] != 0.0 ) ? curT + (next[0] - curPos[0])/rayDir[0] : VTK_FLOAT_MAX;
+    tMax[1] = (rayDir[1] != 0.0 ) ? curT + (next[1] - curPos[1])/rayDir[1] : VTK_FLOAT_MAX;
+    tMax[2] = (rayDir[2] != 0.0 ) ? curT + (next[2] - curPos[2])/rayDir[2] : VTK_FLOAT_MAX;
 
     tDelta[0] = (rayDir[0] != 0.0) ? (h[0]/rayDir[0])*step[0] : VTK_FLOAT_MAX;
     tDelta[1] = (rayDir[1] != 0.0) ? (h[1]/rayDir[1])*step[1] : VTK_FLOAT_MAX;
@@ -879,6 +1104,184 @@ IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t,
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+// Return all the intersections of the line with the cells, ordered along the
+// line. The candidate cells are gathered by walking the bins along the line
+// (see FindCellsAlongLine()), then each candidate is intersected.
+template <typename T> int CellProcessor<T>::
+IntersectWithLine(const double a0[3], const double a1[3], double tol,
+                  vtkPoints *points, vtkIdList *cellIds, vtkGenericCell *cell)
+{
+  vtkIdList *candidates = vtkIdList::New();
+  this->FindCellsAlongLine(a0, a1, tol, candidates);
+
+  std::vector<vtkCellLocatorLineIntersection> hits;
+  vtkCellLocatorLineIntersection hit;
+  double pcoords[3];
+  int subId;
+  vtkIdType numCandidates = candidates->GetNumberOfIds();
+  for (vtkIdType i=0; i < numCandidates; ++i)
+  {
+    hit.CellId = candidates->GetId(i);
+    this->DataSet->GetCell(hit.CellId, cell);
+    if ( cell->IntersectWithLine(a0, a1, tol, hit.T, hit.X, pcoords, subId) )
+    {
+      hits.push_back(hit);
+    }
+  }
+  candidates->Delete();
+
+  return vtkSortCellLocatorLineIntersections(hits, this->DataSet, a0, a1,
+                                             points, cellIds, cell);
+}
+
+//-----------------------------------------------------------------------------
+// Search the bins in shells of increasing i-j-k distance around the bin
+// containing x. Bins farther away than the closest point found so far are
+// skipped, and the search stops once all the bins outside of the searched
+// block are farther away than that. A cell spanning several bins is only
+// evaluated in the bin of its footprint which is closest to x. This avoids
+// the need for a "cell has been visited" array, so concurrent queries do not
+// share any state.
+template <typename T> vtkIdType CellProcessor<T>::
+FindClosestPointWithinRadius(const double x[3], double radius2,
+                             double closestPoint[3], vtkGenericCell *cell,
+                             vtkIdType &cellId, int &subId, double& dist2,
+                             int &inside)
+{
+  double *bounds = this->Binner->Bounds;
+  int *ndivs = this->Binner->Divisions;
+  double *h = this->Binner->H;
+  int ijk[3], blockMin[3], blockMax[3], cellMin[3], cellMax[3];
+  int i, j, k, ii, level, maxLevel=0;
+  double binBounds[6], *bds, xMin[3], xMax[3], point[3], pcoords[3];
+  double d2, lowerBound, minDist2=radius2;
+  vtkIdType binId, cId, closestCell=(-1);
+  int closestSubId=(-1), closestInside=0, tmpSubId, tmpInside;
+  T numIds;
+
+  // Weights are sized for the largest cell met during the query
+  double weightsArray[8];
+  double *weights = weightsArray;
+  std::vector<double> moreWeights;
+
+  this->Binner->GetBinIndices(x, ijk);
+  for (ii=0; ii < 3; ++ii)
+  {
+    maxLevel = std::max(maxLevel, std::max(ijk[ii], ndivs[ii]-1-ijk[ii]));
+  }
+
+  for ( level=0; level <= maxLevel; ++level )
+  {
+    for (ii=0; ii < 3; ++ii)
+    {
+      blockMin[ii] = std::max(ijk[ii]-level, 0);
+      blockMax[ii] = std::min(ijk[ii]+level, ndivs[ii]-1);
+    }
+
+    // Visit the bins on the boundary (shell) of the block
+    for ( k=blockMin[2]; k <= blockMax[2]; ++k )
+    {
+      for ( j=blockMin[1]; j <= blockMax[1]; ++j )
+      {
+        bool fullRow = ( std::abs(k-ijk[2]) == level || std::abs(j-ijk[1]) == level );
+        int iStep = ( fullRow ? 1 : 2*level );
+        for ( i=(fullRow ? blockMin[0] : ijk[0]-level); i <= blockMax[0]; i+=iStep )
+        {
+          binId = i + j*this->xD + k*this->xyD;
+          if ( i < 0 || (numIds=this->GetNumberOfIds(binId)) < 1 )
+          {
+            continue;
+          }
+          this->ComputeBinBounds(i,j,k, binBounds);
+          if ( Distance2ToBounds(x, binBounds) > minDist2 )
+          {
+            continue;
+          }
+
+          const CellFragments<T> *ids = this->GetIds(binId);
+          for (T n=0; n < numIds; ++n)
+          {
+            cId = ids[n].CellId;
+            bds = this->CellBounds + 6*cId;
+
+            // Only process the cell in the bin of its footprint closest to x
+            xMin[0] = bds[0]; xMin[1] = bds[2]; xMin[2] = bds[4];
+            xMax[0] = bds[1]; xMax[1] = bds[3]; xMax[2] = bds[5];
+            this->Binner->GetBinIndices(xMin, cellMin);
+            this->Binner->GetBinIndices(xMax, cellMax);
+            if ( i != std::min(std::max(ijk[0], cellMin[0]), cellMax[0]) ||
+                 j != std::min(std::max(ijk[1], cellMin[1]), cellMax[1]) ||
+                 k != std::min(std::max(ijk[2], cellMin[2]), cellMax[2]) )
+            {
+              continue;
+            }
+
+            if ( Distance2ToBounds(x, bds) > minDist2 )
+            {
+              continue;
+            }
+
+            this->DataSet->GetCell(cId, cell);
+            vtkIdType numPts = cell->GetNumberOfPoints();
+            if ( numPts > 8 && numPts > static_cast<vtkIdType>(moreWeights.size()) )
+            {
+              moreWeights.resize(numPts);
+              weights = moreWeights.data();
+            }
+            tmpInside = cell->EvaluatePosition(x, point, tmpSubId, pcoords, d2, weights);
+            if ( tmpInside != -1 &&
+                 (closestCell < 0 ? d2 <= minDist2 : d2 < minDist2) )
+            {
+              closestCell = cId;
+              closestSubId = tmpSubId;
+              closestInside = tmpInside;
+              minDist2 = d2;
+              closestPoint[0] = point[0];
+              closestPoint[1] = point[1];
+              closestPoint[2] = point[2];
+            }
+          }//for cells in bin
+        }//i
+      }//j
+    }//k
+
+    // Stop when the bins outside of the block are all too far away
+    lowerBound = VTK_DOUBLE_MAX;
+    for (ii=0; ii < 3; ++ii)
+    {
+      if ( ijk[ii]-level > 0 )
+      {
+        lowerBound = std::min(lowerBound,
+                              x[ii] - (bounds[2*ii] + (ijk[ii]-level)*h[ii]));
+      }
+      if ( ijk[ii]+level+1 < ndivs[ii] )
+      {
+        lowerBound = std::min(lowerBound,
+                              bounds[2*ii] + (ijk[ii]+level+1)*h[ii] - x[ii]);
+      }
+    }
+    if ( lowerBound > 0.0 && lowerBound*lowerBound > minDist2 )
+    {
+      break;
+    }
+  }//for shells of increasing level
+
+  if ( closestCell < 0 )
+  {
+    cellId = -1;
+    dist2 = -1.0;
+    return 0;
+  }
+
+  cellId = closestCell;
+  subId = closestSubId;
+  inside = closestInside;
+  dist2 = minDist2;
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
 //-----------------------------------------------------------------------------
 // Here is the VTK class proper.
 
@@ -900,6 +1303,7 @@ vtkStaticCellLocator::vtkStaticCellLocator()
 
   this->MaxNumberOfBuckets = VTK_INT_MAX;
   this->LargeIds = false;
+  this->IncrementalUpdate = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -978,6 +1382,55 @@ IntersectWithLine(const double p1[3], const double p2[3], double tol,
 }
 
 
+//-----------------------------------------------------------------------------
+int vtkStaticCellLocator::
+IntersectWithLine(const double p1[3], const double p2[3],
+                  vtkPoints *points, vtkIdList *cellIds)
+{
+  this->BuildLocator();
+  if ( ! this->Processor )
+  {
+    return 0;
+  }
+  vtkGenericCell *cell = vtkGenericCell::New();
+  int ret = this->Processor->
+    IntersectWithLine(p1,p2,this->Tolerance,points,cellIds,cell);
+  cell->Delete();
+  return ret;
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::
+FindClosestPoint(const double x[3], double closestPoint[3],
+                 vtkGenericCell *cell, vtkIdType &cellId,
+                 int &subId, double& dist2)
+{
+  this->BuildLocator();
+  if ( ! this->Processor )
+  {
+    cellId = -1;
+    return;
+  }
+  int inside;
+  this->Processor->FindClosestPointWithinRadius(
+    x,VTK_DOUBLE_MAX,closestPoint,cell,cellId,subId,dist2,inside);
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticCellLocator::
+FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+                             vtkGenericCell *cell, vtkIdType &cellId,
+                             int &subId, double& dist2, int &inside)
+{
+  this->BuildLocator();
+  if ( ! this->Processor )
+  {
+    return 0;
+  }
+  return this->Processor->FindClosestPointWithinRadius(
+    x,radius*radius,closestPoint,cell,cellId,subId,dist2,inside);
+}
+
 //-----------------------------------------------------------------------------
 void vtkStaticCellLocator::
 BuildLocator()
@@ -991,6 +1444,23 @@ BuildLocator()
     return;
   }
 
+  // Only the cells have changed: try to update the existing bins
+  if ( this->IncrementalUpdate && (this->Processor != nullptr) &&
+       (this->BuildTime > this->MTime) &&
+       this->DataSet->GetNumberOfCells() == this->Binner->NumCells )
+  {
+    vtkDebugMacro( << "Updating static cell locator" );
+    // This is done to cause non-thread safe initialization to occur due to
+    // side effects from GetCellBounds().
+    double bds[6];
+    this->DataSet->GetCellBounds(0,bds);
+    if ( this->Processor->UpdateLocator() )
+    {
+      this->BuildTime.Modified();
+      return;
+    }
+  }
+
   vtkIdType numCells;
   if ( !this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1 )
   {
@@ -1218,6 +1688,28 @@ GenerateRepresentation(int vtkNotUsed(level), vtkPolyData *pd)
 
 }
 
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::FindClosestPoints(vtkPoints *points,
+                                             vtkPoints *closestPoints,
+                                             vtkIdList *cellIds)
+{
+  this->FindClosestPointsInternal(points, closestPoints, cellIds, true);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                              double tol, vtkPoints *points,
+                                              vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, true);
+}
+
 //-----------------------------------------------------------------------------
 void vtkStaticCellLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1229,4 +1721,6 @@ void vtkStaticCellLocator::PrintSelf(ostream& os, vtkIndent indent)
      << this->MaxNumberOfBuckets << "\n";
 
   os << indent << "Large IDs: " << this->LargeIds << "\n";
+  os << indent << "Incremental Update: "
+     << (this->IncrementalUpdate ? "On\n" : "Off\n");
 }
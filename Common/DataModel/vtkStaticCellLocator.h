@@ -25,6 +25,12 @@
  * threaded (via vtkSMPTools), and supports one-time static construction
  * (i.e., incremental cell insertion is not supported).
  *
+ * Line intersection walks the bins along the line, and closest point queries
+ * search the bins in shells of increasing distance around the query point.
+ * Once the locator is built, these queries do not modify the locator and may
+ * be invoked concurrently from several threads (each with its own
+ * vtkGenericCell).
+ *
  * @warning
  * This class is templated. It may run slower than serial execution if the code
  * is not optimized during compilation. Build in Release or ReleaseWithDebugInfo.
@@ -133,14 +139,83 @@ public:
   }
 
   /**
-   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   * Return all the intersection points and cells along the finite line
+   * (p1,p2), ordered from p1 to p2. Either of points and cellIds may be
+   * nullptr. Returns 0 if there is no intersection. For surfaces, -1 is
+   * returned if p1 is inside (the line leaves through the first
+   * intersected cell) and 1 otherwise; 1 is returned for other cells.
+   * This method is thread safe once the locator has been built.
    */
   int IntersectWithLine(const double p1[3], const double p2[3],
-                        vtkPoints *points, vtkIdList *cellIds) override
+                        vtkPoints *points, vtkIdList *cellIds) override;
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * The bins are searched in shells of increasing distance around x. This
+   * method is thread safe once the locator has been built.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3],
+                        vtkGenericCell *cell, vtkIdType &cellId,
+                        int &subId, double& dist2) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3],
+                        vtkIdType &cellId, int &subId, double& dist2) override
+  {
+    this->Superclass::FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. Returns 1 if a point is found within the radius,
+   * 0 otherwise. This method is thread safe once the locator has been built.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2, int &inside) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2) override
   {
-    return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cellId, subId, dist2);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius,
+                                         double closestPoint[3],
+                                         vtkGenericCell *cell,
+                                         vtkIdType &cellId, int &subId,
+                                         double& dist2) override
+  {
+    return this->Superclass::FindClosestPointWithinRadius(
+      x, radius, closestPoint, cell, cellId, subId, dist2);
   }
 
+  //@{
+  /**
+   * Batched queries, issued in parallel with vtkSMPTools: the single
+   * queries of this locator are thread safe once it is built. See
+   * vtkAbstractCellLocator.
+   */
+  void FindCells(vtkPoints *points, vtkIdList *cellIds) override;
+  void FindClosestPoints(vtkPoints *points, vtkPoints *closestPoints,
+                         vtkIdList *cellIds) override;
+  void IntersectWithLines(vtkPoints *starts, vtkPoints *ends, double tol,
+                          vtkPoints *points, vtkIdList *cellIds) override;
+  //@}
+
   //@{
   /**
    * Satisfy vtkLocator abstract interface.
@@ -178,6 +253,22 @@ public:
    */
   bool GetLargeIds() {return this->LargeIds;}
 
+  //@{
+  /**
+   * Enable incremental updates of the locator (off by default). When
+   * enabled and only the cells of the dataset have changed since the
+   * locator was built (same number of cells, same locator parameters),
+   * BuildLocator() keeps the bounds and divisions of the locator, refreshes
+   * the cached cell bounds and re-bins only the cells whose range of bins
+   * has changed. This is much faster than a full build when the points
+   * move a little, e.g. in deforming mesh simulations. If a cell has left
+   * the bounds of the locator, the locator is rebuilt from scratch.
+   */
+  vtkSetMacro(IncrementalUpdate,bool);
+  vtkGetMacro(IncrementalUpdate,bool);
+  vtkBooleanMacro(IncrementalUpdate,bool);
+  //@}
+
 protected:
   vtkStaticCellLocator();
   ~vtkStaticCellLocator() override;
@@ -188,6 +279,7 @@ protected:
 
   vtkIdType MaxNumberOfBuckets; // Maximum number of buckets in locator
   bool LargeIds; //indicate whether integer ids are small or large
+  bool IncrementalUpdate; //re-bin moved cells only if possible
 
   // Support PIMPLd implementation
   vtkCellBinner *Binner; // Does the binning
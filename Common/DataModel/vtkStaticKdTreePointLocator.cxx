@@ -0,0 +1,577 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticKdTreePointLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticKdTreePointLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkStaticKdTreePointLocator);
+
+// The tree never gets deeper than this (2^48 leaves is plenty).
+#define VTK_KD_MAX_LEVELS 48
+
+//-----------------------------------------------------------------------------
+// The tree is balanced: a node covering the points [begin,end) has a left
+// child covering [begin,mid) and a right child covering [mid,end), with
+// mid = begin + (end-begin)/2, and all the leaves are at the same level. So
+// the nodes are numbered implicitly (the children of node n are 2n+1 and
+// 2n+2) and their ranges of points are recomputed during the traversal;
+// only the splitting planes of the interior nodes are stored. The points of
+// the left child lie on or below the splitting plane, those of the right
+// child on or above it.
+struct vtkKdPoint
+{
+  double X[3];
+  vtkIdType Id;
+};
+
+struct vtkStaticKdTree
+{
+  std::vector<vtkKdPoint> Points; // in the order of the leaves
+  std::vector<double> Splits; // position of the splitting plane of each node
+  std::vector<unsigned char> Axes; // and its axis
+  int NumberOfLevels; // the leaves are at this level
+
+  vtkStaticKdTree() : NumberOfLevels(0) {}
+};
+
+namespace {
+
+//-----------------------------------------------------------------------------
+// Copy the points and their ids. Explicit point representations (e.g.,
+// vtkPointSet) take the faster path.
+template <typename T>
+struct CopyPointsArray
+{
+  const T *Points;
+  vtkKdPoint *Output;
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+  {
+    const T *x = this->Points + 3*ptId;
+    vtkKdPoint *p = this->Output + ptId;
+    for ( ; ptId < end; ++ptId, x+=3, ++p )
+    {
+      p->X[0] = static_cast<double>(x[0]);
+      p->X[1] = static_cast<double>(x[1]);
+      p->X[2] = static_cast<double>(x[2]);
+      p->Id = ptId;
+    }
+  }
+};
+
+struct CopyDataSetPoints
+{
+  vtkDataSet *DataSet;
+  vtkKdPoint *Output;
+
+  void operator()(vtkIdType ptId, vtkIdType end)
+  {
+    vtkKdPoint *p = this->Output + ptId;
+    for ( ; ptId < end; ++ptId, ++p )
+    {
+      this->DataSet->GetPoint(ptId, p->X);
+      p->Id = ptId;
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Range of points covered by the kth node of the given level.
+void NodeRange(vtkIdType numPts, int level, vtkIdType k,
+               vtkIdType &begin, vtkIdType &end)
+{
+  begin = 0;
+  end = numPts;
+  for (int bit=level-1; bit >= 0; --bit)
+  {
+    vtkIdType mid = begin + (end-begin)/2;
+    if ( (k >> bit) & 1 )
+    {
+      begin = mid;
+    }
+    else
+    {
+      end = mid;
+    }
+  }
+}
+
+// Split all the nodes of a level at the median along their axis of largest
+// extent. The nodes of a level cover disjoint ranges of points, so they are
+// processed in parallel.
+struct SplitLevel
+{
+  vtkStaticKdTree *Tree;
+  int Level;
+
+  void operator()(vtkIdType k, vtkIdType kEnd)
+  {
+    vtkKdPoint *pts = this->Tree->Points.data();
+    vtkIdType numPts = static_cast<vtkIdType>(this->Tree->Points.size());
+    vtkIdType firstNode = (static_cast<vtkIdType>(1) << this->Level) - 1;
+    vtkIdType begin, end;
+    for ( ; k < kEnd; ++k )
+    {
+      NodeRange(numPts, this->Level, k, begin, end);
+      double bds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+                        -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+      for (vtkIdType i=begin; i < end; ++i)
+      {
+        for (int j=0; j < 3; ++j)
+        {
+          bds[2*j] = std::min(bds[2*j], pts[i].X[j]);
+          bds[2*j+1] = std::max(bds[2*j+1], pts[i].X[j]);
+        }
+      }
+      int axis = 0;
+      for (int j=1; j < 3; ++j)
+      {
+        if ( bds[2*j+1] - bds[2*j] > bds[2*axis+1] - bds[2*axis] )
+        {
+          axis = j;
+        }
+      }
+
+      vtkIdType mid = begin + (end-begin)/2;
+      double split = 0.0;
+      if ( mid < end )
+      {
+        std::nth_element(pts + begin, pts + mid, pts + end,
+                         [axis](const vtkKdPoint &a, const vtkKdPoint &b) {
+                           return a.X[axis] < b.X[axis];
+                         });
+        split = pts[mid].X[axis];
+      }
+      this->Tree->Splits[firstNode + k] = split;
+      this->Tree->Axes[firstNode + k] = static_cast<unsigned char>(axis);
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Visit the points which may lie within the search radius of the visitor,
+// nearest nodes first. The visitor provides the squared search radius
+// (which may shrink during the search) and is handed the points within it.
+template <typename TVisitor>
+void SearchTree(const vtkStaticKdTree *tree, const double x[3], TVisitor &visitor)
+{
+  struct Entry
+  {
+    vtkIdType Node;
+    vtkIdType Begin;
+    vtkIdType End;
+    int Level;
+    double Bound; // lower bound of the squared distance to the node
+  };
+  Entry stack[VTK_KD_MAX_LEVELS+1];
+  int top = 0;
+
+  const vtkKdPoint *pts = tree->Points.data();
+  const double *splits = tree->Splits.data();
+  const unsigned char *axes = tree->Axes.data();
+  const int numLevels = tree->NumberOfLevels;
+
+  stack[top++] = Entry{ 0, 0, static_cast<vtkIdType>(tree->Points.size()), 0, 0.0 };
+  while ( top > 0 )
+  {
+    Entry e = stack[--top];
+    if ( e.Bound > visitor.Radius2() )
+    {
+      continue;
+    }
+
+    // Descend to the nearest leaf, deferring the far children
+    while ( e.Level < numLevels )
+    {
+      int axis = axes[e.Node];
+      double d = x[axis] - splits[e.Node];
+      vtkIdType mid = e.Begin + (e.End-e.Begin)/2;
+      Entry left{ 2*e.Node+1, e.Begin, mid, e.Level+1, e.Bound };
+      Entry right{ 2*e.Node+2, mid, e.End, e.Level+1, e.Bound };
+      Entry &nearChild = ( d < 0.0 ? left : right );
+      Entry &farChild = ( d < 0.0 ? right : left );
+      farChild.Bound = std::max(e.Bound, d*d);
+      if ( farChild.Bound <= visitor.Radius2() && farChild.Begin < farChild.End )
+      {
+        stack[top++] = farChild;
+      }
+      e = nearChild;
+    }
+
+    for (vtkIdType i=e.Begin; i < e.End; ++i)
+    {
+      const double *p = pts[i].X;
+      double d2 = (p[0]-x[0])*(p[0]-x[0]) + (p[1]-x[1])*(p[1]-x[1]) +
+        (p[2]-x[2])*(p[2]-x[2]);
+      if ( d2 <= visitor.Radius2() )
+      {
+        visitor.Visit(pts[i].Id, d2);
+      }
+    }
+  }
+}
+
+// Keep the closest point.
+struct ClosestPointVisitor
+{
+  double Dist2;
+  vtkIdType Id;
+
+  explicit ClosestPointVisitor(double radius2) : Dist2(radius2), Id(-1) {}
+  double Radius2() const { return this->Dist2; }
+  void Visit(vtkIdType id, double d2)
+  {
+    if ( d2 < this->Dist2 || this->Id < 0 )
+    {
+      this->Dist2 = d2;
+      this->Id = id;
+    }
+  }
+};
+
+// Keep the N closest points in a max heap.
+struct ClosestNPointsVisitor
+{
+  typedef std::pair<double,vtkIdType> Neighbor;
+  std::vector<Neighbor> Heap;
+  size_t N;
+
+  explicit ClosestNPointsVisitor(int n) : N(static_cast<size_t>(n))
+  {
+    this->Heap.reserve(this->N);
+  }
+  double Radius2() const
+  {
+    return ( this->Heap.size() < this->N ? VTK_DOUBLE_MAX : this->Heap.front().first );
+  }
+  void Visit(vtkIdType id, double d2)
+  {
+    if ( this->Heap.size() < this->N )
+    {
+      this->Heap.push_back(Neighbor(d2, id));
+      std::push_heap(this->Heap.begin(), this->Heap.end());
+    }
+    else if ( d2 < this->Heap.front().first )
+    {
+      std::pop_heap(this->Heap.begin(), this->Heap.end());
+      this->Heap.back() = Neighbor(d2, id);
+      std::push_heap(this->Heap.begin(), this->Heap.end());
+    }
+  }
+};
+
+// Collect all the points within the radius.
+struct PointsWithinRadiusVisitor
+{
+  double R2;
+  vtkIdList *Result;
+
+  double Radius2() const { return this->R2; }
+  void Visit(vtkIdType id, double)
+  {
+    this->Result->InsertNextId(id);
+  }
+};
+
+//-----------------------------------------------------------------------------
+void AddBox(vtkPoints *pts, vtkCellArray *polys, const double b[6])
+{
+  vtkIdType ids[8];
+  for (int k=0; k < 2; ++k)
+  {
+    for (int j=0; j < 2; ++j)
+    {
+      for (int i=0; i < 2; ++i)
+      {
+        ids[i + 2*j + 4*k] = pts->InsertNextPoint(b[i], b[2+j], b[4+k]);
+      }
+    }
+  }
+  const int faces[6][4] = { {0,4,6,2}, {1,3,7,5}, {0,1,5,4},
+                            {2,6,7,3}, {0,2,3,1}, {4,5,7,6} };
+  for (int f=0; f < 6; ++f)
+  {
+    vtkIdType face[4] = { ids[faces[f][0]], ids[faces[f][1]],
+                          ids[faces[f][2]], ids[faces[f][3]] };
+    polys->InsertNextCell(4, face);
+  }
+}
+
+} // anonymous namespace
+
+//-----------------------------------------------------------------------------
+vtkStaticKdTreePointLocator::vtkStaticKdTreePointLocator()
+{
+  this->NumberOfPointsPerBucket = 8;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+vtkStaticKdTreePointLocator::~vtkStaticKdTreePointLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::Initialize()
+{
+  this->FreeSearchStructure();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::FreeSearchStructure()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::BuildLocator()
+{
+  vtkIdType numPts;
+
+  if ( (this->Tree != nullptr) && (this->BuildTime > this->MTime)
+       && (this->BuildTime > this->DataSet->GetMTime()) )
+  {
+    return;
+  }
+
+  vtkDebugMacro( << "Building kd-tree..." );
+
+  if ( !this->DataSet || (numPts = this->DataSet->GetNumberOfPoints()) < 1 )
+  {
+    vtkErrorMacro( << "No points to locate");
+    return;
+  }
+
+  this->FreeSearchStructure();
+  vtkStaticKdTree *tree = new vtkStaticKdTree;
+  const double *bounds = this->DataSet->GetBounds();
+  std::copy(bounds, bounds+6, this->Bounds);
+
+  // Gather the points
+  tree->Points.resize(numPts);
+  vtkPointSet *ps = vtkPointSet::SafeDownCast(this->DataSet);
+  int dataType = ( ps && ps->GetPoints() ? ps->GetPoints()->GetDataType() : VTK_VOID );
+  if ( dataType == VTK_FLOAT )
+  {
+    CopyPointsArray<float> copier{
+      static_cast<float*>(ps->GetPoints()->GetVoidPointer(0)), tree->Points.data() };
+    vtkSMPTools::For(0, numPts, copier);
+  }
+  else if ( dataType == VTK_DOUBLE )
+  {
+    CopyPointsArray<double> copier{
+      static_cast<double*>(ps->GetPoints()->GetVoidPointer(0)), tree->Points.data() };
+    vtkSMPTools::For(0, numPts, copier);
+  }
+  else
+  {
+    // Non-float points or implicit points representation. A first call
+    // triggers any non thread safe initialization.
+    double x[3];
+    this->DataSet->GetPoint(0, x);
+    CopyDataSetPoints copier{ this->DataSet, tree->Points.data() };
+    vtkSMPTools::For(0, numPts, copier);
+  }
+
+  // The depth of the tree is such that no leaf holds more than
+  // NumberOfPointsPerBucket points.
+  int numLevels = 0;
+  while ( numLevels < VTK_KD_MAX_LEVELS &&
+          ((numPts - 1) >> numLevels) + 1 > this->NumberOfPointsPerBucket )
+  {
+    ++numLevels;
+  }
+  tree->NumberOfLevels = numLevels;
+  vtkIdType numNodes = (static_cast<vtkIdType>(1) << numLevels) - 1;
+  tree->Splits.resize(numNodes);
+  tree->Axes.resize(numNodes);
+
+  // Split the tree level by level
+  for (int level=0; level < numLevels; ++level)
+  {
+    SplitLevel splitter{ tree, level };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(1) << level, 1, splitter);
+  }
+
+  this->Tree = tree;
+  this->Level = numLevels;
+  this->NumberOfBuckets = static_cast<vtkIdType>(1) << numLevels;
+  this->BuildTime.Modified();
+}
+
+//-----------------------------------------------------------------------------
+int vtkStaticKdTreePointLocator::GetNumberOfLevels()
+{
+  return ( this->Tree ? this->Tree->NumberOfLevels : 0 );
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticKdTreePointLocator::FindClosestPoint(const double x[3])
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if ( !this->Tree )
+  {
+    return -1;
+  }
+
+  ClosestPointVisitor visitor(VTK_DOUBLE_MAX);
+  SearchTree(this->Tree, x, visitor);
+  return visitor.Id;
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::FindClosestPoints(vtkPoints *points,
+                                                    vtkIdList *closestIds)
+{
+  this->FindClosestPointsInternal(points, closestIds, true);
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkStaticKdTreePointLocator::
+FindClosestPointWithinRadius(double radius, const double x[3], double& dist2)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  dist2 = -1.0;
+  if ( !this->Tree )
+  {
+    return -1;
+  }
+
+  ClosestPointVisitor visitor(radius*radius);
+  SearchTree(this->Tree, x, visitor);
+  if ( visitor.Id >= 0 )
+  {
+    dist2 = visitor.Dist2;
+  }
+  return visitor.Id;
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::
+FindClosestNPoints(int N, const double x[3], vtkIdList *result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  result->Reset();
+  if ( !this->Tree || N < 1 )
+  {
+    return;
+  }
+
+  N = static_cast<int>(std::min(static_cast<vtkIdType>(N),
+                                static_cast<vtkIdType>(this->Tree->Points.size())));
+  ClosestNPointsVisitor visitor(N);
+  SearchTree(this->Tree, x, visitor);
+
+  // Sort from closest to farthest
+  std::sort_heap(visitor.Heap.begin(), visitor.Heap.end());
+  result->SetNumberOfIds(static_cast<vtkIdType>(visitor.Heap.size()));
+  for (size_t i=0; i < visitor.Heap.size(); ++i)
+  {
+    result->SetId(static_cast<vtkIdType>(i), visitor.Heap[i].second);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::
+FindPointsWithinRadius(double R, const double x[3], vtkIdList *result)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  result->Reset();
+  if ( !this->Tree )
+  {
+    return;
+  }
+
+  PointsWithinRadiusVisitor visitor{ R*R, result };
+  SearchTree(this->Tree, x, visitor);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::GenerateRepresentation(int level, vtkPolyData *pd)
+{
+  this->BuildLocator();
+  if ( !this->Tree )
+  {
+    return;
+  }
+
+  vtkPoints *pts = vtkPoints::New();
+  vtkCellArray *polys = vtkCellArray::New();
+
+  const int numLevels = this->Tree->NumberOfLevels;
+  if ( level < 0 || level > numLevels )
+  {
+    level = numLevels;
+  }
+
+  struct Box
+  {
+    vtkIdType Node;
+    int Level;
+    double Bounds[6];
+  };
+  std::vector<Box> stack(1);
+  stack[0].Node = 0;
+  stack[0].Level = 0;
+  std::copy(this->Bounds, this->Bounds+6, stack[0].Bounds);
+  while ( ! stack.empty() )
+  {
+    Box box = stack.back();
+    stack.pop_back();
+    if ( box.Level == level )
+    {
+      AddBox(pts, polys, box.Bounds);
+      continue;
+    }
+    int axis = this->Tree->Axes[box.Node];
+    double split = this->Tree->Splits[box.Node];
+    Box left = box, right = box;
+    left.Node = 2*box.Node + 1;
+    right.Node = 2*box.Node + 2;
+    left.Level = right.Level = box.Level + 1;
+    left.Bounds[2*axis+1] = split;
+    right.Bounds[2*axis] = split;
+    stack.push_back(right);
+    stack.push_back(left);
+  }
+
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+  pts->Delete();
+  polys->Delete();
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticKdTreePointLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Number of Points Per Bucket: "
+     << this->NumberOfPointsPerBucket << "\n";
+  os << indent << "Number of Levels: " << this->GetNumberOfLevels() << "\n";
+}
@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticKdTreePointLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkStaticKdTreePointLocator
+ * @brief   quickly locate points in 3-space with a static kd-tree
+ *
+ * vtkStaticKdTreePointLocator is a spatial search object to quickly locate
+ * points in 3D. It organizes the points in a balanced kd-tree: each node
+ * splits its points in two halves at the median along the axis of largest
+ * extent, until the leaves hold at most NumberOfPointsPerBucket points.
+ * Since the tree is balanced it is stored implicitly: the points are
+ * reordered so that every node refers to a contiguous range of them, and
+ * only the splitting planes of the interior nodes are kept. Unlike the
+ * uniform bins of vtkStaticPointLocator, the leaves adapt to the density of
+ * the points, so the locator performs well on highly non-uniform data such
+ * as lidar point clouds.
+ *
+ * vtkStaticKdTreePointLocator is threaded (via vtkSMPTools): all the nodes
+ * of a level of the tree are split in parallel. Like vtkStaticPointLocator,
+ * it supports one-time static construction only (i.e., incremental point
+ * insertion is not supported). Once built, the queries do not modify the
+ * locator and may be invoked concurrently from several threads, so the
+ * locator can be used by the threaded point cloud filters
+ * (e.g. vtkRadiusOutlierRemoval, vtkStatisticalOutlierRemoval,
+ * vtkPCANormalEstimation).
+ *
+ * @warning
+ * The Automatic, Divisions and MaxLevel data members of the superclasses
+ * have no effect on this locator; the depth of the tree follows from the
+ * number of points and NumberOfPointsPerBucket.
+ *
+ * @sa
+ * vtkStaticPointLocator vtkKdTreePointLocator vtkPointLocator
+ * vtkAbstractPointLocator vtkLocator
+ */
+
+#ifndef vtkStaticKdTreePointLocator_h
+#define vtkStaticKdTreePointLocator_h
+
+#include "vtkCommonDataModelModule.h" // For export macro
+#include "vtkAbstractPointLocator.h"
+
+class vtkIdList;
+struct vtkStaticKdTree;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkStaticKdTreePointLocator : public vtkAbstractPointLocator
+{
+public:
+  /**
+   * Construct with at most 8 points per leaf of the tree.
+   */
+  static vtkStaticKdTreePointLocator *New();
+
+  //@{
+  /**
+   * Standard type and print methods.
+   */
+  vtkTypeMacro(vtkStaticKdTreePointLocator,vtkAbstractPointLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the maximum number of points in each leaf (bucket) of the
+   * tree. Larger leaves make for a shallower tree which is faster to build,
+   * at the price of more distance computations during the queries.
+   */
+  vtkSetClampMacro(NumberOfPointsPerBucket,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfPointsPerBucket,int);
+  //@}
+
+  // Re-use any superclass signatures that we don't override.
+  using vtkAbstractPointLocator::FindClosestPoint;
+  using vtkAbstractPointLocator::FindClosestNPoints;
+  using vtkAbstractPointLocator::FindPointsWithinRadius;
+
+  /**
+   * Given a position x, return the id of the point closest to it. This
+   * method is thread safe if BuildLocator() is directly or indirectly called
+   * from a single thread first.
+   */
+  vtkIdType FindClosestPoint(const double x[3]) override;
+
+  /**
+   * Find the closest point to each of the given points. Since
+   * FindClosestPoint() is thread safe, the queries are issued in parallel
+   * with vtkSMPTools once the locator has been built.
+   */
+  void FindClosestPoints(vtkPoints *points, vtkIdList *closestIds) override;
+
+  /**
+   * Given a position x and a radius r, return the id of the point closest to
+   * the point in that radius, or -1 if there is no point within the radius.
+   * dist2 returns the squared distance to the point. This method is thread
+   * safe if BuildLocator() is directly or indirectly called from a single
+   * thread first.
+   */
+  vtkIdType FindClosestPointWithinRadius(
+    double radius, const double x[3], double& dist2) override;
+
+  /**
+   * Find the closest N points to a position. The returned points are sorted
+   * from closest to farthest. This method is thread safe if BuildLocator()
+   * is directly or indirectly called from a single thread first.
+   */
+  void FindClosestNPoints(int N, const double x[3], vtkIdList *result) override;
+
+  /**
+   * Find all points within a specified radius R of position x. The result
+   * is not sorted in any specific manner. This method is thread safe if
+   * BuildLocator() is directly or indirectly called from a single thread
+   * first.
+   */
+  void FindPointsWithinRadius(double R, const double x[3],
+                              vtkIdList *result) override;
+
+  //@{
+  /**
+   * See vtkLocator and vtkAbstractPointLocator interface documentation.
+   * These methods are not thread safe.
+   */
+  void Initialize() override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+  /**
+   * Populate a polydata with the boxes of the nodes at the given level of
+   * the tree; a negative level (or a level deeper than the tree) produces
+   * the boxes of the leaves. Typically this is used for debugging.
+   */
+  void GenerateRepresentation(int level, vtkPolyData *pd) override;
+
+  /**
+   * Return the number of levels of the tree below the root, i.e. the tree
+   * has 2^GetNumberOfLevels() leaves. Valid after the locator is built.
+   */
+  int GetNumberOfLevels();
+
+protected:
+  vtkStaticKdTreePointLocator();
+  ~vtkStaticKdTreePointLocator() override;
+
+  int NumberOfPointsPerBucket; // Maximum number of points in a leaf
+  vtkStaticKdTree *Tree; // The points and the splitting planes
+
+private:
+  vtkStaticKdTreePointLocator(const vtkStaticKdTreePointLocator&) = delete;
+  void operator=(const vtkStaticKdTreePointLocator&) = delete;
+};
+
+#endif
@@ -19,12 +19,14 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkLine.h"
 #include "vtkSMPTools.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPThreadLocalObject.h"
 
 #include <vector>
@@ -109,6 +111,7 @@ struct vtkBucketList
   // Virtuals for templated subclasses
   virtual ~vtkBucketList() = default;
   virtual void BuildLocator() = 0;
+  virtual bool UpdateLocator() = 0;
 
   // place points in appropriate buckets
   void GetBucketNeighbors(NeighborBuckets* buckets,
@@ -789,6 +792,198 @@ struct BucketList : public vtkBucketList
     MapOffsets<TIds> offMapper(this);
     vtkSMPTools::For(0,numBatches, offMapper);
   }
+
+  // Access to the point coordinates when updating the locator.
+  template <typename TPts>
+  struct PointsArrayAccessor
+  {
+    const TPts *Points;
+    void GetPoint(vtkIdType ptId, double p[3]) const
+    {
+      const TPts *x = this->Points + 3*ptId;
+      p[0] = static_cast<double>(x[0]);
+      p[1] = static_cast<double>(x[1]);
+      p[2] = static_cast<double>(x[2]);
+    }
+  };
+
+  struct DataSetAccessor
+  {
+    vtkDataSet *DataSet;
+    void GetPoint(vtkIdType ptId, double p[3]) const
+    {
+      this->DataSet->GetPoint(ptId, p);
+    }
+  };
+
+  // Recompute the bucket of each entry of the sorted map. Count the points
+  // which changed bucket, and detect the points which left the bounds of
+  // the locator.
+  template <typename TAccessor>
+  struct ReBinPoints
+  {
+    BucketList<TIds> *BList;
+    TAccessor Accessor;
+    TIds *Buckets; //new bucket of each map entry
+    vtkSMPThreadLocal<vtkIdType> NumMoved;
+    vtkSMPThreadLocal<unsigned char> Outside;
+    vtkIdType TotalMoved;
+    bool AnyOutside;
+
+    ReBinPoints(BucketList<TIds> *blist, TAccessor accessor, TIds *buckets) :
+      BList(blist), Accessor(accessor), Buckets(buckets), TotalMoved(0),
+      AnyOutside(false)
+    {
+    }
+
+    void Initialize()
+    {
+      this->NumMoved.Local() = 0;
+      this->Outside.Local() = 0;
+    }
+
+    void operator()(vtkIdType i, vtkIdType end)
+    {
+      const double *bds = this->BList->Bounds;
+      const LocatorTuple<TIds> *t = this->BList->Map + i;
+      vtkIdType &numMoved = this->NumMoved.Local();
+      unsigned char &outside = this->Outside.Local();
+      double p[3];
+      for ( ; i < end; ++i, ++t )
+      {
+        this->Accessor.GetPoint(t->PtId, p);
+        if ( p[0] < bds[0] || p[0] > bds[1] || p[1] < bds[2] ||
+             p[1] > bds[3] || p[2] < bds[4] || p[2] > bds[5] )
+        {
+          outside = 1;
+        }
+        this->Buckets[i] = static_cast<TIds>(this->BList->GetBucketIndex(p));
+        if ( this->Buckets[i] != t->Bucket )
+        {
+          ++numMoved;
+        }
+      }
+    }
+
+    void Reduce()
+    {
+      for ( vtkSMPThreadLocal<vtkIdType>::iterator iter=this->NumMoved.begin();
+            iter != this->NumMoved.end(); ++iter )
+      {
+        this->TotalMoved += *iter;
+      }
+      for ( vtkSMPThreadLocal<unsigned char>::iterator iter=this->Outside.begin();
+            iter != this->Outside.end(); ++iter )
+      {
+        this->AnyOutside = this->AnyOutside || (*iter != 0);
+      }
+    }
+  };
+
+  // Update the map after the points have moved, keeping the bounds and the
+  // divisions of the locator. Only the points which changed bucket are
+  // moved in the sorted map: they are sorted separately and merged with the
+  // others, which are already in order. Returns false (leaving the locator
+  // unchanged) if a point left the bounds of the locator, in which case it
+  // must be rebuilt.
+  bool UpdateLocator() override
+  {
+    std::vector<TIds> buckets(this->NumPts);
+    vtkIdType numMoved;
+    bool outside;
+
+    vtkPointSet *ps = vtkPointSet::SafeDownCast(this->DataSet);
+    int dataType = ( ps && ps->GetPoints() ? ps->GetPoints()->GetDataType() : VTK_VOID );
+    if ( dataType == VTK_FLOAT )
+    {
+      PointsArrayAccessor<float> accessor{
+        static_cast<float*>(ps->GetPoints()->GetVoidPointer(0)) };
+      ReBinPoints<PointsArrayAccessor<float> > rebin(this, accessor, buckets.data());
+      vtkSMPTools::For(0, this->NumPts, rebin);
+      numMoved = rebin.TotalMoved;
+      outside = rebin.AnyOutside;
+    }
+    else if ( dataType == VTK_DOUBLE )
+    {
+      PointsArrayAccessor<double> accessor{
+        static_cast<double*>(ps->GetPoints()->GetVoidPointer(0)) };
+      ReBinPoints<PointsArrayAccessor<double> > rebin(this, accessor, buckets.data());
+      vtkSMPTools::For(0, this->NumPts, rebin);
+      numMoved = rebin.TotalMoved;
+      outside = rebin.AnyOutside;
+    }
+    else
+    {
+      DataSetAccessor accessor{ this->DataSet };
+      ReBinPoints<DataSetAccessor> rebin(this, accessor, buckets.data());
+      vtkSMPTools::For(0, this->NumPts, rebin);
+      numMoved = rebin.TotalMoved;
+      outside = rebin.AnyOutside;
+    }
+
+    if ( outside )
+    {
+      return false;
+    }
+    if ( numMoved == 0 )
+    {
+      return true;
+    }
+
+    if ( numMoved > this->NumPts / 8 )
+    {
+      // Too many points moved: simply sort again
+      for ( vtkIdType i=0; i < this->NumPts; ++i )
+      {
+        this->Map[i].Bucket = buckets[i];
+      }
+      vtkSMPTools::Sort(this->Map, this->Map + this->NumPts);
+    }
+    else
+    {
+      std::vector<LocatorTuple<TIds> > moved;
+      moved.reserve(numMoved);
+      for ( vtkIdType i=0; i < this->NumPts; ++i )
+      {
+        if ( buckets[i] != this->Map[i].Bucket )
+        {
+          LocatorTuple<TIds> t = this->Map[i];
+          t.Bucket = buckets[i];
+          moved.push_back(t);
+        }
+      }
+      std::sort(moved.begin(), moved.end());
+
+      LocatorTuple<TIds> *map = new LocatorTuple<TIds>[this->NumPts+1];
+      map[this->NumPts].Bucket = this->NumBuckets;
+      LocatorTuple<TIds> *out = map;
+      typename std::vector<LocatorTuple<TIds> >::iterator m = moved.begin();
+      for ( vtkIdType i=0; i < this->NumPts; ++i )
+      {
+        if ( buckets[i] != this->Map[i].Bucket )
+        {
+          continue; //has moved
+        }
+        for ( ; m != moved.end() && *m < this->Map[i]; ++m )
+        {
+          *out++ = *m;
+        }
+        *out++ = this->Map[i];
+      }
+      for ( ; m != moved.end(); ++m )
+      {
+        *out++ = *m;
+      }
+      delete [] this->Map;
+      this->Map = map;
+    }
+
+    int numBatches = static_cast<int>(
+      ceil(static_cast<double>(this->NumPts) / this->BatchSize));
+    MapOffsets<TIds> offMapper(this);
+    vtkSMPTools::For(0,numBatches, offMapper);
+    return true;
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -1673,6 +1868,7 @@ vtkStaticPointLocator::vtkStaticPointLocator()
   this->Buckets = nullptr;
   this->MaxNumberOfBuckets = VTK_INT_MAX;
   this->LargeIds = false;
+  this->IncrementalUpdate = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -1714,6 +1910,19 @@ void vtkStaticPointLocator::BuildLocator()
     return;
   }
 
+  // Only the points have changed: try to update the existing buckets
+  if ( this->IncrementalUpdate && (this->Buckets != nullptr) &&
+       (this->BuildTime > this->MTime) &&
+       this->DataSet->GetNumberOfPoints() == this->Buckets->NumPts )
+  {
+    vtkDebugMacro( << "Updating buckets..." );
+    if ( this->Buckets->UpdateLocator() )
+    {
+      this->BuildTime.Modified();
+      return;
+    }
+  }
+
   vtkDebugMacro( << "Hashing points..." );
   this->Level = 1; //only single lowest level - from superclass
 
@@ -1820,6 +2029,13 @@ vtkIdType vtkStaticPointLocator::FindClosestPoint(const double x[3])
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestPoints(vtkPoints *points,
+                                              vtkIdList *closestIds)
+{
+  this->FindClosestPointsInternal(points, closestIds, true);
+}
+
 //-----------------------------------------------------------------------------
 vtkIdType vtkStaticPointLocator::
 FindClosestPointWithinRadius(double radius, const double x[3],
@@ -2026,4 +2242,7 @@ void vtkStaticPointLocator::PrintSelf(ostream& os, vtkIndent indent)
      << this->MaxNumberOfBuckets << "\n";
 
   os << indent << "Large IDs: " << this->LargeIds << "\n";
+
+  os << indent << "Incremental Update: "
+     << (this->IncrementalUpdate ? "On\n" : "Off\n");
 }
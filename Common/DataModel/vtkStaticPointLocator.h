@@ -45,6 +45,7 @@
  *
  * @sa
  * vtkPointLocator vtkCellLocator vtkLocator vtkAbstractPointLocator
+ * vtkStaticKdTreePointLocator
 */
 
 #ifndef vtkStaticPointLocator_h
@@ -95,6 +96,22 @@ public:
   vtkGetVectorMacro(Divisions,int,3);
   //@}
 
+  //@{
+  /**
+   * Enable incremental updates of the locator (off by default). When
+   * enabled and only the points of the dataset have changed since the
+   * locator was built (same number of points, same locator parameters),
+   * BuildLocator() keeps the bounds and divisions of the locator and moves
+   * only the points which changed bucket. This is much faster than a full
+   * build when the points move a little, e.g. in deforming mesh
+   * simulations. If a point has left the bounds of the locator, the
+   * locator is rebuilt from scratch.
+   */
+  vtkSetMacro(IncrementalUpdate,bool);
+  vtkGetMacro(IncrementalUpdate,bool);
+  vtkBooleanMacro(IncrementalUpdate,bool);
+  //@}
+
   // Re-use any superclass signatures that we don't override.
   using vtkAbstractPointLocator::FindClosestPoint;
   using vtkAbstractPointLocator::FindClosestNPoints;
@@ -109,6 +126,13 @@ public:
    */
   vtkIdType FindClosestPoint(const double x[3]) override;
 
+  /**
+   * Find the closest point to each of the given points. Since
+   * FindClosestPoint() is thread safe, the queries are issued in parallel
+   * with vtkSMPTools once the locator has been built.
+   */
+  void FindClosestPoints(vtkPoints *points, vtkIdList *closestIds) override;
+
   //@{
   /**
    * Given a position x and a radius r, return the id of the point closest to
@@ -243,6 +267,7 @@ protected:
   vtkBucketList *Buckets; // Lists of point ids in each bucket
   vtkIdType MaxNumberOfBuckets; // Maximum number of buckets in locator
   bool LargeIds; //indicate whether integer ids are small or large
+  bool IncrementalUpdate; //move points between existing buckets if possible
 
 private:
   vtkStaticPointLocator(const vtkStaticPointLocator&) = delete;
@@ -0,0 +1,236 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTimeStepPrefetcher.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDataArray.h"
+#include "vtkImageAlgorithm.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStepPrefetcher.h"
+
+#include <vtksys/SystemTools.hxx>
+
+#include <map>
+
+#define CHECK(b, errors) if(!(b)){ errors++; cerr<<"Error on Line "<<__LINE__<<":"<<endl;}
+
+// A source with 10 time steps whose scalars hold the time value.
+// It counts how many times each step was produced, and takes some time to
+// produce a step when Delay is set.
+class TestPrefetchSource : public vtkImageAlgorithm
+{
+public:
+  static TestPrefetchSource *New();
+  vtkTypeMacro(TestPrefetchSource, vtkImageAlgorithm);
+
+  int GetNumberOfExecutions(double t)
+  {
+    std::map<double, int>::iterator it = this->Executions.find(t);
+    return it == this->Executions.end() ? 0 : it->second;
+  }
+
+protected:
+  TestPrefetchSource()
+  {
+    this->SetNumberOfInputPorts(0);
+    this->Delay = 0;
+  }
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**,
+                         vtkInformationVector* outputVector) override
+  {
+    vtkInformation* outInfo = outputVector->GetInformationObject(0);
+    double steps[10];
+    for (int i = 0; i < 10; ++i)
+    {
+      steps[i] = 0.5 * i;
+    }
+    double range[2] = { steps[0], steps[9] };
+    int extent[6] = { 0, 9, 0, 9, 0, 9 };
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), steps, 10);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), range, 2);
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), extent, 6);
+    return 1;
+  }
+
+  void ExecuteDataWithInformation(vtkDataObject* out, vtkInformation* outInfo) override
+  {
+    vtkImageData* image = this->AllocateOutputData(out, outInfo);
+    double t = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+    image->GetPointData()->GetScalars()->FillComponent(0, t);
+    image->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), t);
+    this->Executions[t]++;
+    if (this->Delay > 0)
+    {
+      vtksys::SystemTools::Delay(this->Delay);
+    }
+  }
+
+  std::map<double, int> Executions;
+
+public:
+  unsigned int Delay; // in milliseconds
+
+private:
+  TestPrefetchSource(const TestPrefetchSource&) = delete;
+  void operator=(const TestPrefetchSource&) = delete;
+};
+vtkStandardNewMacro(TestPrefetchSource);
+
+// A filter that passes its input through, downstream of the prefetcher.
+class TestPrefetchConsumer : public vtkImageAlgorithm
+{
+public:
+  static TestPrefetchConsumer *New();
+  vtkTypeMacro(TestPrefetchConsumer, vtkImageAlgorithm);
+
+protected:
+  TestPrefetchConsumer() {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+                  vtkInformationVector* outputVector) override
+  {
+    vtkDataObject* input = vtkDataObject::GetData(inputVector[0]);
+    vtkDataObject* output = vtkDataObject::GetData(outputVector);
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+private:
+  TestPrefetchConsumer(const TestPrefetchConsumer&) = delete;
+  void operator=(const TestPrefetchConsumer&) = delete;
+};
+vtkStandardNewMacro(TestPrefetchConsumer);
+
+static double GetImageValue(vtkDataObject* data)
+{
+  vtkImageData* image = vtkImageData::SafeDownCast(data);
+  return image->GetPointData()->GetScalars()->GetComponent(0, 0);
+}
+
+static double GetValue(vtkTimeStepPrefetcher* prefetcher)
+{
+  vtkImageData* image = vtkImageData::SafeDownCast(prefetcher->GetOutputDataObject(0));
+  return image->GetPointData()->GetScalars()->GetComponent(0, 0);
+}
+
+int TestTimeStepPrefetcher(int, char*[])
+{
+  int errors = 0;
+
+  vtkNew<TestPrefetchSource> source;
+  vtkNew<vtkTimeStepPrefetcher> prefetcher;
+  prefetcher->SetInputConnection(source->GetOutputPort());
+
+  // Requesting a step prefetches the next one.
+  prefetcher->UpdateTimeStep(1.0);
+  CHECK(GetValue(prefetcher) == 1.0, errors);
+  prefetcher->WaitForPrefetch();
+  CHECK(source->GetNumberOfExecutions(1.0) == 1, errors);
+  CHECK(source->GetNumberOfExecutions(1.5) == 1, errors);
+  CHECK(prefetcher->IsTimeStepCached(1.5), errors);
+
+  // Stepping forward is served from the cache and prefetches further.
+  prefetcher->UpdateTimeStep(1.5);
+  CHECK(GetValue(prefetcher) == 1.5, errors);
+  prefetcher->UpdateTimeStep(2.0);
+  CHECK(GetValue(prefetcher) == 2.0, errors);
+  prefetcher->WaitForPrefetch();
+  CHECK(source->GetNumberOfExecutions(1.5) == 1, errors);
+  CHECK(source->GetNumberOfExecutions(2.0) == 1, errors);
+  CHECK(source->GetNumberOfExecutions(2.5) == 1, errors);
+
+  // Going back to a cached step does not re-read it.
+  prefetcher->UpdateTimeStep(1.0);
+  CHECK(GetValue(prefetcher) == 1.0, errors);
+  CHECK(source->GetNumberOfExecutions(1.0) == 1, errors);
+
+  // Previous step prefetching.
+  prefetcher->PrefetchNextOff();
+  prefetcher->PrefetchPreviousOn();
+  prefetcher->UpdateTimeStep(4.0);
+  prefetcher->WaitForPrefetch();
+  CHECK(prefetcher->IsTimeStepCached(3.5), errors);
+  CHECK(!prefetcher->IsTimeStepCached(4.5), errors);
+
+  // Modifying the pipeline invalidates the cache.
+  source->Modified();
+  prefetcher->UpdateTimeStep(3.5);
+  CHECK(GetValue(prefetcher) == 3.5, errors);
+  CHECK(source->GetNumberOfExecutions(3.5) == 2, errors);
+
+  // The memory budget bounds the cache: a step of about 8 KiB fits in
+  // 0.012 MiB, but not together with its neighbour, so nothing is prefetched.
+  prefetcher->ClearCache();
+  prefetcher->PrefetchNextOn();
+  prefetcher->PrefetchPreviousOff();
+  prefetcher->SetMemoryBudget(0.012);
+  prefetcher->UpdateTimeStep(0.0);
+  prefetcher->WaitForPrefetch();
+  CHECK(prefetcher->GetNumberOfCachedTimeSteps() == 1, errors);
+  CHECK(source->GetNumberOfExecutions(0.5) == 0, errors);
+  prefetcher->SetMemoryBudget(0.0);
+  prefetcher->UpdateTimeStep(0.5);
+  CHECK(GetValue(prefetcher) == 0.5, errors);
+  CHECK(prefetcher->GetNumberOfCachedTimeSteps() == 0, errors);
+
+  // Keep updating a downstream filter while the next step is being
+  // prefetched: each update waits for the prefetch, and every step is still
+  // produced once.
+  {
+    vtkNew<TestPrefetchSource> slowSource;
+    slowSource->Delay = 20;
+    vtkNew<vtkTimeStepPrefetcher> slowPrefetcher;
+    slowPrefetcher->SetInputConnection(slowSource->GetOutputPort());
+    vtkNew<TestPrefetchConsumer> consumer;
+    consumer->SetInputConnection(slowPrefetcher->GetOutputPort());
+    for (int i = 0; i < 10; ++i)
+    {
+      double t = 0.5 * i;
+      consumer->UpdateTimeStep(t);
+      CHECK(GetImageValue(consumer->GetOutputDataObject(0)) == t, errors);
+      for (int j = 0; j < 3; ++j)
+      {
+        consumer->Modified();
+        consumer->UpdateTimeStep(t);
+        CHECK(GetImageValue(consumer->GetOutputDataObject(0)) == t, errors);
+      }
+    }
+    slowPrefetcher->WaitForPrefetch();
+    for (int i = 0; i < 10; ++i)
+    {
+      CHECK(slowSource->GetNumberOfExecutions(0.5 * i) == 1, errors);
+    }
+  }
+
+  // Nothing is prefetched when the source has another consumer.
+  {
+    vtkNew<TestPrefetchSource> sharedSource;
+    vtkNew<vtkTimeStepPrefetcher> sharedPrefetcher;
+    sharedPrefetcher->SetInputConnection(sharedSource->GetOutputPort());
+    vtkNew<TestPrefetchConsumer> otherConsumer;
+    otherConsumer->SetInputConnection(sharedSource->GetOutputPort());
+    sharedPrefetcher->UpdateTimeStep(1.0);
+    CHECK(GetValue(sharedPrefetcher) == 1.0, errors);
+    CHECK(!sharedPrefetcher->IsTimeStepCached(1.5), errors);
+    CHECK(sharedSource->GetNumberOfExecutions(1.5) == 0, errors);
+  }
+
+  return errors;
+}
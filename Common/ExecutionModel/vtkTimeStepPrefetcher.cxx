@@ -0,0 +1,539 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTimeStepPrefetcher.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkTimeStepPrefetcher.h"
+
+#include "vtkDataObject.h"
+#include "vtkInformation.h"
+#include "vtkInformationExecutivePortVectorKey.h"
+#include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkTimeStamp.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+class vtkTimeStepPrefetcher::vtkInternals
+{
+public:
+  struct Entry
+  {
+    vtkSmartPointer<vtkDataObject> Data;
+    // The data stays valid as long as the pipeline is not modified after this.
+    vtkMTimeType Stamp;
+    unsigned long LastUse;
+  };
+  typedef std::map<double, Entry> CacheType;
+
+  vtkInternals()
+  {
+    this->UseCounter = 0;
+    this->ThreadId = -1;
+    this->Pending = false;
+    this->Producer = nullptr;
+    this->ProducerPort = 0;
+  }
+
+  void Insert(double t, vtkDataObject* data, vtkMTimeType stamp)
+  {
+    Entry& entry = this->Cache[t];
+    entry.Data = data;
+    entry.Stamp = stamp;
+    entry.LastUse = ++this->UseCounter;
+  }
+
+  // Runs on the background thread. It only touches the prefetch members
+  // below and the upstream pipeline.
+  static VTK_THREAD_RETURN_TYPE Run(void* arg)
+  {
+    vtkMultiThreader::ThreadInfo* info =
+      static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    vtkInternals* self = static_cast<vtkInternals*>(info->UserData);
+    for (size_t i = 0; i < self->Targets.size(); ++i)
+    {
+      vtkNew<vtkInformation> req;
+      req->Copy(self->Request);
+      req->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), self->Targets[i]);
+      vtkNew<vtkInformationVector> reqs;
+      reqs->SetInformationObject(self->ProducerPort, req);
+      if (!self->Producer->Update(self->ProducerPort, reqs))
+      {
+        continue;
+      }
+      vtkDataObject* output = self->Producer->GetOutputDataObject(self->ProducerPort);
+      if (output)
+      {
+        vtkDataObject* copy = output->NewInstance();
+        copy->ShallowCopy(output);
+        self->Results[i].TakeReference(copy);
+        vtkTimeStamp stamp;
+        stamp.Modified();
+        self->Stamps[i] = stamp.GetMTime();
+      }
+    }
+    return VTK_THREAD_RETURN_VALUE;
+  }
+
+  CacheType Cache;
+  unsigned long UseCounter;
+
+  // Prefetch state. Pending is set when targets have been prepared but the
+  // thread is not started yet.
+  vtkNew<vtkMultiThreader> Threader;
+  int ThreadId;
+  bool Pending;
+  vtkAlgorithm* Producer;
+  int ProducerPort;
+  vtkNew<vtkInformation> Request;
+  std::vector<double> Targets;
+  std::vector<vtkSmartPointer<vtkDataObject> > Results;
+  std::vector<vtkMTimeType> Stamps;
+};
+
+//----------------------------------------------------------------------------
+// The executive of vtkTimeStepPrefetcher. It waits for the prefetch before
+// any request reaches the pipeline, and starts the prefetch prepared by
+// RequestData() once the whole REQUEST_DATA pass of the filter, including
+// the bookkeeping of the executive on its input and output, has returned.
+class vtkTimeStepPrefetcherExecutive : public vtkStreamingDemandDrivenPipeline
+{
+public:
+  static vtkTimeStepPrefetcherExecutive* New();
+  vtkTypeMacro(vtkTimeStepPrefetcherExecutive, vtkStreamingDemandDrivenPipeline);
+
+  int ProcessRequest(vtkInformation* request,
+                     vtkInformationVector** inInfoVec,
+                     vtkInformationVector* outInfoVec) override
+  {
+    vtkTimeStepPrefetcher* prefetcher =
+      vtkTimeStepPrefetcher::SafeDownCast(this->GetAlgorithm());
+    if (prefetcher)
+    {
+      prefetcher->WaitForPrefetch();
+    }
+    int result = this->Superclass::ProcessRequest(request, inInfoVec, outInfoVec);
+    if (prefetcher && request->Has(REQUEST_DATA()))
+    {
+      prefetcher->StartPrefetch();
+    }
+    return result;
+  }
+
+protected:
+  vtkTimeStepPrefetcherExecutive() {}
+  ~vtkTimeStepPrefetcherExecutive() override {}
+
+private:
+  vtkTimeStepPrefetcherExecutive(const vtkTimeStepPrefetcherExecutive&) = delete;
+  void operator=(const vtkTimeStepPrefetcherExecutive&) = delete;
+};
+
+vtkStandardNewMacro(vtkTimeStepPrefetcherExecutive);
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkTimeStepPrefetcher);
+
+//----------------------------------------------------------------------------
+vtkTimeStepPrefetcher::vtkTimeStepPrefetcher()
+{
+  this->PrefetchNext = 1;
+  this->PrefetchPrevious = 0;
+  this->MemoryBudget = 1024.0;
+  this->Internals = new vtkInternals;
+  this->SetNumberOfInputPorts(1);
+  this->SetNumberOfOutputPorts(1);
+}
+
+//----------------------------------------------------------------------------
+vtkTimeStepPrefetcher::~vtkTimeStepPrefetcher()
+{
+  this->WaitForPrefetch();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "PrefetchNext: " << this->PrefetchNext << endl;
+  os << indent << "PrefetchPrevious: " << this->PrefetchPrevious << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << " MiB" << endl;
+}
+
+//----------------------------------------------------------------------------
+vtkExecutive* vtkTimeStepPrefetcher::CreateDefaultExecutive()
+{
+  return vtkTimeStepPrefetcherExecutive::New();
+}
+
+//----------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::WaitForPrefetch()
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->ThreadId < 0)
+  {
+    return;
+  }
+  internals->Threader->TerminateThread(internals->ThreadId);
+  internals->ThreadId = -1;
+
+  for (size_t i = 0; i < internals->Targets.size(); ++i)
+  {
+    if (internals->Results[i])
+    {
+      internals->Insert(internals->Targets[i], internals->Results[i], internals->Stamps[i]);
+    }
+  }
+  internals->Targets.clear();
+  internals->Results.clear();
+  internals->Stamps.clear();
+  internals->Producer = nullptr;
+  this->ReduceCacheToBudget();
+}
+
+//----------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::ClearCache()
+{
+  this->WaitForPrefetch();
+  this->Internals->Cache.clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::GetNumberOfCachedTimeSteps()
+{
+  this->WaitForPrefetch();
+  return static_cast<int>(this->Internals->Cache.size());
+}
+
+//----------------------------------------------------------------------------
+bool vtkTimeStepPrefetcher::IsTimeStepCached(double t)
+{
+  this->WaitForPrefetch();
+  return this->Internals->Cache.find(t) != this->Internals->Cache.end();
+}
+
+//----------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::ReduceCacheToBudget()
+{
+  vtkInternals::CacheType& cache = this->Internals->Cache;
+  double size = 0.0;
+  vtkInternals::CacheType::iterator it;
+  for (it = cache.begin(); it != cache.end(); ++it)
+  {
+    size += it->second.Data->GetActualMemorySize() / 1024.0;
+  }
+  while (size > this->MemoryBudget && !cache.empty())
+  {
+    vtkInternals::CacheType::iterator oldest = cache.begin();
+    for (it = cache.begin(); it != cache.end(); ++it)
+    {
+      if (it->second.LastUse < oldest->second.LastUse)
+      {
+        oldest = it;
+      }
+    }
+    size -= oldest->second.Data->GetActualMemorySize() / 1024.0;
+    cache.erase(oldest);
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::ProcessRequest(vtkInformation* request,
+                                          vtkInformationVector** inputVector,
+                                          vtkInformationVector* outputVector)
+{
+  // The upstream pipeline must not be touched while it is being updated in
+  // the background.
+  this->WaitForPrefetch();
+
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA_OBJECT()))
+  {
+    return this->RequestDataObject(request, inputVector, outputVector);
+  }
+
+  if (request->Has(vtkStreamingDemandDrivenPipeline::REQUEST_UPDATE_EXTENT()))
+  {
+    return this->RequestUpdateExtent(request, inputVector, outputVector);
+  }
+
+  if (request->Has(vtkDemandDrivenPipeline::REQUEST_DATA()))
+  {
+    return this->RequestData(request, inputVector, outputVector);
+  }
+
+  return this->Superclass::ProcessRequest(request, inputVector, outputVector);
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::ComputePipelineMTime(vtkInformation* request,
+                                                vtkInformationVector** inInfoVec,
+                                                vtkInformationVector* outInfoVec,
+                                                int requestFromOutputPort,
+                                                vtkMTimeType* mtime)
+{
+  // This is the first thing any update that goes through this filter does,
+  // before the executive walks upstream.
+  this->WaitForPrefetch();
+  return this->Superclass::ComputePipelineMTime(
+    request, inInfoVec, outInfoVec, requestFromOutputPort, mtime);
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::FillInputPortInformation(int vtkNotUsed(port),
+                                                    vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::FillOutputPortInformation(int vtkNotUsed(port),
+                                                     vtkInformation* info)
+{
+  info->Set(vtkDataObject::DATA_TYPE_NAME(), "vtkDataObject");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::RequestDataObject(vtkInformation*,
+                                             vtkInformationVector** inputVector,
+                                             vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  if (!inInfo)
+  {
+    return 0;
+  }
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!input)
+  {
+    return 0;
+  }
+
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!output || !output->IsA(input->GetClassName()))
+  {
+    vtkDataObject* newOutput = input->NewInstance();
+    outInfo->Set(vtkDataObject::DATA_OBJECT(), newOutput);
+    newOutput->Delete();
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::RequestUpdateExtent(vtkInformation*,
+                                               vtkInformationVector** inputVector,
+                                               vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+
+  // Drop cached data that predates a modification of the pipeline.
+  vtkDemandDrivenPipeline* ddp =
+    vtkDemandDrivenPipeline::SafeDownCast(this->GetExecutive());
+  if (ddp)
+  {
+    vtkMTimeType pmt = ddp->GetPipelineMTime();
+    vtkInternals::CacheType& cache = this->Internals->Cache;
+    for (vtkInternals::CacheType::iterator it = cache.begin(); it != cache.end();)
+    {
+      if (it->second.Stamp < pmt)
+      {
+        cache.erase(it++);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  if (!outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+  {
+    return 1;
+  }
+
+  double upTime = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+  if (this->Internals->Cache.find(upTime) != this->Internals->Cache.end())
+  {
+    // Ask the input for what it already has so that it does not execute.
+    vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+    if (input && input->GetInformation()->Has(vtkDataObject::DATA_TIME_STEP()))
+    {
+      inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(),
+        input->GetInformation()->Get(vtkDataObject::DATA_TIME_STEP()));
+    }
+  }
+  else
+  {
+    inInfo->Set(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP(), upTime);
+  }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkTimeStepPrefetcher::RequestData(vtkInformation*,
+                                       vtkInformationVector** inputVector,
+                                       vtkInformationVector* outputVector)
+{
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkDataObject* input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+  vtkDataObject* output = outInfo->Get(vtkDataObject::DATA_OBJECT());
+  if (!input || !output)
+  {
+    return 0;
+  }
+
+  if (!outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP()))
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  double upTime = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
+  vtkInternals::CacheType::iterator pos = this->Internals->Cache.find(upTime);
+  if (pos != this->Internals->Cache.end())
+  {
+    output->ShallowCopy(pos->second.Data);
+    pos->second.LastUse = ++this->Internals->UseCounter;
+  }
+  else
+  {
+    // The input was updated for this time step: keep it.
+    output->ShallowCopy(input);
+    vtkDataObject* cached = input->NewInstance();
+    cached->ShallowCopy(input);
+    vtkTimeStamp stamp;
+    stamp.Modified();
+    this->Internals->Insert(upTime, cached, stamp.GetMTime());
+    cached->Delete();
+  }
+  output->GetInformation()->Set(vtkDataObject::DATA_TIME_STEP(), upTime);
+
+  this->ReduceCacheToBudget();
+  this->PreparePrefetch(inInfo, upTime, output->GetActualMemorySize() / 1024.0);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::PreparePrefetch(vtkInformation* inInfo, double t,
+                                            double stepSize)
+{
+  typedef vtkStreamingDemandDrivenPipeline vtkSDDP;
+
+  vtkInternals* internals = this->Internals;
+  internals->Pending = false;
+  if ((!this->PrefetchNext && !this->PrefetchPrevious) ||
+      !inInfo->Has(vtkSDDP::TIME_STEPS()))
+  {
+    return;
+  }
+
+  int numSteps = inInfo->Length(vtkSDDP::TIME_STEPS());
+  const double* steps = inInfo->Get(vtkSDDP::TIME_STEPS());
+  int current = static_cast<int>(std::upper_bound(steps, steps + numSteps, t) - steps) - 1;
+
+  // Next step first: it is the most likely to be requested.
+  std::vector<double> targets;
+  if (this->PrefetchNext && current + 1 < numSteps)
+  {
+    targets.push_back(steps[current + 1]);
+  }
+  if (this->PrefetchPrevious && current - 1 >= 0)
+  {
+    targets.push_back(steps[current - 1]);
+  }
+  std::vector<double> wanted;
+  for (size_t i = 0; i < targets.size(); ++i)
+  {
+    // Assume neighbouring steps are about as large as the current one.
+    if (internals->Cache.find(targets[i]) == internals->Cache.end() &&
+        (wanted.size() + 2) * stepSize <= this->MemoryBudget)
+    {
+      wanted.push_back(targets[i]);
+    }
+  }
+  if (wanted.empty())
+  {
+    return;
+  }
+
+  int producerPort = 0;
+  vtkAlgorithm* producer = this->GetInputAlgorithm(0, 0, producerPort);
+  if (!producer)
+  {
+    return;
+  }
+
+  // The background thread must be the only one to use the producer.
+  int numConsumers = 0;
+  for (int port = 0; port < producer->GetNumberOfOutputPorts(); ++port)
+  {
+    vtkInformation* producerInfo = producer->GetExecutive()->GetOutputInformation(port);
+    numConsumers += vtkExecutive::CONSUMERS()->Length(producerInfo);
+  }
+  if (numConsumers > 1)
+  {
+    vtkDebugMacro(<< "The input has other consumers: not prefetching.");
+    return;
+  }
+
+  // Keep the piece and extent of the current request.
+  internals->Request->Clear();
+  if (inInfo->Has(vtkSDDP::UPDATE_PIECE_NUMBER()))
+  {
+    internals->Request->CopyEntry(inInfo, vtkSDDP::UPDATE_PIECE_NUMBER());
+    internals->Request->CopyEntry(inInfo, vtkSDDP::UPDATE_NUMBER_OF_PIECES());
+    internals->Request->CopyEntry(inInfo, vtkSDDP::UPDATE_NUMBER_OF_GHOST_LEVELS());
+  }
+  if (inInfo->Has(vtkSDDP::UPDATE_EXTENT()))
+  {
+    internals->Request->CopyEntry(inInfo, vtkSDDP::UPDATE_EXTENT());
+  }
+
+  internals->Producer = producer;
+  internals->ProducerPort = producerPort;
+  internals->Targets = wanted;
+  internals->Results.assign(wanted.size(), nullptr);
+  internals->Stamps.assign(wanted.size(), 0);
+  internals->Pending = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkTimeStepPrefetcher::StartPrefetch()
+{
+  vtkInternals* internals = this->Internals;
+  if (!internals->Pending)
+  {
+    return;
+  }
+  internals->Pending = false;
+  internals->ThreadId = internals->Threader->SpawnThread(vtkInternals::Run, internals);
+  if (internals->ThreadId < 0)
+  {
+    internals->Targets.clear();
+    internals->Results.clear();
+    internals->Stamps.clear();
+    internals->Producer = nullptr;
+  }
+}
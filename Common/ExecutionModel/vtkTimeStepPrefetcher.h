@@ -0,0 +1,185 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkTimeStepPrefetcher.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkTimeStepPrefetcher
+ * @brief   update the upstream pipeline for the next time step in the background
+ *
+ * vtkTimeStepPrefetcher passes its input through and keeps a cache of time
+ * steps keyed by UPDATE_TIME_STEP. Once a time step has been produced, the
+ * upstream pipeline (typically a time-varying reader) is updated for the
+ * next time step, and optionally the previous one, on a background thread
+ * while the current step is processed downstream. A request for a cached
+ * time step is answered with a shallow copy of the cached data without
+ * re-executing upstream.
+ *
+ * The cache holds at most MemoryBudget MiB, measured with
+ * vtkDataObject::GetActualMemorySize(); least recently used time steps are
+ * dropped first, and a prefetch is only started when the estimated size of
+ * the prefetched steps fits in the budget. Cached data is discarded when the
+ * upstream pipeline is modified.
+ *
+ * The prefetch is started by the executive of this filter once its
+ * REQUEST_DATA pass has completely returned, so this filter's own executive
+ * is done with its input information and data when the background thread
+ * starts updating upstream. Every later request that goes through this
+ * filter, and any modified time query, first waits for the prefetch.
+ *
+ * @warning
+ * While a prefetch runs, the upstream algorithms execute (and invoke their
+ * observers) on the background thread. The producer of the input must
+ * therefore have no other consumer: when any output port of the producer
+ * is connected to another algorithm, nothing is prefetched. Code that
+ * modifies or updates the upstream algorithms directly must call
+ * WaitForPrefetch() beforehand. The prefetch relies on the executive
+ * created by CreateDefaultExecutive(); with another executive, nothing is
+ * prefetched.
+ *
+ * @sa
+ * vtkTemporalDataSetCache
+*/
+
+#ifndef vtkTimeStepPrefetcher_h
+#define vtkTimeStepPrefetcher_h
+
+#include "vtkCommonExecutionModelModule.h" // For export macro
+#include "vtkAlgorithm.h"
+
+class VTKCOMMONEXECUTIONMODEL_EXPORT vtkTimeStepPrefetcher : public vtkAlgorithm
+{
+public:
+  static vtkTimeStepPrefetcher *New();
+  vtkTypeMacro(vtkTimeStepPrefetcher, vtkAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Prefetch the time step following the one that was requested.
+   * On by default.
+   */
+  vtkSetMacro(PrefetchNext, vtkTypeBool);
+  vtkGetMacro(PrefetchNext, vtkTypeBool);
+  vtkBooleanMacro(PrefetchNext, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Prefetch the time step preceding the one that was requested, for
+   * scrubbing backwards. Off by default.
+   */
+  vtkSetMacro(PrefetchPrevious, vtkTypeBool);
+  vtkGetMacro(PrefetchPrevious, vtkTypeBool);
+  vtkBooleanMacro(PrefetchPrevious, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Maximum amount of memory, in MiB, held by the cached time steps.
+   * Defaults to 1024.
+   */
+  vtkSetClampMacro(MemoryBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(MemoryBudget, double);
+  //@}
+
+  /**
+   * Block until the background prefetch, if any, is done and move its
+   * result into the cache.
+   */
+  void WaitForPrefetch();
+
+  /**
+   * Drop every cached time step.
+   */
+  void ClearCache();
+
+  /**
+   * Return the number of time steps currently cached. This waits for any
+   * pending prefetch first.
+   */
+  int GetNumberOfCachedTimeSteps();
+
+  /**
+   * Return true when data for time \a t is cached. This waits for any
+   * pending prefetch first.
+   */
+  bool IsTimeStepCached(double t);
+
+  /**
+   * see vtkAlgorithm for details
+   */
+  int ProcessRequest(vtkInformation* request,
+                     vtkInformationVector** inputVector,
+                     vtkInformationVector* outputVector) override;
+
+  /**
+   * Waits for the background prefetch before the pipeline modified time is
+   * gathered upstream.
+   */
+  int ComputePipelineMTime(vtkInformation* request,
+                           vtkInformationVector** inInfoVec,
+                           vtkInformationVector* outInfoVec,
+                           int requestFromOutputPort,
+                           vtkMTimeType* mtime) override;
+
+protected:
+  vtkTimeStepPrefetcher();
+  ~vtkTimeStepPrefetcher() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int FillOutputPortInformation(int port, vtkInformation* info) override;
+
+  virtual int RequestDataObject(vtkInformation*,
+                                vtkInformationVector** inputVector,
+                                vtkInformationVector* outputVector);
+  virtual int RequestUpdateExtent(vtkInformation*,
+                                  vtkInformationVector** inputVector,
+                                  vtkInformationVector* outputVector);
+  virtual int RequestData(vtkInformation*,
+                          vtkInformationVector** inputVector,
+                          vtkInformationVector* outputVector);
+
+  vtkExecutive* CreateDefaultExecutive() override;
+
+  /**
+   * Choose the neighbours of time \a t to prefetch. They are updated by
+   * StartPrefetch() once the current request has returned.
+   */
+  void PreparePrefetch(vtkInformation* inInfo, double t, double stepSize);
+
+  /**
+   * Start updating the input for the prepared time steps on the background
+   * thread.
+   */
+  void StartPrefetch();
+
+  /**
+   * Drop least recently used time steps until the cache fits in the budget.
+   */
+  void ReduceCacheToBudget();
+
+  vtkTypeBool PrefetchNext;
+  vtkTypeBool PrefetchPrevious;
+  double MemoryBudget;
+
+private:
+  vtkTimeStepPrefetcher(const vtkTimeStepPrefetcher&) = delete;
+  void operator=(const vtkTimeStepPrefetcher&) = delete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+
+  friend class vtkTimeStepPrefetcherExecutive;
+};
+
+#endif
@@ -87,6 +87,7 @@ static int TestScalarLogic();
 static int TestVectorLogic();
 static int TestMiscFunctions();
 static int TestErrors();
+static int TestEvaluateBlock();
 
 int UnitTestFunctionParser(int,char *[])
 {
@@ -121,6 +122,7 @@ int UnitTestFunctionParser(int,char *[])
 
   status += TestMiscFunctions();
   status += TestErrors();
+  status += TestEvaluateBlock();
   if (status != 0)
   {
     return EXIT_FAILURE;
@@ -1116,3 +1118,124 @@ int TestErrors()
   }
   return status;
 }
+
+int TestEvaluateBlock()
+{
+  int status = 0;
+  std::cout << "Testing EvaluateBlock" << "...";
+
+  vtkSmartPointer<vtkFunctionParser> parser =
+    vtkSmartPointer<vtkFunctionParser>::New();
+
+  // Invalid values are reported by the tuple by tuple evaluation
+  vtkSmartPointer<vtkTest::ErrorObserver>  errorObserver =
+    vtkSmartPointer<vtkTest::ErrorObserver>::New();
+  parser->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+
+  const vtkIdType numTuples = 1000;
+  std::vector<double> a(numTuples), b(numTuples);
+  std::vector<double> v[3], w[3];
+  for (int j = 0; j < 3; ++j)
+  {
+    v[j].resize(numTuples);
+    w[j].resize(numTuples);
+  }
+  for (vtkIdType i = 0; i < numTuples; ++i)
+  {
+    a[i] = vtkMath::Random(-2.0, 2.0);
+    b[i] = (i % 10 == 0 ? 0.0 : vtkMath::Random(-2.0, 2.0));
+    for (int j = 0; j < 3; ++j)
+    {
+      v[j][i] = vtkMath::Random(-1.0, 1.0);
+      w[j][i] = (i % 7 == 0 ? 0.0 : vtkMath::Random(-1.0, 1.0));
+    }
+  }
+  const double* scalars[3] = { a.data(), b.data(), nullptr };
+  const double* vectors[6] = { v[0].data(), v[1].data(), v[2].data(),
+                               w[0].data(), w[1].data(), w[2].data() };
+
+  // The variable c is not given per tuple, its current value is used
+  const char* functions[] = {
+    "a*b + c/2 - abs(a)^2",
+    "a/b + sqrt(a) - ln(b) + log10(abs(a))",
+    "sin(a)*cos(b) + tan(a) + exp(b) - asin(a) + acos(b) + atan(a*b)",
+    "sinh(a) + cosh(b) - tanh(a) + ceil(a) - floor(b) + sign(a)",
+    "if(a > b & a > 0, a, -b) + min(a, c) - max(b, c) + (a = b) + (a < b | b < 0)",
+    "v.w + mag(v) - a^b",
+    "cross(v, w) + a*v - w*b + c*iHat + jHat - kHat",
+    "norm(w)*mag(v) - v",
+    "if(a < 0, v, cross(w, v)) + -w"
+  };
+
+  int cases = static_cast<int>(sizeof(functions) / sizeof(functions[0]));
+  for (int replace = 0; replace < 2; ++replace)
+  {
+    parser->SetReplaceInvalidValues(replace);
+    parser->SetReplacementValue(-42.0);
+    for (int f = 0; f < cases; ++f)
+    {
+      parser->RemoveAllVariables();
+      parser->SetScalarVariableValue("a", 0.5);
+      parser->SetScalarVariableValue("b", 0.5);
+      parser->SetScalarVariableValue("c", 3.0);
+      parser->SetVectorVariableValue("v", 1.0, 0.0, 0.0);
+      parser->SetVectorVariableValue("w", 0.0, 1.0, 0.0);
+      parser->SetFunction(functions[f]);
+      if (!parser->IsScalarResult() && !parser->IsVectorResult())
+      {
+        std::cout << "\n" << functions[f] << " is not valid";
+        ++status;
+        continue;
+      }
+      int numComps = parser->IsScalarResult() ? 1 : 3;
+      std::vector<double> block(numTuples * numComps);
+      bool ok = parser->EvaluateBlock(numTuples, scalars, vectors, block.data());
+
+      bool expectedOk = true;
+      for (vtkIdType i = 0; i < numTuples; ++i)
+      {
+        parser->SetScalarVariableValue("a", a[i]);
+        parser->SetScalarVariableValue("b", b[i]);
+        parser->SetVectorVariableValue("v", v[0][i], v[1][i], v[2][i]);
+        parser->SetVectorVariableValue("w", w[0][i], w[1][i], w[2][i]);
+        double expected[3];
+        if (numComps == 1)
+        {
+          expected[0] = parser->GetScalarResult();
+        }
+        else
+        {
+          parser->GetVectorResult(expected);
+        }
+        for (int j = 0; j < numComps; ++j)
+        {
+          expectedOk &= (expected[j] != VTK_PARSER_ERROR_RESULT);
+          double result = block[i * numComps + j];
+          if (result != expected[j] &&
+            !(vtkMath::IsNan(result) && vtkMath::IsNan(expected[j])))
+          {
+            std::cout << "\n" << functions[f] << ": tuple " << i
+                      << " expected " << expected[j] << " but got " << result;
+            ++status;
+            break;
+          }
+        }
+      }
+      if (ok != expectedOk)
+      {
+        std::cout << "\n" << functions[f] << ": EvaluateBlock returned " << ok;
+        ++status;
+      }
+    }
+  }
+
+  if (status== 0)
+  {
+    std::cout << "PASSED\n";
+  }
+  else
+  {
+    std::cout << "FAILED\n";
+  }
+  return status;
+}
@@ -17,6 +17,7 @@
 
 #include <cctype>
 #include <algorithm>
+#include <cmath>
 
 vtkStandardNewMacro(vtkFunctionParser);
 
@@ -863,6 +864,547 @@ bool vtkFunctionParser::Evaluate()
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// Vectorized evaluation. The stack is stored as a structure of arrays: stack
+// position p holds the values of all the tuples in the block, so that each
+// operation becomes a simple loop which the compiler can vectorize. The
+// sequence of stack positions does not depend on the values (both branches
+// of "if" are always evaluated), so the bytecode is only decoded once per
+// block. Every operation mirrors the one in Evaluate() so that the results
+// are identical.
+bool vtkFunctionParser::EvaluateBlock(vtkIdType numTuples,
+                                      const double* const* scalarValues,
+                                      const double* const* vectorValues,
+                                      double* result)
+{
+  if (this->FunctionMTime.GetMTime() > this->ParseMTime.GetMTime())
+  {
+    if (this->Parse() == 0)
+    {
+      return false;
+    }
+  }
+  if (numTuples <= 0)
+  {
+    return true;
+  }
+
+  const vtkIdType n = numTuples;
+  std::vector<double> registers(static_cast<size_t>(this->StackSize) * n);
+  std::vector<unsigned char> failed(n, 0);
+  bool anyFailed = false;
+  const bool replace = (this->ReplaceInvalidValues != 0);
+  const double replacement = this->ReplacementValue;
+  const int numScalars = this->GetNumberOfScalarVariables();
+  int numImmediatesProcessed = 0;
+  int stackPosition = -1;
+  vtkIdType i;
+
+  // Stack position p of all the tuples
+  #define vtkSlot(p) (registers.data() + static_cast<size_t>(p) * n)
+
+  // An invalid argument is replaced, or the tuple is marked as failed
+  #define vtkInvalidArgument(x) \
+    if (replace) \
+    { \
+      x = replacement; \
+    } \
+    else \
+    { \
+      failed[i] = 1; \
+      anyFailed = true; \
+    }
+
+  for (int numBytesProcessed = 0; numBytesProcessed < this->ByteCodeSize;
+       numBytesProcessed++)
+  {
+    double *a = (stackPosition >= 1 ? vtkSlot(stackPosition-1) : nullptr);
+    double *b = (stackPosition >= 0 ? vtkSlot(stackPosition) : nullptr);
+    switch (this->ByteCode[numBytesProcessed])
+    {
+      case VTK_PARSER_IMMEDIATE:
+        b = vtkSlot(++stackPosition);
+        std::fill(b, b + n, this->Immediates[numImmediatesProcessed++]);
+        break;
+      case VTK_PARSER_UNARY_MINUS:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = -b[i];
+        }
+        break;
+      case VTK_PARSER_UNARY_PLUS:
+        break;
+      case VTK_PARSER_ADD:
+        for (i = 0; i < n; i++)
+        {
+          a[i] += b[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_SUBTRACT:
+        for (i = 0; i < n; i++)
+        {
+          a[i] -= b[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MULTIPLY:
+        for (i = 0; i < n; i++)
+        {
+          a[i] *= b[i];
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_DIVIDE:
+        for (i = 0; i < n; i++)
+        {
+          if (b[i] == 0)
+          {
+            vtkInvalidArgument(a[i]);
+          }
+          else
+          {
+            a[i] /= b[i];
+          }
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_POWER:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = pow(a[i], b[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_ABSOLUTE_VALUE:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = fabs(b[i]);
+        }
+        break;
+      case VTK_PARSER_EXPONENT:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = exp(b[i]);
+        }
+        break;
+      case VTK_PARSER_CEILING:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = ceil(b[i]);
+        }
+        break;
+      case VTK_PARSER_FLOOR:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = floor(b[i]);
+        }
+        break;
+      case VTK_PARSER_LOGARITHM:
+      case VTK_PARSER_LOGARITHME:
+        for (i = 0; i < n; i++)
+        {
+          if (b[i] <= 0)
+          {
+            vtkInvalidArgument(b[i]);
+          }
+          else
+          {
+            b[i] = log(b[i]);
+          }
+        }
+        break;
+      case VTK_PARSER_LOGARITHM10:
+        for (i = 0; i < n; i++)
+        {
+          if (b[i] <= 0)
+          {
+            vtkInvalidArgument(b[i]);
+          }
+          else
+          {
+            b[i] = log10(b[i]);
+          }
+        }
+        break;
+      case VTK_PARSER_SQUARE_ROOT:
+        for (i = 0; i < n; i++)
+        {
+          if (b[i] < 0)
+          {
+            vtkInvalidArgument(b[i]);
+          }
+          else
+          {
+            b[i] = sqrt(b[i]);
+          }
+        }
+        break;
+      case VTK_PARSER_SINE:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = sin(b[i]);
+        }
+        break;
+      case VTK_PARSER_COSINE:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = cos(b[i]);
+        }
+        break;
+      case VTK_PARSER_TANGENT:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = tan(b[i]);
+        }
+        break;
+      case VTK_PARSER_ARCSINE:
+        for (i = 0; i < n; i++)
+        {
+          if (b[i] < -1 || b[i] > 1)
+          {
+            vtkInvalidArgument(b[i]);
+          }
+          else
+          {
+            b[i] = asin(b[i]);
+          }
+        }
+        break;
+      case VTK_PARSER_ARCCOSINE:
+        for (i = 0; i < n; i++)
+        {
+          if (b[i] < -1 || b[i] > 1)
+          {
+            vtkInvalidArgument(b[i]);
+          }
+          else
+          {
+            b[i] = acos(b[i]);
+          }
+        }
+        break;
+      case VTK_PARSER_ARCTANGENT:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = atan(b[i]);
+        }
+        break;
+      case VTK_PARSER_HYPERBOLIC_SINE:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = sinh(b[i]);
+        }
+        break;
+      case VTK_PARSER_HYPERBOLIC_COSINE:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = cosh(b[i]);
+        }
+        break;
+      case VTK_PARSER_HYPERBOLIC_TANGENT:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = tanh(b[i]);
+        }
+        break;
+      case VTK_PARSER_MIN:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (b[i] < a[i] ? b[i] : a[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_MAX:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (b[i] > a[i] ? b[i] : a[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_CROSS:
+      {
+        double *ux = vtkSlot(stackPosition-5), *uy = vtkSlot(stackPosition-4);
+        double *uz = vtkSlot(stackPosition-3), *vx = vtkSlot(stackPosition-2);
+        double *vy = a, *vz = b;
+        for (i = 0; i < n; i++)
+        {
+          double x = uy[i]*vz[i] - uz[i]*vy[i];
+          double y = uz[i]*vx[i] - ux[i]*vz[i];
+          double z = ux[i]*vy[i] - uy[i]*vx[i];
+          ux[i] = x;
+          uy[i] = y;
+          uz[i] = z;
+        }
+        stackPosition -= 3;
+        break;
+      }
+      case VTK_PARSER_SIGN:
+        for (i = 0; i < n; i++)
+        {
+          b[i] = (b[i] < 0 ? -1 : (b[i] == 0 ? 0 : 1));
+        }
+        break;
+      case VTK_PARSER_VECTOR_UNARY_MINUS:
+      {
+        double *x = vtkSlot(stackPosition-2);
+        for (i = 0; i < n; i++)
+        {
+          x[i] = -x[i];
+          a[i] = -a[i];
+          b[i] = -b[i];
+        }
+        break;
+      }
+      case VTK_PARSER_VECTOR_UNARY_PLUS:
+        break;
+      case VTK_PARSER_DOT_PRODUCT:
+      {
+        double *ux = vtkSlot(stackPosition-5), *uy = vtkSlot(stackPosition-4);
+        double *uz = vtkSlot(stackPosition-3), *vx = vtkSlot(stackPosition-2);
+        for (i = 0; i < n; i++)
+        {
+          ux[i] = ux[i]*vx[i] + uy[i]*a[i] + uz[i]*b[i];
+        }
+        stackPosition -= 5;
+        break;
+      }
+      case VTK_PARSER_VECTOR_ADD:
+      case VTK_PARSER_VECTOR_SUBTRACT:
+      {
+        double *ux = vtkSlot(stackPosition-5), *uy = vtkSlot(stackPosition-4);
+        double *uz = vtkSlot(stackPosition-3), *vx = vtkSlot(stackPosition-2);
+        if (this->ByteCode[numBytesProcessed] == VTK_PARSER_VECTOR_ADD)
+        {
+          for (i = 0; i < n; i++)
+          {
+            ux[i] += vx[i];
+            uy[i] += a[i];
+            uz[i] += b[i];
+          }
+        }
+        else
+        {
+          for (i = 0; i < n; i++)
+          {
+            ux[i] -= vx[i];
+            uy[i] -= a[i];
+            uz[i] -= b[i];
+          }
+        }
+        stackPosition -= 3;
+        break;
+      }
+      case VTK_PARSER_SCALAR_TIMES_VECTOR:
+      {
+        double *s = vtkSlot(stackPosition-3), *x = vtkSlot(stackPosition-2);
+        for (i = 0; i < n; i++)
+        {
+          double si = s[i];
+          s[i] = x[i] * si;
+          x[i] = a[i] * si;
+          a[i] = b[i] * si;
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_VECTOR_TIMES_SCALAR:
+      case VTK_PARSER_VECTOR_OVER_SCALAR:
+      {
+        double *x = vtkSlot(stackPosition-3), *y = vtkSlot(stackPosition-2);
+        if (this->ByteCode[numBytesProcessed] == VTK_PARSER_VECTOR_TIMES_SCALAR)
+        {
+          for (i = 0; i < n; i++)
+          {
+            x[i] *= b[i];
+            y[i] *= b[i];
+            a[i] *= b[i];
+          }
+        }
+        else
+        {
+          for (i = 0; i < n; i++)
+          {
+            x[i] /= b[i];
+            y[i] /= b[i];
+            a[i] /= b[i];
+          }
+        }
+        stackPosition--;
+        break;
+      }
+      case VTK_PARSER_MAGNITUDE:
+      {
+        double *x = vtkSlot(stackPosition-2);
+        for (i = 0; i < n; i++)
+        {
+          x[i] = sqrt(b[i]*b[i] + a[i]*a[i] + x[i]*x[i]);
+        }
+        stackPosition -= 2;
+        break;
+      }
+      case VTK_PARSER_NORMALIZE:
+      {
+        double *x = vtkSlot(stackPosition-2);
+        for (i = 0; i < n; i++)
+        {
+          double magnitude = sqrt(b[i]*b[i] + a[i]*a[i] + x[i]*x[i]);
+          if (magnitude != 0)
+          {
+            b[i] /= magnitude;
+            a[i] /= magnitude;
+            x[i] /= magnitude;
+          }
+        }
+        break;
+      }
+      case VTK_PARSER_IHAT:
+      case VTK_PARSER_JHAT:
+      case VTK_PARSER_KHAT:
+      {
+        int axis = this->ByteCode[numBytesProcessed] - VTK_PARSER_IHAT;
+        for (int j = 0; j < 3; j++)
+        {
+          b = vtkSlot(++stackPosition);
+          std::fill(b, b + n, (j == axis ? 1.0 : 0.0));
+        }
+        break;
+      }
+      case VTK_PARSER_LESS_THAN:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (a[i] < b[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_GREATER_THAN:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (a[i] > b[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_EQUAL_TO:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (a[i] == b[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_AND:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (a[i] && b[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_OR:
+        for (i = 0; i < n; i++)
+        {
+          a[i] = (a[i] || b[i]);
+        }
+        stackPosition--;
+        break;
+      case VTK_PARSER_IF:
+      {
+        // b is the boolean, a the true value and the result (the false
+        // value) is below them.
+        double *r = vtkSlot(stackPosition-2);
+        for (i = 0; i < n; i++)
+        {
+          r[i] = (b[i] != 0.0 ? a[i] : r[i]);
+        }
+        stackPosition -= 2;
+        break;
+      }
+      case VTK_PARSER_VECTOR_IF:
+      {
+        for (int j = 0; j < 3; j++)
+        {
+          double *r = vtkSlot(stackPosition-6+j);
+          const double *t = vtkSlot(stackPosition-3+j);
+          for (i = 0; i < n; i++)
+          {
+            r[i] = (b[i] != 0.0 ? t[i] : r[i]);
+          }
+        }
+        stackPosition -= 4;
+        break;
+      }
+      default:
+      {
+        int var = this->ByteCode[numBytesProcessed] - VTK_PARSER_BEGIN_VARIABLES;
+        if (var < numScalars)
+        {
+          b = vtkSlot(++stackPosition);
+          const double *values = (scalarValues ? scalarValues[var] : nullptr);
+          if (values)
+          {
+            std::copy(values, values + n, b);
+          }
+          else
+          {
+            std::fill(b, b + n, this->ScalarVariableValues[var]);
+          }
+        }
+        else
+        {
+          int vectorNum = var - numScalars;
+          for (int j = 0; j < 3; j++)
+          {
+            b = vtkSlot(++stackPosition);
+            const double *values = (vectorValues ? vectorValues[3*vectorNum+j] : nullptr);
+            if (values)
+            {
+              std::copy(values, values + n, b);
+            }
+            else
+            {
+              std::fill(b, b + n, this->VectorVariableValues[vectorNum][j]);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  #undef vtkSlot
+  #undef vtkInvalidArgument
+
+  // Gather the results
+  if (stackPosition == 0)
+  {
+    const double *x = registers.data();
+    for (i = 0; i < n; i++)
+    {
+      result[i] = (failed[i] ? VTK_PARSER_ERROR_RESULT : x[i]);
+    }
+  }
+  else if (stackPosition == 2)
+  {
+    const double *x = registers.data(), *y = x + n, *z = y + n;
+    for (i = 0; i < n; i++, result += 3)
+    {
+      if (failed[i])
+      {
+        result[0] = result[1] = result[2] = VTK_PARSER_ERROR_RESULT;
+      }
+      else
+      {
+        result[0] = x[i];
+        result[1] = y[i];
+        result[2] = z[i];
+      }
+    }
+  }
+  else
+  {
+    return false;
+  }
+
+  return !anyFailed;
+}
+
 //-----------------------------------------------------------------------------
 int vtkFunctionParser::IsScalarResult()
 {
@@ -177,6 +177,29 @@ public:
     result[0] = r[0]; result[1] = r[1]; result[2] = r[2]; };
   //@}
 
+  /**
+   * Evaluate the function for a block of numTuples tuples at once. The
+   * bytecode is run once for the whole block, each operation looping over
+   * the tuples, which is much faster than setting the variables and calling
+   * GetScalarResult() or GetVectorResult() for every tuple. scalarValues[i]
+   * points to the numTuples values of the ith scalar variable, and
+   * vectorValues[3*i+j] to the numTuples values of the jth component of the
+   * ith vector variable. A null pointer (or a null scalarValues or
+   * vectorValues) means that the current value of the variable is used for
+   * all the tuples. The results are written to result, one value per tuple
+   * for a scalar function and three interleaved values per tuple for a
+   * vector function (see IsScalarResult() and IsVectorResult()).
+   *
+   * The results are identical to those of the tuple by tuple evaluation.
+   * Tuples which cannot be evaluated (e.g., division by zero when
+   * ReplaceInvalidValues is off) are set to VTK_PARSER_ERROR_RESULT, and
+   * false is returned; no error is reported. Once the function has been
+   * parsed (e.g., by calling IsScalarResult()), this method is thread safe,
+   * so different blocks may be evaluated concurrently.
+   */
+  bool EvaluateBlock(vtkIdType numTuples, const double* const* scalarValues,
+                     const double* const* vectorValues, double* result);
+
   //@{
   /**
    * Set the value of a scalar variable.  If a variable with this name
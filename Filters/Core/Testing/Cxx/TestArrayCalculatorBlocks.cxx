@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestArrayCalculatorBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkArrayCalculator, which evaluates its function over blocks of
+// tuples in parallel, gives the same results as vtkFunctionParser evaluated
+// tuple by tuple.
+
+#include "TestCalculatorCases.h"
+
+#include "vtkCellData.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+
+int CheckResults(vtkDataArray* result, vtkDoubleArray* expected, int resultType, const char* fun)
+{
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < result->GetNumberOfComponents(); ++j)
+    {
+      double e = expected->GetComponent(i, j);
+      if (resultType == VTK_FLOAT)
+      {
+        e = static_cast<float>(e);
+      }
+      if (result->GetComponent(i, j) != e)
+      {
+        cerr << fun << ": tuple " << i << " is " << result->GetComponent(i, j) << ", expected "
+             << e << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestArrayCalculatorBlocks(int, char*[])
+{
+  int errors = 0;
+  const vtkIdType numPts = 100000;
+  vtkNew<vtkPolyData> input;
+  MakeCalculatorInput(numPts, input);
+
+  vtkNew<vtkArrayCalculator> calc;
+  calc->SetInputData(input);
+  calc->SetAttributeTypeToPointData();
+  AddCalculatorVariables(calc);
+  calc->SetReplacementValue(-1.0);
+  calc->SetResultArrayName("result");
+  vtkNew<vtkTest::ErrorObserver> observer;
+  calc->AddObserver(vtkCommand::ErrorEvent, observer);
+
+  vtkNew<vtkDoubleArray> expected;
+  for (const CalculatorCase& c : CalculatorCases)
+  {
+    calc->SetFunction(c.Function);
+    calc->SetReplaceInvalidValues(c.Replace);
+    calc->SetResultArrayType(c.ResultType);
+    calc->Update();
+    ReferenceResults(input, c, expected);
+
+    vtkDataArray* result = calc->GetPolyDataOutput()->GetPointData()->GetArray("result");
+    if (!result || result->GetDataType() != c.ResultType ||
+      result->GetNumberOfTuples() != numPts)
+    {
+      cerr << c.Function << ": missing or wrong result array" << endl;
+      ++errors;
+      continue;
+    }
+    errors += CheckResults(result, expected, c.ResultType, c.Function);
+
+    // A single error is reported for all the invalid tuples
+    bool invalid = (!c.Replace && c.Function[0] == 's' && c.Function[1] == '/');
+    std::string message = observer->GetErrorMessage();
+    if (observer->GetError() != invalid ||
+      (invalid && message.find("could not", message.find("could not") + 1) != std::string::npos))
+    {
+      cerr << c.Function << ": unexpected errors: " << message << endl;
+      ++errors;
+    }
+    observer->Clear();
+  }
+
+  // Cell data, through the generic array API
+  vtkNew<vtkCellArray> verts;
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    verts->InsertNextCell(1, &i);
+  }
+  input->SetVerts(verts);
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("c");
+  cellScalars->SetNumberOfTuples(1000);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    cellScalars->SetValue(i, i);
+  }
+  input->GetCellData()->AddArray(cellScalars);
+  vtkNew<vtkArrayCalculator> cellCalc;
+  cellCalc->SetInputData(input);
+  cellCalc->SetAttributeTypeToCellData();
+  cellCalc->AddScalarArrayName("c");
+  cellCalc->SetFunction("c^2 - 1");
+  cellCalc->SetResultArrayName("result");
+  cellCalc->Update();
+  vtkDataArray* cellResult = cellCalc->GetPolyDataOutput()->GetCellData()->GetArray("result");
+  for (vtkIdType i = 0; cellResult && i < 1000; ++i)
+  {
+    if (cellResult->GetComponent(i, 0) != std::pow(static_cast<double>(i), 2.0) - 1)
+    {
+      cerr << "Wrong cell result " << cellResult->GetComponent(i, 0) << " for cell " << i << endl;
+      ++errors;
+      break;
+    }
+  }
+  if (!cellResult)
+  {
+    cerr << "Missing cell result" << endl;
+    ++errors;
+  }
+
+  return errors;
+}
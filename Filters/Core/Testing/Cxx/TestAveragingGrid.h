@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestAveragingGrid.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by TestCellDataToPointDataAveraging and
+// TimeCellDataToPointData: an unstructured grid with cells of several
+// dimensions, and the point and cell arrays averaged by the filters.
+
+#ifndef TestAveragingGrid_h
+#define TestAveragingGrid_h
+
+#include "vtkCellType.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+// Random vectors "v" and integers "i" for num points or cells
+inline void AddArrays(vtkDataSetAttributes* attributes, vtkIdType num)
+{
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("v");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(num);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("i");
+  ints->SetNumberOfTuples(num);
+  for (vtkIdType i = 0; i < num; ++i)
+  {
+    vectors->SetTuple3(
+      i, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0));
+    ints->SetValue(i, static_cast<int>(i % 17) * 10);
+  }
+  attributes->AddArray(vectors);
+  attributes->AddArray(ints);
+}
+
+// A block of n^3 hexahedra, a third of which are replaced by tetrahedra,
+// with quads and lines on the boundary and an unused point
+inline void MakeMixedGrid(int n, vtkUnstructuredGrid* ugrid)
+{
+  int np = n + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  points->InsertNextPoint(-1.0, -1.0, -1.0);
+  ugrid->SetPoints(points);
+  ugrid->Allocate(n * n * n);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        vtkIdType h[8];
+        for (int v = 0; v < 8; ++v)
+        {
+          int di = ((v + 1) / 2) % 2, dj = (v / 2) % 2, dk = v / 4;
+          h[v] = (i + di) + np * ((j + dj) + np * (k + dk));
+        }
+        if ((i + j + k) % 3 == 0)
+        {
+          vtkIdType tet[4] = { h[0], h[1], h[3], h[4] };
+          ugrid->InsertNextCell(VTK_TETRA, 4, tet);
+        }
+        else
+        {
+          ugrid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+        }
+        if (k == 0)
+        {
+          ugrid->InsertNextCell(VTK_QUAD, 4, h);
+        }
+        if (k == 0 && j == 0)
+        {
+          ugrid->InsertNextCell(VTK_LINE, 2, h);
+        }
+      }
+    }
+  }
+}
+
+}
+
+#endif
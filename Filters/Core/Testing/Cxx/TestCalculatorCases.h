@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCalculatorCases.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by TestArrayCalculatorBlocks and TimeArrayCalculator:
+// random point data, the functions evaluated on it and their tuple by tuple
+// evaluation with vtkFunctionParser.
+
+#ifndef TestCalculatorCases_h
+#define TestCalculatorCases_h
+
+#include "vtkArrayCalculator.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkFunctionParser.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+
+namespace
+{
+
+struct CalculatorCase
+{
+  const char* Function;
+  bool Replace;
+  int ResultType;
+};
+
+const CalculatorCase CalculatorCases[] = {
+  { "s*t1 + k - coordsZ^2 + sin(s)*exp(t1)", false, VTK_DOUBLE },
+  { "cross(t, coords) + s*tswap - norm(coords)*mag(t)", false, VTK_DOUBLE },
+  { "if(k > 0, t, coords) + (t . coords)*iHat", false, VTK_FLOAT },
+  { "s/k + ln(t1) - sqrt(coordsZ)", true, VTK_DOUBLE },
+  { "s/k + ln(t1) - sqrt(coordsZ)", false, VTK_DOUBLE },
+  { "norm(tswap - kHat)", false, VTK_FLOAT },
+};
+
+// Evaluate the function tuple by tuple, with the variables of the filter.
+inline void ReferenceResults(vtkPolyData* input, const CalculatorCase& c, vtkDoubleArray* expected)
+{
+  vtkNew<vtkFunctionParser> parser;
+  vtkNew<vtkTest::ErrorObserver> observer;
+  parser->AddObserver(vtkCommand::ErrorEvent, observer);
+  parser->SetReplaceInvalidValues(c.Replace);
+  parser->SetReplacementValue(-1.0);
+  vtkDataArray* s = input->GetPointData()->GetArray("s");
+  vtkDataArray* t = input->GetPointData()->GetArray("t");
+  vtkDataArray* k = input->GetPointData()->GetArray("k");
+  parser->SetScalarVariableValue("s", 0.0);
+  parser->SetScalarVariableValue("t1", 0.0);
+  parser->SetScalarVariableValue("k", 0.0);
+  parser->SetScalarVariableValue("coordsZ", 0.0);
+  parser->SetVectorVariableValue("t", 0.0, 0.0, 0.0);
+  parser->SetVectorVariableValue("tswap", 0.0, 0.0, 0.0);
+  parser->SetVectorVariableValue("coords", 0.0, 0.0, 0.0);
+  parser->SetFunction(c.Function);
+
+  vtkIdType numPts = input->GetNumberOfPoints();
+  expected->SetNumberOfComponents(3);
+  expected->SetNumberOfTuples(numPts);
+  double x[3], r[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    input->GetPoint(i, x);
+    parser->SetScalarVariableValue(0, s->GetComponent(i, 0));
+    parser->SetScalarVariableValue(1, t->GetComponent(i, 1));
+    parser->SetScalarVariableValue(2, k->GetComponent(i, 0));
+    parser->SetScalarVariableValue(3, x[2]);
+    parser->SetVectorVariableValue(0, t->GetComponent(i, 0), t->GetComponent(i, 1),
+      t->GetComponent(i, 2));
+    parser->SetVectorVariableValue(1, t->GetComponent(i, 2), t->GetComponent(i, 1),
+      t->GetComponent(i, 0));
+    parser->SetVectorVariableValue(2, x[0], x[1], x[2]);
+    if (parser->IsVectorResult())
+    {
+      parser->GetVectorResult(r);
+    }
+    else
+    {
+      r[0] = r[1] = r[2] = parser->GetScalarResult();
+    }
+    expected->SetTuple(i, r);
+  }
+}
+
+// Random scalars "s", vectors "t" and integers "k" on numPts random points.
+inline void MakeCalculatorInput(vtkIdType numPts, vtkPolyData* input)
+{
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkDoubleArray> s;
+  s->SetName("s");
+  s->SetNumberOfTuples(numPts);
+  vtkNew<vtkFloatArray> t;
+  t->SetName("t");
+  t->SetNumberOfComponents(3);
+  t->SetNumberOfTuples(numPts);
+  vtkNew<vtkIntArray> k;
+  k->SetName("k");
+  k->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->SetPoint(i, vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0),
+      vtkMath::Random(-1.0, 1.0));
+    s->SetValue(i, vtkMath::Random(-10.0, 10.0));
+    t->SetTuple3(i, vtkMath::Random(-1.0, 1.0), vtkMath::Random(0.0, 2.0), i % 13 == 0 ? 0.0 : 1.0);
+    k->SetValue(i, static_cast<int>(i % 5) - 2);
+  }
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(s);
+  input->GetPointData()->AddArray(t);
+  input->GetPointData()->AddArray(k);
+}
+
+// Set the variables of the functions, as ReferenceResults() does.
+inline void AddCalculatorVariables(vtkArrayCalculator* calc)
+{
+  calc->AddScalarVariable("s", "s");
+  calc->AddScalarVariable("t1", "t", 1);
+  calc->AddScalarVariable("k", "k");
+  calc->AddCoordinateScalarVariable("coordsZ", 2);
+  calc->AddVectorVariable("t", "t");
+  calc->AddVectorVariable("tswap", "t", 2, 1, 0);
+  calc->AddCoordinateVectorVariable("coords");
+}
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellDataToPointDataAveraging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the averages computed by vtkCellDataToPointData and
+// vtkPointDataToCellData, which are threaded, against averages computed
+// point by point (or cell by cell) through the vtkDataSet API, on
+// structured data and on unstructured grids with cells of several
+// dimensions.
+
+#include "TestAveragingGrid.h"
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkIdList.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkStructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Compare the averaged vectors of the ids in the list with the output tuple.
+// Integers are rounded on structured data, and truncated otherwise.
+int CheckAverage(vtkDataSetAttributes* in, vtkDataSetAttributes* out, vtkIdList* ids,
+  vtkIdType outId, bool round, const char* label)
+{
+  vtkIdType num = ids->GetNumberOfIds();
+  double v[3] = { 0.0, 0.0, 0.0 };
+  double sum = 0.0;
+  for (vtkIdType i = 0; i < num; ++i)
+  {
+    double* t = in->GetArray("v")->GetTuple3(ids->GetId(i));
+    v[0] += t[0] / num;
+    v[1] += t[1] / num;
+    v[2] += t[2] / num;
+    sum += in->GetArray("i")->GetTuple1(ids->GetId(i));
+  }
+  double* t = out->GetArray("v")->GetTuple3(outId);
+  int expected = (num == 0 ? 0 : static_cast<int>(round ? std::floor(sum / num + 0.5) : sum / num));
+  if (std::abs(t[0] - v[0]) > 1.0e-12 || std::abs(t[1] - v[1]) > 1.0e-12 ||
+    std::abs(t[2] - v[2]) > 1.0e-12 || out->GetArray("i")->GetTuple1(outId) != expected)
+  {
+    cerr << label << ": wrong average for " << outId << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int TestCellToPoint(vtkDataSet* input, int option, bool round, const char* label)
+{
+  vtkNew<vtkCellDataToPointData> c2p;
+  c2p->SetInputData(input);
+  c2p->SetContributingCellOption(option);
+  c2p->Update();
+
+  int highestDimension = 0;
+  for (vtkIdType i = 0; i < input->GetNumberOfCells(); ++i)
+  {
+    highestDimension = std::max(highestDimension, input->GetCell(i)->GetCellDimension());
+  }
+  vtkNew<vtkIdList> cellIds, contributing;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    input->GetPointCells(ptId, cellIds);
+    int minDimension = 0;
+    if (option == vtkCellDataToPointData::DataSetMax)
+    {
+      minDimension = highestDimension;
+    }
+    for (vtkIdType i = 0; option == vtkCellDataToPointData::Patch && i < cellIds->GetNumberOfIds();
+         ++i)
+    {
+      minDimension = std::max(minDimension, input->GetCell(cellIds->GetId(i))->GetCellDimension());
+    }
+    contributing->Reset();
+    for (vtkIdType i = 0; i < cellIds->GetNumberOfIds(); ++i)
+    {
+      if (input->GetCell(cellIds->GetId(i))->GetCellDimension() >= minDimension)
+      {
+        contributing->InsertNextId(cellIds->GetId(i));
+      }
+    }
+    if (CheckAverage(input->GetCellData(), c2p->GetOutput()->GetPointData(), contributing, ptId,
+          round, label))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int TestPointToCell(vtkDataSet* input, const char* label)
+{
+  vtkNew<vtkPointDataToCellData> p2c;
+  p2c->SetInputData(input);
+  p2c->Update();
+
+  vtkNew<vtkIdList> ptIds;
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    input->GetCellPoints(cellId, ptIds);
+    if (CheckAverage(input->GetPointData(), p2c->GetOutput()->GetCellData(), ptIds, cellId, true,
+          label))
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestCellDataToPointDataAveraging(int, char*[])
+{
+  int errors = 0;
+  const int n = 40;
+
+  // Structured data, including a degenerate image
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(n, n + 1, n + 2);
+  vtkNew<vtkImageData> plane;
+  plane->SetDimensions(n, 1, n);
+  vtkNew<vtkStructuredGrid> sgrid;
+  sgrid->SetDimensions(n, n, 5);
+  vtkNew<vtkPoints> sgridPoints;
+  for (int k = 0; k < 5; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        sgridPoints->InsertNextPoint(i + 0.1 * j, j, k * k);
+      }
+    }
+  }
+  sgrid->SetPoints(sgridPoints);
+
+  vtkDataSet* structured[3] = { image, plane, sgrid };
+  const char* labels[3] = { "image", "plane", "structured grid" };
+  for (int i = 0; i < 3; ++i)
+  {
+    AddArrays(structured[i]->GetPointData(), structured[i]->GetNumberOfPoints());
+    AddArrays(structured[i]->GetCellData(), structured[i]->GetNumberOfCells());
+    errors += TestCellToPoint(structured[i], vtkCellDataToPointData::All, true, labels[i]);
+    errors += TestPointToCell(structured[i], labels[i]);
+  }
+
+  // Hexahedra and tetrahedra, with quads and lines on the boundary and an
+  // unused point
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  MakeMixedGrid(n, ugrid);
+  AddArrays(ugrid->GetPointData(), ugrid->GetNumberOfPoints());
+  AddArrays(ugrid->GetCellData(), ugrid->GetNumberOfCells());
+  errors += TestCellToPoint(ugrid, vtkCellDataToPointData::All, false, "unstructured, all");
+  errors += TestCellToPoint(ugrid, vtkCellDataToPointData::Patch, false, "unstructured, patch");
+  errors += TestCellToPoint(
+    ugrid, vtkCellDataToPointData::DataSetMax, false, "unstructured, data set max");
+  errors += TestPointToCell(ugrid, "unstructured, points to cells");
+
+  return errors;
+}
@@ -0,0 +1,223 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DInstances.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the glyphs generated in parallel by vtkGlyph3D against glyphs
+// transformed point by point with vtkTransform, check that the instance
+// table reproduces the same glyphs, and check that sources mixing cell
+// types keep the cells of each glyph consecutive.
+
+#include "TestGlyphInput.h"
+
+#include "vtkCellData.h"
+#include "vtkGlyph3D.h"
+#include "vtkGlyphSource2D.h"
+#include "vtkIdList.h"
+#include "vtkQuaternion.h"
+#include "vtkSphereSource.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+
+namespace
+{
+
+bool Near(const double a[3], const double b[3], double tol)
+{
+  return std::abs(a[0] - b[0]) <= tol && std::abs(a[1] - b[1]) <= tol &&
+    std::abs(a[2] - b[2]) <= tol;
+}
+
+// Compare the glyph of every input point with the source transformed by
+// vtkTransform, as vtkGlyph3D used to do.
+int CheckGlyphs(vtkPolyData* input, vtkPolyData* source, vtkPolyData* output)
+{
+  vtkIdType numSourcePts = source->GetNumberOfPoints();
+  vtkIdType numSourceCells = source->GetNumberOfCells();
+  if (output->GetNumberOfPoints() != input->GetNumberOfPoints() * numSourcePts ||
+    output->GetNumberOfCells() != input->GetNumberOfPoints() * numSourceCells)
+  {
+    cerr << "Wrong number of glyph points or cells" << endl;
+    return 1;
+  }
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("InputPointIds");
+  vtkDataArray* cellInts = output->GetCellData()->GetArray("i");
+  if (!normals || !pointIds || !cellInts)
+  {
+    cerr << "Missing glyph arrays" << endl;
+    return 1;
+  }
+
+  vtkNew<vtkTransform> trans;
+  vtkNew<vtkIdList> sourceIds, outIds;
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3], v[3];
+    input->GetPoint(ptId, x);
+    input->GetPointData()->GetVectors()->GetTuple(ptId, v);
+    double vMag = vtkMath::Norm(v);
+    double s = input->GetPointData()->GetScalars()->GetTuple1(ptId) * 0.5;
+    trans->Identity();
+    trans->Translate(x);
+    if (v[1] == 0.0 && v[2] == 0.0)
+    {
+      if (v[0] < 0)
+      {
+        trans->RotateWXYZ(180.0, 0, 1, 0);
+      }
+    }
+    else
+    {
+      trans->RotateWXYZ(180.0, (v[0] + vMag) / 2.0, v[1] / 2.0, v[2] / 2.0);
+    }
+    trans->Scale(s, s, s);
+
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+    {
+      vtkIdType outId = ptId * numSourcePts + i;
+      double p[3], n[3], expected[3];
+      trans->TransformPoint(source->GetPoint(i), expected);
+      output->GetPoint(outId, p);
+      if (!Near(p, expected, 1.0e-5))
+      {
+        cerr << "Wrong glyph point " << outId << endl;
+        return 1;
+      }
+      trans->TransformNormal(source->GetPointData()->GetNormals()->GetTuple3(i), expected);
+      normals->GetTuple(outId, n);
+      if (!Near(n, expected, 1.0e-5) || pointIds->GetTuple1(outId) != ptId)
+      {
+        cerr << "Wrong glyph normal or point id " << outId << endl;
+        return 1;
+      }
+    }
+    for (vtkIdType c = 0; c < numSourceCells; ++c)
+    {
+      vtkIdType outCellId = ptId * numSourceCells + c;
+      source->GetCellPoints(c, sourceIds);
+      output->GetCellPoints(outCellId, outIds);
+      if (outIds->GetNumberOfIds() != sourceIds->GetNumberOfIds() ||
+        outIds->GetId(0) != sourceIds->GetId(0) + ptId * numSourcePts ||
+        cellInts->GetTuple1(outCellId) != ptId % 11)
+      {
+        cerr << "Wrong glyph cell " << outCellId << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Apply the orientation and scale of the instances to the source, and
+// compare with the glyphs.
+int CheckInstances(vtkPolyData* input, vtkPolyData* source, vtkPolyData* instances,
+  vtkPolyData* glyphs)
+{
+  vtkDataArray* orientations = instances->GetPointData()->GetArray("Orientation");
+  vtkDataArray* scales = instances->GetPointData()->GetArray("Scale");
+  if (instances->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    instances->GetNumberOfCells() != 0 || !orientations ||
+    orientations->GetNumberOfComponents() != 4 || !scales ||
+    scales->GetNumberOfComponents() != 3 || !instances->GetPointData()->GetArray("i"))
+  {
+    cerr << "Wrong instance table" << endl;
+    return 1;
+  }
+
+  vtkIdType numSourcePts = source->GetNumberOfPoints();
+  for (vtkIdType ptId = 0; ptId < instances->GetNumberOfPoints(); ++ptId)
+  {
+    double q[4], r[3][3], scale[3], x[3];
+    orientations->GetTuple(ptId, q);
+    scales->GetTuple(ptId, scale);
+    instances->GetPoint(ptId, x);
+    vtkQuaterniond quaternion(q);
+    quaternion.ToMatrix3x3(r);
+    for (vtkIdType i = 0; i < numSourcePts; ++i)
+    {
+      double sp[3], p[3], expected[3];
+      source->GetPoint(i, sp);
+      for (int j = 0; j < 3; ++j)
+      {
+        p[j] = x[j] + r[j][0] * scale[0] * sp[0] + r[j][1] * scale[1] * sp[1] +
+          r[j][2] * scale[2] * sp[2];
+      }
+      glyphs->GetPoint(ptId * numSourcePts + i, expected);
+      if (!Near(p, expected, 1.0e-5))
+      {
+        cerr << "Instance " << ptId << " does not match its glyph" << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestGlyph3DInstances(int, char*[])
+{
+  int errors = 0;
+  const vtkIdType numPts = 20000;
+
+  vtkNew<vtkPolyData> input;
+  MakeGlyphInput(numPts, input);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceConnection(sphere->GetOutputPort());
+  glyph->SetScaleFactor(0.5);
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+  glyph->Update();
+  errors += CheckGlyphs(input, sphere->GetOutput(), glyph->GetOutput());
+
+  vtkNew<vtkPolyData> glyphs;
+  glyphs->ShallowCopy(glyph->GetOutput());
+  glyph->GenerateInstancesOn();
+  glyph->Update();
+  errors += CheckInstances(input, sphere->GetOutput(), glyph->GetOutput(), glyphs);
+
+  // A source with lines and polygons
+  vtkNew<vtkGlyphSource2D> square;
+  square->SetGlyphTypeToSquare();
+  square->FilledOn();
+  square->CrossOn();
+  square->Update();
+  vtkPolyData* source = square->GetOutput();
+  glyph->GenerateInstancesOff();
+  glyph->SetSourceConnection(square->GetOutputPort());
+  glyph->Update();
+  vtkPolyData* output = glyph->GetOutput();
+  vtkNew<vtkIdList> sourceIds, outIds;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    vtkIdType ptId = cellId / source->GetNumberOfCells();
+    vtkIdType c = cellId % source->GetNumberOfCells();
+    source->GetCellPoints(c, sourceIds);
+    output->GetCellPoints(cellId, outIds);
+    if (output->GetCellType(cellId) != source->GetCellType(c) ||
+      outIds->GetId(0) != sourceIds->GetId(0) + ptId * source->GetNumberOfPoints())
+    {
+      cerr << "Wrong cell " << cellId << " with a mixed source" << endl;
+      ++errors;
+      break;
+    }
+  }
+
+  return errors;
+}
@@ -0,0 +1,66 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyphInput.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Input shared by TestGlyph3DInstances and TimeGlyph3D: random points with
+// scalars "s", vectors "v", some of them along the x axis, and integers "i".
+
+#ifndef TestGlyphInput_h
+#define TestGlyphInput_h
+
+#include "vtkDoubleArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+namespace
+{
+
+inline void MakeGlyphInput(vtkIdType numPts, vtkPolyData* input)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("s");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("v");
+  vectors->SetNumberOfComponents(3);
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("i");
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->InsertNextPoint(
+      vtkMath::Random(-10.0, 10.0), vtkMath::Random(-10.0, 10.0), vtkMath::Random(-10.0, 10.0));
+    scalars->InsertNextValue(vtkMath::Random(0.5, 2.0));
+    if (i % 10 == 0)
+    {
+      vectors->InsertNextTuple3(i % 20 == 0 ? -1.0 : 1.0, 0.0, 0.0);
+    }
+    else
+    {
+      vectors->InsertNextTuple3(
+        vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0));
+    }
+    ints->InsertNextValue(static_cast<int>(i % 11));
+  }
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+  input->GetPointData()->AddArray(ints);
+}
+
+}
+
+#endif
@@ -0,0 +1,126 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHeightField.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by the tests of the decimation and the smoothing filters:
+// heights sampled on a grid over the unit square, such as a smooth height
+// field, and their triangulation. Not every test uses all of them, hence
+// the inline functions.
+
+#ifndef TestHeightField_h
+#define TestHeightField_h
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+inline double Height(double x, double y)
+{
+  return 0.1 * sin(2.0 * vtkMath::Pi() * x) * cos(2.0 * vtkMath::Pi() * y);
+}
+
+// Sample height(x, y) on a res x res grid over the unit square, row by row.
+template <typename HeightFunction>
+void InsertGridPoints(vtkPoints* points, int res, HeightFunction height)
+{
+  for (int j = 0; j < res; j++)
+  {
+    for (int i = 0; i < res; i++)
+    {
+      double x = static_cast<double>(i) / (res - 1);
+      double y = static_cast<double>(j) / (res - 1);
+      points->InsertNextPoint(x, y, height(x, y));
+    }
+  }
+}
+
+// Sample the height field on a res x res grid over the unit square.
+inline void InsertHeightFieldPoints(vtkPoints* points, int res)
+{
+  InsertGridPoints(points, res, Height);
+}
+
+// Triangulate the rows in [row0, row1) of a res x res grid, either as
+// triangles or as one triangle strip per row.
+inline void TriangulateHeightField(vtkCellArray* cells, int res, bool strips, int row0, int row1)
+{
+  std::vector<vtkIdType> strip(2 * res);
+  for (int j = row0; j < row1; j++)
+  {
+    if (strips)
+    {
+      for (int i = 0; i < res; i++)
+      {
+        strip[2 * i] = (j + 1) * res + i;
+        strip[2 * i + 1] = j * res + i;
+      }
+      cells->InsertNextCell(2 * res, strip.data());
+      continue;
+    }
+    for (int i = 0; i < res - 1; i++)
+    {
+      vtkIdType p0 = j * res + i;
+      vtkIdType tri0[3] = { p0, p0 + 1, p0 + res + 1 };
+      vtkIdType tri1[3] = { p0, p0 + res + 1, p0 + res };
+      cells->InsertNextCell(3, tri0);
+      cells->InsertNextCell(3, tri1);
+    }
+  }
+}
+
+// Triangulate the height field sampled on a res x res grid, with a scalar
+// varying along x.
+inline void MakeHeightField(int res, vtkPolyData* output)
+{
+  vtkNew<vtkPoints> points;
+  InsertHeightFieldPoints(points, res);
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); i++)
+  {
+    scalars->InsertNextValue(points->GetPoint(i)[0]);
+  }
+  vtkNew<vtkCellArray> polys;
+  TriangulateHeightField(polys, res, false, 0, res - 1);
+  output->SetPoints(points);
+  output->SetPolys(polys);
+  output->GetPointData()->SetScalars(scalars);
+}
+
+// Root mean square distance of the points to the height field
+inline double HeightError(vtkPolyData* pd)
+{
+  double error = 0.0;
+  double x[3];
+  for (vtkIdType i = 0; i < pd->GetNumberOfPoints(); i++)
+  {
+    pd->GetPoint(i, x);
+    double d = x[2] - Height(x[0], x[1]);
+    error += d * d;
+  }
+  return pd->GetNumberOfPoints() ? sqrt(error / pd->GetNumberOfPoints()) : 0.0;
+}
+
+}
+
+#endif
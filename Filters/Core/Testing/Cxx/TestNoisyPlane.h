@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestNoisyPlane.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by the tests of the smoothing filters: a triangulated
+// plane with a random height, built with TestHeightField.h, and checks of
+// the smoothed result.
+
+#ifndef TestNoisyPlane_h
+#define TestNoisyPlane_h
+
+#include "TestHeightField.h"
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Random heights of amplitude Noise, drawn in the order of the points
+struct RandomHeight
+{
+  vtkMinimalStandardRandomSequence *Sequence;
+  double Noise;
+
+  double operator()(double, double)
+  {
+    this->Sequence->Next();
+    return this->Noise * (this->Sequence->GetValue() - 0.5);
+  }
+};
+
+// Triangulate a res x res grid over the unit square, with a random height
+// of amplitude noise.
+void InitializeNoisyPlane(vtkPolyData *polyData, int res, double noise)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> randomSequence;
+  randomSequence->SetSeed(1);
+  RandomHeight height = { randomSequence.GetPointer(), noise };
+
+  vtkNew<vtkPoints> points;
+  InsertGridPoints(points, res, height);
+  vtkNew<vtkCellArray> polys;
+  TriangulateHeightField(polys, res, false, 0, res - 1);
+  polyData->SetPoints(points);
+  polyData->SetPolys(polys);
+}
+
+// Root mean square height of the points
+double RMSHeight(vtkPolyData *polyData)
+{
+  double height = 0.0;
+  for (vtkIdType i = 0; i < polyData->GetNumberOfPoints(); ++i)
+  {
+    double point[3];
+    polyData->GetPoint(i, point);
+    height += point[2] * point[2];
+  }
+  return sqrt(height / polyData->GetNumberOfPoints());
+}
+
+// Check that the noise of a res x res plane is smoothed and that its
+// boundary points did not move by more than the square root of tolerance2.
+bool CheckSmoothedPlane(vtkPolyData *input, vtkPolyData *output, int res,
+                        double tolerance2 = 0.0)
+{
+  double inputHeight = RMSHeight(input);
+  double outputHeight = RMSHeight(output);
+  if (outputHeight > 0.5 * inputHeight)
+  {
+    cerr << "The noise is not smoothed, height " << inputHeight << " -> "
+         << outputHeight << endl;
+    return false;
+  }
+
+  for (int i = 0; i < res; ++i)
+  {
+    vtkIdType boundary[4] = { i, (res - 1) * res + i, i * res, i * res + res - 1 };
+    for (int k = 0; k < 4; ++k)
+    {
+      double x0[3], x1[3];
+      input->GetPoint(boundary[k], x0);
+      output->GetPoint(boundary[k], x1);
+      if (vtkMath::Distance2BetweenPoints(x0, x1) > tolerance2)
+      {
+        cerr << "Boundary point " << boundary[k] << " moved" << endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Compare the heights of a few points with stored values, which guard the
+// result of the filters against unintended changes.
+bool CheckHeights(vtkPolyData *output, const vtkIdType *ids,
+                  const double *heights, int numIds)
+{
+  for (int i = 0; i < numIds; ++i)
+  {
+    double x[3];
+    output->GetPoint(ids[i], x);
+    if (fabs(x[2] - heights[i]) > 1.0e-9)
+    {
+      cerr.precision(17);
+      cerr << "Point " << ids[i] << " has height " << x[2] << ", expected "
+           << heights[i] << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+#endif
@@ -14,12 +14,22 @@
 =========================================================================*/
 
 #include "vtkProbeFilter.h"
+#include "vtkAppendFilter.h"
 #include "vtkLineSource.h"
 #include "vtkArrayCalculator.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkDataSet.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkDataArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
 
 // Gets the number of points the probe filter counted as valid.
 // The parameter should be the output of the probe filter
@@ -85,9 +95,104 @@ int TestProbeFilterThreshold()
   return (validIgnore == 2) ? 0 : 1;
 }
 
-// Currently only tests the ComputeThreshold and Threshold.  Other tests
-// should be added
+// Probes an unstructured grid, which goes through the cell locator and the
+// parallel code path, and compares with probing the equivalent image, which
+// uses the serial FindCell() of the image.
+int TestProbeFilterUnstructuredSource()
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(21, 17, 13);
+  image->SetOrigin(-1.0, -0.5, 0.0);
+  image->SetSpacing(0.1, 0.0625, 0.125);
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    image->GetPoint(i, x);
+    pointScalars->InsertNextValue(std::sin(x[0]) + x[1] * x[2]);
+  }
+  image->GetPointData()->AddArray(pointScalars);
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  for (vtkIdType i = 0; i < image->GetNumberOfCells(); ++i)
+  {
+    cellScalars->InsertNextValue(static_cast<double>(i));
+  }
+  image->GetCellData()->AddArray(cellScalars);
+
+  vtkNew<vtkAppendFilter> toUnstructured;
+  toUnstructured->AddInputData(image);
+
+  // Random probe points, some of them outside of the source. The image
+  // accepts points slightly outside of its bounds, so stay away from them.
+  vtkMath::RandomSeed(1234);
+  double bounds[6];
+  image->GetBounds(bounds);
+  vtkNew<vtkPoints> pts;
+  while (pts->GetNumberOfPoints() < 5000)
+  {
+    double x[3] = { vtkMath::Random(-1.2, 1.2), vtkMath::Random(-0.6, 0.6),
+      vtkMath::Random(-0.1, 1.6) };
+    bool nearBoundary = false;
+    for (int j = 0; j < 6; ++j)
+    {
+      nearBoundary |= std::abs(x[j / 2] - bounds[j]) < 0.01;
+    }
+    if (!nearBoundary)
+    {
+      pts->InsertNextPoint(x);
+    }
+  }
+  vtkNew<vtkPolyData> probePoints;
+  probePoints->SetPoints(pts);
+
+  vtkNew<vtkProbeFilter> imageProbe;
+  imageProbe->SetInputData(probePoints);
+  imageProbe->SetSourceData(image);
+  imageProbe->Update();
+
+  vtkNew<vtkProbeFilter> gridProbe;
+  gridProbe->SetInputData(probePoints);
+  gridProbe->SetSourceConnection(toUnstructured->GetOutputPort());
+  gridProbe->Update();
+
+  vtkPointData* expected = imageProbe->GetOutput()->GetPointData();
+  vtkPointData* result = gridProbe->GetOutput()->GetPointData();
+  const char* names[3] = { "vtkValidPointMask", "PointScalars", "CellScalars" };
+  int numValid = 0;
+  for (int a = 0; a < 3; ++a)
+  {
+    vtkDataArray* expectedArray = expected->GetArray(names[a]);
+    vtkDataArray* resultArray = result->GetArray(names[a]);
+    if (!expectedArray || !resultArray ||
+      resultArray->GetNumberOfTuples() != pts->GetNumberOfPoints())
+    {
+      cerr << "Missing probed array " << names[a] << endl;
+      return 1;
+    }
+    for (vtkIdType i = 0; i < pts->GetNumberOfPoints(); ++i)
+    {
+      numValid += (a == 0 && resultArray->GetTuple1(i) == 1);
+      // The unstructured grid has float points
+      if (std::abs(resultArray->GetTuple1(i) - expectedArray->GetTuple1(i)) > 1e-6)
+      {
+        cerr << "Mismatch of " << names[a] << " at point " << i << endl;
+        return 1;
+      }
+    }
+  }
+  if (numValid == 0 || numValid == pts->GetNumberOfPoints())
+  {
+    cerr << "Unexpected number of valid points: " << numValid << endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Tests the ComputeThreshold and Threshold parameters, and probing an
+// unstructured source. Other tests should be added
 int TestProbeFilter(int, char*[])
 {
-  return TestProbeFilterThreshold();
+  return TestProbeFilterThreshold() || TestProbeFilterUnstructuredSource();
 }
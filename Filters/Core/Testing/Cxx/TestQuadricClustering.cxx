@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricClustering.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Cluster a height field of triangles and of triangle strips with the
+// serial and the parallel accumulation, and with the parallel accumulation
+// appending the height field in pieces, and check that the outputs match.
+// Also check that no triangle is lost with a very fine binning.
+
+#include "TestHeightField.h"
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+
+const int Resolution = 300;
+const int NumberOfPieces = 7;
+
+// Triangulate the rows in [row0, row1) of the height field, either as
+// triangles or as one triangle strip per row.
+void MakeHeightField(vtkPoints* points, bool strips, int row0, int row1,
+  vtkPolyData* output)
+{
+  vtkNew<vtkCellArray> cells;
+  TriangulateHeightField(cells, Resolution, strips, row0, row1);
+  output->SetPoints(points);
+  if (strips)
+  {
+    output->SetStrips(cells);
+  }
+  else
+  {
+    output->SetPolys(cells);
+  }
+}
+
+void InitializeClustering(vtkQuadricClustering* clustering, bool parallel)
+{
+  clustering->SetDivisionOrigin(0.0, 0.0, -0.1);
+  clustering->SetDivisionSpacing(1.0 / 64, 1.0 / 64, 1.0 / 32);
+  clustering->SetParallelAccumulation(parallel);
+}
+
+// Compare the topology and the points of two clusterings
+int CompareOutputs(vtkPolyData* output0, vtkPolyData* output1, const char* name)
+{
+  if (output0->GetNumberOfPoints() != output1->GetNumberOfPoints() ||
+    output0->GetNumberOfCells() != output1->GetNumberOfCells())
+  {
+    cerr << name << ": " << output1->GetNumberOfPoints() << " points and "
+         << output1->GetNumberOfCells() << " cells instead of " << output0->GetNumberOfPoints()
+         << " and " << output0->GetNumberOfCells() << endl;
+    return 1;
+  }
+
+  vtkCellArray* cells0 =
+    output0->GetNumberOfPolys() ? output0->GetPolys() : output0->GetStrips();
+  vtkCellArray* cells1 =
+    output1->GetNumberOfPolys() ? output1->GetPolys() : output1->GetStrips();
+  vtkIdType npts0, *pts0, npts1, *pts1;
+  cells0->InitTraversal();
+  cells1->InitTraversal();
+  while (cells0->GetNextCell(npts0, pts0) && cells1->GetNextCell(npts1, pts1))
+  {
+    for (vtkIdType i = 0; i < npts0; i++)
+    {
+      if (npts0 != npts1 || pts0[i] != pts1[i])
+      {
+        cerr << name << ": the cells differ" << endl;
+        return 1;
+      }
+    }
+  }
+
+  double x0[3], x1[3];
+  for (vtkIdType i = 0; i < output0->GetNumberOfPoints(); i++)
+  {
+    output0->GetPoint(i, x0);
+    output1->GetPoint(i, x1);
+    if (vtkMath::Distance2BetweenPoints(x0, x1) > 1.0e-12)
+    {
+      cerr << name << ": point " << i << " is (" << x1[0] << ", " << x1[1] << ", "
+           << x1[2] << ") instead of (" << x0[0] << ", " << x0[1] << ", " << x0[2] << ")"
+           << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int CompareClusterings(vtkPoints* points, bool strips)
+{
+  const char* type = strips ? " of strips" : "";
+  vtkNew<vtkPolyData> input;
+  MakeHeightField(points, strips, 0, Resolution - 1, input);
+
+  vtkSmartPointer<vtkPolyData> outputs[2];
+  for (int parallel = 0; parallel < 2; parallel++)
+  {
+    vtkNew<vtkQuadricClustering> clustering;
+    InitializeClustering(clustering, parallel != 0);
+    clustering->SetInputData(input);
+    clustering->Update();
+    outputs[parallel] = clustering->GetOutput();
+  }
+  if (outputs[0]->GetNumberOfPolys() == 0)
+  {
+    cerr << "Empty clustering" << type << endl;
+    return 1;
+  }
+  int status = CompareOutputs(outputs[0], outputs[1], "Parallel clustering");
+
+  // Stream the height field through the append methods.
+  vtkNew<vtkQuadricClustering> clustering;
+  InitializeClustering(clustering, true);
+  vtkPolyData* output = clustering->GetOutput();
+  double bounds[6];
+  input->GetBounds(bounds);
+  clustering->StartAppend(bounds);
+  for (int piece = 0; piece < NumberOfPieces; piece++)
+  {
+    vtkNew<vtkPolyData> pieceData;
+    MakeHeightField(points, strips, piece * (Resolution - 1) / NumberOfPieces,
+      (piece + 1) * (Resolution - 1) / NumberOfPieces, pieceData);
+    clustering->Append(pieceData);
+  }
+  clustering->EndAppend();
+  status += CompareOutputs(outputs[0], output, "Streamed clustering");
+  return status;
+}
+
+// With 2048^3 bins, far more than 2^21, every vertex of a few rows of the
+// height field falls in its own bin, so no triangle may be dropped as a
+// duplicate.
+int CheckFineBinning(vtkPoints* points)
+{
+  vtkNew<vtkPolyData> input;
+  MakeHeightField(points, false, 0, 20, input);
+
+  vtkNew<vtkQuadricClustering> clustering;
+  clustering->SetNumberOfDivisions(2048, 2048, 2048);
+  clustering->AutoAdjustNumberOfDivisionsOff();
+  clustering->SetParallelAccumulation(true);
+  clustering->SetInputData(input);
+  clustering->Update();
+
+  vtkPolyData* output = clustering->GetOutput();
+  if (output->GetNumberOfPolys() != input->GetNumberOfPolys())
+  {
+    cerr << "Fine clustering: " << output->GetNumberOfPolys() << " triangles instead of "
+         << input->GetNumberOfPolys() << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestQuadricClustering(int, char*[])
+{
+  vtkNew<vtkPoints> points;
+  InsertHeightFieldPoints(points, Resolution);
+
+  int status = CompareClusterings(points, false);
+  status += CompareClusterings(points, true);
+  status += CheckFineBinning(points);
+  return status ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Decimate a height field with the serial and the parallel decimation, with
+// and without the attribute error metric, and compare their reduction and
+// their distance to the height field.
+
+#include "TestHeightField.h"
+
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+namespace
+{
+
+int CompareDecimations(vtkPolyData* input, bool attributeErrorMetric)
+{
+  vtkSmartPointer<vtkPolyData> outputs[2];
+  double reductions[2], errors[2];
+  for (int parallel = 0; parallel < 2; parallel++)
+  {
+    vtkNew<vtkQuadricDecimation> decimate;
+    decimate->SetInputData(input);
+    decimate->SetTargetReduction(0.9);
+    decimate->SetAttributeErrorMetric(attributeErrorMetric);
+    decimate->SetParallelDecimation(parallel != 0);
+
+    decimate->Update();
+
+    outputs[parallel] = decimate->GetOutput();
+    reductions[parallel] = decimate->GetActualReduction();
+    errors[parallel] = HeightError(outputs[parallel]);
+  }
+
+  int status = 0;
+  if (reductions[0] < 0.85)
+  {
+    cerr << "Serial reduction " << reductions[0] << " is too small" << endl;
+    status = 1;
+  }
+  if (reductions[1] < 0.95 * reductions[0] || reductions[1] < 0.85)
+  {
+    cerr << "Parallel reduction " << reductions[1] << " is too small, the serial one is "
+         << reductions[0] << endl;
+    status = 1;
+  }
+  vtkIdType numTris = input->GetNumberOfPolys();
+  for (int parallel = 0; parallel < 2; parallel++)
+  {
+    if (outputs[parallel]->GetNumberOfPolys() !=
+      static_cast<vtkIdType>(floor((1.0 - reductions[parallel]) * numTris + 0.5)))
+    {
+      cerr << "Wrong number of triangles " << outputs[parallel]->GetNumberOfPolys() << endl;
+      status = 1;
+    }
+    if (attributeErrorMetric &&
+      (!outputs[parallel]->GetPointData()->GetScalars() ||
+        outputs[parallel]->GetPointData()->GetScalars()->GetNumberOfTuples() !=
+          outputs[parallel]->GetNumberOfPoints()))
+    {
+      cerr << "Missing decimated scalars" << endl;
+      status = 1;
+    }
+  }
+  if (errors[0] > 0.005)
+  {
+    cerr << "Serial error " << errors[0] << " is too large" << endl;
+    status = 1;
+  }
+  if (errors[1] > 2.0 * errors[0] + 1.0e-4)
+  {
+    cerr << "Parallel error " << errors[1] << " is too large, the serial one is " << errors[0]
+         << endl;
+    status = 1;
+  }
+  return status;
+}
+}
+
+int TestQuadricDecimation(int, char*[])
+{
+  vtkNew<vtkPolyData> input;
+  MakeHeightField(200, input);
+
+  int status = CompareDecimations(input, false);
+  status += CompareDecimations(input, true);
+  return status ? EXIT_FAILURE : EXIT_SUCCESS;
+}
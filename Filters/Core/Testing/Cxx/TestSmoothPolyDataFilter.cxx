@@ -18,6 +18,8 @@
 #include <vtkSmartPointer.h>
 #include <vtkSmoothPolyDataFilter.h>
 
+#include "TestNoisyPlane.h"
+
 namespace
 {
 void InitializePolyData(vtkPolyData *polyData, int dataType)
@@ -83,6 +85,57 @@ int SmoothPolyData(int dataType, int outputPointsPrecision)
 
   return points->GetDataType();
 }
+
+// Smooth a noisy plane, with its boundary fixed, freely and constrained to
+// the plane z = 0.
+int SmoothNoisyPlane(bool simultaneous)
+{
+  const int res = 200;
+  vtkSmartPointer<vtkPolyData> inputPolyData
+    = vtkSmartPointer<vtkPolyData>::New();
+  InitializeNoisyPlane(inputPolyData, res, 0.01);
+
+  vtkSmartPointer<vtkSmoothPolyDataFilter> smoothPolyDataFilter
+    = vtkSmartPointer<vtkSmoothPolyDataFilter>::New();
+  smoothPolyDataFilter->SetInputData(inputPolyData);
+  smoothPolyDataFilter->SetNumberOfIterations(50);
+  smoothPolyDataFilter->SetRelaxationFactor(0.1);
+  smoothPolyDataFilter->BoundarySmoothingOff();
+  smoothPolyDataFilter->SetSimultaneousSmoothing(simultaneous);
+  smoothPolyDataFilter->Update();
+
+  vtkPolyData *outputPolyData = smoothPolyDataFilter->GetOutput();
+  if (!CheckSmoothedPlane(inputPolyData, outputPolyData, res))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // the (default) serial iterations give the same result as always
+  const vtkIdType ids[4] = { 201, 12345, 20100, 39798 };
+  const double heights[4] = { 0.001019018585793674, 0.00025755836395546794,
+    -0.00058705068659037352, 0.00032963947160169482 };
+  if (!simultaneous && !CheckHeights(outputPolyData, ids, heights, 4))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // constrain the points to a flat plane
+  vtkSmartPointer<vtkPolyData> sourcePolyData
+    = vtkSmartPointer<vtkPolyData>::New();
+  InitializeNoisyPlane(sourcePolyData, 20, 0.0);
+  smoothPolyDataFilter->SetSourceData(sourcePolyData);
+  smoothPolyDataFilter->SetNumberOfIterations(5);
+  smoothPolyDataFilter->Update();
+  double outputHeight = RMSHeight(smoothPolyDataFilter->GetOutput());
+  if (outputHeight > 1.0e-6)
+  {
+    cerr << "The constrained points are not on the source, height "
+         << outputHeight << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
 }
 
 int TestSmoothPolyDataFilter(int vtkNotUsed(argc), char *vtkNotUsed(argv)[])
@@ -129,5 +182,9 @@ int TestSmoothPolyDataFilter(int vtkNotUsed(argc), char *vtkNotUsed(argv)[])
     return EXIT_FAILURE;
   }
 
-  return EXIT_SUCCESS;
+  if (SmoothNoisyPlane(false) != EXIT_SUCCESS)
+  {
+    return EXIT_FAILURE;
+  }
+  return SmoothNoisyPlane(true);
 }
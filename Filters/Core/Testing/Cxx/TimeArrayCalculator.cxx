@@ -0,0 +1,67 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeArrayCalculator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkArrayCalculator, which evaluates its function over blocks of
+// tuples in parallel, against vtkFunctionParser evaluated tuple by tuple,
+// for each function of TestArrayCalculatorBlocks. This timing driver is not
+// run by ctest; run it with
+//   vtkFiltersCoreCxxTests TimeArrayCalculator [points]
+// The default is 10^6 points.
+
+#include "TestCalculatorCases.h"
+
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+int TimeArrayCalculator(int argc, char* argv[])
+{
+  vtkIdType numPts = (argc > 1 ? atoi(argv[1]) : 1000000);
+  vtkNew<vtkPolyData> input;
+  MakeCalculatorInput(numPts, input);
+
+  cout << "Timing " << numPts << " points, "
+       << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkArrayCalculator> calc;
+  calc->SetInputData(input);
+  calc->SetAttributeTypeToPointData();
+  AddCalculatorVariables(calc);
+  calc->SetReplacementValue(-1.0);
+  calc->SetResultArrayName("result");
+  vtkNew<vtkTest::ErrorObserver> observer;
+  calc->AddObserver(vtkCommand::ErrorEvent, observer);
+
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkDoubleArray> expected;
+  for (const CalculatorCase& c : CalculatorCases)
+  {
+    calc->SetFunction(c.Function);
+    calc->SetReplaceInvalidValues(c.Replace);
+    calc->SetResultArrayType(c.ResultType);
+    timer->StartTimer();
+    calc->Update();
+    timer->StopTimer();
+    double calcTime = timer->GetElapsedTime();
+
+    timer->StartTimer();
+    ReferenceResults(input, c, expected);
+    timer->StopTimer();
+    cout << c.Function << ": vtkArrayCalculator " << calcTime << " s, tuple by tuple "
+         << timer->GetElapsedTime() << " s\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeCellDataToPointData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkCellDataToPointData, for each contributing cell option, and
+// vtkPointDataToCellData on an image and on an unstructured grid with cells
+// of several dimensions. This timing driver is not run by ctest; run it with
+//   vtkFiltersCoreCxxTests TimeCellDataToPointData [size]
+// The default size of 100 gives 10^6 cells.
+
+#include "TestAveragingGrid.h"
+
+#include "vtkCellData.h"
+#include "vtkCellDataToPointData.h"
+#include "vtkImageData.h"
+#include "vtkPointData.h"
+#include "vtkPointDataToCellData.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+void TimeCellToPoint(vtkDataSet* input, int option, const char* label)
+{
+  vtkNew<vtkCellDataToPointData> c2p;
+  c2p->SetInputData(input);
+  c2p->SetContributingCellOption(option);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  c2p->Update();
+  timer->StopTimer();
+  cout << label << ": " << timer->GetElapsedTime() << " s\n";
+}
+
+void TimePointToCell(vtkDataSet* input, const char* label)
+{
+  vtkNew<vtkPointDataToCellData> p2c;
+  p2c->SetInputData(input);
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  p2c->Update();
+  timer->StopTimer();
+  cout << label << ": " << timer->GetElapsedTime() << " s\n";
+}
+
+}
+
+int TimeCellDataToPointData(int argc, char* argv[])
+{
+  int n = (argc > 1 ? atoi(argv[1]) : 100);
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(n + 1, n + 1, n + 1);
+  AddArrays(image->GetPointData(), image->GetNumberOfPoints());
+  AddArrays(image->GetCellData(), image->GetNumberOfCells());
+  vtkNew<vtkUnstructuredGrid> ugrid;
+  MakeMixedGrid(n, ugrid);
+  AddArrays(ugrid->GetPointData(), ugrid->GetNumberOfPoints());
+  AddArrays(ugrid->GetCellData(), ugrid->GetNumberOfCells());
+
+  cout << "Timing " << image->GetNumberOfCells() << " voxels and " << ugrid->GetNumberOfCells()
+       << " unstructured cells, " << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  TimeCellToPoint(image, vtkCellDataToPointData::All, "image, cells to points");
+  TimePointToCell(image, "image, points to cells");
+  TimeCellToPoint(ugrid, vtkCellDataToPointData::All, "unstructured, all");
+  TimeCellToPoint(ugrid, vtkCellDataToPointData::Patch, "unstructured, patch");
+  TimeCellToPoint(ugrid, vtkCellDataToPointData::DataSetMax, "unstructured, data set max");
+  TimePointToCell(ugrid, "unstructured, points to cells");
+
+  return EXIT_SUCCESS;
+}
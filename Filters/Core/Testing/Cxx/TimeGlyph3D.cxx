@@ -0,0 +1,61 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeGlyph3D.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkGlyph3D generating sphere glyphs in parallel, and generating the
+// instance table that replaces them. This timing driver is not run by
+// ctest; run it with
+//   vtkFiltersCoreCxxTests TimeGlyph3D [points]
+// The default is 200000 points, i.e. 10^7 glyph points.
+
+#include "TestGlyphInput.h"
+
+#include "vtkGlyph3D.h"
+#include "vtkSMPTools.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+int TimeGlyph3D(int argc, char* argv[])
+{
+  vtkIdType numPts = (argc > 1 ? atoi(argv[1]) : 200000);
+  vtkNew<vtkPolyData> input;
+  MakeGlyphInput(numPts, input);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->Update();
+
+  cout << "Timing " << numPts << " glyphs of " << sphere->GetOutput()->GetNumberOfPoints()
+       << " points, " << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkGlyph3D> glyph;
+  glyph->SetInputData(input);
+  glyph->SetSourceConnection(sphere->GetOutputPort());
+  glyph->SetScaleFactor(0.5);
+  glyph->GeneratePointIdsOn();
+  glyph->FillCellDataOn();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  glyph->Update();
+  timer->StopTimer();
+  cout << "Glyphs: " << timer->GetElapsedTime() << " s\n";
+
+  glyph->GenerateInstancesOn();
+  timer->StartTimer();
+  glyph->Update();
+  timer->StopTimer();
+  cout << "Instances: " << timer->GetElapsedTime() << " s\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeQuadricClustering.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the serial and the parallel accumulation of vtkQuadricClustering on
+// a height field of triangles and of triangle strips, and the parallel
+// accumulation appending the height field in pieces. This timing driver is
+// not run by ctest; run it with
+//   vtkFiltersCoreCxxTests TimeQuadricClustering [resolution]
+// The default resolution of 1000 gives a height field of 1996002 triangles.
+
+#include "TestHeightField.h"
+
+#include "vtkQuadricClustering.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+const int NumberOfPieces = 7;
+
+// Triangulate the rows in [row0, row1) of the height field
+void Triangulate(vtkPoints* points, int res, bool strips, int row0, int row1,
+  vtkPolyData* output)
+{
+  vtkNew<vtkCellArray> cells;
+  TriangulateHeightField(cells, res, strips, row0, row1);
+  output->SetPoints(points);
+  if (strips)
+  {
+    output->SetStrips(cells);
+  }
+  else
+  {
+    output->SetPolys(cells);
+  }
+}
+
+void InitializeClustering(vtkQuadricClustering* clustering, bool parallel)
+{
+  clustering->SetDivisionOrigin(0.0, 0.0, -0.1);
+  clustering->SetDivisionSpacing(1.0 / 64, 1.0 / 64, 1.0 / 32);
+  clustering->SetParallelAccumulation(parallel);
+}
+
+void Report(const char* label, const char* type, double time, vtkPolyData* output)
+{
+  cout << label << " clustering" << type << ": " << time << " s, "
+       << output->GetNumberOfPoints() << " points, " << output->GetNumberOfCells()
+       << " cells\n";
+}
+
+}
+
+int TimeQuadricClustering(int argc, char* argv[])
+{
+  int resolution = (argc > 1 ? atoi(argv[1]) : 1000);
+  vtkNew<vtkPoints> points;
+  InsertHeightFieldPoints(points, resolution);
+
+  cout << "Timing a " << resolution << " x " << resolution << " height field, "
+       << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkTimerLog> timer;
+  for (int strips = 0; strips < 2; strips++)
+  {
+    const char* type = strips ? " of strips" : "";
+    vtkNew<vtkPolyData> input;
+    Triangulate(points, resolution, strips != 0, 0, resolution - 1, input);
+
+    for (int parallel = 0; parallel < 2; parallel++)
+    {
+      vtkNew<vtkQuadricClustering> clustering;
+      InitializeClustering(clustering, parallel != 0);
+      clustering->SetInputData(input);
+      timer->StartTimer();
+      clustering->Update();
+      timer->StopTimer();
+      Report(parallel ? "Parallel" : "Serial", type, timer->GetElapsedTime(),
+        clustering->GetOutput());
+    }
+
+    // The pieces are triangulated outside of the timing
+    vtkSmartPointer<vtkPolyData> pieces[NumberOfPieces];
+    for (int piece = 0; piece < NumberOfPieces; piece++)
+    {
+      pieces[piece] = vtkSmartPointer<vtkPolyData>::New();
+      Triangulate(points, resolution, strips != 0, piece * (resolution - 1) / NumberOfPieces,
+        (piece + 1) * (resolution - 1) / NumberOfPieces, pieces[piece]);
+    }
+    vtkNew<vtkQuadricClustering> clustering;
+    InitializeClustering(clustering, true);
+    // EndAppend() fills the output, which must exist beforehand
+    vtkPolyData* output = clustering->GetOutput();
+    double bounds[6];
+    input->GetBounds(bounds);
+    timer->StartTimer();
+    clustering->StartAppend(bounds);
+    for (int piece = 0; piece < NumberOfPieces; piece++)
+    {
+      clustering->Append(pieces[piece]);
+    }
+    clustering->EndAppend();
+    timer->StopTimer();
+    Report("Streamed", type, timer->GetElapsedTime(), output);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeQuadricDecimation.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the serial and the parallel decimation of a height field, with and
+// without the attribute error metric, and print the reduction and the
+// distance to the height field of each. This timing driver is not run by
+// ctest; run it with
+//   vtkFiltersCoreCxxTests TimeQuadricDecimation [resolution] [reduction]
+// The defaults (500, 0.9) give a height field of 498002 triangles.
+
+#include "TestHeightField.h"
+
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+int TimeQuadricDecimation(int argc, char* argv[])
+{
+  int resolution = (argc > 1 ? atoi(argv[1]) : 500);
+  double reduction = (argc > 2 ? atof(argv[2]) : 0.9);
+
+  // The attribute error metric warns about each singular quadric system of
+  // the fine height fields, which would flood the timings.
+  vtkObject::GlobalWarningDisplayOff();
+
+  vtkNew<vtkPolyData> input;
+  MakeHeightField(resolution, input);
+
+  cout << "Timing " << input->GetNumberOfPolys() << " triangles, target reduction "
+       << reduction << ", " << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkTimerLog> timer;
+  for (int attributes = 0; attributes < 2; attributes++)
+  {
+    for (int parallel = 0; parallel < 2; parallel++)
+    {
+      vtkNew<vtkQuadricDecimation> decimate;
+      decimate->SetInputData(input);
+      decimate->SetTargetReduction(reduction);
+      decimate->SetAttributeErrorMetric(attributes != 0);
+      decimate->SetParallelDecimation(parallel != 0);
+
+      timer->StartTimer();
+      decimate->Update();
+      timer->StopTimer();
+
+      vtkPolyData* output = decimate->GetOutput();
+      cout << (parallel ? "Parallel" : "Serial") << " decimation"
+           << (attributes ? " with attributes" : "") << ": " << timer->GetElapsedTime()
+           << " s, reduction " << decimate->GetActualReduction() << ", "
+           << output->GetNumberOfPolys() << " triangles, error " << HeightError(output) << "\n";
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -26,11 +26,191 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTable.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkArrayCalculator);
 
+//----------------------------------------------------------------------------
+// The function is evaluated over blocks of tuples with
+// vtkFunctionParser::EvaluateBlock(), and the blocks are processed in
+// parallel.
+namespace {
+
+const vtkIdType CalculatorBlockSize = 512;
+
+// Where the values of one component of a variable come from: a component of
+// an array, or a point coordinate of the input.
+struct CalculatorInput
+{
+  vtkDataArray *Array;
+  int Component;
+  void *Pointer; //typed data of arrays with the standard memory layout
+  int Variable; //index of the variable in the parser (times 3, plus the
+                //component, for vector variables)
+};
+
+template <typename T>
+void GatherComponent(const T *data, int numComps, int comp, vtkIdType begin,
+                     vtkIdType n, double *out)
+{
+  data += begin*numComps + comp;
+  for (vtkIdType i=0; i < n; ++i)
+  {
+    out[i] = static_cast<double>(data[i*numComps]);
+  }
+}
+
+template <typename T>
+void ScatterResult(T *data, vtkIdType begin, vtkIdType numValues, const double *res)
+{
+  data += begin;
+  for (vtkIdType i=0; i < numValues; ++i)
+  {
+    data[i] = static_cast<T>(res[i]);
+  }
+}
+
+struct EvaluateCalculator
+{
+  vtkFunctionParser *Parser;
+  std::vector<CalculatorInput> ScalarInputs;
+  std::vector<CalculatorInput> VectorInputs;
+  int NumberOfScalarVariables;
+  int NumberOfVectorVariables;
+  vtkDataSet *DataSet; //for coordinates, if Array is nullptr
+  vtkGraph *Graph;
+  vtkDataArray *Result;
+  void *ResultPointer;
+  int ResultComponents;
+  vtkSMPThreadLocal<std::vector<double>> Buffer;
+  vtkSMPThreadLocal<unsigned char> Failed;
+  bool AnyFailed;
+
+  void Initialize()
+  {
+    this->Buffer.Local().resize(CalculatorBlockSize *
+      (this->ScalarInputs.size() + this->VectorInputs.size() + 3));
+    this->Failed.Local() = 0;
+  }
+
+  void Gather(const CalculatorInput &input, vtkIdType begin, vtkIdType n, double *out)
+  {
+    if ( input.Pointer )
+    {
+      int numComps = input.Array->GetNumberOfComponents();
+      switch (input.Array->GetDataType())
+      {
+        vtkTemplateMacro(GatherComponent(static_cast<VTK_TT*>(input.Pointer), numComps,
+                                         input.Component, begin, n, out));
+      }
+    }
+    else if ( input.Array )
+    {
+      for (vtkIdType i=0; i < n; ++i)
+      {
+        out[i] = input.Array->GetComponent(begin+i, input.Component);
+      }
+    }
+    else
+    {
+      double x[3];
+      for (vtkIdType i=0; i < n; ++i)
+      {
+        if ( this->DataSet )
+        {
+          this->DataSet->GetPoint(begin+i, x);
+        }
+        else
+        {
+          this->Graph->GetPoint(begin+i, x);
+        }
+        out[i] = x[input.Component];
+      }
+    }
+  }
+
+  void operator() (vtkIdType begin, vtkIdType end)
+  {
+    std::vector<double> &buffer = this->Buffer.Local();
+    std::vector<const double*> scalars(this->NumberOfScalarVariables, nullptr);
+    std::vector<const double*> vectors(3*this->NumberOfVectorVariables, nullptr);
+    double *res = buffer.data() + CalculatorBlockSize *
+      (this->ScalarInputs.size() + this->VectorInputs.size());
+
+    for ( ; begin < end; begin += CalculatorBlockSize )
+    {
+      vtkIdType n = std::min(CalculatorBlockSize, end - begin);
+      double *values = buffer.data();
+      for (size_t k=0; k < this->ScalarInputs.size(); ++k, values += CalculatorBlockSize)
+      {
+        this->Gather(this->ScalarInputs[k], begin, n, values);
+        scalars[this->ScalarInputs[k].Variable] = values;
+      }
+      for (size_t k=0; k < this->VectorInputs.size(); ++k, values += CalculatorBlockSize)
+      {
+        this->Gather(this->VectorInputs[k], begin, n, values);
+        vectors[this->VectorInputs[k].Variable] = values;
+      }
+
+      if ( ! this->Parser->EvaluateBlock(n, scalars.data(), vectors.data(), res) )
+      {
+        this->Failed.Local() = 1;
+      }
+
+      vtkIdType numValues = n * this->ResultComponents;
+      if ( this->ResultPointer )
+      {
+        switch (this->Result->GetDataType())
+        {
+          vtkTemplateMacro(ScatterResult(static_cast<VTK_TT*>(this->ResultPointer),
+                                         begin*this->ResultComponents, numValues, res));
+        }
+      }
+      else
+      {
+        for (vtkIdType i=0; i < n; ++i)
+        {
+          this->Result->SetTuple(begin+i, res + i*this->ResultComponents);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->AnyFailed = false;
+    for (vtkSMPThreadLocal<unsigned char>::iterator it = this->Failed.begin();
+         it != this->Failed.end(); ++it)
+    {
+      this->AnyFailed |= (*it != 0);
+    }
+  }
+};
+
+// Return a typed pointer to the data of arrays with the standard memory
+// layout and a type handled by vtkTemplateMacro, and nullptr otherwise.
+void *GetTypedPointer(vtkDataArray *array)
+{
+  if ( array == nullptr || ! array->HasStandardMemoryLayout() )
+  {
+    return nullptr;
+  }
+  switch (array->GetDataType())
+  {
+    vtkTemplateMacro(return static_cast<VTK_TT*>(array->GetVoidPointer(0)));
+  }
+  return nullptr;
+}
+
+} //anonymous namespace
+
+
 vtkArrayCalculator::vtkArrayCalculator()
 {
   this->FunctionParser = vtkFunctionParser::New();
@@ -219,7 +399,6 @@ int vtkArrayCalculator::RequestData(
   vtkDataSetAttributes* outFD = nullptr;
   vtkDataArray* currentArray;
   vtkIdType numTuples = 0;
-  double scalarResult[1];
   vtkDataArray* resultArray = nullptr;
   vtkPoints* resultPoints = nullptr;
 
@@ -228,6 +407,7 @@ int vtkArrayCalculator::RequestData(
 
   vtkDataSet *dsInput = vtkDataSet::SafeDownCast(input);
   vtkGraph *graphInput = vtkGraph::SafeDownCast(input);
+  vtkPointSet* psInput = vtkPointSet::SafeDownCast(input);
   vtkPointSet* psOutput = vtkPointSet::SafeDownCast(output);
   int attribute = this->AttributeType;
   if (attribute == DEFAULT_ATTRIBUTE_TYPE)
@@ -413,109 +593,94 @@ int vtkArrayCalculator::RequestData(
   {
     resultArray->SetNumberOfComponents(1);
     resultArray->SetNumberOfTuples(numTuples);
-    scalarResult[0] = this->FunctionParser->GetScalarResult();
-    resultArray->SetTuple(0, scalarResult);
   }
   else
   {
     resultArray->Allocate(numTuples * 3);
     resultArray->SetNumberOfComponents(3);
     resultArray->SetNumberOfTuples(numTuples);
-    resultArray->SetTuple(0, this->FunctionParser->GetVectorResult());
   }
 
-  // Save array pointers to avoid looking them up for each tuple.
-  std::vector<vtkDataArray*> scalarArrays(this->NumberOfScalarArrays);
-  std::vector<vtkDataArray*> vectorArrays(this->NumberOfVectorArrays);
-  std::vector<int> scalarArrayIndicies(this->NumberOfScalarArrays);
-  std::vector<int> vectorArrayIndicies(this->NumberOfVectorArrays);
-
-  for (int cc=0; cc < this->NumberOfScalarArrays; cc++)
-  {
-    int idx = this->FunctionParser->GetScalarVariableIndex(
-      this->ScalarVariableNames[cc]);
-    if (idx >= 0)
+  // Bind the arrays (and point coordinates) to the variables needed by the
+  // function. Later bindings of a variable take precedence, as when the
+  // variables are set one after the other.
+  EvaluateCalculator evaluator;
+  evaluator.Parser = this->FunctionParser;
+  evaluator.NumberOfScalarVariables = this->FunctionParser->GetNumberOfScalarVariables();
+  evaluator.NumberOfVectorVariables = this->FunctionParser->GetNumberOfVectorVariables();
+  evaluator.DataSet = dsInput;
+  evaluator.Graph = graphInput;
+  evaluator.Result = resultArray;
+  evaluator.ResultPointer = GetTypedPointer(resultArray);
+  evaluator.ResultComponents = (resultType == SCALAR_RESULT ? 1 : 3);
+  evaluator.AnyFailed = false;
+
+  for (j = 0; j < this->NumberOfScalarArrays; j++)
+  {
+    int idx = this->FunctionParser->GetScalarVariableIndex(this->ScalarVariableNames[j]);
+    currentArray = inFD->GetArray(this->ScalarArrayNames[j]);
+    if (idx >= 0 && currentArray && this->FunctionParser->GetScalarVariableNeeded(idx))
     {
-      if (this->FunctionParser->GetScalarVariableNeeded(idx))
-      {
-        scalarArrays[cc] = inFD->GetArray(this->ScalarArrayNames[cc]);
-        scalarArrayIndicies[cc] = idx;
-      }
+      CalculatorInput in = { currentArray, this->SelectedScalarComponents[j],
+                             GetTypedPointer(currentArray), idx };
+      evaluator.ScalarInputs.push_back(in);
     }
   }
-
-  for (int cc=0; cc < this->NumberOfVectorArrays; cc++)
+  for (j = 0; j < this->NumberOfVectorArrays; j++)
   {
-    int idx = this->FunctionParser->GetVectorVariableIndex(
-      this->VectorVariableNames[cc]);
-    if (idx >= 0)
+    int idx = this->FunctionParser->GetVectorVariableIndex(this->VectorVariableNames[j]);
+    currentArray = inFD->GetArray(this->VectorArrayNames[j]);
+    if (idx >= 0 && currentArray && this->FunctionParser->GetVectorVariableNeeded(idx))
     {
-      if (this->FunctionParser->GetVectorVariableNeeded(idx))
+      for (int c = 0; c < 3; c++)
       {
-        vectorArrays[cc] = inFD->GetArray(this->VectorArrayNames[cc]);
-        vectorArrayIndicies[cc] = idx;
+        CalculatorInput in = { currentArray, this->SelectedVectorComponents[j][c],
+                               GetTypedPointer(currentArray), 3*idx+c };
+        evaluator.VectorInputs.push_back(in);
       }
     }
   }
-
-  for (i = 1; i < numTuples; i++)
+  if(attribute == vtkDataObject::POINT || attribute == vtkDataObject::VERTEX)
   {
-    for (j = 0; j < this->NumberOfScalarArrays; j++)
+    vtkPoints *inPts = (psInput ? psInput->GetPoints() : nullptr);
+    vtkDataArray *coords = (inPts ? inPts->GetData() : nullptr);
+    for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
     {
-      if ((currentArray = scalarArrays[j]))
+      int idx = this->FunctionParser->GetScalarVariableIndex(
+        this->CoordinateScalarVariableNames[j]);
+      if (idx >= 0 && this->FunctionParser->GetScalarVariableNeeded(idx))
       {
-        this->FunctionParser->
-          SetScalarVariableValue(scalarArrayIndicies[j],
-            currentArray->GetComponent(i, this->SelectedScalarComponents[j]));
+        CalculatorInput in = { coords, this->SelectedCoordinateScalarComponents[j],
+                               GetTypedPointer(coords), idx };
+        evaluator.ScalarInputs.push_back(in);
       }
     }
-    for (j = 0; j < this->NumberOfVectorArrays; j++)
+    for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
     {
-      if ((currentArray = vectorArrays[j]))
+      int idx = this->FunctionParser->GetVectorVariableIndex(
+        this->CoordinateVectorVariableNames[j]);
+      if (idx >= 0 && this->FunctionParser->GetVectorVariableNeeded(idx))
       {
-        this->FunctionParser->SetVectorVariableValue(vectorArrayIndicies[j],
-            currentArray->GetComponent(i, this->SelectedVectorComponents[j][0]),
-            currentArray->GetComponent(
-              i, this->SelectedVectorComponents[j][1]),
-            currentArray->GetComponent(i, this->SelectedVectorComponents[j][2]));
-      }
-    }
-    if(attribute == vtkDataObject::POINT || attribute == vtkDataObject::VERTEX)
-    {
-      double* pt = nullptr;
-      if (dsInput)
-      {
-        pt = dsInput->GetPoint(i);
-      }
-      else
-      {
-        pt = graphInput->GetPoint(i);
-      }
-      for (j = 0; j < this->NumberOfCoordinateScalarArrays; j++)
-      {
-        this->FunctionParser->
-          SetScalarVariableValue(
-            j+this->NumberOfScalarArrays, pt[this->SelectedCoordinateScalarComponents[j]]);
-      }
-      for (j = 0; j < this->NumberOfCoordinateVectorArrays; j++)
-      {
-        this->FunctionParser->
-          SetVectorVariableValue(
-            j+this->NumberOfVectorArrays,
-            pt[this->SelectedCoordinateVectorComponents[j][0]],
-            pt[this->SelectedCoordinateVectorComponents[j][1]],
-            pt[this->SelectedCoordinateVectorComponents[j][2]]);
+        for (int c = 0; c < 3; c++)
+        {
+          CalculatorInput in = { coords, this->SelectedCoordinateVectorComponents[j][c],
+                                 GetTypedPointer(coords), 3*idx+c };
+          evaluator.VectorInputs.push_back(in);
+        }
       }
     }
-    if (resultType == SCALAR_RESULT)
-    {
-      scalarResult[0] = this->FunctionParser->GetScalarResult();
-      resultArray->SetTuple(i, scalarResult);
-    }
-    else
-    {
-      resultArray->SetTuple(i, this->FunctionParser->GetVectorResult());
-    }
+  }
+
+  // Evaluate all the tuples. Results which cannot be stored through a typed
+  // pointer are set one tuple at a time, in a single thread.
+  vtkSMPTools::For(0, numTuples,
+                   (evaluator.ResultPointer ? CalculatorBlockSize : numTuples),
+                   evaluator);
+  if (evaluator.AnyFailed)
+  {
+    vtkErrorMacro("Some tuples could not be evaluated (e.g., division by zero or "
+                  "logarithm of a non-positive value); their result was set to "
+                  << VTK_PARSER_ERROR_RESULT << ". See ReplaceInvalidValues.");
   }
 
   output->ShallowCopy(input);
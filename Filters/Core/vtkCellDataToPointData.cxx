@@ -14,22 +14,32 @@
   =========================================================================*/
 #include "vtkCellDataToPointData.h"
 
+#include "vtkArrayListTemplate.h" // For matching the averaged arrays
 #include "vtkCellData.h"
-#include "vtkCell.h"
+#include "vtkCellType.h"
+#include "vtkCellTypes.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUniformGrid.h"
-#include "vtkUnsignedIntArray.h"
 
 #include <algorithm>
-#include <functional>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 #define VTK_MAX_CELLS_PER_POINT 4096
 
@@ -38,88 +48,312 @@ vtkStandardNewMacro(vtkCellDataToPointData);
 namespace
 {
 //----------------------------------------------------------------------------
-// Helper template function that implement the major part of the algorighm
-// which will be expanded by the vtkTemplateMacro. The template function is
-// provided so that coverage test can cover this function.
+// Average the tuples of a cell array into a tuple of a point array of the
+// same type. There is one such kernel per array, and the kernels are driven
+// through this typeless base class so that all the arrays are processed at
+// once for each point.
+struct BaseArrayAverager
+{
+  virtual ~BaseArrayAverager() {}
+
+  // Sum the cell tuples in the type of the array and divide by the number of
+  // cells. Integral sums are truncated; this is how unstructured data has
+  // always been averaged. Points without cells get zero.
+  virtual void Average(vtkIdType numCells, const vtkIdType *cellIds,
+                       vtkIdType ptId) = 0;
+
+  // Weight the cell tuples equally, accumulating in double and rounding
+  // integral results, as vtkDataArray::InterpolateTuple() does. Nearest
+  // neighbor attributes copy the tuple of the last cell, as
+  // vtkDataSetAttributes::InterpolatePoint() does with equal weights.
+  virtual void Interpolate(vtkIdType numCells, const vtkIdType *cellIds,
+                           vtkIdType ptId) = 0;
+};
+
+template <typename T>
+struct ArrayAverager : public BaseArrayAverager
+{
+  const T *Input;
+  T *Output;
+  int NumComp;
+  bool NearestNeighbor;
+
+  ArrayAverager(const T *input, T *output, int numComp, bool nearest) :
+    Input(input), Output(output), NumComp(numComp), NearestNeighbor(nearest)
+  {
+  }
+
+  void Average(vtkIdType numCells, const vtkIdType *cellIds,
+               vtkIdType ptId) override
+  {
+    T *out = this->Output + ptId*this->NumComp;
+    std::fill_n(out, this->NumComp, T(0));
+    for (vtkIdType i = 0; i < numCells; ++i)
+    {
+      const T *in = this->Input + cellIds[i]*this->NumComp;
+      for (int comp = 0; comp < this->NumComp; ++comp)
+      {
+        out[comp] = static_cast<T>(out[comp] + in[comp]);
+      }
+    }
+    if (numCells > 0)
+    {
+      T const denom = static_cast<T>(numCells);
+      for (int comp = 0; comp < this->NumComp; ++comp)
+      {
+        out[comp] = static_cast<T>(out[comp] / denom);
+      }
+    }
+  }
+
+  void Interpolate(vtkIdType numCells, const vtkIdType *cellIds,
+                   vtkIdType ptId) override
+  {
+    T *out = this->Output + ptId*this->NumComp;
+    if (numCells < 1)
+    {
+      std::fill_n(out, this->NumComp, T(0));
+    }
+    else if (this->NearestNeighbor)
+    {
+      std::copy_n(this->Input + cellIds[numCells-1]*this->NumComp,
+                  this->NumComp, out);
+    }
+    else
+    {
+      double const weight = 1.0 / numCells;
+      for (int comp = 0; comp < this->NumComp; ++comp)
+      {
+        double val = 0.0;
+        for (vtkIdType i = 0; i < numCells; ++i)
+        {
+          val += weight *
+            static_cast<double>(this->Input[cellIds[i]*this->NumComp+comp]);
+        }
+        vtkMath::RoundDoubleToIntegralIfNecessary(val, out+comp);
+      }
+    }
+  }
+};
+
+// The kernels of all the arrays to process.
+struct ArrayAveragerList
+{
+  std::vector<std::unique_ptr<BaseArrayAverager>> Arrays;
+
+  // Add an array pair; a little factory for vtkTemplateMacro.
   template <typename T>
-  void __spread (vtkDataSet* const src, vtkUnsignedIntArray* const num,
-                 vtkDataArray* const srcarray, vtkDataArray* const dstarray,
-                 vtkIdType ncells, vtkIdType npoints, vtkIdType ncomps,
-                 int highestCellDimension, int contributingCellOption)
+  void AddArrays(const T *input, T *output, int numComp, bool nearest)
   {
-    T const* const srcptr = static_cast<T const*>(srcarray->GetVoidPointer(0));
-    T      * const dstptr = static_cast<T      *>(dstarray->GetVoidPointer(0));
+    this->Arrays.emplace_back(
+      new ArrayAverager<T>(input, output, numComp, nearest));
+  }
 
-    // zero initialization
-    std::fill_n(dstptr, npoints*ncomps, T(0));
+  void Average(vtkIdType numCells, const vtkIdType *cellIds, vtkIdType ptId)
+  {
+    for (auto& array : this->Arrays)
+    {
+      array->Average(numCells, cellIds, ptId);
+    }
+  }
+
+  void Interpolate(vtkIdType numCells, const vtkIdType *cellIds,
+                   vtkIdType ptId)
+  {
+    for (auto& array : this->Arrays)
+    {
+      array->Interpolate(numCells, cellIds, ptId);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Threaded averaging over unstructured data. Each point gathers the cells
+// using it from static cell links. The links list the cells in increasing
+// order, so the sums are accumulated in the same order as a serial scatter
+// over the cells would.
+struct AverageUnstructured
+{
+  vtkDataSet *Input;
+  vtkStaticCellLinks *Links;
+  ArrayAveragerList *Arrays;
+  int ContributingCellOption;
+  int HighestCellDimension;
+  const int *TypeDimensions;
+  vtkSMPThreadLocal<std::vector<vtkIdType>> CellIds;
+
+  AverageUnstructured(vtkDataSet *input, vtkStaticCellLinks *links,
+                      ArrayAveragerList *arrays, int option,
+                      int highestCellDimension, const int *typeDimensions) :
+    Input(input), Links(links), Arrays(arrays), ContributingCellOption(option),
+    HighestCellDimension(highestCellDimension), TypeDimensions(typeDimensions)
+  {
+  }
 
-    // accumulate
-    if (contributingCellOption != vtkCellDataToPointData::Patch)
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    std::vector<vtkIdType>& cellIds = this->CellIds.Local();
+    for (; ptId < endPtId; ++ptId)
     {
-      T const* srcbeg = srcptr;
-      for (vtkIdType cid = 0; cid < ncells; ++cid, srcbeg += ncomps)
+      vtkIdType numCells = this->Links->GetNumberOfCells(ptId);
+      const vtkIdType *cells = this->Links->GetCells(ptId);
+
+      if (this->ContributingCellOption != vtkCellDataToPointData::All)
       {
-        vtkCell* cell = src->GetCell(cid);
-        if (cell->GetCellDimension() >= highestCellDimension)
+        // Only the cells of the highest dimension in the data set, or in
+        // the patch of cells around the point, contribute.
+        int minDimension = this->HighestCellDimension;
+        if (this->ContributingCellOption == vtkCellDataToPointData::Patch)
         {
-          vtkIdList* pids = cell->GetPointIds();
-          for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
+          for (vtkIdType i = 0; i < numCells; ++i)
           {
-            T* const dstbeg = dstptr + pids->GetId(i)*ncomps;
-            // accumulate cell data to point data <==> point_data += cell_data
-            std::transform(srcbeg,srcbeg+ncomps,dstbeg,dstbeg,std::plus<T>());
+            minDimension = std::max(minDimension,
+              this->TypeDimensions[this->Input->GetCellType(cells[i])]);
           }
         }
-      }
-      // average
-      T* dstbeg = dstptr;
-      for (vtkIdType pid = 0; pid < npoints; ++pid, dstbeg += ncomps)
-      {
-        // guard against divide by zero
-        if (unsigned int const denom = num->GetValue(pid))
+        cellIds.clear();
+        for (vtkIdType i = 0; i < numCells; ++i)
         {
-          // divide point data by the number of cells using it <==>
-          // point_data /= denum
-          std::transform(dstbeg, dstbeg+ncomps, dstbeg,
-                         std::bind2nd(std::divides<T>(), denom));
+          if (this->TypeDimensions[this->Input->GetCellType(cells[i])] >=
+              minDimension)
+          {
+            cellIds.push_back(cells[i]);
+          }
         }
+        numCells = static_cast<vtkIdType>(cellIds.size());
+        cells = cellIds.data();
       }
+
+      this->Arrays->Average(numCells, cells, ptId);
     }
-    else
-    { // compute over cell patches
-      vtkNew<vtkIdList> cellsOnPoint;
-      std::vector<T> data(4*ncomps);
-      for (vtkIdType pid = 0; pid < npoints; ++pid)
+  }
+};
+
+//----------------------------------------------------------------------------
+// Threaded averaging over structured data. The (up to eight) cells using a
+// point are found from its i-j-k location, in the order of
+// vtkStructuredData::GetPointCells(), so no links are needed.
+struct InterpolateStructured
+{
+  ArrayAveragerList *Arrays;
+  int Dimensions[3];
+  vtkIdType CellDimensions[3];
+
+  InterpolateStructured(ArrayAveragerList *arrays, const int dims[3]) :
+    Arrays(arrays)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Dimensions[i] = dims[i];
+      this->CellDimensions[i] = (dims[i] > 1 ? dims[i] - 1 : 1);
+    }
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    static const int offset[8][3] = {{-1,0,0}, {-1,-1,0}, {-1,-1,-1},
+                                     {-1,0,-1}, {0,0,0},  {0,-1,0},
+                                     {0,-1,-1},  {0,0,-1}};
+    vtkIdType const d01 = static_cast<vtkIdType>(this->Dimensions[0]) *
+      this->Dimensions[1];
+    vtkIdType cellIds[8];
+    vtkIdType cellLoc[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType const ptLoc[3] = {ptId % this->Dimensions[0],
+                                  (ptId / this->Dimensions[0]) %
+                                    this->Dimensions[1],
+                                  ptId / d01};
+      vtkIdType numCells = 0;
+      for (int j = 0; j < 8; ++j)
       {
-        std::fill(data.begin(), data.end(), 0);
-        T numPointCells[4] = {0, 0, 0, 0};
-        // Get all cells touching this point.
-        src->GetPointCells(pid, cellsOnPoint);
-        vtkIdType numPatchCells = cellsOnPoint->GetNumberOfIds();
-        for (vtkIdType pc = 0; pc  < numPatchCells; pc++)
+        int i;
+        for (i = 0; i < 3; ++i)
         {
-          vtkIdType cellId = cellsOnPoint->GetId(pc);
-          int cellDimension = src->GetCell(cellId)->GetCellDimension();
-          numPointCells[cellDimension] += 1;
-          for (int comp=0;comp<ncomps;comp++)
+          cellLoc[i] = ptLoc[i] + offset[j][i];
+          if (cellLoc[i] < 0 || cellLoc[i] >= this->CellDimensions[i])
           {
-            data[comp+ncomps*cellDimension] += srcptr[comp+cellId*ncomps];
+            break;
           }
         }
-        for (int dimension=3;dimension>=0;dimension--)
+        if (i >= 3)
         {
-          if (numPointCells[dimension])
-          {
-            for (int comp=0;comp<ncomps;comp++)
-            {
-              dstptr[comp+pid*ncomps] = data[comp+dimension*ncomps] / numPointCells[dimension];
-            }
-            break;
-          }
+          cellIds[numCells++] = cellLoc[0] + this->CellDimensions[0] *
+            (cellLoc[1] + this->CellDimensions[1] * cellLoc[2]);
         }
       }
+      this->Arrays->Interpolate(numCells, cellIds, ptId);
     }
   }
+};
+
+//----------------------------------------------------------------------------
+// Get the point dimensions of structured data sets, which are processed
+// with a stencil.
+bool GetStructuredDimensions(vtkDataSet *input, int dims[3])
+{
+  if (vtkImageData *image = vtkImageData::SafeDownCast(input))
+  {
+    image->GetDimensions(dims);
+    return true;
+  }
+  if (vtkRectilinearGrid *rgrid = vtkRectilinearGrid::SafeDownCast(input))
+  {
+    rgrid->GetDimensions(dims);
+    return true;
+  }
+  if (vtkStructuredGrid *sgrid = vtkStructuredGrid::SafeDownCast(input))
+  {
+    sgrid->GetDimensions(dims);
+    return true;
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+// Pair the point arrays created by InterpolateAllocate() (those not in
+// passedArrays) with the cell arrays of the same name, and allocate them.
+// Return false, without adding any kernel, if some array cannot be handled
+// by the kernels: it is not a data array, its name is ambiguous, it is a
+// bit array, or its memory layout is not the standard one.
+bool AddInterpolatedArrays(vtkCellData *inCD, vtkPointData *outPD,
+                           const std::set<vtkAbstractArray*>& passedArrays,
+                           vtkIdType numPts, ArrayAveragerList& arrays)
+{
+  std::vector<std::pair<vtkDataArray*, int>> pairs;
+  for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray *outArray = outPD->GetAbstractArray(i);
+    if (passedArrays.count(outArray))
+    {
+      continue;
+    }
+    vtkDataArray *inArray = ArrayList::GetMatchingArray(inCD, outArray);
+    if (!inArray)
+    {
+      return false;
+    }
+    pairs.emplace_back(inArray, i);
+  }
+
+  for (auto& pair : pairs)
+  {
+    vtkDataArray *inArray = pair.first;
+    vtkDataArray *outArray = outPD->GetArray(pair.second);
+    int const attribute = outPD->IsArrayAnAttribute(pair.second);
+    bool const nearest = (attribute >= 0 &&
+      outPD->GetCopyAttribute(attribute, vtkDataSetAttributes::INTERPOLATE) == 2);
+    outArray->SetNumberOfTuples(numPts);
+    switch (inArray->GetDataType())
+    {
+      vtkTemplateMacro(arrays.AddArrays(
+        static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
+        static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
+        inArray->GetNumberOfComponents(), nearest));
+    }
+  }
+  return true;
+}
 
   // Special traversal algorithm for vtkUniformGrid and vtkRectilinearGrid to support blanking
   // points will not have more than 8 cells for either of these data sets
@@ -281,47 +515,6 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData
     return 1;
   }
 
-  // count the number of cells associated with each point. if we are doing patches
-  // though we will do that later on.
-  vtkSmartPointer<vtkUnsignedIntArray> num;
-  int highestCellDimension = 0;
-  if (this->ContributingCellOption != vtkCellDataToPointData::Patch)
-  {
-    num = vtkSmartPointer<vtkUnsignedIntArray>::New();
-    num->SetNumberOfComponents(1);
-    num->SetNumberOfTuples(npoints);
-    std::fill_n(num->GetPointer(0), npoints, 0u);
-    if (this->ContributingCellOption == vtkCellDataToPointData::DataSetMax)
-    {
-      int maxDimension = src->IsA("vtkPolyData") == 1 ? 2 : 3;
-      for (vtkIdType i=0;i<src->GetNumberOfCells();i++)
-      {
-        int dim = src->GetCell(i)->GetCellDimension();
-        if (dim > highestCellDimension)
-        {
-          highestCellDimension = dim;
-          if (highestCellDimension == maxDimension)
-          {
-            break;
-          }
-        }
-      }
-    }
-    vtkNew<vtkIdList> pids;
-    for (vtkIdType cid = 0; cid < ncells; ++cid)
-    {
-      if (src->GetCell(cid)->GetCellDimension() >= highestCellDimension)
-      {
-        src->GetCellPoints(cid, pids);
-        for (vtkIdType i = 0, I = pids->GetNumberOfIds(); i < I; ++i)
-        {
-          vtkIdType const pid = pids->GetId(i);
-          num->SetValue(pid, num->GetValue(pid)+1);
-        }
-      }
-    }
-  }
-
   // First, copy the input to the output as a starting point
   dst->CopyStructure(src);
   vtkPointData* const opd = dst->GetPointData();
@@ -351,15 +544,10 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData
   cfl.InitializeFieldList(clean);
   opd->InterpolateAllocate(cfl, npoints, npoints);
 
+  // Gather the kernels of all the fields
+  ArrayAveragerList arrays;
   for (int fid = 0, nfields = cfl.GetNumberOfFields(); fid < nfields; ++fid)
   {
-    // update progress and check for an abort request.
-    this->UpdateProgress((fid+1.)/nfields);
-    if (this->GetAbortExecute())
-    {
-      break;
-    }
-
     // indices into the field arrays associated with the cell and the point
     // respectively
     int const dstid = cfl.GetFieldIndex(fid);
@@ -369,24 +557,55 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData
       continue;
     }
 
-    vtkCellData * const srccelldata  = clean;
-    vtkPointData* const dstpointdata = dst->GetPointData();
+    vtkDataArray* const srcarray = clean->GetArray(srcid);
+    vtkDataArray* const dstarray = opd->GetArray(dstid);
+    dstarray->SetNumberOfTuples(npoints);
 
-    if (!srccelldata || !dstpointdata)
+    switch (srcarray->GetDataType())
     {
-      continue;
+      vtkTemplateMacro(arrays.AddArrays(
+        static_cast<const VTK_TT*>(srcarray->GetVoidPointer(0)),
+        static_cast<VTK_TT*>(dstarray->GetVoidPointer(0)),
+        srcarray->GetNumberOfComponents(), false));
     }
+  }
 
-    vtkDataArray* const srcarray = srccelldata ->GetArray(srcid);
-    vtkDataArray* const dstarray = dstpointdata->GetArray(dstid);
-    dstarray->SetNumberOfTuples(npoints);
-
-    vtkIdType const ncomps = srcarray->GetNumberOfComponents();
-    switch (srcarray->GetDataType())
+  if (!arrays.Arrays.empty())
+  {
+    // The dimension of a cell only depends on its type. With DataSetMax,
+    // only the cells of the highest dimension in the data set contribute.
+    int typeDimensions[VTK_NUMBER_OF_CELL_TYPES];
+    int highestCellDimension = 0;
+    if (this->ContributingCellOption != vtkCellDataToPointData::All)
     {
-      vtkTemplateMacro
-        (__spread<VTK_TT>(src,num,srcarray,dstarray,ncells,npoints,ncomps, highestCellDimension, this->ContributingCellOption));
+      std::fill_n(typeDimensions, VTK_NUMBER_OF_CELL_TYPES, 0);
+      vtkNew<vtkCellTypes> cellTypes;
+      src->GetCellTypes(cellTypes);
+      vtkNew<vtkGenericCell> cell;
+      for (vtkIdType i = 0; i < cellTypes->GetNumberOfTypes(); ++i)
+      {
+        int const type = cellTypes->GetCellType(i);
+        cell->SetCellType(type);
+        typeDimensions[type] = cell->GetCellDimension();
+        if (this->ContributingCellOption == vtkCellDataToPointData::DataSetMax)
+        {
+          highestCellDimension =
+            std::max(highestCellDimension, typeDimensions[type]);
+        }
+      }
+      // Make GetCellType() thread safe
+      src->GetCellType(0);
     }
+    this->UpdateProgress(0.25);
+
+    vtkNew<vtkStaticCellLinks> links;
+    links->BuildLinks(src);
+    this->UpdateProgress(0.5);
+
+    AverageUnstructured average(src, links, &arrays,
+      this->ContributingCellOption, highestCellDimension, typeDimensions);
+    vtkSMPTools::For(0, npoints, average);
+    this->UpdateProgress(1.0);
   }
 
   if (!this->PassCellData)
@@ -399,17 +618,36 @@ int vtkCellDataToPointData::RequestDataForUnstructuredData
   return 1;
 }
 
+//----------------------------------------------------------------------------
 void vtkCellDataToPointData::InterpolatePointData(vtkDataSet *input, vtkDataSet *output)
 {
-  vtkNew<vtkIdList> cellIds;
-  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
-
   vtkIdType numPts = input->GetNumberOfPoints();
 
   vtkCellData *inCD = input->GetCellData();
   vtkPointData *outPD = output->GetPointData();
+  std::set<vtkAbstractArray*> passedArrays;
+  for (int i = 0; i < outPD->GetNumberOfArrays(); ++i)
+  {
+    passedArrays.insert(outPD->GetAbstractArray(i));
+  }
   outPD->InterpolateAllocate(inCD,numPts);
 
+  // Structured data is processed in parallel with a stencil, unless some
+  // array requires the generic attribute API.
+  int dims[3];
+  ArrayAveragerList arrays;
+  if (GetStructuredDimensions(input, dims) &&
+      AddInterpolatedArrays(inCD, outPD, passedArrays, numPts, arrays))
+  {
+    InterpolateStructured interpolate(&arrays, dims);
+    vtkSMPTools::For(0, numPts, interpolate);
+    this->UpdateProgress(1.0);
+    return;
+  }
+
+  vtkNew<vtkIdList> cellIds;
+  cellIds->Allocate(VTK_MAX_CELLS_PER_POINT);
+
   double weights[VTK_MAX_CELLS_PER_POINT];
 
   int abort = 0;
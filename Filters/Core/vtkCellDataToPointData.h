@@ -28,6 +28,12 @@
  * cells attached to a point. DataSetMax uses the highest cell dimension in
  * the entire data set.
  *
+ * The averaging is threaded with vtkSMPTools, and all the arrays are
+ * processed at once for each point. For unstructured grids and polydata,
+ * the cells using each point are gathered from vtkStaticCellLinks. Image
+ * data, rectilinear grids and structured grids without blanking find them
+ * from the i-j-k location of the point instead.
+ *
  * @warning
  * This filter is an abstract filter, that is, the output is an abstract type
  * (i.e., vtkDataSet). Use the convenience methods (e.g.,
@@ -156,6 +156,7 @@ int vtkFeatureEdges::RequestData(
     newPolys = inPolys;
     Mesh->SetPolys(newPolys);
   }
+  Mesh->EditableOff(); // the links are only queried
   Mesh->BuildLinks();
 
   // Allocate storage for lines/points (arbitrary allocation sizes)
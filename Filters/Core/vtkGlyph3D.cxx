@@ -14,6 +14,8 @@
 =========================================================================*/
 #include "vtkGlyph3D.h"
 
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCell.h"
 #include "vtkFloatArray.h"
@@ -21,11 +23,13 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,9 +37,426 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
+namespace
+{
+
+// The quantities computed from the input data at a glyphed point.
+struct GlyphParameters
+{
+  double S; // scalar value
+  double V[3]; // vector (or normal)
+  double VMag; // vector magnitude
+  double Scale[3]; // data scale, clamped if requested
+};
+
+// The settings of the filter needed to compute the glyph of an input point.
+// Evaluate() and Transform() are thread safe.
+struct GlyphEvaluator
+{
+  vtkDataArray *Scalars; // may be nullptr
+  vtkDataArray *Vectors; // vectors or normals; nullptr if not used
+  unsigned char *Ghosts; // may be nullptr
+  std::vector<bool> HaveSource; // whether each source of the table exists
+  int ScaleMode;
+  int IndexMode;
+  vtkTypeBool Clamping;
+  vtkTypeBool Scaling;
+  int Orient;
+  double ScaleFactor;
+  double Range[2];
+  double Den;
+
+  // Compute the parameters of the glyph at ptId, and return the index of its
+  // source, or -1 if the point is not glyphed.
+  int Evaluate(vtkIdType ptId, GlyphParameters &p) const
+  {
+    p.S = p.VMag = 0.0;
+    p.V[0] = p.V[1] = p.V[2] = 0.0;
+    p.Scale[0] = p.Scale[1] = p.Scale[2] = 1.0;
+    if ( this->Scalars )
+    {
+      p.S = this->Scalars->GetComponent(ptId, 0);
+      if ( this->ScaleMode == VTK_SCALE_BY_SCALAR ||
+           this->ScaleMode == VTK_DATA_SCALING_OFF )
+      {
+        p.Scale[0] = p.Scale[1] = p.Scale[2] = p.S;
+      }
+    }
+    if ( this->Vectors )
+    {
+      this->Vectors->GetTuple(ptId, p.V);
+      p.VMag = vtkMath::Norm(p.V);
+      if ( this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS )
+      {
+        p.Scale[0] = p.V[0];
+        p.Scale[1] = p.V[1];
+        p.Scale[2] = p.V[2];
+      }
+      else if ( this->ScaleMode == VTK_SCALE_BY_VECTOR )
+      {
+        p.Scale[0] = p.Scale[1] = p.Scale[2] = p.VMag;
+      }
+    }
+    if ( this->Clamping )
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        p.Scale[i] = (p.Scale[i] < this->Range[0] ? this->Range[0] :
+                      (p.Scale[i] > this->Range[1] ? this->Range[1] : p.Scale[i]));
+        p.Scale[i] = (p.Scale[i] - this->Range[0]) / this->Den;
+      }
+    }
+
+    int index = 0;
+    if ( this->IndexMode != VTK_INDEXING_OFF )
+    {
+      double value = (this->IndexMode == VTK_INDEXING_BY_SCALAR ? p.S : p.VMag);
+      int numberOfSources = static_cast<int>(this->HaveSource.size());
+      index = static_cast<int>((value - this->Range[0])*numberOfSources / this->Den);
+      index = (index < 0 ? 0 :
+               (index >= numberOfSources ? (numberOfSources-1) : index));
+    }
+    if ( index < 0 || !this->HaveSource[index] ||
+         (this->Ghosts && this->Ghosts[ptId] & vtkDataSetAttributes::DUPLICATEPOINT) )
+    {
+      return -1;
+    }
+    return index;
+  }
+
+  // Compute the rotation of the glyph as a quaternion q (w,x,y,z), and its
+  // scale. The rotation is either none or a half turn about the bisector of
+  // the x axis and the vector, as done by vtkTransform::RotateWXYZ(180,...).
+  void Transform(const GlyphParameters &p, double q[4], double scale[3]) const
+  {
+    q[0] = 1.0;
+    q[1] = q[2] = q[3] = 0.0;
+    if ( this->Vectors && this->Orient && p.VMag > 0.0 )
+    {
+      if ( p.V[1] == 0.0 && p.V[2] == 0.0 )
+      {
+        if ( p.V[0] < 0 ) // just flip x if we need to
+        {
+          q[0] = 0.0;
+          q[2] = 1.0;
+        }
+      }
+      else
+      {
+        q[0] = 0.0;
+        q[1] = (p.V[0] + p.VMag) / 2.0;
+        q[2] = p.V[1] / 2.0;
+        q[3] = p.V[2] / 2.0;
+        vtkMath::Normalize(q + 1);
+      }
+    }
+
+    scale[0] = scale[1] = scale[2] = 1.0;
+    if ( this->Scaling )
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        scale[i] = (this->ScaleMode == VTK_DATA_SCALING_OFF ? this->ScaleFactor :
+                    p.Scale[i] * this->ScaleFactor);
+        if ( scale[i] == 0.0 )
+        {
+          scale[i] = 1.0e-10;
+        }
+      }
+    }
+  }
+};
+
+// A source of the glyph table, ready to be copied to the glyphed points:
+// its points (transformed by the SourceTransform), normals, texture
+// coordinates and connectivity.
+struct GlyphSource
+{
+  std::vector<double> Points;
+  std::vector<double> Normals;
+  std::vector<double> TCoords;
+  int NumberOfTCoordComponents = 0;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  vtkIdType ConnectivitySize = 0;
+  const vtkIdType *Connectivity = nullptr;
+
+  // Return false if the cells of the source are not all of the given kind
+  // (0 to 3 for vertices, lines, polygons and strips; -1 if not yet known),
+  // which is then updated.
+  bool Prepare(vtkPolyData *source, vtkTransform *transform, bool tcoords, int &kind)
+  {
+    vtkPoints *points = source->GetPoints();
+    if ( !points )
+    {
+      return false;
+    }
+    vtkCellArray *cells[4] = { source->GetVerts(), source->GetLines(),
+                               source->GetPolys(), source->GetStrips() };
+    for (int k = 0; k < 4; ++k)
+    {
+      if ( cells[k]->GetNumberOfCells() > 0 )
+      {
+        if ( kind >= 0 && kind != k )
+        {
+          return false;
+        }
+        kind = k;
+        this->NumberOfCells = cells[k]->GetNumberOfCells();
+        this->ConnectivitySize = cells[k]->GetNumberOfConnectivityEntries();
+        this->Connectivity = cells[k]->GetPointer();
+      }
+    }
+
+    vtkNew<vtkPoints> transformed;
+    if ( transform )
+    {
+      transformed->SetDataTypeToDouble();
+      transform->TransformPoints(points, transformed);
+      points = transformed;
+    }
+    this->NumberOfPoints = points->GetNumberOfPoints();
+    this->Points.resize(3*this->NumberOfPoints);
+    for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+    {
+      points->GetPoint(i, &this->Points[3*i]);
+    }
+
+    vtkDataArray *normals = source->GetPointData()->GetNormals();
+    if ( normals )
+    {
+      this->Normals.resize(3*this->NumberOfPoints);
+      for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+      {
+        normals->GetTuple(i, &this->Normals[3*i]);
+      }
+    }
+
+    vtkDataArray *tc = source->GetPointData()->GetTCoords();
+    if ( tcoords && tc )
+    {
+      int numComps = tc->GetNumberOfComponents();
+      this->NumberOfTCoordComponents = numComps;
+      this->TCoords.resize(numComps*this->NumberOfPoints);
+      for (vtkIdType i = 0; i < this->NumberOfPoints; ++i)
+      {
+        tc->GetTuple(i, &this->TCoords[numComps*i]);
+      }
+    }
+    return true;
+  }
+};
+
+// The first output point, cell and connectivity entry of a glyph.
+struct GlyphOffsets
+{
+  vtkIdType Point;
+  vtkIdType Cell;
+  vtkIdType Connectivity;
+};
+
+// Find the glyphed points and the source of their glyph.
+struct ClassifyPoints
+{
+  const GlyphEvaluator *Evaluator;
+  int *SourceIds;
+
+  ClassifyPoints(const GlyphEvaluator *evaluator, int *sourceIds) :
+    Evaluator(evaluator), SourceIds(sourceIds)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    GlyphParameters p;
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->SourceIds[ptId] = this->Evaluator->Evaluate(ptId, p);
+    }
+  }
+};
+
+// The inputs and the output arrays of the glyphs. Output arrays which are
+// not generated are nullptr.
+struct GlyphOutput
+{
+  vtkDataSet *Input = nullptr;
+  const GlyphEvaluator *Evaluator = nullptr;
+  const std::vector<GlyphSource> *Sources = nullptr;
+  const int *SourceIds = nullptr;
+  const GlyphOffsets *Offsets = nullptr;
+  float *Normals = nullptr;
+  float *TCoords = nullptr;
+  float *Vectors = nullptr;
+  float *Scalars = nullptr; // scale or vector magnitude
+  int ScalarsMode = VTK_COLOR_BY_SCALE;
+  vtkIdType *PointIds = nullptr;
+  vtkIdType *Connectivity = nullptr;
+  float *Orientations = nullptr; // instances only
+  float *Scales = nullptr; // instances only
+  int *SourceIndices = nullptr; // instances only
+  ArrayList *PointArrays = nullptr;
+  ArrayList *CellArrays = nullptr;
+  ArrayList *ColorArrays = nullptr;
+};
+
+// Write the glyphs of a range of input points, or their instances, in
+// place.
+template <typename TP>
+struct GenerateGlyphs : public GlyphOutput
+{
+  TP *Points;
+
+  GenerateGlyphs(const GlyphOutput &output, TP *points) :
+    GlyphOutput(output), Points(points)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    GlyphParameters p;
+    double x[3], q[4], scale[3], r[3][3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      int sourceId = this->SourceIds[ptId];
+      if ( sourceId < 0 )
+      {
+        continue;
+      }
+      this->Evaluator->Evaluate(ptId, p);
+      this->Evaluator->Transform(p, q, scale);
+      this->Input->GetPoint(ptId, x);
+      vtkIdType outId = this->Offsets[ptId].Point;
+      vtkIdType numOutPts = this->Offsets[ptId+1].Point - outId;
+
+      if ( this->Orientations )
+      {
+        // The instance of the glyph: a single point
+        for (int i = 0; i < 3; ++i)
+        {
+          this->Points[3*outId+i] = static_cast<TP>(x[i]);
+          this->Scales[3*outId+i] = static_cast<float>(scale[i]);
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+          this->Orientations[4*outId+i] = static_cast<float>(q[i]);
+        }
+        if ( this->SourceIndices )
+        {
+          this->SourceIndices[outId] = sourceId;
+        }
+      }
+      else
+      {
+        // The glyph geometry: x + R*S*p, with the rotation matrix R of the
+        // quaternion (the identity or a half turn). Normals are transformed
+        // by the inverse transpose R*S^-1.
+        for (int i = 0; i < 3; ++i)
+        {
+          for (int j = 0; j < 3; ++j)
+          {
+            r[i][j] = (q[0] == 1.0 ? (i == j ? 1.0 : 0.0) :
+                       2.0*q[i+1]*q[j+1] - (i == j ? 1.0 : 0.0));
+          }
+        }
+        const GlyphSource &source = (*this->Sources)[sourceId];
+        for (vtkIdType i = 0; i < numOutPts; ++i)
+        {
+          const double *sp = &source.Points[3*i];
+          double s[3] = { scale[0]*sp[0], scale[1]*sp[1], scale[2]*sp[2] };
+          TP *op = this->Points + 3*(outId+i);
+          for (int j = 0; j < 3; ++j)
+          {
+            op[j] = static_cast<TP>(x[j] + r[j][0]*s[0] + r[j][1]*s[1] + r[j][2]*s[2]);
+          }
+          if ( this->Normals )
+          {
+            const double *sn = &source.Normals[3*i];
+            double n[3] = { sn[0]/scale[0], sn[1]/scale[1], sn[2]/scale[2] };
+            double rn[3];
+            for (int j = 0; j < 3; ++j)
+            {
+              rn[j] = r[j][0]*n[0] + r[j][1]*n[1] + r[j][2]*n[2];
+            }
+            vtkMath::Normalize(rn);
+            for (int j = 0; j < 3; ++j)
+            {
+              this->Normals[3*(outId+i)+j] = static_cast<float>(rn[j]);
+            }
+          }
+          if ( this->TCoords )
+          {
+            int numComps = source.NumberOfTCoordComponents;
+            for (int j = 0; j < numComps; ++j)
+            {
+              this->TCoords[numComps*(outId+i)+j] =
+                static_cast<float>(source.TCoords[numComps*i+j]);
+            }
+          }
+        }
+
+        // Copy the topology, offsetting the point ids
+        vtkIdType *conn = this->Connectivity + this->Offsets[ptId].Connectivity;
+        const vtkIdType *sourceConn = source.Connectivity;
+        const vtkIdType *sourceEnd = sourceConn + source.ConnectivitySize;
+        while ( sourceConn < sourceEnd )
+        {
+          vtkIdType npts = *sourceConn++;
+          *conn++ = npts;
+          for (vtkIdType i = 0; i < npts; ++i)
+          {
+            *conn++ = *sourceConn++ + outId;
+          }
+        }
+        if ( this->CellArrays )
+        {
+          vtkIdType cellId = this->Offsets[ptId].Cell;
+          vtkIdType endCellId = this->Offsets[ptId+1].Cell;
+          for ( ; cellId < endCellId; ++cellId)
+          {
+            this->CellArrays->Copy(ptId, cellId);
+          }
+        }
+      }
+
+      // Attributes shared by all the points of the glyph
+      for (vtkIdType i = outId; i < outId + numOutPts; ++i)
+      {
+        if ( this->Vectors )
+        {
+          this->Vectors[3*i] = static_cast<float>(p.V[0]);
+          this->Vectors[3*i+1] = static_cast<float>(p.V[1]);
+          this->Vectors[3*i+2] = static_cast<float>(p.V[2]);
+        }
+        if ( this->Scalars )
+        {
+          this->Scalars[i] = static_cast<float>(
+            this->ScalarsMode == VTK_COLOR_BY_SCALE ? p.Scale[0] : p.VMag);
+        }
+        if ( this->PointIds )
+        {
+          this->PointIds[i] = ptId;
+        }
+        if ( this->PointArrays )
+        {
+          this->PointArrays->Copy(ptId, i);
+        }
+        if ( this->ColorArrays )
+        {
+          this->ColorArrays->Copy(ptId, i);
+        }
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
 //----------------------------------------------------------------------------
 // Construct object with scaling on, scaling mode is by scalar value,
 // scale factor = 1.0, the range is (0,1), orient geometry is on, and
@@ -58,6 +479,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->GenerateInstances = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
@@ -265,6 +687,313 @@ bool vtkGlyph3D::Execute(
     source = defaultSource;
   }
 
+  // The vector (or normal) data used to orient, scale and index the glyphs
+  vtkDataArray *array3D = nullptr;
+  if ( haveVectors )
+  {
+    array3D = (this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors);
+    if ( array3D->GetNumberOfComponents() > 3 )
+    {
+      vtkErrorMacro(<<"vtkDataArray "<<array3D->GetName()<<" has more than 3 components.\n");
+      pts->Delete();
+      trans->Delete();
+      return false;
+    }
+  }
+
+  // Glyphs are generated in parallel: the glyphed points are found, the
+  // output is sized, then every glyph is written in place. Sources mixing
+  // cell types are glyphed by the serial loop further below, which keeps the
+  // cells of each glyph consecutive.
+  GlyphEvaluator evaluator;
+  evaluator.Scalars = inSScalars;
+  evaluator.Vectors = array3D;
+  evaluator.Ghosts = inGhostLevels;
+  evaluator.ScaleMode = this->ScaleMode;
+  evaluator.IndexMode = this->IndexMode;
+  evaluator.Clamping = this->Clamping;
+  evaluator.Scaling = this->Scaling;
+  evaluator.Orient = this->Orient;
+  evaluator.ScaleFactor = this->ScaleFactor;
+  evaluator.Range[0] = this->Range[0];
+  evaluator.Range[1] = this->Range[1];
+  evaluator.Den = den;
+
+  bool indexing = (this->IndexMode != VTK_INDEXING_OFF);
+  std::vector<GlyphSource> glyphSources(indexing ? numberOfSources : 1);
+  evaluator.HaveSource.resize(glyphSources.size(), false);
+  bool parallel = true;
+  bool glyphNormals = true;
+  int cellKind = -1;
+  for (i = 0; parallel && i < static_cast<vtkIdType>(glyphSources.size()); i++)
+  {
+    vtkPolyData *glyphSource = (indexing ? this->GetSource(i, sourceVector) : source.Get());
+    if ( glyphSource )
+    {
+      evaluator.HaveSource[i] = true;
+      glyphNormals = glyphNormals && glyphSource->GetPointData()->GetNormals();
+      parallel = (this->GenerateInstances ||
+        glyphSources[i].Prepare(glyphSource, this->SourceTransform, !indexing, cellKind));
+    }
+  }
+
+  if ( parallel )
+  {
+    std::vector<int> sourceIds(numPts);
+    ClassifyPoints classify(&evaluator, sourceIds.data());
+    vtkSMPTools::For(0, numPts, classify);
+
+    // Size the output. The visibility of the points is checked here, since
+    // IsPointVisible() may be overridden by subclasses.
+    std::vector<GlyphOffsets> offsets(numPts+1);
+    offsets[0].Point = offsets[0].Cell = offsets[0].Connectivity = 0;
+    for (inPtId=0; inPtId < numPts; inPtId++)
+    {
+      offsets[inPtId+1] = offsets[inPtId];
+      int sourceId = sourceIds[inPtId];
+      if ( sourceId >= 0 && ((inputUG && !inputUG->IsPointVisible(inPtId)) ||
+                             !this->IsPointVisible(input, inPtId)) )
+      {
+        sourceIds[inPtId] = sourceId = -1;
+      }
+      if ( sourceId < 0 )
+      {
+        continue;
+      }
+      if ( this->GenerateInstances )
+      {
+        offsets[inPtId+1].Point++;
+      }
+      else
+      {
+        const GlyphSource &glyphSource = glyphSources[sourceId];
+        offsets[inPtId+1].Point += glyphSource.NumberOfPoints;
+        offsets[inPtId+1].Cell += glyphSource.NumberOfCells;
+        offsets[inPtId+1].Connectivity += glyphSource.ConnectivitySize;
+      }
+    }
+    vtkIdType numOutPts = offsets[numPts].Point;
+    vtkIdType numOutCells = offsets[numPts].Cell;
+    this->UpdateProgress(0.5);
+
+    vtkNew<vtkPoints> glyphPts;
+    glyphPts->SetDataType(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION ?
+                          VTK_DOUBLE : VTK_FLOAT);
+    glyphPts->SetNumberOfPoints(numOutPts);
+
+    // Attributes copied from the input point data. Arrays which the
+    // ArrayList cannot handle are copied afterwards, in this thread.
+    ArrayList pointArrays, cellArrays, colorArrays;
+    bool serialPointData = false, serialCellData = false, serialColors = false;
+    if ( !indexing )
+    {
+      outputPD->CopyAllocate(pd, numOutPts);
+      serialPointData = !ArrayList::CanCopyArrays(pd, outputPD);
+      if ( !serialPointData )
+      {
+        pointArrays.AddArrays(numOutPts, pd, outputPD, 0.0, false);
+      }
+      if ( this->FillCellData && !this->GenerateInstances )
+      {
+        outputCD->CopyAllocate(pd, numOutCells);
+        serialCellData = !ArrayList::CanCopyArrays(pd, outputCD);
+        if ( !serialCellData )
+        {
+          cellArrays.AddArrays(numOutCells, pd, outputCD, 0.0, false);
+        }
+      }
+    }
+
+    GlyphOutput glyphs;
+    glyphs.Input = input;
+    glyphs.Evaluator = &evaluator;
+    glyphs.Sources = &glyphSources;
+    glyphs.SourceIds = sourceIds.data();
+    glyphs.Offsets = offsets.data();
+    glyphs.PointArrays = (pointArrays.Arrays.empty() ? nullptr : &pointArrays);
+    glyphs.CellArrays = (cellArrays.Arrays.empty() ? nullptr : &cellArrays);
+    glyphs.ColorArrays = nullptr;
+
+    vtkSmartPointer<vtkIdTypeArray> glyphPointIds;
+    if ( this->GeneratePointIds )
+    {
+      glyphPointIds = vtkSmartPointer<vtkIdTypeArray>::New();
+      glyphPointIds->SetName(this->PointIdsName);
+      glyphPointIds->SetNumberOfTuples(numOutPts);
+      outputPD->AddArray(glyphPointIds);
+      glyphs.PointIds = glyphPointIds->GetPointer(0);
+    }
+    vtkSmartPointer<vtkDataArray> glyphScalars;
+    glyphs.ScalarsMode = this->ColorMode;
+    if ( this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars )
+    {
+      if ( inCScalars->GetDataType() != VTK_BIT && inCScalars->HasStandardMemoryLayout() )
+      {
+        vtkStdString name;
+        glyphScalars = colorArrays.AddArrayPair(numOutPts, inCScalars, name, 0.0, false);
+        glyphs.ColorArrays = &colorArrays;
+      }
+      else
+      {
+        glyphScalars.TakeReference(inCScalars->NewInstance());
+        glyphScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
+        glyphScalars->SetNumberOfTuples(numOutPts);
+        serialColors = true;
+      }
+      glyphScalars->SetName(inCScalars->GetName());
+    }
+    else if ( (this->ColorMode == VTK_COLOR_BY_SCALE && inSScalars) ||
+              (this->ColorMode == VTK_COLOR_BY_VECTOR && haveVectors) )
+    {
+      glyphScalars = vtkSmartPointer<vtkFloatArray>::New();
+      glyphScalars->SetNumberOfTuples(numOutPts);
+      if ( this->ColorMode == VTK_COLOR_BY_VECTOR )
+      {
+        glyphScalars->SetName("VectorMagnitude");
+      }
+      else
+      {
+        glyphScalars->SetName(this->ScaleMode == VTK_SCALE_BY_SCALAR ?
+                              inSScalars->GetName() : "GlyphScale");
+      }
+      glyphs.Scalars = static_cast<vtkFloatArray*>(glyphScalars.Get())->GetPointer(0);
+    }
+    vtkSmartPointer<vtkFloatArray> glyphVectors, glyphNormalsArray, glyphTCoords;
+    if ( haveVectors )
+    {
+      glyphVectors = vtkSmartPointer<vtkFloatArray>::New();
+      glyphVectors->SetNumberOfComponents(3);
+      glyphVectors->SetNumberOfTuples(numOutPts);
+      glyphVectors->SetName("GlyphVector");
+      glyphs.Vectors = glyphVectors->GetPointer(0);
+    }
+
+    vtkSmartPointer<vtkFloatArray> orientations, scales;
+    vtkSmartPointer<vtkIntArray> sourceIndices;
+    vtkNew<vtkCellArray> glyphCells;
+    if ( this->GenerateInstances )
+    {
+      orientations = vtkSmartPointer<vtkFloatArray>::New();
+      orientations->SetNumberOfComponents(4);
+      orientations->SetNumberOfTuples(numOutPts);
+      orientations->SetName("Orientation");
+      glyphs.Orientations = orientations->GetPointer(0);
+      scales = vtkSmartPointer<vtkFloatArray>::New();
+      scales->SetNumberOfComponents(3);
+      scales->SetNumberOfTuples(numOutPts);
+      scales->SetName("Scale");
+      glyphs.Scales = scales->GetPointer(0);
+      if ( indexing )
+      {
+        sourceIndices = vtkSmartPointer<vtkIntArray>::New();
+        sourceIndices->SetNumberOfTuples(numOutPts);
+        sourceIndices->SetName("SourceIndex");
+        glyphs.SourceIndices = sourceIndices->GetPointer(0);
+      }
+    }
+    else
+    {
+      if ( glyphNormals )
+      {
+        glyphNormalsArray = vtkSmartPointer<vtkFloatArray>::New();
+        glyphNormalsArray->SetNumberOfComponents(3);
+        glyphNormalsArray->SetNumberOfTuples(numOutPts);
+        glyphNormalsArray->SetName("Normals");
+        glyphs.Normals = glyphNormalsArray->GetPointer(0);
+      }
+      if ( !indexing && glyphSources[0].NumberOfTCoordComponents > 0 )
+      {
+        glyphTCoords = vtkSmartPointer<vtkFloatArray>::New();
+        glyphTCoords->SetNumberOfComponents(glyphSources[0].NumberOfTCoordComponents);
+        glyphTCoords->SetNumberOfTuples(numOutPts);
+        glyphTCoords->SetName("TCoords");
+        glyphs.TCoords = glyphTCoords->GetPointer(0);
+      }
+      glyphs.Connectivity =
+        glyphCells->WritePointer(numOutCells, offsets[numPts].Connectivity);
+    }
+
+    if ( glyphPts->GetDataType() == VTK_DOUBLE )
+    {
+      GenerateGlyphs<double> generate(glyphs,
+        static_cast<double*>(glyphPts->GetVoidPointer(0)));
+      vtkSMPTools::For(0, numPts, generate);
+    }
+    else
+    {
+      GenerateGlyphs<float> generate(glyphs,
+        static_cast<float*>(glyphPts->GetVoidPointer(0)));
+      vtkSMPTools::For(0, numPts, generate);
+    }
+
+    for (inPtId=0; (serialPointData || serialCellData || serialColors) &&
+           inPtId < numPts; inPtId++)
+    {
+      for (i = offsets[inPtId].Point; i < offsets[inPtId+1].Point; i++)
+      {
+        if ( serialPointData )
+        {
+          outputPD->CopyData(pd, inPtId, i);
+        }
+        if ( serialColors )
+        {
+          outputPD->CopyTuple(inCScalars, glyphScalars, inPtId, i);
+        }
+      }
+      for (i = offsets[inPtId].Cell; serialCellData && i < offsets[inPtId+1].Cell; i++)
+      {
+        outputCD->CopyData(pd, inPtId, i);
+      }
+    }
+
+    output->SetPoints(glyphPts);
+    switch ( this->GenerateInstances ? -1 : cellKind )
+    {
+      case 0:
+        output->SetVerts(glyphCells);
+        break;
+      case 1:
+        output->SetLines(glyphCells);
+        break;
+      case 2:
+        output->SetPolys(glyphCells);
+        break;
+      case 3:
+        output->SetStrips(glyphCells);
+        break;
+    }
+    if ( glyphScalars )
+    {
+      int idx = outputPD->AddArray(glyphScalars);
+      outputPD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+    }
+    if ( glyphVectors )
+    {
+      outputPD->SetVectors(glyphVectors);
+    }
+    if ( glyphNormalsArray )
+    {
+      outputPD->SetNormals(glyphNormalsArray);
+    }
+    if ( glyphTCoords )
+    {
+      outputPD->SetTCoords(glyphTCoords);
+    }
+    if ( this->GenerateInstances )
+    {
+      outputPD->AddArray(orientations);
+      outputPD->AddArray(scales);
+      if ( sourceIndices )
+      {
+        outputPD->AddArray(sourceIndices);
+      }
+    }
+
+    pts->Delete();
+    trans->Delete();
+    return true;
+  }
+
   if ( this->IndexMode != VTK_INDEXING_OFF )
   {
     pd = nullptr;
@@ -444,23 +1173,6 @@ bool vtkGlyph3D::Execute(
 
     if ( haveVectors )
     {
-      vtkDataArray *array3D = this->VectorMode == VTK_USE_NORMAL? inNormals : inVectors;
-      if(array3D->GetNumberOfComponents()>3)
-      {
-        vtkErrorMacro(<<"vtkDataArray "<<array3D->GetName()<<" has more than 3 components.\n");
-        pts->Delete();
-        trans->Delete();
-        if(newPts)
-        {
-          newPts->Delete();
-        }
-        if(newVectors)
-        {
-          newVectors->Delete();
-        }
-        return false;
-      }
-
       v[0] = 0;
       v[1] = 0;
       v[2] = 0;
@@ -891,6 +1603,8 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Generate Instances: "
+     << (this->GenerateInstances ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
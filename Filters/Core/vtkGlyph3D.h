@@ -73,6 +73,21 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * The glyphs are generated in parallel (using vtkSMPTools): the size of the
+ * output is computed first, then the points, normals, cells and attributes
+ * of every glyph are written in place. IsPointVisible() is always invoked
+ * from the calling thread. Sources mixing vertices, lines, polygons and
+ * triangle strips are glyphed serially, so that the cells of each glyph
+ * remain consecutive in the output.
+ *
+ * @warning
+ * When GenerateInstances is on, the glyph geometry is not generated at all:
+ * the output is a table with one point per glyph, holding the orientation
+ * and scale of the glyph as point data. This is the input expected by
+ * vtkGlyph3DMapper, which draws the glyphs without ever creating their
+ * geometry.
+ *
  * @sa
  * vtkTensorGlyph
 */
@@ -287,6 +302,27 @@ public:
   vtkBooleanMacro(FillCellData,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Enable/disable the generation of a compact instance table instead of
+   * the glyph geometry. When on, the output has one point (and no cell) per
+   * glyph, located at the glyphed input point. The rotation of the glyph is
+   * stored as a quaternion (w,x,y,z) in the point data array "Orientation",
+   * its scale along x, y and z (including the ScaleFactor) in the array
+   * "Scale", and, if a table of glyphs is indexed, the index of the source
+   * in the array "SourceIndex". The color scalars, vectors, point ids and
+   * input point data are passed as for the glyph geometry. The
+   * SourceTransform is not applied. The output can be drawn with
+   * vtkGlyph3DMapper, using SetOrientationModeToQuaternion(),
+   * SetScaleModeToScaleByVectorComponents() and, to index the sources with
+   * "SourceIndex", a Range of (0, number of sources). By default this is
+   * off.
+   */
+  vtkSetMacro(GenerateInstances,vtkTypeBool);
+  vtkGetMacro(GenerateInstances,vtkTypeBool);
+  vtkBooleanMacro(GenerateInstances,vtkTypeBool);
+  //@}
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
    * blanked. Default implementation is to always return 1;
@@ -356,6 +392,7 @@ protected:
   int IndexMode; // what to use to index into glyph table
   vtkTypeBool GeneratePointIds; // produce input points ids for each output point
   vtkTypeBool FillCellData; // whether to fill output cell data
+  vtkTypeBool GenerateInstances; // produce an instance table, not geometry
   char *PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
@@ -21,11 +21,21 @@
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkTriangleFilter.h"
 #include "vtkSmartPointer.h"
 
 vtkStandardNewMacro(vtkImplicitPolyDataDistance);
 
+// Each thread evaluating the function has its own closest cell and list of
+// neighbor cells, so that concurrent evaluations do not interfere.
+class vtkImplicitPolyDataDistanceScratch
+{
+public:
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+};
+
 //-----------------------------------------------------------------------------
 vtkImplicitPolyDataDistance::vtkImplicitPolyDataDistance()
 {
@@ -42,6 +52,8 @@ vtkImplicitPolyDataDistance::vtkImplicitPolyDataDistance()
   this->Input = nullptr;
   this->Locator = nullptr;
   this->Tolerance = 1e-12;
+
+  this->Scratch = new vtkImplicitPolyDataDistanceScratch;
 }
 
 //-----------------------------------------------------------------------------
@@ -62,6 +74,8 @@ void vtkImplicitPolyDataDistance::SetInput(vtkPolyData* input)
 
     this->Input = triangleFilter->GetOutput();
 
+    // The links are only queried, possibly from several threads
+    this->Input->EditableOff();
     this->Input->BuildLinks();
     this->NoValue = this->Input->GetLength();
 
@@ -98,6 +112,9 @@ vtkImplicitPolyDataDistance::~vtkImplicitPolyDataDistance()
     this->Locator->UnRegister(this);
     this->Locator = nullptr;
   }
+
+  delete this->Scratch;
+  this->Scratch = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -166,8 +183,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
   }
 
   // Get point id of closest point in data set.
-  vtkSmartPointer<vtkGenericCell> cell =
-    vtkSmartPointer<vtkGenericCell>::New();
+  vtkGenericCell *cell = this->Scratch->Cell.Local();
   this->Locator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
 
   if (cellId != -1) // point located
@@ -183,7 +199,8 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     double dist2, weights[3], pcoords[3], awnorm[3] = {0, 0, 0};
     cell->EvaluatePosition(p, closestPoint, subId, pcoords, dist2, weights);
 
-    vtkIdList* idList = vtkIdList::New();
+    vtkIdList* idList = this->Scratch->CellIds.Local();
+    vtkIdType npts, *pts;
     int count = 0;
     for (int i = 0; i < 3; i++)
     {
@@ -236,7 +253,8 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
         }
         else
         {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
+          this->Input->GetCellPoints(idList->GetId(i), npts, pts);
+          vtkPolygon::ComputeNormal(this->Input->GetPoints(), npts, pts, norm);
         }
         awnorm[0] += norm[0];
         awnorm[1] += norm[1];
@@ -271,25 +289,26 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
       {
         double norm[3];
+        this->Input->GetCellPoints(idList->GetId(i), npts, pts);
         if ( cnorms )
         {
           cnorms->GetTuple(idList->GetId(i), norm);
         }
         else
         {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
+          vtkPolygon::ComputeNormal(this->Input->GetPoints(), npts, pts, norm);
         }
 
         // Compute angle at point a
-        int b = this->Input->GetCell(idList->GetId(i))->GetPointId(0);
-        int c = this->Input->GetCell(idList->GetId(i))->GetPointId(1);
+        vtkIdType b = pts[0];
+        vtkIdType c = pts[1];
         if (a == b)
         {
-          b = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          b = pts[2];
         }
         else if (a == c)
         {
-          c = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          c = pts[2];
         }
         double pa[3], pb[3], pc[3];
         this->Input->GetPoint(a, pa);
@@ -305,7 +324,6 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       }
       vtkMath::Normalize(awnorm);
     }
-    idList->Delete();
 
     // sign(dist) = dot(grad, cell normal)
     if (ret == 0)
@@ -25,6 +25,11 @@
  * vtkPolyData have a distance of zero. The gradient of the function
  * is the angle-weighted pseudonormal at the nearest point.
  *
+ * Once the input has been set, the evaluation methods do not modify the
+ * function and keep their scratch space (the closest cell and its
+ * neighbors) per thread, so that they may be invoked concurrently, e.g.,
+ * from vtkSMPTools.
+ *
  * Baerentzen, J. A. and Aanaes, H. (2005). Signed distance
  * computation using the angle weighted pseudonormal. IEEE
  * Transactions on Visualization and Computer Graphics, 11:243-253.
@@ -44,6 +49,7 @@
 
 class vtkCellLocator;
 class vtkPolyData;
+class vtkImplicitPolyDataDistanceScratch;
 
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
 {
@@ -135,6 +141,9 @@ protected:
   vtkPolyData *Input;
   vtkCellLocator *Locator;
 
+  // The per-thread scratch space of the evaluations
+  vtkImplicitPolyDataDistanceScratch *Scratch;
+
 private:
   vtkImplicitPolyDataDistance(const vtkImplicitPolyDataDistance&) = delete;
   void operator=(const vtkImplicitPolyDataDistance&) = delete;
@@ -17,16 +17,28 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 
+#include "vtkArrayListTemplate.h" // For matching the averaged arrays
 #include "vtkCellData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkIdList.h"
+#include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnstructuredGrid.h"
 
 #define VTK_EPSILON 1.e-6
 
@@ -148,6 +160,224 @@ vtkIdType Histogram::IndexOfLargestBin()
   return std::max_element(this->Bins.begin(), it2, BinCountCmp)->Index;
 }
 
+//----------------------------------------------------------------------------
+// Average the point tuples of a cell into a cell tuple, for one pair of
+// arrays of the same type. The arithmetic is the one of
+// vtkDataArray::InterpolateTuple() with equal weights: the sum is
+// accumulated in double and integral results are rounded. Nearest neighbor
+// attributes copy the tuple of the last point, as
+// vtkDataSetAttributes::InterpolatePoint() does with equal weights.
+struct BaseCellAverager
+{
+  virtual ~BaseCellAverager() {}
+  virtual void Average(vtkIdType numPts, const vtkIdType *ptIds,
+                       vtkIdType cellId) = 0;
+};
+
+template <typename T>
+struct CellAverager : public BaseCellAverager
+{
+  const T *Input;
+  T *Output;
+  int NumComp;
+  bool NearestNeighbor;
+
+  CellAverager(const T *input, T *output, int numComp, bool nearest) :
+    Input(input), Output(output), NumComp(numComp), NearestNeighbor(nearest)
+  {
+  }
+
+  void Average(vtkIdType numPts, const vtkIdType *ptIds,
+               vtkIdType cellId) override
+  {
+    T *out = this->Output + cellId*this->NumComp;
+    if (numPts < 1)
+    {
+      std::fill_n(out, this->NumComp, T(0));
+    }
+    else if (this->NearestNeighbor)
+    {
+      std::copy_n(this->Input + ptIds[numPts-1]*this->NumComp,
+                  this->NumComp, out);
+    }
+    else
+    {
+      double const weight = 1.0 / numPts;
+      for (int comp = 0; comp < this->NumComp; ++comp)
+      {
+        double val = 0.0;
+        for (vtkIdType i = 0; i < numPts; ++i)
+        {
+          val += weight *
+            static_cast<double>(this->Input[ptIds[i]*this->NumComp+comp]);
+        }
+        vtkMath::RoundDoubleToIntegralIfNecessary(val, out+comp);
+      }
+    }
+  }
+};
+
+// The averagers of all the arrays, so that a cell is processed at once.
+struct CellAveragerList
+{
+  std::vector<std::unique_ptr<BaseCellAverager>> Arrays;
+
+  template <typename T>
+  void AddArrays(const T *input, T *output, int numComp, bool nearest)
+  {
+    this->Arrays.emplace_back(
+      new CellAverager<T>(input, output, numComp, nearest));
+  }
+
+  void Average(vtkIdType numPts, const vtkIdType *ptIds, vtkIdType cellId)
+  {
+    for (auto& array : this->Arrays)
+    {
+      array->Average(numPts, ptIds, cellId);
+    }
+  }
+
+  // Pair the cell arrays created by InterpolateAllocate(), i.e. those not in
+  // passedArrays, with the point arrays of the same name. Nothing is added,
+  // and false is returned, if an array cannot be processed here: it is not
+  // a data array or a bit array, its name is ambiguous, or its memory layout
+  // is not the standard one.
+  bool AddInterpolatedArrays(vtkPointData *inPD, vtkCellData *outCD,
+                             const std::set<vtkAbstractArray*>& passedArrays,
+                             vtkIdType numCells)
+  {
+    std::vector<std::pair<vtkDataArray*, int>> pairs;
+    for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+    {
+      vtkAbstractArray *outArray = outCD->GetAbstractArray(i);
+      if (passedArrays.count(outArray))
+      {
+        continue;
+      }
+      vtkDataArray *inArray = ArrayList::GetMatchingArray(inPD, outArray);
+      if (!inArray)
+      {
+        return false;
+      }
+      pairs.emplace_back(inArray, i);
+    }
+
+    for (auto& pair : pairs)
+    {
+      vtkDataArray *inArray = pair.first;
+      vtkDataArray *outArray = outCD->GetArray(pair.second);
+      int const attribute = outCD->IsArrayAnAttribute(pair.second);
+      bool const nearest = (attribute >= 0 &&
+        outCD->GetCopyAttribute(attribute, vtkDataSetAttributes::INTERPOLATE) == 2);
+      outArray->SetNumberOfTuples(numCells);
+      switch (inArray->GetDataType())
+      {
+        vtkTemplateMacro(this->AddArrays(
+          static_cast<const VTK_TT*>(inArray->GetVoidPointer(0)),
+          static_cast<VTK_TT*>(outArray->GetVoidPointer(0)),
+          inArray->GetNumberOfComponents(), nearest));
+      }
+    }
+    return true;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Threaded averaging over unstructured grids and polydata, whose
+// GetCellPoints() is thread safe once the cells are built.
+struct AverageUnstructured
+{
+  vtkDataSet *Input;
+  CellAveragerList *Arrays;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  AverageUnstructured(vtkDataSet *input, CellAveragerList *arrays) :
+    Input(input), Arrays(arrays)
+  {
+  }
+
+  void Initialize()
+  {
+    this->PointIds.Local()->Allocate(this->Input->GetMaxCellSize());
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdList *ptIds = this->PointIds.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      this->Input->GetCellPoints(cellId, ptIds);
+      this->Arrays->Average(ptIds->GetNumberOfIds(), ptIds->GetPointer(0),
+                            cellId);
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Threaded averaging over structured data. The points of a cell follow from
+// its i-j-k location, in the order of vtkStructuredData::GetCellPoints(), or
+// in the order of the points of a quad or hexahedron for structured grids.
+struct AverageStructured
+{
+  CellAveragerList *Arrays;
+  int Dimensions[3];
+  vtkIdType CellDimensions[3];
+  bool HexahedronOrder;
+
+  AverageStructured(CellAveragerList *arrays, const int dims[3],
+                    bool hexahedronOrder) :
+    Arrays(arrays), HexahedronOrder(hexahedronOrder)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Dimensions[i] = dims[i];
+      this->CellDimensions[i] = (dims[i] > 1 ? dims[i] - 1 : 1);
+    }
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkIdType const d01 = static_cast<vtkIdType>(this->Dimensions[0]) *
+      this->Dimensions[1];
+    int const di = (this->Dimensions[0] > 1 ? 1 : 0);
+    int const dj = (this->Dimensions[1] > 1 ? 1 : 0);
+    int const dk = (this->Dimensions[2] > 1 ? 1 : 0);
+    vtkIdType ptIds[8];
+    for (; cellId < endCellId; ++cellId)
+    {
+      vtkIdType const i0 = cellId % this->CellDimensions[0];
+      vtkIdType const j0 = (cellId / this->CellDimensions[0]) %
+        this->CellDimensions[1];
+      vtkIdType const k0 = cellId /
+        (this->CellDimensions[0] * this->CellDimensions[1]);
+      vtkIdType numPts = 0;
+      for (vtkIdType k = k0; k <= k0 + dk; ++k)
+      {
+        for (vtkIdType j = j0; j <= j0 + dj; ++j)
+        {
+          for (vtkIdType i = i0; i <= i0 + di; ++i)
+          {
+            ptIds[numPts++] = i + j*this->Dimensions[0] + k*d01;
+          }
+        }
+      }
+      if (this->HexahedronOrder && numPts >= 4)
+      {
+        std::swap(ptIds[2], ptIds[3]);
+        if (numPts == 8)
+        {
+          std::swap(ptIds[6], ptIds[7]);
+        }
+      }
+      this->Arrays->Average(numPts, ptIds, cellId);
+    }
+  }
+};
+
 }
 
 
@@ -234,51 +464,101 @@ int vtkPointDataToCellData::RequestData(
 
   // notice that inPD and outCD are vtkPointData and vtkCellData; respectively.
   // It's weird, but it works.
+  std::set<vtkAbstractArray*> passedArrays;
+  for (int i = 0; i < outCD->GetNumberOfArrays(); ++i)
+  {
+    passedArrays.insert(outCD->GetAbstractArray(i));
+  }
   outCD->InterpolateAllocate(inPD,numCells);
 
-  int abort=0;
-  vtkIdType progressInterval=numCells/20 + 1;
-  for (cellId=0; cellId < numCells && !abort; cellId++)
+  // Averages are computed in parallel, with a stencil for structured data.
+  // Categorical data, other data set types and arrays which require the
+  // generic attribute API are processed serially.
+  int dims[3];
+  bool structured = true;
+  vtkStructuredGrid *sgrid = vtkStructuredGrid::SafeDownCast(input);
+  if (vtkImageData *image = vtkImageData::SafeDownCast(input))
+  {
+    image->GetDimensions(dims);
+  }
+  else if (vtkRectilinearGrid *rgrid = vtkRectilinearGrid::SafeDownCast(input))
+  {
+    rgrid->GetDimensions(dims);
+  }
+  else if (sgrid)
+  {
+    sgrid->GetDimensions(dims);
+  }
+  else
+  {
+    structured = false;
+  }
+  bool const unstructured = (vtkUnstructuredGrid::SafeDownCast(input) ||
+                             vtkPolyData::SafeDownCast(input));
+  CellAveragerList arrays;
+  if (!this->CategoricalData && (structured || unstructured) &&
+      arrays.AddInterpolatedArrays(inPD, outCD, passedArrays, numCells))
   {
-    if ( !(cellId % progressInterval) )
+    if (structured)
     {
-      this->UpdateProgress((double)cellId/numCells);
-      abort = GetAbortExecute();
+      AverageStructured average(&arrays, dims, sgrid != nullptr);
+      vtkSMPTools::For(0, numCells, average);
     }
-
-    input->GetCellPoints(cellId, cellPts);
-    numPts = cellPts->GetNumberOfIds();
-
-    if (numPts == 0)
+    else
     {
-      continue;
+      // Make GetCellPoints() thread safe
+      input->GetCellPoints(0, cellPts);
+      AverageUnstructured average(input, &arrays);
+      vtkSMPTools::For(0, numCells, average);
     }
-
-    // If we aren't dealing with categorical data...
-    if (!(this->CategoricalData))
+    this->UpdateProgress(1.0);
+  }
+  else
+  {
+    int abort=0;
+    vtkIdType progressInterval=numCells/20 + 1;
+    for (cellId=0; cellId < numCells && !abort; cellId++)
     {
-      // ...then we simply provide each point with an equal weight value and
-      // interpolate.
-      weight = 1.0 / numPts;
-      for (ptId=0; ptId < numPts; ptId++)
+      if ( !(cellId % progressInterval) )
       {
-        weights[ptId] = weight;
+        this->UpdateProgress((double)cellId/numCells);
+        abort = GetAbortExecute();
       }
-      outCD->InterpolatePoint(inPD, cellId, cellPts, weights);
-    }
-    else
-    {
-      // ...otherwise, we populate a histogram from the scalar values at each
-      // point, and then select the bin with the most elements.
-      hist.Reset(numPts);
-      for (ptId=0; ptId < numPts; ptId++)
+
+      input->GetCellPoints(cellId, cellPts);
+      numPts = cellPts->GetNumberOfIds();
+
+      if (numPts == 0)
       {
-        pointId = cellPts->GetId(ptId);
-        hist.Fill(pointId,
-                  input->GetPointData()->GetScalars()->GetTuple1(pointId));
+        continue;
       }
 
-      outCD->CopyData(inPD, hist.IndexOfLargestBin(), cellId);
+      // If we aren't dealing with categorical data...
+      if (!(this->CategoricalData))
+      {
+        // ...then we simply provide each point with an equal weight value and
+        // interpolate.
+        weight = 1.0 / numPts;
+        for (ptId=0; ptId < numPts; ptId++)
+        {
+          weights[ptId] = weight;
+        }
+        outCD->InterpolatePoint(inPD, cellId, cellPts, weights);
+      }
+      else
+      {
+        // ...otherwise, we populate a histogram from the scalar values at each
+        // point, and then select the bin with the most elements.
+        hist.Reset(numPts);
+        for (ptId=0; ptId < numPts; ptId++)
+        {
+          pointId = cellPts->GetId(ptId);
+          hist.Fill(pointId,
+                    input->GetPointData()->GetScalars()->GetTuple1(pointId));
+        }
+
+        outCD->CopyData(inPD, hist.IndexOfLargestBin(), cellId);
+      }
     }
   }
 
@@ -22,6 +22,11 @@
  * values of all points defining a particular cell. Optionally, the input point
  * data can be passed through to the output as well.
  *
+ * Unless CategoricalData is on, the cells of unstructured grids, polydata
+ * and structured data sets are processed in parallel with vtkSMPTools, all
+ * the arrays at once. The points of structured cells are computed from the
+ * i-j-k location of the cell.
+ *
  * @warning
  * This filter is an abstract filter, that is, the output is an abstract type
  * (i.e., vtkDataSet). Use the convenience methods (e.g.,
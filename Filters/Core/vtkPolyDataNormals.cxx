@@ -174,6 +174,7 @@ int vtkPolyDataNormals::RequestData(
     this->OldMesh->SetPolys(inPolys);
     polys = inPolys;
   }
+  this->OldMesh->EditableOff(); // the links are only queried
   this->OldMesh->BuildLinks();
   this->UpdateProgress(0.10);
 
@@ -30,6 +30,7 @@
 #include "vtkSmartPointer.h"
 #include "vtkSMPTools.h"
 #include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkStaticCellLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
@@ -362,6 +363,157 @@ void vtkProbeFilter::Probe(vtkDataSet *input, vtkDataSet *source,
   this->DoProbing(input, 0, source, output);
 }
 
+namespace {
+
+// Interleave the lower 21 bits of i with two zero bits after each bit.
+inline vtkTypeUInt64 SpreadBits(vtkTypeUInt64 i)
+{
+  i &= 0x1fffff;
+  i = (i | (i << 32)) & 0x1f00000000ffffULL;
+  i = (i | (i << 16)) & 0x1f0000ff0000ffULL;
+  i = (i | (i << 8)) & 0x100f00f00f00f00fULL;
+  i = (i | (i << 4)) & 0x10c30c30c30c30c3ULL;
+  i = (i | (i << 2)) & 0x1249249249249249ULL;
+  return i;
+}
+
+// Sort key of a probe point along a Morton (Z-order) curve, paired with the
+// id of the point.
+struct MortonPoint
+{
+  vtkTypeUInt64 Key;
+  vtkIdType PtId;
+
+  bool operator<(const MortonPoint& other) const
+  {
+    return this->Key < other.Key;
+  }
+};
+
+// Compute the Morton keys of the probe points. Points that have already been
+// probed get the largest key so that they end up at the end of the ordering.
+struct ComputeMortonKeys
+{
+  vtkDataSet *Input;
+  const char *MaskArray;
+  MortonPoint *Points;
+  double Origin[3];
+  double Scale[3];
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3];
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      MortonPoint &mp = this->Points[ptId];
+      mp.PtId = ptId;
+      if (this->MaskArray[ptId] == static_cast<char>(1))
+      {
+        mp.Key = VTK_TYPE_UINT64_MAX;
+        continue;
+      }
+      this->Input->GetPoint(ptId, x);
+      vtkTypeUInt64 key = 0;
+      for (int i = 0; i < 3; ++i)
+      {
+        double t = (x[i] - this->Origin[i]) * this->Scale[i];
+        t = (t < 0.0 ? 0.0 : (t > 2097151.0 ? 2097151.0 : t));
+        key |= SpreadBits(static_cast<vtkTypeUInt64>(t)) << i;
+      }
+      mp.Key = key;
+    }
+  }
+};
+
+} // anonymous namespace
+
+// Probe the points of a range of the Morton ordering. Each thread uses its
+// own generic cell and weights; the queries of the cell locator are thread
+// safe once it is built, and every point writes only its own output tuple.
+class vtkProbeFilter::ProbeEmptyPointsWorklet
+{
+public:
+  ProbeEmptyPointsWorklet(vtkProbeFilter *probeFilter, vtkDataSet *input,
+                          vtkDataSet *source, int srcIdx,
+                          vtkAbstractCellLocator *locator,
+                          const MortonPoint *order, vtkPointData *outPD,
+                          char *maskArray, double tol2, int maxCellSize)
+    : ProbeFilter(probeFilter), Input(input), Source(source), SrcIdx(srcIdx),
+      Locator(locator), Order(order), OutPointData(outPD),
+      MaskArray(maskArray), Tol2(tol2), MaxCellSize(maxCellSize)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<double> &weightsBuffer = this->WeightsBuffer.Local();
+    weightsBuffer.resize(this->MaxCellSize);
+    double *weights = &weightsBuffer[0];
+    vtkGenericCell *cell = this->Cells.Local();
+    vtkPointData *pd = this->Source->GetPointData();
+    vtkCellData *cd = this->Source->GetCellData();
+
+    double x[3], pcoords[3], closestPoint[3], dist2;
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType ptId = this->Order[i].PtId;
+      if (this->MaskArray[ptId] == static_cast<char>(1))
+      {
+        continue;
+      }
+
+      this->Input->GetPoint(ptId, x);
+      vtkIdType cellId =
+        this->Locator->FindCell(x, this->Tol2, cell, pcoords, weights);
+      if (cellId < 0)
+      {
+        continue;
+      }
+      if (this->ProbeFilter->ComputeTolerance)
+      {
+        // If ComputeTolerance is set, compute a tolerance proportional to the
+        // cell length.
+        cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights);
+        if (dist2 > (cell->GetLength2() * CELL_TOLERANCE_FACTOR_SQR))
+        {
+          continue;
+        }
+      }
+
+      // Interpolate the point data
+      this->OutPointData->InterpolatePoint((*this->ProbeFilter->PointList),
+        pd, this->SrcIdx, ptId, cell->PointIds, weights);
+      vtkVectorOfArrays::iterator iter;
+      for (iter = this->ProbeFilter->CellArrays->begin();
+        iter != this->ProbeFilter->CellArrays->end(); ++iter)
+      {
+        vtkDataArray* inArray = cd->GetArray((*iter)->GetName());
+        if (inArray)
+        {
+          this->OutPointData->CopyTuple(inArray, *iter, cellId, ptId);
+        }
+      }
+      this->MaskArray[ptId] = static_cast<char>(1);
+    }
+  }
+
+private:
+  vtkProbeFilter *ProbeFilter;
+  vtkDataSet *Input;
+  vtkDataSet *Source;
+  int SrcIdx;
+  vtkAbstractCellLocator *Locator;
+  const MortonPoint *Order;
+  vtkPointData *OutPointData;
+  char *MaskArray;
+  double Tol2;
+  int MaxCellSize;
+
+  vtkSMPThreadLocal<std::vector<double> > WeightsBuffer;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cells;
+};
+
 //----------------------------------------------------------------------------
 void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   int srcIdx,
@@ -380,17 +532,6 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   pd = source->GetPointData();
   cd = source->GetCellData();
 
-  // lets use a stack allocated array if possible for performance reasons
-  int mcs = source->GetMaxCellSize();
-  if (mcs<=256)
-  {
-    weights = fastweights;
-  }
-  else
-  {
-    weights = new double[mcs];
-  }
-
   numPts = input->GetNumberOfPoints();
   outPD = output->GetPointData();
 
@@ -401,20 +542,33 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
 
   // vtkPointSet based datasets do not have an implicit structure to their
   // points. A cell locator performs better here than using the dataset's
-  // FindCell function.
-  vtkSmartPointer<vtkAbstractCellLocator> cellLocator;
+  // FindCell function. Since the queries of the locator are thread safe,
+  // the points are then probed in parallel.
   if (vtkPointSet::SafeDownCast(source) != nullptr)
   {
+    vtkSmartPointer<vtkAbstractCellLocator> cellLocator;
     cellLocator.TakeReference(this->CellLocatorPrototype ?
                               this->CellLocatorPrototype->NewInstance() :
                               vtkStaticCellLocator::New());
     cellLocator->SetDataSet(source);
     cellLocator->Update();
+    this->ProbePointsWithLocator(input, srcIdx, source, cellLocator, output);
+    return;
+  }
+
+  // lets use a stack allocated array if possible for performance reasons
+  int mcs = source->GetMaxCellSize();
+  if (mcs<=256)
+  {
+    weights = fastweights;
+  }
+  else
+  {
+    weights = new double[mcs];
   }
 
   // Loop over all input points, interpolating source data
   //
-  vtkNew<vtkGenericCell> gcell;
   int abort=0;
   vtkIdType progressInterval=numPts/20 + 1;
   for (ptId=0; ptId < numPts && !abort; ptId++)
@@ -436,8 +590,7 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
     input->GetPoint(ptId, x);
 
     // Find the cell that contains xyz and get it
-    vtkIdType cellId = (cellLocator.Get() != nullptr) ?
-      cellLocator->FindCell(x, tol2, gcell.GetPointer(), pcoords, weights) :
+    vtkIdType cellId =
       source->FindCell(x, nullptr, -1, tol2, subId, pcoords, weights);
 
     vtkCell* cell = nullptr;
@@ -484,6 +637,61 @@ void vtkProbeFilter::ProbeEmptyPoints(vtkDataSet *input,
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkProbeFilter::ProbePointsWithLocator(vtkDataSet *input, int srcIdx,
+  vtkDataSet *source, vtkAbstractCellLocator *cellLocator, vtkDataSet *output)
+{
+  vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts < 1 || source->GetNumberOfCells() < 1)
+  {
+    return;
+  }
+  char* maskArray = this->MaskPoints->GetPointer(0);
+  double tol2 = this->ComputeTolerance ? VTK_DOUBLE_MAX :
+                (this->Tolerance * this->Tolerance);
+
+  // dummy calls required before multithreaded calls
+  double x[3];
+  input->GetPoint(0, x);
+  static_cast<void>(source->GetCellType(0));
+
+  // Visit the probe points along a Morton curve: consecutive queries then
+  // fall in neighboring cells, which keeps the locator and the source data
+  // in cache whatever the order of the input points.
+  double bounds[6];
+  input->GetBounds(bounds);
+  ComputeMortonKeys keys;
+  keys.Input = input;
+  keys.MaskArray = maskArray;
+  std::vector<MortonPoint> order(numPts);
+  keys.Points = &order[0];
+  for (int i = 0; i < 3; ++i)
+  {
+    double length = bounds[2*i+1] - bounds[2*i];
+    keys.Origin[i] = bounds[2*i];
+    keys.Scale[i] = (length > 0.0 ? 2097151.0 / length : 0.0);
+  }
+  vtkSMPTools::For(0, numPts, keys);
+  vtkSMPTools::Sort(order.begin(), order.end());
+
+  ProbeEmptyPointsWorklet worklet(this, input, source, srcIdx, cellLocator,
+                                  &order[0], output->GetPointData(),
+                                  maskArray, tol2, source->GetMaxCellSize());
+
+  // Probe the points in a few chunks to report progress and check for abort
+  // between them.
+  const vtkIdType numChunks = 20;
+  for (vtkIdType chunk = 0; chunk < numChunks && !this->GetAbortExecute();
+    ++chunk)
+  {
+    this->UpdateProgress(static_cast<double>(chunk)/numChunks);
+    vtkSMPTools::For(chunk*numPts/numChunks, (chunk+1)*numPts/numChunks,
+                     worklet);
+  }
+
+  this->MaskPoints->Modified();
+}
+
 //---------------------------------------------------------------------------
 static void GetPointIdsInRange(double rangeMin, double rangeMax, double start,
   double stepsize, int numSteps, int &minid, int &maxid)
@@ -251,6 +251,12 @@ private:
   void ProbeEmptyPoints(vtkDataSet *input, int srcIdx, vtkDataSet *source,
     vtkDataSet *output);
 
+  // Probe the points in parallel, in Morton order, using a cell locator of
+  // the source to find the cells.
+  void ProbePointsWithLocator(vtkDataSet *input, int srcIdx, vtkDataSet *source,
+    vtkAbstractCellLocator *cellLocator, vtkDataSet *output);
+  class ProbeEmptyPointsWorklet;
+
   // A faster implementation for vtkImageData input.
   void ProbePointsImageData(vtkImageData *input, int srcIdx, vtkDataSet *source,
     vtkImageData *output);
@@ -24,21 +24,208 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 
+#include <functional> // hash of the inserted triangles
+#include <unordered_map> // sparse bins
 #include <unordered_set> // keep track of inserted triangles
+#include <vector>
 
 vtkStandardNewMacro(vtkQuadricClustering);
 
 //----------------------------------------------------------------------------
-// PIMPLd STL set for keeping track of inserted cells
+// PIMPLd STL set for keeping track of inserted cells. A triangle is
+// identified by its sorted bin ids; folding them into a single id would
+// overflow for fine binnings.
 struct vtkQuadricClusteringIdTypeHash {
   size_t operator()(vtkIdType val) const { return static_cast<size_t>(val); }
 };
-class vtkQuadricClusteringCellSet : public std::unordered_set<vtkIdType, vtkQuadricClusteringIdTypeHash> {};
+struct vtkQuadricClusteringTriangle {
+  vtkIdType BinIds[3];
+  bool operator==(const vtkQuadricClusteringTriangle &tri) const
+  {
+    return this->BinIds[0] == tri.BinIds[0] && this->BinIds[1] == tri.BinIds[1] &&
+           this->BinIds[2] == tri.BinIds[2];
+  }
+};
+struct vtkQuadricClusteringTriangleHash {
+  size_t operator()(const vtkQuadricClusteringTriangle &tri) const
+  {
+    std::hash<vtkIdType> hash;
+    size_t h = hash(tri.BinIds[0]);
+    h ^= hash(tri.BinIds[1]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= hash(tri.BinIds[2]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+  }
+};
+class vtkQuadricClusteringCellSet :
+  public std::unordered_set<vtkQuadricClusteringTriangle, vtkQuadricClusteringTriangleHash> {};
 typedef vtkQuadricClusteringCellSet::iterator vtkQuadricClusteringCellSetIterator;
 
+//----------------------------------------------------------------------------
+// The bins used by the parallel accumulation: the shared bins hold the
+// vertex ids and the quadrics added serially, and each thread accumulates
+// the quadrics of its triangles in its own bins until they are merged.
+struct vtkQuadricClustering::SparseBinMap
+{
+  typedef std::unordered_map<vtkIdType, PointQuadric,
+                             vtkQuadricClusteringIdTypeHash> MapType;
+
+  MapType Bins;
+  vtkSMPThreadLocal<MapType> LocalBins;
+
+  // Lower dimensions supersede higher ones, quadrics of the same dimension
+  // add up. This does not depend on the order of the additions.
+  static void Accumulate(PointQuadric &bin, unsigned char dimension,
+                         const double quadric[9])
+  {
+    if (bin.Dimension > dimension)
+    {
+      bin.Dimension = dimension;
+      for (int i = 0; i < 9; i++)
+      {
+        bin.Quadric[i] = quadric[i];
+      }
+    }
+    else if (bin.Dimension == dimension)
+    {
+      for (int i = 0; i < 9; i++)
+      {
+        bin.Quadric[i] += quadric[i];
+      }
+    }
+  }
+};
+
+namespace
+{
+// Compute the nine coefficients of the quadric of a triangle, scaled as
+// vtkQuadricClustering::AddQuadric does.
+void ComputeTriangleQuadric(double *pt0, double *pt1, double *pt2,
+                            double quadric[9])
+{
+  double quadric4x4[4][4];
+  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
+  quadric[0] = quadric4x4[0][0];
+  quadric[1] = quadric4x4[0][1];
+  quadric[2] = quadric4x4[0][2];
+  quadric[3] = quadric4x4[0][3];
+  quadric[4] = quadric4x4[1][1];
+  quadric[5] = quadric4x4[1][2];
+  quadric[6] = quadric4x4[1][3];
+  quadric[7] = quadric4x4[2][2];
+  quadric[8] = quadric4x4[2][3];
+}
+}
+
+//----------------------------------------------------------------------------
+// Hash the triangles of a range of cells and accumulate their quadrics in
+// the bins of the thread. The bins of the triangles are stored so that they
+// can be added to the output in order afterwards.
+struct vtkQuadricClustering::TriangleAccumulator
+{
+  vtkQuadricClustering *Self;
+  vtkPoints *Points;
+  const vtkIdType *Connectivity;
+  const std::vector<vtkIdType> &CellLocations;
+  const std::vector<vtkIdType> &TriangleOffsets;
+  bool Strips;
+  vtkIdType *TriangleBins;
+
+  TriangleAccumulator(vtkQuadricClustering *self, vtkPoints *points,
+                      const vtkIdType *connectivity,
+                      const std::vector<vtkIdType> &cellLocations,
+                      const std::vector<vtkIdType> &triangleOffsets,
+                      bool strips, vtkIdType *triangleBins)
+    : Self(self), Points(points), Connectivity(connectivity),
+      CellLocations(cellLocations), TriangleOffsets(triangleOffsets),
+      Strips(strips), TriangleBins(triangleBins)
+  {
+  }
+
+  void AddTriangle(SparseBinMap::MapType &bins, vtkIdType *binIds,
+                   double *pt0, double *pt1, double *pt2)
+  {
+    if (binIds[0] == binIds[1] || binIds[0] == binIds[2] ||
+        binIds[1] == binIds[2])
+    {
+      if (!this->Self->UseInternalTriangles)
+      {
+        return;
+      }
+    }
+    double quadric[9];
+    ComputeTriangleQuadric(pt0, pt1, pt2, quadric);
+    for (int i = 0; i < 9; i++)
+    {
+      quadric[i] *= 100000000.0;
+    }
+    for (int i = 0; i < 3; i++)
+    {
+      SparseBinMap::Accumulate(bins[binIds[i]], 2, quadric);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    SparseBinMap::MapType &bins = this->Self->SparseBins->LocalBins.Local();
+    double pts[3][3];
+    for (vtkIdType cellId = begin; cellId < end; cellId++)
+    {
+      const vtkIdType *cell = this->Connectivity + this->CellLocations[cellId];
+      vtkIdType numPts = cell[0];
+      const vtkIdType *ptIds = cell + 1;
+      vtkIdType *binIds = this->TriangleBins + 3 * this->TriangleOffsets[cellId];
+      if (numPts < 3)
+      {
+        continue;
+      }
+      if (this->Strips)
+      {
+        // Same traversal as AddStrips
+        this->Points->GetPoint(ptIds[0], pts[0]);
+        this->Points->GetPoint(ptIds[1], pts[1]);
+        vtkIdType stripBins[3];
+        stripBins[0] = this->Self->HashPoint(pts[0]);
+        stripBins[1] = this->Self->HashPoint(pts[1]);
+        int odd = 0;
+        for (vtkIdType j = 2; j < numPts; ++j, binIds += 3)
+        {
+          this->Points->GetPoint(ptIds[j], pts[2]);
+          stripBins[2] = this->Self->HashPoint(pts[2]);
+          binIds[0] = stripBins[0];
+          binIds[1] = stripBins[1];
+          binIds[2] = stripBins[2];
+          this->AddTriangle(bins, binIds, pts[0], pts[1], pts[2]);
+          pts[odd][0] = pts[2][0];
+          pts[odd][1] = pts[2][1];
+          pts[odd][2] = pts[2][2];
+          stripBins[odd] = stripBins[2];
+          odd = odd ? 0 : 1;
+        }
+      }
+      else
+      {
+        // Same fan of triangles as AddPolygons
+        this->Points->GetPoint(ptIds[0], pts[0]);
+        vtkIdType bin0 = this->Self->HashPoint(pts[0]);
+        for (vtkIdType j = 0; j < numPts - 2; j++, binIds += 3)
+        {
+          this->Points->GetPoint(ptIds[j + 1], pts[1]);
+          this->Points->GetPoint(ptIds[j + 2], pts[2]);
+          binIds[0] = bin0;
+          binIds[1] = this->Self->HashPoint(pts[1]);
+          binIds[2] = this->Self->HashPoint(pts[2]);
+          this->AddTriangle(bins, binIds, pts[0], pts[1], pts[2]);
+        }
+      }
+    }
+  }
+};
+
 
 //----------------------------------------------------------------------------
 // Construct with default NumberOfDivisions to 50, DivisionSpacing to 1
@@ -55,7 +242,9 @@ vtkQuadricClustering::vtkQuadricClustering()
   this->NumberOfYDivisions = 50;
   this->NumberOfZDivisions = 50;
   this->QuadricArray = nullptr;
+  this->SparseBins = nullptr;
   this->NumberOfBinsUsed = 0;
+  this->ParallelAccumulation = 0;
   this->AbortExecute = 0;
 
   this->AutoAdjustNumberOfDivisions = 1;
@@ -102,6 +291,8 @@ vtkQuadricClustering::~vtkQuadricClustering()
   this->CellSet = nullptr;
   delete [] this->QuadricArray;
   this->QuadricArray = nullptr;
+  delete this->SparseBins;
+  this->SparseBins = nullptr;
   if (this->OutputTriangleArray)
   {
     this->OutputTriangleArray->Delete();
@@ -114,6 +305,29 @@ vtkQuadricClustering::~vtkQuadricClustering()
   }
 }
 
+//----------------------------------------------------------------------------
+inline vtkQuadricClustering::PointQuadric*
+vtkQuadricClustering::GetBin(vtkIdType binId)
+{
+  if (this->SparseBins)
+  {
+    return &this->SparseBins->Bins[binId];
+  }
+  return this->QuadricArray + binId;
+}
+
+//----------------------------------------------------------------------------
+inline vtkQuadricClustering::PointQuadric*
+vtkQuadricClustering::FindBin(vtkIdType binId)
+{
+  if (this->SparseBins)
+  {
+    SparseBinMap::MapType::iterator it = this->SparseBins->Bins.find(binId);
+    return it == this->SparseBins->Bins.end() ? nullptr : &it->second;
+  }
+  return this->QuadricArray + binId;
+}
+
 //----------------------------------------------------------------------------
 int vtkQuadricClustering::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -187,7 +401,6 @@ int vtkQuadricClustering::RequestData(
 
   this->StartAppend(input->GetBounds());
   this->UpdateProgress(.2);
-  this->SliceSize = this->NumberOfDivisions[0]*this->NumberOfDivisions[1];
 
   this->Append(input);
   if (this->UseFeatureEdges)
@@ -207,6 +420,8 @@ int vtkQuadricClustering::RequestData(
   // Free up some memory.
   delete [] this->QuadricArray;
   this->QuadricArray = nullptr;
+  delete this->SparseBins;
+  this->SparseBins = nullptr;
 
   if ( this->Debug )
   {
@@ -221,14 +436,6 @@ int vtkQuadricClustering::RequestData(
 //----------------------------------------------------------------------------
 void vtkQuadricClustering::StartAppend(double *bounds)
 {
-  // If there are duplicate triangles. remove them
-  if ( this->PreventDuplicateCells )
-  {
-    this->CellSet = new vtkQuadricClusteringCellSet;
-    this->NumberOfBins =
-      this->NumberOfDivisions[0]*this->NumberOfDivisions[1]*this->NumberOfDivisions[2];
-  }
-
   // Copy over the bounds.
   for (vtkIdType i = 0; i < 6; ++i)
   {
@@ -264,6 +471,17 @@ void vtkQuadricClustering::StartAppend(double *bounds)
     this->DivisionSpacing[1] = (bounds[3]-bounds[2])/this->NumberOfDivisions[1];
     this->DivisionSpacing[2] = (bounds[5]-bounds[4])/this->NumberOfDivisions[2];
   }
+  this->SliceSize =
+    static_cast<vtkIdType>(this->NumberOfDivisions[0])*this->NumberOfDivisions[1];
+
+  // If there are duplicate triangles. remove them
+  if ( this->PreventDuplicateCells )
+  {
+    delete this->CellSet;
+    this->CellSet = new vtkQuadricClusteringCellSet;
+    this->NumberOfBins = static_cast<vtkIdType>(this->NumberOfDivisions[0]) *
+      this->NumberOfDivisions[1] * this->NumberOfDivisions[2];
+  }
 
   // Check for conditions that can occur if the Append methods
   // are not called in the correct order.
@@ -293,14 +511,20 @@ void vtkQuadricClustering::StartAppend(double *bounds)
 
   this->NumberOfBinsUsed = 0;
   delete [] this->QuadricArray;
-  this->QuadricArray =
-    new vtkQuadricClustering::PointQuadric[this->NumberOfDivisions[0] *
-                                          this->NumberOfDivisions[1] *
-                                          this->NumberOfDivisions[2]];
-  if (this->QuadricArray == nullptr)
+  this->QuadricArray = nullptr;
+  delete this->SparseBins;
+  this->SparseBins = nullptr;
+  if (this->ParallelAccumulation)
   {
-    vtkErrorMacro("Could not allocate quadric grid.");
-    return;
+    // Only the bins that are used are stored.
+    this->SparseBins = new SparseBinMap;
+  }
+  else
+  {
+    this->QuadricArray =
+      new vtkQuadricClustering::PointQuadric[this->NumberOfDivisions[0] *
+                                            this->NumberOfDivisions[1] *
+                                            this->NumberOfDivisions[2]];
   }
 
   vtkInformation *inInfo = this->GetExecutive()->GetInputInformation(0, 0);
@@ -358,14 +582,84 @@ void vtkQuadricClustering::Append(vtkPolyData *pd)
   inputPolys = pd->GetPolys();
   if (inputPolys)
   {
-    this->AddPolygons(inputPolys, inputPoints, 1, pd, output);
+    if (this->SparseBins)
+    {
+      this->AddTrianglesInParallel(inputPolys, false, inputPoints, pd, output);
+    }
+    else
+    {
+      this->AddPolygons(inputPolys, inputPoints, 1, pd, output);
+    }
   }
   this->UpdateProgress(.80);
 
   inputStrips = pd->GetStrips();
   if (inputStrips)
   {
-    this->AddStrips(inputStrips, inputPoints, 1, pd, output);
+    if (this->SparseBins)
+    {
+      this->AddTrianglesInParallel(inputStrips, true, inputPoints, pd, output);
+    }
+    else
+    {
+      this->AddStrips(inputStrips, inputPoints, 1, pd, output);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::AddTrianglesInParallel(vtkCellArray *cells,
+                                                  bool strips,
+                                                  vtkPoints *points,
+                                                  vtkPolyData *input,
+                                                  vtkPolyData *output)
+{
+  vtkIdType numCells = cells->GetNumberOfCells();
+  if (numCells == 0)
+  {
+    return;
+  }
+
+  // Locate the cells and their triangles so that they can be processed in
+  // any order.
+  const vtkIdType *connectivity = cells->GetPointer();
+  std::vector<vtkIdType> cellLocations(numCells);
+  std::vector<vtkIdType> triangleOffsets(numCells + 1);
+  triangleOffsets[0] = 0;
+  vtkIdType loc = 0;
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    vtkIdType numPts = connectivity[loc];
+    cellLocations[cellId] = loc;
+    triangleOffsets[cellId + 1] =
+      triangleOffsets[cellId] + (numPts > 2 ? numPts - 2 : 0);
+    loc += numPts + 1;
+  }
+
+  // Hash the triangles and accumulate their quadrics in parallel.
+  std::vector<vtkIdType> triangleBins(3 * triangleOffsets[numCells]);
+  TriangleAccumulator accumulator(this, points, connectivity, cellLocations,
+                                  triangleOffsets, strips,
+                                  triangleBins.data());
+  vtkSMPTools::For(0, numCells, accumulator);
+
+  // Add the triangles to the output in the order of the input, as the serial
+  // path does, so that the output does not depend on the number of threads.
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    for (vtkIdType triId = triangleOffsets[cellId];
+         triId < triangleOffsets[cellId + 1]; triId++)
+    {
+      vtkIdType *binIds = &triangleBins[3 * triId];
+      if (this->UseInternalTriangles == 0 &&
+          (binIds[0] == binIds[1] || binIds[0] == binIds[2] ||
+           binIds[1] == binIds[2]))
+      {
+        continue;
+      }
+      this->AddTriangleGeometry(binIds, input, output);
+    }
+    ++this->InCellCount;
   }
 }
 
@@ -482,29 +776,21 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
   }
 
   // Compute the quadric.
-  double quadric[9], quadric4x4[4][4];
-  vtkTriangle::ComputeQuadric(pt0, pt1, pt2, quadric4x4);
-  quadric[0] = quadric4x4[0][0];
-  quadric[1] = quadric4x4[0][1];
-  quadric[2] = quadric4x4[0][2];
-  quadric[3] = quadric4x4[0][3];
-  quadric[4] = quadric4x4[1][1];
-  quadric[5] = quadric4x4[1][2];
-  quadric[6] = quadric4x4[1][3];
-  quadric[7] = quadric4x4[2][2];
-  quadric[8] = quadric4x4[2][3];
+  double quadric[9];
+  ComputeTriangleQuadric(pt0, pt1, pt2, quadric);
 
   // Add the quadric to each of the three corner bins.
   for (int i = 0; i < 3; ++i)
   {
+    PointQuadric *bin = this->GetBin(binIds[i]);
     // If the current quadric is not initialized, then clear it out.
-    if (this->QuadricArray[binIds[i]].Dimension > 2)
+    if (bin->Dimension > 2)
     {
-      this->QuadricArray[binIds[i]].Dimension = 2;
+      bin->Dimension = 2;
       // Initialize the coeff
-      this->InitializeQuadric(this->QuadricArray[binIds[i]].Quadric);
+      this->InitializeQuadric(bin->Quadric);
     }
-    if (this->QuadricArray[binIds[i]].Dimension == 2)
+    if (bin->Dimension == 2)
     { // Points and segments supersede triangles.
       this->AddQuadric(binIds[i], quadric);
     }
@@ -512,82 +798,82 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
 
   if (geometryFlag)
   {
-    vtkIdType triPtIds[3];
-    // Now add the triangle to the geometry.
-    for (int i = 0; i < 3; i++)
+    this->AddTriangleGeometry(binIds, input, output);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Add the triangle to the output, unless two of its vertices fall in the
+// same bin or it is a duplicate.
+void vtkQuadricClustering::AddTriangleGeometry(vtkIdType *binIds,
+                                               vtkPolyData *input,
+                                               vtkPolyData *output)
+{
+  vtkIdType triPtIds[3];
+  // Now add the triangle to the geometry.
+  for (int i = 0; i < 3; i++)
+  {
+    // Get the vertex from each bin.
+    PointQuadric *bin = this->GetBin(binIds[i]);
+    if (bin->VertexId == -1)
     {
-      // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
-      {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
-        this->NumberOfBinsUsed++;
-      }
-      triPtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      bin->VertexId = this->NumberOfBinsUsed;
+      this->NumberOfBinsUsed++;
     }
-    // This comparison could just as well be on triPtIds.
-    if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
-        binIds[1] != binIds[2])
+    triPtIds[i] = bin->VertexId;
+  }
+  // This comparison could just as well be on triPtIds.
+  if (binIds[0] != binIds[1] && binIds[0] != binIds[2] &&
+      binIds[1] != binIds[2])
+  {
+    if ( this->PreventDuplicateCells )
     {
-      if ( this->PreventDuplicateCells )
+      vtkIdType minIdx = ( binIds[0]<binIds[1] ? (binIds[0]<binIds[2] ? 0 : 2) :
+                           (binIds[1]<binIds[2] ? 1 : 2) );
+      vtkIdType midIdx = 0;
+      vtkIdType maxIdx = 0;
+      switch ( minIdx )
       {
-        vtkIdType minIdx = ( binIds[0]<binIds[1] ? (binIds[0]<binIds[2] ? 0 : 2) :
-                             (binIds[1]<binIds[2] ? 1 : 2) );
-        vtkIdType midIdx = 0;
-        vtkIdType maxIdx = 0;
-        switch ( minIdx )
-        {
-          case 0:
-            if ( binIds[1] > binIds[2] )
-            {
-              maxIdx = 1;
-              midIdx = 2;
-            }
-            else
-            {
-              maxIdx = 2;
-              midIdx = 1;
-            }
-            break;
-          case 1:
-            if ( binIds[0] > binIds[2] )
-            {
-              maxIdx = 0;
-              midIdx = 2;
-            }
-            else
-            {
-              maxIdx = 2;
-              midIdx = 0;
-            }
-            break;
-          case 2:
-            if ( binIds[0] > binIds[1] )
-            {
-              maxIdx = 0;
-              midIdx = 1;
-            }
-            else
-            {
-              maxIdx = 1;
-              midIdx = 0;
-            }
-            break;
-        }
-        // TODO: this arithmetic overflows with the TestQuadricLODActor test.
-        vtkIdType idx = binIds[minIdx] + this->NumberOfBins*binIds[midIdx] +
-                        this->NumberOfBins*this->NumberOfBins*binIds[maxIdx];
-        if ( this->CellSet->find(idx) == this->CellSet->end() )
-        {
-          this->CellSet->insert(idx);
-          this->OutputTriangleArray->InsertNextCell(3, triPtIds);
-          if (this->CopyCellData && input)
+        case 0:
+          if ( binIds[1] > binIds[2] )
+          {
+            maxIdx = 1;
+            midIdx = 2;
+          }
+          else
+          {
+            maxIdx = 2;
+            midIdx = 1;
+          }
+          break;
+        case 1:
+          if ( binIds[0] > binIds[2] )
           {
-            output->GetCellData()->
-              CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
-          }//if cell data
-        }//if not a duplicate
+            maxIdx = 0;
+            midIdx = 2;
+          }
+          else
+          {
+            maxIdx = 2;
+            midIdx = 0;
+          }
+          break;
+        case 2:
+          if ( binIds[0] > binIds[1] )
+          {
+            maxIdx = 0;
+            midIdx = 1;
+          }
+          else
+          {
+            maxIdx = 1;
+            midIdx = 0;
+          }
+          break;
       }
-      else //don't check for duplicates
+      vtkQuadricClusteringTriangle tri = {
+        { binIds[minIdx], binIds[midIdx], binIds[maxIdx] } };
+      if ( this->CellSet->insert(tri).second )
       {
         this->OutputTriangleArray->InsertNextCell(3, triPtIds);
         if (this->CopyCellData && input)
@@ -595,9 +881,18 @@ void vtkQuadricClustering::AddTriangle(vtkIdType *binIds, double *pt0, double *p
           output->GetCellData()->
             CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
         }//if cell data
-      }//don't check for duplicates
-    }//if not duplicate vertices
-  }//if this should be inserted
+      }//if not a duplicate
+    }
+    else //don't check for duplicates
+    {
+      this->OutputTriangleArray->InsertNextCell(3, triPtIds);
+      if (this->CopyCellData && input)
+      {
+        output->GetCellData()->
+          CopyData(input->GetCellData(), this->InCellCount,this->OutCellCount++);
+      }//if cell data
+    }//don't check for duplicates
+  }//if not duplicate vertices
 }
 
 //----------------------------------------------------------------------------
@@ -704,14 +999,15 @@ void vtkQuadricClustering::AddEdge(vtkIdType *binIds, double *pt0, double *pt1,
 
   for (int i = 0; i < 2; ++i)
   {
+    PointQuadric *bin = this->GetBin(binIds[i]);
     // If the current quadric is from triangles (or not initialized), then clear it out.
-    if (this->QuadricArray[binIds[i]].Dimension > 1)
+    if (bin->Dimension > 1)
     {
-      this->QuadricArray[binIds[i]].Dimension = 1;
+      bin->Dimension = 1;
       // Initialize the coeff
-      this->InitializeQuadric(this->QuadricArray[binIds[i]].Quadric);
+      this->InitializeQuadric(bin->Quadric);
     }
-    if (this->QuadricArray[binIds[i]].Dimension == 1)
+    if (bin->Dimension == 1)
     { // Points supersede segments.
       this->AddQuadric(binIds[i], q);
     }
@@ -723,12 +1019,13 @@ void vtkQuadricClustering::AddEdge(vtkIdType *binIds, double *pt0, double *pt1,
     for (int i = 0; i < 2; i++)
     {
       // Get the vertex from each bin.
-      if (this->QuadricArray[binIds[i]].VertexId == -1)
+      PointQuadric *bin = this->GetBin(binIds[i]);
+      if (bin->VertexId == -1)
       {
-        this->QuadricArray[binIds[i]].VertexId = this->NumberOfBinsUsed;
+        bin->VertexId = this->NumberOfBinsUsed;
         this->NumberOfBinsUsed++;
       }
-      edgePtIds[i] = this->QuadricArray[binIds[i]].VertexId;
+      edgePtIds[i] = bin->VertexId;
     }
     // This comparison could just as well be on edgePtIds.
     if (binIds[0] != binIds[1])
@@ -822,13 +1119,14 @@ void vtkQuadricClustering::AddVertex(vtkIdType binId, double *pt,
 
   // If the current quadric is from triangles, edges (or not initialized),
   // then clear it out.
-  if (this->QuadricArray[binId].Dimension > 0)
+  PointQuadric *bin = this->GetBin(binId);
+  if (bin->Dimension > 0)
   {
-    this->QuadricArray[binId].Dimension = 0;
+    bin->Dimension = 0;
     // Initialize the coeff
-    this->InitializeQuadric(this->QuadricArray[binId].Quadric);
+    this->InitializeQuadric(bin->Quadric);
   }
-  if (this->QuadricArray[binId].Dimension == 0)
+  if (bin->Dimension == 0)
   { // Points supersede all other types of quadrics.
     this->AddQuadric(binId, q);
   }
@@ -837,9 +1135,9 @@ void vtkQuadricClustering::AddVertex(vtkIdType binId, double *pt,
   {
     // Now add the vert to the geometry.
     // Get the vertex from the bin.
-    if (this->QuadricArray[binId].VertexId == -1)
+    if (bin->VertexId == -1)
     {
-      this->QuadricArray[binId].VertexId = this->NumberOfBinsUsed;
+      bin->VertexId = this->NumberOfBinsUsed;
       this->NumberOfBinsUsed++;
 
       if (this->CopyCellData && input)
@@ -855,7 +1153,7 @@ void vtkQuadricClustering::AddVertex(vtkIdType binId, double *pt,
 //----------------------------------------------------------------------------
 void vtkQuadricClustering::AddQuadric(vtkIdType binId, double quadric[9])
 {
-  double *q = this->QuadricArray[binId].Quadric;
+  double *q = this->GetBin(binId)->Quadric;
 
   for (int i=0; i<9; i++)
   {
@@ -863,6 +1161,30 @@ void vtkQuadricClustering::AddQuadric(vtkIdType binId, double quadric[9])
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkQuadricClustering::MergeBins()
+{
+  if (!this->SparseBins)
+  {
+    return;
+  }
+
+  SparseBinMap::MapType &bins = this->SparseBins->Bins;
+  vtkSMPThreadLocal<SparseBinMap::MapType>::iterator localIter;
+  for (localIter = this->SparseBins->LocalBins.begin();
+       localIter != this->SparseBins->LocalBins.end(); ++localIter)
+  {
+    for (SparseBinMap::MapType::iterator it = localIter->begin();
+         it != localIter->end(); ++it)
+    {
+      SparseBinMap::Accumulate(bins[it->first], it->second.Dimension,
+                               it->second.Quadric);
+    }
+    // Release the memory of the thread bins.
+    SparseBinMap::MapType().swap(*localIter);
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkIdType vtkQuadricClustering::HashPoint(double point[3])
 {
@@ -949,7 +1271,29 @@ void vtkQuadricClustering::EndAppend()
 
   // Compute the representative points for each bin
   outputPoints = vtkPoints::New();
-  for (vtkIdType i = 0; !abortExecute && i < numBuckets; i++ )
+  if (this->SparseBins)
+  {
+    this->MergeBins();
+    outputPoints->SetNumberOfPoints(this->NumberOfBinsUsed);
+    SparseBinMap::MapType::iterator it;
+    for (it = this->SparseBins->Bins.begin();
+         !abortExecute && it != this->SparseBins->Bins.end(); ++it)
+    {
+      if (cstep > step)
+      {
+        cstep = 0;
+        abortExecute = this->GetAbortExecute();
+      }
+      ++cstep;
+
+      if (it->second.VertexId != -1)
+      {
+        this->ComputeRepresentativePoint(it->second.Quadric, it->first, newPt);
+        outputPoints->SetPoint(it->second.VertexId, newPt);
+      }
+    }
+  }
+  for (vtkIdType i = 0; this->QuadricArray && !abortExecute && i < numBuckets; i++ )
   {
     if (cstep > step)
     {
@@ -994,6 +1338,8 @@ void vtkQuadricClustering::EndAppend()
   // Free the quadric array.
   delete [] this->QuadricArray;
   this->QuadricArray = nullptr;
+  delete this->SparseBins;
+  this->SparseBins = nullptr;
 }
 
 
@@ -1239,10 +1585,11 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
   vtkIdType   outPtId;
   vtkPoints   *inputPoints;
   vtkPoints   *outputPoints;
-  vtkIdType   numPoints, numBins;
+  vtkIdType   numPoints;
   vtkIdType   binId;
-  double       *minError, e, pt[3];
+  double       e, pt[3];
   double       *q;
+  PointQuadric *bin;
 
   inputPoints = input->GetPoints();
   if (inputPoints == nullptr)
@@ -1270,14 +1617,9 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
   output->GetPointData()->
     CopyAllocate(input->GetPointData(), this->NumberOfBinsUsed);
 
-  // Allocate and initialize an array to hold errors for each bin.
-  numBins = this->NumberOfDivisions[0] * this->NumberOfDivisions[1]
-                  * this->NumberOfDivisions[2];
-  minError = new double[numBins];
-  for (vtkIdType i = 0; i < numBins; ++i)
-  {
-    minError[i] = VTK_DOUBLE_MAX;
-  }
+  // Allocate and initialize an array to hold errors for each used bin.
+  this->MergeBins();
+  std::vector<double> minError(this->NumberOfBinsUsed, VTK_DOUBLE_MAX);
 
   // Loop through the input points.
   numPoints = inputPoints->GetNumberOfPoints();
@@ -1285,7 +1627,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
   {
     inputPoints->GetPoint(i, pt);
     binId = this->HashPoint(pt);
-    outPtId = this->QuadricArray[binId].VertexId;
+    bin = this->FindBin(binId);
+    outPtId = bin ? bin->VertexId : -1;
     // Sanity check.
     if (outPtId == -1)
     {
@@ -1298,13 +1641,13 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
     // Compute the error for this point.  Note: the constant term is ignored.
     // It will be the same for every point in this bin, and it
     // is not stored in the quadric array anyway.
-    q = this->QuadricArray[binId].Quadric;
+    q = bin->Quadric;
     e = q[0]*pt[0]*pt[0] + 2.0*q[1]*pt[0]*pt[1] + 2.0*q[2]*pt[0]*pt[2] + 2.0*q[3]*pt[0]
           + q[4]*pt[1]*pt[1] + 2.0*q[5]*pt[1]*pt[2] + 2.0*q[6]*pt[1]
           + q[7]*pt[2]*pt[2] + 2.0*q[8]*pt[2];
-    if (e < minError[binId])
+    if (e < minError[outPtId])
     {
-      minError[binId] = e;
+      minError[outPtId] = e;
       outputPoints->InsertPoint(outPtId, pt);
 
       // Since this is the same point as the input point, copy point data here too.
@@ -1329,8 +1672,8 @@ void vtkQuadricClustering::EndAppendUsingPoints(vtkPolyData *input,
 
   delete [] this->QuadricArray;
   this->QuadricArray = nullptr;
-
-  delete [] minError;
+  delete this->SparseBins;
+  this->SparseBins = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -1349,6 +1692,12 @@ void vtkQuadricClustering::EndAppendVertexGeometry(vtkPolyData *input,
   vtkIdType outPtId;
   vtkIdType binId, cellId, outCellId;
 
+  // There is no input when the append methods are called directly.
+  if (!input)
+  {
+    return;
+  }
+
   inVerts = input->GetVerts();
   outVerts = vtkCellArray::New();
 
@@ -1365,11 +1714,12 @@ void vtkQuadricClustering::EndAppendVertexGeometry(vtkPolyData *input,
     {
       input->GetPoint(ptIds[j], pt);
       binId = this->HashPoint(pt);
-      outPtId = this->QuadricArray[binId].VertexId;
+      PointQuadric *bin = this->FindBin(binId);
+      outPtId = bin ? bin->VertexId : -1;
       if (outPtId >= 0)
       {
         // Do not use this point.  Destroy infomration in Quadric array.
-        this->QuadricArray[binId].VertexId = -1;
+        bin->VertexId = -1;
         tmp[tmpIdx] = outPtId;
         ++tmpIdx;
       }
@@ -1581,5 +1931,7 @@ void vtkQuadricClustering::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Prevent Duplicate Cells : "
      << (this->PreventDuplicateCells ? "On\n" : "Off\n");
+  os << indent << "Parallel Accumulation: "
+     << (this->ParallelAccumulation ? "On\n" : "Off\n");
 }
 
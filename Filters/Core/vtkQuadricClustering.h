@@ -59,6 +59,14 @@
  * manual control, it has the advantage that extremely large data can be
  * processed in pieces and appended to the filter piece-by-piece.
  *
+ * When ParallelAccumulation is on, the quadrics of the triangles of the
+ * polygons and triangle strips are accumulated in parallel into one sparse
+ * map of bins per thread, and the maps are merged by EndAppend. The bins
+ * are then only stored when they are used, so the memory grows with the
+ * size of the output rather than with the number of divisions. Combined
+ * with the append methods, this allows fine binnings of surfaces that are
+ * streamed through the filter in pieces.
+ *
  * @warning
  * This filter can drastically affect topology, i.e., topology is not
  * preserved.
@@ -255,6 +263,19 @@ public:
   vtkBooleanMacro(PreventDuplicateCells,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * When this flag is on, the quadrics of the triangles of the polygons and
+   * triangle strips are computed and accumulated in parallel, and the bins
+   * are stored in sparse maps rather than in a dense array. The output is
+   * the same as the serial one, up to the rounding of the sums of the
+   * quadrics. This is off by default.
+   */
+  vtkSetMacro(ParallelAccumulation, vtkTypeBool);
+  vtkGetMacro(ParallelAccumulation, vtkTypeBool);
+  vtkBooleanMacro(ParallelAccumulation, vtkTypeBool);
+  //@}
+
 protected:
   vtkQuadricClustering();
   ~vtkQuadricClustering() override;
@@ -284,8 +305,19 @@ protected:
                  vtkPolyData *input, vtkPolyData *output);
   void AddTriangle(vtkIdType *binIds, double *pt0, double *pt1, double *pt2,
                    int geometeryFlag, vtkPolyData *input, vtkPolyData *output);
+  void AddTriangleGeometry(vtkIdType *binIds, vtkPolyData *input,
+                           vtkPolyData *output);
   //@}
 
+  /**
+   * Add the triangles of polygons (or of triangle strips when strips is
+   * on) to the output, accumulating their quadrics in parallel into the
+   * sparse bins of each thread.
+   */
+  void AddTrianglesInParallel(vtkCellArray *cells, bool strips,
+                              vtkPoints *points, vtkPolyData *input,
+                              vtkPolyData *output);
+
   //@{
   /**
    * Add edges to the quadric array.  If geometry flag is on then
@@ -319,6 +351,11 @@ protected:
    */
   void AddQuadric(vtkIdType binId, double quadric[9]);
 
+  /**
+   * Merge the sparse bins accumulated by each thread into the shared ones.
+   */
+  void MergeBins();
+
   /**
    * Find the feature points of a given set of edges.
    * The points returned are (1) those used by only one edge, (2) those
@@ -391,8 +428,20 @@ protected:
     double Quadric[9];
   };
 
+  /**
+   * Return the bin with the given id, creating it when the bins are
+   * sparse. FindBin returns nullptr for sparse bins that are not used.
+   */
+  PointQuadric* GetBin(vtkIdType binId);
+  PointQuadric* FindBin(vtkIdType binId);
+
+  struct SparseBinMap;
+  struct TriangleAccumulator;
+
   PointQuadric* QuadricArray;
+  SparseBinMap* SparseBins; // used instead of QuadricArray in parallel
   vtkIdType NumberOfBinsUsed;
+  vtkTypeBool ParallelAccumulation;
 
   // Have to make these instance variables if we are going to allow
   // the algorithm to be driven by the Append methods.
@@ -53,10 +53,465 @@
 #include "vtkPolyData.h"
 #include "vtkPointData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <atomic> // for the claims of the parallel collapses
+#include <cmath>
+#include <memory>
+#include <vector>
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
+namespace
+{
+// Gather the sorted ids, greater than ptId, of the points sharing a
+// triangle with ptId.
+void GetUpperNeighbors(vtkPolyData *mesh, vtkIdType ptId,
+                       std::vector<vtkIdType> &neighbors)
+{
+  unsigned short ncells, i;
+  vtkIdType *cells, npts, *pts, j;
+
+  neighbors.clear();
+  mesh->GetPointCells(ptId, ncells, cells);
+  for (i = 0; i < ncells; i++)
+  {
+    mesh->GetCellPoints(cells[i], npts, pts);
+    for (j = 0; j < npts; j++)
+    {
+      if (pts[j] > ptId)
+      {
+        neighbors.push_back(pts[j]);
+      }
+    }
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+                  neighbors.end());
+}
+
+// Call visit on every point of the triangles around ptId. Stop and return
+// false as soon as visit does.
+template <typename Visitor>
+bool VisitTrianglePoints(vtkPolyData *mesh, vtkIdType ptId, Visitor &visit)
+{
+  unsigned short ncells, i;
+  vtkIdType *cells, npts, *pts, j;
+
+  mesh->GetPointCells(ptId, ncells, cells);
+  for (i = 0; i < ncells; i++)
+  {
+    mesh->GetCellPoints(cells[i], npts, pts);
+    for (j = 0; j < npts; j++)
+    {
+      if (!visit(pts[j]))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Visit the points a collapse of the edge touches, the points of the
+// triangles around both of its end points.
+template <typename Visitor>
+bool VisitCollapsePoints(vtkPolyData *mesh, vtkIdType pt0Id,
+                         vtkIdType pt1Id, Visitor &visit)
+{
+  return VisitTrianglePoints(mesh, pt0Id, visit) &&
+    VisitTrianglePoints(mesh, pt1Id, visit);
+}
+
+// The edges from a point to its neighbors with a greater id, with their
+// collapse cost and target point. They are kept from one round to the next
+// and only updated for the points a round touched.
+struct BatchPointEdges
+{
+  std::vector<vtkIdType> Neighbors;
+  std::vector<double> Costs;
+  std::vector<double> Targets;
+};
+
+// An edge with a finite cost, the Index-th edge of point PtId.
+struct BatchCandidate
+{
+  double Cost;
+  vtkIdType PtId;
+  vtkIdType Index;
+
+  bool operator<(const BatchCandidate &other) const
+  {
+    return this->Cost < other.Cost ||
+      (this->Cost == other.Cost &&
+       (this->PtId < other.PtId ||
+        (this->PtId == other.PtId && this->Index < other.Index)));
+  }
+};
+
+// Gather the candidate edges of all points and count the edges.
+struct GatherBatchCandidates
+{
+  const std::vector<BatchPointEdges> &Edges;
+  vtkSMPThreadLocal<std::vector<BatchCandidate> > LocalCandidates;
+  vtkSMPThreadLocal<vtkIdType> LocalNumberOfEdges;
+  std::vector<BatchCandidate> Candidates;
+  vtkIdType NumberOfEdges;
+
+  GatherBatchCandidates(const std::vector<BatchPointEdges> &edges)
+    : Edges(edges), NumberOfEdges(0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalCandidates.Local().clear();
+    this->LocalNumberOfEdges.Local() = 0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<BatchCandidate> &candidates = this->LocalCandidates.Local();
+    vtkIdType &numEdges = this->LocalNumberOfEdges.Local();
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      const std::vector<double> &costs = this->Edges[ptId].Costs;
+      numEdges += static_cast<vtkIdType>(costs.size());
+      for (size_t i = 0; i < costs.size(); ++i)
+      {
+        if (costs[i] < VTK_DOUBLE_MAX)
+        {
+          BatchCandidate candidate = {costs[i], ptId,
+                                      static_cast<vtkIdType>(i)};
+          candidates.push_back(candidate);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->Candidates.clear();
+    this->NumberOfEdges = 0;
+    vtkSMPThreadLocal<std::vector<BatchCandidate> >::iterator it;
+    for (it = this->LocalCandidates.begin();
+         it != this->LocalCandidates.end(); ++it)
+    {
+      this->Candidates.insert(this->Candidates.end(), it->begin(), it->end());
+    }
+    vtkSMPThreadLocal<vtkIdType>::iterator nit;
+    for (nit = this->LocalNumberOfEdges.begin();
+         nit != this->LocalNumberOfEdges.end(); ++nit)
+    {
+      this->NumberOfEdges += *nit;
+    }
+  }
+};
+
+// Gather the distinct points each collapse of Ranks touches into Points,
+// from Offsets[slot], which leaves room for 3 points per triangle around the
+// end points, and count them into Counts[slot].
+struct GatherCollapsePoints
+{
+  vtkPolyData *Mesh;
+  const std::vector<BatchCandidate> &Candidates;
+  const std::vector<BatchPointEdges> &Edges;
+  const std::vector<vtkIdType> &Ranks;
+  const std::vector<vtkIdType> &Offsets;
+  std::vector<vtkIdType> &Counts;
+  std::vector<vtkIdType> &Points;
+  // the last slot which gathered each point, to skip the duplicates
+  vtkSMPThreadLocal<std::vector<vtkIdType> > LocalVisits;
+
+  GatherCollapsePoints(vtkPolyData *mesh,
+                       const std::vector<BatchCandidate> &candidates,
+                       const std::vector<BatchPointEdges> &edges,
+                       const std::vector<vtkIdType> &ranks,
+                       const std::vector<vtkIdType> &offsets,
+                       std::vector<vtkIdType> &counts,
+                       std::vector<vtkIdType> &points)
+    : Mesh(mesh), Candidates(candidates), Edges(edges), Ranks(ranks),
+      Offsets(offsets), Counts(counts), Points(points)
+  {
+  }
+
+  void Initialize()
+  {
+    std::vector<vtkIdType> &visits = this->LocalVisits.Local();
+    if (visits.empty())
+    {
+      visits.assign(this->Mesh->GetNumberOfPoints(), -1);
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkIdType> &visits = this->LocalVisits.Local();
+    for (vtkIdType slot = begin; slot < end; ++slot)
+    {
+      const BatchCandidate &candidate = this->Candidates[this->Ranks[slot]];
+      vtkIdType *points = &this->Points[0] + this->Offsets[slot];
+      vtkIdType count = 0;
+      // the ranks are unique, unlike the slots of different chunks
+      vtkIdType rank = this->Ranks[slot];
+      auto gather = [&visits, rank, points, &count](vtkIdType ptId)
+      {
+        if (visits[ptId] != rank)
+        {
+          visits[ptId] = rank;
+          points[count++] = ptId;
+        }
+        return true;
+      };
+      VisitCollapsePoints(this->Mesh, candidate.PtId,
+        this->Edges[candidate.PtId].Neighbors[candidate.Index], gather);
+      this->Counts[slot] = count;
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+// Update the edges of the points touched by the previous round, from each
+// point to its neighbors with a greater id, with their collapse cost and
+// target point. Only the edges from or to a point whose quadric changed
+// (marked 2, the kept point of a collapse, or every point for the first
+// round) get a new cost; the costs of the other edges, including the
+// VTK_DOUBLE_MAX of the edges which failed the placement check, are kept.
+struct vtkQuadricDecimation::BatchEdgeBuilder
+{
+  struct LocalData
+  {
+    BatchPointEdges Previous;
+    std::vector<double> Quad;
+    std::vector<double> B;
+    std::vector<double> Data;
+    std::vector<double*> A;
+  };
+
+  vtkQuadricDecimation *Self;
+  int Dimension;
+  const std::vector<vtkIdType> &PointIds;
+  const std::vector<unsigned char> &Marks;
+  std::vector<BatchPointEdges> &Edges;
+  vtkSMPThreadLocal<LocalData> Locals;
+
+  BatchEdgeBuilder(vtkQuadricDecimation *self, int dimension,
+                   const std::vector<vtkIdType> &ptIds,
+                   const std::vector<unsigned char> &marks,
+                   std::vector<BatchPointEdges> &edges)
+    : Self(self), Dimension(dimension), PointIds(ptIds), Marks(marks),
+      Edges(edges)
+  {
+  }
+
+  void Initialize()
+  {
+    LocalData &local = this->Locals.Local();
+    int n = this->Dimension;
+    local.Quad.resize(11 + 4 * this->Self->NumberOfComponents +
+                      this->Self->VolumePreservation);
+    local.B.resize(n);
+    local.Data.resize(n * n);
+    local.A.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+      local.A[i] = &local.Data[i * n];
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData &local = this->Locals.Local();
+    BatchPointEdges &previous = local.Previous;
+    vtkQuadricDecimation *self = this->Self;
+    int n = this->Dimension;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkIdType ptId = this->PointIds[i];
+      BatchPointEdges &edges = this->Edges[ptId];
+      std::swap(previous, edges);
+      GetUpperNeighbors(self->Mesh, ptId, edges.Neighbors);
+      edges.Costs.resize(edges.Neighbors.size());
+      edges.Targets.resize(edges.Neighbors.size() * n);
+      for (size_t j = 0; j < edges.Neighbors.size(); ++j)
+      {
+        vtkIdType nbrId = edges.Neighbors[j];
+        double *x = &edges.Targets[j * n];
+        if (this->Marks[ptId] != 2 && this->Marks[nbrId] != 2)
+        {
+          std::vector<vtkIdType>::iterator it = std::lower_bound(
+            previous.Neighbors.begin(), previous.Neighbors.end(), nbrId);
+          if (it != previous.Neighbors.end() && *it == nbrId)
+          {
+            size_t k = it - previous.Neighbors.begin();
+            edges.Costs[j] = previous.Costs[k];
+            std::copy(&previous.Targets[k * n],
+                      &previous.Targets[k * n] + n, x);
+            continue;
+          }
+        }
+        if (self->AttributeErrorMetric)
+        {
+          edges.Costs[j] = self->ComputeCost2(ptId, nbrId, x, &local.Quad[0],
+                                              &local.A[0], &local.B[0]);
+        }
+        else
+        {
+          edges.Costs[j] = self->ComputeCost(ptId, nbrId, x, &local.Quad[0]);
+        }
+      }
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+//----------------------------------------------------------------------------
+// Select, among the sorted candidates, the collapses whose points do not
+// overlap and which pass the placement check. The selection is the same as
+// visiting the candidates in cost order and keeping those which pass the
+// check and do not overlap one kept before, and does not depend on the
+// number of threads. Each pass visits the undecided candidates in parallel:
+// - Claim: every candidate lowers the claim of the points its collapse
+//   touches to its rank.
+// - Select: a candidate which won all its points has no cheaper undecided
+//   candidate overlapping it. It is selected and locks its points if its
+//   target point passes the placement check; otherwise its cost is set to
+//   VTK_DOUBLE_MAX, as the serial decimation does.
+// - Drop: the claims are reset and the candidates which were decided or
+//   touch a locked point are removed from the undecided ones.
+struct vtkQuadricDecimation::BatchCollapseSelector
+{
+  enum PassType
+  {
+    CLAIM,
+    SELECT,
+    DROP
+  };
+  enum StateType
+  {
+    UNDECIDED = 0,
+    SELECTED,
+    REJECTED
+  };
+
+  vtkQuadricDecimation *Self;
+  int Dimension;
+  const std::vector<BatchCandidate> &Candidates;
+  std::vector<BatchPointEdges> &Edges;
+  // the ranks of the candidates of the current chunk and the points their
+  // collapses touch, see GatherCollapsePoints
+  const std::vector<vtkIdType> &Ranks;
+  const std::vector<vtkIdType> &Offsets;
+  const std::vector<vtkIdType> &Counts;
+  const std::vector<vtkIdType> &Points;
+  std::atomic<vtkIdType> *Claims;
+  // the points locked by this round are set to Stamp
+  std::vector<int> &Locks;
+  int Stamp;
+  std::vector<unsigned char> &States;
+  // the slots of the undecided candidates, and whether they stay undecided
+  const std::vector<vtkIdType> &Undecided;
+  std::vector<unsigned char> &Keep;
+  PassType Pass;
+
+  BatchCollapseSelector(vtkQuadricDecimation *self, int dimension,
+                        const std::vector<BatchCandidate> &candidates,
+                        std::vector<BatchPointEdges> &edges,
+                        const std::vector<vtkIdType> &ranks,
+                        const std::vector<vtkIdType> &offsets,
+                        const std::vector<vtkIdType> &counts,
+                        const std::vector<vtkIdType> &points,
+                        std::atomic<vtkIdType> *claims,
+                        std::vector<int> &locks, int stamp,
+                        std::vector<unsigned char> &states,
+                        const std::vector<vtkIdType> &undecided,
+                        std::vector<unsigned char> &keep)
+    : Self(self), Dimension(dimension), Candidates(candidates), Edges(edges),
+      Ranks(ranks), Offsets(offsets), Counts(counts), Points(points), Claims(claims),
+      Locks(locks), Stamp(stamp), States(states), Undecided(undecided),
+      Keep(keep), Pass(CLAIM)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType i, j, ptId, current;
+    for (i = begin; i < end; ++i)
+    {
+      vtkIdType slot = this->Undecided[i];
+      vtkIdType rank = this->Ranks[slot];
+      const vtkIdType *first = &this->Points[0] + this->Offsets[slot];
+      const vtkIdType *last = first + this->Counts[slot];
+      if (this->Pass == CLAIM)
+      {
+        for (; first != last; ++first)
+        {
+          std::atomic<vtkIdType> &claim = this->Claims[*first];
+          current = claim.load(std::memory_order_relaxed);
+          while (rank < current &&
+                 !claim.compare_exchange_weak(current, rank,
+                                              std::memory_order_relaxed))
+          {
+          }
+        }
+      }
+      else if (this->Pass == SELECT)
+      {
+        const vtkIdType *pt = first;
+        while (pt != last &&
+               this->Claims[*pt].load(std::memory_order_relaxed) == rank)
+        {
+          ++pt;
+        }
+        if (pt != last)
+        {
+          continue;
+        }
+        const BatchCandidate &candidate = this->Candidates[rank];
+        BatchPointEdges &edges = this->Edges[candidate.PtId];
+        j = candidate.Index;
+        if (!this->Self->IsGoodPlacement(candidate.PtId, edges.Neighbors[j],
+                                         &edges.Targets[j * this->Dimension]))
+        {
+          edges.Costs[j] = VTK_DOUBLE_MAX;
+          this->States[rank] = REJECTED;
+          continue;
+        }
+        // the points of the selected collapses do not overlap
+        this->States[rank] = SELECTED;
+        for (; first != last; ++first)
+        {
+          this->Locks[*first] = this->Stamp;
+        }
+      }
+      else
+      {
+        this->Keep[i] = this->States[rank] == UNDECIDED;
+        for (; first != last; ++first)
+        {
+          ptId = *first;
+          this->Claims[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+          if (this->Locks[ptId] == this->Stamp)
+          {
+            this->Keep[i] = 0;
+          }
+        }
+      }
+    }
+  }
+};
+
 
 //----------------------------------------------------------------------------
 vtkQuadricDecimation::vtkQuadricDecimation()
@@ -87,6 +542,9 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TCoordsWeight = 0.1;
   this->TensorsWeight = 0.1;
 
+  this->ParallelDecimation = 0;
+  this->BatchFraction = 0.25;
+
   this->ActualReduction = 0.0;
 }
 
@@ -251,24 +709,28 @@ int vtkQuadricDecimation::RequestData(
     }
   }
 
-  vtkDebugMacro(<<"Computing Edges");
-  this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
-  this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
-  for (i = 0; i <  this->Mesh->GetNumberOfCells(); i++)
+  // The parallel decimation computes its own edges in each round
+  if (!this->ParallelDecimation)
   {
-    this->Mesh->GetCellPoints(i, npts, pts);
-
-    for (j = 0; j < 3; j++)
+    vtkDebugMacro(<<"Computing Edges");
+    this->Edges->InitEdgeInsertion(numPts, 1); // storing edge id as attribute
+    this->EdgeCosts->Allocate(this->Mesh->GetPolys()->GetNumberOfCells() * 3);
+    for (i = 0; i <  this->Mesh->GetNumberOfCells(); i++)
     {
-      if (this->Edges->IsEdge(pts[j], pts[(j+1)%3]) == -1)
+      this->Mesh->GetCellPoints(i, npts, pts);
+
+      for (j = 0; j < 3; j++)
       {
-        // If this edge has not been processed, get an id for it, add it to
-        // the edge list (Edges), and add its endpoints to the EndPoint1List
-        // and EndPoint2List (the 2 endpoints to different lists).
-        edgeId = this->Edges->GetNumberOfEdges();
-        this->Edges->InsertEdge(pts[j], pts[(j+1)%3], edgeId);
-        this->EndPoint1List->InsertId(edgeId, pts[j]);
-        this->EndPoint2List->InsertId(edgeId, pts[(j+1)%3]);
+        if (this->Edges->IsEdge(pts[j], pts[(j+1)%3]) == -1)
+        {
+          // If this edge has not been processed, get an id for it, add it to
+          // the edge list (Edges), and add its endpoints to the EndPoint1List
+          // and EndPoint2List (the 2 endpoints to different lists).
+          edgeId = this->Edges->GetNumberOfEdges();
+          this->Edges->InsertEdge(pts[j], pts[(j+1)%3], edgeId);
+          this->EndPoint1List->InsertId(edgeId, pts[j]);
+          this->EndPoint2List->InsertId(edgeId, pts[(j+1)%3]);
+        }
       }
     }
   }
@@ -299,71 +761,79 @@ int vtkQuadricDecimation::RequestData(
   this->AddBoundaryConstraints();
   this->UpdateProgress(0.15);
 
-  vtkDebugMacro(<<"Computing Costs");
-  // Compute the cost of and target point for collapsing each edge.
-  for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
-  {
-    if (this->AttributeErrorMetric)
-    {
-      cost = this->ComputeCost2(i, x);
-    }
-    else
-    {
-      cost = this->ComputeCost(i, x);
-    }
-    this->EdgeCosts->Insert(cost, i);
-    this->TargetPoints->InsertTuple(i, x);
-  }
-  this->UpdateProgress(0.20);
-
-  // Okay collapse edges until desired reduction is reached
   this->ActualReduction = 0.0;
   this->NumberOfEdgeCollapses = 0;
-  edgeId = this->EdgeCosts->Pop(0,cost);
-
-  int abort = 0;
-  while ( !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
-         this->ActualReduction < this->TargetReduction )
+  if (this->ParallelDecimation)
   {
-    if ( ! (this->NumberOfEdgeCollapses % 10000) )
+    numDeletedTris = this->CollapseEdgesInBatches(numTris);
+    cost = 0.0;
+  }
+  else
+  {
+    vtkDebugMacro(<<"Computing Costs");
+    // Compute the cost of and target point for collapsing each edge.
+    for (i = 0; i < this->Edges->GetNumberOfEdges(); i++)
     {
-      vtkDebugMacro(<<"Collapsing edge#" << this->NumberOfEdgeCollapses);
-      this->UpdateProgress (0.20 + 0.80*this->NumberOfEdgeCollapses/numPts);
-      abort = this->GetAbortExecute();
+      if (this->AttributeErrorMetric)
+      {
+        cost = this->ComputeCost2(i, x);
+      }
+      else
+      {
+        cost = this->ComputeCost(i, x);
+      }
+      this->EdgeCosts->Insert(cost, i);
+      this->TargetPoints->InsertTuple(i, x);
     }
+    this->UpdateProgress(0.20);
 
-    endPtIds[0] = this->EndPoint1List->GetId(edgeId);
-    endPtIds[1] = this->EndPoint2List->GetId(edgeId);
-    this->TargetPoints->GetTuple(edgeId, x);
+    // Okay collapse edges until desired reduction is reached
+    edgeId = this->EdgeCosts->Pop(0,cost);
 
-    // check for a poorly placed point
-    if ( !this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+    int abort = 0;
+    while ( !abort && edgeId >= 0 && cost < VTK_DOUBLE_MAX &&
+           this->ActualReduction < this->TargetReduction )
     {
-      vtkDebugMacro(<<"Poor placement detected " << edgeId << " " <<  cost);
-      // return the point to the queue but with the max cost so that
-      // when it is recomputed it will be reconsidered
-      this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
+      if ( ! (this->NumberOfEdgeCollapses % 10000) )
+      {
+        vtkDebugMacro(<<"Collapsing edge#" << this->NumberOfEdgeCollapses);
+        this->UpdateProgress (0.20 + 0.80*this->NumberOfEdgeCollapses/numPts);
+        abort = this->GetAbortExecute();
+      }
 
-      edgeId = this->EdgeCosts->Pop(0, cost);
-      continue;
-    }
+      endPtIds[0] = this->EndPoint1List->GetId(edgeId);
+      endPtIds[1] = this->EndPoint2List->GetId(edgeId);
+      this->TargetPoints->GetTuple(edgeId, x);
 
-    this->NumberOfEdgeCollapses++;
+      // check for a poorly placed point
+      if ( !this->IsGoodPlacement(endPtIds[0], endPtIds[1], x))
+      {
+        vtkDebugMacro(<<"Poor placement detected " << edgeId << " " <<  cost);
+        // return the point to the queue but with the max cost so that
+        // when it is recomputed it will be reconsidered
+        this->EdgeCosts->Insert(VTK_DOUBLE_MAX, edgeId);
 
-    // Set the new coordinates of point0.
-    this->SetPointAttributeArray(endPtIds[0], x);
-    vtkDebugMacro(<<"Cost: " << cost << " Edge: "
-                  << endPtIds[0] << " " << endPtIds[1]);
+        edgeId = this->EdgeCosts->Pop(0, cost);
+        continue;
+      }
+
+      this->NumberOfEdgeCollapses++;
 
-    // Merge the quadrics of the two points.
-    this->AddQuadric(endPtIds[1], endPtIds[0]);
+      // Set the new coordinates of point0.
+      this->SetPointAttributeArray(endPtIds[0], x);
+      vtkDebugMacro(<<"Cost: " << cost << " Edge: "
+                    << endPtIds[0] << " " << endPtIds[1]);
 
-    this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+      // Merge the quadrics of the two points.
+      this->AddQuadric(endPtIds[1], endPtIds[0]);
 
-    // Update the output triangles.
-    numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
-    this->ActualReduction = (double) numDeletedTris / numTris;
-    edgeId = this->EdgeCosts->Pop(0, cost);
+      this->UpdateEdgeData(endPtIds[0], endPtIds[1]);
+
+      // Update the output triangles.
+      numDeletedTris += this->CollapseEdge(endPtIds[0], endPtIds[1]);
+      this->ActualReduction = (double) numDeletedTris / numTris;
+      edgeId = this->EdgeCosts->Pop(0, cost);
+    }
   }
 
   vtkDebugMacro(<<"Number Of Edge Collapses: "
@@ -420,6 +890,181 @@ int vtkQuadricDecimation::RequestData(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkQuadricDecimation::CollapseEdgesInBatches(vtkIdType numTris)
+{
+  vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+  int dimension = 3 + this->NumberOfComponents + this->VolumePreservation;
+  vtkIdType numDeletedTris = 0;
+  vtkIdType ptId, nbrId, rank, j, numCandidates, numUndecided;
+  vtkIdType chunk, chunkSize;
+  unsigned short ncells0, ncells1;
+  vtkIdType *cells;
+  size_t i;
+  int round = 0;
+
+  std::vector<BatchPointEdges> edges(numPts);
+  // the points whose edges are updated and their marks, see
+  // BatchEdgeBuilder
+  std::vector<vtkIdType> updated(numPts);
+  std::vector<unsigned char> marks(numPts, 2);
+  std::vector<vtkIdType> ranks, offsets, counts, points, undecided;
+  std::vector<unsigned char> states, keep;
+  std::vector<int> locks(numPts, 0);
+  std::unique_ptr<std::atomic<vtkIdType>[]> claims(
+    new std::atomic<vtkIdType>[numPts]);
+  GatherBatchCandidates gatherer(edges);
+  std::vector<BatchCandidate> &candidates = gatherer.Candidates;
+
+  if (numTris == 0)
+  {
+    return 0;
+  }
+  for (ptId = 0; ptId < numPts; ptId++)
+  {
+    updated[ptId] = ptId;
+    claims[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+  }
+
+  while (this->ActualReduction < this->TargetReduction &&
+         !this->GetAbortExecute())
+  {
+    vtkDebugMacro(<<"Collapse round " << round << " with "
+                  << this->NumberOfEdgeCollapses << " edges collapsed");
+
+    // Update the edges of the points touched by the previous round, or of
+    // all the points for the first one
+    BatchEdgeBuilder builder(this, dimension, updated, marks, edges);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(updated.size()), builder);
+    for (i = 0; i < updated.size(); i++)
+    {
+      marks[updated[i]] = 0;
+    }
+
+    // Sort the cheapest edges
+    vtkSMPTools::For(0, numPts, gatherer);
+    numCandidates = static_cast<vtkIdType>(
+      std::ceil(this->BatchFraction * gatherer.NumberOfEdges));
+    numCandidates = std::max(numCandidates, static_cast<vtkIdType>(1));
+    numCandidates = std::min(numCandidates,
+                             static_cast<vtkIdType>(candidates.size()));
+    if (numCandidates == 0)
+    {
+      break;
+    }
+    if (numCandidates < static_cast<vtkIdType>(candidates.size()))
+    {
+      std::nth_element(candidates.begin(),
+                       candidates.begin() + numCandidates, candidates.end());
+      candidates.resize(numCandidates);
+    }
+    vtkSMPTools::Sort(candidates.begin(), candidates.end());
+
+    // Select the collapses in parallel, by chunks of candidates in cost
+    // order. The candidates with an end point locked by the previous chunks
+    // are dropped before gathering their points.
+    states.assign(numCandidates, BatchCollapseSelector::UNDECIDED);
+    GatherCollapsePoints collapsePoints(this->Mesh, candidates, edges, ranks,
+                                        offsets, counts, points);
+    BatchCollapseSelector selector(this, dimension, candidates, edges, ranks,
+                                   offsets, counts, points, claims.get(),
+                                   locks, round + 1, states, undecided, keep);
+    chunkSize = std::max(numCandidates / 16, static_cast<vtkIdType>(1024));
+    for (chunk = 0; chunk < numCandidates; chunk += chunkSize)
+    {
+      ranks.clear();
+      offsets.assign(1, 0);
+      for (rank = chunk; rank < std::min(chunk + chunkSize, numCandidates);
+           rank++)
+      {
+        ptId = candidates[rank].PtId;
+        nbrId = edges[ptId].Neighbors[candidates[rank].Index];
+        if (locks[ptId] == round + 1 || locks[nbrId] == round + 1)
+        {
+          continue;
+        }
+        this->Mesh->GetPointCells(ptId, ncells0, cells);
+        this->Mesh->GetPointCells(nbrId, ncells1, cells);
+        ranks.push_back(rank);
+        offsets.push_back(offsets.back() + 3 * (ncells0 + ncells1));
+      }
+      numUndecided = static_cast<vtkIdType>(ranks.size());
+      counts.resize(numUndecided);
+      points.resize(offsets.back());
+      vtkSMPTools::For(0, numUndecided, collapsePoints);
+
+      undecided.resize(numUndecided);
+      for (j = 0; j < numUndecided; j++)
+      {
+        undecided[j] = j;
+      }
+      while (!undecided.empty())
+      {
+        numUndecided = static_cast<vtkIdType>(undecided.size());
+        keep.resize(numUndecided);
+        selector.Pass = BatchCollapseSelector::CLAIM;
+        vtkSMPTools::For(0, numUndecided, selector);
+        selector.Pass = BatchCollapseSelector::SELECT;
+        vtkSMPTools::For(0, numUndecided, selector);
+        selector.Pass = BatchCollapseSelector::DROP;
+        vtkSMPTools::For(0, numUndecided, selector);
+        numUndecided = 0;
+        for (i = 0; i < keep.size(); i++)
+        {
+          if (keep[i])
+          {
+            undecided[numUndecided++] = undecided[i];
+          }
+        }
+        undecided.resize(numUndecided);
+      }
+    }
+
+    // The selected collapses do not interact, do them in cost order until
+    // the target reduction is reached. The edges of the points they touch
+    // are updated by the next round, and get a new cost if they end at the
+    // kept point.
+    updated.clear();
+    auto touch = [&marks, &updated](vtkIdType id)
+    {
+      if (!marks[id])
+      {
+        marks[id] = 1;
+        updated.push_back(id);
+      }
+      return true;
+    };
+    for (rank = 0; rank < numCandidates &&
+           static_cast<double>(numDeletedTris) / numTris <
+           this->TargetReduction; rank++)
+    {
+      if (states[rank] != BatchCollapseSelector::SELECTED)
+      {
+        continue;
+      }
+      ptId = candidates[rank].PtId;
+      BatchPointEdges &ptEdges = edges[ptId];
+      nbrId = ptEdges.Neighbors[candidates[rank].Index];
+      VisitCollapsePoints(this->Mesh, ptId, nbrId, touch);
+      marks[ptId] = 2;
+      this->NumberOfEdgeCollapses++;
+
+      // Set the new coordinates of the first point, merge the quadrics of
+      // the two points and update the triangles.
+      this->SetPointAttributeArray(
+        ptId, &ptEdges.Targets[candidates[rank].Index * dimension]);
+      this->AddQuadric(nbrId, ptId);
+      numDeletedTris += this->CollapseEdge(ptId, nbrId);
+    }
+    this->ActualReduction = static_cast<double>(numDeletedTris) / numTris;
+    this->UpdateProgress(0.20 + 0.80 *
+      std::min(1.0, this->ActualReduction / this->TargetReduction));
+    round++;
+  }
+
+  return numDeletedTris;
+}
+
 //----------------------------------------------------------------------------
 void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
 {
@@ -823,6 +1468,15 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 
 //----------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
+{
+  return this->ComputeCost(this->EndPoint1List->GetId(edgeId),
+                           this->EndPoint2List->GetId(edgeId),
+                           x, this->TempQuad);
+}
+
+//----------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost(vtkIdType pt0Id, vtkIdType pt1Id,
+                                         double *x, double *quad)
 {
   static const double errorNumber = 1e-10;
   double temp[3], A[3][3], b[3];
@@ -834,25 +1488,25 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
   double v[3],  c, norm, normTemp,  temp2[3];
   double pt1[3], pt2[3];
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
+  pointIds[0] = pt0Id;
+  pointIds[1] = pt1Id;
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
+    quad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
       this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   norm = vtkMath::Norm(A[0]);
   normTemp = vtkMath::Norm(A[1]);
@@ -906,7 +1560,7 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
 
   // Compute the cost
   // x'*quad*x
-  index = this->TempQuad;
+  index = quad;
   for (i = 0; i < 4; i++)
   {
     cost += (*index++)*newPoint[i]*newPoint[i];
@@ -922,6 +1576,16 @@ double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double *x)
 
 //----------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
+{
+  return this->ComputeCost2(this->EndPoint1List->GetId(edgeId),
+                            this->EndPoint2List->GetId(edgeId),
+                            x, this->TempQuad, this->TempA, this->TempB);
+}
+
+//----------------------------------------------------------------------------
+double vtkQuadricDecimation::ComputeCost2(vtkIdType pt0Id, vtkIdType pt1Id,
+                                          double *x, double *quad,
+                                          double **A, double *b)
 {
   // this function is so ugly because the functionality of converting an QEM
   // into a dense matrix was not extracted into a separate function and
@@ -932,34 +1596,34 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
   int i, j;
   int solveOk;
 
-  pointIds[0] = this->EndPoint1List->GetId(edgeId);
-  pointIds[1] = this->EndPoint2List->GetId(edgeId);
+  pointIds[0] = pt0Id;
+  pointIds[1] = pt1Id;
 
   for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
-    this->TempQuad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
+    quad[i] = this->ErrorQuadrics[pointIds[0]].Quadric[i] +
       this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
   // copy the temp quad into TempA
   // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
 
   for (i = 3; i < 3 +  this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11+4*(i-3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11+4*(i-3)+1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11+4*(i-3)+2];
-    this->TempB[i] = -this->TempQuad[11+4*(i-3)+3];
+    A[0][i] = A[i][0] = quad[11+4*(i-3)];
+    A[1][i] = A[i][1] = quad[11+4*(i-3)+1];
+    A[2][i] = A[i][2] = quad[11+4*(i-3)+2];
+    b[i] = -quad[11+4*(i-3)+3];
   }
 
 
@@ -970,11 +1634,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -985,45 +1649,45 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
     // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
+    b[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
+    b[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
   }
 
   for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    x[i] = this->TempB[i];
+    x[i] = b[i];
   }
 
   // solve A*x = b
   // this clobers A
   // need to develop a quality of the solution test??
-  solveOk = vtkMath::SolveLinearSystem(this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
+  solveOk = vtkMath::SolveLinearSystem(A, x, 3 + this->NumberOfComponents + this->VolumePreservation);
 
   // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
 
   for (i = 3; i < 3 +  this->NumberOfComponents; i++)
   {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11+4*(i-3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11+4*(i-3)+1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11+4*(i-3)+2];
+    A[0][i] = A[i][0] = quad[11+4*(i-3)];
+    A[1][i] = A[i][1] = quad[11+4*(i-3)+1];
+    A[2][i] = A[i][2] = quad[11+4*(i-3)+2];
   }
 
   for (i = 3; i < 3 +  this->NumberOfComponents; i++)
@@ -1032,11 +1696,11 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i == j)
       {
-        this->TempA[i][j] = this->TempQuad[10];
+        A[i][j] = quad[10];
       }
       else
       {
-        this->TempA[i][j] = 0;
+        A[i][j] = 0;
       }
     }
   }
@@ -1047,15 +1711,15 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
     {
       if (i >= 3)
       {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
+        A[i][3 + this->NumberOfComponents] = 0;
+        A[3 + this->NumberOfComponents][i] = 0;
       }
       else
       {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
+        A[i][3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + i];
+        A[3 + this->NumberOfComponents][i] += this->VolumeConstraints[pointIds[1] * 4 + i];
       }
     }
   }
@@ -1088,7 +1752,7 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
       temp2[i] = 0;
       for (j = 0; j < 3 + this->NumberOfComponents; ++j)
       {
-        temp2[i] += this->TempA[i][j]*v[j];
+        temp2[i] += A[i][j]*v[j];
       }
     }
 
@@ -1106,13 +1770,13 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
         temp[i] = 0;
         for (j = 0; j < 3 + this->NumberOfComponents; ++j)
         {
-          temp[i] += this->TempA[i][j]*pt1[j];
+          temp[i] += A[i][j]*pt1[j];
         }
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
       {
-        temp[i] = this->TempB[i] - temp[i];
+        temp[i] = b[i] - temp[i];
       }
 
       for (i = 0; i < 3 + this->NumberOfComponents; i++)
@@ -1146,18 +1810,18 @@ double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double *x)
   // x'*A*x - 2*b*x + d
   for (i = 0; i < 3+this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost += this->TempA[i][i]*x[i]*x[i];
+    cost += A[i][i]*x[i]*x[i];
     for (j = i+1; j < 3+this->NumberOfComponents + this->VolumePreservation; j++)
     {
-      cost += 2.0*this->TempA[i][j]*x[i]*x[j];
+      cost += 2.0*A[i][j]*x[i]*x[j];
     }
   }
   for (i = 0; i < 3+this->NumberOfComponents + this->VolumePreservation; i++)
   {
-    cost -=  2.0 * this->TempB[i]*x[i];
+    cost -=  2.0 * b[i]*x[i];
   }
 
-  cost += this->TempQuad[9];
+  cost += quad[9];
 
   return cost;
 }
@@ -1454,4 +2118,7 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Parallel Decimation: "
+     << (this->ParallelDecimation ? "On\n" : "Off\n");
+  os << indent << "Batch Fraction: " << this->BatchFraction << "\n";
 }
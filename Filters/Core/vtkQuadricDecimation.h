@@ -40,6 +40,20 @@
  * taking into account variation in attributes (i.e., scalars, vectors, and
  * so on).
  *
+ * When ParallelDecimation is on, the edges are collapsed in rounds instead
+ * of one at a time. Each round sorts the cheapest edges (the BatchFraction
+ * of them) and selects, in cost order, the collapses which pass the
+ * placement check and whose triangles do not share a vertex with those of a
+ * collapse selected before; the selected collapses do not interact and give
+ * the same mesh as if they were done one after the other. Updating the
+ * edges touched by the previous round, gathering and sorting the cheapest
+ * ones, and the selection run in parallel (using vtkSMPTools) and do not
+ * depend on the number of threads; only the collapses themselves are done
+ * serially, as they edit the cell links. The result is close to, but not
+ * the same as, the serial decimation. On a single thread, this mode is
+ * slower than the serial one, since each round scans all the edges for the
+ * cheapest ones and visits many candidates blocked by a cheaper collapse.
+ *
  * This paper is based on the work of Garland and Heckbert who first
  * presented the quadric error measure at Siggraph '97 "Surface
  * Simplification Using Quadric Error Metrics". For details of the algorithm
@@ -148,6 +162,28 @@ public:
   vtkGetMacro(TensorsWeight, double);
   //@}
 
+  //@{
+  /**
+   * Decide whether to collapse the edges in parallel rounds of independent
+   * collapses rather than one at a time off a single priority queue. By
+   * default ParallelDecimation is off.
+   */
+  vtkSetMacro(ParallelDecimation, vtkTypeBool);
+  vtkGetMacro(ParallelDecimation, vtkTypeBool);
+  vtkBooleanMacro(ParallelDecimation, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * When ParallelDecimation is on, set/get the fraction of the edges, the
+   * cheapest ones, considered for collapse in each round. Smaller values
+   * stay closer to the serial decimation but need more rounds. By default
+   * BatchFraction is 0.25.
+   */
+  vtkSetClampMacro(BatchFraction, double, 0.0, 1.0);
+  vtkGetMacro(BatchFraction, double);
+  //@}
+
   //@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -198,6 +234,25 @@ protected:
   double ComputeCost2(vtkIdType edgeId, double *x);
   //@}
 
+  //@{
+  /**
+   * Compute cost for contracting the edge between these 2 points, using the
+   * provided work space instead of the Temp* ivars, so that they can be
+   * called concurrently. quad holds 11 + 4 * NumberOfComponents values, A
+   * and b hold 3 + NumberOfComponents + VolumePreservation rows.
+   */
+  double ComputeCost(vtkIdType pt0Id, vtkIdType pt1Id, double *x,
+                     double *quad);
+  double ComputeCost2(vtkIdType pt0Id, vtkIdType pt1Id, double *x,
+                      double *quad, double **A, double *b);
+  //@}
+
+  /**
+   * Collapse edges in parallel rounds until the target reduction is
+   * reached; return the number of triangles deleted.
+   */
+  vtkIdType CollapseEdgesInBatches(vtkIdType numTris);
+
   /**
    * Find all edges that will have an endpoint change ids because of an edge
    * collapse.  p1Id and p2Id are the endpoints of the edge.  p2Id is the
@@ -247,6 +302,9 @@ protected:
   double TCoordsWeight;
   double TensorsWeight;
 
+  vtkTypeBool ParallelDecimation;
+  double BatchFraction;
+
   int               NumberOfEdgeCollapses;
   vtkEdgeTable     *Edges;
   vtkIdList        *EndPoint1List;
@@ -279,6 +337,11 @@ protected:
   double *TempData;
 
 private:
+  // Update the edges and select the collapses of a round of
+  // CollapseEdgesInBatches() in parallel
+  struct BatchEdgeBuilder;
+  struct BatchCollapseSelector;
+
   vtkQuadricDecimation(const vtkQuadricDecimation&) = delete;
   void operator=(const vtkQuadricDecimation&) = delete;
 };
@@ -24,11 +24,15 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothingStencils.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -128,6 +132,8 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorScalars = 0;
   this->GenerateErrorVectors = 0;
 
+  this->SimultaneousSmoothing = 0;
+
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
   this->SmoothPoints = nullptr;
@@ -151,132 +157,179 @@ vtkPolyData *vtkSmoothPolyDataFilter::GetSource()
     this->GetExecutive()->GetInputData(1, 0));
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
-
-namespace {
-
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
+namespace
 {
-  char      type;
-  vtkIdList *edges; // connected edges (list of connected point ids)
-  _vtkMeshVertex()
-  {
-    type = VTK_SIMPLE_VERTEX; //can smooth
-    edges = nullptr;
-  }
-} vtkMeshVertex, *vtkMeshVertexPtr;
 
-template<typename T> struct vtkSPDF_InternalParams
+//-----------------------------------------------------------------------------
+// One smoothing iteration: each point that can move is moved from X0 toward
+// the mean position of its stencil using the relaxation factor, and written
+// to X1. If X1 is a separate buffer, all the points are moved from the
+// positions of the previous iteration and can be processed in any order.
+// If X1 is X0, the points are moved in place, in order, each one using the
+// latest positions of its neighbors. When a source is given, the moved
+// points are constrained to its surface. The
+// vtkCellLocator::FindClosestPoint() called below evaluates the cells in the
+// GenericCell of the locator, a query state shared by all the callers, so
+// the iteration is then run serially.
+template<typename T> struct MovePoints
 {
-  vtkSmoothPolyDataFilter* spdf;
-  int numberOfIterations;
-  vtkPoints *newPts;
-  T factor;
-  T conv;
-  vtkIdType numPts;
-  vtkMeshVertexPtr vertexPtr;
-  vtkPolyData *source;
+  const vtkIdType *Offsets;
+  const vtkIdType *Stencils;
+  T Factor;
+  const T *X0;
+  T *X1;
+  vtkPolyData *Source;
   vtkSmoothPoints *SmoothPoints;
-  double *w;
-  vtkCellLocator *cellLocator;
-};
+  vtkCellLocator *CellLocator;
+  double *W;
 
-template<typename T> void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
-{
-  int iterationNumber = 0;
-  for (T maxDist = std::numeric_limits<T>::max();
-       maxDist > params.conv && iterationNumber < params.numberOfIterations;
-       ++iterationNumber)
+  T MaxDist; // the largest motion, i.e. the norm of the summed stencil
+  vtkSMPThreadLocal<T> LocalMaxDist;
+
+  void Initialize()
   {
-    if (iterationNumber && !(iterationNumber % 5))
-    {
-      params.spdf->UpdateProgress(0.5 + 0.5*iterationNumber / params.numberOfIterations);
-      if (params.spdf->GetAbortExecute())
-      {
-        break;
-      }
-    }
+    this->LocalMaxDist.Local() = 0.0;
+  }
 
-    maxDist = 0.0;
-    T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
-    T* start = newPtsCoords;
-    vtkMeshVertexPtr vertsPtr = params.vertexPtr;
-    vtkIdType npts, *edgeIdPtr;
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    T &maxDist = this->LocalMaxDist.Local();
     T dist, deltaX[3];
     double dist2, xNew[3], closestPt[3];
 
-    // For each non-fixed vertex of the mesh, move the point toward the mean
-    // position of its connected neighbors using the relaxation factor.
-    for (vtkIdType i = 0; i < params.numPts; ++i)
+    for (vtkIdType i = begin; i < end; i++)
     {
-      if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges != nullptr &&
-         (npts = vertsPtr->edges->GetNumberOfIds()) > 0)
+      const vtkIdType *stencil = this->Stencils + this->Offsets[i];
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      const T *x0 = this->X0 + 3*i;
+      T *x1 = this->X1 + 3*i;
+      if ( npts == 0 )
       {
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        edgeIdPtr = vertsPtr->edges->GetPointer(0);
-        // Compute the mean (cumulated) direction vector
-        for (vtkIdType j = 0; j < npts; ++j)
+        // point is not allowed to move
+        if ( x1 != x0 )
         {
-          for (unsigned short k = 0; k < 3; ++k)
-          {
-            deltaX[k] += *(start + 3 * (*edgeIdPtr) + k);
-          }
-          ++edgeIdPtr;
-        }//for all connected points
-
-        // Move the point
-        *newPtsCoords += params.factor * (deltaX[0] / npts - (*newPtsCoords));
-        xNew[0] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[1] / npts - (*newPtsCoords));
-        xNew[1] = *newPtsCoords;
-        ++newPtsCoords;
-        *newPtsCoords += params.factor * (deltaX[2] / npts - (*newPtsCoords));
-        xNew[2] = *newPtsCoords;
-        ++newPtsCoords;
-
-        // Constrain point to surface
-        if (params.source)
+          x1[0] = x0[0]; x1[1] = x0[1]; x1[2] = x0[2];
+        }
+        continue;
+      }
+
+      // Compute the mean (cumulated) direction vector
+      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+      for (vtkIdType j = 0; j < npts; j++)
+      {
+        const T *y = this->X0 + 3*stencil[j];
+        for (int k = 0; k < 3; k++)
+        {
+          deltaX[k] += y[k];
+        }
+      }
+
+      // Move the point
+      for (int k = 0; k < 3; k++)
+      {
+        x1[k] = x0[k] + this->Factor * (deltaX[k] / npts - x0[k]);
+      }
+
+      // Constrain point to surface
+      if ( this->Source )
+      {
+        vtkSmoothPoint *sPtr = this->SmoothPoints->GetSmoothPoint(i);
+        vtkCell *cell = nullptr;
+        xNew[0] = x1[0]; xNew[1] = x1[1]; xNew[2] = x1[2];
+
+        if (sPtr->cellId >= 0) //in cell
         {
-          vtkSmoothPoint *sPtr = params.SmoothPoints->GetSmoothPoint(i);
-          vtkCell *cell = nullptr;
-
-          if (sPtr->cellId >= 0) //in cell
-          {
-            cell = params.source->GetCell(sPtr->cellId);
-          }
-
-          if (!cell || cell->EvaluatePosition(xNew, closestPt,
-              sPtr->subId, sPtr->p, dist2, params.w) == 0)
-          { // not in cell anymore
-            params.cellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId,
-                                                 sPtr->subId, dist2);
-          }
-          for (int k = 0; k < 3; ++k)
-          {
-            xNew[k] = closestPt[k];
-          }
-          params.newPts->SetPoint(i, xNew);
+          cell = this->Source->GetCell(sPtr->cellId);
         }
 
-        if ((dist = vtkMath::Norm(deltaX)) > maxDist)
+        if (!cell || cell->EvaluatePosition(xNew, closestPt,
+            sPtr->subId, sPtr->p, dist2, this->W) == 0)
+        { // not in cell anymore
+          this->CellLocator->FindClosestPoint(xNew, closestPt, sPtr->cellId,
+                                              sPtr->subId, dist2);
+        }
+        for (int k = 0; k < 3; k++)
         {
-          maxDist = dist;
+          x1[k] = static_cast<T>(closestPt[k]);
         }
-      }//if can move point
-      else
+      }
+
+      if ((dist = vtkMath::Norm(deltaX)) > maxDist)
+      {
+        maxDist = dist;
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    this->MaxDist = 0.0;
+    typename vtkSMPThreadLocal<T>::iterator iter;
+    for (iter = this->LocalMaxDist.begin();
+         iter != this->LocalMaxDist.end(); ++iter)
+    {
+      if ( *iter > this->MaxDist )
       {
-        newPtsCoords += 3;
+        this->MaxDist = *iter;
       }
-      ++vertsPtr;
-    }//for all points
-  }//for not converged or within iteration count
+    }
+  }
+};
+
+// Run the smoothing iterations. Simultaneous iterations swap the two buffers
+// of points; otherwise the points are moved in place. On return, pts[0]
+// holds the smoothed points.
+template<typename T>
+void vtkSPDF_MovePoints(vtkSmoothPolyDataFilter *self, int numberOfIterations,
+                        bool simultaneous, vtkPoints *pts[2], T factor, T conv,
+                        const vtkIdType *offsets, const vtkIdType *stencils,
+                        vtkPolyData *source, vtkSmoothPoints *smoothPoints,
+                        double *w, vtkCellLocator *cellLocator)
+{
+  vtkIdType numPts = pts[0]->GetNumberOfPoints();
+  MovePoints<T> move;
+  move.Offsets = offsets;
+  move.Stencils = stencils;
+  move.Factor = factor;
+  move.Source = source;
+  move.SmoothPoints = smoothPoints;
+  move.CellLocator = cellLocator;
+  move.W = w;
 
-  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > conv && iterationNumber < numberOfIterations;
+       ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      self->UpdateProgress(0.5 + 0.5*iterationNumber / numberOfIterations);
+      if (self->GetAbortExecute())
+      {
+        break;
+      }
+    }
+
+    move.X0 = static_cast<T*>(pts[0]->GetVoidPointer(0));
+    move.X1 = static_cast<T*>(pts[simultaneous ? 1 : 0]->GetVoidPointer(0));
+    if ( simultaneous && !source )
+    {
+      vtkSMPTools::For(0, numPts, move);
+    }
+    else
+    {
+      move.Initialize();
+      move(0, numPts);
+      move.Reduce();
+    }
+    maxDist = move.MaxDist;
+    if ( simultaneous )
+    {
+      std::swap(pts[0], pts[1]);
+    }
+  }
+
+  vtkDebugWithObjectMacro(self, << "Performed " << iterationNumber << " smoothing passes");
 }
 
 }// namespace
@@ -304,22 +357,20 @@ int vtkSmoothPolyDataFilter::RequestData(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numPts, numCells, i, numPolys, numStrips;
-  int j, k;
+  int j;
   vtkIdType npts = 0;
   vtkIdType *pts = nullptr;
-  vtkIdType p1, p2;
   double conv;
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double x1[3], x2[3], x3[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
   double closestPt[3], dist2, *w = nullptr;
   vtkIdType numSimple=0, numBEdges=0, numFixed=0, numFEdges=0;
-  vtkPolyData *inMesh, *Mesh;
+  vtkPolyData *inMesh = nullptr, *Mesh;
   vtkPoints *inPts;
   vtkTriangleFilter *toTris=nullptr;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
-  vtkPoints *newPts;
-  vtkMeshVertexPtr Verts;
+  vtkPoints *newPts[2];
   vtkCellLocator *cellLocator=nullptr;
 
   // Check input
@@ -362,7 +413,8 @@ int vtkSmoothPolyDataFilter::RequestData(
   // using a subset of the attached vertices.
   //
   vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
+  std::vector<char> lineTypes(numPts, VTK_SIMPLE_VERTEX);
+  std::vector<vtkIdType> lineEdges;
 
   inPts = input->GetPoints();
   conv = this->Convergence * input->GetLength();
@@ -373,44 +425,38 @@ int vtkSmoothPolyDataFilter::RequestData(
   {
     for (j=0; j<npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      lineTypes[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal();
-  inLines->GetNextCell(npts,pts); )
+  inLines = input->GetLines();
+  if ( inLines->GetNumberOfCells() > 0 )
+  {
+    lineEdges.resize(2*numPts);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
   {
     for (j=0; j<npts; j++)
     {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      if ( lineTypes[pts[j]] == VTK_SIMPLE_VERTEX )
       {
-        if ( j == (npts-1) ) //end-of-line marked FIXED
-        {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        }
-        else if ( j == 0 ) //beginning-of-line marked FIXED
+        if ( j == 0 || j == (npts-1) ) //ends of line marked FIXED
         {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
-          inPts->GetPoint(pts[0],x2);
-          inPts->GetPoint(pts[1],x3);
+          lineTypes[pts[j]] = VTK_FIXED_VERTEX;
         }
         else //is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[j+1]);
+          lineTypes[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          lineEdges[2*pts[j]] = pts[j-1];
+          lineEdges[2*pts[j]+1] = pts[j+1];
         }
       } //if simple vertex
 
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX )
+      else if ( lineTypes[pts[j]] == VTK_FEATURE_EDGE_VERTEX )
       { //multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        lineTypes[pts[j]] = VTK_FIXED_VERTEX;
       }
 
     } //for all points in this line
@@ -423,25 +469,15 @@ int vtkSmoothPolyDataFilter::RequestData(
   inStrips=input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
+  Mesh = nullptr;
   if ( numPolys > 0 || numStrips > 0 )
   { //build cell structure
-    vtkCellArray *polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
-
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
-
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
     inMesh->SetPolys(inPolys);
     Mesh = inMesh;
 
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
+    if ( numStrips > 0 )
     { // convert data to triangles
       inMesh->SetStrips(inStrips);
       toTris = vtkTriangleFilter::New();
@@ -450,179 +486,53 @@ int vtkSmoothPolyDataFilter::RequestData(
       Mesh = toTris->GetOutput();
     }
 
+    Mesh->EditableOff(); // the links are only queried
     Mesh->BuildLinks(); //to do neighborhood searching
-    polys = Mesh->GetPolys();
     this->UpdateProgress(0.375);
+  }//if strips or polys
 
-    for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
-    cellId++)
-    {
-      for (i=0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i+1)%npts];
-
-        if ( Verts[p1].edges == nullptr )
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-        }
-        if ( Verts[p2].edges == nullptr )
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if ( numNei >= 2 )
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j=0; j < numNei; j++)
-          {
-            if ( neighbors->GetId(j) < cellId )
-            {
-              break;
-            }
-          }
-          if ( j >= numNei )
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId )
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if (vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
+  // Build the stencils of the points in parallel, then gather them in
+  // compressed sparse row form.
+  std::vector<char> types(numPts);
+  std::vector<vtkIdType> offsets(numPts+1);
+  vtkBuildSmoothingStencils stencils;
+  stencils.Mesh = Mesh;
+  stencils.Points = inPts;
+  stencils.LineTypes = lineTypes.data();
+  stencils.LineEdges = lineEdges.data();
+  stencils.CosFeatureAngle = CosFeatureAngle;
+  stencils.CosEdgeAngle = CosEdgeAngle;
+  stencils.FeatureEdgeSmoothing = this->FeatureEdgeSmoothing;
+  stencils.NonManifoldSmoothing = 0;
+  stencils.BoundarySmoothing = this->BoundarySmoothing;
+  // the fixed points do not move
+  stencils.KeepFixedStencils = false;
+  stencils.Offsets = offsets.data();
+  stencils.Types = types.data();
+  std::vector<vtkIdType> stencilIds;
+  vtkGatherSmoothingStencils(stencils, numPts, stencilIds);
+
+  if (toTris)
+  {
+    toTris->Delete();
+  }
+  if ( inMesh != nullptr )
+  {
     inMesh->Delete();
-    if (toTris) {toTris->Delete();}
-
-    neighbors->Delete();
-  }//if strips or polys
+  }
 
   this->UpdateProgress(0.50);
 
-  //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
   {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+    switch ( types[i] )
     {
-      numSimple++;
+      case VTK_SIMPLE_VERTEX: numSimple++; break;
+      case VTK_FIXED_VERTEX: numFixed++; break;
+      case VTK_FEATURE_EDGE_VERTEX: numFEdges++; break;
+      default: numBEdges++; break;
     }
-
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
-    {
-      numFixed++;
-    }
-
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-    Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
-    { //see how many edges; if two, what the angle is
-
-      if ( !this->BoundarySmoothing &&
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
-      }
-
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numFixed++;
-      }
-
-      else //check angle between edges
-      {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
-        inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
-
-        for (k=0; k<3; k++)
-        {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
-        }
-        if ( vtkMath::Normalize(l1) >= 0.0 &&
-             vtkMath::Normalize(l2) >= 0.0 &&
-             vtkMath::Dot(l1,l2) < CosEdgeAngle)
-        {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
-        }
-        else
-        {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
-          {
-            numFEdges++;
-          }
-          else
-          {
-            numBEdges++;
-          }
-        }
-      }//if along edge
-    }//if edge vertex
-  }//for all points
+  }
 
   vtkDebugMacro(<<"Found\n\t" << numSimple << " simple vertices\n\t"
                 << numFEdges << " feature edge vertices\n\t"
@@ -631,26 +541,35 @@ int vtkSmoothPolyDataFilter::RequestData(
 
   vtkDebugMacro(<<"Beginning smoothing iterations...");
 
-  // We've setup the topology...now perform Laplacian smoothing
+  // We've setup the topology...now perform Laplacian smoothing. Simultaneous
+  // smoothing moves the points from one buffer of points to the other at each
+  // iteration; the second buffer is left empty otherwise.
   //
-  newPts = vtkPoints::New();
+  newPts[0] = vtkPoints::New();
+  newPts[1] = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
-  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(inPts->GetDataType());
-  }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  for (j=0; j<2; j++)
   {
-    newPts->SetDataType(VTK_FLOAT);
+    if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+    {
+      newPts[j]->SetDataType(inPts->GetDataType());
+    }
+    else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+    {
+      newPts[j]->SetDataType(VTK_FLOAT);
+    }
+    else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+    {
+      newPts[j]->SetDataType(VTK_DOUBLE);
+    }
   }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  newPts[0]->SetNumberOfPoints(numPts);
+  if ( this->SimultaneousSmoothing )
   {
-    newPts->SetDataType(VTK_DOUBLE);
+    newPts[1]->SetNumberOfPoints(numPts);
   }
 
-  newPts->SetNumberOfPoints(numPts);
-
   // If Source defined, we do constrained smoothing (that is, points are
   // constrained to the surface of the mesh object).
   if ( source )
@@ -668,35 +587,35 @@ int vtkSmoothPolyDataFilter::RequestData(
       sPtr = this->SmoothPoints->InsertSmoothPoint(i);
       cellLocator->FindClosestPoint(inPts->GetPoint(i), closestPt,
                                     sPtr->cellId, sPtr->subId, dist2);
-      newPts->SetPoint(i, closestPt);
+      newPts[0]->SetPoint(i, closestPt);
     }
   }
   else //smooth normally
   {
     for (i=0; i<numPts; i++) //initialize to old coordinates
     {
-      newPts->SetPoint(i,inPts->GetPoint(i));
+      newPts[0]->SetPoint(i,inPts->GetPoint(i));
     }
   }
 
-  if (newPts->GetDataType() == VTK_DOUBLE)
+  if (newPts[0]->GetDataType() == VTK_DOUBLE)
   {
-    vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
-                                              this->RelaxationFactor, conv, numPts,
-                                              Verts, source, this->SmoothPoints,
-                                              w, cellLocator };
-
-    vtkSPDF_MovePoints(params);
+    vtkSPDF_MovePoints<double>(this, this->NumberOfIterations,
+                               this->SimultaneousSmoothing != 0, newPts,
+                               this->RelaxationFactor, conv, offsets.data(),
+                               stencilIds.data(), source, this->SmoothPoints,
+                               w, cellLocator);
   }
   else
   {
-    vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
-                                             static_cast<float>(this->RelaxationFactor),
-                                             static_cast<float>(conv), numPts, Verts,
-                                             source, this->SmoothPoints, w, cellLocator };
-
-    vtkSPDF_MovePoints(params);
+    vtkSPDF_MovePoints<float>(this, this->NumberOfIterations,
+                              this->SimultaneousSmoothing != 0, newPts,
+                              static_cast<float>(this->RelaxationFactor),
+                              static_cast<float>(conv), offsets.data(),
+                              stencilIds.data(), source, this->SmoothPoints,
+                              w, cellLocator);
   }
+  newPts[1]->Delete();
 
   if ( source )
   {
@@ -717,7 +636,7 @@ int vtkSmoothPolyDataFilter::RequestData(
     for (i=0; i<numPts; i++)
     {
       inPts->GetPoint(i,x1);
-      newPts->GetPoint(i,x2);
+      newPts[0]->GetPoint(i,x2);
       newScalars->SetComponent(i,0,
                                sqrt(vtkMath::Distance2BetweenPoints(x1,x2)));
     }
@@ -734,7 +653,7 @@ int vtkSmoothPolyDataFilter::RequestData(
     for (i=0; i<numPts; i++)
     {
       inPts->GetPoint(i,x1);
-      newPts->GetPoint(i,x2);
+      newPts[0]->GetPoint(i,x2);
       for (j=0; j<3; j++)
       {
         x3[j] = x2[j] - x1[j];
@@ -745,25 +664,14 @@ int vtkSmoothPolyDataFilter::RequestData(
     newVectors->Delete();
   }
 
-  output->SetPoints(newPts);
-  newPts->Delete();
+  output->SetPoints(newPts[0]);
+  newPts[0]->Delete();
 
   output->SetVerts(input->GetVerts());
   output->SetLines(input->GetLines());
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-  {
-    if ( Verts[i].edges != nullptr )
-    {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
-    }
-  }
-  delete [] Verts;
-
   return 1;
 }
 
@@ -795,6 +703,7 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Boundary Smoothing: " << (this->BoundarySmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Simultaneous Smoothing: " << (this->SimultaneousSmoothing ? "On\n" : "Off\n");
   if ( this->GetSource() )
   {
       os << indent << "Source: " << static_cast<void *>(this->GetSource()) << "\n";
@@ -77,6 +77,13 @@
  * second input: the Source. If defined, the input mesh is constrained to
  * lie on the surface defined by the Source ivar.
  *
+ * By default each vertex is moved using the coordinates its neighbors were
+ * just given during the same pass (Gauss-Seidel iterations), so the passes
+ * are serial. If SimultaneousSmoothing is on, all the vertices are moved
+ * from the coordinates of the previous pass (Jacobi iterations), which lets
+ * the passes run in parallel. The result then differs slightly, and the
+ * mesh relaxes a little more slowly per iteration.
+ *
  *
  * @warning
  * The Laplacian operation reduces high frequency information in the geometry
@@ -195,6 +202,18 @@ public:
   vtkBooleanMacro(GenerateErrorVectors,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Turn on/off moving all the vertices of a pass at once, from the
+   * coordinates of the previous pass, which allows the passes to run in
+   * parallel. Off by default, in which case each vertex uses the latest
+   * coordinates of its neighbors.
+   */
+  vtkSetMacro(SimultaneousSmoothing,vtkTypeBool);
+  vtkGetMacro(SimultaneousSmoothing,vtkTypeBool);
+  vtkBooleanMacro(SimultaneousSmoothing,vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Specify the source object which is used to constrain smoothing. The
@@ -231,6 +250,7 @@ protected:
   vtkTypeBool BoundarySmoothing;
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
+  vtkTypeBool SimultaneousSmoothing;
   int OutputPointsPrecision;
 
   vtkSmoothPoints *SmoothPoints;
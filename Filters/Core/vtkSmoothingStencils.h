@@ -0,0 +1,312 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSmoothingStencils.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSmoothingStencils
+ * @brief   private helpers of the smoothing filters
+ *
+ * Helpers shared by vtkSmoothPolyDataFilter and
+ * vtkWindowedSincPolyDataFilter. They classify the points of a mesh as
+ * simple, fixed, feature edge or boundary edge vertices, and gather in
+ * parallel the stencil of each point, i.e. the points it is smoothed with,
+ * in compressed sparse row form. This header is not installed.
+*/
+
+#ifndef vtkSmoothingStencils_h
+#define vtkSmoothingStencils_h
+
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+#define VTK_SIMPLE_VERTEX 0
+#define VTK_FIXED_VERTEX 1
+#define VTK_FEATURE_EDGE_VERTEX 2
+#define VTK_BOUNDARY_EDGE_VERTEX 3
+
+// The stencils of a range of points, starting at point Begin
+struct vtkSmoothingStencilBlock
+{
+  vtkIdType Begin;
+  std::vector<vtkIdType> Ids;
+};
+
+// Classify each point and gather its stencil. Each point replays the
+// analysis of the edges of its polygons in the order of the cells, so the
+// types and the stencils do not depend on how the points are split between
+// the threads. The size of each stencil is written to Offsets[ptId+1] and
+// the stencils of each range of points are kept in a block, to be copied
+// into the adjacency once the offsets are known.
+struct vtkBuildSmoothingStencils
+{
+  vtkPolyData *Mesh; // the polygons with their links, may be nullptr
+  vtkPoints *Points;
+  const char *LineTypes; // the types set by the vertices and the lines
+  const vtkIdType *LineEdges; // the two neighbors of line points
+  double CosFeatureAngle;
+  double CosEdgeAngle;
+  int FeatureEdgeSmoothing;
+  int NonManifoldSmoothing;
+  int BoundarySmoothing;
+  bool KeepFixedStencils; // whether the fixed points keep their stencil
+  vtkIdType *Offsets;
+  char *Types;
+
+  vtkSMPThreadLocal<std::vector<vtkIdType> > Stencil;
+  vtkSMPThreadLocal<std::vector<vtkSmoothingStencilBlock> > Blocks;
+
+  // Return the type of the edge (p1,p2) of a cell, or -1 if the edge is
+  // analyzed with another cell. The neighbors of the edge are found as
+  // vtkPolyData::GetCellEdgeNeighbors() does.
+  int ClassifyEdge(vtkIdType cellId, vtkIdType npts, vtkIdType *pts,
+                   vtkIdType p1, vtkIdType p2)
+  {
+    unsigned short ncells;
+    vtkIdType *cells, numNeiPts, *neiPts;
+    this->Mesh->GetPointCells(p1, ncells, cells);
+    vtkIdType numNei = 0, nei = -1;
+    bool visited = false;
+    for (unsigned short i=0; i < ncells; i++)
+    {
+      if ( cells[i] == cellId )
+      {
+        continue;
+      }
+      this->Mesh->GetCellPoints(cells[i], numNeiPts, neiPts);
+      if ( std::find(neiPts, neiPts + numNeiPts, p2) != neiPts + numNeiPts )
+      {
+        if ( numNei++ == 0 )
+        {
+          nei = cells[i];
+        }
+        visited = visited || cells[i] < cellId;
+      }
+    }
+
+    if ( numNei == 0 )
+    {
+      return VTK_BOUNDARY_EDGE_VERTEX;
+    }
+    else if ( numNei >= 2 )
+    {
+      // non-manifold case, check nonmanifold smoothing state. Only the first
+      // cell of the edge marks it.
+      return !this->NonManifoldSmoothing && !visited ?
+        VTK_FEATURE_EDGE_VERTEX : VTK_SIMPLE_VERTEX;
+    }
+    else if ( nei > cellId )
+    {
+      if (this->FeatureEdgeSmoothing)
+      {
+        double normal[3], neiNormal[3];
+        vtkPolygon::ComputeNormal(this->Points,npts,pts,normal);
+        this->Mesh->GetCellPoints(nei,numNeiPts,neiPts);
+        vtkPolygon::ComputeNormal(this->Points,numNeiPts,neiPts,neiNormal);
+
+        if ( vtkMath::Dot(normal,neiNormal) <= this->CosFeatureAngle )
+        {
+          return VTK_FEATURE_EDGE_VERTEX;
+        }
+      }
+      return VTK_SIMPLE_VERTEX;
+    }
+    // a visited edge
+    return -1;
+  }
+
+  // Update the type and the stencil of a point with one of its edges
+  static void AddEdge(char &type, std::vector<vtkIdType> &stencil,
+                      int edge, vtkIdType nei)
+  {
+    if ( edge && type == VTK_SIMPLE_VERTEX )
+    {
+      stencil.clear();
+      stencil.push_back(nei);
+      type = edge;
+    }
+    else if ( (edge && type == VTK_BOUNDARY_EDGE_VERTEX) ||
+              (edge && type == VTK_FEATURE_EDGE_VERTEX) ||
+              (!edge && type == VTK_SIMPLE_VERTEX ) )
+    {
+      stencil.push_back(nei);
+      if ( type && edge == VTK_BOUNDARY_EDGE_VERTEX )
+      {
+        type = VTK_BOUNDARY_EDGE_VERTEX;
+      }
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    std::vector<vtkIdType> &stencil = this->Stencil.Local();
+    std::vector<vtkSmoothingStencilBlock> &blocks = this->Blocks.Local();
+    blocks.push_back(vtkSmoothingStencilBlock());
+    vtkSmoothingStencilBlock &block = blocks.back();
+    block.Begin = begin;
+    double x1[3], x2[3], x3[3], l1[3], l2[3];
+
+    for (vtkIdType ptId = begin; ptId < end; ptId++)
+    {
+      char type = this->LineTypes[ptId];
+      stencil.clear();
+      if ( type == VTK_FEATURE_EDGE_VERTEX )
+      {
+        stencil.push_back(this->LineEdges[2*ptId]);
+        stencil.push_back(this->LineEdges[2*ptId+1]);
+      }
+
+      if ( this->Mesh )
+      {
+        unsigned short ncells;
+        vtkIdType *cells, npts, *pts;
+        this->Mesh->GetPointCells(ptId, ncells, cells);
+        for (unsigned short c=0; c < ncells; c++)
+        {
+          if ( c > 0 && cells[c] == cells[c-1] )
+          {
+            continue; // the point is used twice by this cell
+          }
+          this->Mesh->GetCellPoints(cells[c], npts, pts);
+          for (vtkIdType i=0; i < npts; i++)
+          {
+            vtkIdType p1 = pts[i];
+            vtkIdType p2 = pts[(i+1)%npts];
+            if ( p1 != ptId && p2 != ptId )
+            {
+              continue;
+            }
+            int edge = this->ClassifyEdge(cells[c], npts, pts, p1, p2);
+            if ( edge < 0 )
+            {
+              continue;
+            }
+            if ( p1 == ptId )
+            {
+              this->AddEdge(type, stencil, edge, p2);
+            }
+            if ( p2 == ptId )
+            {
+              this->AddEdge(type, stencil, edge, p1);
+            }
+          }
+        }
+      }
+
+      // post-process edge vertices to make sure we can smooth them
+      if ( type == VTK_FEATURE_EDGE_VERTEX || type == VTK_BOUNDARY_EDGE_VERTEX )
+      {
+        if ( !this->BoundarySmoothing && type == VTK_BOUNDARY_EDGE_VERTEX )
+        {
+          type = VTK_FIXED_VERTEX;
+        }
+        else if ( stencil.size() != 2 )
+        {
+          // can only smooth edges on 2-manifold surfaces
+          type = VTK_FIXED_VERTEX;
+        }
+        else //check angle between edges
+        {
+          this->Points->GetPoint(stencil[0],x1);
+          this->Points->GetPoint(ptId,x2);
+          this->Points->GetPoint(stencil[1],x3);
+          for (int k=0; k<3; k++)
+          {
+            l1[k] = x2[k] - x1[k];
+            l2[k] = x3[k] - x2[k];
+          }
+          if ( vtkMath::Normalize(l1) >= 0.0 &&
+               vtkMath::Normalize(l2) >= 0.0 &&
+               vtkMath::Dot(l1,l2) < this->CosEdgeAngle)
+          {
+            type = VTK_FIXED_VERTEX;
+          }
+        }
+      }
+
+      if ( type == VTK_FIXED_VERTEX && !this->KeepFixedStencils )
+      {
+        stencil.clear();
+      }
+      this->Types[ptId] = type;
+      this->Offsets[ptId+1] = static_cast<vtkIdType>(stencil.size());
+      block.Ids.insert(block.Ids.end(), stencil.begin(), stencil.end());
+    }
+  }
+};
+
+// Copy the blocks of stencils into the adjacency
+struct vtkCopySmoothingStencilBlocks
+{
+  const std::vector<vtkSmoothingStencilBlock*> &Blocks;
+  const vtkIdType *Offsets;
+  vtkIdType *Stencils;
+
+  vtkCopySmoothingStencilBlocks(
+    const std::vector<vtkSmoothingStencilBlock*> &blocks,
+    const vtkIdType *offsets, vtkIdType *stencils)
+    : Blocks(blocks), Offsets(offsets), Stencils(stencils)
+  {
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const vtkSmoothingStencilBlock *block = this->Blocks[i];
+      std::copy(block->Ids.begin(), block->Ids.end(),
+                this->Stencils + this->Offsets[block->Begin]);
+    }
+  }
+};
+
+// Build the stencils of the numPts points in parallel, then gather them in
+// compressed sparse row form: the stencil of point i is made of
+// stencilIds[offsets[i]] to stencilIds[offsets[i+1]-1]. The Offsets and
+// the Types of the builder must point to arrays of numPts+1 and numPts
+// values.
+inline void vtkGatherSmoothingStencils(vtkBuildSmoothingStencils &stencils,
+                                       vtkIdType numPts,
+                                       std::vector<vtkIdType> &stencilIds)
+{
+  vtkIdType *offsets = stencils.Offsets;
+  offsets[0] = 0;
+  vtkSMPTools::For(0, numPts, stencils);
+  for (vtkIdType i=0; i < numPts; i++)
+  {
+    offsets[i+1] += offsets[i];
+  }
+
+  stencilIds.resize(offsets[numPts]);
+  std::vector<vtkSmoothingStencilBlock*> blocks;
+  vtkSMPThreadLocal<std::vector<vtkSmoothingStencilBlock> >::iterator blockIter;
+  for (blockIter = stencils.Blocks.begin();
+       blockIter != stencils.Blocks.end(); ++blockIter)
+  {
+    for (size_t b = 0; b < blockIter->size(); b++)
+    {
+      blocks.push_back(&(*blockIter)[b]);
+    }
+  }
+  vtkCopySmoothingStencilBlocks copyBlocks(blocks, offsets, stencilIds.data());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(blocks.size()), copyBlocks);
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkSmoothingStencils.h
@@ -14,18 +14,25 @@
 =========================================================================*/
 #include "vtkTubeFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 
 vtkStandardNewMacro(vtkTubeFilter);
@@ -53,6 +60,10 @@ vtkTubeFilter::vtkTubeFilter()
 
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
+#if !defined(VTK_LEGACY_REMOVE)
+  this->Theta = 0.0;
+#endif
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
@@ -82,8 +93,722 @@ struct IdPointsEqual
   vtkPoints *Points;
 };
 
+// The outcome of computing the frames of a polyline.
+enum LineStatus
+{
+  LINE_DEGENERATE, // less than two distinct points, silently skipped
+  LINE_VALID,
+  LINE_COINCIDENT_POINTS,
+  LINE_BAD_NORMAL,
+  LINE_NEGATIVE_SCALAR
+};
+
+// Each point of a polyline has a frame made of its position, the two
+// vectors w and nP spanning the plane of the tube section, and the scale
+// factor of the radius.
+const int FRAME_SIZE = 10;
+
+// The number of points, cells and connectivity entries generated before a
+// polyline.
+struct TubeOffsets
+{
+  vtkIdType Points;
+  vtkIdType Cells;
+  vtkIdType Connectivity;
+};
+
+// Per thread buffers used to process one polyline at a time.
+struct TubeLine
+{
+  std::vector<vtkIdType> Ids; //point ids, without consecutive duplicates
+  std::vector<double> Frames;
+  double StartCapNorm[3];
+  double EndCapNorm[3];
+  double BadS[3]; //reported when the normal is parallel to the line
+  double BadN[3];
+  std::vector<double> Vector;
+
+  // Used to generate the normals of the polyline
+  std::vector<double> Normals;
+  std::vector<std::pair<vtkIdType,vtkIdType> > SortedIds;
+  std::vector<vtkIdType> LocalIds;
+  vtkSmartPointer<vtkPoints> LocalPoints;
+  vtkSmartPointer<vtkCellArray> LocalLine;
+  vtkSmartPointer<vtkFloatArray> LocalNormals;
+};
+
+// Polylines are tubed independently of each other: a first pass computes
+// the frames of each polyline to count the points and cells of its tube,
+// and once the output is allocated a second pass computes the frames again
+// and generates the tube in place.
+struct TubeGenerator
+{
+  vtkPoints *InPts;
+  const vtkIdType *Lines;
+  const vtkIdType *LineLocations;
+  vtkDataArray *InNormals; //nullptr if generated, or if the default is used
+  bool GenerateNormals;
+  double DefaultNormal[3];
+  vtkDataArray *InScalars;
+  vtkDataArray *InVectors;
+  double Range[2];
+  double MaxSpeed;
+  double Radius;
+  int VaryRadius;
+  double RadiusFactor;
+  int NumberOfSides;
+  bool SidesShareVertices;
+  bool Capping;
+  int OnRatio;
+  int Offset;
+  double Theta;
+  vtkSMPThreadLocal<TubeLine> Line;
+
+  // Compute the sliding normals of the polyline. Each polyline computes its
+  // normals independently, avoiding conflicts at shared vertices. A point
+  // repeated along the polyline (e.g. a closed loop) keeps a single normal,
+  // the last one computed for it.
+  void ComputeNormals(TubeLine &line)
+  {
+    vtkIdType j, npts = static_cast<vtkIdType>(line.Ids.size());
+    if ( !line.LocalPoints )
+    {
+      line.LocalPoints = vtkSmartPointer<vtkPoints>::New();
+      line.LocalPoints->SetDataTypeToDouble();
+      line.LocalLine = vtkSmartPointer<vtkCellArray>::New();
+      line.LocalNormals = vtkSmartPointer<vtkFloatArray>::New();
+      line.LocalNormals->SetNumberOfComponents(3);
+    }
+
+    // Repeated points share the local id of their first occurrence
+    line.SortedIds.resize(npts);
+    for (j=0; j < npts; j++)
+    {
+      line.SortedIds[j] = std::make_pair(line.Ids[j], j);
+    }
+    std::sort(line.SortedIds.begin(), line.SortedIds.end());
+    line.LocalIds.resize(npts);
+    for (vtkIdType first=0, i=0; i < npts; i++)
+    {
+      if ( i == 0 || line.SortedIds[i].first != line.SortedIds[i-1].first )
+      {
+        first = line.SortedIds[i].second;
+      }
+      line.LocalIds[line.SortedIds[i].second] = first;
+    }
+
+    double x[3];
+    line.LocalPoints->SetNumberOfPoints(npts);
+    for (j=0; j < npts; j++)
+    {
+      this->InPts->GetPoint(line.Ids[j], x);
+      line.LocalPoints->SetPoint(j, x);
+    }
+    line.LocalLine->Reset();
+    line.LocalLine->InsertNextCell(npts, line.LocalIds.data());
+    line.LocalNormals->SetNumberOfTuples(npts);
+    vtkPolyLine::GenerateSlidingNormals(line.LocalPoints, line.LocalLine,
+                                        line.LocalNormals);
+
+    line.Normals.resize(3*npts);
+    for (j=0; j < npts; j++)
+    {
+      line.LocalNormals->GetTuple(line.LocalIds[j], line.Normals.data() + 3*j);
+    }
+  }
+
+  // Remove the duplicate points of the polyline and compute the frame of
+  // each point. Use "averaged" segment to create beveled effect. Watch out
+  // for first and last points.
+  int ComputeFrames(vtkIdType lineId, TubeLine &line)
+  {
+    const vtkIdType *cell = this->Lines + this->LineLocations[lineId];
+    line.Ids.assign(cell + 1, cell + 1 + cell[0]);
+    line.Ids.erase(std::unique(line.Ids.begin(), line.Ids.end(),
+                               IdPointsEqual(this->InPts)), line.Ids.end());
+    vtkIdType npts = static_cast<vtkIdType>(line.Ids.size());
+    if (npts < 2)
+    {
+      return LINE_DEGENERATE;
+    }
+    const vtkIdType *pts = line.Ids.data();
+
+    if ( this->GenerateNormals )
+    {
+      this->ComputeNormals(line);
+    }
+    line.Frames.resize(FRAME_SIZE*npts);
+    if ( this->InVectors )
+    {
+      line.Vector.resize(std::max(3, this->InVectors->GetNumberOfComponents()));
+    }
+
+    vtkIdType j;
+    int i;
+    double p[3];
+    double pNext[3];
+    double sNext[3] = {0.0, 0.0, 0.0};
+    double sPrev[3];
+    double n[3];
+    double s[3];
+    double w[3];
+    double nP[3];
+    double sFactor=1.0;
+
+    for (j=0; j < npts; j++)
+    {
+      if ( j == 0 ) //first point
+      {
+        this->InPts->GetPoint(pts[0],p);
+        this->InPts->GetPoint(pts[1],pNext);
+        for (i=0; i<3; i++)
+        {
+          sNext[i] = pNext[i] - p[i];
+          sPrev[i] = sNext[i];
+          line.StartCapNorm[i] = -sPrev[i];
+        }
+        vtkMath::Normalize(line.StartCapNorm);
+      }
+      else if ( j == (npts-1) ) //last point
+      {
+        for (i=0; i<3; i++)
+        {
+          sPrev[i] = sNext[i];
+          p[i] = pNext[i];
+          line.EndCapNorm[i] = sNext[i];
+        }
+        vtkMath::Normalize(line.EndCapNorm);
+      }
+      else
+      {
+        for (i=0; i<3; i++)
+        {
+          p[i] = pNext[i];
+        }
+        this->InPts->GetPoint(pts[j+1],pNext);
+        for (i=0; i<3; i++)
+        {
+          sPrev[i] = sNext[i];
+          sNext[i] = pNext[i] - p[i];
+        }
+      }
+
+      if ( this->GenerateNormals )
+      {
+        std::copy(line.Normals.data() + 3*j, line.Normals.data() + 3*j + 3, n);
+      }
+      else if ( this->InNormals )
+      {
+        this->InNormals->GetTuple(pts[j], n);
+      }
+      else
+      {
+        std::copy(this->DefaultNormal, this->DefaultNormal + 3, n);
+      }
+
+      if ( vtkMath::Normalize(sNext) == 0.0 )
+      {
+        return LINE_COINCIDENT_POINTS;
+      }
+
+      for (i=0; i<3; i++)
+      {
+        s[i] = (sPrev[i] + sNext[i]) / 2.0; //average vector
+      }
+      // if s is zero then just use sPrev cross n
+      if (vtkMath::Normalize(s) == 0.0)
+      {
+        vtkMath::Cross(sPrev,n,s);
+        vtkMath::Normalize(s);
+      }
+
+      vtkMath::Cross(s,n,w);
+      if ( vtkMath::Normalize(w) == 0.0)
+      {
+        std::copy(s, s + 3, line.BadS);
+        std::copy(n, n + 3, line.BadN);
+        return LINE_BAD_NORMAL;
+      }
+
+      vtkMath::Cross(w,s,nP); //create orthogonal coordinate system
+      vtkMath::Normalize(nP);
+
+      // Compute a scale factor based on scalars or vectors
+      if ( this->InScalars && this->VaryRadius == VTK_VARY_RADIUS_BY_SCALAR )
+      {
+        sFactor = 1.0 + ((this->RadiusFactor - 1.0) *
+                  (this->InScalars->GetComponent(pts[j],0) - this->Range[0])
+                         / (this->Range[1]-this->Range[0]));
+      }
+      else if ( this->InVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR )
+      {
+        this->InVectors->GetTuple(pts[j], line.Vector.data());
+        sFactor = sqrt(this->MaxSpeed/vtkMath::Norm(line.Vector.data()));
+        if ( sFactor > this->RadiusFactor )
+        {
+          sFactor = this->RadiusFactor;
+        }
+      }
+      else if ( this->InScalars &&
+                this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR )
+      {
+        sFactor = this->InScalars->GetComponent(pts[j],0);
+        if (sFactor < 0.0)
+        {
+          return LINE_NEGATIVE_SCALAR;
+        }
+      }
+
+      double *frame = line.Frames.data() + FRAME_SIZE*j;
+      std::copy(p, p + 3, frame);
+      std::copy(w, w + 3, frame + 3);
+      std::copy(nP, nP + 3, frame + 6);
+      frame[9] = sFactor;
+    }//for all points in polyline
+
+    return LINE_VALID;
+  }
+
+  // The number of points of the tube around a polyline of npts points
+  vtkIdType GetNumberOfPoints(vtkIdType npts) const
+  {
+    vtkIdType numPts = this->NumberOfSides * npts;
+    if ( ! this->SidesShareVertices )
+    {
+      numPts *= 2; //points are duplicated
+    }
+    if ( this->Capping )
+    {
+      numPts += 2*this->NumberOfSides; //cap points are duplicated
+    }
+    return numPts;
+  }
+
+  // The number of strips along the sides of a tube
+  vtkIdType GetNumberOfSideStrips() const
+  {
+    vtkIdType numStrips = 0;
+    for (int k=this->Offset; k<(this->NumberOfSides+this->Offset);
+         k+=this->OnRatio)
+    {
+      numStrips++;
+    }
+    return numStrips;
+  }
+};
+
+// First pass: compute the frames of each polyline, and the number of points
+// left once the duplicate points are removed.
+struct CountTubes
+{
+  TubeGenerator *Tubes;
+  unsigned char *Status;
+  vtkIdType *NumberOfLinePoints;
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    TubeLine &line = this->Tubes->Line.Local();
+    for ( ; lineId < endLineId; lineId++)
+    {
+      this->Status[lineId] =
+        static_cast<unsigned char>(this->Tubes->ComputeFrames(lineId, line));
+      this->NumberOfLinePoints[lineId] = static_cast<vtkIdType>(line.Ids.size());
+    }
+  }
+};
+
+// The output of the tubes, and how the attributes are copied. Attributes
+// are copied by the array lists when they are given; otherwise the input
+// point id of each output point is recorded so that the point data can be
+// copied afterwards.
+struct TubeOutput
+{
+  TubeGenerator *Tubes;
+  const unsigned char *Status;
+  const TubeOffsets *Offsets;
+  vtkIdType FirstCellId; //the line cellIds start after the last vert cellId
+  float *NewNormals;
+  float *NewTCoords;
+  int GenerateTCoords;
+  double TextureLength;
+  vtkDataArray *InScalars;
+  vtkIdType *NewStrips;
+  ArrayList *PointArrays;
+  ArrayList *CellArrays;
+  vtkIdType *PointIds;
+};
+
+// Second pass: generate the points, strips and texture coordinates of the
+// tube around each valid polyline.
+template <typename TP>
+struct GenerateTubes : public TubeOutput
+{
+  TP *NewPts;
+
+  GenerateTubes(const TubeOutput &output, TP *newPts) :
+    TubeOutput(output), NewPts(newPts)
+  {
+  }
+
+  void CopyPointData(vtkIdType inId, vtkIdType outId)
+  {
+    if ( this->PointArrays )
+    {
+      this->PointArrays->Copy(inId, outId);
+    }
+    if ( this->PointIds )
+    {
+      this->PointIds[outId] = inId;
+    }
+  }
+
+  void InsertPoint(vtkIdType ptId, const double x[3], const double normal[3])
+  {
+    TP *p = this->NewPts + 3*ptId;
+    float *n = this->NewNormals + 3*ptId;
+    for (int i=0; i<3; i++)
+    {
+      p[i] = static_cast<TP>(x[i]);
+      n[i] = static_cast<float>(normal[i]);
+    }
+  }
+
+  void InsertCapPoint(vtkIdType ptId, vtkIdType fromId, const double normal[3])
+  {
+    TP *p = this->NewPts + 3*ptId;
+    float *n = this->NewNormals + 3*ptId;
+    for (int i=0; i<3; i++)
+    {
+      p[i] = this->NewPts[3*fromId+i];
+      n[i] = static_cast<float>(normal[i]);
+    }
+  }
+
+  void GeneratePoints(vtkIdType offset, const TubeLine &line)
+  {
+    const TubeGenerator *tubes = this->Tubes;
+    vtkIdType npts = static_cast<vtkIdType>(line.Ids.size());
+    const vtkIdType *pts = line.Ids.data();
+    vtkIdType j;
+    int i, k;
+    double s[3];
+    double normal[3];
+    vtkIdType ptId=offset;
+
+    for (j=0; j < npts; j++)
+    {
+      const double *frame = line.Frames.data() + FRAME_SIZE*j;
+      const double *p = frame;
+      const double *w = frame + 3;
+      const double *nP = frame + 6;
+      double sFactor = frame[9];
+
+      //create points around line
+      if (tubes->SidesShareVertices)
+      {
+        for (k=0; k < tubes->NumberOfSides; k++)
+        {
+          for (i=0; i<3; i++)
+          {
+            normal[i] = w[i]*cos((double)k*tubes->Theta) +
+              nP[i]*sin((double)k*tubes->Theta);
+            s[i] = p[i] + tubes->Radius * sFactor * normal[i];
+          }
+          this->InsertPoint(ptId,s,normal);
+          this->CopyPointData(pts[j],ptId);
+          ptId++;
+        }//for each side
+      }
+      else
+      {
+        double n_left[3], n_right[3];
+        for (k=0; k < tubes->NumberOfSides; k++)
+        {
+          for (i=0; i<3; i++)
+          {
+            // Create duplicate vertices at each point
+            // and adjust the associated normals so that they are
+            // oriented with the facets. This preserves the tube's
+            // polygonal appearance, as if by flat-shading around the tube,
+            // while still allowing smooth (gouraud) shading along the
+            // tube as it bends.
+            normal[i]  = w[i]*cos((double)(k+0.0)*tubes->Theta) +
+              nP[i]*sin((double)(k+0.0)*tubes->Theta);
+            n_right[i] = w[i]*cos((double)(k-0.5)*tubes->Theta) +
+              nP[i]*sin((double)(k-0.5)*tubes->Theta);
+            n_left[i]  = w[i]*cos((double)(k+0.5)*tubes->Theta) +
+              nP[i]*sin((double)(k+0.5)*tubes->Theta);
+            s[i] = p[i] + tubes->Radius * sFactor * normal[i];
+          }
+          this->InsertPoint(ptId,s,n_right);
+          this->CopyPointData(pts[j],ptId);
+          this->InsertPoint(ptId+1,s,n_left);
+          this->CopyPointData(pts[j],ptId+1);
+          ptId += 2;
+        }//for each side
+      }//else separate vertices
+    }//for all points in polyline
+
+    //Produce end points for cap. They are placed at tail end of points.
+    if (tubes->Capping)
+    {
+      int numCapSides = tubes->NumberOfSides;
+      int capIncr = 1;
+      if ( ! tubes->SidesShareVertices )
+      {
+        numCapSides = 2 * tubes->NumberOfSides;
+        capIncr = 2;
+      }
+
+      //the start cap
+      for (k=0; k < numCapSides; k+=capIncr)
+      {
+        this->InsertCapPoint(ptId,offset+k,line.StartCapNorm);
+        this->CopyPointData(pts[0],ptId);
+        ptId++;
+      }
+      //the end cap
+      vtkIdType endOffset = offset + (npts-1)*tubes->NumberOfSides;
+      if ( ! tubes->SidesShareVertices )
+      {
+        endOffset = offset + 2*(npts-1)*tubes->NumberOfSides;
+      }
+      for (k=0; k < numCapSides; k+=capIncr)
+      {
+        this->InsertCapPoint(ptId,endOffset+k,line.EndCapNorm);
+        this->CopyPointData(pts[npts-1],ptId);
+        ptId++;
+      }
+    }//if capping
+  }
+
+  void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType inCellId,
+                      vtkIdType outCellId, vtkIdType *strips)
+  {
+    const TubeGenerator *tubes = this->Tubes;
+    vtkIdType i, i3;
+    int k;
+    int i1, i2;
+
+    for (k=tubes->Offset; k<(tubes->NumberOfSides+tubes->Offset);
+         k+=tubes->OnRatio)
+    {
+      if (tubes->SidesShareVertices)
+      {
+        i1 = k % tubes->NumberOfSides;
+        i2 = (k+1) % tubes->NumberOfSides;
+      }
+      else
+      {
+        i1 = 2*(k % tubes->NumberOfSides) + 1;
+        i2 = 2*((k+1) % tubes->NumberOfSides);
+      }
+      if ( this->CellArrays )
+      {
+        this->CellArrays->Copy(inCellId,outCellId);
+      }
+      outCellId++;
+      *strips++ = npts*2;
+      for (i=0; i < npts; i++)
+      {
+        i3 = i*tubes->NumberOfSides;
+        if ( ! tubes->SidesShareVertices )
+        {
+          i3 *= 2;
+        }
+        *strips++ = offset+i2+i3;
+        *strips++ = offset+i1+i3;
+      }
+    } //for each side of the tube
+
+    // Take care of capping. The caps are n-sided polygons that can be
+    // easily triangle stripped.
+    if (tubes->Capping)
+    {
+      vtkIdType startIdx = offset + npts*tubes->NumberOfSides;
+
+      if ( ! tubes->SidesShareVertices )
+      {
+        startIdx = offset + 2*npts*tubes->NumberOfSides;
+      }
+
+      //The start cap
+      if ( this->CellArrays )
+      {
+        this->CellArrays->Copy(inCellId,outCellId);
+        this->CellArrays->Copy(inCellId,outCellId+1);
+      }
+      *strips++ = tubes->NumberOfSides;
+      *strips++ = startIdx;
+      *strips++ = startIdx+1;
+      for (i1=tubes->NumberOfSides-1, i2=2, k=0; k<(tubes->NumberOfSides-2); k++)
+      {
+        if ( (k%2) )
+        {
+          *strips++ = startIdx + i2;
+          i2++;
+        }
+        else
+        {
+          *strips++ = startIdx + i1;
+          i1--;
+        }
+      }
+
+      //The end cap - reversed order to be consistent with normal
+      startIdx += tubes->NumberOfSides;
+      *strips++ = tubes->NumberOfSides;
+      *strips++ = startIdx;
+      *strips++ = startIdx+tubes->NumberOfSides-1;
+      for (i1=tubes->NumberOfSides-2, i2=1, k=0; k<(tubes->NumberOfSides-2); k++)
+      {
+        if ( (k%2) )
+        {
+          *strips++ = startIdx + i1;
+          i1--;
+        }
+        else
+        {
+          *strips++ = startIdx + i2;
+          i2++;
+        }
+      }
+    }
+  }
+
+  void InsertTCoord(vtkIdType ptId, double s, double t)
+  {
+    this->NewTCoords[2*ptId] = static_cast<float>(s);
+    this->NewTCoords[2*ptId+1] = static_cast<float>(t);
+  }
+
+  void GenerateTextureCoords(vtkIdType offset, const TubeLine &line)
+  {
+    const TubeGenerator *tubes = this->Tubes;
+    vtkIdType npts = static_cast<vtkIdType>(line.Ids.size());
+    const vtkIdType *pts = line.Ids.data();
+    vtkPoints *inPts = tubes->InPts;
+    vtkIdType i;
+    int k;
+    double tc=0.0;
+
+    int numSides = tubes->NumberOfSides;
+    if ( ! tubes->SidesShareVertices )
+    {
+      numSides = 2 * tubes->NumberOfSides;
+    }
+
+    double s0, s;
+    if ( this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS )
+    {
+      s0 = this->InScalars->GetTuple1(pts[0]);
+      for (i=0; i < npts; i++)
+      {
+        s = this->InScalars->GetTuple1(pts[i]);
+        tc = (s - s0) / this->TextureLength;
+        for ( k=0; k < numSides; k++)
+        {
+          double tcy = static_cast<double>(k) / (numSides - 1);
+          this->InsertTCoord(offset + i * numSides + k, tc, tcy);
+        }
+      }
+    }
+    else if ( this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH )
+    {
+      double xPrev[3], x[3], len=0.0;
+      inPts->GetPoint(pts[0],xPrev);
+      for (i=0; i < npts; i++)
+      {
+        inPts->GetPoint(pts[i],x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x, xPrev));
+        tc = len / this->TextureLength;
+        for ( k=0; k < numSides; k++)
+        {
+          double tcy = static_cast<double>(k) / (numSides - 1);
+          this->InsertTCoord(offset + i * numSides + k, tc, tcy);
+        }
+
+        xPrev[0]=x[0]; xPrev[1]=x[1]; xPrev[2]=x[2];
+      }
+    }
+    else if ( this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH )
+    {
+      double xPrev[3], x[3], length=0.0, len=0.0;
+      inPts->GetPoint(pts[0],xPrev);
+      for (i=0; i < npts; i++)
+      {
+        inPts->GetPoint(pts[i],x);
+        length += sqrt(vtkMath::Distance2BetweenPoints(x,xPrev));
+        xPrev[0]=x[0]; xPrev[1]=x[1]; xPrev[2]=x[2];
+      }
+
+      inPts->GetPoint(pts[0],xPrev);
+      for (i=0; i < npts; i++)
+      {
+        inPts->GetPoint(pts[i],x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x,xPrev));
+        tc = len / length;
+        for ( k=0; k < numSides; k++)
+        {
+          double tcy = static_cast<double>(k) / (numSides - 1);
+          this->InsertTCoord(offset + i * numSides + k, tc, tcy);
+        }
+        xPrev[0]=x[0]; xPrev[1]=x[1]; xPrev[2]=x[2];
+      }
+    }
+
+    // Capping, set the endpoints as appropriate
+    if ( tubes->Capping )
+    {
+      int ik;
+      vtkIdType startIdx = offset + npts*numSides;
+
+      //start cap
+      for (ik=0; ik < tubes->NumberOfSides; ik++)
+      {
+        this->InsertTCoord(startIdx+ik,0.0,0.0);
+      }
+
+      //end cap
+      for (ik=0; ik < tubes->NumberOfSides; ik++)
+      {
+        this->InsertTCoord(startIdx+tubes->NumberOfSides+ik,tc,0.0);
+      }
+    }
+  }
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    TubeLine &line = this->Tubes->Line.Local();
+    for ( ; lineId < endLineId; lineId++)
+    {
+      if ( this->Status[lineId] != LINE_VALID )
+      {
+        continue;
+      }
+      this->Tubes->ComputeFrames(lineId, line);
+      const TubeOffsets &offsets = this->Offsets[lineId];
+      this->GeneratePoints(offsets.Points, line);
+      this->GenerateStrips(offsets.Points, static_cast<vtkIdType>(line.Ids.size()),
+                           this->FirstCellId + lineId, offsets.Cells,
+                           this->NewStrips + offsets.Connectivity);
+      if ( this->NewTCoords )
+      {
+        this->GenerateTextureCoords(offsets.Points, line);
+      }
+    }
+  }
+};
+
+template <typename TP>
+void GenerateAllTubes(const TubeOutput &output, TP *newPts, vtkIdType numLines)
+{
+  GenerateTubes<TP> generate(output, newPts);
+  vtkSMPTools::For(0, numLines, generate);
 }
 
+} // anonymous namespace
+
 int vtkTubeFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -112,18 +837,10 @@ int vtkTubeFilter::RequestData(
   vtkIdType numPts;
   vtkIdType numLines;
   vtkIdType numNewPts, numNewCells;
-  vtkPoints *newPts;
-  int deleteNormals=0;
-  vtkFloatArray *newNormals;
   vtkIdType i;
   double range[2], maxSpeed=0;
-  vtkCellArray *newStrips;
-  vtkIdType npts=0, *pts=nullptr;
-  vtkIdType offset=0;
-  vtkFloatArray *newTCoords=nullptr;
-  int abort=0;
-  vtkIdType inCellId;
-  double oldRadius=1.0;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
+  double radius=this->Radius;
 
   // Check input and initialize
   //
@@ -137,72 +854,37 @@ int vtkTubeFilter::RequestData(
     return 1;
   }
 
-  // Create the geometry and topology
-  numNewPts = numPts * this->NumberOfSides;
-  newPts = vtkPoints::New();
-
-  // Set the desired precision for the points in the output.
-  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
-  {
-    newPts->SetDataType(inPts->GetDataType());
-  }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_FLOAT);
-  }
-  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
-  {
-    newPts->SetDataType(VTK_DOUBLE);
-  }
-
-  newPts->Allocate(numNewPts);
-  newNormals = vtkFloatArray::New();
-  newNormals->SetName("TubeNormals");
-  newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3*numNewPts);
-  newStrips = vtkCellArray::New();
-  newStrips->Allocate(newStrips->EstimateSize(1,numNewPts));
-  vtkCellArray *singlePolyline = vtkCellArray::New();
-
-  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
-  outPD->CopyNormalsOff();
-  if ( (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
-       this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
-       this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH )
-  {
-    newTCoords = vtkFloatArray::New();
-    newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
-    outPD->CopyTCoordsOff();
-  }
-  outPD->CopyAllocate(pd,numNewPts);
-
-  int generateNormals = 0;
+  TubeGenerator tubes;
+  tubes.InPts = inPts;
+  tubes.InNormals = nullptr;
+  tubes.GenerateNormals = false;
   if ( !(inNormals=pd->GetNormals()) || this->UseDefaultNormal )
   {
-    deleteNormals = 1;
-    inNormals = vtkFloatArray::New();
-    inNormals->SetNumberOfComponents(3);
-    inNormals->SetNumberOfTuples(numPts);
-
     if ( this->UseDefaultNormal )
     {
-      for ( i=0; i < numPts; i++)
+      // The default normal used to be stored as a float
+      for (i=0; i < 3; i++)
       {
-        inNormals->SetTuple(i,this->DefaultNormal);
+        tubes.DefaultNormal[i] = static_cast<float>(this->DefaultNormal[i]);
       }
     }
     else
     {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their tubes) calculated independently
-      generateNormals = 1;
+      // Normals are generated for each polyline. This allows different
+      // polylines to share vertices, but have their normals (and hence
+      // their tubes) calculated independently.
+      tubes.GenerateNormals = true;
     }
   }
+  else
+  {
+    tubes.InNormals = inNormals;
+  }
 
   // If varying width, get appropriate info.
   //
+  range[0] = 0.0;
+  range[1] = 1.0;
   if ( inScalars )
   {
     inScalars->GetRange(range,0);
@@ -216,9 +898,8 @@ int vtkTubeFilter::RequestData(
     }
     if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
     {
-      // temporarily set the radius to 1.0 so that radius*scalar = scalar
-      oldRadius = this->Radius;
-      this->Radius = 1.0;
+      // use a radius of 1.0 so that radius*scalar = scalar
+      radius = 1.0;
       if (range[0] < 0.0)
       {
         vtkWarningMacro(<< "Scalar values fall below zero when using absolute radius values!");
@@ -230,105 +911,207 @@ int vtkTubeFilter::RequestData(
     maxSpeed = inVectors->GetMaxNorm();
   }
 
-  // Copy selected parts of cell data; certainly don't want normals
-  //
-  numNewCells = inLines->GetNumberOfCells() * this->NumberOfSides + 2;
-  outCD->CopyNormalsOff();
-  outCD->CopyAllocate(cd,numNewCells);
-
-  //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
-  //
-  this->Theta = 2.0*vtkMath::Pi() / this->NumberOfSides;
-  vtkPolyLine *lineNormalGenerator = vtkPolyLine::New();
-  // the line cellIds start after the last vert cellId
-  inCellId = input->GetNumberOfVerts();
-  for (inLines->InitTraversal();
-       inLines->GetNextCell(npts,pts) && !abort; inCellId++)
-  {
-    this->UpdateProgress((double)inCellId/numLines);
-    abort = this->GetAbortExecute();
-
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) -
-           pts);
-    if (npts < 2)
-    {
-      continue; //skip tubing this polyline
-    }
+  tubes.InScalars = inScalars;
+  tubes.InVectors = inVectors;
+  tubes.Range[0] = range[0];
+  tubes.Range[1] = range[1];
+  tubes.MaxSpeed = maxSpeed;
+  tubes.Radius = radius;
+  tubes.VaryRadius = this->VaryRadius;
+  tubes.RadiusFactor = this->RadiusFactor;
+  tubes.NumberOfSides = this->NumberOfSides;
+  tubes.SidesShareVertices = (this->SidesShareVertices != 0);
+  tubes.Capping = (this->Capping != 0);
+  tubes.OnRatio = this->OnRatio;
+  tubes.Offset = this->Offset;
+  tubes.Theta = 2.0*vtkMath::Pi() / this->NumberOfSides;
+#if !defined(VTK_LEGACY_REMOVE)
+  this->Theta = tubes.Theta;
+#endif
+
+  // Locate the polylines in the connectivity array
+  std::vector<vtkIdType> lineLocations(numLines);
+  const vtkIdType *lines = inLines->GetPointer();
+  vtkIdType loc = 0;
+  for (i=0; i < numLines; i++)
+  {
+    lineLocations[i] = loc;
+    loc += lines[loc] + 1;
+  }
+  tubes.Lines = lines;
+  tubes.LineLocations = lineLocations.data();
+
+  // Compute the frames along each polyline to find out which polylines can
+  // be tubed, and how many points each tube has.
+  std::vector<unsigned char> status(numLines);
+  std::vector<vtkIdType> numLinePts(numLines);
+  CountTubes count;
+  count.Tubes = &tubes;
+  count.Status = status.data();
+  count.NumberOfLinePoints = numLinePts.data();
+  vtkSMPTools::For(0, numLines, count);
+  this->UpdateProgress(0.5);
+  if ( this->GetAbortExecute() )
+  {
+    return 1;
+  }
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
+  // Accumulate the size of the tubes. The tube is not generated if the
+  // polyline is bad; warnings are reported in the order of the polylines.
+  std::vector<TubeOffsets> offsets(numLines+1);
+  offsets[0].Points = offsets[0].Cells = offsets[0].Connectivity = 0;
+  vtkIdType numSideStrips = tubes.GetNumberOfSideStrips();
+  TubeLine badLine;
+  for (i=0; i < numLines; i++)
+  {
+    offsets[i+1] = offsets[i];
+    if ( status[i] == LINE_VALID )
     {
-      singlePolyline->Reset(); //avoid instantiation
-      singlePolyline->InsertNextCell(npts,pts);
-      lineNormalGenerator->GenerateSlidingNormals(inPts,singlePolyline, inNormals);
+      vtkIdType npts = numLinePts[i];
+      offsets[i+1].Points += tubes.GetNumberOfPoints(npts);
+      offsets[i+1].Cells += numSideStrips;
+      offsets[i+1].Connectivity += numSideStrips * (2*npts + 1);
+      if ( this->Capping )
+      {
+        offsets[i+1].Cells += 2;
+        offsets[i+1].Connectivity += 2 * (this->NumberOfSides + 1);
+      }
     }
-
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if ( !this->GeneratePoints(offset,npts,pts,inPts,newPts,pd,outPD,
-                               newNormals,inScalars,range,inVectors,
-                               maxSpeed,inNormals) )
+    else if ( status[i] != LINE_DEGENERATE )
     {
+      if ( status[i] == LINE_COINCIDENT_POINTS )
+      {
+        vtkWarningMacro(<<"Coincident points!");
+      }
+      else if ( status[i] == LINE_BAD_NORMAL )
+      {
+        tubes.ComputeFrames(i, badLine);
+        double *s = badLine.BadS, *n = badLine.BadN;
+        vtkWarningMacro(<<"Bad normal s = " <<s[0]<<" "<<s[1]<<" "<< s[2]
+                        << " n = " << n[0] << " " << n[1] << " " << n[2]);
+      }
+      else
+      {
+        vtkWarningMacro(<<"Scalar value less than zero, skipping line");
+      }
       vtkWarningMacro(<< "Could not generate points!");
-      continue; //skip tubing this polyline
     }
+  }
+  numNewPts = offsets[numLines].Points;
+  numNewCells = offsets[numLines].Cells;
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset,npts,pts,inCellId,cd,outCD,newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if ( newTCoords )
-    {
-      this->GenerateTextureCoords(offset,npts,pts,inPts,inScalars,newTCoords);
-    }
+  // Create the geometry and topology
+  vtkNew<vtkPoints> newPts;
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset,npts);
+  // Set the desired precision for the points in the output.
+  if(this->OutputPointsPrecision == vtkAlgorithm::DEFAULT_PRECISION)
+  {
+    newPts->SetDataType(inPts->GetDataType());
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::SINGLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_FLOAT);
+  }
+  else if(this->OutputPointsPrecision == vtkAlgorithm::DOUBLE_PRECISION)
+  {
+    newPts->SetDataType(VTK_DOUBLE);
+  }
 
-  }//for all polylines
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkFloatArray> newNormals;
+  newNormals->SetName("TubeNormals");
+  newNormals->SetNumberOfComponents(3);
+  newNormals->SetNumberOfTuples(numNewPts);
+  vtkNew<vtkCellArray> newStrips;
+  vtkIdType *strips = newStrips->WritePointer(numNewCells,
+                                              offsets[numLines].Connectivity);
 
-  singlePolyline->Delete();
+  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
+  outPD->CopyNormalsOff();
+  if ( (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+       this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+       this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH )
+  {
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(2);
+    newTCoords->SetNumberOfTuples(numNewPts);
+    outPD->CopyTCoordsOff();
+  }
+  outPD->CopyAllocate(pd,numNewPts);
+  ArrayList pointArrays;
+  std::vector<vtkIdType> pointIds;
+  if ( ArrayList::CanCopyArrays(pd, outPD) )
+  {
+    pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+  }
+  else
+  {
+    pointIds.resize(numNewPts);
+  }
 
-  // reset the radius to ite original value if necessary
-  if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
+  // Copy selected parts of cell data; certainly don't want normals
+  //
+  outCD->CopyNormalsOff();
+  outCD->CopyAllocate(cd,numNewCells);
+  ArrayList cellArrays;
+  bool serialCellData = !ArrayList::CanCopyArrays(cd, outCD);
+  if ( !serialCellData )
   {
-    this->Radius = oldRadius;
+    cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
   }
 
-  // Update ourselves
+  //  Create points along each polyline that are connected into NumberOfSides
+  //  triangle strips. Texture coordinates are optionally generated.
   //
-  if ( deleteNormals )
+  TubeOutput tubeOutput;
+  tubeOutput.Tubes = &tubes;
+  tubeOutput.Status = status.data();
+  tubeOutput.Offsets = offsets.data();
+  tubeOutput.FirstCellId = input->GetNumberOfVerts();
+  tubeOutput.NewNormals = newNormals->GetPointer(0);
+  tubeOutput.NewTCoords = (newTCoords ? newTCoords->GetPointer(0) : nullptr);
+  tubeOutput.GenerateTCoords = this->GenerateTCoords;
+  tubeOutput.TextureLength = this->TextureLength;
+  tubeOutput.InScalars = inScalars;
+  tubeOutput.NewStrips = strips;
+  tubeOutput.PointArrays = (pointArrays.Arrays.empty() ? nullptr : &pointArrays);
+  tubeOutput.CellArrays = (cellArrays.Arrays.empty() ? nullptr : &cellArrays);
+  tubeOutput.PointIds = (pointIds.empty() ? nullptr : pointIds.data());
+  switch (newPts->GetDataType())
   {
-    inNormals->Delete();
+    vtkTemplateMacro(GenerateAllTubes(tubeOutput,
+      static_cast<VTK_TT*>(newPts->GetVoidPointer(0)), numLines));
   }
 
+  // Copy the attributes which could not be copied in parallel
+  for (i=0; i < static_cast<vtkIdType>(pointIds.size()); i++)
+  {
+    outPD->CopyData(pd,pointIds[i],i);
+  }
+  for (vtkIdType lineId=0; serialCellData && lineId < numLines; lineId++)
+  {
+    vtkIdType inCellId = input->GetNumberOfVerts() + lineId;
+    for (i=offsets[lineId].Cells; i < offsets[lineId+1].Cells; i++)
+    {
+      outCD->CopyData(cd,inCellId,i);
+    }
+  }
+
+  // Update ourselves
+  //
   if ( newTCoords )
   {
     outPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
   output->SetPoints(newPts);
-  newPts->Delete();
-
   output->SetStrips(newStrips);
-  newStrips->Delete();
-
   outPD->SetNormals(newNormals);
-  newNormals->Delete();
-  lineNormalGenerator->Delete();
-
-  output->Squeeze();
 
   return 1;
 }
 
+#if !defined(VTK_LEGACY_REMOVE)
 int vtkTubeFilter::GeneratePoints(vtkIdType offset,
                                   vtkIdType npts, vtkIdType *pts,
                                   vtkPoints *inPts, vtkPoints *newPts,
@@ -354,6 +1137,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset,
   double normal[3];
   vtkIdType ptId=offset;
 
+  VTK_LEGACY_BODY(vtkTubeFilter::GeneratePoints, "VTK 9.0");
+
   // Use "averaged" segment to create beveled effect.
   // Watch out for first and last points.
   //
@@ -570,6 +1355,8 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
   int k;
   int i1, i2, i3;
 
+  VTK_LEGACY_BODY(vtkTubeFilter::GenerateStrips, "VTK 9.0");
+
   if (this->SidesShareVertices)
   {
     for (k=this->Offset; k<(this->NumberOfSides+this->Offset);
@@ -672,6 +1459,8 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset,
   int k;
   double tc=0.0;
 
+  VTK_LEGACY_BODY(vtkTubeFilter::GenerateTextureCoords, "VTK 9.0");
+
   int numSides = this->NumberOfSides;
   if ( ! this->SidesShareVertices )
   {
@@ -760,6 +1549,8 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset,
 // Compute the number of points in this tube
 vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
 {
+  VTK_LEGACY_BODY(vtkTubeFilter::ComputeOffset, "VTK 9.0");
+
   if ( this->SidesShareVertices )
   {
     offset += this->NumberOfSides * npts;
@@ -776,6 +1567,7 @@ vtkIdType vtkTubeFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
 
   return offset;
 }
+#endif
 
 // Description:
 // Return the method of varying tube radius descriptive character string.
@@ -34,6 +34,11 @@
  * common use is to combine this filter with vtkStreamTracer to generate
  * streamtubes.
  *
+ * The polylines are tubed in parallel (using vtkSMPTools). A first pass
+ * counts the points and strips of the tube around each polyline, and once
+ * the output is allocated a second pass generates the tubes in place. The
+ * output is the same as if the polylines were tubed one after the other.
+ *
  * @warning
  * The number of tube sides must be greater than 3. If you wish to use fewer
  * sides (i.e., a ribbon), use vtkRibbonFilter.
@@ -250,23 +255,33 @@ protected:
   int OutputPointsPrecision;
   double TextureLength; //this length is mapped to [0,1) texture space
 
-  // Helper methods
-  int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
-                     vtkPoints *inPts, vtkPoints *newPts,
-                     vtkPointData *pd, vtkPointData *outPD,
-                     vtkFloatArray *newNormals, vtkDataArray *inScalars,
-                     double range[2], vtkDataArray *inVectors, double maxNorm,
-                     vtkDataArray *inNormals);
-  void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
-                      vtkIdType inCellId, vtkCellData *cd, vtkCellData *outCD,
-                      vtkCellArray *newStrips);
-  void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
-                             vtkPoints *inPts, vtkDataArray *inScalars,
-                            vtkFloatArray *newTCoords);
-  vtkIdType ComputeOffset(vtkIdType offset,vtkIdType npts);
+  //@{
+  /**
+   * Helper methods of the former serial implementation, which tubed one
+   * polyline at a time. RequestData() no longer calls them; it tubes the
+   * polylines in parallel.
+   * @deprecated VTK 9.0. Subclasses that overrode them should override
+   * RequestData() instead.
+   */
+  VTK_LEGACY(int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                                vtkPoints *inPts, vtkPoints *newPts,
+                                vtkPointData *pd, vtkPointData *outPD,
+                                vtkFloatArray *newNormals, vtkDataArray *inScalars,
+                                double range[2], vtkDataArray *inVectors, double maxNorm,
+                                vtkDataArray *inNormals));
+  VTK_LEGACY(void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                                 vtkIdType inCellId, vtkCellData *cd, vtkCellData *outCD,
+                                 vtkCellArray *newStrips));
+  VTK_LEGACY(void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                                        vtkPoints *inPts, vtkDataArray *inScalars,
+                                        vtkFloatArray *newTCoords));
+  VTK_LEGACY(vtkIdType ComputeOffset(vtkIdType offset,vtkIdType npts));
+  //@}
 
-  // Helper data members
+#if !defined(VTK_LEGACY_REMOVE)
+  // Helper data member of the legacy helper methods, set by RequestData()
   double Theta;
+#endif
 
 private:
   vtkTubeFilter(const vtkTubeFilter&) = delete;
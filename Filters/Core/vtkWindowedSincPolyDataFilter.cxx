@@ -23,10 +23,13 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkSmoothingStencils.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 //-----------------------------------------------------------------------------
@@ -52,17 +55,141 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->NormalizeCoordinates = 0;
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
+namespace
+{
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
+//-----------------------------------------------------------------------------
+// First iteration of the windowed sinc filter:
+// x1 = x0 - 0.5 laplacian(x0) and x3 = c0 x0 + c1 x1
+struct FirstIteration
 {
-  char      type;
-  vtkIdList *edges; // connected edges (list of connected point ids)
-} vtkMeshVertex, *vtkMeshVertexPtr;
+  const vtkIdType *Offsets;
+  const vtkIdType *Stencils;
+  const char *Types;
+  const double *C;
+  const float *X0;
+  float *X1;
+  float *X3;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double x[3], deltaX[3];
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const vtkIdType *stencil = this->Stencils + this->Offsets[i];
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      const float *x0 = this->X0 + 3*i;
+      float *x1 = this->X1 + 3*i;
+      float *x3 = this->X3 + 3*i;
+      if ( npts > 0 )
+      {
+        // point is allowed to move
+        x[0] = x0[0]; x[1] = x0[1]; x[2] = x0[2];
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+
+        // calculate the negative of the laplacian
+        for (vtkIdType j=0; j<npts; j++) //for all connected points
+        {
+          const float *y = this->X0 + 3*stencil[j];
+          for (int k=0; k<3; k++)
+          {
+            deltaX[k] += (x[k] - y[k]) / npts;
+          }
+        }
+        for (int k=0; k<3; k++)
+        {
+          deltaX[k] = x[k] - 0.5*deltaX[k];
+          x1[k] = static_cast<float>(deltaX[k]);
+        }
+
+        // calculate x3 = c0 x0 + c1 x1
+        for (int k=0; k < 3; k++)
+        {
+          x3[k] = this->Types[i] == VTK_FIXED_VERTEX ? x0[k] :
+            static_cast<float>(this->C[0]*x[k] + this->C[1]*deltaX[k]);
+        }
+      }//if can move point
+      else
+      {
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        for (int k=0; k < 3; k++)
+        {
+          x1[k] = 0.0f;
+          x3[k] = x0[k];
+        }
+      }
+    }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// Next iterations: x2 = (x1 - x0) + (x1 - laplacian(x1)) and x3 += cj x2.
+// Only x2 and x3 are written, the points that cannot move already have a
+// zero x1.
+struct NextIteration
+{
+  const vtkIdType *Offsets;
+  const vtkIdType *Stencils;
+  const char *Types;
+  double C;
+  const float *X0;
+  const float *X1;
+  float *X2;
+  float *X3;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double deltaX[3];
+    for (vtkIdType i = begin; i < end; i++)
+    {
+      const vtkIdType *stencil = this->Stencils + this->Offsets[i];
+      vtkIdType npts = this->Offsets[i+1] - this->Offsets[i];
+      float *x2 = this->X2 + 3*i;
+      if ( npts > 0 )
+      {
+        // point is allowed to move
+        const float *p_x0 = this->X0 + 3*i;
+        const float *p_x1 = this->X1 + 3*i;
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+
+        // calculate the negative laplacian of x1
+        for (vtkIdType j=0; j<npts; j++)
+        {
+          const float *y = this->X1 + 3*stencil[j];
+          for (int k=0; k<3; k++)
+          {
+            deltaX[k] += (static_cast<double>(p_x1[k]) - y[k]) / npts;
+          }
+        }//for all connected points
+
+        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+        for (int k=0; k<3; k++)
+        {
+          deltaX[k] = static_cast<double>(p_x1[k]) - p_x0[k] + p_x1[k] - deltaX[k];
+          x2[k] = static_cast<float>(deltaX[k]);
+        }
+
+        // smooth the vertex (x3 = x3 + cj x2)
+        if ( this->Types[i] != VTK_FIXED_VERTEX )
+        {
+          float *x3 = this->X3 + 3*i;
+          for (int k=0; k<3; k++)
+          {
+            x3[k] = static_cast<float>(x3[k] + this->C * deltaX[k]);
+          }
+        }
+      }//if can move point
+      else
+      {
+        // point is not allowed to move (zero out the Laplacian)
+        x2[0] = x2[1] = x2[2] = 0.0f;
+      }
+    }
+  }
+};
+
+} // anonymous namespace
 
 //-----------------------------------------------------------------------------
 int vtkWindowedSincPolyDataFilter::RequestData(
@@ -81,12 +208,10 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numPts, numCells, numPolys, numStrips, i;
-  int j, k;
+  int j;
   vtkIdType npts = 0;
   vtkIdType *pts = nullptr;
-  vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
-  double x1[3], x2[3], x3[3], l1[3], l2[3];
+  double x1[3], x2[3], x3[3];
   double CosFeatureAngle; //Cosine of angle between adjacent polys
   double CosEdgeAngle; // Cosine of angle between adjacent edges
   int iterationNumber;
@@ -96,10 +221,9 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   vtkTriangleFilter *toTris=nullptr;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints *newPts[4];
-  vtkMeshVertexPtr Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -148,12 +272,8 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   // vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
   // using a subset of the attached vertices.
   vtkDebugMacro(<<"Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i=0; i<numPts; i++)
-  {
-    Verts[i].type = VTK_SIMPLE_VERTEX; //can smooth
-    Verts[i].edges = nullptr;
-  }
+  std::vector<char> lineTypes(numPts, VTK_SIMPLE_VERTEX);
+  std::vector<vtkIdType> lineEdges;
 
   inPts = input->GetPoints();
 
@@ -163,15 +283,19 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   {
     for (j=0; j<npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      lineTypes[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
 
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines=input->GetLines(), inLines->InitTraversal();
-  inLines->GetNextCell(npts,pts); )
+  inLines = input->GetLines();
+  if ( inLines->GetNumberOfCells() > 0 )
+  {
+    lineEdges.resize(2*numPts);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts,pts); )
   {
     // Check for closed loop which are treated specially. Basically the
     // last point is ignored (set to fixed).
@@ -179,48 +303,42 @@ int vtkWindowedSincPolyDataFilter::RequestData(
 
     for (j=0; j<npts; j++)
     {
-      if ( Verts[pts[j]].type == VTK_SIMPLE_VERTEX )
+      if ( lineTypes[pts[j]] == VTK_SIMPLE_VERTEX )
       {
         // First point
         if ( j == 0 )
         {
           if ( !closedLoop )
           {
-            Verts[pts[0]].type = VTK_FIXED_VERTEX;
+            lineTypes[pts[0]] = VTK_FIXED_VERTEX;
           }
           else
           {
-            Verts[pts[0]].type = VTK_FEATURE_EDGE_VERTEX;
-            Verts[pts[0]].edges = vtkIdList::New();
-            Verts[pts[0]].edges->SetNumberOfIds(2);
-            Verts[pts[0]].edges->SetId(0,pts[npts-2]);
-            Verts[pts[0]].edges->SetId(1,pts[1]);
+            lineTypes[pts[0]] = VTK_FEATURE_EDGE_VERTEX;
+            lineEdges[2*pts[0]] = pts[npts-2];
+            lineEdges[2*pts[0]+1] = pts[1];
           }
         }
         // Last point
         else if ( j == (npts-1) && !closedLoop )
         {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          lineTypes[pts[j]] = VTK_FIXED_VERTEX;
         }
         // Inbetween point
         else //is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0,pts[j-1]);
-          Verts[pts[j]].edges->SetId(1,pts[(closedLoop && j==(npts-2) ? 0 : (j+1))]);
+          lineTypes[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          lineEdges[2*pts[j]] = pts[j-1];
+          lineEdges[2*pts[j]+1] = pts[(closedLoop && j==(npts-2) ? 0 : (j+1))];
         }
       } //if simple vertex
 
       // Vertex has been visited before, need to fix it. Special case
       // when working on closed loop.
-      else if ( Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX &&
+      else if ( lineTypes[pts[j]] == VTK_FEATURE_EDGE_VERTEX &&
                 ! (closedLoop && j == (npts-1)) )
       {
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        lineTypes[pts[j]] = VTK_FIXED_VERTEX;
       }
     } //for all points in this line
   } //for all lines
@@ -233,24 +351,15 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   inStrips=input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
+  Mesh = nullptr;
   if ( numPolys > 0 || numStrips > 0 )
   { //build cell structure
-    vtkCellArray *polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    vtkIdType *neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList *neighbors;
-
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
     inMesh->SetPolys(inPolys);
     Mesh = inMesh;
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
 
-    if ( (numStrips = inStrips->GetNumberOfCells()) > 0 )
+    if ( numStrips > 0 )
     { // convert data to triangles
       inMesh->SetStrips(inStrips);
       toTris = vtkTriangleFilter::New();
@@ -259,186 +368,52 @@ int vtkWindowedSincPolyDataFilter::RequestData(
       Mesh = toTris->GetOutput();
     }
 
+    Mesh->EditableOff(); // the links are only queried
     Mesh->BuildLinks(); //to do neighborhood searching
-    polys = Mesh->GetPolys();
-
-    for (cellId=0, polys->InitTraversal(); polys->GetNextCell(npts,pts);
-         cellId++)
-    {
-      for (i=0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i+1)%npts];
-
-        if ( Verts[p1].edges == nullptr )
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16,6);
-          // Verts[p1].edges = new vtkIdList(6,6);
-        }
-        if ( Verts[p2].edges == nullptr )
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16,6);
-          // Verts[p2].edges = new vtkIdList(6,6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId,p1,p2,neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if ( numNei == 0 )
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if ( numNei >= 2 )
-        {
-          // non-manifold case, check nonmanifold smoothing state
-          if (!this->NonManifoldSmoothing)
-          {
-            // check to make sure that this edge hasn't been marked already
-            for (j=0; j < numNei; j++)
-            {
-              if ( neighbors->GetId(j) < cellId )
-              {
-                break;
-              }
-            }
-            if ( j >= numNei )
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-
-        else if ( numNei == 1 && (nei=neighbors->GetId(0)) > cellId )
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts,npts,pts,normal);
-            Mesh->GetCellPoints(nei,numNeiPts,neiPts);
-            vtkPolygon::ComputeNormal(inPts,numNeiPts,neiPts,neiNormal);
-
-            if ( vtkMath::Dot(normal,neiNormal) <= CosFeatureAngle )
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if ( edge && Verts[p1].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ( (edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-        (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if ( Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if ( edge && Verts[p2].type == VTK_SIMPLE_VERTEX )
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ( (edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX ) ||
-        (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-        (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX ) )
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if ( Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX )
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
-    //    delete inMesh; // delete this later, windowed sinc smoothing needs it
-    if (toTris)
-    {
-      toTris->Delete();
-    }
-    neighbors->Delete();
   }//if strips or polys
 
+  // Build the stencils of the points in parallel, then gather them in
+  // compressed sparse row form.
+  std::vector<char> types(numPts);
+  std::vector<vtkIdType> offsets(numPts+1);
+  vtkBuildSmoothingStencils stencils;
+  stencils.Mesh = Mesh;
+  stencils.Points = inPts;
+  stencils.LineTypes = lineTypes.data();
+  stencils.LineEdges = lineEdges.data();
+  stencils.CosFeatureAngle = CosFeatureAngle;
+  stencils.CosEdgeAngle = CosEdgeAngle;
+  stencils.FeatureEdgeSmoothing = this->FeatureEdgeSmoothing;
+  stencils.NonManifoldSmoothing = this->NonManifoldSmoothing;
+  stencils.BoundarySmoothing = this->BoundarySmoothing;
+  // the Laplacian of the fixed points is used by their neighbors
+  stencils.KeepFixedStencils = true;
+  stencils.Offsets = offsets.data();
+  stencils.Types = types.data();
+  std::vector<vtkIdType> stencilIds;
+  vtkGatherSmoothingStencils(stencils, numPts, stencilIds);
+
+  if (toTris)
+  {
+    toTris->Delete();
+  }
+  if ( inMesh != nullptr )
+  {
+    inMesh->Delete();
+  }
+
   this->UpdateProgress(0.50);
 
-  //post-process edge vertices to make sure we can smooth them
   for (i=0; i<numPts; i++)
   {
-    if ( Verts[i].type == VTK_SIMPLE_VERTEX )
+    switch ( types[i] )
     {
-      numSimple++;
+      case VTK_SIMPLE_VERTEX: numSimple++; break;
+      case VTK_FIXED_VERTEX: numFixed++; break;
+      case VTK_FEATURE_EDGE_VERTEX: numFEdges++; break;
+      default: numBEdges++; break;
     }
-
-    else if ( Verts[i].type == VTK_FIXED_VERTEX )
-    {
-      numFixed++;
-    }
-
-    else if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX ||
-              Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
-    { //see how many edges; if two, what the angle is
-
-      if ( !this->BoundarySmoothing &&
-      Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX )
-      {
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numBEdges++;
-      }
-
-      else if ( (npts = Verts[i].edges->GetNumberOfIds()) != 2 )
-      {
-        // can only smooth edges on 2-manifold surfaces
-        Verts[i].type = VTK_FIXED_VERTEX;
-        numFixed++;
-      }
-
-      else //check angle between edges
-      {
-        inPts->GetPoint(Verts[i].edges->GetId(0),x1);
-        inPts->GetPoint(i,x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1),x3);
-
-        for (k=0; k<3; k++)
-        {
-          l1[k] = x2[k] - x1[k];
-          l2[k] = x3[k] - x2[k];
-        }
-        if ((vtkMath::Normalize(l1) >= 0.0) && (vtkMath::Normalize(l2) >= 0.0)
-            && (vtkMath::Dot(l1,l2) < CosEdgeAngle))
-        {
-          numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
-        }
-        else
-        {
-          if ( Verts[i].type == VTK_FEATURE_EDGE_VERTEX )
-          {
-            numFEdges++;
-          }
-          else
-          {
-            numBEdges++;
-          }
-        }
-      }//if along edge
-    }//if edge vertex
-  }//for all points
+  }
 
   vtkDebugMacro(<<"Found\n\t" << numSimple << " simple vertices\n\t"
                 << numFEdges << " feature edge vertices\n\t"
@@ -452,14 +427,12 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   // need 4 vectors of points
   zero=0; one=1; two=2; three=3;
 
-  newPts[0] = vtkPoints::New();
-  newPts[0]->SetNumberOfPoints(numPts);
-  newPts[1] = vtkPoints::New();
-  newPts[1]->SetNumberOfPoints(numPts);
-  newPts[2] = vtkPoints::New();
-  newPts[2]->SetNumberOfPoints(numPts);
-  newPts[3] = vtkPoints::New();
-  newPts[3]->SetNumberOfPoints(numPts);
+  for (j=0; j<4; j++)
+  {
+    newPts[j] = vtkPoints::New();
+    newPts[j]->SetDataTypeToFloat();
+    newPts[j]->SetNumberOfPoints(numPts);
+  }
 
   // Get the center and length of the input dataset
   double *inCenter = input->GetCenter();
@@ -506,9 +479,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   c = new double[this->NumberOfIterations+1];
   cprime = new double[this->NumberOfIterations+1];
 
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;
-
   // Calculate the weights and the Chebychev coefficients c.
   //
 
@@ -593,54 +563,18 @@ int vtkWindowedSincPolyDataFilter::RequestData(
     vtkErrorMacro(<< "An optimal offset for the smoothing filter could not be found.  Unpredictable smoothing/shrinkage may result.");
   }
 
-  // first iteration
-  for (i=0; i<numPts; i++)
+  // The iterations only read the points of the previous ones, so each of
+  // them is run in parallel over the points.
+  float *x[4];
+  for (j=0; j<4; j++)
   {
-    if ( Verts[i].edges != nullptr &&
-         (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-    {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); //use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-      // calculate the negative of the laplacian
-      for (j=0; j<npts; j++) //for all connected points
-      {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k=0; k<3; k++)
-        {
-          deltaX[k] += (x[k] - y[k]) / npts;
-        }
-      }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k=0; k<3; k++)
-      {
-        deltaX[k] = x[k] - 0.5*deltaX[k];
-      }
-      newPts[one]->SetPoint(i, deltaX);
+    x[j] = static_cast<float*>(newPts[j]->GetVoidPointer(0));
+  }
 
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k=0; k < 3; k++)
-      {
-        deltaX[k] = c[0]*x[k] + c[1]*deltaX[k];
-      }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-      {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
-      else
-      {
-        newPts[three]->SetPoint(i, deltaX);
-      }
-    }//if can move point
-    else
-    {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-    }
-  }//for all points
+  // first iteration
+  FirstIteration first = { offsets.data(), stencilIds.data(), types.data(),
+                           c, x[zero], x[one], x[three] };
+  vtkSMPTools::For(0, numPts, first);
 
   // for the rest of the iterations
   for ( iterationNumber=2;
@@ -656,53 +590,10 @@ int vtkWindowedSincPolyDataFilter::RequestData(
       }
     }
 
-    for (i=0; i<numPts; i++)
-    {
-      if ( Verts[i].edges != nullptr &&
-           (npts = Verts[i].edges->GetNumberOfIds()) > 0 )
-      {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); //use current points
-        newPts[one]->GetPoint(i, p_x1);
-
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-        // calculate the negative laplacian of x1
-        for (j=0; j<npts; j++)
-        {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k=0; k<3; k++)
-          {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
-          }
-        }//for all connected points
-
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k=0; k<3; k++)
-        {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-        }
-        newPts[two]->SetPoint(i, deltaX);
-
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k=0;k<3;k++)
-        {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-        }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
-        {
-          newPts[three]->SetPoint(i,xNew);
-        }
-      }//if can move point
-      else
-      {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-      }
-    }//for all points
+    NextIteration next = { offsets.data(), stencilIds.data(), types.data(),
+                           c[iterationNumber], x[zero], x[one], x[two],
+                           x[three] };
+    vtkSMPTools::For(0, numPts, next);
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -793,22 +684,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // finally delete the constructed (local) mesh
-  if ( inMesh != nullptr )
-  {
-    inMesh->Delete();
-  }
-
-  //free up connectivity storage
-  for (i=0; i<numPts; i++)
-  {
-    if ( Verts[i].edges != nullptr )
-    {
-      Verts[i].edges->Delete();
-    }
-  }
-  delete [] Verts;
-
   return 1;
 }
 
@@ -0,0 +1,178 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLagrangianFlow.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+    This software is distributed WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+    PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by TestLagrangianParticleTrackerThreadSafe and
+// TimeLagrangianParticleTracker: particles seeded in a rotating flow, the
+// terminating, pass-through, bouncing and break-up surfaces they interact
+// with, and the arrays of vtkLagrangianMatidaIntegrationModel. Not every
+// test uses all of them, hence the inline functions.
+
+#ifndef TestLagrangianFlow_h
+#define TestLagrangianFlow_h
+
+#include "vtkCellData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkDoubleArray.h"
+#include "vtkImageData.h"
+#include "vtkLagrangianMatidaIntegrationModel.h"
+#include "vtkMath.h"
+#include "vtkMultiBlockDataGroupFilter.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPointSource.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+
+namespace
+{
+
+inline void AddSurfaceType(vtkPolyData* surface, int type)
+{
+  vtkNew<vtkDoubleArray> surfaceType;
+  surfaceType->SetName("SurfaceType");
+  surfaceType->SetNumberOfTuples(surface->GetNumberOfCells());
+  surfaceType->FillComponent(0, type);
+  surface->GetCellData()->AddArray(surfaceType);
+}
+
+inline vtkSmartPointer<vtkPolyData> MakePlane(
+  double origin[3], double point1[3], double point2[3], int type)
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetOrigin(origin);
+  plane->SetPoint1(point1);
+  plane->SetPoint2(point2);
+  plane->SetResolution(10, 10);
+  plane->Update();
+  vtkSmartPointer<vtkPolyData> pd = plane->GetOutput();
+  AddSurfaceType(pd, type);
+  return pd;
+}
+
+// Random seeds with the initial velocity, density and diameter of the
+// particles
+inline void MakeSeeds(int numberOfSeeds, vtkPolyData* seedPD)
+{
+  vtkNew<vtkPointSource> points;
+  points->SetNumberOfPoints(numberOfSeeds);
+  points->SetRadius(4);
+  points->Update();
+  seedPD->ShallowCopy(points->GetOutput());
+  vtkIdType nSeeds = seedPD->GetNumberOfPoints();
+
+  vtkNew<vtkDoubleArray> partVel;
+  partVel->SetNumberOfComponents(3);
+  partVel->SetNumberOfTuples(nSeeds);
+  partVel->SetName("InitialVelocity");
+  vtkNew<vtkDoubleArray> partDens;
+  partDens->SetNumberOfTuples(nSeeds);
+  partDens->SetName("ParticleDensity");
+  vtkNew<vtkDoubleArray> partDiam;
+  partDiam->SetNumberOfTuples(nSeeds);
+  partDiam->SetName("ParticleDiameter");
+  for (vtkIdType i = 0; i < nSeeds; i++)
+  {
+    partVel->SetTuple3(i, vtkMath::Random(-2, 2), vtkMath::Random(-2, 5),
+      vtkMath::Random(-2, 2));
+  }
+  partDens->FillComponent(0, 1920);
+  partDiam->FillComponent(0, 0.1);
+  seedPD->GetPointData()->AddArray(partVel);
+  seedPD->GetPointData()->AddArray(partDens);
+  seedPD->GetPointData()->AddArray(partDiam);
+}
+
+// The flow velocity, density and viscosity, as cell data
+inline void MakeFlow(vtkImageData* flowImg)
+{
+  flowImg->SetExtent(-10, 10, -10, 10, -10, 10);
+  vtkIdType nCells = flowImg->GetNumberOfCells();
+  vtkNew<vtkDoubleArray> flowVel;
+  flowVel->SetNumberOfComponents(3);
+  flowVel->SetNumberOfTuples(nCells);
+  flowVel->SetName("FlowVelocity");
+  vtkNew<vtkDoubleArray> flowDens;
+  flowDens->SetNumberOfTuples(nCells);
+  flowDens->SetName("FlowDensity");
+  vtkNew<vtkDoubleArray> flowDynVisc;
+  flowDynVisc->SetNumberOfTuples(nCells);
+  flowDynVisc->SetName("FlowDynamicViscosity");
+  for (vtkIdType i = 0; i < nCells; i++)
+  {
+    double x[3], pcoords[3], weights[8];
+    int subId;
+    flowImg->GetCell(i)->EvaluateLocation(subId, pcoords, x, weights);
+    flowVel->SetTuple3(i, -0.3 * x[1], 0.3 * x[0], -0.3);
+  }
+  flowDens->FillComponent(0, 1000);
+  flowDynVisc->FillComponent(0, 0.894);
+  flowImg->GetCellData()->AddArray(flowVel);
+  flowImg->GetCellData()->AddArray(flowDens);
+  flowImg->GetCellData()->AddArray(flowDynVisc);
+}
+
+// Add to the group the boundary of the flow as a terminating surface, a
+// pass-through and a bouncing plane, and optionally a break-up plane.
+inline void AddSurfaces(
+  vtkImageData* flowImg, bool breakUp, vtkMultiBlockDataGroupFilter* groupSurface)
+{
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(flowImg);
+  surface->Update();
+  vtkPolyData* termPd = surface->GetOutput();
+  AddSurfaceType(termPd, vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_TERM);
+  double passOrigin[3] = { -10, -10, 0 };
+  double passPoint1[3] = { 10, -10, 0 };
+  double passPoint2[3] = { -10, 10, 0 };
+  double bounceOrigin[3] = { -6, -6, -3 };
+  double bouncePoint1[3] = { 6, -6, -3 };
+  double bouncePoint2[3] = { -6, 6, -3 };
+  double breakOrigin[3] = { -10, 5, -10 };
+  double breakPoint1[3] = { 10, 5, -10 };
+  double breakPoint2[3] = { -10, 5, 10 };
+  groupSurface->AddInputDataObject(termPd);
+  groupSurface->AddInputDataObject(MakePlane(passOrigin, passPoint1, passPoint2,
+    vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_PASS));
+  groupSurface->AddInputDataObject(MakePlane(bounceOrigin, bouncePoint1, bouncePoint2,
+    vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_BOUNCE));
+  if (breakUp)
+  {
+    groupSurface->AddInputDataObject(MakePlane(breakOrigin, breakPoint1, breakPoint2,
+      vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_BREAK));
+  }
+}
+
+// Set the arrays of the integration model
+inline void SetMatidaArrays(vtkLagrangianMatidaIntegrationModel* integrationModel)
+{
+  integrationModel->SetInputArrayToProcess(0, 1, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "InitialVelocity");
+  integrationModel->SetInputArrayToProcess(2, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, "SurfaceType");
+  integrationModel->SetInputArrayToProcess(3, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, "FlowVelocity");
+  integrationModel->SetInputArrayToProcess(4, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, "FlowDensity");
+  integrationModel->SetInputArrayToProcess(5, 0, 0,
+    vtkDataObject::FIELD_ASSOCIATION_CELLS, "FlowDynamicViscosity");
+  integrationModel->SetInputArrayToProcess(6, 1, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "ParticleDiameter");
+  integrationModel->SetInputArrayToProcess(7, 1, 0,
+    vtkDataObject::FIELD_ASSOCIATION_POINTS, "ParticleDensity");
+}
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLagrangianParticleTrackerThreadSafe.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+    This software is distributed WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+    PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Track many particles through terminating, pass-through, bouncing and
+// optionally break-up surfaces, with vtkLagrangianMatidaIntegrationModel
+// flagged thread safe and without it, and check that the paths and
+// interactions are the same. Without the break-up surface, the particles
+// are integrated concurrently.
+
+#include "TestLagrangianFlow.h"
+
+#include "vtkIdList.h"
+#include "vtkImageDataToPointSet.h"
+#include "vtkLagrangianParticleTracker.h"
+#include "vtkMultiBlockDataSet.h"
+
+namespace
+{
+
+// Compare the points and the point data arrays of two polydata
+int ComparePoints(vtkPolyData* pd1, vtkPolyData* pd2, const char* label)
+{
+  if (pd1->GetNumberOfPoints() != pd2->GetNumberOfPoints())
+  {
+    cerr << label << ": different number of points " << pd1->GetNumberOfPoints()
+         << " " << pd2->GetNumberOfPoints() << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < pd1->GetNumberOfPoints(); i++)
+  {
+    double x1[3], x2[3];
+    pd1->GetPoint(i, x1);
+    pd2->GetPoint(i, x2);
+    if (x1[0] != x2[0] || x1[1] != x2[1] || x1[2] != x2[2])
+    {
+      cerr << label << ": different point " << i << endl;
+      return 1;
+    }
+  }
+  const char* names[] = { "StepNumber", "ParticleVelocity", "IntegrationTime" };
+  for (int a = 0; a < 3; a++)
+  {
+    vtkDataArray* array1 = pd1->GetPointData()->GetArray(names[a]);
+    vtkDataArray* array2 = pd2->GetPointData()->GetArray(names[a]);
+    if (!array1 || !array2 ||
+      array1->GetNumberOfTuples() != pd1->GetNumberOfPoints() ||
+      array2->GetNumberOfTuples() != pd2->GetNumberOfPoints())
+    {
+      cerr << label << ": missing " << names[a] << endl;
+      return 1;
+    }
+    for (vtkIdType i = 0; i < array1->GetNumberOfValues(); i++)
+    {
+      if (array1->GetComponent(i / array1->GetNumberOfComponents(),
+            i % array1->GetNumberOfComponents()) !=
+        array2->GetComponent(i / array2->GetNumberOfComponents(),
+          i % array2->GetNumberOfComponents()))
+      {
+        cerr << label << ": different " << names[a] << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+}
+
+int TestLagrangianParticleTrackerThreadSafe(int, char*[])
+{
+  // Seeds with the particle data
+  vtkNew<vtkPolyData> seedPD;
+  MakeSeeds(2000, seedPD);
+  vtkIdType nSeeds = seedPD->GetNumberOfPoints();
+
+  // Flow, as image data and as unstructured grid
+  vtkNew<vtkImageData> flowImg;
+  MakeFlow(flowImg);
+  vtkNew<vtkImageDataToPointSet> ugFlow;
+  ugFlow->AddInputData(flowImg);
+
+  int errors = 0;
+  for (int test = 0; test < 4; test++)
+  {
+    int flow = test % 2;
+    bool breakUp = test >= 2;
+    vtkNew<vtkMultiBlockDataGroupFilter> groupSurface;
+    AddSurfaces(flowImg, breakUp, groupSurface);
+
+    vtkSmartPointer<vtkMultiBlockDataSet> outputs[2][2];
+    for (int threadSafe = 0; threadSafe < 2; threadSafe++)
+    {
+      vtkNew<vtkLagrangianMatidaIntegrationModel> integrationModel;
+      SetMatidaArrays(integrationModel);
+      integrationModel->SetThreadSafe(threadSafe != 0);
+
+      vtkNew<vtkLagrangianParticleTracker> tracker;
+      tracker->SetIntegrationModel(integrationModel);
+      if (flow == 0)
+      {
+        tracker->SetInputData(flowImg);
+      }
+      else
+      {
+        tracker->SetInputConnection(ugFlow->GetOutputPort());
+      }
+      tracker->SetSourceData(seedPD);
+      tracker->SetSurfaceConnection(groupSurface->GetOutputPort());
+      tracker->SetStepFactor(0.5);
+      // The broken particles are carried back through the break-up surface
+      // and break again, so fewer steps keep their number small
+      tracker->SetMaximumNumberOfSteps(breakUp ? 50 : 100);
+      tracker->SetCellLengthComputationMode(
+        flow == 0 ? vtkLagrangianParticleTracker::STEP_LAST_CELL_VEL_DIR
+                  : vtkLagrangianParticleTracker::STEP_CUR_CELL_DIV_THEO);
+      tracker->Update();
+
+      outputs[threadSafe][0] = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+      outputs[threadSafe][0]->SetNumberOfBlocks(1);
+      vtkNew<vtkPolyData> paths;
+      paths->ShallowCopy(tracker->GetOutput());
+      outputs[threadSafe][0]->SetBlock(0, paths);
+      outputs[threadSafe][1] = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+      outputs[threadSafe][1]->ShallowCopy(tracker->GetOutput(1));
+    }
+
+    // Compare the paths, the break-up surface creates more paths
+    vtkPolyData* paths[2] = { vtkPolyData::SafeDownCast(outputs[0][0]->GetBlock(0)),
+      vtkPolyData::SafeDownCast(outputs[1][0]->GetBlock(0)) };
+    errors += ComparePoints(paths[0], paths[1], "Paths");
+    if (paths[0]->GetNumberOfLines() != paths[1]->GetNumberOfLines() ||
+      paths[0]->GetNumberOfLines() < nSeeds ||
+      (paths[0]->GetNumberOfLines() > nSeeds) != breakUp)
+    {
+      cerr << "Wrong number of paths " << paths[0]->GetNumberOfLines() << " "
+           << paths[1]->GetNumberOfLines() << endl;
+      errors++;
+    }
+    else
+    {
+      vtkDataArray* ids[2] = { paths[0]->GetCellData()->GetArray("Id"),
+        paths[1]->GetCellData()->GetArray("Id") };
+      vtkDataArray* seedIds[2] = { paths[0]->GetCellData()->GetArray("SeedId"),
+        paths[1]->GetCellData()->GetArray("SeedId") };
+      vtkDataArray* terminations[2] = { paths[0]->GetCellData()->GetArray("Termination"),
+        paths[1]->GetCellData()->GetArray("Termination") };
+      vtkNew<vtkIdList> pts1, pts2;
+      for (vtkIdType i = 0; i < paths[0]->GetNumberOfLines(); i++)
+      {
+        paths[0]->GetCellPoints(i, pts1);
+        paths[1]->GetCellPoints(i, pts2);
+        bool samePoints = pts1->GetNumberOfIds() == pts2->GetNumberOfIds();
+        for (vtkIdType j = 0; samePoints && j < pts1->GetNumberOfIds(); j++)
+        {
+          samePoints = pts1->GetId(j) == pts2->GetId(j);
+        }
+        if (!samePoints || seedIds[0]->GetTuple1(i) != seedIds[1]->GetTuple1(i) ||
+          terminations[0]->GetTuple1(i) != terminations[1]->GetTuple1(i) ||
+          ids[0]->GetTuple1(i) != ids[1]->GetTuple1(i))
+        {
+          cerr << "Different path " << i << endl;
+          errors++;
+          break;
+        }
+      }
+    }
+
+    // Compare the interactions
+    vtkMultiBlockDataSet* interactions[2] = { outputs[0][1], outputs[1][1] };
+    unsigned int nBlocks = breakUp ? 4 : 3;
+    if (interactions[0]->GetNumberOfBlocks() != nBlocks ||
+      interactions[1]->GetNumberOfBlocks() != nBlocks)
+    {
+      cerr << "Wrong number of interaction blocks" << endl;
+      errors++;
+      continue;
+    }
+    vtkIdType nInteractions = 0;
+    for (unsigned int b = 0; b < nBlocks; b++)
+    {
+      vtkPolyData* pd1 = vtkPolyData::SafeDownCast(interactions[0]->GetBlock(b));
+      vtkPolyData* pd2 = vtkPolyData::SafeDownCast(interactions[1]->GetBlock(b));
+      errors += ComparePoints(pd1, pd2, "Interactions");
+      nInteractions += pd1->GetNumberOfPoints();
+    }
+    if (nInteractions == 0)
+    {
+      cerr << "No interactions" << endl;
+      errors++;
+    }
+  }
+  return errors;
+}
@@ -406,6 +406,61 @@ int TestStreaklineFilter()
   return EXIT_SUCCESS;
 }
 
+// Advect many particles in the rotation around the y axis, and check that
+// each path keeps its particle id, its distance to the axis and its height.
+int TestParticlePathFilterManyParticles()
+{
+  vtkNew<TestTimeSource> imageSource;
+  imageSource->SetBoundingBox(-1,1,-1,1,-1,1);
+
+  const int numParticles = 2000;
+  vtkNew<vtkPoints> points;
+  for(int i=0; i<numParticles; i++)
+  {
+    double r = vtkMath::Random(0.1,0.8);
+    double theta = vtkMath::Random(0.0,2.0*vtkMath::Pi());
+    points->InsertNextPoint(r*cos(theta),vtkMath::Random(-0.9,0.9),r*sin(theta));
+  }
+  vtkNew<vtkPolyData> ps;
+  ps->SetPoints(points);
+
+  vtkNew<vtkParticlePathFilter> filter;
+  filter->SetInputConnection(0,imageSource->GetOutputPort());
+  filter->SetInputData(1,ps);
+  filter->SetComputeVorticity(true);
+  filter->SetTerminationTime(4.0);
+  filter->Update();
+
+  vtkPolyData* out = filter->GetOutput();
+  EXPECT(out->GetNumberOfLines() == numParticles, "Wrong # of lines"<<out->GetNumberOfLines());
+  vtkDataArray* particleIds = out->GetPointData()->GetArray("ParticleId");
+  vtkDataArray* vorticity = out->GetPointData()->GetArray("Vorticity");
+  EXPECT(particleIds && vorticity, "Missing particle arrays");
+
+  vtkCellArray* lines = out->GetLines();
+  vtkNew<vtkIdList> polyLine;
+  lines->InitTraversal();
+  while(lines->GetNextCell(polyLine))
+  {
+    EXPECT(polyLine->GetNumberOfIds() == 5, "Wrong # of points "<<polyLine->GetNumberOfIds());
+    double p0[3];
+    out->GetPoint(polyLine->GetId(0),p0);
+    double r0 = sqrt(p0[0]*p0[0]+p0[2]*p0[2]);
+    double id = particleIds->GetTuple1(polyLine->GetId(0));
+    for(int j=1; j<polyLine->GetNumberOfIds();j++)
+    {
+      double p[3];
+      out->GetPoint(polyLine->GetId(j),p);
+      EXPECT(particleIds->GetTuple1(polyLine->GetId(j)) == id, "Wrong particle id");
+      EXPECT(fabs(sqrt(p[0]*p[0]+p[2]*p[2])-r0)<0.01*r0 && fabs(p[1]-p0[1])<1e-6,
+             "Wrong particle position");
+      EXPECT(fabs(vorticity->GetComponent(polyLine->GetId(j),0))<1e-4 &&
+             fabs(vorticity->GetComponent(polyLine->GetId(j),2))<1e-4, "Wrong vorticity");
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
 
 int TestParticleTracers(int, char*[])
 {
@@ -494,6 +549,7 @@ int TestParticleTracers(int, char*[])
   EXPECT(TestParticlePathFilter()==EXIT_SUCCESS,"");
   EXPECT(TestParticlePathFilterStartTime()==EXIT_SUCCESS,"");
   EXPECT(TestStreaklineFilter()==EXIT_SUCCESS,"");
+  EXPECT(TestParticlePathFilterManyParticles()==EXIT_SUCCESS,"");
 
   return EXIT_SUCCESS;
 }
@@ -23,7 +23,13 @@
 #include "vtkPointData.h"
 #include "vtkSmartPointer.h"
 #include "vtkDoubleArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkUnstructuredGrid.h"
 #include <cassert>
+#include <cmath>
 
 int TestFieldNames(int, char*[])
 {
@@ -104,9 +110,156 @@ int TestFieldNames(int, char*[])
   return EXIT_SUCCESS;
 }
 
+void AddVortex(vtkDataSet* ds)
+{
+  vtkIdType numPts = ds->GetNumberOfPoints();
+  vtkSmartPointer<vtkDoubleArray> vectors = vtkSmartPointer<vtkDoubleArray>::New();
+  vectors->SetName("Velocity");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  for(vtkIdType idx=0; idx<numPts; idx++)
+  {
+    double x[3];
+    ds->GetPoint(idx, x);
+    vectors->SetTuple3(idx, -x[1] + 0.1*x[0], x[0], 0.2);
+  }
+  ds->GetPointData()->SetVectors(vectors);
+}
+
+int TestManySeeds(int, char*[])
+{
+  //create a multiblock data set of an image and of an unstructured grid
+  //of hexahedra, so that the streamlines go from one to the other
+  vtkSmartPointer<vtkImageData> image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(0,10,0,20,0,10);
+  image->SetOrigin(-5,-5,0);
+  image->SetSpacing(0.5,0.5,0.5);
+  AddVortex(image);
+
+  vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+  for(int k=0; k<=10; k++)
+  {
+    for(int j=0; j<=20; j++)
+    {
+      for(int i=0; i<=10; i++)
+      {
+        points->InsertNextPoint(0.5*i, -5+0.5*j, 0.5*k);
+      }
+    }
+  }
+  vtkSmartPointer<vtkUnstructuredGrid> grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(10*20*10);
+  for(int k=0; k<10; k++)
+  {
+    for(int j=0; j<20; j++)
+    {
+      for(int i=0; i<10; i++)
+      {
+        vtkIdType hex[8];
+        for(int v=0; v<8; v++)
+        {
+          hex[v] = (i + ((v+1)/2)%2) + 11*((j + (v/2)%2) + 21*(k + v/4));
+        }
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+      }
+    }
+  }
+  AddVortex(grid);
+
+  vtkNew<vtkMultiBlockDataSet> dataSets;
+  dataSets->SetNumberOfBlocks( 2 );
+  dataSets->SetBlock( 0, image );
+  dataSets->SetBlock( 1, grid );
+
+  //create many seeds, some of them outside of the data
+  vtkNew<vtkPolyData> seeds;
+  vtkNew<vtkPoints> seedPoints;
+  for(int i=0; i<1000; i++)
+  {
+    seedPoints->InsertNextPoint(vtkMath::Random(-5.5,5.5),
+                                vtkMath::Random(-5.5,5.5),
+                                vtkMath::Random(0.0,4.0));
+  }
+  seeds->SetPoints(seedPoints);
+
+  vtkNew<vtkStreamTracer> tracer;
+  tracer->SetSourceData(seeds);
+  tracer->SetInputData(dataSets);
+  tracer->SetMaximumPropagation(20.0);
+  tracer->SetIntegratorTypeToRungeKutta45();
+  tracer->Update();
+  vtkNew<vtkPolyData> traces;
+  traces->DeepCopy(tracer->GetOutput());
+
+  //the streamlines are ordered by seed
+  vtkDataArray* seedIds = traces->GetCellData()->GetArray("SeedIds");
+  vtkDataArray* reasons = traces->GetCellData()->GetArray("ReasonForTermination");
+  if(   seedIds==nullptr || reasons==nullptr
+     || traces->GetNumberOfCells()==0
+     || traces->GetPointData()->GetArray("Vorticity")==nullptr)
+  {
+    return EXIT_FAILURE;
+  }
+  for(vtkIdType cellId=1; cellId<traces->GetNumberOfCells(); cellId++)
+  {
+    if(seedIds->GetTuple1(cellId) <= seedIds->GetTuple1(cellId-1))
+    {
+      cerr << "Streamlines are not in seed order" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //each streamline is the one of its seed traced alone
+  vtkNew<vtkPolyData> seed;
+  vtkNew<vtkPoints> seedPoint;
+  seedPoint->SetNumberOfPoints(1);
+  seed->SetPoints(seedPoint);
+  tracer->SetSourceData(seed);
+  vtkNew<vtkIdList> ptIds, singlePtIds;
+  for(vtkIdType cellId=0; cellId<traces->GetNumberOfCells(); cellId+=37)
+  {
+    vtkIdType seedId = static_cast<vtkIdType>(seedIds->GetTuple1(cellId));
+    seedPoint->SetPoint(0, seedPoints->GetPoint(seedId));
+    seedPoint->Modified();
+    tracer->Update();
+    vtkPolyData* single = tracer->GetOutput();
+    traces->GetCellPoints(cellId, ptIds);
+    if(   single->GetNumberOfCells()!=1
+       || single->GetCellData()->GetArray("ReasonForTermination")->GetTuple1(0)
+          != reasons->GetTuple1(cellId))
+    {
+      cerr << "Wrong streamline for seed " << seedId << endl;
+      return EXIT_FAILURE;
+    }
+    single->GetCellPoints(0, singlePtIds);
+    if(singlePtIds->GetNumberOfIds()!=ptIds->GetNumberOfIds())
+    {
+      cerr << "Wrong number of points for seed " << seedId << endl;
+      return EXIT_FAILURE;
+    }
+    for(vtkIdType i=0; i<ptIds->GetNumberOfIds(); i++)
+    {
+      double p[3], q[3];
+      traces->GetPoint(ptIds->GetId(i), p);
+      single->GetPoint(singlePtIds->GetId(i), q);
+      if(   vtkMath::Distance2BetweenPoints(p, q) > 1e-12
+         || std::abs(traces->GetPointData()->GetArray("Rotation")->GetTuple1(ptIds->GetId(i))
+                   - single->GetPointData()->GetArray("Rotation")->GetTuple1(singlePtIds->GetId(i))) > 1e-9)
+      {
+        cerr << "Wrong point for seed " << seedId << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 int TestStreamTracer(int n, char* a[])
 {
   int numFailures(0);
   numFailures += TestFieldNames(n,a);
+  numFailures += TestManySeeds(n,a);
   return numFailures;
 }
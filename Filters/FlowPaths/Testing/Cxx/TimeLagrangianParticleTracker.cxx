@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeLagrangianParticleTracker.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+    This software is distributed WITHOUT ANY WARRANTY; without even
+    the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+    PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkLagrangianParticleTracker on image and unstructured flows, with
+// and without a break-up surface, with vtkLagrangianMatidaIntegrationModel
+// flagged thread safe and without it. Without the break-up surface, thread
+// safe models integrate the particles concurrently. This timing driver is
+// not run by ctest; run it with
+//   vtkFiltersFlowPathsCxxTests TimeLagrangianParticleTracker [seeds]
+// The default is 2000 seeds, as in TestLagrangianParticleTrackerThreadSafe.
+
+#include "TestLagrangianFlow.h"
+
+#include "vtkImageDataToPointSet.h"
+#include "vtkLagrangianParticleTracker.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+int TimeLagrangianParticleTracker(int argc, char* argv[])
+{
+  int numberOfSeeds = (argc > 1 ? atoi(argv[1]) : 2000);
+  vtkNew<vtkPolyData> seedPD;
+  MakeSeeds(numberOfSeeds, seedPD);
+  vtkNew<vtkImageData> flowImg;
+  MakeFlow(flowImg);
+  vtkNew<vtkImageDataToPointSet> ugFlow;
+  ugFlow->AddInputData(flowImg);
+
+  cout << "Timing " << numberOfSeeds << " seeds, " << vtkSMPTools::GetEstimatedNumberOfThreads()
+       << " threads\n";
+
+  vtkNew<vtkTimerLog> timer;
+  for (int test = 0; test < 4; test++)
+  {
+    int flow = test % 2;
+    bool breakUp = test >= 2;
+    vtkNew<vtkMultiBlockDataGroupFilter> groupSurface;
+    AddSurfaces(flowImg, breakUp, groupSurface);
+    for (int threadSafe = 0; threadSafe < 2; threadSafe++)
+    {
+      vtkNew<vtkLagrangianMatidaIntegrationModel> integrationModel;
+      SetMatidaArrays(integrationModel);
+      integrationModel->SetThreadSafe(threadSafe != 0);
+
+      vtkNew<vtkLagrangianParticleTracker> tracker;
+      tracker->SetIntegrationModel(integrationModel);
+      if (flow == 0)
+      {
+        tracker->SetInputData(flowImg);
+      }
+      else
+      {
+        tracker->SetInputConnection(ugFlow->GetOutputPort());
+      }
+      tracker->SetSourceData(seedPD);
+      tracker->SetSurfaceConnection(groupSurface->GetOutputPort());
+      tracker->SetStepFactor(0.5);
+      tracker->SetMaximumNumberOfSteps(breakUp ? 50 : 100);
+      tracker->SetCellLengthComputationMode(
+        flow == 0 ? vtkLagrangianParticleTracker::STEP_LAST_CELL_VEL_DIR
+                  : vtkLagrangianParticleTracker::STEP_CUR_CELL_DIV_THEO);
+      timer->StartTimer();
+      tracker->Update();
+      timer->StopTimer();
+      cout << (flow == 0 ? "Image" : "Unstructured") << " flow"
+           << (breakUp ? " with break-up" : "") << ", thread safe " << threadSafe << ": "
+           << timer->GetElapsedTime() << " s\n";
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
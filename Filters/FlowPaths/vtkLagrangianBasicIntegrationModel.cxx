@@ -508,6 +508,7 @@ vtkLagrangianBasicIntegrationModel::vtkLagrangianBasicIntegrationModel():
   Tolerance(1.0e-8),
   NonPlanarQuadSupport(false),
   UseInitialIntegrationTime(false),
+  ThreadSafe(false),
   Tracker(nullptr)
 {
   SurfaceArrayDescription surfaceTypeDescription;
@@ -584,6 +585,74 @@ void vtkLagrangianBasicIntegrationModel::PrintSelf(ostream& os, vtkIndent indent
     os << indent << "CurrentParticle: " << this->CurrentParticle << endl;
   }
   os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "ThreadSafe: " << this->ThreadSafe << endl;
+}
+
+//----------------------------------------------------------------------------
+void vtkLagrangianBasicIntegrationModel::ShallowCopy(
+  vtkLagrangianBasicIntegrationModel* model)
+{
+  this->NumFuncs = model->NumFuncs;
+  this->NumIndepVars = model->NumIndepVars;
+  this->SetLocator(model->Locator);
+  this->Tracker = model->Tracker;
+
+  // Share the datasets and their already built locators
+  this->ClearDataSets();
+  this->ClearDataSets(true);
+  *this->DataSets = *model->DataSets;
+  *this->Locators = *model->Locators;
+  *this->Surfaces = *model->Surfaces;
+  for (size_t iDs = 0; iDs < this->Surfaces->size(); iDs++)
+  {
+    (*this->Surfaces)[iDs].second->Register(this);
+  }
+  *this->SurfaceLocators = *model->SurfaceLocators;
+  this->LocatorsBuilt = model->LocatorsBuilt;
+  this->WeightsSize = model->WeightsSize;
+  this->LastWeights = new double[this->WeightsSize];
+
+  this->InputArrays = model->InputArrays;
+  this->SurfaceArrayDescriptions = model->SurfaceArrayDescriptions;
+  this->Tolerance = model->Tolerance;
+  this->NonPlanarQuadSupport = model->NonPlanarQuadSupport;
+  this->UseInitialIntegrationTime = model->UseInitialIntegrationTime;
+  this->ThreadSafe = model->ThreadSafe;
+}
+
+//----------------------------------------------------------------------------
+bool vtkLagrangianBasicIntegrationModel::HasBreakUpSurfaces()
+{
+  // "SurfaceType" is at index 2
+  int surfaceIndex = 2;
+  if (this->Surfaces->empty() || this->InputArrays.count(surfaceIndex) == 0)
+  {
+    return false;
+  }
+  const std::string& name = this->InputArrays[surfaceIndex].second;
+  int association = this->InputArrays[surfaceIndex].first.val[2];
+
+  for (size_t iDs = 0; iDs < this->Surfaces->size(); iDs++)
+  {
+    vtkDataSet* surface = (*this->Surfaces)[iDs].second;
+    vtkDataArray* surfaceTypes =
+      association == vtkDataObject::FIELD_ASSOCIATION_NONE ?
+      surface->GetFieldData()->GetArray(name.c_str()) :
+      surface->GetCellData()->GetArray(name.c_str());
+    if (!surfaceTypes)
+    {
+      continue;
+    }
+    for (vtkIdType i = 0; i < surfaceTypes->GetNumberOfTuples(); i++)
+    {
+      if (static_cast<int>(surfaceTypes->GetComponent(i, 0)) ==
+        vtkLagrangianBasicIntegrationModel::SURFACE_TYPE_BREAK)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 //----------------------------------------------------------------------------
@@ -639,6 +708,14 @@ void vtkLagrangianBasicIntegrationModel::AddDataSet(vtkDataSet * dataset,
     locator->BuildLocator();
   }
 
+  // Build the cells and cache the ghost array now, so particles can then be
+  // integrated concurrently
+  if (dataset->GetNumberOfCells() > 0)
+  {
+    dataset->GetCell(0, this->Cell);
+  }
+  dataset->GetCellGhostArray();
+
   // Add locator
   if (surface)
   {
@@ -763,8 +840,8 @@ vtkLagrangianParticle* vtkLagrangianBasicIntegrationModel::ComputeSurfaceInterac
         double tmpFactor;
         double tmpPoint[3];
         vtkIdType tmpCellId = cellList->GetId(i);
-        vtkCell* cell = tmpSurface->GetCell(tmpCellId);
-        if (this->IntersectWithLine(cell, particle->GetPosition(),
+        tmpSurface->GetCell(tmpCellId, this->Cell);
+        if (this->IntersectWithLine(this->Cell->GetRepresentativeCell(), particle->GetPosition(),
           particle->GetNextPosition(), this->Tolerance,
           tmpFactor, tmpPoint) == 0)
         {
@@ -966,6 +1043,11 @@ bool vtkLagrangianBasicIntegrationModel::BreakParticle(vtkLagrangianParticle* pa
     part2Vel[i] = part2Vel[i] / part2Norm * bounceNorm;
   }
 
+  // The new particles start on the surface, they must not interact with
+  // the same cell again right away
+  particle1->SetLastSurfaceCell(surface, cellId);
+  particle2->SetLastSurfaceCell(surface, cellId);
+
   // push new particle in queue
   particles.push(particle1);
   particles.push(particle2);
@@ -1355,8 +1437,9 @@ bool vtkLagrangianBasicIntegrationModel::GetFlowOrSurfaceData(int idx, vtkDataSe
       this->TmpArray = array->NewInstance();
       this->TmpArray->SetNumberOfComponents(nComponents);
       this->TmpArray->SetNumberOfTuples(1);
+      dataSet->GetCell(tupleId, this->Cell);
       this->TmpArray->InterpolateTuple(
-        0, dataSet->GetCell(tupleId)->GetPointIds(), array, weights);
+        0, this->Cell->GetPointIds(), array, weights);
 
       // Recover data
       data = this->TmpArray->GetTuple(0);
@@ -1379,7 +1462,9 @@ bool vtkLagrangianBasicIntegrationModel::GetFlowOrSurfaceData(int idx, vtkDataSe
         return false;
       }
       nComponents = array->GetNumberOfComponents();
-      data = array->GetTuple(tupleId);
+      this->TmpTuple.resize(nComponents);
+      array->GetTuple(tupleId, this->TmpTuple.data());
+      data = this->TmpTuple.data();
       return true;
     }
     case vtkDataObject::FIELD_ASSOCIATION_NONE:
@@ -1393,7 +1478,9 @@ bool vtkLagrangianBasicIntegrationModel::GetFlowOrSurfaceData(int idx, vtkDataSe
         return false;
       }
       nComponents = array->GetNumberOfComponents();
-      data = array->GetTuple(tupleId);
+      this->TmpTuple.resize(nComponents);
+      array->GetTuple(tupleId, this->TmpTuple.data());
+      data = this->TmpTuple.data();
       return true;
     }
     default:
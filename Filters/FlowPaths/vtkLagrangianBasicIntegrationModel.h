@@ -43,6 +43,15 @@
  * Inherited class could reimplement CheckFreeFlightTermination to set
  * the way particle terminate in free flight
  *
+ * Concurrent integration is opt-in: ThreadSafe is off by default, including
+ * for vtkLagrangianMatidaIntegrationModel, and vtkLagrangianParticleTracker
+ * integrates the particles serially unless it is set. When set, each thread
+ * uses its own copy of the model made with ShallowCopy; inherited classes
+ * with their own ivars should reimplement ShallowCopy to copy them. The
+ * default surface interactions can run concurrently but break-up, which
+ * appends to the seed data shared by all the particles, so the tracker stays
+ * serial when HasBreakUpSurfaces() returns true.
+ *
  * @sa
  * vtkLagrangianParticleTracker vtkLagrangianParticle
  * vtkLagrangianMatidaIntegrationModel
@@ -58,6 +67,7 @@
 
 #include <queue> // for new particles
 #include <map> // for array indexes
+#include <vector> // for tuple copy
 
 class vtkAbstractArray;
 class vtkAbstractCellLocator;
@@ -175,6 +185,33 @@ public:
   vtkGetMacro(Tolerance, double);
   //@}
 
+  //@{
+  /**
+   * Set/Get whether particles can be integrated concurrently with this model.
+   * When set, vtkLagrangianParticleTracker gives each thread its own copy of
+   * the model made with ShallowCopy, so the callbacks of a copy are never
+   * invoked concurrently, but they must not modify any state shared between
+   * the copies. Default is false, so concurrent integration is opt-in.
+   */
+  vtkSetMacro(ThreadSafe, bool);
+  vtkGetMacro(ThreadSafe, bool);
+  vtkBooleanMacro(ThreadSafe, bool);
+  //@}
+
+  /**
+   * Return true if a cell of the surfaces is of the break-up type. Breaking
+   * a particle up appends the seed data of the new particles to the seed
+   * data shared by all the particles, which cannot be done concurrently.
+   */
+  virtual bool HasBreakUpSurfaces();
+
+  /**
+   * Copy the parameters of the provided model, an instance of the same class,
+   * into this one. Datasets, surfaces and locators are shared with the
+   * provided model, the locators must have been built.
+   */
+  virtual void ShallowCopy(vtkLagrangianBasicIntegrationModel* model);
+
   /**
    * Interact the current particle with a surfaces
    * Return a particle to record as interaction point if not nullptr
@@ -532,10 +569,12 @@ protected:
   vtkLocatorsType* SurfaceLocators;
 
   vtkDataArray* TmpArray;
+  std::vector<double> TmpTuple;
 
   double Tolerance;
   bool NonPlanarQuadSupport;
   bool UseInitialIntegrationTime;
+  bool ThreadSafe;
 
   vtkNew<vtkStringArray> SeedArrayNames;
   vtkNew<vtkIntArray> SeedArrayComps;
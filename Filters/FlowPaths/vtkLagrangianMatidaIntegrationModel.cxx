@@ -121,7 +121,7 @@ int vtkLagrangianMatidaIntegrationModel::FunctionValues(vtkDataSet* dataSet,
       "cannot use Matida equations");
     return 0;
   }
-  double particleDiameter = particleDiameters->GetTuple1(tupleIndex);
+  double particleDiameter = particleDiameters->GetComponent(tupleIndex, 0);
 
   // Fetch Particle Density at index 7
   vtkDataArray* particleDensities = vtkDataArray::SafeDownCast(
@@ -132,7 +132,7 @@ int vtkLagrangianMatidaIntegrationModel::FunctionValues(vtkDataSet* dataSet,
       "cannot use Matida equations");
     return 0;
   }
-  double particleDensity = particleDensities->GetTuple1(tupleIndex);
+  double particleDensity = particleDensities->GetComponent(tupleIndex, 0);
 
   // Compute function values
   for (int i = 0; i<3; i++)
@@ -22,6 +22,7 @@
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkDoubleArray.h"
 #include "vtkExecutive.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -37,12 +38,14 @@
 #include "vtkPolyLine.h"
 #include "vtkPolygon.h"
 #include "vtkRungeKutta2.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
-#include "vtkVoxel.h"
 
 #include <algorithm>
 #include <limits>
 #include <sstream>
+#include <vector>
 
 vtkObjectFactoryNewMacro(vtkLagrangianParticleTracker);
 vtkCxxSetObjectMacro(vtkLagrangianParticleTracker, IntegrationModel, vtkLagrangianBasicIntegrationModel);
@@ -271,6 +274,13 @@ int vtkLagrangianParticleTracker::RequestData(
   // before integration.
   this->IntegrationModel->PreIntegrate(particlesQueue);
 
+  // Integrate the particles concurrently when possible, the queue is then
+  // empty
+  if (this->CanIntegrateInParallel())
+  {
+    this->IntegrateInParallel(particlesQueue, particlePathsOutput, interactionOutput);
+  }
+
   // Integrate each particle
   while (!this->GetAbortExecute())
   {
@@ -352,9 +362,7 @@ vtkMTimeType vtkLagrangianParticleTracker::GetMTime()
 //---------------------------------------------------------------------------
 vtkIdType vtkLagrangianParticleTracker::GetNewParticleId()
 {
-  vtkIdType id = this->ParticleCounter;
-  this->ParticleCounter++;
-  return id;
+  return this->ParticleCounter++;
 }
 
 //---------------------------------------------------------------------------
@@ -995,6 +1003,18 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
   double stepFactor = this->StepFactor;
   double reintegrationFactor = 1;
   double& stepTimeActual = particle->GetStepTimeRef();
+
+  // A particle created by a surface interaction, such as a break-up, may
+  // already have used all the steps of its parent
+  if (this->MaximumNumberOfSteps > -1 &&
+      particle->GetNumberOfSteps() >= this->MaximumNumberOfSteps &&
+      particle->GetTermination() ==
+      vtkLagrangianParticle::PARTICLE_TERMINATION_NOT_TERMINATED)
+  {
+    particle->SetTermination(
+      vtkLagrangianParticle::PARTICLE_TERMINATION_OUT_OF_STEPS);
+  }
+
   while (particle->GetTermination() ==
          vtkLagrangianParticle::PARTICLE_TERMINATION_NOT_TERMINATED)
   {
@@ -1143,7 +1163,7 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
       stepFactor = stepTime * reintegrationFactor * velocityMagnitude / cellLength;
     }
     if (this->MaximumNumberOfSteps > -1 &&
-        particle->GetNumberOfSteps() == this->MaximumNumberOfSteps &&
+        particle->GetNumberOfSteps() >= this->MaximumNumberOfSteps &&
         particle->GetTermination() ==
         vtkLagrangianParticle::PARTICLE_TERMINATION_NOT_TERMINATED)
     {
@@ -1164,6 +1184,320 @@ int vtkLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
   return integrationRes;
 }
 
+//---------------------------------------------------------------------------
+namespace
+{
+// Give the local polydata empty points and point data like the output ones
+void CopyOutputStructure(vtkPolyData* output, vtkPolyData* local)
+{
+  if (output->GetPoints())
+  {
+    vtkNew<vtkPoints> points;
+    points->SetDataType(output->GetPoints()->GetDataType());
+    local->SetPoints(points);
+  }
+  local->GetPointData()->CopyStructure(output->GetPointData());
+}
+
+// Append the local points from start to end, and their data, to the output.
+// Return the output id of the first one.
+vtkIdType AppendPoints(vtkPolyData* local, vtkIdType start, vtkIdType end, vtkPolyData* output)
+{
+  vtkIdType outputStart = output->GetNumberOfPoints();
+  if (end > start)
+  {
+    output->GetPoints()->InsertPoints(outputStart, end - start, start, local->GetPoints());
+    vtkPointData* outputData = output->GetPointData();
+    vtkPointData* localData = local->GetPointData();
+    for (int i = 0; i < outputData->GetNumberOfArrays(); i++)
+    {
+      outputData->GetAbstractArray(i)->InsertTuples(
+        outputStart, end - start, start, localData->GetAbstractArray(i));
+    }
+  }
+  return outputStart;
+}
+}
+
+//---------------------------------------------------------------------------
+struct vtkLagrangianParticleTracker::ParticleIntegrator
+{
+  struct LocalData
+  {
+    // A tracker with copies of the integration model and integrator
+    vtkSmartPointer<vtkLagrangianParticleTracker> Tracker;
+    vtkSmartPointer<vtkPolyData> ParticlePathsOutput;
+    vtkSmartPointer<vtkDataObject> InteractionOutput;
+    std::vector<vtkPolyData*> Interactions;
+    std::queue<vtkLagrangianParticle*> NewParticles;
+  };
+
+  // Where the points of a particle are in the local outputs
+  struct Result
+  {
+    LocalData* Local;
+    vtkIdType PathStart;
+    vtkIdType PathEnd;
+    std::vector<vtkIdType> PathPointIds;
+    std::vector<vtkIdType> InteractionStarts;
+    std::vector<vtkIdType> InteractionEnds;
+    std::vector<vtkLagrangianParticle*> NewParticles;
+  };
+
+  vtkLagrangianParticleTracker* Tracker;
+  vtkPolyData* ParticlePathsOutput;
+  vtkDataObject* InteractionOutput;
+  std::vector<vtkPolyData*> Interactions;
+  std::vector<vtkLagrangianParticle*> Particles;
+  std::vector<Result> Results;
+  vtkSMPThreadLocal<LocalData> Locals;
+
+  ParticleIntegrator(vtkLagrangianParticleTracker* tracker,
+    vtkPolyData* particlePathsOutput, vtkDataObject* interactionOutput)
+    : Tracker(tracker)
+    , ParticlePathsOutput(particlePathsOutput)
+    , InteractionOutput(interactionOutput)
+  {
+    this->GetInteractions(interactionOutput, this->Interactions);
+  }
+
+  // Recover the interaction polydata, in the composite output order
+  static void GetInteractions(vtkDataObject* interactionOutput,
+    std::vector<vtkPolyData*>& interactions)
+  {
+    vtkCompositeDataSet* hd = vtkCompositeDataSet::SafeDownCast(interactionOutput);
+    if (hd)
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(hd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(hd->GetDataSet(iter));
+        if (pd)
+        {
+          interactions.push_back(pd);
+        }
+      }
+    }
+    else if (vtkPolyData* pd = vtkPolyData::SafeDownCast(interactionOutput))
+    {
+      interactions.push_back(pd);
+    }
+  }
+
+  void Initialize()
+  {
+    // called for each batch, the thread local objects are kept
+    LocalData& local = this->Locals.Local();
+    if (local.Tracker)
+    {
+      return;
+    }
+    vtkLagrangianParticleTracker* tracker = this->Tracker;
+    vtkSmartPointer<vtkLagrangianBasicIntegrationModel> model =
+      vtkSmartPointer<vtkLagrangianBasicIntegrationModel>::Take(
+        tracker->IntegrationModel->NewInstance());
+    model->ShallowCopy(tracker->IntegrationModel);
+    vtkSmartPointer<vtkInitialValueProblemSolver> integrator =
+      vtkSmartPointer<vtkInitialValueProblemSolver>::Take(tracker->Integrator->NewInstance());
+    integrator->SetFunctionSet(model);
+
+    local.Tracker = vtkSmartPointer<vtkLagrangianParticleTracker>::Take(tracker->NewInstance());
+    local.Tracker->SetIntegrationModel(model);
+    local.Tracker->SetIntegrator(integrator);
+    local.Tracker->CellLengthComputationMode = tracker->CellLengthComputationMode;
+    local.Tracker->StepFactor = tracker->StepFactor;
+    local.Tracker->StepFactorMin = tracker->StepFactorMin;
+    local.Tracker->StepFactorMax = tracker->StepFactorMax;
+    local.Tracker->MaximumNumberOfSteps = tracker->MaximumNumberOfSteps;
+    local.Tracker->MaximumIntegrationTime = tracker->MaximumIntegrationTime;
+    local.Tracker->AdaptiveStepReintegration = tracker->AdaptiveStepReintegration;
+    local.Tracker->MinimumVelocityMagnitude = tracker->MinimumVelocityMagnitude;
+    local.Tracker->MinimumReductionFactor = tracker->MinimumReductionFactor;
+
+    // Local outputs with the structure of the outputs
+    local.ParticlePathsOutput = vtkSmartPointer<vtkPolyData>::New();
+    CopyOutputStructure(this->ParticlePathsOutput, local.ParticlePathsOutput);
+    local.InteractionOutput =
+      vtkSmartPointer<vtkDataObject>::Take(this->InteractionOutput->NewInstance());
+    vtkCompositeDataSet* hd = vtkCompositeDataSet::SafeDownCast(this->InteractionOutput);
+    if (hd)
+    {
+      vtkCompositeDataSet* localHd =
+        vtkCompositeDataSet::SafeDownCast(local.InteractionOutput);
+      localHd->CopyStructure(hd);
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(hd->NewIterator());
+      for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        vtkPolyData* pd = vtkPolyData::SafeDownCast(hd->GetDataSet(iter));
+        if (pd)
+        {
+          vtkNew<vtkPolyData> localPd;
+          CopyOutputStructure(pd, localPd);
+          localHd->SetDataSet(iter, localPd);
+        }
+      }
+    }
+    else if (vtkPolyData* pd = vtkPolyData::SafeDownCast(this->InteractionOutput))
+    {
+      CopyOutputStructure(pd, vtkPolyData::SafeDownCast(local.InteractionOutput));
+    }
+    this->GetInteractions(local.InteractionOutput, local.Interactions);
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData& local = this->Locals.Local();
+    vtkNew<vtkIdList> particlePathPointId;
+    size_t nInteractions = local.Interactions.size();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      Result& result = this->Results[i];
+      result.Local = &local;
+      result.PathStart = local.ParticlePathsOutput->GetNumberOfPoints();
+      result.InteractionStarts.resize(nInteractions);
+      result.InteractionEnds.resize(nInteractions);
+      for (size_t j = 0; j < nInteractions; j++)
+      {
+        result.InteractionStarts[j] = local.Interactions[j]->GetNumberOfPoints();
+      }
+
+      particlePathPointId->Reset();
+      local.Tracker->Integrate(this->Particles[i], local.NewParticles,
+        local.ParticlePathsOutput, particlePathPointId, local.InteractionOutput);
+
+      result.PathEnd = local.ParticlePathsOutput->GetNumberOfPoints();
+      result.PathPointIds.assign(particlePathPointId->GetPointer(0),
+        particlePathPointId->GetPointer(0) + particlePathPointId->GetNumberOfIds());
+      for (size_t j = 0; j < nInteractions; j++)
+      {
+        result.InteractionEnds[j] = local.Interactions[j]->GetNumberOfPoints();
+      }
+      result.NewParticles.clear();
+      while (!local.NewParticles.empty())
+      {
+        result.NewParticles.push_back(local.NewParticles.front());
+        local.NewParticles.pop();
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  // Add the paths and interactions to the outputs in the particle order and
+  // queue the new particles.
+  void Gather(std::queue<vtkLagrangianParticle*>& particlesQueue)
+  {
+    vtkLagrangianParticleTracker* tracker = this->Tracker;
+    vtkPolyData* particlePathsOutput = this->ParticlePathsOutput;
+    for (size_t i = 0; i < this->Particles.size(); ++i)
+    {
+      vtkLagrangianParticle* particle = this->Particles[i];
+      Result& result = this->Results[i];
+      LocalData* local = result.Local;
+
+      std::vector<vtkIdType>& ids = result.PathPointIds;
+      if (!ids.empty())
+      {
+        vtkIdType start = AppendPoints(
+          local->ParticlePathsOutput, result.PathStart, result.PathEnd, particlePathsOutput);
+        for (size_t j = 0; j < ids.size(); j++)
+        {
+          ids[j] += start - result.PathStart;
+        }
+
+        // Duplicate single point particle paths, to avoid degenerated lines.
+        if (ids.size() == 1)
+        {
+          ids.push_back(ids[0]);
+        }
+
+        // Add particle path or vertex to cell array
+        particlePathsOutput->GetLines()->InsertNextCell(
+          static_cast<vtkIdType>(ids.size()), ids.data());
+        tracker->InsertPathData(particle, particlePathsOutput->GetCellData());
+        tracker->IntegrationModel->InsertModelPathData(
+          particle, particlePathsOutput->GetCellData());
+
+        // Insert data from seed data only on not yet written arrays
+        tracker->InsertSeedData(particle, particlePathsOutput->GetCellData());
+      }
+
+      for (size_t j = 0; j < this->Interactions.size(); j++)
+      {
+        AppendPoints(local->Interactions[j], result.InteractionStarts[j],
+          result.InteractionEnds[j], this->Interactions[j]);
+      }
+
+      for (size_t j = 0; j < result.NewParticles.size(); j++)
+      {
+        particlesQueue.push(result.NewParticles[j]);
+      }
+
+      // Delete integrated particle
+      delete particle;
+    }
+
+    for (vtkSMPThreadLocal<LocalData>::iterator local = this->Locals.begin();
+      local != this->Locals.end(); ++local)
+    {
+      local->ParticlePathsOutput->GetPoints()->Reset();
+      local->ParticlePathsOutput->GetPointData()->Reset();
+      for (size_t j = 0; j < local->Interactions.size(); j++)
+      {
+        if (local->Interactions[j]->GetPoints())
+        {
+          local->Interactions[j]->GetPoints()->Reset();
+        }
+        local->Interactions[j]->GetPointData()->Reset();
+      }
+    }
+  }
+};
+
+//---------------------------------------------------------------------------
+bool vtkLagrangianParticleTracker::CanIntegrateInParallel()
+{
+  return this->IntegrationModel->GetThreadSafe() &&
+    !this->IntegrationModel->HasBreakUpSurfaces();
+}
+
+//---------------------------------------------------------------------------
+void vtkLagrangianParticleTracker::IntegrateInParallel(
+  std::queue<vtkLagrangianParticle*>& particlesQueue,
+  vtkPolyData* particlePathsOutput, vtkDataObject* interactionOutput)
+{
+  // Particles are integrated in batches, between which the outputs and the
+  // queue are updated and the progress and abort flag are checked
+  const size_t batchSize = 1000;
+  ParticleIntegrator integrator(this, particlePathsOutput, interactionOutput);
+  vtkIdType numberOfParticles = 0;
+  while (!this->GetAbortExecute())
+  {
+    // Check for particle feed
+    this->GetParticleFeed(particlesQueue);
+    if (particlesQueue.empty())
+    {
+      break;
+    }
+
+    integrator.Particles.clear();
+    while (!particlesQueue.empty() && integrator.Particles.size() < batchSize)
+    {
+      integrator.Particles.push_back(particlesQueue.front());
+      particlesQueue.pop();
+    }
+    integrator.Results.resize(integrator.Particles.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(integrator.Particles.size()), integrator);
+    integrator.Gather(particlesQueue);
+
+    numberOfParticles += static_cast<vtkIdType>(integrator.Particles.size());
+    this->UpdateProgress(std::min(1.0,
+      static_cast<double>(numberOfParticles) / this->ParticleCounter));
+  }
+}
+
 //---------------------------------------------------------------------------
 void vtkLagrangianParticleTracker::InsertPathOutputPoint(
   vtkLagrangianParticle* particle, vtkPolyData* particlePathsOutput,
@@ -1265,8 +1599,7 @@ void vtkLagrangianParticleTracker::InsertSeedData(vtkLagrangianParticle* particl
     vtkDataArray* arr = data->GetArray(name);
     if (arr->GetNumberOfTuples() < maxTuples)
     {
-      arr->InsertNextTuple(
-        seedData->GetArray(i)->GetTuple(particle->GetSeedArrayTupleIndex()));
+      arr->InsertNextTuple(particle->GetSeedArrayTupleIndex(), seedData->GetArray(i));
     }
   }
   // here all arrays from data should have the exact same size
@@ -1340,7 +1673,8 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
     vtkIdType cellId;
     if (this->IntegrationModel->FindInLocators(particle->GetPosition(), dataset, cellId))
     {
-      cell = dataset->GetCell(cellId);
+      dataset->GetCell(cellId, this->GenericCell);
+      cell = this->GenericCell;
     }
     else
     {
@@ -1357,11 +1691,12 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
     {
       return cellLength;
     }
-    cell = dataset->GetCell(particle->GetLastCellId());
-    if (!cell)
+    dataset->GetCell(particle->GetLastCellId(), this->GenericCell);
+    if (this->GenericCell->GetCellType() == VTK_EMPTY_CELL)
     {
       return cellLength;
     }
+    cell = this->GenericCell;
   }
   if (cell == nullptr)
   {
@@ -1394,7 +1729,7 @@ double vtkLagrangianParticleTracker::ComputeCellLength(
   }
   else if ((this->CellLengthComputationMode == STEP_CUR_CELL_DIV_THEO ||
     this->CellLengthComputationMode == STEP_LAST_CELL_DIV_THEO) &&
-      vtkMath::Norm(vel) > 0.0 && !vtkVoxel::SafeDownCast(cell))
+      vtkMath::Norm(vel) > 0.0 && cell->GetCellType() != VTK_VOXEL)
   {
     double velHat[3] = {vel[0], vel[1], vel[2]};
     vtkMath::Normalize(velHat);
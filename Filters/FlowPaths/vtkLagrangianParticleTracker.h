@@ -79,6 +79,17 @@
  *      break-up and pass-through surface
  * The serial and parallel filters are fully tested.
  *
+ * Concurrent integration is opt-in: the particles are integrated serially
+ * unless the integration model is flagged as thread safe, which none of the
+ * models provided with VTK is by default (see
+ * vtkLagrangianBasicIntegrationModel::SetThreadSafe). With such a model and
+ * no break-up surface, the particles are integrated in batches using
+ * vtkSMPTools, each thread using its own copy of the integration model,
+ * integrator and tracker parameters. The paths and interactions are then
+ * added to the outputs in the particle queue order, so they do not depend on
+ * the number of threads. vtkPLagrangianParticleTracker integrates particles
+ * serially when it streams particles between ranks.
+ *
  * @sa
  * vtkLagrangianMatidaIntegrationModel vtkLagrangianParticle
  * vtkLagrangianBasicIntegrationModel
@@ -90,13 +101,16 @@
 #include "vtkFiltersFlowPathsModule.h" // For export macro
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkBoundingBox.h" // For cached bounds
+#include "vtkNew.h" // For generic cell
 
+#include <atomic> // for particle counter
 #include <queue> // for particle queue
 
 class vtkBoundingBox;
 class vtkCellArray;
 class vtkDataSet;
 class vtkDoubleArray;
+class vtkGenericCell;
 class vtkIdList;
 class vtkInformation;
 class vtkInitialValueProblemSolver;
@@ -321,7 +335,9 @@ public:
   vtkMTimeType GetMTime() override;
 
   /**
-   * Get an unique id for a particle
+   * Get an unique id for a particle.
+   * Thread safe: the counter is atomic, since the callbacks of the
+   * integration model may create particles from several threads.
    */
   virtual vtkIdType GetNewParticleId();
 
@@ -367,6 +383,20 @@ protected:
     vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
     vtkDataObject* interactionOutput);
 
+  /**
+   * Return true if the particles can be integrated concurrently, which
+   * requires an integration model flagged as thread safe and no break-up
+   * surface.
+   */
+  virtual bool CanIntegrateInParallel();
+
+  /**
+   * Integrate the particles of the queue in parallel, and particles created
+   * by the integration, until the queue is empty.
+   */
+  void IntegrateInParallel(std::queue<vtkLagrangianParticle*>& particleQueue,
+    vtkPolyData* particlePathsOutput, vtkDataObject* interactionOutput);
+
   void InsertPathOutputPoint(vtkLagrangianParticle* particle,
     vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
     bool prev = false);
@@ -402,7 +432,10 @@ protected:
   bool UseParticlePathsRenderingThreshold;
   bool GeneratePolyVertexInteractionOutput;
   int ParticlePathsRenderingPointsThreshold;
-  vtkIdType ParticleCounter;
+  std::atomic<vtkIdType> ParticleCounter;
+
+  // Used to compute the cell length
+  vtkNew<vtkGenericCell> GenericCell;
 
   // internal parameters use for step computation
   double MinimumVelocityMagnitude;
@@ -416,6 +449,9 @@ protected:
   vtkMTimeType SurfacesTime;
 
 private:
+  // Integrate particles concurrently, see IntegrateInParallel
+  struct ParticleIntegrator;
+
   vtkLagrangianParticleTracker(const vtkLagrangianParticleTracker&) = delete;
   void operator=(const vtkLagrangianParticleTracker&) = delete;
 };
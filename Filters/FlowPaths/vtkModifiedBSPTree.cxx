@@ -653,26 +653,9 @@ int BSPNode::getDominantAxis(const double dir[3])
   }
 }
 //---------------------------------------------------------------------------
-int vtkModifiedBSPTree::IntersectWithLine(const double p1[3],
-                                          const double p2[3],
-                                          double tol,
-                                          double &t,
-                                          double x[3],
-                                          double pcoords[3],
-                                          int &subId,
-                                          vtkIdType &cellId,
-                                          vtkGenericCell *cell)
-{
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
-}
-//---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-                                          double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId)
+                                          double &t, double x[3], double pcoords[3], int &subId, vtkIdType &cellId,
+                                          vtkGenericCell *cell)
 {
   //
   BSPNode  *node, *Near, *Mid, *Far;
@@ -776,7 +759,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
       ctmin = _tmin; ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit<closest_intersection)
           {
@@ -795,6 +778,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellId, cell);
   }
   //
   return HIT;
@@ -930,7 +914,7 @@ int vtkModifiedBSPTree::IntersectWithLine(
       ctmin = _tmin; ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, this->GenericCell))
         {
           if (points)
           {
@@ -976,6 +960,50 @@ int vtkModifiedBSPTree::IntersectWithLine(
   return HIT;
 }
 //---------------------------------------------------------------------------
+// This is here to shut off warnings about the generic cell overload of
+// IntersectCellInternal() calling the deprecated one.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+# pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+#ifdef _MSC_VER
+# pragma warning (disable: 4996)
+#endif
+
+#if !defined(VTK_LEGACY_REMOVE)
+// Value of subId with which the generic cell overload of
+// IntersectCellInternal() calls the deprecated one. The default deprecated
+// overload then returns -1 to let the caller test the cell itself.
+static const int vtkModifiedBSPTreeLegacyIntersectMarker = VTK_INT_MIN;
+#endif
+
+//---------------------------------------------------------------------------
+int vtkModifiedBSPTree::IntersectCellInternal(
+  vtkIdType cell_ID,
+  const double p1[3],
+  const double p2[3],
+  const double tol,
+  double &t,
+  double ipt[3],
+  double pcoords[3],
+  int &subId,
+  vtkGenericCell *cell)
+{
+#if !defined(VTK_LEGACY_REMOVE)
+  // Give subclasses that override the deprecated overload a chance to test
+  // the cell.
+  subId = vtkModifiedBSPTreeLegacyIntersectMarker;
+  int hit = this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId);
+  if (hit != -1)
+  {
+    return hit;
+  }
+#endif
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+}
+//---------------------------------------------------------------------------
+#if !defined(VTK_LEGACY_REMOVE)
 int vtkModifiedBSPTree::IntersectCellInternal(
   vtkIdType cell_ID,
   const double p1[3],
@@ -986,9 +1014,17 @@ int vtkModifiedBSPTree::IntersectCellInternal(
   double pcoords[3],
   int &subId)
 {
+  if (subId == vtkModifiedBSPTreeLegacyIntersectMarker)
+  {
+    // Not overridden, let the generic cell overload test the cell
+    return -1;
+  }
+  VTK_LEGACY_REPLACED_BODY(vtkModifiedBSPTree::IntersectCellInternal, "VTK 9.0",
+    vtkModifiedBSPTree::IntersectCellInternal with a vtkGenericCell);
   this->DataSet->GetCell(cell_ID, this->GenericCell);
   return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
+#endif
 //////////////////////////////////////////////////////////////////////////////
 // FindCell stuff
 //////////////////////////////////////////////////////////////////////////////
@@ -1093,6 +1129,18 @@ vtkIdListCollection *vtkModifiedBSPTree::GetLeafNodeCellInformation()
   return LeafCellsList;
 }
 //----------------------------------------------------------------------------
+void vtkModifiedBSPTree::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, true);
+}
+//----------------------------------------------------------------------------
+void vtkModifiedBSPTree::IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                            double tol, vtkPoints *points,
+                                            vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, true);
+}
+//----------------------------------------------------------------------------
 void vtkModifiedBSPTree::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
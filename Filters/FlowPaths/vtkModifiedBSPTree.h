@@ -192,16 +192,33 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
    */
   virtual void GenerateRepresentationLeafs(vtkPolyData *pd);
 
+  //@{
+  /**
+   * Batched queries, see vtkAbstractCellLocator. FindCells() and
+   * IntersectWithLines() issue their queries in parallel with vtkSMPTools,
+   * since FindCell() and IntersectWithLine() are thread safe once the tree
+   * is built.
+   */
+  void FindCells(vtkPoints *points, vtkIdList *cellIds) override;
+  void IntersectWithLines(vtkPoints *starts, vtkPoints *ends, double tol,
+                          vtkPoints *points, vtkIdList *cellIds) override;
+  //@}
+
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. Uses fast tree-search BBox rejection tests.
    */
   int IntersectWithLine(const double p1[3], const double p2[3], double tol, double &t, double x[3],
-    double pcoords[3], int &subId, vtkIdType &cellId) override;
+    double pcoords[3], int &subId, vtkIdType &cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
 
   /**
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic cell.
+   * The generic cell is used for the cell intersections, so concurrent
+   * queries should each provide their own.
    */
   int IntersectWithLine(const double p1[3], const double p2[3], double tol, double &t, double x[3],
     double pcoords[3], int &subId, vtkIdType &cellId, vtkGenericCell *cell) override;
@@ -248,12 +265,25 @@ class VTKFILTERSFLOWPATHS_EXPORT vtkModifiedBSPTree : public vtkAbstractCellLoca
   void Subdivide(BSPNode *node, Sorted_cell_extents_Lists *lists, vtkDataSet *dataSet,
     vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int &MaxDepth);
 
+  // The cell/ray test used by the tree search. The cell is the scratch
+  // space of the calling query, so that concurrent queries do not share one.
+  // Unless legacy code is removed, it calls the deprecated overload below so
+  // that subclasses overriding that one keep working.
+  virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
+    const double tol, double &t, double ipt[3], double pcoords[3], int &subId,
+    vtkGenericCell *cell);
+
   // We provide a function which does the cell/ray test so that
   // it can be overridden by subclasses to perform special treatment
   // (Example : Particles stored in tree, have no dimension, so we must
   // override the cell test to return a value based on some particle size
-  virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
-    const double tol, double &t, double ipt[3], double pcoords[3], int &subId);
+  // @deprecated Replaced by the IntersectCellInternal() taking a generic cell
+  // as of VTK 9.0. Overrides are called by queries running concurrently, so
+  // they must not modify the locator, and should not call this superclass
+  // implementation, which returns -1 when called by the tree search.
+  VTK_LEGACY(virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+    const double p2[3], const double tol, double &t, double ipt[3], double pcoords[3],
+    int &subId));
 
   void BuildLocatorIfNeeded();
   void ForceBuildLocator();
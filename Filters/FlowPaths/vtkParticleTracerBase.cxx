@@ -34,12 +34,15 @@
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTemporalInterpolatedVelocityField.h"
 #include <cassert>
 
 #include <functional>
+#include <iterator>
 #include <algorithm>
 #ifdef DEBUGPARTICLETRACE
 #define Assert(x) assert(x)
@@ -802,13 +805,6 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
 
   std::vector<vtkDataSet*> seedSources = this->GetSeedSources(inputVector[1], this->CurrentTimeStep);
 
-  //
-  // Setup some variables
-  //
-  vtkSmartPointer<vtkInitialValueProblemSolver> integrator;
-  integrator.TakeReference(this->GetIntegrator()->NewInstance());
-  integrator->SetFunctionSet(this->Interpolator);
-
   //
   // Make sure the Particle Positions are initialized with Seed particles
   //
@@ -854,7 +850,6 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
   {
     ParticleListIterator  it_first = this->ParticleHistories.begin();
     ParticleListIterator  it_last  = this->ParticleHistories.end();
-    ParticleListIterator  it_next;
 
     //
     // Perform multiple passes. The number of passes is equal to one more than
@@ -864,19 +859,7 @@ vtkPolyData* vtkParticleTracerBase::Execute(vtkInformationVector** inputVector)
     while(continueExecuting)
     {
       vtkDebugMacro(<<"Begin Pass " << pass << " with " << this->ParticleHistories.size() << " Particles");
-      for (ParticleListIterator it=it_first; it!=it_last;)
-      {
-        // Keep the 'next' iterator handy because if a particle is terminated
-        // or leaves the domain, the 'current' iterator will be deleted.
-        it_next = it;
-        it_next++;
-        this->IntegrateParticle(it, from, this->CurrentTimeValue, integrator);
-        if (this->GetAbortExecute())
-        {
-          break;
-        }
-        it = it_next;
-      }
+      this->IntegrateParticles(it_first, it_last, from, this->CurrentTimeValue);
       // Particles might have been deleted during the first pass as they move
       // out of domain or age. Before adding any new particles that are sent
       // to us, we must know the starting point ready for the next pass
@@ -1056,183 +1039,359 @@ int vtkParticleTracerBase::RequestData(
 }
 
 //---------------------------------------------------------------------------
-void vtkParticleTracerBase::IntegrateParticle(
-  ParticleListIterator &it, double currenttime, double targettime,
-  vtkInitialValueProblemSolver* integrator)
+struct vtkParticleTracerBase::ParticleIntegrator
 {
-  double epsilon = (targettime-currenttime)/100.0;
-  double velocity[3], point1[4], point2[4] = {0.0, 0.0, 0.0, 0.0};
-  double minStep=0, maxStep=0;
-  double stepWanted, stepTaken=0.0;
-  int substeps = 0;
+  // What the serial gather does with an advanced particle
+  enum Outcome
+  {
+    PARTICLE_ADDED,   // not advanced, added as is
+    PARTICLE_MOVED,   // added, unless it stagnates
+    PARTICLE_OUTSIDE, // sent, or handled as moved if no other process takes it
+    PARTICLE_FAILED   // the integration failed, sent with its previous data
+  };
+
+  struct LocalData
+  {
+    vtkSmartPointer<vtkTemporalInterpolatedVelocityField> Interpolator;
+    vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+    vtkSmartPointer<vtkPointData> PointData;
+    vtkSmartPointer<vtkDoubleArray> CellVectors;
+    vtkIdType NumberOfPoints;
+  };
+
+  struct Result
+  {
+    ParticleInformation Previous;
+    int Outcome;
+    double Velocity[3];
+    vtkIdType CachedCellId[2];
+    int CachedDataSetId[2];
+    // interpolated point data, PointDataId is -1 if there is none
+    LocalData* Local;
+    vtkIdType PointDataId;
+    double Vorticity[3];
+  };
+
+  vtkParticleTracerBase* Tracer;
+  double CurrentTime;
+  double TargetTime;
+  std::vector<ParticleListIterator> Particles;
+  std::vector<Result> Results;
+  vtkSMPThreadLocal<LocalData> Locals;
+
+  ParticleIntegrator(vtkParticleTracerBase* tracer, double currenttime, double targettime)
+    : Tracer(tracer)
+    , CurrentTime(currenttime)
+    , TargetTime(targettime)
+  {
+  }
+
+  void Initialize()
+  {
+    // called for each batch, the thread local objects are kept
+    LocalData& local = this->Locals.Local();
+    if (local.Interpolator)
+    {
+      return;
+    }
+    local.Interpolator = vtkSmartPointer<vtkTemporalInterpolatedVelocityField>::New();
+    local.Interpolator->ShallowCopy(this->Tracer->Interpolator);
+    local.Integrator.TakeReference(this->Tracer->GetIntegrator()->NewInstance());
+    local.Integrator->SetFunctionSet(local.Interpolator);
+    local.PointData = vtkSmartPointer<vtkPointData>::New();
+    local.PointData->InterpolateAllocate(this->Tracer->DataReferenceT[0]->GetPointData());
+    local.CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+    local.CellVectors->SetNumberOfComponents(3);
+    local.CellVectors->Allocate(3*VTK_CELL_SIZE);
+    local.NumberOfPoints = 0;
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData& local = this->Locals.Local();
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Advance(*this->Particles[i], local, this->Results[i]);
+    }
+  }
 
-  ParticleInformation &info = (*it);
-  ParticleInformation previous = (*it);
-  bool particle_good = true;
+  void Reduce() {}
 
-  info.ErrorCode = 0;
+  // Integrate a particle between the two times, without modifying the
+  // particle list or the output.
+  void Advance(ParticleInformation &info, LocalData &local, Result &result)
+  {
+    vtkParticleTracerBase* tracer = this->Tracer;
+    vtkTemporalInterpolatedVelocityField* interpolator = local.Interpolator;
+    double currenttime = this->CurrentTime;
+    double targettime = this->TargetTime;
+    double epsilon = (targettime-currenttime)/100.0;
+    double point1[4], point2[4] = {0.0, 0.0, 0.0, 0.0};
+    double minStep=0, maxStep=0;
+    double stepWanted, stepTaken=0.0;
+    int substeps = 0;
 
-  // Get the Initial point {x,y,z,t}
-  memcpy(point1, &info.CurrentPosition, sizeof(Position));
+    result.Previous = info;
+    result.Local = &local;
+    result.PointDataId = -1;
 
-  if(currenttime==targettime)
-  {
-    Assert(point1[3]==currenttime);
-  }
-  else
-  {
-    Assert (point1[3]>=(currenttime-epsilon) && point1[3]<=(targettime+epsilon));
+    info.ErrorCode = 0;
 
-    //
-    // begin interpolation between available time values, if the particle has
-    // a cached cell ID and dataset - try to use it,
-    //
-    if(this->AllFixedGeometry)
+    // Get the Initial point {x,y,z,t}
+    memcpy(point1, &info.CurrentPosition, sizeof(Position));
+
+    if(currenttime==targettime)
     {
-      this->Interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+      Assert(point1[3]==currenttime);
+      // the particle does not move, locate it to interpolate its scalars
+      interpolator->TestPoint(point1);
+      interpolator->GetLastGoodVelocity(result.Velocity);
+      result.Outcome = PARTICLE_ADDED;
     }
     else
     {
-      this->Interpolator->ClearCache();
-    }
-
-    double delT = (targettime-currenttime) * this->IntegrationStep;
-    epsilon = delT*1E-3;
+      Assert (point1[3]>=(currenttime-epsilon) && point1[3]<=(targettime+epsilon));
 
-    while (point1[3] < (targettime-epsilon))
-    {
       //
-      // Here beginneth the real work
+      // begin interpolation between available time values, if the particle has
+      // a cached cell ID and dataset - try to use it,
       //
-      double error = 0;
-
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      stepWanted = delT;
-      if ( (point1[3] + stepWanted) > targettime )
+      if(tracer->AllFixedGeometry)
       {
-        stepWanted = targettime - point1[3];
-        maxStep = stepWanted;
+        interpolator->SetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
       }
+      else
+      {
+        interpolator->ClearCache();
+      }
+
+      double delT = (targettime-currenttime) * tracer->IntegrationStep;
+      epsilon = delT*1E-3;
 
-      // Calculate the next step using the integrator provided.
-      // If the next point is out of bounds, send it to another process
-      if (integrator->ComputeNextStep(
-            point1, point2, point1[3], stepWanted,
-            stepTaken, minStep, maxStep,
-            this->MaximumError, error) != 0)
+      while (point1[3] < (targettime-epsilon))
       {
-        // if the particle is sent, remove it from the list
-        info.ErrorCode = 1;
-        if (!this->RetryWithPush(info, point1, delT, substeps))
+        //
+        // Here beginneth the real work
+        //
+        double error = 0;
+
+        // If, with the next step, propagation will be larger than
+        // max, reduce it so that it is (approximately) equal to max.
+        stepWanted = delT;
+        if ( (point1[3] + stepWanted) > targettime )
         {
-          if(previous.PointId <0 && previous.TailPointId < 0)
-          {
-            vtkErrorMacro("the particle should have been added");
-          }
-          else
-          {
-            this->SendParticleToAnotherProcess(info,previous, this->ParticlePointData);
-          }
-          this->ParticleHistories.erase(it);
-          particle_good = false;
-          break;
+          stepWanted = targettime - point1[3];
+          maxStep = stepWanted;
         }
-        else
+
+        // Calculate the next step using the integrator provided.
+        // If the next point is out of bounds, send it to another process
+        if (local.Integrator->ComputeNextStep(
+              point1, point2, point1[3], stepWanted,
+              stepTaken, minStep, maxStep,
+              tracer->MaximumError, error) != 0)
         {
+          info.ErrorCode = 1;
+          if (!tracer->RetryWithPush(interpolator, info, point1, delT, substeps))
+          {
+            result.Outcome = PARTICLE_FAILED;
+            return;
+          }
           // particle was not sent, retry saved it, so copy info back
           substeps++;
           memcpy(point1, &info.CurrentPosition, sizeof(Position));
         }
-      }
-      else // success, increment position/time
-      {
-        substeps++;
-
-        // increment the particle time
-        point2[3] = point1[3] + stepTaken;
-        info.age += stepTaken;
-        info.SimulationTime += stepTaken;
+        else // success, increment position/time
+        {
+          substeps++;
 
-        // Point is valid. Insert it.
-        memcpy(&info.CurrentPosition, point2, sizeof(Position));
-        memcpy(point1, point2, sizeof(Position));
-      }
+          // increment the particle time
+          point2[3] = point1[3] + stepTaken;
+          info.age += stepTaken;
+          info.SimulationTime += stepTaken;
 
-      // If the solver is adaptive and the next time step (delT.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the Cell
-      // size (unless it is specified in time units)
-      if (integrator->IsAdaptive())
-      {
-        // code removed. Put it back when this is stable
+          // Point is valid. Insert it.
+          memcpy(&info.CurrentPosition, point2, sizeof(Position));
+          memcpy(point1, point2, sizeof(Position));
+        }
       }
-    }
 
-    if (particle_good)
-    {
       // The integration succeeded, but check the computed final position
       // is actually inside the domain (the intermediate steps taken inside
       // the integrator were ok, but the final step may just pass out)
       // if it moves out, we can't interpolate scalars, so we must send it away
-      info.LocationState = this->Interpolator->TestPoint(info.CurrentPosition.x);
+      info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
+      result.Outcome = PARTICLE_MOVED;
       if (info.LocationState==ID_OUTSIDE_ALL)
       {
         info.ErrorCode = 2;
-        // if the particle is sent, remove it from the list
-        if (this->SendParticleToAnotherProcess(info,previous,this->OutputPointData))
-        {
-          this->ParticleHistories.erase(it);
-          particle_good = false;
-        }
+        result.Outcome = PARTICLE_OUTSIDE;
       }
-    }
+      interpolator->GetLastGoodVelocity(result.Velocity);
 
-    // Has this particle stagnated
-    //
-    if (particle_good)
-    {
-      this->Interpolator->GetLastGoodVelocity(velocity);
-      info.speed = vtkMath::Norm(velocity);
-      if (it->speed <= this->TerminalSpeed)
+      // a stagnating particle is erased, there is nothing to interpolate
+      float speed = vtkMath::Norm(result.Velocity);
+      if (speed <= tracer->TerminalSpeed)
       {
-        this->ParticleHistories.erase(it);
-        particle_good = false;
+        return;
       }
     }
-  }
 
-  //
-  // We got this far without error :
-  // Insert the point into the output
-  // Create any new scalars and interpolate existing ones
-  // Cache cell ids and datasets
-  //
-  if (particle_good)
-  {
     //
-    // store the last Cell Ids and dataset indices for next time particle is updated
+    // store the last Cell Ids and dataset indices for next time particle is
+    // updated, and interpolate the scalars in case the particle is added
     //
-    this->Interpolator->GetCachedCellIds(info.CachedCellId, info.CachedDataSetId);
+    interpolator->GetCachedCellIds(result.CachedCellId, result.CachedDataSetId);
     //
-    info.TimeStepAge += 1;
+    // In principle we always integrate the particle until it reaches Time2
+    // - so we don't need to do any interpolation of the scalars
+    // between T0 and T1, just fetch the values
+    // of the spatially interpolated scalars from T1.
     //
-    // Now generate the output geometry and scalars
+    int T = info.LocationState==ID_OUTSIDE_T1 ? 0 : 1;
+    if (interpolator->InterpolatePoint(T, local.PointData, local.NumberOfPoints))
+    {
+      result.PointDataId = local.NumberOfPoints++;
+    }
+    //
+    // Compute vorticity
     //
-    this->AddParticle(info,velocity);
+    if (tracer->ComputeVorticity)
+    {
+      vtkGenericCell *cell(nullptr);
+      double pcoords[3], weights[256];
+      // have to use T0 if particle is out at T1, otherwise use T1
+      interpolator->GetVorticityData(
+        T, pcoords, weights, cell, local.CellVectors);
+      tracer->CalculateVorticity(cell, pcoords, local.CellVectors, result.Vorticity);
+    }
+
+#ifdef DEBUGPARTICLETRACE
+    double eps = (tracer->GetCacheDataTime(1)-tracer->GetCacheDataTime(0))/100;
+    Assert (point1[3]>=(tracer->GetCacheDataTime(0)-eps) && point1[3]<=(tracer->GetCacheDataTime(1)+eps));
+#endif
   }
-  else
+
+  // Send, erase or add the advanced particles in list order.
+  void Gather()
   {
-    this->Interpolator->ClearCache();
+    vtkParticleTracerBase* tracer = this->Tracer;
+    for (size_t i = 0; i < this->Particles.size(); ++i)
+    {
+      ParticleListIterator it = this->Particles[i];
+      ParticleInformation &info = *it;
+      Result &result = this->Results[i];
+
+      if (result.Outcome == PARTICLE_FAILED)
+      {
+        // if the particle is sent, remove it from the list
+        if(result.Previous.PointId <0 && result.Previous.TailPointId < 0)
+        {
+          vtkErrorWithObjectMacro(tracer, "the particle should have been added");
+        }
+        else
+        {
+          tracer->SendParticleToAnotherProcess(info, result.Previous, tracer->ParticlePointData);
+        }
+        tracer->ParticleHistories.erase(it);
+        continue;
+      }
+      if (result.Outcome == PARTICLE_OUTSIDE &&
+        tracer->SendParticleToAnotherProcess(info, result.Previous, tracer->OutputPointData))
+      {
+        // if the particle is sent, remove it from the list
+        tracer->ParticleHistories.erase(it);
+        continue;
+      }
+      if (result.Outcome != PARTICLE_ADDED)
+      {
+        // Has this particle stagnated
+        info.speed = vtkMath::Norm(result.Velocity);
+        if (info.speed <= tracer->TerminalSpeed)
+        {
+          tracer->ParticleHistories.erase(it);
+          continue;
+        }
+      }
+
+      //
+      // We got this far without error :
+      // Insert the point into the output
+      // Copy the interpolated scalars and the vorticity
+      // Cache cell ids and datasets
+      //
+      info.CachedCellId[0] = result.CachedCellId[0];
+      info.CachedCellId[1] = result.CachedCellId[1];
+      info.CachedDataSetId[0] = result.CachedDataSetId[0];
+      info.CachedDataSetId[1] = result.CachedDataSetId[1];
+      //
+      info.TimeStepAge += 1;
+      //
+      // Now generate the output geometry and scalars
+      //
+      vtkIdType tempId = tracer->AppendParticle(info);
+      if (result.PointDataId >= 0)
+      {
+        vtkPointData* pd = result.Local->PointData;
+        for (int a = 0; a < pd->GetNumberOfArrays(); a++)
+        {
+          tracer->OutputPointData->GetAbstractArray(a)->InsertTuple(
+            tempId, result.PointDataId, pd->GetAbstractArray(a));
+        }
+      }
+      if (tracer->ComputeVorticity)
+      {
+        tracer->AppendVorticity(info, result.Vorticity, result.Velocity);
+      }
+    }
+
+    for (vtkSMPThreadLocal<LocalData>::iterator local = this->Locals.begin();
+      local != this->Locals.end(); ++local)
+    {
+      local->PointData->Reset();
+      local->NumberOfPoints = 0;
+    }
   }
+};
 
-#ifdef DEBUGPARTICLETRACE
-  double eps = (this->GetCacheDataTime(1)-this->GetCacheDataTime(0))/100;
-  Assert (point1[3]>=(this->GetCacheDataTime(0)-eps) && point1[3]<=(this->GetCacheDataTime(1)+eps));
-#endif
+//---------------------------------------------------------------------------
+void vtkParticleTracerBase::IntegrateParticles(
+  ParticleListIterator first, ParticleListIterator last,
+  double currenttime, double targettime)
+{
+  // The threads share the locators, build them first
+  this->Interpolator->BuildLocators();
+
+  // Particles are advanced in batches, between which the particle list and
+  // the output are updated and the abort flag is checked
+  const size_t batchSize = 1000;
+  ParticleIntegrator integrator(this, currenttime, targettime);
+  ParticleListIterator it = first;
+  while (it != last && !this->GetAbortExecute())
+  {
+    integrator.Particles.clear();
+    for (; it != last && integrator.Particles.size() < batchSize; ++it)
+    {
+      integrator.Particles.push_back(it);
+    }
+    integrator.Results.resize(integrator.Particles.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(integrator.Particles.size()), integrator);
+    integrator.Gather();
+  }
 }
 
+//---------------------------------------------------------------------------
+#if !defined(VTK_LEGACY_REMOVE)
+void vtkParticleTracerBase::IntegrateParticle(
+  ParticleListIterator &it, double currenttime, double targettime,
+  vtkInitialValueProblemSolver* vtkNotUsed(integrator))
+{
+  VTK_LEGACY_REPLACED_BODY(vtkParticleTracerBase::IntegrateParticle, "VTK 9.0",
+                           vtkParticleTracerBase::IntegrateParticles);
+  this->IntegrateParticles(it, std::next(it), currenttime, targettime);
+}
+#endif
+
 //---------------------------------------------------------------------------
 void vtkParticleTracerBase::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1447,12 +1606,13 @@ void vtkParticleTracerBase::CreateProtoPD(vtkDataObject* input)
 
 //---------------------------------------------------------------------------
 bool vtkParticleTracerBase::RetryWithPush(
+  vtkTemporalInterpolatedVelocityField* interpolator,
   ParticleInformation &info,  double* point1,double delT, int substeps)
 {
   double velocity[3];
-  this->Interpolator->ClearCache();
+  interpolator->ClearCache();
 
-  info.LocationState = this->Interpolator->TestPoint(point1);
+  info.LocationState = interpolator->TestPoint(point1);
 
   if (info.LocationState==ID_OUTSIDE_ALL)
   {
@@ -1461,7 +1621,7 @@ bool vtkParticleTracerBase::RetryWithPush(
     // send the particle 'as is' and hope it lands in another process
     if (substeps>0)
     {
-      this->Interpolator->GetLastGoodVelocity(velocity);
+      interpolator->GetLastGoodVelocity(velocity);
     }
     else
     {
@@ -1472,19 +1632,19 @@ bool vtkParticleTracerBase::RetryWithPush(
   else if (info.LocationState==ID_OUTSIDE_T0)
   {
     // the particle left the volume but can be tested at T2, so use the velocity at T2
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     info.ErrorCode = 4;
   }
   else if (info.LocationState==ID_OUTSIDE_T1)
   {
     // the particle left the volume but can be tested at T1, so use the velocity at T1
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
     info.ErrorCode = 5;
   }
   else
   {
     // The test returned INSIDE_ALL, so test failed near start of integration,
-    this->Interpolator->GetLastGoodVelocity(velocity);
+    interpolator->GetLastGoodVelocity(velocity);
   }
 
   // try adding a one increment push to the particle to get over a rotating/moving boundary
@@ -1494,7 +1654,7 @@ bool vtkParticleTracerBase::RetryWithPush(
   }
 
   info.CurrentPosition.x[3] += delT;
-  info.LocationState = this->Interpolator->TestPoint(info.CurrentPosition.x);
+  info.LocationState = interpolator->TestPoint(info.CurrentPosition.x);
   info.age += delT;
   info.SimulationTime += delT; // = this->GetCurrentTimeValue();
 
@@ -1511,20 +1671,7 @@ bool vtkParticleTracerBase::RetryWithPush(
 void vtkParticleTracerBase::AddParticle(
   vtkParticleTracerBaseNamespace::ParticleInformation &info, double* velocity)
 {
-  const double    *coord = info.CurrentPosition.x;
-  vtkIdType tempId = this->OutputCoordinates->InsertNextPoint(coord);
-  // create the cell
-  this->ParticleCells->InsertNextCell(1, &tempId);
-  // set the easy scalars for this particle
-  this->ParticleIds->InsertNextValue(info.UniqueParticleId);
-  this->ParticleSourceIds->InsertNextValue(info.SourceID);
-  this->InjectedPointIds->InsertNextValue(info.InjectedPointId);
-  this->InjectedStepIds->InsertNextValue(info.InjectedStepId);
-  this->ErrorCodeArray->InsertNextValue(info.ErrorCode);
-  this->ParticleAge->InsertNextValue(info.age);
-  this->AppendToExtraPointDataArrays(info);
-  info.PointId = tempId;
-  info.TailPointId = -1;
+  vtkIdType tempId = this->AppendParticle(info);
 
   //
   // Interpolate all existing point attributes
@@ -1548,7 +1695,6 @@ void vtkParticleTracerBase::AddParticle(
   {
     vtkGenericCell *cell(nullptr);
     double pcoords[3], vorticity[3], weights[256];
-    double rotation, omega;
     // have to use T0 if particle is out at T1, otherwise use T1
     if (info.LocationState==ID_OUTSIDE_T1)
     {
@@ -1562,35 +1708,65 @@ void vtkParticleTracerBase::AddParticle(
     }
 
     this->CalculateVorticity(cell, pcoords, CellVectors, vorticity);
-    this->ParticleVorticity->InsertNextTuple(vorticity);
-    // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
-    if (info.speed != 0.0)
-    {
-      omega = vtkMath::Dot(vorticity, velocity);
-      omega /= info.speed;
-      omega *= this->RotationScale;
-    }
-    else
-    {
-      omega = 0.0;
-    }
-    vtkIdType index = this->ParticleAngularVel->InsertNextValue(omega);
-    if (index>0)
-    {
-      rotation     = info.rotation + (info.angularVel + omega)/2 * (info.CurrentPosition.x[3] - info.time);
-    }
-    else
-    {
-      rotation     = 0.0;
-    }
-    this->ParticleRotation->InsertNextValue(rotation);
-    info.rotation   = rotation;
-    info.angularVel = omega;
-    info.time       = info.CurrentPosition.x[3];
+    this->AppendVorticity(info, vorticity, velocity);
   }
 
 }
 
+//---------------------------------------------------------------------------
+vtkIdType vtkParticleTracerBase::AppendParticle(
+  vtkParticleTracerBaseNamespace::ParticleInformation &info)
+{
+  const double    *coord = info.CurrentPosition.x;
+  vtkIdType tempId = this->OutputCoordinates->InsertNextPoint(coord);
+  // create the cell
+  this->ParticleCells->InsertNextCell(1, &tempId);
+  // set the easy scalars for this particle
+  this->ParticleIds->InsertNextValue(info.UniqueParticleId);
+  this->ParticleSourceIds->InsertNextValue(info.SourceID);
+  this->InjectedPointIds->InsertNextValue(info.InjectedPointId);
+  this->InjectedStepIds->InsertNextValue(info.InjectedStepId);
+  this->ErrorCodeArray->InsertNextValue(info.ErrorCode);
+  this->ParticleAge->InsertNextValue(info.age);
+  this->AppendToExtraPointDataArrays(info);
+  info.PointId = tempId;
+  info.TailPointId = -1;
+  return tempId;
+}
+
+//---------------------------------------------------------------------------
+void vtkParticleTracerBase::AppendVorticity(
+  vtkParticleTracerBaseNamespace::ParticleInformation &info,
+  double vorticity[3], double* velocity)
+{
+  double rotation, omega;
+  this->ParticleVorticity->InsertNextTuple(vorticity);
+  // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
+  if (info.speed != 0.0)
+  {
+    omega = vtkMath::Dot(vorticity, velocity);
+    omega /= info.speed;
+    omega *= this->RotationScale;
+  }
+  else
+  {
+    omega = 0.0;
+  }
+  vtkIdType index = this->ParticleAngularVel->InsertNextValue(omega);
+  if (index>0)
+  {
+    rotation     = info.rotation + (info.angularVel + omega)/2 * (info.CurrentPosition.x[3] - info.time);
+  }
+  else
+  {
+    rotation     = 0.0;
+  }
+  this->ParticleRotation->InsertNextValue(rotation);
+  info.rotation   = rotation;
+  info.angularVel = omega;
+  info.time       = info.CurrentPosition.x[3];
+}
+
 //---------------------------------------------------------------------------
 bool vtkParticleTracerBase::IsPointDataValid(vtkDataObject* input)
 {
@@ -20,6 +20,12 @@
  * in a vector field. Note that the input vtkPointData structure must
  * be identical on all datasets.
  *
+ * Within a process, the particles are advected in parallel with
+ * vtkSMPTools, each thread using its own copy of the interpolator sharing
+ * the cell locators. The particles are then sent to other processes, erased
+ * or added to the output serially, in the order of the particle list, so
+ * that the output does not depend on the number of threads.
+ *
  * @sa
  * vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver
  * vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkStreamTracer
@@ -391,12 +397,24 @@ public:
   virtual bool UpdateParticleListFromOtherProcesses(){return false;}
 
   /**
-   * particle between the two times supplied.
+   * Advance the particles from first to last between the two times
+   * supplied, then send, erase or add them to the output.
    */
-  void IntegrateParticle(
+  void IntegrateParticles(
+    vtkParticleTracerBaseNamespace::ParticleListIterator first,
+    vtkParticleTracerBaseNamespace::ParticleListIterator last,
+    double currenttime, double terminationtime);
+
+  /**
+   * Advance one particle between the two times supplied.
+   * @deprecated VTK 9.0. Use IntegrateParticles() on the range of the
+   * particle instead. The integrator argument is ignored: the particle is
+   * advanced with a copy of the integrator of the filter.
+   */
+  VTK_LEGACY(void IntegrateParticle(
     vtkParticleTracerBaseNamespace::ParticleListIterator &it,
     double currenttime, double terminationtime,
-    vtkInitialValueProblemSolver* integrator);
+    vtkInitialValueProblemSolver* integrator));
 
   // if the particle is added to send list, then returns value is 1,
   // if it is kept on this process after a retry return value is 0
@@ -492,9 +510,23 @@ public:
    * first order integration though so it may introduce a bit extra error compared
    * to the integrator that is used.
    */
-  bool RetryWithPush(
+  bool RetryWithPush(vtkTemporalInterpolatedVelocityField* interpolator,
     vtkParticleTracerBaseNamespace::ParticleInformation &info, double* point1,double delT, int subSteps);
 
+  //@{
+  /**
+   * Append a particle, its scalars and its rotation to the output, see
+   * AddParticle().
+   */
+  vtkIdType AppendParticle(vtkParticleTracerBaseNamespace::ParticleInformation &info);
+  void AppendVorticity(vtkParticleTracerBaseNamespace::ParticleInformation &info,
+    double vorticity[3], double* velocity);
+  //@}
+
+  // Advances a range of particles with thread local objects, see
+  // IntegrateParticles().
+  struct ParticleIntegrator;
+
   bool SetTerminationTimeNoModify(double t);
 
   //Parameters of tracing
@@ -45,8 +45,11 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkRungeKutta2.h"
 #include "vtkRungeKutta4.h"
 #include "vtkRungeKutta45.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkObjectFactoryNewMacro(vtkStreamTracer)
@@ -652,566 +655,857 @@ int vtkStreamTracer::CheckInputs(vtkAbstractInterpolatedVelocityField*& func,
   return VTK_OK;
 }
 
-void vtkStreamTracer::Integrate(vtkPointData *input0Data,
-                                vtkPolyData* output,
-                                vtkDataArray* seedSource,
-                                vtkIdList* seedIds,
-                                vtkIntArray* integrationDirections,
-                                double lastPoint[3],
-                                vtkAbstractInterpolatedVelocityField* func,
-                                int maxCellSize,
-                                int vecType,
-                                const char *vecName,
-                                double& inPropagation,
-                                vtkIdType& inNumSteps,
-                                double &inIntegrationTime)
+//----------------------------------------------------------------------------
+// Integrates the seeds of a range with the objects of the calling thread.
+// The points and point attributes of the streamlines are appended to thread
+// local buffers, and each seed records where its streamline is stored, so
+// that the streamlines can be gathered in seed order once all seeds are
+// done.
+struct vtkStreamTracer::TracerIntegrator
 {
-  vtkIdType numLines = seedIds->GetNumberOfIds();
-  double propagation = inPropagation;
-  vtkIdType numSteps = inNumSteps;
-  double integrationTime = inIntegrationTime;
-
-  // Useful pointers
-  vtkDataSetAttributes* outputPD = output->GetPointData();
-  vtkDataSetAttributes* outputCD = output->GetCellData();
-  vtkPointData* inputPD;
-  vtkDataSet* input;
-  vtkDataArray* inVectors;
-
-  int direction=1;
-
-  if (this->GetIntegrator() == nullptr)
+  // Integration objects and output buffers of one thread
+  struct LocalData
+  {
+    vtkSmartPointer<vtkAbstractInterpolatedVelocityField> Func;
+    vtkSmartPointer<vtkInitialValueProblemSolver> Integrator;
+    vtkInterpolatedVelocityField* SurfaceFunc;
+    vtkSmartPointer<vtkGenericCell> Cell;
+    std::vector<double> Weights;
+    vtkSmartPointer<vtkDoubleArray> CellVectors;
+    vtkSmartPointer<vtkPoints> Points;
+    vtkSmartPointer<vtkPointData> PointData;
+    vtkSmartPointer<vtkDoubleArray> Time;
+    vtkSmartPointer<vtkDoubleArray> VelocityVectors;
+    vtkSmartPointer<vtkDoubleArray> Vorticity;
+    vtkSmartPointer<vtkDoubleArray> Rotation;
+    vtkSmartPointer<vtkDoubleArray> AngularVel;
+
+    LocalData() : SurfaceFunc(nullptr) {}
+  };
+
+  // Where the streamline of a seed is stored, and the state of the
+  // integration when it stopped.
+  struct Line
+  {
+    LocalData* Local; // nullptr when the seed is skipped
+    vtkIdType FirstPoint;
+    vtkIdType NumberOfPoints;
+    int ReasonForTermination;
+    double Propagation;
+    vtkIdType NumberOfSteps;
+    double IntegrationTime;
+    bool HasLastPoint;
+    double LastPoint[3];
+    bool HasStepSize;
+    double LastUsedStepSize;
+
+    Line() : Local(nullptr), FirstPoint(0), NumberOfPoints(0),
+      ReasonForTermination(OUT_OF_LENGTH), Propagation(0), NumberOfSteps(0),
+      IntegrationTime(0), HasLastPoint(false), HasStepSize(false),
+      LastUsedStepSize(0) {}
+  };
+
+  vtkStreamTracer* Tracer;
+  vtkPointData* Input0Data;
+  vtkDataArray* SeedSource;
+  vtkIdList* SeedIds;
+  vtkIntArray* IntegrationDirections;
+  vtkAbstractInterpolatedVelocityField* Func;
+  bool CopyFunction;
+  int MaxCellSize;
+  int VecType;
+  const char* VecName;
+  double InPropagation;
+  vtkIdType InNumSteps;
+  double InIntegrationTime;
+  std::vector<Line> Lines;
+  vtkSMPThreadLocal<LocalData> Locals;
+
+  TracerIntegrator(vtkStreamTracer* tracer, vtkPointData* input0Data,
+    vtkDataArray* seedSource, vtkIdList* seedIds,
+    vtkIntArray* integrationDirections, vtkAbstractInterpolatedVelocityField* func,
+    bool copyFunction, int maxCellSize, int vecType, const char* vecName,
+    double propagation, vtkIdType numSteps, double integrationTime)
+    : Tracer(tracer), Input0Data(input0Data), SeedSource(seedSource),
+      SeedIds(seedIds), IntegrationDirections(integrationDirections),
+      Func(func), CopyFunction(copyFunction), MaxCellSize(maxCellSize),
+      VecType(vecType), VecName(vecName), InPropagation(propagation),
+      InNumSteps(numSteps), InIntegrationTime(integrationTime),
+      Lines(seedIds->GetNumberOfIds())
   {
-    vtkErrorMacro("No integrator is specified.");
-    return;
   }
 
-  double* weights = nullptr;
-  if ( maxCellSize > 0 )
+  // Create a velocity field equivalent to Func, with its own cell cache and
+  // cell locators, as CheckInputs() does.
+  vtkAbstractInterpolatedVelocityField* NewFunction()
   {
-    weights = new double[maxCellSize];
+    vtkAbstractInterpolatedVelocityField* func = this->Func->NewInstance();
+    func->CopyParameters(this->Func);
+    if (vtkAMRInterpolatedVelocityField* amrFunc =
+      vtkAMRInterpolatedVelocityField::SafeDownCast(func))
+    {
+      amrFunc->SetAMRData(vtkOverlappingAMR::SafeDownCast(this->Tracer->InputData));
+    }
+    else if (vtkCompositeInterpolatedVelocityField* compositeFunc =
+      vtkCompositeInterpolatedVelocityField::SafeDownCast(func))
+    {
+      vtkSmartPointer<vtkCompositeDataIterator> iter;
+      iter.TakeReference(this->Tracer->InputData->NewIterator());
+      for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+      {
+        if (vtkDataSet* inp = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject()))
+        {
+          compositeFunc->AddDataSet(inp);
+        }
+      }
+    }
+    func->SelectVectors(this->VecType, this->VecName);
+    return func;
   }
 
-  // Used in GetCell()
-  vtkGenericCell* cell = vtkGenericCell::New();
-
-  // Create a new integrator, the type is the same as Integrator
-  vtkInitialValueProblemSolver* integrator =
-    this->GetIntegrator()->NewInstance();
-  integrator->SetFunctionSet(func);
-
-  // Check Surface option
-  vtkInterpolatedVelocityField* surfaceFunc = nullptr;
-  if (this->SurfaceStreamlines == true)
+  // Called once per thread and per batch of seeds, the objects are only
+  // created the first time.
+  void Initialize()
   {
-    surfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(func);
-    if (surfaceFunc == nullptr)
+    LocalData& local = this->Locals.Local();
+    if (local.Func)
     {
-        vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
-                           "Interpolated Velocity Field, setting it off");
-        this->SetSurfaceStreamlines(false);
+      return;
+    }
+    if (this->CopyFunction)
+    {
+      local.Func.TakeReference(this->NewFunction());
     }
     else
     {
-      surfaceFunc->SetForceSurfaceTangentVector(true);
-      surfaceFunc->SetSurfaceDataset(true);
+      local.Func = this->Func;
+    }
+    local.Integrator.TakeReference(this->Tracer->GetIntegrator()->NewInstance());
+    local.Integrator->SetFunctionSet(local.Func);
+    if (this->Tracer->SurfaceStreamlines)
+    {
+      local.SurfaceFunc = vtkInterpolatedVelocityField::SafeDownCast(local.Func);
+      local.SurfaceFunc->SetForceSurfaceTangentVector(true);
+      local.SurfaceFunc->SetSurfaceDataset(true);
+    }
+    local.Cell = vtkSmartPointer<vtkGenericCell>::New();
+    local.Weights.resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+
+    local.Points = vtkSmartPointer<vtkPoints>::New();
+    local.PointData = vtkSmartPointer<vtkPointData>::New();
+    // See the comment in Integrate() about the size of this allocation.
+    local.PointData->InterpolateAllocate(this->Input0Data,
+      this->Tracer->MaximumNumberOfSteps);
+    local.Time = vtkSmartPointer<vtkDoubleArray>::New();
+    if (this->VecType != vtkDataObject::POINT)
+    {
+      local.VelocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      local.VelocityVectors->SetNumberOfComponents(3);
+    }
+    if (this->Tracer->ComputeVorticity)
+    {
+      local.CellVectors = vtkSmartPointer<vtkDoubleArray>::New();
+      local.CellVectors->SetNumberOfComponents(3);
+      local.CellVectors->Allocate(3*VTK_CELL_SIZE);
+      local.Vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+      local.Vorticity->SetNumberOfComponents(3);
+      local.Rotation = vtkSmartPointer<vtkDoubleArray>::New();
+      local.AngularVel = vtkSmartPointer<vtkDoubleArray>::New();
     }
   }
 
-  // Since we do not know what the total number of points
-  // will be, we do not allocate any. This is important for
-  // cases where a lot of streamers are used at once. If we
-  // were to allocate any points here, potentially, we can
-  // waste a lot of memory if a lot of streamers are used.
-  // Always insert the first point
-  vtkPoints* outputPoints = vtkPoints::New();
-  vtkCellArray* outputLines = vtkCellArray::New();
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    LocalData& local = this->Locals.Local();
+    for (vtkIdType currentLine = begin; currentLine < end; ++currentLine)
+    {
+      this->IntegrateSeed(currentLine, local);
+    }
+  }
 
-  // We will keep track of integration time in this array
-  vtkDoubleArray* time = vtkDoubleArray::New();
-  time->SetName("IntegrationTime");
+  // The streamlines are gathered by Finalize() once all the batches of
+  // seeds are integrated.
+  void Reduce() {}
 
-  // This array explains why the integration stopped
-  vtkIntArray* retVals = vtkIntArray::New();
-  retVals->SetName("ReasonForTermination");
+  void IntegrateSeed(vtkIdType currentLine, LocalData& local);
 
-  vtkIntArray* sids = vtkIntArray::New();
-  sids->SetName("SeedIds");
+  void Finalize(vtkPolyData* output, double lastPoint[3],
+    double& inPropagation, vtkIdType& inNumSteps, double& inIntegrationTime);
+};
 
-  vtkSmartPointer<vtkDoubleArray> velocityVectors;
-  if(vecType != vtkDataObject::POINT)
+//----------------------------------------------------------------------------
+void vtkStreamTracer::TracerIntegrator::IntegrateSeed(vtkIdType currentLine,
+                                                      LocalData& local)
+{
+  vtkStreamTracer* tracer = this->Tracer;
+  vtkAbstractInterpolatedVelocityField* func = local.Func;
+  vtkInitialValueProblemSolver* integrator = local.Integrator;
+  vtkGenericCell* cell = local.Cell;
+  double* weights = local.Weights.data();
+  vtkPoints* outputPoints = local.Points;
+  vtkPointData* outputPD = local.PointData;
+  vtkDoubleArray* time = local.Time;
+  vtkDoubleArray* velocityVectors = local.VelocityVectors;
+  vtkDoubleArray* cellVectors = local.CellVectors;
+  vtkDoubleArray* vorticity = local.Vorticity;
+  vtkDoubleArray* rotation = local.Rotation;
+  vtkDoubleArray* angularVel = local.AngularVel;
+  int vecType = this->VecType;
+  const char* vecName = this->VecName;
+  Line& line = this->Lines[currentLine];
+
+  // The values passed to Integrate() are only used for the first line.
+  double propagation = 0;
+  vtkIdType numSteps = 0;
+  double integrationTime = 0;
+  if (currentLine == 0)
   {
-    velocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
-    velocityVectors->SetName(vecName);
-    velocityVectors->SetNumberOfComponents(3);
+    propagation = this->InPropagation;
+    numSteps = this->InNumSteps;
+    integrationTime = this->InIntegrationTime;
   }
-  vtkDoubleArray* cellVectors = nullptr;
-  vtkDoubleArray* vorticity = nullptr;
-  vtkDoubleArray* rotation = nullptr;
-  vtkDoubleArray* angularVel = nullptr;
-  if (this->ComputeVorticity)
-  {
-    cellVectors = vtkDoubleArray::New();
-    cellVectors->SetNumberOfComponents(3);
-    cellVectors->Allocate(3*VTK_CELL_SIZE);
 
-    vorticity = vtkDoubleArray::New();
-    vorticity->SetName("Vorticity");
-    vorticity->SetNumberOfComponents(3);
-
-    rotation = vtkDoubleArray::New();
-    rotation->SetName("Rotation");
+  vtkPointData* inputPD;
+  vtkDataSet* input;
+  vtkDataArray* inVectors;
+  double velocity[3];
 
-    angularVel = vtkDoubleArray::New();
-    angularVel->SetName("AngularVelocity");
+  int direction=1;
+  switch (this->IntegrationDirections->GetValue(currentLine))
+  {
+    case FORWARD:
+      direction = 1;
+      break;
+    case BACKWARD:
+      direction = -1;
+      break;
   }
 
-  // We will interpolate all point attributes of the input on each point of
-  // the output (unless they are turned off). Note that we are using only
-  // the first input, if there are more than one, the attributes have to match.
-  //
-  // Note: We have to use a specific value (safe to employ the maximum number
-  //       of steps) as the size of the initial memory allocation here. The
-  //       use of the default argument might incur a crash problem (due to
-  //       "insufficient memory") in the parallel mode. This is the case when
-  //       a streamline intensely shuttles between two processes in an exactly
-  //       interleaving fashion --- only one point is produced on each process
-  //       (and actually two points, after point duplication, are saved to a
-  //       vtkPolyData in vtkDistributedStreamTracer::NoBlockProcessTask) and
-  //       as a consequence a large number of such small vtkPolyData objects
-  //       are needed to represent a streamline, consuming up the memory before
-  //       the intermediate memory is timely released.
-  outputPD->InterpolateAllocate( input0Data,
-                                 this->MaximumNumberOfSteps );
+  // temporary variables used in the integration
+  double point1[3], point2[3], pcoords[3], vort[3], omega;
+  vtkIdType index, numPts=0;
 
-  vtkIdType numPtsTotal=0;
-  double velocity[3];
+  // Clear the last cell to avoid starting a search from
+  // the last point in the streamline
+  func->ClearLastCellId();
+
+  // Initial point
+  this->SeedSource->GetTuple(this->SeedIds->GetId(currentLine), point1);
+  memcpy(point2, point1, 3*sizeof(double));
+  if (!func->FunctionValues(point1, velocity))
+  {
+    return;
+  }
 
-  int shouldAbort = 0;
+  if ( propagation >= tracer->MaximumPropagation ||
+       numSteps    >  tracer->MaximumNumberOfSteps)
+  {
+    return;
+  }
 
-  for(int currentLine = 0; currentLine < numLines; currentLine++)
+  line.Local = &local;
+  line.FirstPoint = outputPoints->GetNumberOfPoints();
+  numPts++;
+  vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
+  double lastInsertedPoint[3];
+  outputPoints->GetPoint(nextPoint, lastInsertedPoint);
+  time->InsertNextValue(integrationTime);
+
+  // We will always pass an arc-length step size to the integrator.
+  // If the user specifies a step size in cell length unit, we will
+  // have to convert it to arc length.
+  IntervalInformation stepSize;  // either positive or negative
+  stepSize.Unit  = LENGTH_UNIT;
+  stepSize.Interval = 0;
+  IntervalInformation aStep; // always positive
+  aStep.Unit = LENGTH_UNIT;
+  double step, minStep=0, maxStep=0;
+  double stepTaken;
+  double speed;
+  double cellLength;
+  int retVal=OUT_OF_LENGTH, tmp;
+
+  // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+  input = func->GetLastDataSet();
+  inputPD = input->GetPointData();
+  inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+  // Convert intervals to arc-length unit
+  input->GetCell(func->GetLastCellId(), cell);
+  cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+  speed = vtkMath::Norm(velocity);
+  // Never call conversion methods if speed == 0
+  if ( speed != 0.0 )
   {
+    tracer->ConvertIntervals( stepSize.Interval, minStep, maxStep,
+                              direction, cellLength );
+  }
 
-    double progress = static_cast<double>(currentLine)/numLines;
-    this->UpdateProgress(progress);
+  // Interpolate all point attributes on first point
+  func->GetLastWeights(weights);
+  InterpolatePoint(outputPD, inputPD, nextPoint, cell->PointIds, weights,
+                   tracer->HasMatchingPointAttributes);
+  // handle both point and cell velocity attributes.
+  vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
+  if(vecType != vtkDataObject::POINT)
+  {
+    velocityVectors->InsertNextTuple(velocity);
+    outputVelocityVectors = velocityVectors;
+  }
 
-    switch (integrationDirections->GetValue(currentLine))
+  // Compute vorticity if required
+  // This can be used later for streamribbon generation.
+  if (tracer->ComputeVorticity)
+  {
+    if(vecType == vtkDataObject::POINT)
     {
-      case FORWARD:
-        direction = 1;
-        break;
-      case BACKWARD:
-        direction = -1;
-        break;
+      inVectors->GetTuples(cell->PointIds, cellVectors);
+      func->GetLastLocalCoordinates(pcoords);
+      tracer->CalculateVorticity(cell, pcoords, cellVectors, vort);
     }
+    else
+    {
+      vort[0] = 0;
+      vort[1] = 0;
+      vort[2] = 0;
+    }
+    vorticity->InsertNextTuple(vort);
+    // rotation
+    // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
+    if (speed != 0.0)
+    {
+      omega = vtkMath::Dot(vort, velocity);
+      omega /= speed;
+      omega *= tracer->RotationScale;
+    }
+    else
+    {
+      omega = 0.0;
+    }
+    angularVel->InsertNextValue(omega);
+    rotation->InsertNextValue(0.0);
+  }
 
-    // temporary variables used in the integration
-    double point1[3], point2[3], pcoords[3], vort[3], omega;
-    vtkIdType index, numPts=0;
+  double error = 0;
 
-    // Clear the last cell to avoid starting a search from
-    // the last point in the streamline
-    func->ClearLastCellId();
+  // Integrate until the maximum propagation length is reached,
+  // maximum number of steps is reached or until a boundary is encountered.
+  // Begin Integration
+  while ( propagation < tracer->MaximumPropagation )
+  {
 
-    // Initial point
-    seedSource->GetTuple(seedIds->GetId(currentLine), point1);
-    memcpy(point2, point1, 3*sizeof(double));
-    if (!func->FunctionValues(point1, velocity))
+    if (numSteps > tracer->MaximumNumberOfSteps)
     {
-      continue;
+      retVal = OUT_OF_STEPS;
+      break;
     }
 
-    if ( propagation >= this->MaximumPropagation ||
-         numSteps    >  this->MaximumNumberOfSteps)
+    bool endIntegration = false;
+    for (std::size_t i = 0; i < tracer->CustomTerminationCallback.size(); ++i)
     {
-      continue;
+      if(tracer->CustomTerminationCallback[i](tracer->CustomTerminationClientData[i],
+                                              outputPoints, outputVelocityVectors, direction))
+      {
+        retVal = tracer->CustomReasonForTermination[i];
+        endIntegration = true;
+        break;
+      }
+    }
+    if (endIntegration)
+    {
+      break;
     }
 
-    numPts++;
-    numPtsTotal++;
-    vtkIdType nextPoint = outputPoints->InsertNextPoint(point1);
-    double lastInsertedPoint[3];
-    outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-    time->InsertNextValue(integrationTime);
-
-    // We will always pass an arc-length step size to the integrator.
-    // If the user specifies a step size in cell length unit, we will
-    // have to convert it to arc length.
-    IntervalInformation stepSize;  // either positive or negative
-    stepSize.Unit  = LENGTH_UNIT;
-    stepSize.Interval = 0;
-    IntervalInformation aStep; // always positive
-    aStep.Unit = LENGTH_UNIT;
-    double step, minStep=0, maxStep=0;
-    double stepTaken;
-    double speed;
-    double cellLength;
-    int retVal=OUT_OF_LENGTH, tmp;
+    numSteps++;
 
-    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-    input = func->GetLastDataSet();
-    inputPD = input->GetPointData();
-    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
-    // Convert intervals to arc-length unit
-    input->GetCell(func->GetLastCellId(), cell);
-    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-    speed = vtkMath::Norm(velocity);
     // Never call conversion methods if speed == 0
-    if ( speed != 0.0 )
+    if ( (speed == 0) || (speed <= tracer->TerminalSpeed) )
     {
-      this->ConvertIntervals( stepSize.Interval, minStep, maxStep,
-                              direction, cellLength );
+      retVal = STAGNATION;
+      break;
     }
 
-    // Interpolate all point attributes on first point
-    func->GetLastWeights(weights);
-    InterpolatePoint(outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-    // handle both point and cell velocity attributes.
-    vtkDataArray* outputVelocityVectors = outputPD->GetArray(vecName);
-    if(vecType != vtkDataObject::POINT)
-    {
-      velocityVectors->InsertNextTuple(velocity);
-      outputVelocityVectors = velocityVectors;
-    }
+    // If, with the next step, propagation will be larger than
+    // max, reduce it so that it is (approximately) equal to max.
+    aStep.Interval = fabs( stepSize.Interval );
 
-    // Compute vorticity if required
-    // This can be used later for streamribbon generation.
-    if (this->ComputeVorticity)
+    if ( ( propagation + aStep.Interval ) > tracer->MaximumPropagation )
     {
-      if(vecType == vtkDataObject::POINT)
-      {
-        inVectors->GetTuples(cell->PointIds, cellVectors);
-        func->GetLastLocalCoordinates(pcoords);
-        vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
-      }
-      else
-      {
-        vort[0] = 0;
-        vort[1] = 0;
-        vort[2] = 0;
-      }
-      vorticity->InsertNextTuple(vort);
-      // rotation
-      // local rotation = vorticity . unit tangent ( i.e. velocity/speed )
-      if (speed != 0.0)
+      aStep.Interval = tracer->MaximumPropagation - propagation;
+      if ( stepSize.Interval >= 0 )
       {
-        omega = vtkMath::Dot(vort, velocity);
-        omega /= speed;
-        omega *= this->RotationScale;
+        stepSize.Interval = vtkStreamTracer::ConvertToLength( aStep, cellLength );
       }
       else
       {
-        omega = 0.0;
+        stepSize.Interval = vtkStreamTracer::ConvertToLength( aStep, cellLength ) * ( -1.0 );
       }
-      angularVel->InsertNextValue(omega);
-      rotation->InsertNextValue(0.0);
+      maxStep = stepSize.Interval;
     }
+    line.HasStepSize = true;
+    line.LastUsedStepSize = stepSize.Interval;
 
-    double error = 0;
-
-    // Integrate until the maximum propagation length is reached,
-    // maximum number of steps is reached or until a boundary is encountered.
-    // Begin Integration
-    while ( propagation < this->MaximumPropagation )
+    // Calculate the next step using the integrator provided
+    // Break if the next point is out of bounds.
+    func->SetNormalizeVector( true );
+    tmp = integrator->ComputeNextStep( point1, point2, 0, stepSize.Interval,
+                                       stepTaken, minStep, maxStep,
+                                       tracer->MaximumError, error );
+    func->SetNormalizeVector( false );
+    if ( tmp != 0 )
     {
+      retVal = tmp;
+      line.HasLastPoint = true;
+      memcpy(line.LastPoint, point2, 3*sizeof(double));
+      break;
+    }
 
-      if (numSteps > this->MaximumNumberOfSteps)
+    // This is the next starting point
+    if (tracer->SurfaceStreamlines && local.SurfaceFunc != nullptr)
+    {
+      if (local.SurfaceFunc->SnapPointOnCell(point2, point1) != 1)
       {
-        retVal = OUT_OF_STEPS;
+        retVal = OUT_OF_DOMAIN;
+        line.HasLastPoint = true;
+        memcpy(line.LastPoint, point2, 3 * sizeof(double));
         break;
       }
-
-      bool endIntegration = false;
-      for (std::size_t i = 0; i < this->CustomTerminationCallback.size(); ++i)
-      {
-        if(this->CustomTerminationCallback[i](this->CustomTerminationClientData[i],
-                                              outputPoints, outputVelocityVectors, direction))
-        {
-          retVal = this->CustomReasonForTermination[i];
-          endIntegration = true;
-          break;
-        }
-      }
-      if (endIntegration)
+    }
+    else
+    {
+      for (int i = 0; i < 3; i++)
       {
-        break;
+        point1[i] = point2[i];
       }
+    }
 
-      if ( numSteps++ % 1000 == 1 )
-      {
-        progress =
-          ( currentLine + propagation / this->MaximumPropagation ) / numLines;
-        this->UpdateProgress(progress);
+    // Interpolate the velocity at the next point
+    if ( !func->FunctionValues(point2, velocity) )
+    {
+      retVal = OUT_OF_DOMAIN;
+      line.HasLastPoint = true;
+      memcpy(line.LastPoint, point2, 3*sizeof(double));
+      break;
+    }
 
-        if (this->GetAbortExecute())
-        {
-          shouldAbort = 1;
-          break;
-        }
-      }
+    // It is not enough to use the starting point for stagnation calculation
+    // Use average speed to check if it is below stagnation threshold
+    double speed2 = vtkMath::Norm(velocity);
+    if ( (speed+speed2)/2 <= tracer->TerminalSpeed )
+    {
+      retVal = STAGNATION;
+      break;
+    }
 
-      // Never call conversion methods if speed == 0
-      if ( (speed == 0) || (speed <= this->TerminalSpeed) )
-      {
-        retVal = STAGNATION;
-        break;
-      }
+    integrationTime += stepTaken / speed;
+    // Calculate propagation (using the same units as MaximumPropagation
+    propagation += fabs( stepSize.Interval );
 
-      // If, with the next step, propagation will be larger than
-      // max, reduce it so that it is (approximately) equal to max.
-      aStep.Interval = fabs( stepSize.Interval );
+    // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
+    input = func->GetLastDataSet();
+    inputPD = input->GetPointData();
+    inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
 
-      if ( ( propagation + aStep.Interval ) > this->MaximumPropagation )
-      {
-        aStep.Interval = this->MaximumPropagation - propagation;
-        if ( stepSize.Interval >= 0 )
-        {
-          stepSize.Interval = this->ConvertToLength( aStep, cellLength );
-        }
-        else
-        {
-          stepSize.Interval = this->ConvertToLength( aStep, cellLength ) * ( -1.0 );
-        }
-        maxStep = stepSize.Interval;
-      }
-      this->LastUsedStepSize = stepSize.Interval;
-
-      // Calculate the next step using the integrator provided
-      // Break if the next point is out of bounds.
-      func->SetNormalizeVector( true );
-      tmp = integrator->ComputeNextStep( point1, point2, 0, stepSize.Interval,
-                                         stepTaken, minStep, maxStep,
-                                         this->MaximumError, error );
-      func->SetNormalizeVector( false );
-      if ( tmp != 0 )
+    // Calculate cell length and speed to be used in unit conversions
+    input->GetCell(func->GetLastCellId(), cell);
+    cellLength = sqrt(static_cast<double>(cell->GetLength2()));
+    speed = speed2;
+
+    // Check if conversion to float will produce a point in same place
+    float convertedPoint[3];
+    for (int i = 0; i < 3; i++)
+    {
+      convertedPoint[i] = point1[i];
+    }
+    if (lastInsertedPoint[0] != convertedPoint[0] ||
+        lastInsertedPoint[1] != convertedPoint[1] ||
+        lastInsertedPoint[2] != convertedPoint[2])
+    {
+      // Point is valid. Insert it.
+      numPts++;
+      nextPoint = outputPoints->InsertNextPoint(point1);
+      outputPoints->GetPoint(nextPoint, lastInsertedPoint);
+      time->InsertNextValue(integrationTime);
+
+      // Interpolate all point attributes on current point
+      func->GetLastWeights(weights);
+      InterpolatePoint(outputPD, inputPD, nextPoint, cell->PointIds, weights,
+                       tracer->HasMatchingPointAttributes);
+
+      if(vecType != vtkDataObject::POINT)
       {
-        retVal = tmp;
-        memcpy(lastPoint, point2, 3*sizeof(double));
-        break;
+        velocityVectors->InsertNextTuple(velocity);
       }
-
-      // This is the next starting point
-      if (this->SurfaceStreamlines && surfaceFunc != nullptr)
+      // Compute vorticity if required
+      // This can be used later for streamribbon generation.
+      if (tracer->ComputeVorticity)
       {
-        if (surfaceFunc->SnapPointOnCell(point2, point1) != 1)
+        if(vecType == vtkDataObject::POINT)
         {
-          retVal = OUT_OF_DOMAIN;
-          memcpy(lastPoint, point2, 3 * sizeof(double));
-          break;
+          inVectors->GetTuples(cell->PointIds, cellVectors);
+          func->GetLastLocalCoordinates(pcoords);
+          tracer->CalculateVorticity(cell, pcoords, cellVectors, vort);
         }
-      }
-      else
-      {
-        for (int i = 0; i < 3; i++)
+        else
         {
-          point1[i] = point2[i];
+          vort[0] = 0;
+          vort[1] = 0;
+          vort[2] = 0;
         }
+        vorticity->InsertNextTuple(vort);
+        // rotation
+        // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
+        // rotation = sum ( angular velocity * stepSize )
+        omega = vtkMath::Dot(vort, velocity);
+        omega /= speed;
+        omega *= tracer->RotationScale;
+        index = angularVel->InsertNextValue(omega);
+        rotation->InsertNextValue(rotation->GetValue(index-1) +
+                                  (angularVel->GetValue(index-1) + omega)/2 *
+                                  (integrationTime - time->GetValue(index-1)));
       }
+    }
 
-      // Interpolate the velocity at the next point
-      if ( !func->FunctionValues(point2, velocity) )
-      {
-        retVal = OUT_OF_DOMAIN;
-        memcpy(lastPoint, point2, 3*sizeof(double));
-        break;
-      }
-
-      // It is not enough to use the starting point for stagnation calculation
-      // Use average speed to check if it is below stagnation threshold
-      double speed2 = vtkMath::Norm(velocity);
-      if ( (speed+speed2)/2 <= this->TerminalSpeed )
-      {
-        retVal = STAGNATION;
-        break;
-      }
-
-      integrationTime += stepTaken / speed;
-      // Calculate propagation (using the same units as MaximumPropagation
-      propagation += fabs( stepSize.Interval );
+    // Never call conversion methods if speed == 0
+    if ( (speed == 0) || (speed <= tracer->TerminalSpeed) )
+    {
+      retVal = STAGNATION;
+      break;
+    }
 
-      // Make sure we use the dataset found by the vtkAbstractInterpolatedVelocityField
-      input = func->GetLastDataSet();
-      inputPD = input->GetPointData();
-      inVectors = input->GetAttributesAsFieldData(vecType)->GetArray(vecName);
+    // Convert all intervals to arc length
+    tracer->ConvertIntervals( step, minStep, maxStep, direction, cellLength );
 
-      // Calculate cell length and speed to be used in unit conversions
-      input->GetCell(func->GetLastCellId(), cell);
-      cellLength = sqrt(static_cast<double>(cell->GetLength2()));
-      speed = speed2;
 
-      // Check if conversion to float will produce a point in same place
-      float convertedPoint[3];
-      for (int i = 0; i < 3; i++)
-      {
-        convertedPoint[i] = point1[i];
-      }
-      if (lastInsertedPoint[0] != convertedPoint[0] ||
-          lastInsertedPoint[1] != convertedPoint[1] ||
-          lastInsertedPoint[2] != convertedPoint[2])
+    // If the solver is adaptive and the next step size (stepSize.Interval)
+    // that the solver wants to use is smaller than minStep or larger
+    // than maxStep, re-adjust it. This has to be done every step
+    // because minStep and maxStep can change depending on the cell
+    // size (unless it is specified in arc-length unit)
+    if (integrator->IsAdaptive())
+    {
+      if (fabs(stepSize.Interval) < fabs(minStep))
       {
-        // Point is valid. Insert it.
-        numPts++;
-        numPtsTotal++;
-        nextPoint = outputPoints->InsertNextPoint(point1);
-        outputPoints->GetPoint(nextPoint, lastInsertedPoint);
-        time->InsertNextValue(integrationTime);
-
-        // Interpolate all point attributes on current point
-        func->GetLastWeights(weights);
-        InterpolatePoint(outputPD, inputPD, nextPoint, cell->PointIds, weights, this->HasMatchingPointAttributes);
-
-        if(vecType != vtkDataObject::POINT)
-        {
-          velocityVectors->InsertNextTuple(velocity);
-        }
-        // Compute vorticity if required
-        // This can be used later for streamribbon generation.
-        if (this->ComputeVorticity)
-        {
-          if(vecType == vtkDataObject::POINT)
-          {
-            inVectors->GetTuples(cell->PointIds, cellVectors);
-            func->GetLastLocalCoordinates(pcoords);
-            vtkStreamTracer::CalculateVorticity(cell, pcoords, cellVectors, vort);
-          }
-          else
-          {
-            vort[0] = 0;
-            vort[1] = 0;
-            vort[2] = 0;
-          }
-          vorticity->InsertNextTuple(vort);
-          // rotation
-          // angular velocity = vorticity . unit tangent ( i.e. velocity/speed )
-          // rotation = sum ( angular velocity * stepSize )
-          omega = vtkMath::Dot(vort, velocity);
-          omega /= speed;
-          omega *= this->RotationScale;
-          index = angularVel->InsertNextValue(omega);
-          rotation->InsertNextValue(rotation->GetValue(index-1) +
-                                    (angularVel->GetValue(index-1) + omega)/2 *
-                                    (integrationTime - time->GetValue(index-1)));
-        }
+        stepSize.Interval = fabs( minStep ) *
+                              stepSize.Interval / fabs( stepSize.Interval );
       }
-
-      // Never call conversion methods if speed == 0
-      if ( (speed == 0) || (speed <= this->TerminalSpeed) )
+      else if (fabs(stepSize.Interval) > fabs(maxStep))
       {
-        retVal = STAGNATION;
-        break;
+        stepSize.Interval = fabs( maxStep ) *
+                              stepSize.Interval / fabs( stepSize.Interval );
       }
+    }
+    else
+    {
+      stepSize.Interval = step;
+    }
+  }
 
-      // Convert all intervals to arc length
-      this->ConvertIntervals( step, minStep, maxStep, direction, cellLength );
+  line.NumberOfPoints = numPts;
+  line.ReasonForTermination = retVal;
+  line.Propagation = propagation;
+  line.NumberOfSteps = numSteps;
+  line.IntegrationTime = integrationTime;
+}
 
+//----------------------------------------------------------------------------
+void vtkStreamTracer::TracerIntegrator::Finalize(vtkPolyData* output,
+  double lastPoint[3], double& inPropagation, vtkIdType& inNumSteps,
+  double& inIntegrationTime)
+{
+  vtkIdType numLines = static_cast<vtkIdType>(this->Lines.size());
 
-      // If the solver is adaptive and the next step size (stepSize.Interval)
-      // that the solver wants to use is smaller than minStep or larger
-      // than maxStep, re-adjust it. This has to be done every step
-      // because minStep and maxStep can change depending on the cell
-      // size (unless it is specified in arc-length unit)
-      if (integrator->IsAdaptive())
-      {
-        if (fabs(stepSize.Interval) < fabs(minStep))
-        {
-          stepSize.Interval = fabs( minStep ) *
-                                stepSize.Interval / fabs( stepSize.Interval );
-        }
-        else if (fabs(stepSize.Interval) > fabs(maxStep))
-        {
-          stepSize.Interval = fabs( maxStep ) *
-                                stepSize.Interval / fabs( stepSize.Interval );
-        }
-      }
-      else
-      {
-        stepSize.Interval = step;
-      }
+  // The state of the integration is returned for the last integrated line,
+  // as if the seeds were integrated one after another.
+  vtkIdType numPts = 0, numCells = 0, connSize = 0;
+  for (vtkIdType i = 0; i < numLines; ++i)
+  {
+    const Line& line = this->Lines[i];
+    if (line.HasLastPoint)
+    {
+      memcpy(lastPoint, line.LastPoint, 3*sizeof(double));
     }
-
-    if (shouldAbort)
+    if (line.HasStepSize)
     {
-      break;
+      this->Tracer->LastUsedStepSize = line.LastUsedStepSize;
+    }
+    if (line.Local)
+    {
+      inPropagation = line.Propagation;
+      inNumSteps = line.NumberOfSteps;
+      inIntegrationTime = line.IntegrationTime;
+      numPts += line.NumberOfPoints;
+      if (line.NumberOfPoints > 1)
+      {
+        ++numCells;
+        connSize += line.NumberOfPoints + 1;
+      }
     }
+  }
 
-    if (numPts > 1)
+  // Point attributes that are missing from some blocks were removed from
+  // the buffers of the threads that interpolated them, remove them from the
+  // output as well.
+  vtkPointData* outputPD = output->GetPointData();
+  bool fast = this->Tracer->HasMatchingPointAttributes;
+  for (int i = outputPD->GetNumberOfArrays() - 1; i >= 0; --i)
+  {
+    vtkAbstractArray* array = outputPD->GetAbstractArray(i);
+    for (vtkSMPThreadLocal<LocalData>::iterator it = this->Locals.begin();
+         it != this->Locals.end(); ++it)
     {
-      outputLines->InsertNextCell(numPts);
-      for (int i=numPtsTotal-numPts; i<numPtsTotal; i++)
+      if (!fast && !it->PointData->GetAbstractArray(array->GetName()))
       {
-        outputLines->InsertCellPoint(i);
+        outputPD->RemoveArray(array->GetName());
+        break;
       }
-      retVals->InsertNextValue(retVal);
-      sids->InsertNextValue(seedIds->GetId(currentLine));
     }
+  }
 
-    // Initialize these to 0 before starting the next line.
-    // The values passed in the function call are only used
-    // for the first line.
-    inPropagation = propagation;
-    inNumSteps = numSteps;
-    inIntegrationTime = integrationTime;
+  vtkNew<vtkPoints> outputPoints;
+  outputPoints->SetNumberOfPoints(numPts);
 
-    propagation = 0;
-    numSteps = 0;
-    integrationTime = 0;
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("IntegrationTime");
+  time->SetNumberOfTuples(numPts);
+
+  vtkSmartPointer<vtkDoubleArray> velocityVectors;
+  if (this->VecType != vtkDataObject::POINT)
+  {
+    velocityVectors = vtkSmartPointer<vtkDoubleArray>::New();
+    velocityVectors->SetName(this->VecName);
+    velocityVectors->SetNumberOfComponents(3);
+    velocityVectors->SetNumberOfTuples(numPts);
+  }
+  vtkSmartPointer<vtkDoubleArray> vorticity;
+  vtkSmartPointer<vtkDoubleArray> rotation;
+  vtkSmartPointer<vtkDoubleArray> angularVel;
+  if (this->Tracer->ComputeVorticity)
+  {
+    vorticity = vtkSmartPointer<vtkDoubleArray>::New();
+    vorticity->SetName("Vorticity");
+    vorticity->SetNumberOfComponents(3);
+    vorticity->SetNumberOfTuples(numPts);
+    rotation = vtkSmartPointer<vtkDoubleArray>::New();
+    rotation->SetName("Rotation");
+    rotation->SetNumberOfTuples(numPts);
+    angularVel = vtkSmartPointer<vtkDoubleArray>::New();
+    angularVel->SetName("AngularVelocity");
+    angularVel->SetNumberOfTuples(numPts);
+  }
+  for (int i = 0; i < outputPD->GetNumberOfArrays(); ++i)
+  {
+    outputPD->GetAbstractArray(i)->SetNumberOfTuples(numPts);
   }
 
-  if (!shouldAbort)
+  vtkNew<vtkCellArray> outputLines;
+  vtkIdType* conn = outputLines->WritePointer(numCells, connSize);
+  vtkNew<vtkIntArray> retVals;
+  retVals->SetName("ReasonForTermination");
+  retVals->SetNumberOfTuples(numCells);
+  vtkNew<vtkIntArray> sids;
+  sids->SetName("SeedIds");
+  sids->SetNumberOfTuples(numCells);
+
+  // Gather the points, the point attributes and the lines in seed order
+  vtkIdType ptId = 0, cellId = 0;
+  for (vtkIdType i = 0; i < numLines; ++i)
   {
-    // Create the output polyline
-    output->SetPoints(outputPoints);
-    outputPD->AddArray(time);
-    if(vecType != vtkDataObject::POINT)
+    const Line& line = this->Lines[i];
+    if (!line.Local)
+    {
+      continue;
+    }
+    LocalData* local = line.Local;
+    vtkIdType n = line.NumberOfPoints;
+    outputPoints->GetData()->InsertTuples(ptId, n, line.FirstPoint,
+                                          local->Points->GetData());
+    time->InsertTuples(ptId, n, line.FirstPoint, local->Time);
+    if (velocityVectors)
     {
-      outputPD->AddArray(velocityVectors);
+      velocityVectors->InsertTuples(ptId, n, line.FirstPoint, local->VelocityVectors);
     }
     if (vorticity)
     {
-      outputPD->AddArray(vorticity);
-      outputPD->AddArray(rotation);
-      outputPD->AddArray(angularVel);
+      vorticity->InsertTuples(ptId, n, line.FirstPoint, local->Vorticity);
+      rotation->InsertTuples(ptId, n, line.FirstPoint, local->Rotation);
+      angularVel->InsertTuples(ptId, n, line.FirstPoint, local->AngularVel);
     }
-
-    vtkIdType numPts = outputPoints->GetNumberOfPoints();
-    if ( numPts > 1 )
+    for (int j = 0; j < outputPD->GetNumberOfArrays(); ++j)
     {
-      // Assign geometry and attributes
-      output->SetLines(outputLines);
-      if (this->GenerateNormalsInIntegrate)
+      vtkAbstractArray* array = outputPD->GetAbstractArray(j);
+      vtkAbstractArray* localArray = fast ?
+        local->PointData->GetAbstractArray(j) :
+        local->PointData->GetAbstractArray(array->GetName());
+      if (localArray)
       {
-        this->GenerateNormals(output, nullptr, vecName);
+        array->InsertTuples(ptId, n, line.FirstPoint, localArray);
       }
+    }
 
-      outputCD->AddArray(retVals);
-      outputCD->AddArray(sids);
+    if (n > 1)
+    {
+      *conn++ = n;
+      for (vtkIdType j = 0; j < n; ++j)
+      {
+        *conn++ = ptId + j;
+      }
+      retVals->SetValue(cellId, line.ReasonForTermination);
+      sids->SetValue(cellId, static_cast<int>(this->SeedIds->GetId(i)));
+      ++cellId;
     }
+    ptId += n;
   }
 
+  // Create the output polyline
+  output->SetPoints(outputPoints);
+  outputPD->AddArray(time);
+  if (velocityVectors)
+  {
+    outputPD->AddArray(velocityVectors);
+  }
   if (vorticity)
   {
-    vorticity->Delete();
-    rotation->Delete();
-    angularVel->Delete();
+    outputPD->AddArray(vorticity);
+    outputPD->AddArray(rotation);
+    outputPD->AddArray(angularVel);
   }
 
-  if (cellVectors)
+  if ( numPts > 1 )
   {
-    cellVectors->Delete();
+    // Assign geometry and attributes
+    output->SetLines(outputLines);
+    if (this->Tracer->GenerateNormalsInIntegrate)
+    {
+      this->Tracer->GenerateNormals(output, nullptr, this->VecName);
+    }
+
+    output->GetCellData()->AddArray(retVals);
+    output->GetCellData()->AddArray(sids);
   }
-  retVals->Delete();
-  sids->Delete();
+}
 
-  outputPoints->Delete();
-  outputLines->Delete();
+//----------------------------------------------------------------------------
+void vtkStreamTracer::Integrate(vtkPointData *input0Data,
+                                vtkPolyData* output,
+                                vtkDataArray* seedSource,
+                                vtkIdList* seedIds,
+                                vtkIntArray* integrationDirections,
+                                double lastPoint[3],
+                                vtkAbstractInterpolatedVelocityField* func,
+                                int maxCellSize,
+                                int vecType,
+                                const char *vecName,
+                                double& inPropagation,
+                                vtkIdType& inNumSteps,
+                                double &inIntegrationTime)
+{
+  vtkIdType numLines = seedIds->GetNumberOfIds();
+
+  if (this->GetIntegrator() == nullptr)
+  {
+    vtkErrorMacro("No integrator is specified.");
+    return;
+  }
+
+  // Check Surface option
+  if (this->SurfaceStreamlines == true)
+  {
+    vtkInterpolatedVelocityField* surfaceFunc =
+      vtkInterpolatedVelocityField::SafeDownCast(func);
+    if (surfaceFunc == nullptr)
+    {
+        vtkWarningMacro(<< "Surface Streamlines works only with Point Locator "
+                           "Interpolated Velocity Field, setting it off");
+        this->SetSurfaceStreamlines(false);
+    }
+    else
+    {
+      surfaceFunc->SetForceSurfaceTangentVector(true);
+      surfaceFunc->SetSurfaceDataset(true);
+    }
+  }
 
-  time->Delete();
+  // We will interpolate all point attributes of the input on each point of
+  // the output (unless they are turned off). Note that we are using only
+  // the first input, if there are more than one, the attributes have to match.
+  //
+  // Note: We have to use a specific value (safe to employ the maximum number
+  //       of steps) as the size of the initial memory allocation here. The
+  //       use of the default argument might incur a crash problem (due to
+  //       "insufficient memory") in the parallel mode. This is the case when
+  //       a streamline intensely shuttles between two processes in an exactly
+  //       interleaving fashion --- only one point is produced on each process
+  //       (and actually two points, after point duplication, are saved to a
+  //       vtkPolyData in vtkDistributedStreamTracer::NoBlockProcessTask) and
+  //       as a consequence a large number of such small vtkPolyData objects
+  //       are needed to represent a streamline, consuming up the memory before
+  //       the intermediate memory is timely released.
+  output->GetPointData()->InterpolateAllocate( input0Data,
+                                               this->MaximumNumberOfSteps );
+
+  // The seeds are integrated in parallel, each thread with its own copy of
+  // the velocity field, unless the custom termination callbacks (which may
+  // not be thread safe) are used or there is a single seed.
+  bool parallel = numLines > 1 && this->CustomTerminationCallback.empty() &&
+    this->InputData != nullptr;
+  if (parallel)
+  {
+    // Trigger the lazy initialization of the datasets (cells, cell links,
+    // point locator, bounds) so that FindCell() and GetCell() are thread
+    // safe.
+    std::vector<double> weights(maxCellSize > 0 ? maxCellSize : 1);
+    vtkNew<vtkGenericCell> cell;
+    vtkSmartPointer<vtkCompositeDataIterator> iter;
+    iter.TakeReference(this->InputData->NewIterator());
+    for (iter->GoToFirstItem(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      vtkDataSet* ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (!ds || ds->GetNumberOfPoints() < 1 || ds->GetNumberOfCells() < 1)
+      {
+        continue;
+      }
+      double x[3], pcoords[3];
+      int subId;
+      ds->ComputeBounds();
+      ds->GetCell(0, cell);
+      ds->GetPoint(0, x);
+      ds->FindCell(x, nullptr, cell, -1, 0.0, subId, pcoords, weights.data());
+    }
+  }
 
+  TracerIntegrator tracerIntegrator(this, input0Data, seedSource, seedIds,
+    integrationDirections, func, parallel, maxCellSize, vecType, vecName,
+    inPropagation, inNumSteps, inIntegrationTime);
 
-  integrator->Delete();
-  cell->Delete();
+  // The seeds are integrated in batches to report progress and check for
+  // abort requests.
+  vtkIdType batchSize = numLines / 10 + 1;
+  bool shouldAbort = false;
+  for (vtkIdType begin = 0; begin < numLines; begin += batchSize)
+  {
+    this->UpdateProgress(static_cast<double>(begin)/numLines);
+    if (this->GetAbortExecute())
+    {
+      shouldAbort = true;
+      break;
+    }
+    vtkIdType end = std::min(begin + batchSize, numLines);
+    if (parallel)
+    {
+      vtkSMPTools::For(begin, end, tracerIntegrator);
+    }
+    else
+    {
+      tracerIntegrator.Initialize();
+      tracerIntegrator(begin, end);
+    }
+  }
 
-  delete[] weights;
+  if (!shouldAbort)
+  {
+    tracerIntegrator.Finalize(output, lastPoint, inPropagation, inNumSteps,
+                              inIntegrationTime);
+  }
 
   output->Squeeze();
 }
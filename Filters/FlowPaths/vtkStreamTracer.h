@@ -69,6 +69,13 @@
  * a source object, traces will be generated from each point in the source
  * that is inside the dataset.
  *
+ * The seeds are integrated in parallel with vtkSMPTools. Each thread uses
+ * its own copy of the velocity field (and thus of its cell locators and
+ * cell cache) and of the integrator, and the streamlines are gathered in
+ * the order of the seeds, so the output does not depend on the number of
+ * threads. The seeds are integrated serially when custom termination
+ * callbacks are set, since these are not expected to be thread safe.
+ *
  * @sa
  * vtkRibbonFilter vtkRuledSurfaceFilter vtkInitialValueProblemSolver
  * vtkRungeKutta2 vtkRungeKutta4 vtkRungeKutta45 vtkTemporalStreamTracer
@@ -479,6 +486,9 @@ protected:
   friend class PStreamTracerUtils;
 
 private:
+  // Integrates a range of seeds with thread local objects, see Integrate().
+  struct TracerIntegrator;
+
   vtkStreamTracer(const vtkStreamTracer&) = delete;
   void operator=(const vtkStreamTracer&) = delete;
 };
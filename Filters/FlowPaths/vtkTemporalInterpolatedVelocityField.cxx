@@ -150,6 +150,59 @@ void vtkTemporalInterpolatedVelocityField::AdvanceOneTimeStep()
   }
 }
 //---------------------------------------------------------------------------
+void vtkTemporalInterpolatedVelocityField::BuildLocators()
+{
+  for (int T=0; T<2; T++)
+  {
+    vtkCachingInterpolatedVelocityField *ivf = this->IVF[T];
+    for (size_t i=0; i<ivf->CacheList.size(); i++)
+    {
+      IVFDataSetInfo &data = ivf->CacheList[i];
+      if (!data.DataSet || data.DataSet->GetNumberOfCells()==0)
+      {
+        continue;
+      }
+      // a first search builds the locator, the cells and the links
+      double x[3], pcoords[3];
+      int subId;
+      data.DataSet->GetCenter(x);
+      data.DataSet->GetCell(0, data.Cell);
+      if (data.BSPTree)
+      {
+        data.BSPTree->FindCell(
+          x, data.Tolerance, data.Cell, pcoords, &ivf->Weights[0]);
+      }
+      else
+      {
+        data.DataSet->FindCell(x, nullptr, data.Cell, -1,
+          data.Tolerance, subId, pcoords, &ivf->Weights[0]);
+      }
+    }
+    ivf->ClearLastCellInfo();
+  }
+}
+//---------------------------------------------------------------------------
+void vtkTemporalInterpolatedVelocityField::ShallowCopy(
+  vtkTemporalInterpolatedVelocityField* from)
+{
+  for (int T=0; T<2; T++)
+  {
+    vtkCachingInterpolatedVelocityField *ivf = from->IVF[T];
+    this->IVF[T] = vtkSmartPointer<vtkCachingInterpolatedVelocityField>::New();
+    this->IVF[T]->SetVectorsSelection(ivf->VectorsSelection);
+    this->IVF[T]->CacheList = ivf->CacheList;
+    for (size_t i=0; i<this->IVF[T]->CacheList.size(); i++)
+    {
+      this->IVF[T]->CacheList[i].Cell = vtkSmartPointer<vtkGenericCell>::New();
+    }
+    this->IVF[T]->Weights.assign(ivf->Weights.size(), 0.0);
+  }
+  this->StaticDataSets = from->StaticDataSets;
+  this->Times[0] = from->Times[0];
+  this->Times[1] = from->Times[1];
+  this->ScaleCoeff = from->ScaleCoeff;
+}
+//---------------------------------------------------------------------------
 void vtkTemporalInterpolatedVelocityField::ShowCacheResults()
 {
   vtkErrorMacro(<< ")\n"
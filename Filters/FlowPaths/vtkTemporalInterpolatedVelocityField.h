@@ -30,8 +30,9 @@
  * values and computing vorticity etc.
  *
  * @warning
- * vtkTemporalInterpolatedVelocityField is probably not thread safe.
- * A new instance should be created by each thread.
+ * vtkTemporalInterpolatedVelocityField is not thread safe. Each thread
+ * should use its own copy, made with ShallowCopy() once the locators are
+ * built with BuildLocators().
  *
  * @warning
  * Datasets are added in lists. The list for T1 must be idential to that for T0
@@ -155,6 +156,20 @@ public:
 
   void AdvanceOneTimeStep();
 
+  /**
+   * Build the cell locators and the cell structures of the datasets, which
+   * are otherwise built on the first evaluation, so that copies made with
+   * ShallowCopy() can be evaluated concurrently.
+   */
+  void BuildLocators();
+
+  /**
+   * Use the datasets, cell locators and times of another interpolator. They
+   * are shared, but this instance keeps its own cells, weights and cached
+   * cell ids.
+   */
+  void ShallowCopy(vtkTemporalInterpolatedVelocityField* from);
+
 protected:
   vtkTemporalInterpolatedVelocityField();
   ~vtkTemporalInterpolatedVelocityField() override;
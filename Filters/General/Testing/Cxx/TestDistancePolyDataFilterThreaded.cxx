@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDistancePolyDataFilterThreaded.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compute the distance between two spheres with vtkDistancePolyDataFilter,
+// whose evaluations run in parallel, and compare it with the analytic
+// distance and with serial evaluations of vtkImplicitPolyDataDistance.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDistancePolyDataFilter.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+
+int TestDistancePolyDataFilterThreaded(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetThetaResolution(80);
+  sphere1->SetPhiResolution(60);
+  sphere1->SetRadius(1.0);
+
+  vtkNew<vtkSphereSource> sphere2;
+  sphere2->SetThetaResolution(90);
+  sphere2->SetPhiResolution(70);
+  sphere2->SetCenter(0.3, 0.2, 0.1);
+  sphere2->SetRadius(0.8);
+
+  vtkNew<vtkDistancePolyDataFilter> distance;
+  distance->SetInputConnection(0, sphere1->GetOutputPort());
+  distance->SetInputConnection(1, sphere2->GetOutputPort());
+  distance->Update();
+
+  vtkPolyData* output = distance->GetOutput();
+  vtkDataArray* pointDist = output->GetPointData()->GetArray("Distance");
+  vtkDataArray* cellDist = output->GetCellData()->GetArray("Distance");
+  vtkDataArray* secondDist =
+    distance->GetSecondDistanceOutput()->GetPointData()->GetArray("Distance");
+  if (!pointDist || !cellDist || !secondDist ||
+    pointDist->GetNumberOfTuples() != output->GetNumberOfPoints() ||
+    cellDist->GetNumberOfTuples() != output->GetNumberOfCells())
+  {
+    cerr << "Missing distance arrays" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Serial evaluations must give the same values, and the signed distance
+  // must approximate the distance to the second sphere.
+  vtkNew<vtkImplicitPolyDataDistance> function;
+  function->SetInput(sphere2->GetOutput());
+  double center[3] = { 0.3, 0.2, 0.1 }, x[3];
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    output->GetPoint(i, x);
+    double d = function->EvaluateFunction(x);
+    double exact = std::sqrt(vtkMath::Distance2BetweenPoints(x, center)) - 0.8;
+    if (d != pointDist->GetTuple1(i) || std::abs(d - exact) > 0.01)
+    {
+      cerr << "Wrong distance at point " << i << ": " << pointDist->GetTuple1(i)
+           << " (serial " << d << ", exact " << exact << ")" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Unsigned, negated distances
+  distance->SignedDistanceOff();
+  distance->ComputeSecondDistanceOff();
+  distance->Update();
+  pointDist = distance->GetOutput()->GetPointData()->GetArray("Distance");
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    output->GetPoint(i, x);
+    if (pointDist->GetTuple1(i) != std::abs(function->EvaluateFunction(x)))
+    {
+      cerr << "Wrong unsigned distance at point " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
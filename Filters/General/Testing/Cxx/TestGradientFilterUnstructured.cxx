@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGradientFilterUnstructured.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compute the gradient, vorticity, divergence and Q-criterion of a linear
+// vector field on unstructured grids with vtkGradientFilter. Linear cells
+// reproduce linear fields, so the results are exact.
+
+#include "TestLinearFieldGrid.h"
+
+#include "vtkDataArray.h"
+#include "vtkGradientFilter.h"
+#include "vtkSmartPointer.h"
+
+#include <cmath>
+
+namespace
+{
+
+int CheckGradients(vtkDataArray* gradients, vtkDataArray* vorticity, vtkDataArray* divergence,
+  vtkDataArray* qCriterion, vtkIdType id, const char* label)
+{
+  const double tol = 1.0e-10;
+  double g[9];
+  gradients->GetTuple(id, g);
+  for (int i = 0; i < 3; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      if (std::abs(g[3 * i + j] - A[i][j]) > tol)
+      {
+        cerr << label << ": wrong gradient " << g[3 * i + j] << " at " << id << endl;
+        return 1;
+      }
+    }
+  }
+  double w[3] = { A[2][1] - A[1][2], A[0][2] - A[2][0], A[1][0] - A[0][1] };
+  double div = A[0][0] + A[1][1] + A[2][2];
+  double q = -(A[0][0] * A[0][0] + A[1][1] * A[1][1] + A[2][2] * A[2][2]) / 2.0 -
+    (A[0][1] * A[1][0] + A[0][2] * A[2][0] + A[1][2] * A[2][1]);
+  double* vort = vorticity->GetTuple3(id);
+  if (std::abs(vort[0] - w[0]) > tol || std::abs(vort[1] - w[1]) > tol ||
+    std::abs(vort[2] - w[2]) > tol || std::abs(divergence->GetTuple1(id) - div) > tol ||
+    std::abs(qCriterion->GetTuple1(id) - q) > tol)
+  {
+    cerr << label << ": wrong vorticity, divergence or Q-criterion at " << id << endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Return the output attributes holding the results, or nullptr.
+vtkSmartPointer<vtkDataSetAttributes> RunFilter(vtkUnstructuredGrid* grid, int association,
+  const char* name, int option, bool faster, const char* label)
+{
+  vtkNew<vtkGradientFilter> gradient;
+  gradient->SetInputData(grid);
+  gradient->SetInputArrayToProcess(0, 0, 0, association, name);
+  gradient->SetResultArrayName("Gradients");
+  gradient->ComputeVorticityOn();
+  gradient->ComputeDivergenceOn();
+  gradient->ComputeQCriterionOn();
+  gradient->SetContributingCellOption(option);
+  gradient->SetFasterApproximation(faster);
+  gradient->Update();
+
+  vtkSmartPointer<vtkDataSetAttributes> out;
+  if (association == vtkDataObject::FIELD_ASSOCIATION_POINTS)
+  {
+    out = gradient->GetOutput()->GetPointData();
+  }
+  else
+  {
+    out = gradient->GetOutput()->GetCellData();
+  }
+  if (!out->GetArray("Gradients") || !out->GetArray("Vorticity") ||
+    !out->GetArray("Divergence") || !out->GetArray("Q-criterion"))
+  {
+    cerr << label << ": missing output arrays" << endl;
+    return nullptr;
+  }
+  return out;
+}
+
+}
+
+int TestGradientFilterUnstructured(int, char*[])
+{
+  int errors = 0;
+  const int n = 30;
+
+  // Point data on a mixed grid
+  vtkNew<vtkUnstructuredGrid> mixed;
+  MakeGrid(n, true, mixed);
+  AddLinearPointField(mixed, "v");
+
+  struct
+  {
+    int Option;
+    bool Faster;
+    const char* Label;
+  } pointCases[] = { { vtkGradientFilter::DataSetMax, false, "Points, data set max" },
+    { vtkGradientFilter::Patch, false, "Points, patch" },
+    { vtkGradientFilter::DataSetMax, true, "Points, faster approximation" } };
+  for (const auto& c : pointCases)
+  {
+    vtkSmartPointer<vtkDataSetAttributes> out =
+      RunFilter(mixed, vtkDataObject::FIELD_ASSOCIATION_POINTS, "v", c.Option, c.Faster, c.Label);
+    int failed = (out ? 0 : 1);
+    for (vtkIdType i = 0; !failed && i < mixed->GetNumberOfPoints(); ++i)
+    {
+      failed = CheckGradients(out->GetArray("Gradients"), out->GetArray("Vorticity"),
+        out->GetArray("Divergence"), out->GetArray("Q-criterion"), i, c.Label);
+    }
+    errors += failed;
+  }
+
+  // Cell data on hexahedra. Averaged to the points, a linear cell field is
+  // exact at interior points, so cells not touching the boundary are exact.
+  vtkNew<vtkUnstructuredGrid> hexes;
+  MakeGrid(n, false, hexes);
+  AddLinearCellField(hexes, "c");
+
+  vtkSmartPointer<vtkDataSetAttributes> out = RunFilter(
+    hexes, vtkDataObject::FIELD_ASSOCIATION_CELLS, "c", vtkGradientFilter::All, false, "Cells");
+  int failed = (out ? 0 : 1);
+  for (int k = 1; !failed && k < n - 1; ++k)
+  {
+    for (int j = 1; !failed && j < n - 1; ++j)
+    {
+      for (int i = 1; !failed && i < n - 1; ++i)
+      {
+        failed = CheckGradients(out->GetArray("Gradients"), out->GetArray("Vorticity"),
+          out->GetArray("Divergence"), out->GetArray("Q-criterion"), i + n * (j + n * k),
+          "Cells");
+      }
+    }
+  }
+  errors += failed;
+
+  return errors;
+}
@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLinearFieldGrid.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by TestGradientFilterUnstructured and TimeGradientFilter:
+// unstructured grids holding a linear vector field, as point or cell data.
+// Not every test uses all of them, hence the inline functions.
+
+#ifndef TestLinearFieldGrid_h
+#define TestLinearFieldGrid_h
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+
+// The field is A*x + b
+const double A[3][3] = { { 1.0, 2.0, -0.5 }, { 0.3, -1.0, 4.0 }, { -2.0, 0.7, 0.2 } };
+
+inline void LinearField(const double x[3], double v[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    v[i] = A[i][0] * x[0] + A[i][1] * x[1] + A[i][2] * x[2] + i;
+  }
+}
+
+// An affinely distorted block of n^3 hexahedra. If mixed, some hexahedra are
+// replaced by five tetrahedra, and quads are added on the bottom face.
+inline void MakeGrid(int n, bool mixed, vtkUnstructuredGrid* grid)
+{
+  int np = n + 1;
+  vtkNew<vtkPoints> pts;
+  pts->SetDataTypeToDouble();
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        pts->InsertNextPoint(i + 0.3 * j, j + 0.2 * k, 0.8 * k + 0.1 * i);
+      }
+    }
+  }
+  grid->SetPoints(pts);
+  grid->Allocate(6 * n * n * n);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        vtkIdType h[8];
+        for (int v = 0; v < 8; ++v)
+        {
+          int di = ((v + 1) / 2) % 2, dj = (v / 2) % 2, dk = v / 4;
+          h[v] = (i + di) + np * ((j + dj) + np * (k + dk));
+        }
+        if (mixed && (i + j + k) % 2 == 0)
+        {
+          vtkIdType tets[5][4] = { { h[0], h[1], h[3], h[4] }, { h[1], h[2], h[3], h[6] },
+            { h[1], h[4], h[5], h[6] }, { h[3], h[4], h[6], h[7] }, { h[1], h[3], h[4], h[6] } };
+          for (int t = 0; t < 5; ++t)
+          {
+            grid->InsertNextCell(VTK_TETRA, 4, tets[t]);
+          }
+        }
+        else
+        {
+          grid->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+        }
+        if (mixed && k == 0)
+        {
+          grid->InsertNextCell(VTK_QUAD, 4, h);
+        }
+      }
+    }
+  }
+}
+
+// Add the linear field, sampled at the points, as the point array name
+inline void AddLinearPointField(vtkUnstructuredGrid* grid, const char* name)
+{
+  vtkNew<vtkDoubleArray> pointField;
+  pointField->SetName(name);
+  pointField->SetNumberOfComponents(3);
+  pointField->SetNumberOfTuples(grid->GetNumberOfPoints());
+  double x[3], v[3];
+  for (vtkIdType i = 0; i < grid->GetNumberOfPoints(); ++i)
+  {
+    grid->GetPoint(i, x);
+    LinearField(x, v);
+    pointField->SetTuple(i, v);
+  }
+  grid->GetPointData()->AddArray(pointField);
+}
+
+// Add the linear field, sampled at the centers of the hexahedra, as the cell
+// array name
+inline void AddLinearCellField(vtkUnstructuredGrid* grid, const char* name)
+{
+  vtkNew<vtkDoubleArray> cellField;
+  cellField->SetName(name);
+  cellField->SetNumberOfComponents(3);
+  cellField->SetNumberOfTuples(grid->GetNumberOfCells());
+  vtkNew<vtkIdList> ids;
+  double x[3], v[3];
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); ++i)
+  {
+    grid->GetCellPoints(i, ids);
+    x[0] = x[1] = x[2] = 0.0;
+    for (vtkIdType j = 0; j < 8; ++j)
+    {
+      double p[3];
+      grid->GetPoint(ids->GetId(j), p);
+      x[0] += p[0] / 8.0;
+      x[1] += p[1] / 8.0;
+      x[2] += p[2] / 8.0;
+    }
+    LinearField(x, v);
+    cellField->SetTuple(i, v);
+  }
+  grid->GetCellData()->AddArray(cellField);
+}
+
+}
+
+#endif
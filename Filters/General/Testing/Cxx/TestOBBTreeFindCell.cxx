@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBBTreeFindCell.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check vtkOBBTree::FindCell against vtkStaticCellLocator, both as single
+// queries and through the batched FindCells().
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+
+int TestOBBTreeFindCell(int, char*[])
+{
+  // A triangulated, jittered grid in the z=0 plane, so that the query
+  // points lie exactly on the surface.
+  const int dim = 41;
+  vtkMath::RandomSeed(8675309);
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < dim; ++j)
+  {
+    for (int i = 0; i < dim; ++i)
+    {
+      double jitter = (i > 0 && i < dim - 1 && j > 0 && j < dim - 1) ? 0.01 : 0.0;
+      points->InsertNextPoint(0.05 * i + vtkMath::Random(-jitter, jitter),
+        0.05 * j + vtkMath::Random(-jitter, jitter), 0.0);
+    }
+  }
+  vtkNew<vtkCellArray> triangles;
+  for (int j = 0; j < dim - 1; ++j)
+  {
+    for (int i = 0; i < dim - 1; ++i)
+    {
+      vtkIdType p = j * dim + i;
+      vtkIdType tri0[3] = { p, p + 1, p + dim + 1 };
+      vtkIdType tri1[3] = { p, p + dim + 1, p + dim };
+      triangles->InsertNextCell(3, tri0);
+      triangles->InsertNextCell(3, tri1);
+    }
+  }
+  vtkNew<vtkPolyData> surface;
+  surface->SetPoints(points);
+  surface->SetPolys(triangles);
+
+  vtkNew<vtkPoints> query;
+  query->SetNumberOfPoints(2000);
+  for (vtkIdType i = 0; i < query->GetNumberOfPoints(); ++i)
+  {
+    query->SetPoint(i, vtkMath::Random(-0.5, 2.5), vtkMath::Random(-0.5, 2.5), 0.0);
+  }
+
+  vtkNew<vtkOBBTree> tree;
+  tree->SetDataSet(surface);
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(surface);
+  reference->BuildLocator();
+
+  vtkNew<vtkIdList> cellIds;
+  tree->FindCells(query, cellIds);
+
+  int errors = 0;
+  vtkNew<vtkGenericCell> cell;
+  double x[3], pcoords[3], weights[3], closest[3], dist2;
+  int subId;
+  for (vtkIdType i = 0; i < query->GetNumberOfPoints(); ++i)
+  {
+    query->GetPoint(i, x);
+    vtkIdType cellId = tree->FindCell(x, 0.0, cell, pcoords, weights);
+    vtkIdType refId = reference->FindCell(x, 0.0, cell, pcoords, weights);
+    if (cellId != cellIds->GetId(i) || (cellId < 0) != (refId < 0))
+    {
+      ++errors;
+      continue;
+    }
+    // A point on a shared edge may be assigned to either cell.
+    if (cellId >= 0)
+    {
+      surface->GetCell(cellId, cell);
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) != 1)
+      {
+        ++errors;
+      }
+    }
+  }
+
+  if (errors)
+  {
+    cerr << errors << " FindCell mismatches" << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
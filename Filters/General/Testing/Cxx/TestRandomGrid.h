@@ -0,0 +1,118 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRandomGrid.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by the spatial reordering test and timing driver: a block
+// of hexahedra with random point and cell numberings.
+
+#ifndef TestRandomGrid_h
+#define TestRandomGrid_h
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVariant.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+void Shuffle(std::vector<vtkIdType>& ids)
+{
+  for (vtkIdType i = static_cast<vtkIdType>(ids.size()) - 1; i > 0; --i)
+  {
+    vtkIdType j = static_cast<vtkIdType>(vtkMath::Random(0.0, i + 1.0));
+    std::swap(ids[i], ids[j < i ? j : i]);
+  }
+}
+
+// A block of n^3 hexahedra with random point and cell numberings.
+void MakeRandomGrid(int n, vtkUnstructuredGrid* grid)
+{
+  int np = n + 1;
+  std::vector<vtkIdType> ptIds(np * np * np), cellIds(n * n * n);
+  for (size_t i = 0; i < ptIds.size(); ++i)
+  {
+    ptIds[i] = static_cast<vtkIdType>(i);
+  }
+  for (size_t i = 0; i < cellIds.size(); ++i)
+  {
+    cellIds[i] = static_cast<vtkIdType>(i);
+  }
+  Shuffle(ptIds);
+  Shuffle(cellIds);
+
+  vtkNew<vtkPoints> pts;
+  pts->SetNumberOfPoints(np * np * np);
+  vtkNew<vtkDoubleArray> pointScalars;
+  pointScalars->SetName("PointScalars");
+  pointScalars->SetNumberOfTuples(np * np * np);
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        vtkIdType id = ptIds[i + np * (j + np * k)];
+        pts->SetPoint(id, i, j + 0.1 * std::sin(0.3 * i), k);
+        pointScalars->SetValue(id, i + 10 * j + 100 * k);
+      }
+    }
+  }
+
+  std::vector<vtkIdType> order(n * n * n);
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        order[cellIds[i + n * (j + n * k)]] = i + n * (j + n * k);
+      }
+    }
+  }
+  grid->SetPoints(pts);
+  grid->Allocate(n * n * n);
+  vtkNew<vtkDoubleArray> cellScalars;
+  cellScalars->SetName("CellScalars");
+  vtkNew<vtkStringArray> cellNames;
+  cellNames->SetName("CellNames");
+  for (vtkIdType c = 0; c < n * n * n; ++c)
+  {
+    int i = order[c] % n, j = (order[c] / n) % n, k = order[c] / (n * n);
+    vtkIdType hex[8];
+    for (int v = 0; v < 8; ++v)
+    {
+      int di = ((v + 1) / 2) % 2, dj = (v / 2) % 2, dk = v / 4;
+      hex[v] = ptIds[(i + di) + np * ((j + dj) + np * (k + dk))];
+    }
+    grid->InsertNextCell(VTK_HEXAHEDRON, 8, hex);
+    cellScalars->InsertNextValue(order[c]);
+    cellNames->InsertNextValue(vtkVariant(order[c]).ToString());
+  }
+  grid->GetPointData()->SetScalars(pointScalars);
+  grid->GetCellData()->SetScalars(cellScalars);
+  grid->GetCellData()->AddArray(cellNames);
+}
+
+}
+
+#endif
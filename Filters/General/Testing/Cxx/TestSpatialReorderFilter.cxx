@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpatialReorderFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Reorder a randomly numbered hexahedral mesh and a polydata with
+// vtkSpatialReorderFilter, and check that the output describes the same data.
+
+#include "TestRandomGrid.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSpatialReorderFilter.h"
+#include "vtkStringArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+
+// Check that the output is the input renumbered with the original ids.
+int CheckReordering(vtkPointSet* input, vtkPointSet* output)
+{
+  vtkIdTypeArray* origPts =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkIdTypeArray* origCells =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  if (!origPts || !origCells || output->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    output->GetNumberOfCells() != input->GetNumberOfCells())
+  {
+    cerr << "Missing original ids or wrong output size" << endl;
+    return 1;
+  }
+
+  double x[3], y[3];
+  vtkDataArray* inScalars = input->GetPointData()->GetScalars();
+  vtkDataArray* outScalars = output->GetPointData()->GetScalars();
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    vtkIdType orig = origPts->GetValue(i);
+    input->GetPoint(orig, x);
+    output->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+      (inScalars && inScalars->GetTuple1(orig) != outScalars->GetTuple1(i)))
+    {
+      cerr << "Point " << i << " does not match input point " << orig << endl;
+      return 1;
+    }
+  }
+
+  vtkNew<vtkIdList> inPts, outPts;
+  vtkDataArray* inCellScalars = input->GetCellData()->GetScalars();
+  vtkDataArray* outCellScalars = output->GetCellData()->GetScalars();
+  vtkStringArray* inNames =
+    vtkArrayDownCast<vtkStringArray>(input->GetCellData()->GetAbstractArray("CellNames"));
+  vtkStringArray* outNames =
+    vtkArrayDownCast<vtkStringArray>(output->GetCellData()->GetAbstractArray("CellNames"));
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    vtkIdType orig = origCells->GetValue(i);
+    input->GetCellPoints(orig, inPts);
+    output->GetCellPoints(i, outPts);
+    bool same = input->GetCellType(orig) == output->GetCellType(i) &&
+      inPts->GetNumberOfIds() == outPts->GetNumberOfIds();
+    for (vtkIdType j = 0; same && j < inPts->GetNumberOfIds(); ++j)
+    {
+      same = origPts->GetValue(outPts->GetId(j)) == inPts->GetId(j);
+    }
+    if (same && inCellScalars)
+    {
+      same = inCellScalars->GetTuple1(orig) == outCellScalars->GetTuple1(i);
+    }
+    if (same && inNames)
+    {
+      same = outNames && inNames->GetValue(orig) == outNames->GetValue(i);
+    }
+    if (!same)
+    {
+      cerr << "Cell " << i << " does not match input cell " << orig << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Average distance between points with consecutive ids.
+double PointSpread(vtkPointSet* ds)
+{
+  double sum = 0.0, x[3], y[3];
+  ds->GetPoint(0, x);
+  for (vtkIdType i = 1; i < ds->GetNumberOfPoints(); ++i)
+  {
+    ds->GetPoint(i, y);
+    sum += std::sqrt(vtkMath::Distance2BetweenPoints(x, y));
+    x[0] = y[0];
+    x[1] = y[1];
+    x[2] = y[2];
+  }
+  return sum / ds->GetNumberOfPoints();
+}
+
+}
+
+int TestSpatialReorderFilter(int, char*[])
+{
+  int errors = 0;
+  vtkMath::RandomSeed(31415);
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeRandomGrid(30, grid);
+
+  vtkNew<vtkSpatialReorderFilter> reorder;
+  reorder->SetInputData(grid);
+  reorder->GenerateOriginalIdsOn();
+  for (int curve = vtkSpatialReorderFilter::HILBERT_CURVE;
+       curve <= vtkSpatialReorderFilter::MORTON_CURVE; ++curve)
+  {
+    reorder->SetCurve(curve);
+    reorder->Update();
+    vtkUnstructuredGrid* output = vtkUnstructuredGrid::SafeDownCast(reorder->GetOutput());
+    errors += CheckReordering(grid, output);
+
+    // Consecutive points must be much closer than in the random numbering
+    double before = PointSpread(grid), after = PointSpread(output);
+    if (after > 0.2 * before)
+    {
+      cerr << "Poor locality after reordering: " << after << " vs " << before << endl;
+      ++errors;
+    }
+  }
+
+  // Cells only
+  reorder->ReorderPointsOff();
+  reorder->Update();
+  errors += CheckReordering(grid, reorder->GetOutput());
+  if (reorder->GetOutput()->GetPoints() != grid->GetPoints())
+  {
+    cerr << "The points should be passed through" << endl;
+    ++errors;
+  }
+  reorder->ReorderPointsOn();
+
+  // A grid with points but no cells: only the points are reordered
+  vtkNew<vtkUnstructuredGrid> cloud;
+  cloud->SetPoints(grid->GetPoints());
+  cloud->GetPointData()->SetScalars(grid->GetPointData()->GetScalars());
+  reorder->SetInputData(cloud);
+  reorder->Update();
+  errors += CheckReordering(cloud, reorder->GetOutput());
+
+  // Polydata: the cells are reordered within each cell array
+  vtkNew<vtkPolyData> poly;
+  poly->SetPoints(grid->GetPoints());
+  poly->GetPointData()->SetScalars(grid->GetPointData()->GetScalars());
+  vtkNew<vtkCellArray> verts, lines, polys;
+  for (vtkIdType i = 0; i < 500; ++i)
+  {
+    vtkIdType pt = (i * 37) % grid->GetNumberOfPoints();
+    verts->InsertNextCell(1, &pt);
+    vtkIdType line[2] = { pt, (pt * 7 + 1) % grid->GetNumberOfPoints() };
+    lines->InsertNextCell(2, line);
+  }
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType i = 0; i < grid->GetNumberOfCells(); i += 3)
+  {
+    grid->GetCellPoints(i, ids);
+    polys->InsertNextCell(4, ids->GetPointer(0));
+  }
+  poly->SetVerts(verts);
+  poly->SetLines(lines);
+  poly->SetPolys(polys);
+  reorder->SetInputData(poly);
+  reorder->Update();
+  vtkPolyData* polyOut = vtkPolyData::SafeDownCast(reorder->GetOutput());
+  errors += CheckReordering(poly, polyOut);
+  vtkIdTypeArray* origCells =
+    vtkIdTypeArray::SafeDownCast(polyOut->GetCellData()->GetArray("vtkOriginalCellIds"));
+  for (vtkIdType i = 0; origCells && i < polyOut->GetNumberOfCells(); ++i)
+  {
+    vtkIdType block = (i < 500 ? 0 : (i < 1000 ? 1 : 2));
+    vtkIdType origBlock = (origCells->GetValue(i) < 500 ? 0 : (origCells->GetValue(i) < 1000 ? 1 : 2));
+    if (block != origBlock)
+    {
+      cerr << "Polydata cell " << i << " moved to another cell array" << endl;
+      ++errors;
+      break;
+    }
+  }
+
+  return errors;
+}
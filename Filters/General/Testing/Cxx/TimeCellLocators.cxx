@@ -0,0 +1,105 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeCellLocators.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the construction and the IntersectWithLine() queries of the cell
+// locators on a triangulated sphere. This timing driver is not run by
+// ctest; run it with
+//   vtkFiltersGeneralCxxTests TimeCellLocators [resolution] [segments]
+// The defaults (710, 100000) give a sphere of 1005360 triangles. The
+// vtkOBBTree and vtkCellTreeLocator queries take minutes at that size.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkMath.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+int TimeCellLocators(int argc, char* argv[])
+{
+  int resolution = (argc > 1 ? atoi(argv[1]) : 710);
+  int numSegments = (argc > 2 ? atoi(argv[2]) : 100000);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+
+  // Segments between random points of the [-0.75, 0.75]^3 cube
+  vtkMath::RandomSeed(314159);
+  vtkNew<vtkPoints> ends;
+  ends->SetDataTypeToDouble();
+  ends->SetNumberOfPoints(2 * numSegments);
+  for (vtkIdType i = 0; i < 2 * numSegments; ++i)
+  {
+    ends->SetPoint(i, vtkMath::Random(-0.75, 0.75), vtkMath::Random(-0.75, 0.75),
+      vtkMath::Random(-0.75, 0.75));
+  }
+
+  cout << "Timing " << surface->GetNumberOfCells() << " triangles, " << numSegments
+       << " segments\n";
+
+  const char* names[] = { "vtkBVHCellLocator", "vtkStaticCellLocator", "vtkCellLocator",
+    "vtkModifiedBSPTree", "vtkCellTreeLocator", "vtkOBBTree" };
+  vtkSmartPointer<vtkAbstractCellLocator> locators[] = {
+    vtkSmartPointer<vtkBVHCellLocator>::New(), vtkSmartPointer<vtkStaticCellLocator>::New(),
+    vtkSmartPointer<vtkCellLocator>::New(), vtkSmartPointer<vtkModifiedBSPTree>::New(),
+    vtkSmartPointer<vtkCellTreeLocator>::New(), vtkSmartPointer<vtkOBBTree>::New()
+  };
+
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkGenericCell> cell;
+  for (int l = 0; l < 6; ++l)
+  {
+    vtkAbstractCellLocator* locator = locators[l];
+    locator->SetDataSet(surface);
+    locator->LazyEvaluationOff();
+    timer->StartTimer();
+    locator->BuildLocator();
+    timer->StopTimer();
+    double buildTime = timer->GetElapsedTime();
+
+    vtkIdType numHits = 0;
+    double t, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId;
+    timer->StartTimer();
+    for (vtkIdType i = 0; i < numSegments; ++i)
+    {
+      double p1[3], p2[3];
+      ends->GetPoint(2 * i, p1);
+      ends->GetPoint(2 * i + 1, p2);
+      if (locator->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell))
+      {
+        ++numHits;
+      }
+    }
+    timer->StopTimer();
+    cout << names[l] << ": build " << buildTime << " s, queries " << timer->GetElapsedTime()
+         << " s, " << numHits << " hits\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeGradientFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkGradientFilter computing the gradient, vorticity, divergence and
+// Q-criterion of point data on a grid of mixed cells and of cell data on
+// hexahedra, for each contributing cell option. This timing driver is not
+// run by ctest; run it with
+//   vtkFiltersGeneralCxxTests TimeGradientFilter [size]
+// The default size of 60 gives grids of 60^3 hexahedra, half of which are
+// split into tetrahedra in the mixed grid.
+
+#include "TestLinearFieldGrid.h"
+
+#include "vtkGradientFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+void TimeFilter(vtkUnstructuredGrid* grid, int association, const char* name, int option,
+  bool faster, const char* label)
+{
+  vtkNew<vtkGradientFilter> gradient;
+  gradient->SetInputData(grid);
+  gradient->SetInputArrayToProcess(0, 0, 0, association, name);
+  gradient->SetResultArrayName("Gradients");
+  gradient->ComputeVorticityOn();
+  gradient->ComputeDivergenceOn();
+  gradient->ComputeQCriterionOn();
+  gradient->SetContributingCellOption(option);
+  gradient->SetFasterApproximation(faster);
+
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  gradient->Update();
+  timer->StopTimer();
+  cout << label << ": " << timer->GetElapsedTime() << " s\n";
+}
+
+}
+
+int TimeGradientFilter(int argc, char* argv[])
+{
+  int n = (argc > 1 ? atoi(argv[1]) : 60);
+
+  vtkNew<vtkUnstructuredGrid> mixed;
+  MakeGrid(n, true, mixed);
+  AddLinearPointField(mixed, "v");
+  vtkNew<vtkUnstructuredGrid> hexes;
+  MakeGrid(n, false, hexes);
+  AddLinearCellField(hexes, "c");
+
+  cout << "Timing " << mixed->GetNumberOfCells() << " mixed cells and "
+       << hexes->GetNumberOfCells() << " hexahedra, "
+       << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  const int points = vtkDataObject::FIELD_ASSOCIATION_POINTS;
+  const int cells = vtkDataObject::FIELD_ASSOCIATION_CELLS;
+  TimeFilter(mixed, points, "v", vtkGradientFilter::All, false, "Points, all");
+  TimeFilter(mixed, points, "v", vtkGradientFilter::Patch, false, "Points, patch");
+  TimeFilter(mixed, points, "v", vtkGradientFilter::DataSetMax, false, "Points, data set max");
+  TimeFilter(mixed, points, "v", vtkGradientFilter::DataSetMax, true,
+    "Points, faster approximation");
+  TimeFilter(hexes, cells, "c", vtkGradientFilter::All, false, "Cells, all");
+  TimeFilter(hexes, cells, "c", vtkGradientFilter::Patch, false, "Cells, patch");
+  TimeFilter(hexes, cells, "c", vtkGradientFilter::DataSetMax, false, "Cells, data set max");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,80 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeSpatialReorderFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkDataSetSurfaceFilter and vtkCellDataToPointData on a randomly
+// numbered block of hexahedra and on its copy reordered along a Hilbert
+// curve by vtkSpatialReorderFilter. This timing driver is not run by ctest;
+// run it with
+//   vtkFiltersGeneralCxxTests TimeSpatialReorderFilter [size]
+// The default size of 100 gives 10^6 hexahedra.
+
+#include "TestRandomGrid.h"
+
+#include "vtkCellDataToPointData.h"
+#include "vtkDataSetSurfaceFilter.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkSpatialReorderFilter.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstdlib>
+
+namespace
+{
+
+void TimeDownstreamFilters(vtkDataSet* ds, const char* label)
+{
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkDataSetSurfaceFilter> surface;
+  surface->SetInputData(ds);
+  timer->StartTimer();
+  surface->Update();
+  timer->StopTimer();
+  double surfaceTime = timer->GetElapsedTime();
+
+  vtkNew<vtkCellDataToPointData> c2p;
+  c2p->SetInputData(ds);
+  timer->StartTimer();
+  c2p->Update();
+  timer->StopTimer();
+  cout << label << ": vtkDataSetSurfaceFilter " << surfaceTime << " s, vtkCellDataToPointData "
+       << timer->GetElapsedTime() << " s\n";
+}
+
+}
+
+int TimeSpatialReorderFilter(int argc, char* argv[])
+{
+  int size = (argc > 1 ? atoi(argv[1]) : 100);
+
+  vtkMath::RandomSeed(31415);
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeRandomGrid(size, grid);
+  cout << "Timing " << grid->GetNumberOfCells() << " hexahedra\n";
+
+  vtkNew<vtkTimerLog> timer;
+  vtkNew<vtkSpatialReorderFilter> reorder;
+  reorder->SetInputData(grid);
+  reorder->SetCurveToHilbert();
+  timer->StartTimer();
+  reorder->Update();
+  timer->StopTimer();
+  cout << "vtkSpatialReorderFilter: " << timer->GetElapsedTime() << " s\n";
+
+  TimeDownstreamFilters(grid, "Random ordering");
+  TimeDownstreamFilters(reorder->GetOutput(), "Hilbert ordering");
+
+  return EXIT_SUCCESS;
+}
@@ -672,27 +672,9 @@ namespace
 }
 typedef std::pair<double, int> Intersection;
 
-int vtkCellTreeLocator::IntersectWithLine(const double p1[3],
-                                          const double p2[3],
-                                          double tol,
-                                          double &t,
-                                          double x[3],
-                                          double pcoords[3],
-                                          int &subId,
-                                          vtkIdType &cellId,
-                                          vtkGenericCell *cell)
-{
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
-}
-
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
   double& t, double x[3], double pcoords[3],
-  int &subId, vtkIdType &cellIds)
+  int &subId, vtkIdType &cellIds, vtkGenericCell *cell)
 {
   //
   vtkCellTreeNode  *node, *near, *far;
@@ -805,7 +787,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
       ctmin = _tmin; ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit<closest_intersection)
           {
@@ -826,6 +808,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellIds, cell);
   }
   //
   return HIT;
@@ -1211,7 +1194,51 @@ void vtkCellTreeLocator::Classify(const double origin[3],
   }
 
 }
+//----------------------------------------------------------------------------
+// This is here to shut off warnings about the generic cell overload of
+// IntersectCellInternal() calling the deprecated one.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+# pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+#ifdef _MSC_VER
+# pragma warning (disable: 4996)
+#endif
+
+#if !defined(VTK_LEGACY_REMOVE)
+// Value of subId with which the generic cell overload of
+// IntersectCellInternal() calls the deprecated one. The default deprecated
+// overload then returns -1 to let the caller test the cell itself.
+static const int vtkCellTreeLocatorLegacyIntersectMarker = VTK_INT_MIN;
+#endif
+
 //----------------------------------------------------------------------------
+int vtkCellTreeLocator::IntersectCellInternal(
+  vtkIdType cell_ID,
+  const double p1[3],
+  const double p2[3],
+  const double tol,
+  double &t,
+  double ipt[3],
+  double pcoords[3],
+  int &subId,
+  vtkGenericCell *cell)
+{
+#if !defined(VTK_LEGACY_REMOVE)
+  // Give subclasses that override the deprecated overload a chance to test
+  // the cell.
+  subId = vtkCellTreeLocatorLegacyIntersectMarker;
+  int hit = this->IntersectCellInternal(cell_ID, p1, p2, tol, t, ipt, pcoords, subId);
+  if (hit != -1)
+  {
+    return hit;
+  }
+#endif
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
+}
+//----------------------------------------------------------------------------
+#if !defined(VTK_LEGACY_REMOVE)
 int vtkCellTreeLocator::IntersectCellInternal(
   vtkIdType cell_ID,
   const double p1[3],
@@ -1222,9 +1249,17 @@ int vtkCellTreeLocator::IntersectCellInternal(
   double pcoords[3],
   int &subId)
 {
+  if (subId == vtkCellTreeLocatorLegacyIntersectMarker)
+  {
+    // Not overridden, let the generic cell overload test the cell
+    return -1;
+  }
+  VTK_LEGACY_REPLACED_BODY(vtkCellTreeLocator::IntersectCellInternal, "VTK 9.0",
+    vtkCellTreeLocator::IntersectCellInternal with a vtkGenericCell);
   this->DataSet->GetCell(cell_ID, this->GenericCell);
   return this->GenericCell->IntersectWithLine(const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
+#endif
 //----------------------------------------------------------------------------
 void vtkCellTreeLocator::FreeSearchStructure(void)
 {
@@ -1421,6 +1456,20 @@ void vtkCellTreeLocator::FindCellsWithinBounds(double *bbox, vtkIdList *cells)
     }
   }
 }
+//---------------------------------------------------------------------------
+void vtkCellTreeLocator::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, true);
+}
+
+//---------------------------------------------------------------------------
+void vtkCellTreeLocator::IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                            double tol, vtkPoints *points,
+                                            vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, true);
+}
+
 //---------------------------------------------------------------------------
 
 void vtkCellTreeLocator::PrintSelf(ostream& os, vtkIndent indent)
@@ -16,16 +16,102 @@
 
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
 #include "vtkImplicitPolyDataDistance.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangle.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkDistancePolyDataFilter);
 
+namespace
+{
+
+// Evaluate the distance function at the points of the mesh.
+struct PointDistance
+{
+  vtkPolyData *Mesh;
+  vtkImplicitPolyDataDistance *Function;
+  double *Distance;
+  bool Signed;
+  bool Negate;
+
+  PointDistance(vtkPolyData *mesh, vtkImplicitPolyDataDistance *imp,
+                double *dist, bool signedDist, bool negate) :
+    Mesh(mesh), Function(imp), Distance(dist), Signed(signedDist),
+    Negate(negate)
+  {
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId )
+    {
+      this->Mesh->GetPoint(ptId, x);
+      double val = this->Function->EvaluateFunction(x);
+      this->Distance[ptId] = this->Signed ? (this->Negate ? -val : val) : fabs(val);
+    }
+  }
+};
+
+// Evaluate the distance function at the parametric centers of the cells of
+// the mesh.
+struct CellDistance
+{
+  vtkPolyData *Mesh;
+  vtkImplicitPolyDataDistance *Function;
+  double *Distance;
+  bool Signed;
+  bool Negate;
+  int MaxCellSize;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  CellDistance(vtkPolyData *mesh, vtkImplicitPolyDataDistance *imp,
+               double *dist, bool signedDist, bool negate) :
+    Mesh(mesh), Function(imp), Distance(dist), Signed(signedDist),
+    Negate(negate), MaxCellSize(mesh->GetMaxCellSize())
+  {
+  }
+
+  void Initialize()
+  {
+    this->Weights.Local().resize(this->MaxCellSize > 0 ? this->MaxCellSize : 1);
+  }
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    vtkGenericCell *cell = this->Cell.Local();
+    double *weights = this->Weights.Local().data();
+    int subId;
+    double pcoords[3], x[3];
+    for ( ; cellId < endCellId; ++cellId )
+    {
+      this->Mesh->GetCell(cellId, cell);
+      cell->GetParametricCenter(pcoords);
+      cell->EvaluateLocation(subId, pcoords, x, weights);
+
+      double val = this->Function->EvaluateFunction(x);
+      this->Distance[cellId] = this->Signed ? (this->Negate ? -val : val) : fabs(val);
+    }
+  }
+
+  void Reduce()
+  {
+  }
+};
+
+} // anonymous namespace
+
 //-----------------------------------------------------------------------------
 vtkDistancePolyDataFilter::vtkDistancePolyDataFilter() : vtkPolyDataAlgorithm()
 {
@@ -89,47 +175,35 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   imp->SetInput( src );
 
   // Calculate distance from points.
-  int numPts = mesh->GetNumberOfPoints();
+  vtkIdType numPts = mesh->GetNumberOfPoints();
 
   vtkDoubleArray* pointArray = vtkDoubleArray::New();
   pointArray->SetName( "Distance" );
   pointArray->SetNumberOfComponents( 1 );
   pointArray->SetNumberOfTuples( numPts );
 
-  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
-  {
-    double pt[3];
-    mesh->GetPoint( ptId, pt );
-    double val = imp->EvaluateFunction( pt );
-    double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-    pointArray->SetValue( ptId, dist );
-  }
+  // The function is thread safe once its input is set
+  bool signedDist = this->SignedDistance != 0;
+  bool negate = this->NegateDistance != 0;
+  PointDistance pointDistance(mesh, imp, pointArray->GetPointer(0),
+                              signedDist, negate);
+  vtkSMPTools::For(0, numPts, pointDistance);
 
   mesh->GetPointData()->AddArray( pointArray );
   pointArray->Delete();
   mesh->GetPointData()->SetActiveScalars( "Distance" );
 
   // Calculate distance from cell centers.
-  int numCells = mesh->GetNumberOfCells();
+  vtkIdType numCells = mesh->GetNumberOfCells();
 
   vtkDoubleArray* cellArray = vtkDoubleArray::New();
   cellArray->SetName( "Distance" );
   cellArray->SetNumberOfComponents( 1 );
   cellArray->SetNumberOfTuples( numCells );
 
-  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
-  {
-    vtkCell *cell = mesh->GetCell( cellId );
-    int subId;
-    double pcoords[3], x[3], weights[256];
-
-    cell->GetParametricCenter( pcoords );
-    cell->EvaluateLocation( subId, pcoords, x, weights );
-
-    double val = imp->EvaluateFunction( x );
-    double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-    cellArray->SetValue( cellId, dist );
-  }
+  CellDistance cellDistance(mesh, imp, cellArray->GetPointer(0),
+                            signedDist, negate);
+  vtkSMPTools::For(0, numCells, cellDistance);
 
   mesh->GetCellData()->AddArray( cellArray );
   cellArray->Delete();
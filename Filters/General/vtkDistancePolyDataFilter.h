@@ -27,6 +27,12 @@
  * computed by calling SignedDistanceOff(). The signed distance field
  * may be negated by calling NegateDistanceOn();
  *
+ * @warning
+ * The distances at the points and at the cell centers are computed in
+ * parallel using vtkSMPTools. Using TBB or other non-sequential type (set
+ * in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve
+ * performance significantly.
+ *
  * This code was contributed in the VTK Journal paper:
  * "Boolean Operations on Surfaces in VTK Without External Libraries"
  * by Cory Quammen, Chris Weigle C., Russ Taylor
@@ -23,8 +23,10 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCellDataToPointData.h"
+#include "vtkCellTypes.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,11 +37,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -91,7 +98,7 @@ namespace
 
   int GetCellParametricData(
     vtkIdType pointId, double pointCoord[3], vtkCell *cell, int & subId,
-    double parametricCoord[3]);
+    double parametricCoord[3], double *weights);
 
   template<class data_type>
   void ComputeCellGradientsUG(
@@ -451,17 +458,18 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(
   int highestCellDimension = 0;
   if (this->ContributingCellOption == vtkGradientFilter::DataSetMax)
   {
-    int maxDimension = input->IsA("vtkPolyData") == 1 ? 2 : 3;
-    for (vtkIdType i=0;i<input->GetNumberOfCells();i++)
+    // The dimension only depends on the cell type, so only the distinct cell
+    // types are checked.
+    vtkNew<vtkCellTypes> cellTypes;
+    input->GetCellTypes(cellTypes);
+    vtkNew<vtkGenericCell> cell;
+    for (vtkIdType i=0;i<cellTypes->GetNumberOfTypes();i++)
     {
-      int dim = input->GetCell(i)->GetCellDimension();
+      cell->SetCellType(cellTypes->GetCellType(i));
+      int dim = cell->GetCellDimension();
       if (dim > highestCellDimension)
       {
         highestCellDimension = dim;
-        if (highestCellDimension == maxDimension)
-        {
-          break;
-        }
       }
     }
   }
@@ -836,125 +844,189 @@ int vtkGradientFilter::GetOutputArrayType(vtkDataArray* array)
 
 namespace {
 //-----------------------------------------------------------------------------
+// Point gradients of unstructured data sets. Each point averages the
+// derivatives of the cells using it, found through static cell links built
+// once up front. The points are processed in parallel, each thread with its
+// own cell and buffers.
   template<class data_type>
-  void ComputePointGradientsUG(
-    vtkDataSet *structure, vtkDataArray *array, data_type *gradients,
-    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
-    data_type* divergence, int highestCellDimension, int contributingCellOption)
+  struct PointGradientsUG
   {
-    vtkNew<vtkIdList> currentPoint;
-    currentPoint->SetNumberOfIds(1);
-    vtkNew<vtkIdList> cellsOnPoint;
-
-    vtkIdType numpts = structure->GetNumberOfPoints();
-
-    int numberOfOutputComponents = 3*numberOfInputComponents;
-    std::vector<data_type> g(numberOfOutputComponents);
-
-    // if we are doing patches for contributing cell dimensions we want to keep track of
-    // the maximum expected dimension so we can exit out of the check loop quicker
-    const int maxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+    vtkDataSet *Structure;
+    vtkStaticCellLinks *Links;
+    vtkDataArray *Array;
+    data_type *Gradients;
+    int NumberOfInputComponents;
+    data_type *Vorticity;
+    data_type *QCriterion;
+    data_type *Divergence;
+    int HighestCellDimension;
+    int ContributingCellOption;
+    int MaxCellDimension;
+    int MaxCellSize;
+
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+    vtkSMPThreadLocal<std::vector<double> > Values;
+    vtkSMPThreadLocal<std::vector<double> > Weights;
+    vtkSMPThreadLocal<std::vector<data_type> > G;
+
+    void Initialize()
+    {
+      this->Values.Local().resize(this->MaxCellSize);
+      this->Weights.Local().resize(this->MaxCellSize);
+      this->G.Local().resize(3*this->NumberOfInputComponents);
+    }
 
-    for (vtkIdType point = 0; point < numpts; point++)
+    void operator() (vtkIdType beginPoint, vtkIdType endPoint)
     {
-      currentPoint->SetId(0, point);
-      double pointcoords[3];
-      structure->GetPoint(point, pointcoords);
-      // Get all cells touching this point.
-      structure->GetCellNeighbors(-1, currentPoint, cellsOnPoint);
-      vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-
-      for(int i=0;i<numberOfOutputComponents;i++)
+      vtkGenericCell *cell = this->Cell.Local();
+      std::vector<double> &values = this->Values.Local();
+      std::vector<double> &weights = this->Weights.Local();
+      std::vector<data_type> &g = this->G.Local();
+      int numberOfOutputComponents = 3*this->NumberOfInputComponents;
+      int highestCellDimension = this->HighestCellDimension;
+
+      for (vtkIdType point = beginPoint; point < endPoint; point++)
       {
-        g[i] = 0;
-      }
+        double pointcoords[3];
+        this->Structure->GetPoint(point, pointcoords);
+        // Get all cells touching this point.
+        vtkIdType numCellNeighbors = this->Links->GetNumberOfCells(point);
+        const vtkIdType *cellsOnPoint = this->Links->GetCells(point);
 
-      if (contributingCellOption == vtkGradientFilter::Patch)
-      {
-        highestCellDimension = 0;
-        for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+        for(int i=0;i<numberOfOutputComponents;i++)
+        {
+          g[i] = 0;
+        }
+
+        if (this->ContributingCellOption == vtkGradientFilter::Patch)
         {
-          int cellDimension = structure->GetCell(cellsOnPoint->GetId(neighbor))->GetCellDimension();
-          if (cellDimension > highestCellDimension)
+          highestCellDimension = 0;
+          for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
           {
-            highestCellDimension = cellDimension;
-            if (highestCellDimension == maxCellDimension)
+            this->Structure->GetCell(cellsOnPoint[neighbor], cell);
+            int cellDimension = cell->GetCellDimension();
+            if (cellDimension > highestCellDimension)
             {
-              break;
+              highestCellDimension = cellDimension;
+              if (highestCellDimension == this->MaxCellDimension)
+              {
+                break;
+              }
             }
           }
         }
-      }
-      vtkIdType numValidCellNeighbors = 0;
+        vtkIdType numValidCellNeighbors = 0;
 
-      // Iterate on all cells and find all points connected to current point
-      // by an edge.
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
-      {
-        vtkCell *cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-        if (cell->GetCellDimension() >= highestCellDimension)
+        // Iterate on all cells and find all points connected to current point
+        // by an edge.
+        for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
         {
-          int subId;
-          double parametricCoord[3];
-          if(GetCellParametricData(point, pointcoords, cell,
-                                   subId, parametricCoord))
+          this->Structure->GetCell(cellsOnPoint[neighbor], cell);
+          if (cell->GetCellDimension() >= highestCellDimension)
           {
-            numValidCellNeighbors++;
-            for(int inputComponent=0;inputComponent<numberOfInputComponents;inputComponent++)
+            int subId;
+            double parametricCoord[3];
+            if(GetCellParametricData(point, pointcoords, cell,
+                                     subId, parametricCoord, &weights[0]))
             {
+              numValidCellNeighbors++;
               int numberOfCellPoints = cell->GetNumberOfPoints();
-              std::vector<double> values(numberOfCellPoints);
-              // Get values of Array at cell points.
-              for (int i = 0; i < numberOfCellPoints; i++)
+              for(int inputComponent=0;inputComponent<this->NumberOfInputComponents;inputComponent++)
               {
-                values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
-              }
-
-              double derivative[3];
-              // Get derivative of cell at point.
-              cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
-
-              g[inputComponent*3] += static_cast<data_type>(derivative[0]);
-              g[inputComponent*3+1] += static_cast<data_type>(derivative[1]);
-              g[inputComponent*3+2] += static_cast<data_type>(derivative[2]);
-            } // iterating over Components
-          } // if(GetCellParametricData())
-        } // if(cell->GetCellDimension () >= highestCellDimension
-      } // iterating over neighbors
-
-      if (numValidCellNeighbors > 0)
-      {
-        for(int i=0;i<3*numberOfInputComponents;i++)
-        {
-          g[i] /= numValidCellNeighbors;
-        }
-
-        if(vorticity)
-        {
-          ComputeVorticityFromGradient(&g[0], vorticity+3*point);
-        }
-        if(qCriterion)
-        {
-          ComputeQCriterionFromGradient(&g[0], qCriterion+point);
-        }
-        if(divergence)
-        {
-          ComputeDivergenceFromGradient(&g[0], divergence+point);
-        }
-        if(gradients)
+                // Get values of Array at cell points.
+                for (int i = 0; i < numberOfCellPoints; i++)
+                {
+                  values[i] = this->Array->GetComponent(cell->GetPointId(i), inputComponent);
+                }
+
+                double derivative[3];
+                // Get derivative of cell at point.
+                cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
+
+                g[inputComponent*3] += static_cast<data_type>(derivative[0]);
+                g[inputComponent*3+1] += static_cast<data_type>(derivative[1]);
+                g[inputComponent*3+2] += static_cast<data_type>(derivative[2]);
+              } // iterating over Components
+            } // if(GetCellParametricData())
+          } // if(cell->GetCellDimension () >= highestCellDimension
+        } // iterating over neighbors
+
+        if (numValidCellNeighbors > 0)
         {
           for(int i=0;i<numberOfOutputComponents;i++)
           {
-            gradients[point*numberOfOutputComponents+i] = g[i];
+            g[i] /= numValidCellNeighbors;
+          }
+
+          if(this->Vorticity)
+          {
+            ComputeVorticityFromGradient(&g[0], this->Vorticity+3*point);
+          }
+          if(this->QCriterion)
+          {
+            ComputeQCriterionFromGradient(&g[0], this->QCriterion+point);
+          }
+          if(this->Divergence)
+          {
+            ComputeDivergenceFromGradient(&g[0], this->Divergence+point);
+          }
+          if(this->Gradients)
+          {
+            for(int i=0;i<numberOfOutputComponents;i++)
+            {
+              this->Gradients[point*numberOfOutputComponents+i] = g[i];
+            }
           }
         }
-      }
-    }  // iterating over points in grid
+      }  // iterating over points in grid
+    }
+
+    void Reduce()
+    {
+    }
+  };
+
+  template<class data_type>
+  void ComputePointGradientsUG(
+    vtkDataSet *structure, vtkDataArray *array, data_type *gradients,
+    int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+    data_type* divergence, int highestCellDimension, int contributingCellOption)
+  {
+    vtkIdType numpts = structure->GetNumberOfPoints();
+    if (numpts < 1 || structure->GetNumberOfCells() < 1)
+    {
+      return;
+    }
+
+    // The links are queried only, so the static ones can be used. Getting a
+    // cell once makes GetCell() thread safe.
+    vtkNew<vtkStaticCellLinks> links;
+    links->BuildLinks(structure);
+    vtkNew<vtkGenericCell> cell;
+    structure->GetCell(0, cell);
+
+    PointGradientsUG<data_type> functor;
+    functor.Structure = structure;
+    functor.Links = links;
+    functor.Array = array;
+    functor.Gradients = gradients;
+    functor.NumberOfInputComponents = numberOfInputComponents;
+    functor.Vorticity = vorticity;
+    functor.QCriterion = qCriterion;
+    functor.Divergence = divergence;
+    functor.HighestCellDimension = highestCellDimension;
+    functor.ContributingCellOption = contributingCellOption;
+    // if we are doing patches for contributing cell dimensions we want to keep track of
+    // the maximum expected dimension so we can exit out of the check loop quicker
+    functor.MaxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+    functor.MaxCellSize = std::max(structure->GetMaxCellSize(), 1);
+    vtkSMPTools::For(0, numpts, functor);
   }
 
 //-----------------------------------------------------------------------------
   int GetCellParametricData(vtkIdType pointId, double pointCoord[3],
-                            vtkCell *cell, int &subId, double parametricCoord[3])
+                            vtkCell *cell, int &subId, double parametricCoord[3],
+                            double *weights)
   {
     // Watch out for degenerate cells.  They make the derivative calculation
     // fail.
@@ -974,74 +1046,123 @@ namespace {
     }
 
     double dummy;
-    int numpoints = cell->GetNumberOfPoints();
-    std::vector<double> values(numpoints);
     // Get parametric position of point.
     cell->EvaluatePosition(pointCoord, nullptr, subId, parametricCoord,
-                           dummy, &values[0]/*Really another dummy.*/);
+                           dummy, weights/*Really another dummy.*/);
 
     return 1;
   }
 
 //-----------------------------------------------------------------------------
+// Cell gradients of unstructured data sets, evaluated at the parametric
+// center of the cells in parallel.
   template<class data_type>
-    void ComputeCellGradientsUG(
-      vtkDataSet *structure, vtkDataArray *array, data_type *gradients,
-      int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
-      data_type* divergence)
+  struct CellGradientsUG
   {
-    vtkIdType numcells = structure->GetNumberOfCells();
-    std::vector<double> values(8);
-    std::vector<data_type> cellGradients(3*numberOfInputComponents);
-    for (vtkIdType cellid = 0; cellid < numcells; cellid++)
+    vtkDataSet *Structure;
+    vtkDataArray *Array;
+    data_type *Gradients;
+    int NumberOfInputComponents;
+    data_type *Vorticity;
+    data_type *QCriterion;
+    data_type *Divergence;
+    int MaxCellSize;
+
+    vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+    vtkSMPThreadLocal<std::vector<double> > Values;
+    vtkSMPThreadLocal<std::vector<data_type> > CellGradients;
+
+    void Initialize()
+    {
+      this->Values.Local().resize(this->MaxCellSize);
+      this->CellGradients.Local().resize(3*this->NumberOfInputComponents);
+    }
+
+    void operator() (vtkIdType beginCell, vtkIdType endCell)
     {
-      vtkCell *cell = structure->GetCell(cellid);
-      int subId;
-      double cellCenter[3];
-      subId = cell->GetParametricCenter(cellCenter);
+      vtkGenericCell *cell = this->Cell.Local();
+      std::vector<double> &values = this->Values.Local();
+      std::vector<data_type> &cellGradients = this->CellGradients.Local();
+      int numberOfOutputComponents = 3*this->NumberOfInputComponents;
 
-      int numpoints = cell->GetNumberOfPoints();
-      if(static_cast<size_t>(numpoints) > values.size())
-      {
-        values.resize(numpoints);
-      }
-      double derivative[3];
-      for(int inputComponent=0;inputComponent<numberOfInputComponents;
-          inputComponent++)
+      for (vtkIdType cellid = beginCell; cellid < endCell; cellid++)
       {
-        for (int i = 0; i < numpoints; i++)
+        this->Structure->GetCell(cellid, cell);
+        int subId;
+        double cellCenter[3];
+        subId = cell->GetParametricCenter(cellCenter);
+
+        int numpoints = cell->GetNumberOfPoints();
+        double derivative[3];
+        for(int inputComponent=0;inputComponent<this->NumberOfInputComponents;
+            inputComponent++)
         {
-          values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
-        }
+          for (int i = 0; i < numpoints; i++)
+          {
+            values[i] = this->Array->GetComponent(cell->GetPointId(i), inputComponent);
+          }
 
-        cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
-        cellGradients[inputComponent*3] =
-          static_cast<data_type>(derivative[0]);
-        cellGradients[inputComponent*3+1] =
-          static_cast<data_type>(derivative[1]);
-        cellGradients[inputComponent*3+2] =
-          static_cast<data_type>(derivative[2]);
-      }
-      if(gradients)
-      {
-        for(int i=0;i<3*numberOfInputComponents;i++)
+          cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
+          cellGradients[inputComponent*3] =
+            static_cast<data_type>(derivative[0]);
+          cellGradients[inputComponent*3+1] =
+            static_cast<data_type>(derivative[1]);
+          cellGradients[inputComponent*3+2] =
+            static_cast<data_type>(derivative[2]);
+        }
+        if(this->Gradients)
         {
-          gradients[cellid*3*numberOfInputComponents+i] = cellGradients[i];
+          for(int i=0;i<numberOfOutputComponents;i++)
+          {
+            this->Gradients[cellid*numberOfOutputComponents+i] = cellGradients[i];
+          }
+        }
+        if(this->Vorticity)
+        {
+          ComputeVorticityFromGradient(&cellGradients[0], this->Vorticity+3*cellid);
+        }
+        if(this->QCriterion)
+        {
+          ComputeQCriterionFromGradient(&cellGradients[0], this->QCriterion+cellid);
+        }
+        if(this->Divergence)
+        {
+          ComputeDivergenceFromGradient(&cellGradients[0], this->Divergence+cellid);
         }
-      }
-      if(vorticity)
-      {
-        ComputeVorticityFromGradient(&cellGradients[0], vorticity+3*cellid);
-      }
-      if(qCriterion)
-      {
-        ComputeQCriterionFromGradient(&cellGradients[0], qCriterion+cellid);
-      }
-      if(divergence)
-      {
-        ComputeDivergenceFromGradient(&cellGradients[0], divergence+cellid);
       }
     }
+
+    void Reduce()
+    {
+    }
+  };
+
+  template<class data_type>
+    void ComputeCellGradientsUG(
+      vtkDataSet *structure, vtkDataArray *array, data_type *gradients,
+      int numberOfInputComponents, data_type* vorticity, data_type* qCriterion,
+      data_type* divergence)
+  {
+    vtkIdType numcells = structure->GetNumberOfCells();
+    if (numcells < 1)
+    {
+      return;
+    }
+
+    // Getting a cell once makes GetCell() thread safe.
+    vtkNew<vtkGenericCell> cell;
+    structure->GetCell(0, cell);
+
+    CellGradientsUG<data_type> functor;
+    functor.Structure = structure;
+    functor.Array = array;
+    functor.Gradients = gradients;
+    functor.NumberOfInputComponents = numberOfInputComponents;
+    functor.Vorticity = vorticity;
+    functor.QCriterion = qCriterion;
+    functor.Divergence = divergence;
+    functor.MaxCellSize = std::max(structure->GetMaxCellSize(), 8);
+    vtkSMPTools::For(0, numcells, functor);
   }
 
 //-----------------------------------------------------------------------------
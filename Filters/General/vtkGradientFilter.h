@@ -39,6 +39,9 @@
  * the entire data set. For Patch or DataSetMax it is possible that some values
  * will not be computed. The ReplacementValueOption specifies what to use
  * for these values.
+ *
+ * For unstructured grids and polydata the gradients are computed in
+ * parallel with vtkSMPTools, both for point and cell data.
 */
 
 #ifndef vtkGradientFilter_h
@@ -974,6 +974,77 @@ int vtkOBBTree::IntersectWithLine(const double a0[3], const double a1[3], double
   }
 }
 
+// Returns true if the point lies in the node, enlarged by the tolerance.
+static bool vtkOBBTreePointInNode(vtkOBBNode *node, const double x[3],
+                                  double tol)
+{
+  for ( int ii = 0; ii < 3; ii++ )
+  {
+    double range = vtkMath::Dot( node->Axes[ii], node->Axes[ii] );
+    double dot = vtkMath::Dot( x, node->Axes[ii] ) -
+      vtkMath::Dot( node->Corner, node->Axes[ii] );
+    double eps = tol * sqrt( range );
+    if ( dot < -eps || dot > range + eps )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Find the cell containing the point by walking down the nodes containing
+// it. Only the passed cell and local storage are used, so that concurrent
+// queries are safe once the tree has been built.
+vtkIdType vtkOBBTree::FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                               double pcoords[3], double *weights)
+{
+  if ( this->Tree == nullptr )
+  {
+    return -1;
+  }
+
+  double tol = this->Tolerance + sqrt( tol2 );
+  double closestPoint[3], dist2;
+  int subId;
+  vtkIdType cellId = -1;
+
+  vtkOBBNode **OBBstack = new vtkOBBNode *[this->GetLevel()+1];
+  OBBstack[0] = this->Tree;
+  int depth = 1;
+  while ( depth > 0 && cellId < 0 )
+  { // simulate recursion without the overhead or limitations
+    vtkOBBNode *node = OBBstack[--depth];
+    if ( !vtkOBBTreePointInNode( node, x, tol ) )
+    {
+      continue;
+    }
+    if ( node->Kids == nullptr )
+    { // then this is a leaf node...test its cells
+      vtkIdList *cells = node->Cells;
+      for ( vtkIdType ii = 0; ii < cells->GetNumberOfIds(); ii++ )
+      {
+        vtkIdType thisId = cells->GetId(ii);
+        this->DataSet->GetCell( thisId, cell );
+        if ( cell->EvaluatePosition( x, closestPoint, subId, pcoords,
+                                     dist2, weights ) == 1 && dist2 <= tol2 )
+        {
+          cellId = thisId;
+          break;
+        }
+      }
+    }
+    else
+    { // push kids onto stack
+      OBBstack[depth] = node->Kids[0];
+      OBBstack[depth+1] = node->Kids[1];
+      depth += 2;
+    }
+  }
+
+  delete [] OBBstack;
+  return cellId;
+}
+
 void vtkOBBNode::DebugPrintTree( int level, double *leaf_vol,
                                  int *minCells, int *maxCells )
 {
@@ -1867,6 +1938,19 @@ int vtkOBBTree::IntersectWithOBBTree( vtkOBBTree *OBBTreeB,
   return( count );
 }
 
+// Issue the batched queries in parallel, see vtkAbstractCellLocator.
+void vtkOBBTree::FindCells(vtkPoints *points, vtkIdList *cellIds)
+{
+  this->FindCellsInternal(points, cellIds, true);
+}
+
+void vtkOBBTree::IntersectWithLines(vtkPoints *starts, vtkPoints *ends,
+                                    double tol, vtkPoints *points,
+                                    vtkIdList *cellIds)
+{
+  this->IntersectWithLinesInternal(starts, ends, tol, points, cellIds, true);
+}
+
 void vtkOBBTree::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
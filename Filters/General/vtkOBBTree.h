@@ -96,6 +96,7 @@ public:
 
   // Re-use any superclass signatures that we don't override.
   using vtkAbstractCellLocator::IntersectWithLine;
+  using vtkAbstractCellLocator::FindCell;
 
   /**
    * Take the passed line segment and intersect it with the data set.
@@ -120,6 +121,27 @@ public:
                         double& t, double x[3], double pcoords[3],
                         int &subId, vtkIdType &cellId, vtkGenericCell *cell) override;
 
+  /**
+   * Find the cell containing the given point, or return -1. A cell is
+   * accepted when the point evaluates inside it within tol2. Only the
+   * passed cell is modified, so that concurrent calls are safe once the
+   * tree has been built.
+   */
+  vtkIdType FindCell(double x[3], double tol2, vtkGenericCell *cell,
+                     double pcoords[3], double *weights) override;
+
+  //@{
+  /**
+   * Batched queries, see vtkAbstractCellLocator. FindCells() and
+   * IntersectWithLines() issue their queries in parallel with vtkSMPTools,
+   * since FindCell() and IntersectWithLine() are thread safe once the tree
+   * is built.
+   */
+  void FindCells(vtkPoints *points, vtkIdList *cellIds) override;
+  void IntersectWithLines(vtkPoints *starts, vtkPoints *ends, double tol,
+                          vtkPoints *points, vtkIdList *cellIds) override;
+  //@}
+
   /**
    * Compute an OBB from the list of points given. Return the corner point
    * and the three axes defining the orientation of the OBB. Also return
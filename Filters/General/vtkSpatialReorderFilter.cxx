@@ -0,0 +1,646 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpatialReorderFilter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpatialReorderFilter.h"
+
+#include "vtkArrayListTemplate.h" // For processing attribute data
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <vector>
+
+vtkStandardNewMacro(vtkSpatialReorderFilter);
+
+namespace { //anonymous
+
+// The curves have 2^21 steps along each axis so that a key fits in 63 bits.
+const double CurveSteps = 2097151.0;
+
+//----------------------------------------------------------------------------
+// Interleave the lower 21 bits of i with two zero bits after each bit.
+inline vtkTypeUInt64 SpreadBits(vtkTypeUInt64 i)
+{
+  i &= 0x1fffff;
+  i = (i | (i << 32)) & 0x1f00000000ffffULL;
+  i = (i | (i << 16)) & 0x1f0000ff0000ffULL;
+  i = (i | (i << 8)) & 0x100f00f00f00f00fULL;
+  i = (i | (i << 4)) & 0x10c30c30c30c30c3ULL;
+  i = (i | (i << 2)) & 0x1249249249249249ULL;
+  return i;
+}
+
+//----------------------------------------------------------------------------
+// Index of a point along the Hilbert curve, from its coordinates quantized
+// on 21 bits. This is Skilling's algorithm ("Programming the Hilbert curve",
+// AIP Conf. Proc. 707, 2004): the coordinates are transformed in place into
+// the "transposed" Hilbert index, whose bits are then interleaved.
+inline vtkTypeUInt64 HilbertIndex(vtkTypeUInt64 X[3])
+{
+  const vtkTypeUInt64 M = static_cast<vtkTypeUInt64>(1) << 20;
+  vtkTypeUInt64 P, Q, t;
+
+  // Inverse undo
+  for (Q = M; Q > 1; Q >>= 1)
+  {
+    P = Q - 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (X[i] & Q)
+      {
+        X[0] ^= P; // invert
+      }
+      else
+      {
+        t = (X[0] ^ X[i]) & P; // exchange
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  X[1] ^= X[0];
+  X[2] ^= X[1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+  {
+    if (X[2] & Q)
+    {
+      t ^= Q - 1;
+    }
+  }
+  X[0] ^= t;
+  X[1] ^= t;
+  X[2] ^= t;
+
+  return (SpreadBits(X[0]) << 2) | (SpreadBits(X[1]) << 1) | SpreadBits(X[2]);
+}
+
+//----------------------------------------------------------------------------
+// Maps a position in the bounding box of the input to its sort key.
+struct CurveMapper
+{
+  double Origin[3];
+  double Scale[3];
+  int Curve;
+
+  CurveMapper(const double bounds[6], int curve) : Curve(curve)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      double length = bounds[2*i+1] - bounds[2*i];
+      this->Origin[i] = bounds[2*i];
+      this->Scale[i] = (length > 0.0 ? CurveSteps / length : 0.0);
+    }
+  }
+
+  vtkTypeUInt64 GetKey(const double x[3]) const
+  {
+    vtkTypeUInt64 X[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      double t = (x[i] - this->Origin[i]) * this->Scale[i];
+      t = (t < 0.0 ? 0.0 : (t > CurveSteps ? CurveSteps : t));
+      X[i] = static_cast<vtkTypeUInt64>(t);
+    }
+    if (this->Curve == vtkSpatialReorderFilter::HILBERT_CURVE)
+    {
+      return HilbertIndex(X);
+    }
+    return (SpreadBits(X[2]) << 2) | (SpreadBits(X[1]) << 1) | SpreadBits(X[0]);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Once sorted, an array of SortKey maps the new ids to the old ids. Ties are
+// broken with the ids so that the ordering does not depend on the sort.
+struct SortKey
+{
+  vtkTypeUInt64 Key;
+  vtkIdType Id;
+
+  bool operator<(const SortKey& other) const
+  {
+    return this->Key < other.Key ||
+      (this->Key == other.Key && this->Id < other.Id);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Compute the sort keys of the points.
+struct ComputePointKeys
+{
+  vtkPoints *Points;
+  const CurveMapper *Mapper;
+  SortKey *Keys;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      this->Keys[ptId].Key = this->Mapper->GetKey(x);
+      this->Keys[ptId].Id = ptId;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Compute the sort keys of a range of cells from the centers of their
+// points. Offset is the id of the first cell of the range.
+struct ComputeCellKeys
+{
+  vtkPoints *Points;
+  const CurveMapper *Mapper;
+  const vtkIdType *Connectivity;
+  const vtkIdType *Locations;
+  vtkIdType Offset;
+  SortKey *Keys;
+
+  void operator()(vtkIdType cellId, vtkIdType endCellId)
+  {
+    double x[3], center[3];
+    for ( ; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType *cell = this->Connectivity + this->Locations[cellId];
+      vtkIdType npts = cell[0];
+      center[0] = center[1] = center[2] = 0.0;
+      for (vtkIdType i = 1; i <= npts; ++i)
+      {
+        this->Points->GetPoint(cell[i], x);
+        center[0] += x[0];
+        center[1] += x[1];
+        center[2] += x[2];
+      }
+      if (npts > 0)
+      {
+        center[0] /= npts;
+        center[1] /= npts;
+        center[2] /= npts;
+      }
+      SortKey &key = this->Keys[this->Offset + cellId];
+      key.Key = this->Mapper->GetKey(center);
+      key.Id = this->Offset + cellId;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Invert the ordering into a map from the old ids to the new ids.
+struct InvertOrder
+{
+  const SortKey *Order;
+  vtkIdType *Map;
+
+  void operator()(vtkIdType newId, vtkIdType endNewId)
+  {
+    for ( ; newId < endNewId; ++newId)
+    {
+      this->Map[this->Order[newId].Id] = newId;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Copy the tuples of the input arrays to the output arrays in the new order.
+struct PermuteTuples
+{
+  ArrayList *Arrays;
+  const SortKey *Order;
+
+  void operator()(vtkIdType newId, vtkIdType endNewId)
+  {
+    for ( ; newId < endNewId; ++newId)
+    {
+      this->Arrays->Copy(this->Order[newId].Id, newId);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Write the cells in the new order, renumbering their points. The input
+// cells are given by their locations in the connectivity array; the output
+// locations have been computed beforehand. Offset is the id of the first cell
+// of the range in the ordering. Types is only used by unstructured grids.
+struct RewriteCells
+{
+  const vtkIdType *InConnectivity;
+  const vtkIdType *InLocations;
+  const unsigned char *InTypes;
+  const SortKey *Order;
+  vtkIdType Offset;
+  const vtkIdType *PointMap;
+  vtkIdType *OutConnectivity;
+  const vtkIdType *OutLocations;
+  unsigned char *OutTypes;
+
+  void operator()(vtkIdType newId, vtkIdType endNewId)
+  {
+    for ( ; newId < endNewId; ++newId)
+    {
+      vtkIdType oldId = this->Order[this->Offset + newId].Id - this->Offset;
+      const vtkIdType *inCell = this->InConnectivity + this->InLocations[oldId];
+      vtkIdType *outCell = this->OutConnectivity + this->OutLocations[newId];
+      vtkIdType npts = *outCell++ = *inCell++;
+      if (this->PointMap)
+      {
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          outCell[i] = this->PointMap[inCell[i]];
+        }
+      }
+      else
+      {
+        std::copy(inCell, inCell + npts, outCell);
+      }
+      if (this->OutTypes)
+      {
+        this->OutTypes[newId] = this->InTypes[oldId];
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Sort the ids of a dataset along the curve.
+void SortIds(std::vector<SortKey> &keys, vtkIdType begin, vtkIdType end)
+{
+  vtkSMPTools::Sort(keys.begin() + begin, keys.begin() + end);
+}
+
+//----------------------------------------------------------------------------
+// The ordering of the points or the cells when they are not reordered.
+void IdentityOrder(std::vector<SortKey> &keys)
+{
+  for (vtkIdType i = 0; i < static_cast<vtkIdType>(keys.size()); ++i)
+  {
+    keys[i].Key = 0;
+    keys[i].Id = i;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Permute the attribute arrays. The data arrays are permuted in parallel,
+// the other arrays (e.g. string arrays) serially.
+void PermuteAttributes(vtkDataSetAttributes *inData,
+  vtkDataSetAttributes *outData, const std::vector<SortKey> &order)
+{
+  vtkIdType num = static_cast<vtkIdType>(order.size());
+  outData->CopyAllocate(inData, num);
+
+  ArrayList arrays;
+  arrays.AddArrays(num, inData, outData, 0.0, false);
+  PermuteTuples permute = { &arrays, order.data() };
+  vtkSMPTools::For(0, num, permute);
+
+  vtkNew<vtkIdList> oldIds;
+  for (int i = 0; i < outData->GetNumberOfArrays(); ++i)
+  {
+    vtkAbstractArray *outArray = outData->GetAbstractArray(i);
+    vtkAbstractArray *inArray = inData->GetAbstractArray(outArray->GetName());
+    if (vtkArrayDownCast<vtkDataArray>(outArray) || !inArray)
+    {
+      continue;
+    }
+    if (oldIds->GetNumberOfIds() == 0)
+    {
+      oldIds->SetNumberOfIds(num);
+      for (vtkIdType newId = 0; newId < num; ++newId)
+      {
+        oldIds->SetId(newId, order[newId].Id);
+      }
+    }
+    outArray->SetNumberOfTuples(num);
+    inArray->GetTuples(oldIds, outArray);
+  }
+}
+
+//----------------------------------------------------------------------------
+// Record the ordering as an array of original ids.
+void AddOriginalIds(vtkDataSetAttributes *outData, const char *name,
+  const std::vector<SortKey> &order)
+{
+  vtkNew<vtkIdTypeArray> ids;
+  ids->SetName(name);
+  ids->SetNumberOfTuples(static_cast<vtkIdType>(order.size()));
+  vtkIdType *idsPtr = ids->GetPointer(0);
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    idsPtr[i] = order[i].Id;
+  }
+  outData->AddArray(ids);
+}
+
+//----------------------------------------------------------------------------
+// The locations of the cells of a vtkCellArray in its connectivity array.
+void GetCellLocations(vtkCellArray *cells, std::vector<vtkIdType> &locations)
+{
+  locations.resize(cells->GetNumberOfCells());
+  const vtkIdType *conn = cells->GetPointer();
+  vtkIdType loc = 0;
+  for (size_t i = 0; i < locations.size(); ++i)
+  {
+    locations[i] = loc;
+    loc += conn[loc] + 1;
+  }
+}
+
+//----------------------------------------------------------------------------
+// Prefix sum of the sizes of the cells in the new order, giving their
+// locations in the output connectivity array. Returns the size of the
+// connectivity array.
+vtkIdType GetNewCellLocations(const vtkIdType *conn, const vtkIdType *locations,
+  const SortKey *order, vtkIdType offset, vtkIdType numCells,
+  vtkIdType *newLocations)
+{
+  vtkIdType loc = 0;
+  for (vtkIdType newId = 0; newId < numCells; ++newId)
+  {
+    newLocations[newId] = loc;
+    loc += conn[locations[order[offset + newId].Id - offset]] + 1;
+  }
+  return loc;
+}
+
+} //anonymous namespace
+
+//================= Begin class proper =======================================
+//----------------------------------------------------------------------------
+vtkSpatialReorderFilter::vtkSpatialReorderFilter()
+{
+  this->Curve = HILBERT_CURVE;
+  this->ReorderPoints = true;
+  this->ReorderCells = true;
+  this->GenerateOriginalIds = false;
+}
+
+//----------------------------------------------------------------------------
+vtkSpatialReorderFilter::~vtkSpatialReorderFilter() = default;
+
+//----------------------------------------------------------------------------
+int vtkSpatialReorderFilter::RequestData(
+  vtkInformation *vtkNotUsed(request),
+  vtkInformationVector **inputVector,
+  vtkInformationVector *outputVector)
+{
+  vtkPointSet *input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet *output = vtkPointSet::GetData(outputVector);
+  if (!input || !output)
+  {
+    return 0;
+  }
+
+  vtkPolyData *inPoly = vtkPolyData::SafeDownCast(input);
+  vtkUnstructuredGrid *inGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  vtkPoints *inPts = input->GetPoints();
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkIdType numCells = input->GetNumberOfCells();
+  if (!inPts || numPts < 1 || (!inPoly && !inGrid))
+  {
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  double bounds[6];
+  input->GetBounds(bounds);
+  CurveMapper mapper(bounds, this->Curve);
+
+  // Sort the points along the curve
+  std::vector<SortKey> pointOrder(numPts);
+  std::vector<vtkIdType> pointMap;
+  if (this->ReorderPoints)
+  {
+    ComputePointKeys keys = { inPts, &mapper, pointOrder.data() };
+    vtkSMPTools::For(0, numPts, keys);
+    SortIds(pointOrder, 0, numPts);
+    pointMap.resize(numPts);
+    InvertOrder invert = { pointOrder.data(), pointMap.data() };
+    vtkSMPTools::For(0, numPts, invert);
+  }
+  else
+  {
+    IdentityOrder(pointOrder);
+  }
+  const vtkIdType *ptMap = (pointMap.empty() ? nullptr : pointMap.data());
+  this->UpdateProgress(0.25);
+
+  // The cells are stored in one connectivity array for unstructured grids,
+  // and in four (vertices, lines, polygons, strips) for polydata. Each
+  // array is reordered separately.
+  std::vector<SortKey> cellOrder(numCells);
+  IdentityOrder(cellOrder);
+  vtkCellArray *inCells[4] = { nullptr, nullptr, nullptr, nullptr };
+  std::vector<vtkIdType> inLocations[4];
+  int numBlocks = 0;
+  if (inGrid)
+  {
+    // A grid without cells has no cell arrays, only its points are reordered
+    if (numCells > 0)
+    {
+      inCells[numBlocks++] = inGrid->GetCells();
+      vtkIdTypeArray *locations = inGrid->GetCellLocationsArray();
+      inLocations[0].assign(locations->GetPointer(0),
+                            locations->GetPointer(0) + numCells);
+    }
+  }
+  else
+  {
+    inCells[numBlocks++] = inPoly->GetVerts();
+    inCells[numBlocks++] = inPoly->GetLines();
+    inCells[numBlocks++] = inPoly->GetPolys();
+    inCells[numBlocks++] = inPoly->GetStrips();
+    for (int b = 0; b < numBlocks; ++b)
+    {
+      GetCellLocations(inCells[b], inLocations[b]);
+    }
+  }
+
+  vtkIdType offset = 0;
+  for (int b = 0; b < numBlocks; ++b)
+  {
+    vtkIdType numBlockCells = static_cast<vtkIdType>(inLocations[b].size());
+    if (this->ReorderCells && numBlockCells > 0)
+    {
+      ComputeCellKeys keys = { inPts, &mapper, inCells[b]->GetPointer(),
+        inLocations[b].data(), offset, cellOrder.data() };
+      vtkSMPTools::For(0, numBlockCells, keys);
+      SortIds(cellOrder, offset, offset + numBlockCells);
+    }
+    offset += numBlockCells;
+  }
+  this->UpdateProgress(0.5);
+
+  // Rewrite the connectivity
+  offset = 0;
+  vtkSmartPointer<vtkCellArray> outCells[4];
+  vtkNew<vtkIdTypeArray> outLocations;
+  vtkNew<vtkUnsignedCharArray> outTypes;
+  for (int b = 0; b < numBlocks; ++b)
+  {
+    vtkIdType numBlockCells = static_cast<vtkIdType>(inLocations[b].size());
+    const vtkIdType *inConn = inCells[b]->GetPointer();
+    std::vector<vtkIdType> newLocations;
+    vtkIdType *newLocs;
+    if (inGrid)
+    {
+      outLocations->SetNumberOfTuples(numBlockCells);
+      outTypes->SetNumberOfTuples(numBlockCells);
+      newLocs = outLocations->GetPointer(0);
+    }
+    else
+    {
+      newLocations.resize(numBlockCells);
+      newLocs = newLocations.data();
+    }
+    vtkIdType size = GetNewCellLocations(inConn, inLocations[b].data(),
+      cellOrder.data(), offset, numBlockCells, newLocs);
+
+    outCells[b] = vtkSmartPointer<vtkCellArray>::New();
+    vtkIdType *outConn = outCells[b]->WritePointer(numBlockCells, size);
+    RewriteCells rewrite = { inConn, inLocations[b].data(),
+      (inGrid ? inGrid->GetCellTypesArray()->GetPointer(0) : nullptr),
+      cellOrder.data(), offset, ptMap, outConn, newLocs,
+      (inGrid ? outTypes->GetPointer(0) : nullptr) };
+    vtkSMPTools::For(0, numBlockCells, rewrite);
+    offset += numBlockCells;
+  }
+  this->UpdateProgress(0.75);
+
+  if (inGrid && numBlocks > 0)
+  {
+    vtkUnstructuredGrid *outGrid = vtkUnstructuredGrid::SafeDownCast(output);
+    vtkIdTypeArray *inFaces = inGrid->GetFaces();
+    if (inFaces)
+    {
+      // Polyhedra also list their faces: (numFaces, numFace0Pts, id0, id1,
+      // ..., numFace1Pts, ...). These are rare, so they are copied serially.
+      vtkIdTypeArray *inFaceLocations = inGrid->GetFaceLocations();
+      vtkNew<vtkIdTypeArray> outFaces;
+      vtkNew<vtkIdTypeArray> outFaceLocations;
+      outFaceLocations->SetNumberOfTuples(numCells);
+      for (vtkIdType newId = 0; newId < numCells; ++newId)
+      {
+        vtkIdType loc = inFaceLocations->GetValue(cellOrder[newId].Id);
+        if (loc < 0)
+        {
+          outFaceLocations->SetValue(newId, -1);
+          continue;
+        }
+        outFaceLocations->SetValue(newId, outFaces->GetNumberOfTuples());
+        const vtkIdType *face = inFaces->GetPointer(loc);
+        vtkIdType numFaces = *face++;
+        outFaces->InsertNextValue(numFaces);
+        for (vtkIdType f = 0; f < numFaces; ++f)
+        {
+          vtkIdType npts = *face++;
+          outFaces->InsertNextValue(npts);
+          for (vtkIdType i = 0; i < npts; ++i, ++face)
+          {
+            outFaces->InsertNextValue(ptMap ? ptMap[*face] : *face);
+          }
+        }
+      }
+      outGrid->SetCells(outTypes, outLocations, outCells[0],
+                        outFaceLocations, outFaces);
+    }
+    else
+    {
+      outGrid->SetCells(outTypes, outLocations, outCells[0]);
+    }
+  }
+  else if (inPoly)
+  {
+    vtkPolyData *outPoly = vtkPolyData::SafeDownCast(output);
+    outPoly->SetVerts(outCells[0]);
+    outPoly->SetLines(outCells[1]);
+    outPoly->SetPolys(outCells[2]);
+    outPoly->SetStrips(outCells[3]);
+  }
+
+  // Permute the points and the attributes
+  if (ptMap)
+  {
+    vtkNew<vtkPoints> outPts;
+    ArrayList points;
+    vtkStdString name(inPts->GetData()->GetName() ?
+                      inPts->GetData()->GetName() : "");
+    outPts->SetData(
+      points.AddArrayPair(numPts, inPts->GetData(), name, 0.0, false));
+    PermuteTuples permute = { &points, pointOrder.data() };
+    vtkSMPTools::For(0, numPts, permute);
+    output->SetPoints(outPts);
+    PermuteAttributes(input->GetPointData(), output->GetPointData(),
+                      pointOrder);
+  }
+  else
+  {
+    output->SetPoints(inPts);
+    output->GetPointData()->PassData(input->GetPointData());
+  }
+  if (this->ReorderCells)
+  {
+    PermuteAttributes(input->GetCellData(), output->GetCellData(), cellOrder);
+  }
+  else
+  {
+    output->GetCellData()->PassData(input->GetCellData());
+  }
+  output->GetFieldData()->PassData(input->GetFieldData());
+
+  if (this->GenerateOriginalIds)
+  {
+    AddOriginalIds(output->GetPointData(), "vtkOriginalPointIds", pointOrder);
+    AddOriginalIds(output->GetCellData(), "vtkOriginalCellIds", cellOrder);
+  }
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpatialReorderFilter::FillInputPortInformation(
+  int vtkNotUsed(port), vtkInformation *info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpatialReorderFilter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Curve: "
+     << (this->Curve == HILBERT_CURVE ? "Hilbert\n" : "Morton\n");
+  os << indent << "Reorder Points: "
+     << (this->ReorderPoints ? "On\n" : "Off\n");
+  os << indent << "Reorder Cells: "
+     << (this->ReorderCells ? "On\n" : "Off\n");
+  os << indent << "Generate Original Ids: "
+     << (this->GenerateOriginalIds ? "On\n" : "Off\n");
+}
@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpatialReorderFilter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpatialReorderFilter
+ * @brief   reorder points and cells along a space-filling curve
+ *
+ * vtkSpatialReorderFilter renumbers the points and the cells of a
+ * vtkPolyData or a vtkUnstructuredGrid so that entities close in space
+ * are also close in memory. The points are sorted along a Hilbert or a
+ * Morton (Z-order) curve running through the bounding box of the input,
+ * and the cells are sorted along the same curve using the centers of their
+ * points. The connectivity is rewritten to refer to the new point ids, and
+ * all the point and cell attribute arrays are permuted accordingly. The
+ * geometry and topology of the data are otherwise unchanged.
+ *
+ * Meshes produced by mesh generators often come with an essentially random
+ * ordering of points and cells, which makes every downstream algorithm
+ * (locators, surface extraction, attribute interpolation, rendering) jump
+ * around in memory. Reordering such a mesh once makes these algorithms
+ * much more cache friendly.
+ *
+ * The Hilbert curve has better locality than the Morton curve (it never
+ * jumps between distant regions of space) at a slightly higher cost to
+ * compute the sort keys. The curves are traversed with 2^21 steps along
+ * each axis.
+ *
+ * Optionally the permutation may be recorded in the output as the
+ * vtkIdTypeArrays "vtkOriginalPointIds" (point data) and
+ * "vtkOriginalCellIds" (cell data), which give the input id of each output
+ * point and cell.
+ *
+ * @warning
+ * vtkPolyData stores its vertices, lines, polygons and triangle strips in
+ * separate cell arrays, and the cell ids follow this order. The cells are
+ * therefore reordered within each of the four cell arrays.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
+ * @sa
+ * vtkStaticCleanPolyData vtkStaticPointLocator
+ */
+
+#ifndef vtkSpatialReorderFilter_h
+#define vtkSpatialReorderFilter_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkPointSetAlgorithm.h"
+
+class VTKFILTERSGENERAL_EXPORT vtkSpatialReorderFilter : public vtkPointSetAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print, and provide type information.
+   */
+  static vtkSpatialReorderFilter *New();
+  vtkTypeMacro(vtkSpatialReorderFilter,vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  enum CurveType
+  {
+    HILBERT_CURVE = 0,
+    MORTON_CURVE = 1
+  };
+
+  //@{
+  /**
+   * Specify the space-filling curve used to order the points and cells. By
+   * default the Hilbert curve is used.
+   */
+  vtkSetClampMacro(Curve,int,HILBERT_CURVE,MORTON_CURVE);
+  vtkGetMacro(Curve,int);
+  void SetCurveToHilbert() { this->SetCurve(HILBERT_CURVE); }
+  void SetCurveToMorton() { this->SetCurve(MORTON_CURVE); }
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the reordering of the points, and of the cells. Both are on
+   * by default.
+   */
+  vtkSetMacro(ReorderPoints,vtkTypeBool);
+  vtkGetMacro(ReorderPoints,vtkTypeBool);
+  vtkBooleanMacro(ReorderPoints,vtkTypeBool);
+  vtkSetMacro(ReorderCells,vtkTypeBool);
+  vtkGetMacro(ReorderCells,vtkTypeBool);
+  vtkBooleanMacro(ReorderCells,vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off the generation of the "vtkOriginalPointIds" and
+   * "vtkOriginalCellIds" arrays, which map the output points and cells to
+   * the input ones. Off by default.
+   */
+  vtkSetMacro(GenerateOriginalIds,vtkTypeBool);
+  vtkGetMacro(GenerateOriginalIds,vtkTypeBool);
+  vtkBooleanMacro(GenerateOriginalIds,vtkTypeBool);
+  //@}
+
+protected:
+  vtkSpatialReorderFilter();
+  ~vtkSpatialReorderFilter() override;
+
+  int RequestData(vtkInformation *, vtkInformationVector **,
+                  vtkInformationVector *) override;
+  int FillInputPortInformation(int port, vtkInformation *info) override;
+
+  int Curve;
+  vtkTypeBool ReorderPoints;
+  vtkTypeBool ReorderCells;
+  vtkTypeBool GenerateOriginalIds;
+
+private:
+  vtkSpatialReorderFilter(const vtkSpatialReorderFilter&) = delete;
+  void operator=(const vtkSpatialReorderFilter&) = delete;
+};
+
+#endif
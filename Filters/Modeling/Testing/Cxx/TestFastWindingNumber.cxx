@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFastWindingNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the winding numbers computed by vtkFastWindingNumber, and check that
+// the ray casting and winding number strategies of vtkSelectEnclosedPoints
+// select the same points.
+
+#include "vtkDataArray.h"
+#include "vtkFastWindingNumber.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRandomPool.h"
+#include "vtkReverseSense.h"
+#include "vtkSelectEnclosedPoints.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+
+#include <cmath>
+
+namespace
+{
+
+int CheckWindingNumber(vtkFastWindingNumber* winding, double x[3], double expected, double tol)
+{
+  double w = winding->EvaluateWindingNumber(x);
+  if (std::abs(w - expected) > tol)
+  {
+    cerr << "Winding number at (" << x[0] << "," << x[1] << "," << x[2] << ") is " << w
+         << ", expected " << expected << endl;
+    return 1;
+  }
+  return 0;
+}
+
+}
+
+int TestFastWindingNumber(int, char*[])
+{
+  int errors = 0;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(4.5, 5.5, 5.0);
+  sphere->SetRadius(2.5);
+  sphere->SetPhiResolution(100);
+  sphere->SetThetaResolution(150);
+  sphere->Update();
+
+  // Triangles, triangle strips, and an inward oriented surface
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+  vtkNew<vtkReverseSense> reverse;
+  reverse->SetInputConnection(sphere->GetOutputPort());
+  reverse->ReverseCellsOn();
+  reverse->Update();
+
+  vtkPolyData* surfaces[3] = { sphere->GetOutput(), stripper->GetOutput(), reverse->GetOutput() };
+  double sign[3] = { 1.0, 1.0, -1.0 };
+  vtkNew<vtkFastWindingNumber> winding;
+  for (int i = 0; i < 6; ++i)
+  {
+    // A huge accuracy evaluates the exact solid angle of every triangle
+    double tol = (i < 3 ? 0.1 : 1.0e-9);
+    winding->SetAccuracy(i < 3 ? 2.0 : 1.0e6);
+    winding->BuildHierarchy(surfaces[i % 3]);
+    if (winding->GetNumberOfTriangles() != sphere->GetOutput()->GetNumberOfPolys())
+    {
+      cerr << "Wrong number of triangles: " << winding->GetNumberOfTriangles() << endl;
+      ++errors;
+    }
+    double center[3] = { 4.5, 5.5, 5.0 };
+    double nearInside[3] = { 4.5, 5.5, 7.45 };
+    double nearOutside[3] = { 4.5, 5.5, 7.55 };
+    double far[3] = { 40.0, -20.0, 5.0 };
+    errors += CheckWindingNumber(winding, center, sign[i % 3], tol);
+    errors += CheckWindingNumber(winding, nearInside, sign[i % 3], tol);
+    errors += CheckWindingNumber(winding, nearOutside, 0.0, tol);
+    errors += CheckWindingNumber(winding, far, 0.0, tol);
+    if (winding->ClassifyPoint(center) != 1 || winding->ClassifyPoint(far) != 0)
+    {
+      cerr << "Wrong classification" << endl;
+      ++errors;
+    }
+  }
+
+  // Random points in a box enclosing the sphere
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(200000);
+  vtkNew<vtkRandomPool> pool;
+  pool->PopulateDataArray(points->GetData(), 0, 1.5, 7.5);
+  pool->PopulateDataArray(points->GetData(), 1, 2.5, 8.5);
+  pool->PopulateDataArray(points->GetData(), 2, 2.0, 8.0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkSelectEnclosedPoints> select;
+  select->SetInputData(cloud);
+  select->SetSurfaceConnection(sphere->GetOutputPort());
+  select->Update();
+  vtkNew<vtkPolyData> rays;
+  rays->DeepCopy(select->GetOutput());
+
+  select->SetStrategyToWindingNumber();
+  select->Update();
+
+  vtkDataArray* rayHits = rays->GetPointData()->GetArray("SelectedPoints");
+  vtkDataArray* windingHits = select->GetOutput()->GetPointData()->GetArray("SelectedPoints");
+  vtkIdType numInside = 0, numDifferent = 0;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    numInside += (windingHits->GetTuple1(i) != 0.0 ? 1 : 0);
+    numDifferent += (windingHits->GetTuple1(i) != rayHits->GetTuple1(i) ? 1 : 0);
+  }
+  if (numDifferent > 0)
+  {
+    cerr << numDifferent << " points are classified differently" << endl;
+    ++errors;
+  }
+
+  // The fraction of points inside approximates the volume of the sphere
+  double volume = 216.0 * numInside / points->GetNumberOfPoints();
+  if (std::abs(volume - 4.0 / 3.0 * vtkMath::Pi() * 2.5 * 2.5 * 2.5) > 1.0)
+  {
+    cerr << "Unexpected enclosed volume " << volume << endl;
+    ++errors;
+  }
+
+  // The backdoor
+  select->Initialize(stripper->GetOutput());
+  if (!select->IsInsideSurface(4.5, 5.5, 5.0) || select->IsInsideSurface(4.5, 5.5, 7.55))
+  {
+    cerr << "Wrong answer from IsInsideSurface()" << endl;
+    ++errors;
+  }
+  select->Complete();
+
+  // Switching to the winding number after Initialize() casts rays instead
+  select->SetStrategyToRayCasting();
+  select->Initialize(sphere->GetOutput());
+  select->SetStrategyToWindingNumber();
+  if (!select->IsInsideSurface(4.5, 5.5, 5.0) || select->IsInsideSurface(4.5, 5.5, 7.55))
+  {
+    cerr << "Wrong answer from IsInsideSurface() after changing the strategy" << endl;
+    ++errors;
+  }
+  select->Complete();
+
+  return errors;
+}
@@ -0,0 +1,96 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRandomPolylines.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Input shared by TestRibbonAndTubeFilters and TimeRibbonAndTubeFilters:
+// random polylines carrying their point and line ids.
+
+#ifndef TestRandomPolylines_h
+#define TestRandomPolylines_h
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkIntArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <vector>
+
+namespace
+{
+
+// Random polylines of 3 to 40 points. Every tenth polyline is a closed loop
+// through the first point.
+inline void MakeLines(vtkPolyData* polyData, int numLines)
+{
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  vtkNew<vtkCellArray> lines;
+  for (int l = 0; l < numLines; ++l)
+  {
+    std::vector<vtkIdType> ids;
+    double x[3] = { 0.0, 0.0, 0.0 };
+    if (l % 10 == 0)
+    {
+      ids.push_back(0);
+    }
+    else
+    {
+      x[0] = vtkMath::Random(-10.0, 10.0);
+      x[1] = vtkMath::Random(-10.0, 10.0);
+      x[2] = vtkMath::Random(-10.0, 10.0);
+      ids.push_back(points->InsertNextPoint(x));
+    }
+    int n = 3 + l % 38;
+    for (int j = 1; j < n; ++j)
+    {
+      x[0] += vtkMath::Random(0.1, 0.5);
+      x[1] += vtkMath::Random(-0.5, 0.5);
+      x[2] += vtkMath::Random(-0.5, 0.5);
+      ids.push_back(points->InsertNextPoint(x));
+    }
+    if (l % 10 == 0)
+    {
+      ids.push_back(0);
+    }
+    lines->InsertNextCell(static_cast<vtkIdType>(ids.size()), ids.data());
+  }
+  polyData->SetPoints(points);
+  polyData->SetLines(lines);
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  pointIds->SetNumberOfTuples(points->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    pointIds->SetValue(i, i);
+  }
+  polyData->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIntArray> lineIds;
+  lineIds->SetName("LineIds");
+  lineIds->SetNumberOfTuples(numLines);
+  for (int l = 0; l < numLines; ++l)
+  {
+    lineIds->SetValue(l, l);
+  }
+  polyData->GetCellData()->AddArray(lineIds);
+}
+
+}
+
+#endif
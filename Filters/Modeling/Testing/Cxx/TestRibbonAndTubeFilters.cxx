@@ -0,0 +1,628 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRibbonAndTubeFilters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tube and ribbon many polylines, some of them closed loops sharing a
+// point, and check the size of the output, the distance of the generated
+// points to the lines, and the attributes copied to the points and cells.
+// Unless legacy code is removed, also compare the output point by point and
+// strip by strip with the former serial implementation, which is rebuilt
+// from the deprecated per-polyline helpers of the filters.
+
+#include "TestRandomPolylines.h"
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyLine.h"
+#include "vtkRibbonFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkTubeFilter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if !defined(VTK_LEGACY_REMOVE)
+
+// The serial filters call the deprecated helpers.
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER)
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4996)
+#endif
+
+// vtkTubeFilter as it was before the polylines were tubed in parallel.
+class SerialTubeFilter : public vtkTubeFilter
+{
+public:
+  static SerialTubeFilter* New();
+  vtkTypeMacro(SerialTubeFilter, vtkTubeFilter);
+
+protected:
+  SerialTubeFilter() {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkPointData* pd = input->GetPointData();
+    vtkPointData* outPD = output->GetPointData();
+    vtkCellData* cd = input->GetCellData();
+    vtkCellData* outCD = output->GetCellData();
+    vtkDataArray* inScalars = this->GetInputArrayToProcess(0, inputVector);
+    vtkDataArray* inVectors = this->GetInputArrayToProcess(1, inputVector);
+    vtkPoints* inPts = input->GetPoints();
+    vtkCellArray* inLines = input->GetLines();
+    vtkIdType numPts = inPts->GetNumberOfPoints();
+    vtkIdType numNewPts = numPts * this->NumberOfSides;
+
+    vtkNew<vtkPoints> newPts;
+    newPts->SetDataType(inPts->GetDataType());
+    newPts->Allocate(numNewPts);
+    vtkNew<vtkFloatArray> newNormals;
+    newNormals->SetName("TubeNormals");
+    newNormals->SetNumberOfComponents(3);
+    newNormals->Allocate(3 * numNewPts);
+    vtkNew<vtkCellArray> newStrips;
+    vtkNew<vtkCellArray> singlePolyline;
+
+    outPD->CopyNormalsOff();
+    vtkSmartPointer<vtkFloatArray> newTCoords;
+    if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+      this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+      this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+    {
+      newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+      newTCoords->SetNumberOfComponents(2);
+      newTCoords->Allocate(numNewPts);
+      outPD->CopyTCoordsOff();
+    }
+    outPD->CopyAllocate(pd, numNewPts);
+
+    bool generateNormals = false;
+    vtkSmartPointer<vtkDataArray> inNormals = pd->GetNormals();
+    if (!inNormals || this->UseDefaultNormal)
+    {
+      inNormals = vtkSmartPointer<vtkFloatArray>::New();
+      inNormals->SetNumberOfComponents(3);
+      inNormals->SetNumberOfTuples(numPts);
+      for (vtkIdType i = 0; this->UseDefaultNormal && i < numPts; ++i)
+      {
+        inNormals->SetTuple(i, this->DefaultNormal);
+      }
+      generateNormals = !this->UseDefaultNormal;
+    }
+
+    double range[2] = { 0.0, 1.0 }, maxSpeed = 0.0, oldRadius = this->Radius;
+    if (inScalars)
+    {
+      inScalars->GetRange(range, 0);
+      if (range[1] - range[0] == 0.0)
+      {
+        range[1] = range[0] + 1.0;
+      }
+      if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
+      {
+        this->Radius = 1.0;
+      }
+    }
+    if (inVectors)
+    {
+      maxSpeed = inVectors->GetMaxNorm();
+    }
+    outCD->CopyNormalsOff();
+    outCD->CopyAllocate(cd, inLines->GetNumberOfCells() * this->NumberOfSides + 2);
+
+    this->Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
+    vtkIdType npts, *linePts, offset = 0;
+    vtkIdType inCellId = input->GetNumberOfVerts();
+    for (inLines->InitTraversal(); inLines->GetNextCell(npts, linePts); ++inCellId)
+    {
+      // The serial filter removed the duplicate points in place
+      std::vector<vtkIdType> ids(linePts, linePts + npts);
+      ids.erase(std::unique(ids.begin(), ids.end(),
+                  [inPts](vtkIdType a, vtkIdType b) {
+                    double pa[3], pb[3];
+                    inPts->GetPoint(a, pa);
+                    inPts->GetPoint(b, pb);
+                    return pa[0] == pb[0] && pa[1] == pb[1] && pa[2] == pb[2];
+                  }),
+        ids.end());
+      npts = static_cast<vtkIdType>(ids.size());
+      vtkIdType* pts = ids.data();
+      if (npts < 2)
+      {
+        continue;
+      }
+      if (generateNormals)
+      {
+        singlePolyline->Reset();
+        singlePolyline->InsertNextCell(npts, pts);
+        vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals);
+      }
+      if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals,
+            inScalars, range, inVectors, maxSpeed, inNormals))
+      {
+        continue;
+      }
+      this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
+      offset = this->ComputeOffset(offset, npts);
+    }
+    this->Radius = oldRadius;
+
+    if (newTCoords)
+    {
+      outPD->SetTCoords(newTCoords);
+    }
+    output->SetPoints(newPts);
+    output->SetStrips(newStrips);
+    outPD->SetNormals(newNormals);
+    return 1;
+  }
+
+private:
+  SerialTubeFilter(const SerialTubeFilter&) = delete;
+  void operator=(const SerialTubeFilter&) = delete;
+};
+
+vtkStandardNewMacro(SerialTubeFilter);
+
+// vtkRibbonFilter as it was before the polylines were processed in parallel.
+class SerialRibbonFilter : public vtkRibbonFilter
+{
+public:
+  static SerialRibbonFilter* New();
+  vtkTypeMacro(SerialRibbonFilter, vtkRibbonFilter);
+
+protected:
+  SerialRibbonFilter() {}
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+    vtkPolyData* output = vtkPolyData::GetData(outputVector);
+    vtkPointData* pd = input->GetPointData();
+    vtkPointData* outPD = output->GetPointData();
+    vtkCellData* cd = input->GetCellData();
+    vtkCellData* outCD = output->GetCellData();
+    vtkDataArray* inScalars = this->GetInputArrayToProcess(0, inputVector);
+    vtkPoints* inPts = input->GetPoints();
+    vtkCellArray* inLines = input->GetLines();
+    vtkIdType numPts = inPts->GetNumberOfPoints();
+    vtkIdType numNewPts = 2 * numPts;
+
+    vtkNew<vtkPoints> newPts;
+    newPts->Allocate(numNewPts);
+    vtkNew<vtkFloatArray> newNormals;
+    newNormals->SetNumberOfComponents(3);
+    newNormals->Allocate(3 * numNewPts);
+    vtkNew<vtkCellArray> newStrips;
+    vtkNew<vtkCellArray> singlePolyline;
+
+    outPD->CopyNormalsOff();
+    vtkSmartPointer<vtkFloatArray> newTCoords;
+    if ((this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+      this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+      this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH)
+    {
+      newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+      newTCoords->SetNumberOfComponents(2);
+      newTCoords->Allocate(numNewPts);
+      outPD->CopyTCoordsOff();
+    }
+    outPD->CopyAllocate(pd, numNewPts);
+
+    bool generateNormals = false;
+    vtkSmartPointer<vtkDataArray> inNormals = this->GetInputArrayToProcess(1, inputVector);
+    if (!inNormals || this->UseDefaultNormal)
+    {
+      inNormals = vtkSmartPointer<vtkFloatArray>::New();
+      inNormals->SetNumberOfComponents(3);
+      inNormals->SetNumberOfTuples(numPts);
+      for (vtkIdType i = 0; this->UseDefaultNormal && i < numPts; ++i)
+      {
+        inNormals->SetTuple(i, this->DefaultNormal);
+      }
+      generateNormals = !this->UseDefaultNormal;
+    }
+
+    double range[2] = { 0.0, 1.0 };
+    if (this->VaryWidth && inScalars)
+    {
+      inScalars->GetRange(range, 0);
+      if (range[1] - range[0] == 0.0)
+      {
+        range[1] = range[0] + 1.0;
+      }
+    }
+    outCD->CopyNormalsOff();
+    outCD->CopyAllocate(cd, inLines->GetNumberOfCells());
+
+    this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
+    vtkIdType npts, *pts, offset = 0, inCellId = 0;
+    for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts); ++inCellId)
+    {
+      if (npts < 2)
+      {
+        continue;
+      }
+      if (generateNormals)
+      {
+        singlePolyline->Reset();
+        singlePolyline->InsertNextCell(npts, pts);
+        if (!vtkPolyLine::GenerateSlidingNormals(inPts, singlePolyline, inNormals))
+        {
+          continue;
+        }
+      }
+      if (!this->GeneratePoints(
+            offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+      {
+        continue;
+      }
+      this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
+      if (newTCoords)
+      {
+        this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      }
+      offset = this->ComputeOffset(offset, npts);
+    }
+
+    if (newTCoords)
+    {
+      outPD->SetTCoords(newTCoords);
+    }
+    output->SetPoints(newPts);
+    output->SetStrips(newStrips);
+    outPD->SetNormals(newNormals);
+    return 1;
+  }
+
+private:
+  SerialRibbonFilter(const SerialRibbonFilter&) = delete;
+  void operator=(const SerialRibbonFilter&) = delete;
+};
+
+vtkStandardNewMacro(SerialRibbonFilter);
+
+#endif
+
+namespace
+{
+
+// Check that each output point lies at the given distance of the input
+// point it was generated from, and that its normal is a unit vector. The
+// ribbon points are single precision.
+int CheckPoints(vtkPolyData* input, vtkPolyData* output, double distance, const char* label)
+{
+  vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  if (!pointIds || !normals || normals->GetNumberOfTuples() != output->GetNumberOfPoints())
+  {
+    cerr << label << ": missing point ids or normals" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    double x[3], p[3], n[3];
+    output->GetPoint(i, x);
+    input->GetPoint(static_cast<vtkIdType>(pointIds->GetTuple1(i)), p);
+    normals->GetTuple(i, n);
+    if (std::abs(std::sqrt(vtkMath::Distance2BetweenPoints(x, p)) - distance) > 1.0e-5 ||
+      std::abs(vtkMath::Norm(n) - 1.0) > 1.0e-6)
+    {
+      cerr << label << ": wrong point or normal " << i << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+
+#if !defined(VTK_LEGACY_REMOVE)
+// Check that two arrays hold the same values.
+bool SameValues(vtkDataArray* a, vtkDataArray* b)
+{
+  if (!a || !b)
+  {
+    return a == b;
+  }
+  int numComp = a->GetNumberOfComponents();
+  if (b->GetNumberOfComponents() != numComp || b->GetNumberOfTuples() != a->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < numComp; ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Check that the named arrays of the serial output are in the output with
+// the same values.
+bool SameArrays(vtkDataSetAttributes* serial, vtkDataSetAttributes* output)
+{
+  for (int a = 0; a < serial->GetNumberOfArrays(); ++a)
+  {
+    const char* name = serial->GetArrayName(a);
+    if (name && !SameValues(serial->GetArray(a), output->GetArray(name)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Compare the output of a filter with the output of its serial version,
+// point by point and strip by strip.
+int CompareWithSerial(vtkPolyData* serial, vtkPolyData* output, const char* label)
+{
+  if (!serial->GetPoints() || !output->GetPoints() ||
+    !SameValues(serial->GetPoints()->GetData(), output->GetPoints()->GetData()))
+  {
+    cerr << label << ": the points differ from the serial filter" << endl;
+    return 1;
+  }
+  vtkPointData* serialPD = serial->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  if (!SameValues(serialPD->GetNormals(), outPD->GetNormals()) ||
+    !SameValues(serialPD->GetTCoords(), outPD->GetTCoords()) || !SameArrays(serialPD, outPD))
+  {
+    cerr << label << ": the point data differs from the serial filter" << endl;
+    return 1;
+  }
+  if (!SameArrays(serial->GetCellData(), output->GetCellData()))
+  {
+    cerr << label << ": the cell data differs from the serial filter" << endl;
+    return 1;
+  }
+
+  vtkCellArray* serialStrips = serial->GetStrips();
+  vtkCellArray* strips = output->GetStrips();
+  if (serialStrips->GetNumberOfCells() != strips->GetNumberOfCells())
+  {
+    cerr << label << ": " << strips->GetNumberOfCells() << " strips instead of "
+         << serialStrips->GetNumberOfCells() << endl;
+    return 1;
+  }
+  vtkIdType serialNpts, *serialPts, npts, *pts;
+  serialStrips->InitTraversal();
+  strips->InitTraversal();
+  for (vtkIdType i = 0; serialStrips->GetNextCell(serialNpts, serialPts); ++i)
+  {
+    strips->GetNextCell(npts, pts);
+    if (npts != serialNpts || !std::equal(pts, pts + npts, serialPts))
+    {
+      cerr << label << ": strip " << i << " differs from the serial filter" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Compare the tubes and ribbons of lines with varying scalars and vectors
+// with the serial filters.
+int TestAgainstSerialFilters()
+{
+  int errors = 0;
+  vtkNew<vtkPolyData> input;
+  MakeLines(input, 500);
+  vtkIdType numPts = input->GetNumberOfPoints();
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    scalars->SetValue(i, vtkMath::Random(0.02, 0.08));
+    vectors->SetTuple3(
+      i, vtkMath::Random(0.5, 1.0), vtkMath::Random(-1.0, 1.0), vtkMath::Random(-1.0, 1.0));
+  }
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  struct
+  {
+    int VaryRadius;
+    bool SidesShareVertices;
+    bool Capping;
+    int GenerateTCoords;
+    int OnRatio;
+    int Offset;
+    bool UseDefaultNormal;
+  } tubeCases[] = {
+    { VTK_VARY_RADIUS_OFF, true, true, VTK_TCOORDS_FROM_NORMALIZED_LENGTH, 1, 0, false },
+    { VTK_VARY_RADIUS_BY_SCALAR, false, true, VTK_TCOORDS_FROM_LENGTH, 1, 0, false },
+    { VTK_VARY_RADIUS_BY_VECTOR, true, false, VTK_TCOORDS_FROM_SCALARS, 2, 1, false },
+    { VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR, false, true, VTK_TCOORDS_FROM_SCALARS, 1, 0, false },
+    { VTK_VARY_RADIUS_OFF, true, true, VTK_TCOORDS_OFF, 1, 0, true }
+  };
+  vtkNew<vtkTubeFilter> tube;
+  vtkNew<SerialTubeFilter> serialTube;
+  vtkTubeFilter* tubes[2] = { tube, serialTube };
+  for (const auto& c : tubeCases)
+  {
+    for (vtkTubeFilter* t : tubes)
+    {
+      t->SetInputData(input);
+      t->SetNumberOfSides(7);
+      t->SetRadius(0.05);
+      t->SetVaryRadius(c.VaryRadius);
+      t->SetSidesShareVertices(c.SidesShareVertices);
+      t->SetCapping(c.Capping);
+      t->SetGenerateTCoords(c.GenerateTCoords);
+      t->SetTextureLength(0.5);
+      t->SetOnRatio(c.OnRatio);
+      t->SetOffset(c.Offset);
+      t->SetUseDefaultNormal(c.UseDefaultNormal);
+      t->SetDefaultNormal(0.0, 0.0, 1.0);
+      t->Update();
+    }
+    errors += CompareWithSerial(serialTube->GetOutput(), tube->GetOutput(), "Tubes");
+  }
+
+  struct
+  {
+    bool VaryWidth;
+    int GenerateTCoords;
+    bool UseDefaultNormal;
+    double Angle;
+  } ribbonCases[] = { { false, VTK_TCOORDS_OFF, false, 30.0 },
+    { true, VTK_TCOORDS_FROM_SCALARS, false, 0.0 },
+    { false, VTK_TCOORDS_FROM_NORMALIZED_LENGTH, true, 45.0 },
+    { false, VTK_TCOORDS_FROM_LENGTH, false, 90.0 } };
+  vtkNew<vtkRibbonFilter> ribbon;
+  vtkNew<SerialRibbonFilter> serialRibbon;
+  vtkRibbonFilter* ribbons[2] = { ribbon, serialRibbon };
+  for (const auto& c : ribbonCases)
+  {
+    for (vtkRibbonFilter* r : ribbons)
+    {
+      r->SetInputData(input);
+      r->SetWidth(0.05);
+      r->SetVaryWidth(c.VaryWidth);
+      r->SetGenerateTCoords(c.GenerateTCoords);
+      r->SetTextureLength(0.5);
+      r->SetUseDefaultNormal(c.UseDefaultNormal);
+      r->SetDefaultNormal(0.0, 0.0, 1.0);
+      r->SetAngle(c.Angle);
+      r->Update();
+    }
+    errors += CompareWithSerial(serialRibbon->GetOutput(), ribbon->GetOutput(), "Ribbons");
+  }
+  return errors;
+}
+#endif
+
+}
+
+int TestRibbonAndTubeFilters(int, char*[])
+{
+  int errors = 0;
+  const int numLines = 20000;
+  const int numSides = 6;
+
+  vtkNew<vtkPolyData> input;
+  MakeLines(input, numLines);
+  vtkIdType numInputIds = input->GetLines()->GetNumberOfConnectivityEntries() - numLines;
+
+  vtkNew<vtkTubeFilter> tube;
+  tube->SetInputData(input);
+  tube->SetNumberOfSides(numSides);
+  tube->SetRadius(0.05);
+  tube->CappingOn();
+  tube->SetGenerateTCoordsToNormalizedLength();
+  tube->Update();
+
+  vtkPolyData* tubes = tube->GetOutput();
+  vtkDataArray* lineIds = tubes->GetCellData()->GetArray("LineIds");
+  if (tubes->GetNumberOfPoints() != numSides * numInputIds + 2 * numSides * numLines ||
+    tubes->GetNumberOfCells() != (numSides + 2) * numLines || !lineIds ||
+    !tubes->GetPointData()->GetTCoords())
+  {
+    cerr << "Wrong tubes" << endl;
+    ++errors;
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < tubes->GetNumberOfCells(); ++i)
+    {
+      if (lineIds->GetTuple1(i) != i / (numSides + 2))
+      {
+        cerr << "Wrong cell data for tube strip " << i << endl;
+        ++errors;
+        break;
+      }
+    }
+    errors += CheckPoints(input, tubes, 0.05, "Tubes");
+  }
+
+  vtkNew<vtkRibbonFilter> ribbon;
+  ribbon->SetInputData(input);
+  ribbon->SetWidth(0.05);
+  ribbon->SetAngle(30.0);
+  ribbon->Update();
+
+  vtkPolyData* ribbons = ribbon->GetOutput();
+  lineIds = ribbons->GetCellData()->GetArray("LineIds");
+  if (ribbons->GetNumberOfPoints() != 2 * numInputIds || ribbons->GetNumberOfCells() != numLines ||
+    !lineIds)
+  {
+    cerr << "Wrong ribbons" << endl;
+    ++errors;
+  }
+  else
+  {
+    for (vtkIdType i = 0; i < ribbons->GetNumberOfCells(); ++i)
+    {
+      if (lineIds->GetTuple1(i) != i)
+      {
+        cerr << "Wrong cell data for ribbon " << i << endl;
+        ++errors;
+        break;
+      }
+    }
+    errors += CheckPoints(input, ribbons, 0.05, "Ribbons");
+  }
+
+  // Duplicate points are skipped by the tube filter, without modifying the
+  // input lines.
+  vtkIdType ids[5] = { 1, 2, 2, 3, 3 };
+  vtkNew<vtkCellArray> duplicates;
+  duplicates->InsertNextCell(5, ids);
+  vtkNew<vtkPolyData> duplicateInput;
+  duplicateInput->SetPoints(input->GetPoints());
+  duplicateInput->SetLines(duplicates);
+  tube->CappingOff();
+  tube->SetInputData(duplicateInput);
+  tube->Update();
+  vtkIdType npts, *pts;
+  duplicates->InitTraversal();
+  duplicates->GetNextCell(npts, pts);
+  if (tube->GetOutput()->GetNumberOfPoints() != 3 * numSides || npts != 5 || pts[2] != 2 ||
+    pts[4] != 3)
+  {
+    cerr << "Wrong tube with duplicate points" << endl;
+    ++errors;
+  }
+
+#if !defined(VTK_LEGACY_REMOVE)
+  // The serial filters warn about their use of the deprecated helpers
+  vtkObject::GlobalWarningDisplayOff();
+  errors += TestAgainstSerialFilters();
+  vtkObject::GlobalWarningDisplayOn();
+#endif
+
+  return errors;
+}
@@ -0,0 +1,61 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeRibbonAndTubeFilters.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time vtkTubeFilter and vtkRibbonFilter, which process the polylines in
+// parallel, on random polylines of 3 to 40 points. This timing driver is
+// not run by ctest; run it with
+//   vtkFiltersModelingCxxTests TimeRibbonAndTubeFilters [lines]
+// The default is 200000 polylines.
+
+#include "TestRandomPolylines.h"
+
+#include "vtkRibbonFilter.h"
+#include "vtkSMPTools.h"
+#include "vtkTimerLog.h"
+#include "vtkTubeFilter.h"
+
+#include <cstdlib>
+
+int TimeRibbonAndTubeFilters(int argc, char* argv[])
+{
+  int numLines = (argc > 1 ? atoi(argv[1]) : 200000);
+  vtkNew<vtkPolyData> input;
+  MakeLines(input, numLines);
+
+  cout << "Timing " << numLines << " polylines of " << input->GetNumberOfPoints()
+       << " points, " << vtkSMPTools::GetEstimatedNumberOfThreads() << " threads\n";
+
+  vtkNew<vtkTubeFilter> tube;
+  tube->SetInputData(input);
+  tube->SetNumberOfSides(6);
+  tube->SetRadius(0.05);
+  tube->CappingOn();
+  tube->SetGenerateTCoordsToNormalizedLength();
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  tube->Update();
+  timer->StopTimer();
+  cout << "Tubes: " << timer->GetElapsedTime() << " s\n";
+
+  vtkNew<vtkRibbonFilter> ribbon;
+  ribbon->SetInputData(input);
+  ribbon->SetWidth(0.05);
+  ribbon->SetAngle(30.0);
+  timer->StartTimer();
+  ribbon->Update();
+  timer->StopTimer();
+  cout << "Ribbons: " << timer->GetElapsedTime() << " s\n";
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TimeSelectEnclosedPoints.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Time the ray casting and the winding number strategies of
+// vtkSelectEnclosedPoints classifying random points against a sphere. This
+// timing driver is not run by ctest; run it with
+//   vtkFiltersModelingCxxTests TimeSelectEnclosedPoints [points] [resolution]
+// The defaults (1000000, 150) classify 10^6 points against a sphere of
+// 29400 triangles.
+
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRandomPool.h"
+#include "vtkSelectEnclosedPoints.h"
+#include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
+
+#include <cstdlib>
+
+int TimeSelectEnclosedPoints(int argc, char* argv[])
+{
+  vtkIdType numPts = (argc > 1 ? atoi(argv[1]) : 1000000);
+  int resolution = (argc > 2 ? atoi(argv[2]) : 150);
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetCenter(4.5, 5.5, 5.0);
+  sphere->SetRadius(2.5);
+  sphere->SetPhiResolution(2 * resolution / 3);
+  sphere->SetThetaResolution(resolution);
+  sphere->Update();
+
+  // Random points in a box enclosing the sphere
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkRandomPool> pool;
+  pool->PopulateDataArray(points->GetData(), 0, 1.5, 7.5);
+  pool->PopulateDataArray(points->GetData(), 1, 2.5, 8.5);
+  pool->PopulateDataArray(points->GetData(), 2, 2.0, 8.0);
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  cout << "Timing " << numPts << " points, " << sphere->GetOutput()->GetNumberOfPolys()
+       << " triangles\n";
+
+  vtkNew<vtkSelectEnclosedPoints> select;
+  select->SetInputData(cloud);
+  select->SetSurfaceConnection(sphere->GetOutputPort());
+  vtkNew<vtkTimerLog> timer;
+  for (int strategy = 0; strategy < 2; ++strategy)
+  {
+    if (strategy)
+    {
+      select->SetStrategyToWindingNumber();
+    }
+    timer->StartTimer();
+    select->Update();
+    timer->StopTimer();
+    cout << (strategy ? "Winding number" : "Ray casting") << ": " << timer->GetElapsedTime()
+         << " s\n";
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,419 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFastWindingNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFastWindingNumber.h"
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkFastWindingNumber);
+
+//----------------------------------------------------------------------------
+// The hierarchy is a binary tree of triangle clusters. The two children of a
+// node are stored next to each other; the triangles are stored in the order
+// of the leaves so that each node refers to a contiguous range of them.
+class vtkFastWindingNumberHierarchy
+{
+public:
+  struct Node
+  {
+    double Center[3]; //area weighted center of the triangles
+    double Normal[3]; //sum of the area weighted normals of the triangles
+    double Moment[9]; //sum of the (centroid - Center) x (area weighted normal) tensors
+    double Radius; //radius of the sphere about Center enclosing the triangles
+    vtkIdType Start; //range of triangles
+    vtkIdType End;
+    vtkIdType Child; //index of the first child, or -1 for a leaf
+  };
+
+  std::vector<double> Triangles; //nine coordinates per triangle
+  std::vector<Node> Nodes;
+};
+
+namespace {
+
+//----------------------------------------------------------------------------
+// Signed solid angle of the triangle (a,b,c) seen from the origin (Van
+// Oosterom and Strackee). It is positive when the triangle is oriented
+// counterclockwise seen from the origin's opposite side.
+inline double SolidAngle(const double a[3], const double b[3], const double c[3])
+{
+  double la = vtkMath::Norm(a);
+  double lb = vtkMath::Norm(b);
+  double lc = vtkMath::Norm(c);
+  double bc[3];
+  vtkMath::Cross(b,c,bc);
+  double det = vtkMath::Dot(a,bc);
+  double den = la*lb*lc + vtkMath::Dot(a,b)*lc + vtkMath::Dot(a,c)*lb + vtkMath::Dot(b,c)*la;
+  return 2.0 * atan2(det,den);
+}
+
+//----------------------------------------------------------------------------
+// Compute the centroid and the area weighted normal of each triangle.
+struct ComputeTriangleData
+{
+  const double *Triangles;
+  double *Centers;
+  double *Normals;
+
+  void operator() (vtkIdType triId, vtkIdType endTriId)
+  {
+    const double *t = this->Triangles + 9*triId;
+    double *c = this->Centers + 3*triId;
+    double *n = this->Normals + 3*triId;
+    double e1[3], e2[3];
+    for ( ; triId < endTriId; ++triId, t+=9, c+=3, n+=3 )
+    {
+      for (int i=0; i < 3; ++i)
+      {
+        c[i] = (t[i] + t[3+i] + t[6+i]) / 3.0;
+        e1[i] = t[3+i] - t[i];
+        e2[i] = t[6+i] - t[i];
+      }
+      vtkMath::Cross(e1,e2,n);
+      n[0] *= 0.5;
+      n[1] *= 0.5;
+      n[2] *= 0.5;
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Append the triangles of a cell array; polygons are fan triangulated and
+// triangle strips are unrolled keeping a consistent orientation. The sum of
+// the solid angles of a fan is that of the polygon, even if it is concave.
+void AddTriangles(vtkCellArray *cells, vtkPoints *pts, bool strips,
+                  std::vector<double> &tris)
+{
+  if ( cells == nullptr )
+  {
+    return;
+  }
+  vtkIdType npts, *ptIds;
+  double x[3][3];
+  for ( cells->InitTraversal(); cells->GetNextCell(npts,ptIds); )
+  {
+    for (vtkIdType i=0; i < npts-2; ++i)
+    {
+      vtkIdType ids[3];
+      if ( ! strips )
+      {
+        ids[0] = ptIds[0];
+        ids[1] = ptIds[i+1];
+        ids[2] = ptIds[i+2];
+      }
+      else if ( i % 2 == 0 )
+      {
+        ids[0] = ptIds[i];
+        ids[1] = ptIds[i+1];
+        ids[2] = ptIds[i+2];
+      }
+      else
+      {
+        ids[0] = ptIds[i+1];
+        ids[1] = ptIds[i];
+        ids[2] = ptIds[i+2];
+      }
+      for (int j=0; j < 3; ++j)
+      {
+        pts->GetPoint(ids[j],x[j]);
+        tris.insert(tris.end(), x[j], x[j]+3);
+      }
+    }
+  }
+}
+
+} //anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkFastWindingNumber::vtkFastWindingNumber()
+{
+  this->Accuracy = 2.0;
+  this->NumberOfTrianglesPerLeaf = 8;
+  this->Hierarchy = new vtkFastWindingNumberHierarchy;
+}
+
+//----------------------------------------------------------------------------
+vtkFastWindingNumber::~vtkFastWindingNumber()
+{
+  delete this->Hierarchy;
+}
+
+//----------------------------------------------------------------------------
+void vtkFastWindingNumber::Initialize()
+{
+  std::vector<double>().swap(this->Hierarchy->Triangles);
+  std::vector<vtkFastWindingNumberHierarchy::Node>().swap(this->Hierarchy->Nodes);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkFastWindingNumber::GetNumberOfTriangles()
+{
+  return static_cast<vtkIdType>(this->Hierarchy->Triangles.size() / 9);
+}
+
+//----------------------------------------------------------------------------
+void vtkFastWindingNumber::BuildHierarchy(vtkPolyData *surface)
+{
+  this->Initialize();
+  if ( surface == nullptr || surface->GetPoints() == nullptr )
+  {
+    return;
+  }
+
+  // Gather the triangles
+  std::vector<double> tris;
+  AddTriangles(surface->GetPolys(), surface->GetPoints(), false, tris);
+  AddTriangles(surface->GetStrips(), surface->GetPoints(), true, tris);
+  vtkIdType numTris = static_cast<vtkIdType>(tris.size() / 9);
+  if ( numTris == 0 )
+  {
+    return;
+  }
+
+  std::vector<double> centers(3*numTris), normals(3*numTris);
+  ComputeTriangleData triData = { tris.data(), centers.data(), normals.data() };
+  vtkSMPTools::For(0, numTris, triData);
+
+  // Build the tree top down, splitting the triangles at the median of their
+  // centroids along the longest axis of the node. Nodes are processed from
+  // a work list of node indices.
+  typedef vtkFastWindingNumberHierarchy::Node Node;
+  std::vector<Node> &nodes = this->Hierarchy->Nodes;
+  std::vector<vtkIdType> order(numTris);
+  for (vtkIdType i=0; i < numTris; ++i)
+  {
+    order[i] = i;
+  }
+  nodes.reserve(2*(numTris / this->NumberOfTrianglesPerLeaf) + 1);
+  nodes.push_back(Node());
+  nodes[0].Start = 0;
+  nodes[0].End = numTris;
+  std::vector<vtkIdType> work(1,0);
+  while ( ! work.empty() )
+  {
+    vtkIdType nodeId = work.back();
+    work.pop_back();
+    Node node = nodes[nodeId];
+    vtkIdType numNodeTris = node.End - node.Start;
+
+    // Dipole of the cluster
+    double area = 0.0, bds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+                                  -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    double mean[3] = { 0.0, 0.0, 0.0 };
+    for (int i=0; i < 3; ++i)
+    {
+      node.Center[i] = node.Normal[i] = 0.0;
+    }
+    for (vtkIdType i=node.Start; i < node.End; ++i)
+    {
+      const double *c = centers.data() + 3*order[i];
+      const double *n = normals.data() + 3*order[i];
+      double a = vtkMath::Norm(n);
+      area += a;
+      for (int j=0; j < 3; ++j)
+      {
+        node.Center[j] += a * c[j];
+        node.Normal[j] += n[j];
+        mean[j] += c[j];
+        bds[2*j] = std::min(bds[2*j], c[j]);
+        bds[2*j+1] = std::max(bds[2*j+1], c[j]);
+      }
+    }
+    for (int j=0; j < 3; ++j)
+    {
+      node.Center[j] = ( area > 0.0 ? node.Center[j] / area : mean[j] / numNodeTris );
+    }
+    double radius2 = 0.0;
+    std::fill(node.Moment, node.Moment+9, 0.0);
+    for (vtkIdType i=node.Start; i < node.End; ++i)
+    {
+      const double *t = tris.data() + 9*order[i];
+      const double *c = centers.data() + 3*order[i];
+      const double *n = normals.data() + 3*order[i];
+      for (int j=0; j < 3; ++j)
+      {
+        radius2 = std::max(radius2, vtkMath::Distance2BetweenPoints(node.Center,t+3*j));
+        for (int k=0; k < 3; ++k)
+        {
+          node.Moment[3*j+k] += (c[j] - node.Center[j]) * n[k];
+        }
+      }
+    }
+    node.Radius = sqrt(radius2);
+
+    // Split if needed
+    node.Child = -1;
+    if ( numNodeTris > this->NumberOfTrianglesPerLeaf )
+    {
+      int axis = 0;
+      for (int j=1; j < 3; ++j)
+      {
+        if ( (bds[2*j+1]-bds[2*j]) > (bds[2*axis+1]-bds[2*axis]) )
+        {
+          axis = j;
+        }
+      }
+      vtkIdType mid = node.Start + numNodeTris/2;
+      const double *cptr = centers.data();
+      std::nth_element(order.begin()+node.Start, order.begin()+mid, order.begin()+node.End,
+                       [cptr,axis](vtkIdType a, vtkIdType b)
+                       { return cptr[3*a+axis] < cptr[3*b+axis]; });
+      node.Child = static_cast<vtkIdType>(nodes.size());
+      Node left, right;
+      left.Start = node.Start;
+      left.End = right.Start = mid;
+      right.End = node.End;
+      nodes.push_back(left);
+      nodes.push_back(right);
+      work.push_back(node.Child);
+      work.push_back(node.Child+1);
+    }
+    nodes[nodeId] = node;
+  }
+
+  // Store the triangles in the order of the leaves
+  std::vector<double> &sorted = this->Hierarchy->Triangles;
+  sorted.resize(tris.size());
+  for (vtkIdType i=0; i < numTris; ++i)
+  {
+    std::copy(tris.begin()+9*order[i], tris.begin()+9*order[i]+9, sorted.begin()+9*i);
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkFastWindingNumber::EvaluateWindingNumber(const double x[3])
+{
+  bool near;
+  return this->Evaluate(x, -1.0, near);
+}
+
+//----------------------------------------------------------------------------
+// Traverse the hierarchy accumulating the solid angles. If tol >= 0, the
+// traversal stops as soon as the point is found within tol of the bounding
+// box of a triangle, and near is set. Clusters closer than tol are never
+// approximated, so that all the triangles within tol of x are visited.
+double vtkFastWindingNumber::Evaluate(const double x[3], double tol, bool &near)
+{
+  near = false;
+  const std::vector<vtkFastWindingNumberHierarchy::Node> &nodes = this->Hierarchy->Nodes;
+  if ( nodes.empty() )
+  {
+    return 0.0;
+  }
+  const double *tris = this->Hierarchy->Triangles.data();
+
+  // The tree is balanced, so the depth of the traversal is logarithmic in
+  // the number of triangles.
+  vtkIdType stack[256];
+  int top = 0;
+  stack[top++] = 0;
+  double omega = 0.0, d[3], a[3], b[3], c[3];
+  while ( top > 0 )
+  {
+    const vtkFastWindingNumberHierarchy::Node &node = nodes[stack[--top]];
+    d[0] = node.Center[0] - x[0];
+    d[1] = node.Center[1] - x[1];
+    d[2] = node.Center[2] - x[2];
+    double dist2 = vtkMath::Dot(d,d);
+    double far = std::max(this->Accuracy*node.Radius, node.Radius + tol);
+    if ( dist2 > far*far )
+    {
+      // Expand the solid angle of the cluster about its center to second
+      // order: the dipole term, plus the gradient of the dipole kernel
+      // (I/|d|^3 - 3 d d^T/|d|^5) contracted with the moment tensor.
+      const double *m = node.Moment;
+      double dist3 = dist2 * sqrt(dist2);
+      double md[3] = { m[0]*d[0] + m[1]*d[1] + m[2]*d[2],
+                       m[3]*d[0] + m[4]*d[1] + m[5]*d[2],
+                       m[6]*d[0] + m[7]*d[1] + m[8]*d[2] };
+      omega += (vtkMath::Dot(d,node.Normal) + m[0] + m[4] + m[8] -
+                3.0*vtkMath::Dot(d,md)/dist2) / dist3;
+    }
+    else if ( node.Child >= 0 )
+    {
+      stack[top++] = node.Child;
+      stack[top++] = node.Child + 1;
+    }
+    else
+    {
+      const double *t = tris + 9*node.Start;
+      for (vtkIdType i=node.Start; i < node.End; ++i, t+=9)
+      {
+        for (int j=0; j < 3; ++j)
+        {
+          a[j] = t[j] - x[j];
+          b[j] = t[3+j] - x[j];
+          c[j] = t[6+j] - x[j];
+        }
+        if ( tol >= 0.0 )
+        {
+          int j = 0;
+          while ( j < 3 && std::min(a[j],std::min(b[j],c[j])) <= tol &&
+                  std::max(a[j],std::max(b[j],c[j])) >= -tol )
+          {
+            ++j;
+          }
+          if ( j == 3 )
+          {
+            near = true;
+            return 0.5;
+          }
+        }
+        omega += SolidAngle(a,b,c);
+      }
+    }
+  }
+
+  return omega / (4.0*vtkMath::Pi());
+}
+
+//----------------------------------------------------------------------------
+int vtkFastWindingNumber::ClassifyPoint(const double x[3], double tol)
+{
+  bool near;
+  double w = fabs(this->Evaluate(x, tol, near));
+  if ( near )
+  {
+    return -1;
+  }
+  else if ( w > 0.75 )
+  {
+    return 1;
+  }
+  else if ( w < 0.25 )
+  {
+    return 0;
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkFastWindingNumber::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+
+  os << indent << "Accuracy: " << this->Accuracy << "\n";
+  os << indent << "Number Of Triangles Per Leaf: "
+     << this->NumberOfTrianglesPerLeaf << "\n";
+  os << indent << "Number Of Triangles: " << this->GetNumberOfTriangles() << "\n";
+}
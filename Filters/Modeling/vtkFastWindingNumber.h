@@ -0,0 +1,136 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFastWindingNumber.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkFastWindingNumber
+ * @brief   evaluate the winding number of a closed surface at many points
+ *
+ * vtkFastWindingNumber computes the generalized winding number of a
+ * polygonal surface at query points. The winding number is the signed solid
+ * angle subtended by the surface, divided by 4*pi: for a closed, consistently
+ * oriented surface it is 1 inside the surface and 0 outside (-1 inside if the
+ * surface is oriented inward). Polygons and triangle strips are triangulated
+ * on the fly; vertices and lines are ignored.
+ *
+ * The triangles are organized in a bounding volume hierarchy. Each node of
+ * the hierarchy stores the area weighted center, the sum of the area
+ * weighted normals and the first moment of its triangles, so that the
+ * contribution of a cluster far from the query point is approximated by a
+ * second order expansion about its center, while nearby triangles
+ * contribute their exact solid angle (Barill et al., "Fast Winding Numbers
+ * for Soups and Clouds", SIGGRAPH 2018). A cluster is
+ * considered far when its distance to the query point exceeds Accuracy times
+ * its radius. Evaluating a point thus costs O(log n) rather than O(n), and
+ * no random rays are involved.
+ *
+ * Once BuildHierarchy() has been invoked, EvaluateWindingNumber() and
+ * ClassifyPoint() are thread safe. The hierarchy keeps its own copy of the
+ * triangles and does not reference the surface.
+ *
+ * @sa
+ * vtkSelectEnclosedPoints vtkExtractEnclosedPoints
+ */
+
+#ifndef vtkFastWindingNumber_h
+#define vtkFastWindingNumber_h
+
+#include "vtkFiltersModelingModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkPolyData;
+class vtkFastWindingNumberHierarchy;
+
+class VTKFILTERSMODELING_EXPORT vtkFastWindingNumber : public vtkObject
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print, and provide type information.
+   */
+  static vtkFastWindingNumber *New();
+  vtkTypeMacro(vtkFastWindingNumber,vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the ratio between the distance of a cluster of triangles to the
+   * query point and the radius of the cluster above which the contribution
+   * of the cluster is approximated. Larger values are more accurate and
+   * slower. By default the accuracy is 2.
+   */
+  vtkSetClampMacro(Accuracy,double,1.0,VTK_DOUBLE_MAX);
+  vtkGetMacro(Accuracy,double);
+  //@}
+
+  //@{
+  /**
+   * Specify the maximum number of triangles in a leaf of the hierarchy. By
+   * default leaves hold up to 8 triangles.
+   */
+  vtkSetClampMacro(NumberOfTrianglesPerLeaf,int,1,VTK_INT_MAX);
+  vtkGetMacro(NumberOfTrianglesPerLeaf,int);
+  //@}
+
+  /**
+   * Build the hierarchy from the polygons and triangle strips of the given
+   * surface. Any previous hierarchy is discarded.
+   */
+  void BuildHierarchy(vtkPolyData *surface);
+
+  /**
+   * Release the memory used by the hierarchy.
+   */
+  void Initialize();
+
+  /**
+   * Return the number of triangles in the hierarchy.
+   */
+  vtkIdType GetNumberOfTriangles();
+
+  /**
+   * Return the winding number of the surface at the point x. This method is
+   * thread safe once the hierarchy has been built.
+   */
+  double EvaluateWindingNumber(const double x[3]);
+
+  /**
+   * Classify the point x with respect to the surface, ignoring its
+   * orientation. Return 1 if the magnitude of the winding number is above
+   * 0.75 (inside), 0 if it is below 0.25 (outside), and -1 otherwise. The
+   * latter happens for points (nearly) on the surface, or for surfaces
+   * which are not closed or not consistently oriented; the caller should
+   * then fall back to a more robust test. Points within the distance tol
+   * of the bounding box of a triangle are not classified either (-1). This
+   * method is thread safe once the hierarchy has been built.
+   */
+  int ClassifyPoint(const double x[3], double tol=0.0);
+
+protected:
+  vtkFastWindingNumber();
+  ~vtkFastWindingNumber() override;
+
+  double Accuracy;
+  int NumberOfTrianglesPerLeaf;
+
+  vtkFastWindingNumberHierarchy *Hierarchy;
+
+  double Evaluate(const double x[3], double tol, bool &near);
+
+private:
+  vtkFastWindingNumber(const vtkFastWindingNumber&) = delete;
+  void operator=(const vtkFastWindingNumber&) = delete;
+};
+
+#endif
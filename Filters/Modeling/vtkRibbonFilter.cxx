@@ -14,17 +14,26 @@
 =========================================================================*/
 #include "vtkRibbonFilter.h"
 
+#include "vtkArrayListTemplate.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
 #include "vtkMath.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolyLine.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkRibbonFilter);
 
@@ -45,6 +54,10 @@ vtkRibbonFilter::vtkRibbonFilter()
   this->GenerateTCoords = 0;
   this->TextureLength = 1.0;
 
+#if !defined(VTK_LEGACY_REMOVE)
+  this->Theta = 0.0;
+#endif
+
   // by default process active point scalars
   this->SetInputArrayToProcess(0,0,0,vtkDataObject::FIELD_ASSOCIATION_POINTS,
                                vtkDataSetAttributes::SCALARS);
@@ -57,6 +70,452 @@ vtkRibbonFilter::vtkRibbonFilter()
 vtkRibbonFilter::~vtkRibbonFilter() = default;
 
 
+namespace {
+
+// The outcome of computing the frames of a polyline.
+enum LineStatus
+{
+  LINE_TOO_SHORT,
+  LINE_VALID,
+  LINE_COINCIDENT_POINTS,
+  LINE_BAD_NORMAL
+};
+
+// Each point of a polyline has a frame made of its position, the direction
+// v across the ribbon, the ribbon normal nP, and the scale factor of the
+// width.
+const int FRAME_SIZE = 10;
+
+// Per thread buffers used to process one polyline at a time.
+struct RibbonLine
+{
+  std::vector<vtkIdType> Ids;
+  std::vector<double> Frames;
+  int NumberOfBevelWarnings;
+  double BadS[3]; //reported when the normal is parallel to the line
+  double BadN[3];
+
+  // Used to generate the normals of the polyline
+  std::vector<double> Normals;
+  std::vector<std::pair<vtkIdType,vtkIdType> > SortedIds;
+  std::vector<vtkIdType> LocalIds;
+  vtkSmartPointer<vtkPoints> LocalPoints;
+  vtkSmartPointer<vtkCellArray> LocalLine;
+  vtkSmartPointer<vtkFloatArray> LocalNormals;
+};
+
+// Polylines are processed independently of each other: a first pass
+// computes the frames of each polyline to find out which ones can be
+// ribboned, and once the output is allocated a second pass computes the
+// frames again and generates the ribbons in place.
+struct RibbonGenerator
+{
+  vtkPoints *InPts;
+  const vtkIdType *Lines;
+  const vtkIdType *LineLocations;
+  vtkDataArray *InNormals; //nullptr if generated, or if the default is used
+  bool GenerateNormals;
+  double DefaultNormal[3];
+  vtkDataArray *InScalars;
+  double Range[2];
+  double Width;
+  bool VaryWidth;
+  double WidthFactor;
+  double Theta;
+  vtkSMPThreadLocal<RibbonLine> Line;
+
+  // Compute the sliding normals of the polyline. Each polyline computes its
+  // normals independently, avoiding conflicts at shared vertices. A point
+  // repeated along the polyline (e.g. a closed loop) keeps a single normal,
+  // the last one computed for it.
+  void ComputeNormals(RibbonLine &line)
+  {
+    vtkIdType j, npts = static_cast<vtkIdType>(line.Ids.size());
+    if ( !line.LocalPoints )
+    {
+      line.LocalPoints = vtkSmartPointer<vtkPoints>::New();
+      line.LocalPoints->SetDataTypeToDouble();
+      line.LocalLine = vtkSmartPointer<vtkCellArray>::New();
+      line.LocalNormals = vtkSmartPointer<vtkFloatArray>::New();
+      line.LocalNormals->SetNumberOfComponents(3);
+    }
+
+    // Repeated points share the local id of their first occurrence
+    line.SortedIds.resize(npts);
+    for (j=0; j < npts; j++)
+    {
+      line.SortedIds[j] = std::make_pair(line.Ids[j], j);
+    }
+    std::sort(line.SortedIds.begin(), line.SortedIds.end());
+    line.LocalIds.resize(npts);
+    for (vtkIdType first=0, i=0; i < npts; i++)
+    {
+      if ( i == 0 || line.SortedIds[i].first != line.SortedIds[i-1].first )
+      {
+        first = line.SortedIds[i].second;
+      }
+      line.LocalIds[line.SortedIds[i].second] = first;
+    }
+
+    double x[3];
+    line.LocalPoints->SetNumberOfPoints(npts);
+    for (j=0; j < npts; j++)
+    {
+      this->InPts->GetPoint(line.Ids[j], x);
+      line.LocalPoints->SetPoint(j, x);
+    }
+    line.LocalLine->Reset();
+    line.LocalLine->InsertNextCell(npts, line.LocalIds.data());
+    line.LocalNormals->SetNumberOfTuples(npts);
+    vtkPolyLine::GenerateSlidingNormals(line.LocalPoints, line.LocalLine,
+                                        line.LocalNormals);
+
+    line.Normals.resize(3*npts);
+    for (j=0; j < npts; j++)
+    {
+      line.LocalNormals->GetTuple(line.LocalIds[j], line.Normals.data() + 3*j);
+    }
+  }
+
+  // Compute the frame of each point of the polyline. Use "averaged" segment
+  // to create beveled effect. Watch out for first and last points.
+  int ComputeFrames(vtkIdType lineId, RibbonLine &line)
+  {
+    const vtkIdType *cell = this->Lines + this->LineLocations[lineId];
+    vtkIdType npts = cell[0];
+    line.NumberOfBevelWarnings = 0;
+    if (npts < 2)
+    {
+      return LINE_TOO_SHORT;
+    }
+    line.Ids.assign(cell + 1, cell + 1 + npts);
+    const vtkIdType *pts = line.Ids.data();
+
+    if ( this->GenerateNormals )
+    {
+      this->ComputeNormals(line);
+    }
+    line.Frames.resize(FRAME_SIZE*npts);
+
+    vtkIdType j;
+    int i;
+    double p[3];
+    double pNext[3];
+    double sNext[3] = {0, 0, 0};
+    double sPrev[3];
+    double n[3];
+    double s[3], v[3];
+    double w[3];
+    double nP[3];
+    double sFactor=1.0;
+
+    for (j=0; j < npts; j++)
+    {
+      if ( j == 0 ) //first point
+      {
+        this->InPts->GetPoint(pts[0],p);
+        this->InPts->GetPoint(pts[1],pNext);
+        for (i=0; i<3; i++)
+        {
+          sNext[i] = pNext[i] - p[i];
+          sPrev[i] = sNext[i];
+        }
+      }
+      else if ( j == (npts-1) ) //last point
+      {
+        for (i=0; i<3; i++)
+        {
+          sPrev[i] = sNext[i];
+          p[i] = pNext[i];
+        }
+      }
+      else
+      {
+        for (i=0; i<3; i++)
+        {
+          p[i] = pNext[i];
+        }
+        this->InPts->GetPoint(pts[j+1],pNext);
+        for (i=0; i<3; i++)
+        {
+          sPrev[i] = sNext[i];
+          sNext[i] = pNext[i] - p[i];
+        }
+      }
+
+      if ( this->GenerateNormals )
+      {
+        std::copy(line.Normals.data() + 3*j, line.Normals.data() + 3*j + 3, n);
+      }
+      else if ( this->InNormals )
+      {
+        this->InNormals->GetTuple(pts[j], n);
+      }
+      else
+      {
+        std::copy(this->DefaultNormal, this->DefaultNormal + 3, n);
+      }
+
+      if ( vtkMath::Normalize(sNext) == 0.0 )
+      {
+        return LINE_COINCIDENT_POINTS;
+      }
+
+      for (i=0; i<3; i++)
+      {
+        s[i] = (sPrev[i] + sNext[i]) / 2.0; //average vector
+      }
+      // if s is zero then just use sPrev cross n
+      if (vtkMath::Normalize(s) == 0.0)
+      {
+        line.NumberOfBevelWarnings++;
+        vtkMath::Cross(sPrev,n,s);
+        if (vtkMath::Normalize(s) == 0.0)
+        {
+          line.NumberOfBevelWarnings++;
+        }
+      }
+
+      vtkMath::Cross(s,n,w);
+      if ( vtkMath::Normalize(w) == 0.0)
+      {
+        std::copy(s, s + 3, line.BadS);
+        std::copy(n, n + 3, line.BadN);
+        return LINE_BAD_NORMAL;
+      }
+
+      vtkMath::Cross(w,s,nP); //create orthogonal coordinate system
+      vtkMath::Normalize(nP);
+
+      // Compute a scale factor based on scalars or vectors
+      if ( this->InScalars && this->VaryWidth ) // varying by scalar values
+      {
+        sFactor = 1.0 + ((this->WidthFactor - 1.0) *
+                  (this->InScalars->GetComponent(pts[j],0) - this->Range[0])
+                         / (this->Range[1]-this->Range[0]));
+      }
+
+      for (i=0; i<3; i++)
+      {
+        v[i] = (w[i]*cos(this->Theta) + nP[i]*sin(this->Theta));
+      }
+
+      double *frame = line.Frames.data() + FRAME_SIZE*j;
+      std::copy(p, p + 3, frame);
+      std::copy(v, v + 3, frame + 3);
+      std::copy(nP, nP + 3, frame + 6);
+      frame[9] = sFactor;
+    }//for all points in polyline
+
+    return LINE_VALID;
+  }
+};
+
+// First pass: compute the frames of each polyline.
+struct CountRibbons
+{
+  RibbonGenerator *Ribbons;
+  unsigned char *Status;
+  int *NumberOfBevelWarnings;
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    RibbonLine &line = this->Ribbons->Line.Local();
+    for ( ; lineId < endLineId; lineId++)
+    {
+      this->Status[lineId] =
+        static_cast<unsigned char>(this->Ribbons->ComputeFrames(lineId, line));
+      this->NumberOfBevelWarnings[lineId] = line.NumberOfBevelWarnings;
+    }
+  }
+};
+
+// Second pass: generate the points, strip and texture coordinates of the
+// ribbon along each valid polyline. Attributes are copied by the array
+// lists when they are given; otherwise the input point id of each output
+// point is recorded so that the point data can be copied afterwards.
+struct GenerateRibbons
+{
+  RibbonGenerator *Ribbons;
+  const unsigned char *Status;
+  const vtkIdType *Offsets; //points (and strip entries) before each line
+  const vtkIdType *CellIds;
+  float *NewPts;
+  float *NewNormals;
+  float *NewTCoords;
+  int GenerateTCoords;
+  double TextureLength;
+  vtkIdType *NewStrips;
+  ArrayList *PointArrays;
+  ArrayList *CellArrays;
+  vtkIdType *PointIds;
+
+  void InsertPoint(vtkIdType ptId, vtkIdType inId, const double x[3],
+                   const double normal[3])
+  {
+    for (int i=0; i<3; i++)
+    {
+      this->NewPts[3*ptId+i] = static_cast<float>(x[i]);
+      this->NewNormals[3*ptId+i] = static_cast<float>(normal[i]);
+    }
+    if ( this->PointArrays )
+    {
+      this->PointArrays->Copy(inId, ptId);
+    }
+    if ( this->PointIds )
+    {
+      this->PointIds[ptId] = inId;
+    }
+  }
+
+  void GeneratePoints(vtkIdType offset, const RibbonLine &line)
+  {
+    const RibbonGenerator *ribbons = this->Ribbons;
+    vtkIdType npts = static_cast<vtkIdType>(line.Ids.size());
+    const vtkIdType *pts = line.Ids.data();
+    double sp[3], sm[3];
+    vtkIdType ptId=offset;
+
+    for (vtkIdType j=0; j < npts; j++)
+    {
+      const double *frame = line.Frames.data() + FRAME_SIZE*j;
+      const double *p = frame;
+      const double *v = frame + 3;
+      const double *nP = frame + 6;
+      double sFactor = frame[9];
+      for (int i=0; i<3; i++)
+      {
+        sp[i] = p[i] + ribbons->Width * sFactor * v[i];
+        sm[i] = p[i] - ribbons->Width * sFactor * v[i];
+      }
+      this->InsertPoint(ptId,pts[j],sm,nP);
+      ptId++;
+      this->InsertPoint(ptId,pts[j],sp,nP);
+      ptId++;
+    }//for all points in polyline
+  }
+
+  void GenerateStrip(vtkIdType offset, vtkIdType npts, vtkIdType inCellId,
+                     vtkIdType outCellId, vtkIdType *strip)
+  {
+    vtkIdType i, idx;
+
+    if ( this->CellArrays )
+    {
+      this->CellArrays->Copy(inCellId,outCellId);
+    }
+    *strip++ = npts*2;
+    for (i=0; i < npts; i++)
+    {
+      idx = 2*i;
+      *strip++ = offset+idx;
+      *strip++ = offset+idx+1;
+    }
+  }
+
+  void InsertTCoord(vtkIdType ptId, double s, double t)
+  {
+    this->NewTCoords[2*ptId] = static_cast<float>(s);
+    this->NewTCoords[2*ptId+1] = static_cast<float>(t);
+  }
+
+  void GenerateTextureCoords(vtkIdType offset, const RibbonLine &line)
+  {
+    vtkIdType npts = static_cast<vtkIdType>(line.Ids.size());
+    const vtkIdType *pts = line.Ids.data();
+    vtkPoints *inPts = this->Ribbons->InPts;
+    vtkDataArray *inScalars = this->Ribbons->InScalars;
+    vtkIdType i;
+    int k;
+    double tc;
+
+    double s0, s;
+    //The first texture coordinate is always 0.
+    for ( k=0; k < 2; k++)
+    {
+      this->InsertTCoord(offset+k,0.0,0.0);
+    }
+    if ( this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
+    {
+      s0 = inScalars->GetTuple1(pts[0]);
+      for (i=1; i < npts; i++)
+      {
+        s = inScalars->GetTuple1(pts[i]);
+        tc = (s - s0) / this->TextureLength;
+        for ( k=0; k < 2; k++)
+        {
+          this->InsertTCoord(offset+i*2+k,tc,0.0);
+        }
+      }
+    }
+    else if ( this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH )
+    {
+      double xPrev[3], x[3], len=0.0;
+      inPts->GetPoint(pts[0],xPrev);
+      for (i=1; i < npts; i++)
+      {
+        inPts->GetPoint(pts[i],x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x,xPrev));
+        tc = len / this->TextureLength;
+        for ( k=0; k < 2; k++)
+        {
+          this->InsertTCoord(offset+i*2+k,tc,0.0);
+        }
+        xPrev[0]=x[0]; xPrev[1]=x[1]; xPrev[2]=x[2];
+      }
+    }
+    else if ( this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH )
+    {
+      double xPrev[3], x[3], length=0.0, len=0.0;
+      inPts->GetPoint(pts[0],xPrev);
+      for (i=1; i < npts; i++)
+      {
+        inPts->GetPoint(pts[i],x);
+        length += sqrt(vtkMath::Distance2BetweenPoints(x,xPrev));
+        xPrev[0]=x[0]; xPrev[1]=x[1]; xPrev[2]=x[2];
+      }
+
+      inPts->GetPoint(pts[0],xPrev);
+      for (i=1; i < npts; i++)
+      {
+        inPts->GetPoint(pts[i],x);
+        len += sqrt(vtkMath::Distance2BetweenPoints(x,xPrev));
+        tc = len / length;
+        for ( k=0; k < 2; k++)
+        {
+          this->InsertTCoord(offset+i*2+k,tc,0.0);
+        }
+        xPrev[0]=x[0]; xPrev[1]=x[1]; xPrev[2]=x[2];
+      }
+    }
+  }
+
+  void operator()(vtkIdType lineId, vtkIdType endLineId)
+  {
+    RibbonLine &line = this->Ribbons->Line.Local();
+    for ( ; lineId < endLineId; lineId++)
+    {
+      if ( this->Status[lineId] != LINE_VALID )
+      {
+        continue;
+      }
+      this->Ribbons->ComputeFrames(lineId, line);
+      vtkIdType offset = this->Offsets[lineId];
+      this->GeneratePoints(offset, line);
+      // Each previous strip holds its size and two ids per point
+      this->GenerateStrip(offset, static_cast<vtkIdType>(line.Ids.size()),
+                          lineId, this->CellIds[lineId],
+                          this->NewStrips + offset + this->CellIds[lineId]);
+      if ( this->NewTCoords )
+      {
+        this->GenerateTextureCoords(offset, line);
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
 int vtkRibbonFilter::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **inputVector,
@@ -84,17 +543,9 @@ int vtkRibbonFilter::RequestData(
   vtkIdType numPts;
   vtkIdType numLines;
   vtkIdType numNewPts, numNewCells;
-  vtkPoints *newPts;
-  int deleteNormals=0;
-  vtkFloatArray *newNormals;
   vtkIdType i;
   double range[2];
-  vtkCellArray *newStrips;
-  vtkIdType npts=0, *pts=nullptr;
-  vtkIdType offset=0;
-  vtkFloatArray *newTCoords=nullptr;
-  int abort=0;
-  vtkIdType inCellId;
+  vtkSmartPointer<vtkFloatArray> newTCoords;
 
   // Check input and initialize
   //
@@ -108,57 +559,38 @@ int vtkRibbonFilter::RequestData(
     return 1;
   }
 
-  // Create the geometry and topology
-  numNewPts = 2 * numPts;
-  newPts = vtkPoints::New();
-  newPts->Allocate(numNewPts);
-  newNormals = vtkFloatArray::New();
-  newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3*numNewPts);
-  newStrips = vtkCellArray::New();
-  newStrips->Allocate(newStrips->EstimateSize(1,numNewPts));
-  vtkCellArray *singlePolyline = vtkCellArray::New();
-
-  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
-  outPD->CopyNormalsOff();
-  if ( (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
-       this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
-       this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH )
-  {
-    newTCoords = vtkFloatArray::New();
-    newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
-    outPD->CopyTCoordsOff();
-  }
-  outPD->CopyAllocate(pd,numNewPts);
-
-  int generateNormals = 0;
+  RibbonGenerator ribbons;
+  ribbons.InPts = inPts;
+  ribbons.InNormals = nullptr;
+  ribbons.GenerateNormals = false;
   inNormals = this->GetInputArrayToProcess(1,inputVector);
   if ( !inNormals || this->UseDefaultNormal )
   {
-    deleteNormals = 1;
-    inNormals = vtkFloatArray::New();
-    inNormals->SetNumberOfComponents(3);
-    inNormals->SetNumberOfTuples(numPts);
-
     if ( this->UseDefaultNormal )
     {
-      for ( i=0; i < numPts; i++)
+      // The default normal used to be stored as a float
+      for (i=0; i < 3; i++)
       {
-        inNormals->SetTuple(i,this->DefaultNormal);
+        ribbons.DefaultNormal[i] = static_cast<float>(this->DefaultNormal[i]);
       }
     }
     else
     {
-      // Normal generation has been moved to lower in the function.
-      // This allows each different polylines to share vertices, but have
-      // their normals (and hence their ribbons) calculated independently
-      generateNormals = 1;
+      // Normals are generated for each polyline. This allows different
+      // polylines to share vertices, but have their normals (and hence
+      // their ribbons) calculated independently.
+      ribbons.GenerateNormals = true;
     }
   }
+  else
+  {
+    ribbons.InNormals = inNormals;
+  }
 
   // If varying width, get appropriate info.
   //
+  range[0] = 0.0;
+  range[1] = 1.0;
   if ( this->VaryWidth && inScalars )
   {
     inScalars->GetRange(range,0);
@@ -169,99 +601,177 @@ int vtkRibbonFilter::RequestData(
     }
   }
 
-  // Copy selected parts of cell data; certainly don't want normals
-  //
-  numNewCells = inLines->GetNumberOfCells();
-  outCD->CopyNormalsOff();
-  outCD->CopyAllocate(cd,numNewCells);
+  ribbons.InScalars = inScalars;
+  ribbons.Range[0] = range[0];
+  ribbons.Range[1] = range[1];
+  ribbons.Width = this->Width;
+  ribbons.VaryWidth = (this->VaryWidth != 0);
+  ribbons.WidthFactor = this->WidthFactor;
+  ribbons.Theta = vtkMath::RadiansFromDegrees( this->Angle );
+#if !defined(VTK_LEGACY_REMOVE)
+  this->Theta = ribbons.Theta;
+#endif
 
-  //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
-  //
-  this->Theta = vtkMath::RadiansFromDegrees( this->Angle );
-  vtkPolyLine *lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId=0, inLines->InitTraversal();
-       inLines->GetNextCell(npts,pts) && !abort; inCellId++)
+  // Locate the polylines in the connectivity array
+  std::vector<vtkIdType> lineLocations(numLines);
+  const vtkIdType *lines = inLines->GetPointer();
+  vtkIdType loc = 0;
+  for (i=0; i < numLines; i++)
   {
-    this->UpdateProgress((double)inCellId/numLines);
-    abort = this->GetAbortExecute();
+    lineLocations[i] = loc;
+    loc += lines[loc] + 1;
+  }
+  ribbons.Lines = lines;
+  ribbons.LineLocations = lineLocations.data();
 
-    if (npts < 2)
+  // Compute the frames along each polyline to find out which polylines can
+  // be ribboned.
+  std::vector<unsigned char> status(numLines);
+  std::vector<int> numBevelWarnings(numLines);
+  CountRibbons count;
+  count.Ribbons = &ribbons;
+  count.Status = status.data();
+  count.NumberOfBevelWarnings = numBevelWarnings.data();
+  vtkSMPTools::For(0, numLines, count);
+  this->UpdateProgress(0.5);
+  if ( this->GetAbortExecute() )
+  {
+    return 1;
+  }
+
+  // Number the points and strips of the ribbons. The strip is not created
+  // if the polyline is bad; warnings are reported in the order of the
+  // polylines.
+  std::vector<vtkIdType> offsets(numLines+1);
+  std::vector<vtkIdType> cellIds(numLines+1);
+  offsets[0] = cellIds[0] = 0;
+  RibbonLine badLine;
+  for (i=0; i < numLines; i++)
+  {
+    offsets[i+1] = offsets[i];
+    cellIds[i+1] = cellIds[i];
+    if ( status[i] == LINE_VALID )
+    {
+      offsets[i+1] += 2 * lines[lineLocations[i]];
+      cellIds[i+1]++;
+    }
+    else if ( status[i] == LINE_TOO_SHORT )
     {
       vtkWarningMacro(<< "Less than two points in line!");
-      continue; //skip tubing this polyline
     }
-
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
+    for (int k=0; k < numBevelWarnings[i]; k++)
     {
-      singlePolyline->Reset(); //avoid instantiation
-      singlePolyline->InsertNextCell(npts,pts);
-      if ( !lineNormalGenerator->GenerateSlidingNormals(inPts,singlePolyline,
-                                                        inNormals) )
-      {
-        vtkWarningMacro(<< "No normals for line!");
-        continue; //skip tubing this polyline
-      }
+      vtkWarningMacro(<< "Using alternate bevel vector");
     }
-
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if ( !this->GeneratePoints(offset,npts,pts,inPts,newPts,pd,outPD,
-                               newNormals,inScalars,range,inNormals) )
+    if ( status[i] == LINE_COINCIDENT_POINTS )
     {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; //skip ribboning this polyline
+      vtkWarningMacro(<<"Coincident points!");
     }
-
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset,npts,pts,inCellId,cd,outCD,newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if ( newTCoords )
+    else if ( status[i] == LINE_BAD_NORMAL )
     {
-      this->GenerateTextureCoords(offset,npts,pts,inPts,inScalars,newTCoords);
+      ribbons.ComputeFrames(i, badLine);
+      double *s = badLine.BadS, *n = badLine.BadN;
+      vtkWarningMacro(<<"Bad normal s = " <<s[0]<<" "<<s[1]<<" "<< s[2]
+                      << " n = " << n[0] << " " << n[1] << " " << n[2]);
     }
+    if ( status[i] != LINE_VALID && status[i] != LINE_TOO_SHORT )
+    {
+      vtkWarningMacro(<< "Could not generate points!");
+    }
+  }
+  numNewPts = offsets[numLines];
+  numNewCells = cellIds[numLines];
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset,npts);
+  // Create the geometry and topology
+  vtkNew<vtkPoints> newPts;
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkNew<vtkFloatArray> newNormals;
+  newNormals->SetNumberOfComponents(3);
+  newNormals->SetNumberOfTuples(numNewPts);
+  vtkNew<vtkCellArray> newStrips;
+  vtkIdType *strips = newStrips->WritePointer(numNewCells, numNewPts+numNewCells);
 
-  }//for all polylines
+  // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
+  outPD->CopyNormalsOff();
+  if ( (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars) ||
+       this->GenerateTCoords == VTK_TCOORDS_FROM_LENGTH ||
+       this->GenerateTCoords == VTK_TCOORDS_FROM_NORMALIZED_LENGTH )
+  {
+    newTCoords = vtkSmartPointer<vtkFloatArray>::New();
+    newTCoords->SetNumberOfComponents(2);
+    newTCoords->SetNumberOfTuples(numNewPts);
+    outPD->CopyTCoordsOff();
+  }
+  outPD->CopyAllocate(pd,numNewPts);
+  ArrayList pointArrays;
+  std::vector<vtkIdType> pointIds;
+  if ( ArrayList::CanCopyArrays(pd, outPD) )
+  {
+    pointArrays.AddArrays(numNewPts, pd, outPD, 0.0, false);
+  }
+  else
+  {
+    pointIds.resize(numNewPts);
+  }
 
-  singlePolyline->Delete();
+  // Copy selected parts of cell data; certainly don't want normals
+  //
+  outCD->CopyNormalsOff();
+  outCD->CopyAllocate(cd,numNewCells);
+  ArrayList cellArrays;
+  bool serialCellData = !ArrayList::CanCopyArrays(cd, outCD);
+  if ( !serialCellData )
+  {
+    cellArrays.AddArrays(numNewCells, cd, outCD, 0.0, false);
+  }
 
-  // Update ourselves
+  //  Create points along each polyline that are connected into a triangle
+  //  strip. Texture coordinates are optionally generated.
   //
-  if ( deleteNormals )
+  GenerateRibbons generate;
+  generate.Ribbons = &ribbons;
+  generate.Status = status.data();
+  generate.Offsets = offsets.data();
+  generate.CellIds = cellIds.data();
+  generate.NewPts = static_cast<float*>(newPts->GetVoidPointer(0));
+  generate.NewNormals = newNormals->GetPointer(0);
+  generate.NewTCoords = (newTCoords ? newTCoords->GetPointer(0) : nullptr);
+  generate.GenerateTCoords = this->GenerateTCoords;
+  generate.TextureLength = this->TextureLength;
+  generate.NewStrips = strips;
+  generate.PointArrays = (pointArrays.Arrays.empty() ? nullptr : &pointArrays);
+  generate.CellArrays = (cellArrays.Arrays.empty() ? nullptr : &cellArrays);
+  generate.PointIds = (pointIds.empty() ? nullptr : pointIds.data());
+  vtkSMPTools::For(0, numLines, generate);
+
+  // Copy the attributes which could not be copied in parallel
+  for (i=0; i < static_cast<vtkIdType>(pointIds.size()); i++)
   {
-    inNormals->Delete();
+    outPD->CopyData(pd,pointIds[i],i);
+  }
+  for (i=0; serialCellData && i < numLines; i++)
+  {
+    if ( status[i] == LINE_VALID )
+    {
+      outCD->CopyData(cd,i,cellIds[i]);
+    }
   }
 
+  // Update ourselves
+  //
   if ( newTCoords )
   {
     outPD->SetTCoords(newTCoords);
-    newTCoords->Delete();
   }
 
   output->SetPoints(newPts);
-  newPts->Delete();
-
   output->SetStrips(newStrips);
-  newStrips->Delete();
-
   outPD->SetNormals(newNormals);
-  newNormals->Delete();
-  lineNormalGenerator->Delete();
-
-  output->Squeeze();
 
   return 1;
 }
 
+#if !defined(VTK_LEGACY_REMOVE)
 int vtkRibbonFilter::GeneratePoints(vtkIdType offset,
                                   vtkIdType npts, vtkIdType *pts,
                                   vtkPoints *inPts, vtkPoints *newPts,
@@ -284,6 +794,8 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset,
   double sFactor=1.0;
   vtkIdType ptId=offset;
 
+  VTK_LEGACY_BODY(vtkRibbonFilter::GeneratePoints, "VTK 9.0");
+
   // Use "averaged" segment to create beveled effect.
   // Watch out for first and last points.
   //
@@ -406,6 +918,8 @@ void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
 {
   vtkIdType i, idx, outCellId;
 
+  VTK_LEGACY_BODY(vtkRibbonFilter::GenerateStrip, "VTK 9.0");
+
   outCellId = newStrips->InsertNextCell(npts*2);
   outCD->CopyData(cd,inCellId,outCellId);
   for (i=0; i < npts; i++)
@@ -426,6 +940,8 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset,
   int k;
   double tc;
 
+  VTK_LEGACY_BODY(vtkRibbonFilter::GenerateTextureCoords, "VTK 9.0");
+
   double s0, s;
   //The first texture coordinate is always 0.
   for ( k=0; k < 2; k++)
@@ -490,9 +1006,12 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset,
 // Compute the number of points in this ribbon
 vtkIdType vtkRibbonFilter::ComputeOffset(vtkIdType offset, vtkIdType npts)
 {
+  VTK_LEGACY_BODY(vtkRibbonFilter::ComputeOffset, "VTK 9.0");
+
   offset += 2 * npts;
   return offset;
 }
+#endif
 
 // Description:
 // Return the method of generating the texture coordinates.
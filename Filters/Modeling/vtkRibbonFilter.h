@@ -23,6 +23,11 @@
  * the local line segment. An offset angle can be specified to rotate the
  * ribbon with respect to the normal.
  *
+ * The polylines are processed in parallel (using vtkSMPTools). A first pass
+ * finds out which polylines can be ribboned, and once the output is
+ * allocated a second pass generates the ribbons in place. The output is the
+ * same as if the polylines were processed one after the other.
+ *
  * @warning
  * The input line must not have duplicate points, or normals at points that
  * are parallel to the incoming/outgoing line segments. (Duplicate points
@@ -163,22 +168,32 @@ protected:
   int GenerateTCoords; //control texture coordinate generation
   double TextureLength; //this length is mapped to [0,1) texture space
 
-  // Helper methods
-  int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
-                     vtkPoints *inPts, vtkPoints *newPts,
-                     vtkPointData *pd, vtkPointData *outPD,
-                     vtkFloatArray *newNormals, vtkDataArray *inScalars,
-                     double range[2], vtkDataArray *inNormals);
-  void GenerateStrip(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
-                     vtkIdType inCellId, vtkCellData *cd, vtkCellData *outCD,
-                     vtkCellArray *newStrips);
-  void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
-                             vtkPoints *inPts, vtkDataArray *inScalars,
-                             vtkFloatArray *newTCoords);
-  vtkIdType ComputeOffset(vtkIdType offset,vtkIdType npts);
-
-  // Helper data members
+  //@{
+  /**
+   * Helper methods of the former serial implementation, which processed one
+   * polyline at a time. RequestData() no longer calls them; it processes the
+   * polylines in parallel.
+   * @deprecated VTK 9.0. Subclasses that overrode them should override
+   * RequestData() instead.
+   */
+  VTK_LEGACY(int GeneratePoints(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                                vtkPoints *inPts, vtkPoints *newPts,
+                                vtkPointData *pd, vtkPointData *outPD,
+                                vtkFloatArray *newNormals, vtkDataArray *inScalars,
+                                double range[2], vtkDataArray *inNormals));
+  VTK_LEGACY(void GenerateStrip(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                                vtkIdType inCellId, vtkCellData *cd, vtkCellData *outCD,
+                                vtkCellArray *newStrips));
+  VTK_LEGACY(void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, vtkIdType *pts,
+                                        vtkPoints *inPts, vtkDataArray *inScalars,
+                                        vtkFloatArray *newTCoords));
+  VTK_LEGACY(vtkIdType ComputeOffset(vtkIdType offset,vtkIdType npts));
+  //@}
+
+#if !defined(VTK_LEGACY_REMOVE)
+  // Helper data member of the legacy helper methods, set by RequestData()
   double Theta;
+#endif
 
 private:
   vtkRibbonFilter(const vtkRibbonFilter&) = delete;
@@ -25,6 +25,7 @@
 #include "vtkPolyData.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkExecutive.h"
+#include "vtkFastWindingNumber.h"
 #include "vtkFeatureEdges.h"
 #include "vtkStaticCellLocator.h"
 #include "vtkGenericCell.h"
@@ -53,6 +54,7 @@ struct SelectInOutCheck
   double Length;
   double Tolerance;
   vtkStaticCellLocator *Locator;
+  vtkFastWindingNumber *Winding;
   unsigned char *Hits;
   vtkSelectEnclosedPoints *Selector;
   vtkTypeBool InsideOut;
@@ -65,9 +67,10 @@ struct SelectInOutCheck
   vtkSMPThreadLocalObject<vtkGenericCell> Cell;
 
   SelectInOutCheck(vtkIdType numPts, vtkDataSet *ds, vtkPolyData *surface, double bds[6], double tol,
-                   vtkStaticCellLocator *loc, unsigned char *hits, vtkSelectEnclosedPoints *sel,
-                   vtkTypeBool io) : NumPts(numPts), DataSet(ds), Surface(surface), Tolerance(tol),
-                               Locator(loc), Hits(hits), Selector(sel), InsideOut(io)
+                   vtkStaticCellLocator *loc, vtkFastWindingNumber *winding, unsigned char *hits,
+                   vtkSelectEnclosedPoints *sel, vtkTypeBool io) :
+    NumPts(numPts), DataSet(ds), Surface(surface), Tolerance(tol), Locator(loc),
+    Winding(winding), Hits(hits), Selector(sel), InsideOut(io)
   {
     this->Bounds[0] = bds[0];
     this->Bounds[1] = bds[1];
@@ -109,7 +112,7 @@ struct SelectInOutCheck
     {
       this->DataSet->GetPoint(ptId, x);
 
-      if ( this->Selector->IsInsideSurface(x, this->Surface, this->Bounds, this->Length,
+      if ( this->Selector->IsInsideSurface(x, this->Winding, this->Surface, this->Bounds, this->Length,
                                            this->Tolerance, this->Locator, cellIds, cell,
                                            counter, this->Sequence, ptId) )
       {
@@ -128,9 +131,10 @@ struct SelectInOutCheck
 
   static void Execute(vtkIdType numPts, vtkDataSet *ds, vtkPolyData *surface,
                       double bds[6], double tol, vtkStaticCellLocator *loc,
-                      unsigned char *hits, vtkSelectEnclosedPoints *sel)
+                      vtkFastWindingNumber *winding, unsigned char *hits,
+                      vtkSelectEnclosedPoints *sel)
   {
-    SelectInOutCheck inOut(numPts, ds, surface, bds, tol, loc, hits, sel,
+    SelectInOutCheck inOut(numPts, ds, surface, bds, tol, loc, winding, hits, sel,
                            sel->GetInsideOut());
     vtkSMPTools::For(0, numPts, inOut);
   }
@@ -148,11 +152,13 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
   this->CheckSurface = false;
   this->InsideOut = 0;
   this->Tolerance = 0.0001;
+  this->Strategy = vtkSelectEnclosedPoints::RAY_CASTING;
 
   this->InsideOutsideArray = nullptr;
 
   // These are needed to support backward compatibility
   this->CellLocator = vtkStaticCellLocator::New();
+  this->WindingNumber = vtkFastWindingNumber::New();
   this->CellIds = vtkIdList::New();
   this->Cell = vtkGenericCell::New();
 }
@@ -172,6 +178,7 @@ vtkSelectEnclosedPoints::~vtkSelectEnclosedPoints()
     loc->Delete();
   }
 
+  this->WindingNumber->Delete();
   this->CellIds->Delete();
   this->Cell->Delete();
 }
@@ -222,7 +229,9 @@ int vtkSelectEnclosedPoints::RequestData(
 
   // Process the points in parallel
   SelectInOutCheck::Execute(numPts, input, surface, this->Bounds, this->Tolerance,
-                            this->CellLocator, hitsPtr, this);
+                            this->CellLocator,
+                            (this->Strategy == vtkSelectEnclosedPoints::WINDING_NUMBER ?
+                             this->WindingNumber : nullptr), hitsPtr, this);
 
   // Copy all the input geometry and data to the output.
   output->CopyStructure(input);
@@ -283,6 +292,17 @@ void vtkSelectEnclosedPoints::Initialize(vtkPolyData *surface)
   // Set up structures for acceleration ray casting
   this->CellLocator->SetDataSet(surface);
   this->CellLocator->BuildLocator();
+
+  // The winding number hierarchy answers most queries without casting rays.
+  // Do not keep a hierarchy built from a previous surface.
+  if ( this->Strategy == vtkSelectEnclosedPoints::WINDING_NUMBER )
+  {
+    this->WindingNumber->BuildHierarchy(surface);
+  }
+  else
+  {
+    this->WindingNumber->Initialize();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -311,16 +331,54 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x, double y, double z)
 
 //----------------------------------------------------------------------------
 // This is done to preserve backward compatibility. However it is not thread
-// safe due to the use of the data member CellIds and Cell.
+// safe due to the use of the data member CellIds and Cell. If the strategy
+// was switched to the winding number after Initialize(), there is no
+// hierarchy and rays are cast instead.
 int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
 {
   vtkIntersectionCounter counter(this->Tolerance, this->Length);
+  vtkFastWindingNumber *winding =
+    (this->Strategy == vtkSelectEnclosedPoints::WINDING_NUMBER &&
+     this->WindingNumber->GetNumberOfTriangles() > 0 ? this->WindingNumber : nullptr);
 
-  return this->IsInsideSurface(x, this->Surface, this->Bounds, this->Length,
+  return this->IsInsideSurface(x, winding,
+                               this->Surface, this->Bounds, this->Length,
                                this->Tolerance, this->CellLocator, this->CellIds,
                                this->Cell, counter);
 }
 
+//----------------------------------------------------------------------------
+// Evaluate the winding number first since it is much cheaper than casting
+// rays. Points close to the surface (within the intersection tolerance, or
+// where the winding number is not conclusive) are resolved by the ray
+// casting method, so that both methods produce the same answers.
+int vtkSelectEnclosedPoints::
+IsInsideSurface(double x[3], vtkFastWindingNumber *winding, vtkPolyData *surface,
+                double bds[6], double length, double tolerance,
+                vtkAbstractCellLocator *locator, vtkIdList *cellIds,
+                vtkGenericCell *genCell, vtkIntersectionCounter &counter,
+                vtkRandomPool* seq, vtkIdType seqIdx)
+{
+  if ( winding != nullptr )
+  {
+    if ( x[0] < bds[0] || x[0] > bds[1] ||
+         x[1] < bds[2] || x[1] > bds[3] ||
+         x[2] < bds[4] || x[2] > bds[5])
+    {
+      return 0;
+    }
+    int inside = winding->ClassifyPoint(x, tolerance*length);
+    if ( inside >= 0 )
+    {
+      return inside;
+    }
+  }
+
+  return vtkSelectEnclosedPoints::
+    IsInsideSurface(x, surface, bds, length, tolerance, locator, cellIds,
+                    genCell, counter, seq, seqIdx);
+}
+
 //----------------------------------------------------------------------------
 // General method uses ray casting to determine in/out. Since this is a
 // numerically delicate operation, we use a crude "statistical" method (based
@@ -503,6 +561,7 @@ int vtkSelectEnclosedPoints::FillInputPortInformation(int port, vtkInformation *
 void vtkSelectEnclosedPoints::Complete()
 {
   this->CellLocator->FreeSearchStructure();
+  this->WindingNumber->Initialize();
 }
 
 //----------------------------------------------------------------------------
@@ -526,4 +585,5 @@ void vtkSelectEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
      << (this->InsideOut ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "Strategy: " << this->Strategy << "\n";
 }
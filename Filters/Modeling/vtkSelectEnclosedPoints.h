@@ -25,6 +25,15 @@
  * After running the filter, it is possible to query it as to whether a point
  * is inside/outside by invoking the IsInside(ptId) method.
  *
+ * Two strategies are available. By default, random rays are cast from each
+ * point and the parity of the number of intersections with the surface is
+ * used to vote on the answer. Alternatively, the winding number of the
+ * surface may be evaluated at each point using a precomputed hierarchy (see
+ * vtkFastWindingNumber). This is much faster for large numbers of points;
+ * points for which the winding number is not conclusive (i.e., points very
+ * close to the surface) are resolved by casting rays, so both strategies
+ * produce the same answers for closed, consistently oriented surfaces.
+ *
  * @warning
  * The filter assumes that the surface is closed and manifold. A boolean flag
  * can be set to force the filter to first check whether this is true. If false,
@@ -59,6 +68,7 @@ class vtkStaticCellLocator;
 class vtkIdList;
 class vtkGenericCell;
 class vtkRandomPool;
+class vtkFastWindingNumber;
 
 
 class VTKFILTERSMODELING_EXPORT vtkSelectEnclosedPoints : public vtkDataSetAlgorithm
@@ -106,6 +116,25 @@ public:
   vtkGetMacro(InsideOut,vtkTypeBool);
   //@}
 
+  enum StrategyType
+  {
+    RAY_CASTING = 0,
+    WINDING_NUMBER = 1
+  };
+
+  //@{
+  /**
+   * Specify the strategy used to determine whether points are inside the
+   * surface: casting random rays (the default), or evaluating the winding
+   * number of the surface. The winding number strategy requires the polygons
+   * of the surface to be consistently oriented.
+   */
+  vtkSetClampMacro(Strategy,int,RAY_CASTING,WINDING_NUMBER);
+  vtkGetMacro(Strategy,int);
+  void SetStrategyToRayCasting() { this->SetStrategy(RAY_CASTING); }
+  void SetStrategyToWindingNumber() { this->SetStrategy(WINDING_NUMBER); }
+  //@}
+
   //@{
   /**
    * Specify whether to check the surface for closure. If on, then the
@@ -136,7 +165,9 @@ public:
    * This is a backdoor that can be used to test many points for containment.
    * First initialize the instance, then repeated calls to IsInsideSurface()
    * can be used without rebuilding the search structures. The Complete()
-   * method releases memory.
+   * method releases memory. The winding number hierarchy is only built if
+   * the strategy is WINDING_NUMBER when Initialize() is called; otherwise
+   * IsInsideSurface() casts rays.
    */
   void Initialize(vtkPolyData *surface);
   int IsInsideSurface(double x[3]);
@@ -160,6 +191,19 @@ public:
                              vtkIntersectionCounter &counter,
                              vtkRandomPool* poole=nullptr, vtkIdType seqIdx=0);
 
+  /**
+   * A variant of the static method above which first evaluates the winding
+   * number of the surface at x using the provided hierarchy (built from the
+   * same surface), and only casts rays when the winding number is not
+   * conclusive. It is thread safe as well.
+   */
+  static int IsInsideSurface(double x[3], vtkFastWindingNumber *winding,
+                             vtkPolyData *surface, double bds[6],
+                             double length,  double tol, vtkAbstractCellLocator *locator,
+                             vtkIdList *cellIds, vtkGenericCell *genCell,
+                             vtkIntersectionCounter &counter,
+                             vtkRandomPool* poole=nullptr, vtkIdType seqIdx=0);
+
   /**
    * A static method for determining whether a surface is closed. Provide as input
    * a vtkPolyData. The method returns >0 is the surface is closed and manifold.
@@ -173,11 +217,13 @@ protected:
   vtkTypeBool    CheckSurface;
   vtkTypeBool    InsideOut;
   double Tolerance;
+  int Strategy;
 
   vtkUnsignedCharArray *InsideOutsideArray;
 
   // Internal structures for accelerating the intersection test
   vtkStaticCellLocator *CellLocator;
+  vtkFastWindingNumber *WindingNumber;
   vtkIdList      *CellIds;
   vtkGenericCell *Cell;
   vtkPolyData    *Surface;
@@ -940,6 +940,16 @@ int vtkPLagrangianParticleTracker::Integrate(vtkLagrangianParticle* particle,
   return ret;
 }
 
+//---------------------------------------------------------------------------
+bool vtkPLagrangianParticleTracker::CanIntegrateInParallel()
+{
+  if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
+  {
+    return false;
+  }
+  return this->Superclass::CanIntegrateInParallel();
+}
+
 //---------------------------------------------------------------------------
 void vtkPLagrangianParticleTracker::ReceiveParticles(
   std::queue<vtkLagrangianParticle*>& particleQueue)
@@ -86,6 +86,11 @@ protected:
     vtkPolyData* particlePathsOutput, vtkIdList* particlePathPointId,
     vtkDataObject* interactionOutput) override;
 
+  /**
+   * Particles are integrated serially when they are streamed between ranks.
+   */
+  bool CanIntegrateInParallel() override;
+
   void SendParticle(vtkLagrangianParticle* particle);
   void ReceiveParticles(std::queue<vtkLagrangianParticle*>& particleQueue);
 
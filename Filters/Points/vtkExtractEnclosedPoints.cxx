@@ -26,6 +26,7 @@
 #include "vtkPolyData.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkExecutive.h"
+#include "vtkFastWindingNumber.h"
 #include "vtkFeatureEdges.h"
 #include "vtkStaticCellLocator.h"
 #include "vtkGenericCell.h"
@@ -56,6 +57,7 @@ struct ExtractInOutCheck
   double Length;
   double Tolerance;
   vtkStaticCellLocator *Locator;
+  vtkFastWindingNumber *Winding;
   vtkIdType *PointMap;
   vtkRandomPool *Sequence;
   vtkSMPThreadLocal<vtkIntersectionCounter> Counter;
@@ -66,8 +68,10 @@ struct ExtractInOutCheck
   vtkSMPThreadLocalObject<vtkGenericCell> Cell;
 
   ExtractInOutCheck(vtkIdType numPts, T *pts, vtkPolyData *surface, double bds[6],
-                    double tol, vtkStaticCellLocator *loc, vtkIdType *map) :
-    NumPts(numPts), Points(pts), Surface(surface), Tolerance(tol), Locator(loc), PointMap(map)
+                    double tol, vtkStaticCellLocator *loc, vtkFastWindingNumber *winding,
+                    vtkIdType *map) :
+    NumPts(numPts), Points(pts), Surface(surface), Tolerance(tol), Locator(loc),
+    Winding(winding), PointMap(map)
   {
     this->Bounds[0] = bds[0];
     this->Bounds[1] = bds[1];
@@ -114,7 +118,7 @@ struct ExtractInOutCheck
       x[2] = static_cast<double>(pts[2]);
 
       hit = vtkSelectEnclosedPoints::
-        IsInsideSurface(x, this->Surface, this->Bounds, this->Length,
+        IsInsideSurface(x, this->Winding, this->Surface, this->Bounds, this->Length,
                         this->Tolerance, this->Locator, cellIds, cell,
                         counter, this->Sequence, ptId);
       *map++ = (hit ? 1 : -1);
@@ -127,9 +131,9 @@ struct ExtractInOutCheck
 
   static void Execute(vtkIdType numPts, T *pts, vtkPolyData *surface,
                       double bds[6], double tol, vtkStaticCellLocator *loc,
-                      vtkIdType *hits)
+                      vtkFastWindingNumber *winding, vtkIdType *hits)
   {
-    ExtractInOutCheck inOut(numPts, pts, surface, bds, tol, loc, hits);
+    ExtractInOutCheck inOut(numPts, pts, surface, bds, tol, loc, winding, hits);
     vtkSMPTools::For(0, numPts, inOut);
   }
 }; //ExtractInOutCheck
@@ -145,6 +149,7 @@ vtkExtractEnclosedPoints::vtkExtractEnclosedPoints()
 
   this->CheckSurface = false;
   this->Tolerance = 0.001;
+  this->Strategy = vtkSelectEnclosedPoints::RAY_CASTING;
 }
 
 //----------------------------------------------------------------------------
@@ -199,6 +204,14 @@ int vtkExtractEnclosedPoints::FilterPoints(vtkPointSet *input)
   locator->SetDataSet(surface);
   locator->BuildLocator();
 
+  // The winding number hierarchy answers most queries without casting rays
+  vtkFastWindingNumber *winding = nullptr;
+  if ( this->Strategy == vtkSelectEnclosedPoints::WINDING_NUMBER )
+  {
+    winding = vtkFastWindingNumber::New();
+    winding->BuildHierarchy(surface);
+  }
+
   // Loop over all input points determining inside/outside
   vtkIdType numPts = input->GetNumberOfPoints();
   void *inPtr = input->GetPoints()->GetVoidPointer(0);
@@ -206,11 +219,15 @@ int vtkExtractEnclosedPoints::FilterPoints(vtkPointSet *input)
   {
     vtkTemplateMacro(ExtractInOutCheck<VTK_TT>::
                      Execute(numPts, (VTK_TT *)inPtr, surface, bds,
-                             this->Tolerance, locator, this->PointMap));
+                             this->Tolerance, locator, winding, this->PointMap));
   }
 
   // Clean up and get out
   locator->Delete();
+  if ( winding )
+  {
+    winding->Delete();
+  }
   return 1;
 }
 
@@ -276,4 +293,5 @@ void vtkExtractEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
      << (this->CheckSurface ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "Strategy: " << this->Strategy << "\n";
 }
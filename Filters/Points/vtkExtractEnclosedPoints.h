@@ -25,6 +25,10 @@
  * available for generating an in/out mask, and also extracting points
  * outside of the enclosing surface.
  *
+ * The points are classified either by casting random rays, or by evaluating
+ * the winding number of the surface with a precomputed hierarchy; see
+ * vtkSelectEnclosedPoints for details on the two strategies.
+ *
  * @warning
  * The filter assumes that the surface is closed and manifold. A boolean flag
  * can be set to force the filter to first check whether this is true. If false,
@@ -55,6 +59,7 @@
 
 #include "vtkFiltersPointsModule.h" // For export macro
 #include "vtkPointCloudFilter.h"
+#include "vtkSelectEnclosedPoints.h" // For the strategy types
 
 class VTKFILTERSPOINTS_EXPORT vtkExtractEnclosedPoints : public vtkPointCloudFilter
 {
@@ -105,12 +110,29 @@ public:
   vtkGetMacro(Tolerance,double);
   //@}
 
+  //@{
+  /**
+   * Specify the strategy used to determine whether points are inside the
+   * surface: casting random rays (the default), or evaluating the winding
+   * number of the surface. The winding number strategy requires the polygons
+   * of the surface to be consistently oriented.
+   */
+  vtkSetClampMacro(Strategy,int,vtkSelectEnclosedPoints::RAY_CASTING,
+                   vtkSelectEnclosedPoints::WINDING_NUMBER);
+  vtkGetMacro(Strategy,int);
+  void SetStrategyToRayCasting()
+    { this->SetStrategy(vtkSelectEnclosedPoints::RAY_CASTING); }
+  void SetStrategyToWindingNumber()
+    { this->SetStrategy(vtkSelectEnclosedPoints::WINDING_NUMBER); }
+  //@}
+
 protected:
   vtkExtractEnclosedPoints();
   ~vtkExtractEnclosedPoints() override;
 
   vtkTypeBool CheckSurface;
   double      Tolerance;
+  int         Strategy;
 
   // Internal structures for managing the intersection testing
   vtkPolyData *Surface;
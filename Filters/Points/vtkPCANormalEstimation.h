@@ -143,7 +143,10 @@ public:
   /**
    * Specify a point locator. By default a vtkStaticPointLocator is
    * used. The locator performs efficient searches to locate points
-   * around a sample point.
+   * around a sample point. The SampleSize nearest neighbors of the points
+   * are searched from several threads at once. In sparse regions of a
+   * clustered point cloud, the uniform bins make these searches visit many
+   * empty bins; a vtkStaticKdTreePointLocator avoids that.
    */
   void SetLocator(vtkAbstractPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkAbstractPointLocator);
@@ -90,7 +90,9 @@ public:
   /**
    * Specify a point locator. By default a vtkStaticPointLocator is
    * used. The locator performs efficient searches to locate near a
-   * specified interpolation position.
+   * specified interpolation position. The radius searches are issued from
+   * several threads at once, so the locator must support concurrent
+   * queries, as vtkStaticPointLocator and vtkStaticKdTreePointLocator do.
    */
   void SetLocator(vtkAbstractPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkAbstractPointLocator);
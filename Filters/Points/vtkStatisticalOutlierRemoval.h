@@ -95,7 +95,9 @@ public:
   /**
    * Specify a point locator. By default a vtkStaticPointLocator is
    * used. The locator performs efficient searches to locate points
-   * surroinding a sample point.
+   * surroinding a sample point. Outliers lie by definition in sparse
+   * regions, where the nearest neighbor searches of uniform bins are
+   * slowest; vtkStaticKdTreePointLocator adapts to the point density.
    */
   void SetLocator(vtkAbstractPointLocator *locator);
   vtkGetObjectMacro(Locator,vtkAbstractPointLocator);
@@ -0,0 +1,430 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestEnSightGoldBinaryReaderCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write small binary EnSight Gold data sets and check that the reader
+// reuses static geometry across time steps only when asked to, notices when
+// the geometry file
+// is rewritten, and finds every time step of a single file file set, along
+// with the values of its variables when the time steps are read again.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkEnSightGoldBinaryReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Writes the 80 character lines, ints and floats of a C binary file in
+// the byte order of the host.
+class BinaryFile
+{
+public:
+  explicit BinaryFile(const std::string& name)
+    : Stream(name.c_str(), ios::out | ios::binary)
+  {
+  }
+
+  void Line(const char* text)
+  {
+    char line[80];
+    memset(line, ' ', 80);
+    memcpy(line, text, strlen(text));
+    this->Stream.write(line, 80);
+  }
+  void Int(int value)
+  {
+    this->Stream.write(reinterpret_cast<const char*>(&value), sizeof(int));
+  }
+  void Long(vtkTypeInt64 value)
+  {
+    this->Stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+  void Float(float value)
+  {
+    this->Stream.write(reinterpret_cast<const char*>(&value), sizeof(float));
+  }
+  vtkTypeInt64 Tell()
+  {
+    return static_cast<vtkTypeInt64>(this->Stream.tellp());
+  }
+
+private:
+  std::ofstream Stream;
+};
+
+// A unit square split into two triangles, shifted along x.
+const float SquareX[4] = { 0, 1, 1, 0 };
+const float SquareY[4] = { 0, 0, 1, 1 };
+
+void WriteSquare(BinaryFile& file, float shift, bool extents)
+{
+  file.Line("description 1");
+  file.Line("description 2");
+  file.Line("node id off");
+  file.Line("element id off");
+  if (extents)
+  {
+    file.Line("extents");
+    const float bounds[6] = { shift, shift + 1, 0, 1, 0, 0 };
+    for (int i = 0; i < 6; i++)
+    {
+      file.Float(bounds[i]);
+    }
+  }
+  file.Line("part");
+  file.Int(1);
+  file.Line("square");
+  file.Line("coordinates");
+  file.Int(4);
+  for (int i = 0; i < 4; i++)
+  {
+    file.Float(SquareX[i] + shift);
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    file.Float(SquareY[i]);
+  }
+  for (int i = 0; i < 4; i++)
+  {
+    file.Float(0);
+  }
+  file.Line("tria3");
+  file.Int(2);
+  const int conn[6] = { 1, 2, 3, 1, 3, 4 };
+  for (int i = 0; i < 6; i++)
+  {
+    file.Int(conn[i]);
+  }
+}
+
+void WriteStaticGeometry(const std::string& name, float shift, bool extents)
+{
+  BinaryFile file(name);
+  file.Line("C Binary");
+  WriteSquare(file, shift, extents);
+}
+
+// All time steps in one file, optionally with the file index that lets the
+// reader seek to a time step without scanning the file.
+void WriteFileSetGeometry(
+  const std::string& name, int numSteps, float shift, bool index)
+{
+  BinaryFile file(name);
+  file.Line("C Binary");
+  std::vector<vtkTypeInt64> offsets;
+  for (int step = 0; step < numSteps; step++)
+  {
+    file.Line("BEGIN TIME STEP");
+    offsets.push_back(file.Tell());
+    WriteSquare(file, shift + step, false);
+    file.Line("END TIME STEP");
+  }
+  if (index)
+  {
+    vtkTypeInt64 indexOffset = file.Tell();
+    file.Int(numSteps);
+    for (int step = 0; step < numSteps; step++)
+    {
+      file.Long(offsets[step]);
+    }
+    file.Long(indexOffset);
+    file.Line("FILE_INDEX");
+  }
+}
+
+// The per node or per element values of all time steps in one file. The
+// values of a time step are value + 10 * step + the node or element index.
+void WriteFileSetScalars(const std::string& name, int numSteps, bool perElement,
+  float value, bool index)
+{
+  BinaryFile file(name);
+  std::vector<vtkTypeInt64> offsets;
+  for (int step = 0; step < numSteps; step++)
+  {
+    file.Line("BEGIN TIME STEP");
+    offsets.push_back(file.Tell());
+    file.Line(perElement ? "pressure" : "temperature");
+    file.Line("part");
+    file.Int(1);
+    file.Line(perElement ? "tria3" : "coordinates");
+    for (int i = 0; i < (perElement ? 2 : 4); i++)
+    {
+      file.Float(value + 10 * step + i);
+    }
+    file.Line("END TIME STEP");
+  }
+  if (index)
+  {
+    vtkTypeInt64 indexOffset = file.Tell();
+    file.Int(numSteps);
+    for (int step = 0; step < numSteps; step++)
+    {
+      file.Long(offsets[step]);
+    }
+    file.Long(indexOffset);
+    file.Line("FILE_INDEX");
+  }
+}
+
+void WriteScalars(const std::string& name, float value)
+{
+  BinaryFile file(name);
+  file.Line("temperature");
+  file.Line("part");
+  file.Int(1);
+  file.Line("coordinates");
+  for (int i = 0; i < 4; i++)
+  {
+    file.Float(value + i);
+  }
+}
+
+void WriteText(const std::string& name, const char* text)
+{
+  std::ofstream file(name.c_str());
+  file << text;
+}
+
+const char* StaticCase =
+  "FORMAT\n"
+  "type: ensight gold\n"
+  "GEOMETRY\n"
+  "model: static.geo\n"
+  "VARIABLE\n"
+  "scalar per node: 1 temperature static.****\n"
+  "TIME\n"
+  "time set: 1\n"
+  "number of steps: 2\n"
+  "filename start number: 0\n"
+  "filename increment: 1\n"
+  "time values: 0.0 1.0\n";
+
+const char* FileSetCase =
+  "FORMAT\n"
+  "type: ensight gold\n"
+  "GEOMETRY\n"
+  "model: 1 1 fileset.geo\n"
+  "VARIABLE\n"
+  "scalar per node: 1 1 temperature fileset.scl\n"
+  "scalar per element: 1 1 pressure fileset.esc\n"
+  "TIME\n"
+  "time set: 1\n"
+  "number of steps: 3\n"
+  "time values: 0.0 1.0 2.0\n"
+  "FILE\n"
+  "file set: 1\n"
+  "number of steps: 3\n";
+
+void SetHostByteOrder(vtkEnSightGoldBinaryReader* reader)
+{
+#ifdef VTK_WORDS_BIGENDIAN
+  reader->SetByteOrderToBigEndian();
+#else
+  reader->SetByteOrderToLittleEndian();
+#endif
+}
+
+vtkUnstructuredGrid* GetSquare(vtkEnSightGoldBinaryReader* reader, double time)
+{
+  reader->UpdateTimeStep(time);
+  vtkMultiBlockDataSet* output =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutputDataObject(0));
+  vtkUnstructuredGrid* square = output ?
+    vtkUnstructuredGrid::SafeDownCast(output->GetBlock(0)) : nullptr;
+  if (!square || square->GetNumberOfPoints() != 4 ||
+      square->GetNumberOfCells() != 2)
+  {
+    cerr << "Wrong geometry at time " << time << endl;
+    return nullptr;
+  }
+  return square;
+}
+
+bool CheckShift(vtkUnstructuredGrid* square, double shift)
+{
+  double x[3];
+  square->GetPoint(1, x);
+  if (x[0] != shift + 1 || x[1] != 0)
+  {
+    cerr << "Expected the square shifted by " << shift << ", got point 1 at ("
+         << x[0] << ", " << x[1] << ")" << endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckScalars(vtkUnstructuredGrid* square, double value)
+{
+  vtkDataArray* scalars = square->GetPointData()->GetArray("temperature");
+  if (!scalars || scalars->GetComponent(3, 0) != value + 3)
+  {
+    cerr << "Wrong temperature, expected " << value + 3 << endl;
+    return false;
+  }
+  return true;
+}
+
+bool CheckFileSetScalars(vtkUnstructuredGrid* square, double temperatureValue,
+  double pressureValue, int step)
+{
+  vtkDataArray* temperature = square->GetPointData()->GetArray("temperature");
+  vtkDataArray* pressure = square->GetCellData()->GetArray("pressure");
+  if (!temperature || temperature->GetComponent(3, 0) != temperatureValue + 10 * step + 3 ||
+      !pressure || pressure->GetComponent(1, 0) != pressureValue + 10 * step + 1)
+  {
+    cerr << "Wrong temperature or pressure at time step " << step << endl;
+    return false;
+  }
+  return true;
+}
+
+int TestStaticGeometry(const std::string& dir)
+{
+  WriteText(dir + "/static.case", StaticCase);
+  WriteStaticGeometry(dir + "/static.geo", 0, false);
+  WriteScalars(dir + "/static.0000", 10);
+  WriteScalars(dir + "/static.0001", 20);
+
+  vtkNew<vtkEnSightGoldBinaryReader> reader;
+  reader->SetFilePath(dir.c_str());
+  reader->SetCaseFileName("static.case");
+  SetHostByteOrder(reader);
+
+  // By default, every time step reads the geometry again.
+  vtkUnstructuredGrid* square = GetSquare(reader, 0.0);
+  if (!square || !CheckShift(square, 0) || !CheckScalars(square, 10))
+  {
+    return 1;
+  }
+  vtkSmartPointer<vtkPoints> points = square->GetPoints();
+  square = GetSquare(reader, 1.0);
+  if (!square || !CheckShift(square, 0) || !CheckScalars(square, 20))
+  {
+    return 1;
+  }
+  if (square->GetPoints() == points)
+  {
+    cerr << "The geometry was reused with ReuseGeometry off" << endl;
+    return 1;
+  }
+
+  // With ReuseGeometry on, the second time step reuses the points of the
+  // first one.
+  reader->ReuseGeometryOn();
+  square = GetSquare(reader, 0.0);
+  if (!square || !CheckShift(square, 0) || !CheckScalars(square, 10))
+  {
+    return 1;
+  }
+  points = square->GetPoints();
+  square = GetSquare(reader, 1.0);
+  if (!square || !CheckShift(square, 0) || !CheckScalars(square, 20))
+  {
+    return 1;
+  }
+  if (square->GetPoints() != points)
+  {
+    cerr << "The static geometry was read again" << endl;
+    return 1;
+  }
+
+  // Rewriting the geometry file invalidates the cache. The extents change
+  // the size of the file, so the test does not depend on the resolution
+  // of file modification times.
+  WriteStaticGeometry(dir + "/static.geo", 5, true);
+  reader->Modified();
+  square = GetSquare(reader, 0.0);
+  if (!square || !CheckShift(square, 5) || !CheckScalars(square, 10))
+  {
+    return 1;
+  }
+  if (square->GetPoints() == points)
+  {
+    cerr << "The geometry was not read again after the file changed" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int TestFileSet(const std::string& dir, bool index)
+{
+  const char* name = index ? " with a file index" : "";
+  WriteText(dir + "/fileset.case", FileSetCase);
+  WriteFileSetGeometry(dir + "/fileset.geo", 3, 0, index);
+  WriteFileSetScalars(dir + "/fileset.scl", 3, false, 100, index);
+  WriteFileSetScalars(dir + "/fileset.esc", 3, true, 200, index);
+
+  vtkNew<vtkEnSightGoldBinaryReader> reader;
+  reader->SetFilePath(dir.c_str());
+  reader->SetCaseFileName("fileset.case");
+  SetHostByteOrder(reader);
+
+  // Jump around so that both cached and new offsets are used, and the
+  // values of the variables are read from their part index.
+  const int steps[5] = { 2, 0, 1, 2, 1 };
+  for (int i = 0; i < 5; i++)
+  {
+    vtkUnstructuredGrid* square = GetSquare(reader, steps[i]);
+    if (!square || !CheckShift(square, steps[i]) ||
+        !CheckFileSetScalars(square, 100, 200, steps[i]))
+    {
+      cerr << "Failure reading time step " << steps[i] << name << endl;
+      return 1;
+    }
+  }
+
+  // A rewritten file drops the cached time step offsets, count and part
+  // index.
+  WriteFileSetGeometry(dir + "/fileset.geo", 3, 10, !index);
+  WriteFileSetScalars(dir + "/fileset.scl", 3, false, 300, !index);
+  reader->Modified();
+  for (int step = 2; step >= 0; step--)
+  {
+    vtkUnstructuredGrid* square = GetSquare(reader, step);
+    if (!square || !CheckShift(square, 10 + step) ||
+        !CheckFileSetScalars(square, 300, 200, step))
+    {
+      cerr << "Failure reading time step " << step << " after rewriting"
+           << name << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestEnSightGoldBinaryReaderCache(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string dir = tempDir;
+  delete[] tempDir;
+
+  int status = TestStaticGeometry(dir);
+  status += TestFileSet(dir, false);
+  status += TestFileSet(dir, true);
+  return status ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -3,6 +3,7 @@ vtk_module(vtkIOEnSight
     StandAlone
   TEST_DEPENDS
     vtkRenderingOpenGL2
+    vtkTestingCore
   KIT
     vtkIO
   DEPENDS
@@ -21,16 +21,21 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSmartPointer.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
 #include <sys/stat.h>
 #include <cctype>
 #include <string>
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -49,6 +54,27 @@
 #endif
 
 vtkStandardNewMacro(vtkEnSightGoldBinaryReader);
+
+// The modification time of a file in nanoseconds, or in seconds scaled to
+// nanoseconds where the finer time is not available.
+static vtkTypeInt64 vtkEnSightGoldBinaryReaderModifiedTime(
+  const VTK_STAT_STRUCT& fs)
+{
+  vtkTypeInt64 nanoseconds = static_cast<vtkTypeInt64>(fs.st_mtime) * 1000000000;
+#if defined(__APPLE__)
+  nanoseconds += static_cast<vtkTypeInt64>(fs.st_mtimespec.tv_nsec);
+#elif !defined(_WIN32)
+  nanoseconds += static_cast<vtkTypeInt64>(fs.st_mtim.tv_nsec);
+#endif
+  return nanoseconds;
+}
+
+// The EnSight id of each part of a time step of a variable file, and the
+// offset of the line that follows the part id ("coordinates", "block" or
+// the first element type).
+class vtkEnSightGoldBinaryReader::PartIndexInternal :
+  public std::vector<std::pair<int, vtkTypeInt64> > {};
+
 class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
 {
   typedef std::string MapKey;
@@ -58,19 +84,55 @@ class vtkEnSightGoldBinaryReader::FileOffsetMapInternal
     typedef std::map<MapKey, MapValue>::value_type value_type;
 
     std::map<MapKey, MapValue> Map;
+    // Number of time steps in each file, once counted.
+    std::map<MapKey, int> NumberOfTimeSteps;
+    // Size and modification time of each file when it was indexed.
+    std::map<MapKey, std::pair<vtkTypeUInt64, vtkTypeInt64> > Stamps;
+    // Part index of each time step of the variable files read.
+    std::map<MapKey, std::map<int, PartIndexInternal> > Parts;
+};
+
+// The parts of the last geometry file read, along with what identifies
+// the file and time step they were read from.
+class vtkEnSightGoldBinaryReader::GeometryCacheInternal
+{
+  public:
+    GeometryCacheInternal() : TimeStep(-1), FileSize(0), FileModifiedTime(0),
+      ByteOrder(0), NodeIdsListed(0), ElementIdsListed(0) {}
+
+    std::string FileName;
+    std::string FilePath;
+    int TimeStep;
+    vtkTypeUInt64 FileSize;
+    vtkTypeInt64 FileModifiedTime;
+    int ByteOrder;
+    int NodeIdsListed;
+    int ElementIdsListed;
+    // EnSight part ids in file order and the blocks they translate to.
+    std::vector<int> PartIds;
+    std::vector<int> RealIds;
+    vtkSmartPointer<vtkMultiBlockDataSet> Parts;
 };
 
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+// Size of the stream buffer. Much larger than the default so that the
+// many small line, int and part id reads rarely reach the file system.
+#define FILE_BUFFER_SIZE (1 << 18)
+
 //----------------------------------------------------------------------------
 vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 {
   this->FileOffsets = new vtkEnSightGoldBinaryReader::FileOffsetMapInternal;
+  this->GeometryCache = new vtkEnSightGoldBinaryReader::GeometryCacheInternal;
 
   this->GoldIFile = nullptr;
   this->FileSize = 0;
+  this->FileModifiedTime = 0;
+  this->FileBuffer = new char[FILE_BUFFER_SIZE];
   this->SizeOfInt = sizeof(int);
+  this->LastTimeStepOffset = 0;
   this->Fortran = 0;
   this->NodeIdsListed = 0;
   this->ElementIdsListed = 0;
@@ -80,6 +142,7 @@ vtkEnSightGoldBinaryReader::vtkEnSightGoldBinaryReader()
 vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
 {
   delete this->FileOffsets;
+  delete this->GeometryCache;
 
   if (this->GoldIFile)
   {
@@ -87,6 +150,7 @@ vtkEnSightGoldBinaryReader::~vtkEnSightGoldBinaryReader()
     delete this->GoldIFile;
     this->GoldIFile = nullptr;
   }
+  delete [] this->FileBuffer;
 }
 
 //----------------------------------------------------------------------------
@@ -111,13 +175,17 @@ int vtkEnSightGoldBinaryReader::OpenFile(const char* filename)
   VTK_STAT_STRUCT fs;
   if ( !VTK_STAT_FUNC( filename, &fs) )
   {
-    // Find out how big the file is.
+    // Find out how big the file is, and when it was last modified.
     this->FileSize = static_cast<vtkTypeUInt64>(fs.st_size);
+    this->FileModifiedTime = vtkEnSightGoldBinaryReaderModifiedTime(fs);
 
+    // The buffer has to be set before the file is opened.
+    this->GoldIFile = new ifstream;
+    this->GoldIFile->rdbuf()->pubsetbuf(this->FileBuffer, FILE_BUFFER_SIZE);
 #ifdef _WIN32
-    this->GoldIFile = new ifstream(filename, ios::in | ios::binary);
+    this->GoldIFile->open(filename, ios::in | ios::binary);
 #else
-    this->GoldIFile = new ifstream(filename, ios::in);
+    this->GoldIFile->open(filename, ios::in);
 #endif
   }
   else
@@ -268,16 +336,27 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     return 0;
   }
 
-  //this will close the file, so we need to reinitialize it
-  int numberOfTimeStepsInFile=this->CountTimeSteps();
-
-  if (!this->InitializeFile(fileName))
+  // Reuse the parts read last time if nothing changed since.
+  if (this->ReuseGeometry &&
+      this->RestoreCachedGeometry(fileName, timeStep, output))
   {
-  return 0;
+    this->GoldIFile->close();
+    delete this->GoldIFile;
+    this->GoldIFile = nullptr;
+    return 1;
   }
+  this->GeometryCache->Parts = nullptr;
 
   if (this->UseFileSets)
   {
+    //this may close the file, so we need to reinitialize it
+    int numberOfTimeStepsInFile = this->GetNumberOfTimeStepsInFile(fileName);
+
+    if (!this->InitializeFile(fileName))
+    {
+      return 0;
+    }
+
     if (numberOfTimeStepsInFile>1)
     {
       this->AddFileIndexToCache(fileName);
@@ -348,6 +427,7 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     lineRead = this->ReadLine(line); // "part"
   }
 
+  vtkNew<vtkIdList> partIds;
   while (lineRead > 0 && strncmp(line, "part", 4) == 0)
   {
     this->ReadPartId(&partId);
@@ -358,6 +438,7 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
       return 0;
     }
     realId = this->InsertNewPartId(partId);
+    partIds->InsertNextId(partId);
 
     // Increment the number of geometry parts such that the measured geometry,
     // if any, can be properly combined into a vtkMultiBlockDataSet object.
@@ -436,11 +517,16 @@ int vtkEnSightGoldBinaryReader::ReadGeometryFile(const char* fileName, int timeS
     return 0;
   }
 
+  if (this->ReuseGeometry)
+  {
+    this->CacheGeometry(fileName, timeStep, partIds, output);
+  }
+
   return 1;
 }
 
 //----------------------------------------------------------------------------
-int vtkEnSightGoldBinaryReader::CountTimeSteps()
+int vtkEnSightGoldBinaryReader::CountTimeSteps(const char* fileName)
 {
   int count=0;
   while(1)
@@ -448,6 +534,10 @@ int vtkEnSightGoldBinaryReader::CountTimeSteps()
     int result=this->SkipTimeStep();
     if (result)
     {
+      if (fileName)
+      {
+        this->AddTimeStepToCache(fileName, count, this->LastTimeStepOffset);
+      }
       count++;
     }
     else
@@ -472,6 +562,7 @@ int vtkEnSightGoldBinaryReader::SkipTimeStep()
       return 0;
     }
   }
+  this->LastTimeStepOffset = this->GoldIFile->tellg();
 
   // Skip the 2 description lines.
   this->ReadLine(line);
@@ -1304,7 +1395,7 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
   int numberOfComponents, int component)
 {
   char line[80];
-  int partId, realId, numPts, i, lineRead;
+  int partId, realId, numPts, i;
   vtkFloatArray *scalars;
   float* scalarsRead;
   vtkDataSet *output;
@@ -1338,7 +1429,11 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once a time step was indexed, its parts are read without looking for
+  // the time step or walking the part headers again.
+  const PartIndexInternal *parts =
+    (measured ? nullptr : this->FindVariableParts(fileName, timeStep));
+  if (this->UseFileSets && !parts)
   {
     this->AddFileIndexToCache(fileName);
 
@@ -1394,7 +1489,10 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
     }
   }
 
-  this->ReadLine(line); // skip the description line
+  if (!parts)
+  {
+    this->ReadLine(line); // skip the description line
+  }
 
   if (measured)
   {
@@ -1416,9 +1514,10 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
       // For complex scalars, there is a file for the real part and another
       // file for the imaginary part, but we are storing them as a 2-component
       // array.
+      float *scalarsPtr = scalars->GetPointer(0) + component;
       for (i = 0; i < numPts; i++)
       {
-        scalars->SetComponent(i, component, scalarsRead[i]);
+        scalarsPtr[i*numberOfComponents] = scalarsRead[i];
       }
       scalars->SetName(description);
       output->GetPointData()->AddArray(scalars);
@@ -1438,76 +1537,66 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerNode(
     return 1;
   }
 
-  lineRead = this->ReadLine(line);
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  if (!parts)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    parts = this->IndexVariableParts(fileName, timeStep, compositeOutput, 1, 0);
+  }
+  for (size_t p = 0; p < parts->size(); p++)
+  {
+    partId = (*parts)[p].first;
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numPts = output->GetNumberOfPoints();
-    // If the part has points, part number is followed by "coordinates" or
-    // "block" and list of values.
-    // If the part has no points, only part number is given, which may be
-    // optionally followed by "coordinates" or "block", without any values.
-
-    lineRead = this->ReadLine(line); // "coordinates", "block" or next part
-
+    // A part without points has no values.
     if (!numPts)
     {
-      if (lineRead && strncmp(line, "part", 4) == 0)
-      {
-        // Part number was not followed by "coordinates" or "block"; we are
-        // at the start of another part, skip to next iteration to avoid
-        // reading anything more.
-        continue;
-      }
+      continue;
+    }
+
+    this->GoldIFile->seekg((*parts)[p].second, ios::beg);
+    this->ReadLine(line); // "coordinates" or "block"
+    if (component == 0)
+    {
+      scalars = vtkFloatArray::New();
+      scalars->SetNumberOfComponents(numberOfComponents);
+      scalars->SetNumberOfTuples(numPts);
     }
     else
     {
-      if (component == 0)
-      {
-        scalars = vtkFloatArray::New();
-        scalars->SetNumberOfComponents(numberOfComponents);
-        scalars->SetNumberOfTuples(numPts);
-      }
-      else
-      {
-        scalars = (vtkFloatArray*)(output->GetPointData()->
-          GetArray(description));
-      }
+      scalars = (vtkFloatArray*)(output->GetPointData()->
+        GetArray(description));
+    }
 
+    if (numberOfComponents == 1)
+    {
+      // Read straight into the array.
+      this->ReadFloatArray(scalars->GetPointer(0), numPts);
+    }
+    else
+    {
       scalarsRead = new float[numPts];
       this->ReadFloatArray(scalarsRead, numPts);
-
+      float *scalarsPtr = scalars->GetPointer(0) + component;
       for (i = 0; i < numPts; i++)
       {
-        scalars->SetComponent(i, component, scalarsRead[i]);
-      }
-      if (component == 0)
-      {
-        scalars->SetName(description);
-        output->GetPointData()->AddArray(scalars);
-        if (!output->GetPointData()->GetScalars())
-        {
-          output->GetPointData()->SetScalars(scalars);
-        }
-        scalars->Delete();
+        scalarsPtr[i*numberOfComponents] = scalarsRead[i];
       }
-      else
+      delete [] scalarsRead;
+    }
+    if (component == 0)
+    {
+      scalars->SetName(description);
+      output->GetPointData()->AddArray(scalars);
+      if (!output->GetPointData()->GetScalars())
       {
-        output->GetPointData()->AddArray(scalars);
+        output->GetPointData()->SetScalars(scalars);
       }
-      delete [] scalarsRead;
+      scalars->Delete();
     }
-
-    this->GoldIFile->peek();
-    if (this->GoldIFile->eof())
+    else
     {
-      lineRead = 0;
-      continue;
+      output->GetPointData()->AddArray(scalars);
     }
-    lineRead = this->ReadLine(line);
   }
 
   if (this->GoldIFile)
@@ -1525,9 +1614,8 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
   vtkMultiBlockDataSet *compositeOutput, int measured)
 {
   char line[80];
-  int partId, realId, numPts, i, lineRead;
+  int partId, realId, numPts, i;
   vtkFloatArray *vectors;
-  float tuple[3];
   float *comp1, *comp2, *comp3;
   float *vectorsRead;
   vtkDataSet *output;
@@ -1561,7 +1649,11 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once a time step was indexed, its parts are read without looking for
+  // the time step or walking the part headers again.
+  const PartIndexInternal *parts =
+    (measured ? nullptr : this->FindVariableParts(fileName, timeStep));
+  if (this->UseFileSets && !parts)
   {
     this->AddFileIndexToCache(fileName);
 
@@ -1617,7 +1709,10 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
     }
   }
 
-  this->ReadLine(line); // skip the description line
+  if (!parts)
+  {
+    this->ReadLine(line); // skip the description line
+  }
 
   if (measured)
   {
@@ -1651,68 +1746,50 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerNode(
     return 1;
   }
 
-  lineRead = this->ReadLine(line);
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  if (!parts)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    parts = this->IndexVariableParts(fileName, timeStep, compositeOutput, 3, 0);
+  }
+  for (size_t p = 0; p < parts->size(); p++)
+  {
+    partId = (*parts)[p].first;
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numPts = output->GetNumberOfPoints();
-    // If the part has points, part number is followed by "coordinates" or
-    // "block" and list of values.
-    // If the part has no points, only part number is given, which may be
-    // optionally followed by "coordinates" or "block", without any values.
-
-    lineRead = this->ReadLine(line); // "coordinates", "block" or next part
-
+    // A part without points has no values.
     if (!numPts)
     {
-      if (lineRead && strncmp(line, "part", 4) == 0)
-      {
-        // Part number was not followed by "coordinates" or "block"; we are
-        // at the start of another part, skip to next iteration to avoid
-        // reading anything more.
-        continue;
-      }
+      continue;
     }
-    else
+
+    this->GoldIFile->seekg((*parts)[p].second, ios::beg);
+    this->ReadLine(line); // "coordinates" or "block"
+    vectors = vtkFloatArray::New();
+    vectors->SetNumberOfComponents(3);
+    vectors->SetNumberOfTuples(numPts);
+    comp1 = new float[numPts];
+    comp2 = new float[numPts];
+    comp3 = new float[numPts];
+    this->ReadFloatArray(comp1, numPts);
+    this->ReadFloatArray(comp2, numPts);
+    this->ReadFloatArray(comp3, numPts);
+    float *vectorsPtr = vectors->GetPointer(0);
+    for (i = 0; i < numPts; i++)
     {
-      vectors = vtkFloatArray::New();
-      vectors->SetNumberOfComponents(3);
-      vectors->SetNumberOfTuples(numPts);
-      comp1 = new float[numPts];
-      comp2 = new float[numPts];
-      comp3 = new float[numPts];
-      this->ReadFloatArray(comp1, numPts);
-      this->ReadFloatArray(comp2, numPts);
-      this->ReadFloatArray(comp3, numPts);
-      for (i = 0; i < numPts; i++)
-      {
-        tuple[0] = comp1[i];
-        tuple[1] = comp2[i];
-        tuple[2] = comp3[i];
-        vectors->SetTuple(i, tuple);
-      }
-      vectors->SetName(description);
-      output->GetPointData()->AddArray(vectors);
-      if (!output->GetPointData()->GetVectors())
-      {
-        output->GetPointData()->SetVectors(vectors);
-      }
-      vectors->Delete();
-      delete [] comp1;
-      delete [] comp2;
-      delete [] comp3;
+      vectorsPtr[3*i] = comp1[i];
+      vectorsPtr[3*i+1] = comp2[i];
+      vectorsPtr[3*i+2] = comp3[i];
     }
-
-    this->GoldIFile->peek();
-    if (this->GoldIFile->eof())
+    vectors->SetName(description);
+    output->GetPointData()->AddArray(vectors);
+    if (!output->GetPointData()->GetVectors())
     {
-      lineRead = 0;
-      continue;
+      output->GetPointData()->SetVectors(vectors);
     }
-    lineRead = this->ReadLine(line);
+    vectors->Delete();
+    delete [] comp1;
+    delete [] comp2;
+    delete [] comp3;
   }
 
   if (this->GoldIFile)
@@ -1731,7 +1808,7 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
   vtkMultiBlockDataSet *compositeOutput)
 {
   char line[80];
-  int partId, realId, numPts, i, lineRead;
+  int partId, realId, numPts, i;
   vtkFloatArray *tensors;
   float *comp1, *comp2, *comp3, *comp4, *comp5, *comp6;
   float tuple[6];
@@ -1766,7 +1843,11 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once a time step was indexed, its parts are read without looking for
+  // the time step or walking the part headers again.
+  const PartIndexInternal *parts =
+    this->FindVariableParts(fileName, timeStep);
+  if (this->UseFileSets && !parts)
   {
     this->AddFileIndexToCache(fileName);
 
@@ -1808,19 +1889,21 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
     }
   }
 
-  this->ReadLine(line); // skip the description line
-  lineRead = this->ReadLine(line);
-
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  if (!parts)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    this->ReadLine(line); // skip the description line
+    parts = this->IndexVariableParts(fileName, timeStep, compositeOutput, 6, 0);
+  }
+  for (size_t p = 0; p < parts->size(); p++)
+  {
+    partId = (*parts)[p].first;
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numPts = output->GetNumberOfPoints();
     if (numPts)
     {
       tensors = vtkFloatArray::New();
+      this->GoldIFile->seekg((*parts)[p].second, ios::beg);
       this->ReadLine(line); // "coordinates" or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(numPts);
@@ -1856,14 +1939,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerNode(
       delete [] comp5;
       delete [] comp6;
     }
-
-    this->GoldIFile->peek();
-    if (this->GoldIFile->eof())
-    {
-      lineRead = 0;
-      continue;
-    }
-    lineRead = this->ReadLine(line);
   }
 
   if (this->GoldIFile)
@@ -1919,7 +1994,11 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once a time step was indexed, its parts are read without looking for
+  // the time step or walking the part headers again.
+  const PartIndexInternal *parts =
+    this->FindVariableParts(fileName, timeStep);
+  if (this->UseFileSets && !parts)
   {
     this->AddFileIndexToCache(fileName);
 
@@ -1997,19 +2076,22 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
     }
   }
 
-  this->ReadLine(line); // skip the description line
-  lineRead = this->ReadLine(line); // "part"
-
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  if (!parts)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    this->ReadLine(line); // skip the description line
+    parts = this->IndexVariableParts(fileName, timeStep, compositeOutput, 1, 1);
+  }
+  for (size_t p = 0; p < parts->size(); p++)
+  {
+    partId = (*parts)[p].first;
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numCells = output->GetNumberOfCells();
     if (numCells)
     {
-      this->ReadLine(line); // element type or "block"
+      this->GoldIFile->clear();
+      this->GoldIFile->seekg((*parts)[p].second, ios::beg);
+      lineRead = this->ReadLine(line); // element type or "block"
       if (component == 0)
       {
         scalars = vtkFloatArray::New();
@@ -2099,18 +2181,6 @@ int vtkEnSightGoldBinaryReader::ReadScalarsPerElement(
         output->GetCellData()->AddArray(scalars);
       }
     }
-    else
-    {
-      this->GoldIFile->peek();
-      if (this->GoldIFile->eof())
-      {
-        lineRead = 0;
-      }
-      else
-      {
-        lineRead = this->ReadLine(line);
-      }
-    }
   }
 
   if (this->GoldIFile)
@@ -2165,7 +2235,11 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once a time step was indexed, its parts are read without looking for
+  // the time step or walking the part headers again.
+  const PartIndexInternal *parts =
+    this->FindVariableParts(fileName, timeStep);
+  if (this->UseFileSets && !parts)
   {
     this->AddFileIndexToCache(fileName);
 
@@ -2240,20 +2314,23 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
     }
   }
 
-  this->ReadLine(line); // skip the description line
-  lineRead = this->ReadLine(line); // "part"
-
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  if (!parts)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    this->ReadLine(line); // skip the description line
+    parts = this->IndexVariableParts(fileName, timeStep, compositeOutput, 3, 1);
+  }
+  for (size_t p = 0; p < parts->size(); p++)
+  {
+    partId = (*parts)[p].first;
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numCells = output->GetNumberOfCells();
     if (numCells)
     {
       vectors = vtkFloatArray::New();
-      this->ReadLine(line); // element type or "block"
+      this->GoldIFile->clear();
+      this->GoldIFile->seekg((*parts)[p].second, ios::beg);
+      lineRead = this->ReadLine(line); // element type or "block"
       vectors->SetNumberOfComponents(3);
       vectors->SetNumberOfTuples(numCells);
       // need to find out from CellIds how many cells we have of this element
@@ -2339,18 +2416,6 @@ int vtkEnSightGoldBinaryReader::ReadVectorsPerElement(
       }
       vectors->Delete();
     }
-    else
-    {
-      this->GoldIFile->peek();
-      if (this->GoldIFile->eof())
-      {
-        lineRead = 0;
-      }
-      else
-      {
-        lineRead = this->ReadLine(line);
-      }
-    }
   }
 
   if (this->GoldIFile)
@@ -2405,7 +2470,11 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
     return 0;
   }
 
-  if (this->UseFileSets)
+  // Once a time step was indexed, its parts are read without looking for
+  // the time step or walking the part headers again.
+  const PartIndexInternal *parts =
+    this->FindVariableParts(fileName, timeStep);
+  if (this->UseFileSets && !parts)
   {
     this->AddFileIndexToCache(fileName);
 
@@ -2480,20 +2549,23 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
     }
   }
 
-  this->ReadLine(line); // skip the description line
-  lineRead = this->ReadLine(line); // "part"
-
-  while (lineRead && strncmp(line, "part", 4) == 0)
+  if (!parts)
   {
-    this->ReadPartId(&partId);
-    partId--; // EnSight starts #ing with 1.
+    this->ReadLine(line); // skip the description line
+    parts = this->IndexVariableParts(fileName, timeStep, compositeOutput, 6, 1);
+  }
+  for (size_t p = 0; p < parts->size(); p++)
+  {
+    partId = (*parts)[p].first;
     realId = this->InsertNewPartId(partId);
     output = this->GetDataSetFromBlock(compositeOutput, realId);
     numCells = output->GetNumberOfCells();
     if (numCells)
     {
       tensors = vtkFloatArray::New();
-      this->ReadLine(line); // element type or "block"
+      this->GoldIFile->clear();
+      this->GoldIFile->seekg((*parts)[p].second, ios::beg);
+      lineRead = this->ReadLine(line); // element type or "block"
       tensors->SetNumberOfComponents(6);
       tensors->SetNumberOfTuples(numCells);
 
@@ -2600,18 +2672,6 @@ int vtkEnSightGoldBinaryReader::ReadTensorsPerElement(
       output->GetCellData()->AddArray(tensors);
       tensors->Delete();
     }
-    else
-    {
-      this->GoldIFile->peek();
-      if (this->GoldIFile->eof())
-      {
-        lineRead = 0;
-      }
-      else
-      {
-        lineRead = this->ReadLine(line);
-      }
-    }
   }
 
   if (this->GoldIFile)
@@ -2679,7 +2739,7 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       vtkPoints *points = vtkPoints::New();
       vtkDebugMacro("num. points: " << numPts);
 
-      points->Allocate(numPts);
+      points->SetNumberOfPoints(numPts);
 
       if (this->NodeIdsListed)
       {
@@ -2693,9 +2753,13 @@ int vtkEnSightGoldBinaryReader::CreateUnstructuredGridOutput(
       this->ReadFloatArray(yCoords, numPts);
       this->ReadFloatArray(zCoords, numPts);
 
+      float *pointsPtr =
+        static_cast<vtkFloatArray*>(points->GetData())->GetPointer(0);
       for (i = 0; i < numPts; i++)
       {
-        points->InsertNextPoint(xCoords[i], yCoords[i], zCoords[i]);
+        pointsPtr[3*i] = xCoords[i];
+        pointsPtr[3*i+1] = yCoords[i];
+        pointsPtr[3*i+2] = zCoords[i];
       }
 
       output->SetPoints(points);
@@ -4279,6 +4343,19 @@ int vtkEnSightGoldBinaryReader::ReadFloatArray(float *result,
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::SkipFloatArray(int numFloats)
+{
+  if (numFloats <= 0)
+  {
+    return;
+  }
+  // Fortran records start and end with their length.
+  vtkTypeInt64 size = static_cast<vtkTypeInt64>(sizeof(float)) * numFloats +
+    (this->Fortran ? 8 : 0);
+  this->GoldIFile->seekg(size, ios::cur);
+}
+
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -4337,6 +4414,8 @@ void vtkEnSightGoldBinaryReader::AddTimeStepToCache(const char* fileName,
 //----------------------------------------------------------------------------
 void vtkEnSightGoldBinaryReader::AddFileIndexToCache(const char* fileName)
 {
+  this->CheckFileIndex(fileName);
+
   // only read the file index if we have not searched for the file index before
   if (this->FileOffsets->Map.find(fileName) == this->FileOffsets->Map.end())
   {
@@ -4374,3 +4453,243 @@ void vtkEnSightGoldBinaryReader::AddFileIndexToCache(const char* fileName)
   }
   this->GoldIFile->seekg(0l, ios::beg);
 }
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::CheckFileIndex(const char* fileName)
+{
+  std::pair<vtkTypeUInt64, vtkTypeInt64> stamp(this->FileSize,
+                                               this->FileModifiedTime);
+  std::map<std::string, std::pair<vtkTypeUInt64, vtkTypeInt64> >::iterator
+    it = this->FileOffsets->Stamps.find(fileName);
+  if (it != this->FileOffsets->Stamps.end() && it->second == stamp)
+  {
+    return;
+  }
+  this->FileOffsets->Map.erase(fileName);
+  this->FileOffsets->NumberOfTimeSteps.erase(fileName);
+  this->FileOffsets->Parts.erase(fileName);
+  this->FileOffsets->Stamps[fileName] = stamp;
+}
+
+//----------------------------------------------------------------------------
+const vtkEnSightGoldBinaryReader::PartIndexInternal*
+vtkEnSightGoldBinaryReader::FindVariableParts(const char* fileName, int timeStep)
+{
+  this->CheckFileIndex(fileName);
+
+  std::map<std::string, std::map<int, PartIndexInternal> >::iterator
+    fileIt = this->FileOffsets->Parts.find(fileName);
+  if (fileIt == this->FileOffsets->Parts.end())
+  {
+    return nullptr;
+  }
+  // The time step only selects a part of the file with file sets.
+  std::map<int, PartIndexInternal>::iterator stepIt =
+    fileIt->second.find(this->UseFileSets ? timeStep : 1);
+  return (stepIt == fileIt->second.end() ? nullptr : &stepIt->second);
+}
+
+//----------------------------------------------------------------------------
+const vtkEnSightGoldBinaryReader::PartIndexInternal*
+vtkEnSightGoldBinaryReader::IndexVariableParts(const char* fileName,
+  int timeStep, vtkMultiBlockDataSet *compositeOutput, int numberOfArrays,
+  int perElement)
+{
+  this->CheckFileIndex(fileName);
+  PartIndexInternal &parts = this->FileOffsets->Parts[fileName][
+    this->UseFileSets ? timeStep : 1];
+  parts.clear();
+
+  char line[80];
+  int partId, realId, elementType, i;
+  vtkIdType num;
+  vtkDataSet *output;
+
+  int lineRead = this->ReadLine(line);
+  while (lineRead && strncmp(line, "part", 4) == 0)
+  {
+    this->ReadPartId(&partId);
+    partId--; // EnSight starts #ing with 1.
+    parts.push_back(std::make_pair(partId,
+      static_cast<vtkTypeInt64>(this->GoldIFile->tellg())));
+    realId = this->InsertNewPartId(partId);
+    output = this->GetDataSetFromBlock(compositeOutput, realId);
+    num = (perElement ? output->GetNumberOfCells() : output->GetNumberOfPoints());
+
+    // "coordinates", "block", an element type, or the next part when the
+    // part has no values.
+    lineRead = this->ReadLine(line);
+    if (!num)
+    {
+      if (lineRead && strncmp(line, "part", 4) != 0)
+      {
+        lineRead = this->ReadLine(line);
+      }
+    }
+    else if (!perElement || strncmp(line, "block", 5) == 0)
+    {
+      for (i = 0; i < numberOfArrays; i++)
+      {
+        this->SkipFloatArray(static_cast<int>(num));
+      }
+      lineRead = this->ReadLine(line);
+    }
+    else
+    {
+      int idx = this->UnstructuredPartIds->IsId(realId);
+      while (lineRead && strncmp(line, "part", 4) != 0 &&
+        strncmp(line, "END TIME STEP", 13) != 0)
+      {
+        elementType = this->GetElementType(line);
+        if (elementType == -1)
+        {
+          // Reported when the part is read.
+          lineRead = 0;
+          break;
+        }
+        num = this->GetCellIds(idx, elementType)->GetNumberOfIds();
+        for (i = 0; i < numberOfArrays; i++)
+        {
+          this->SkipFloatArray(static_cast<int>(num));
+        }
+        lineRead = this->ReadLine(line);
+      }
+    }
+  }
+  this->GoldIFile->clear();
+  return &parts;
+}
+
+//----------------------------------------------------------------------------
+int vtkEnSightGoldBinaryReader::GetNumberOfTimeStepsInFile(const char* fileName)
+{
+  this->CheckFileIndex(fileName);
+
+  std::map<std::string, int>::iterator it =
+    this->FileOffsets->NumberOfTimeSteps.find(fileName);
+  if (it != this->FileOffsets->NumberOfTimeSteps.end())
+  {
+    return it->second;
+  }
+
+  // A file index, when present, lists every time step. It is only read the
+  // first time the file is seen; later the offsets may be a partial list.
+  bool seen =
+    (this->FileOffsets->Map.find(fileName) != this->FileOffsets->Map.end());
+  this->AddFileIndexToCache(fileName);
+  int count = static_cast<int>(this->FileOffsets->Map[fileName].size());
+  if (seen || count == 0)
+  {
+    // Otherwise walk the whole file once, caching the offset of each time
+    // step on the way.
+    this->GoldIFile->clear();
+    this->GoldIFile->seekg(0l, ios::beg);
+    count = this->CountTimeSteps(fileName);
+  }
+  this->FileOffsets->NumberOfTimeSteps[fileName] = count;
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::CacheGeometry(const char* fileName,
+                                               int timeStep,
+                                               vtkIdList *partIds,
+                                               vtkMultiBlockDataSet *output)
+{
+  GeometryCacheInternal *cache = this->GeometryCache;
+  cache->FileName = fileName;
+  cache->FilePath = (this->FilePath ? this->FilePath : "");
+  // The time step only selects a part of the file with file sets.
+  cache->TimeStep = (this->UseFileSets ? timeStep : 1);
+  cache->FileSize = this->FileSize;
+  cache->FileModifiedTime = this->FileModifiedTime;
+  cache->ByteOrder = this->ByteOrder;
+  cache->NodeIdsListed = this->NodeIdsListed;
+  cache->ElementIdsListed = this->ElementIdsListed;
+
+  vtkIdType numParts = partIds->GetNumberOfIds();
+  cache->PartIds.resize(numParts);
+  cache->RealIds.resize(numParts);
+  for (vtkIdType i = 0; i < numParts; i++)
+  {
+    cache->PartIds[i] = static_cast<int>(partIds->GetId(i));
+    cache->RealIds[i] = this->InsertNewPartId(cache->PartIds[i]);
+  }
+
+  // Variables are added to the output blocks later on; the cache holds
+  // shallow copies of the geometry only.
+  cache->Parts = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  for (unsigned int i = 0; i < output->GetNumberOfBlocks(); i++)
+  {
+    vtkDataObject *part = output->GetBlock(i);
+    if (!part)
+    {
+      continue;
+    }
+    vtkDataObject *copy = part->NewInstance();
+    copy->ShallowCopy(part);
+    cache->Parts->SetBlock(i, copy);
+    copy->Delete();
+    if (output->HasMetaData(i))
+    {
+      cache->Parts->GetMetaData(i)->Copy(output->GetMetaData(i));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkEnSightGoldBinaryReader::RestoreCachedGeometry(const char* fileName,
+  int timeStep, vtkMultiBlockDataSet *output)
+{
+  GeometryCacheInternal *cache = this->GeometryCache;
+  if (!cache->Parts ||
+      cache->FileName != fileName ||
+      cache->FilePath != (this->FilePath ? this->FilePath : "") ||
+      cache->TimeStep != (this->UseFileSets ? timeStep : 1) ||
+      cache->FileSize != this->FileSize ||
+      cache->FileModifiedTime != this->FileModifiedTime ||
+      cache->ByteOrder != this->ByteOrder)
+  {
+    return false;
+  }
+
+  // The parts must still translate to the blocks they were read into.
+  for (size_t i = 0; i < cache->PartIds.size(); i++)
+  {
+    if (this->InsertNewPartId(cache->PartIds[i]) != cache->RealIds[i])
+    {
+      return false;
+    }
+  }
+
+  for (unsigned int i = 0; i < cache->Parts->GetNumberOfBlocks(); i++)
+  {
+    vtkDataObject *part = cache->Parts->GetBlock(i);
+    if (!part)
+    {
+      continue;
+    }
+    vtkDataObject *copy = part->NewInstance();
+    copy->ShallowCopy(part);
+    output->SetBlock(i, copy);
+    copy->Delete();
+    if (cache->Parts->HasMetaData(i))
+    {
+      output->GetMetaData(i)->Copy(cache->Parts->GetMetaData(i));
+    }
+  }
+
+  this->NumberOfGeometryParts += static_cast<int>(cache->PartIds.size());
+  this->NodeIdsListed = cache->NodeIdsListed;
+  this->ElementIdsListed = cache->ElementIdsListed;
+  vtkDebugMacro("Reusing the geometry read from " << fileName);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkEnSightGoldBinaryReader::ClearForNewCaseFileName()
+{
+  this->GeometryCache->Parts = nullptr;
+  this->FileOffsets->Parts.clear();
+  this->Superclass::ClearForNewCaseFileName();
+}
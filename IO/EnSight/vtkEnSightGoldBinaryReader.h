@@ -33,6 +33,18 @@
  * what types they will be.
  * This reader can only handle static EnSight datasets (both static geometry
  * and variables).
+ *
+ * With ReuseGeometry on, the parts read from a geometry file are kept and
+ * reused, without parsing the file again, as long as later requests resolve
+ * to the same file, the same time step in it, and the file's size and
+ * modification time (in nanoseconds where available) are unchanged. The
+ * time step offsets of file sets are indexed once per file.
+ * The first time a time step of a variable file is read, the offsets of the
+ * values of its parts are indexed by walking the part headers; the values
+ * are then read by seeking straight to each part, and later reads of the
+ * same time step skip the headers. The indexes are dropped when the file's
+ * size or modification time change. Files are read through a large stream
+ * buffer.
  * @par Thanks:
  * Thanks to Yvan Fournier for providing the code to support nfaced elements.
 */
@@ -44,6 +56,7 @@
 #include "vtkEnSightReader.h"
 
 
+class vtkIdList;
 class vtkMultiBlockDataSet;
 
 class VTKIOENSIGHT_EXPORT vtkEnSightGoldBinaryReader : public vtkEnSightReader
@@ -57,7 +70,8 @@ protected:
   vtkEnSightGoldBinaryReader();
   ~vtkEnSightGoldBinaryReader() override;
 
-  // Returns 1 if successful.  Sets file size as a side action.
+  // Returns 1 if successful.  Sets file size and modification time as a
+  // side action.
   int OpenFile(const char* filename);
 
 
@@ -199,8 +213,17 @@ protected:
    * This function assumes the file is already open and returns the
    * number of timesteps remaining in the file
    * The file will be closed after calling this method
+   * When fileName is given, the offset of each time step found is added to
+   * the time step cache of that file.
+   */
+  int CountTimeSteps(const char* fileName = nullptr);
+
+  /**
+   * Return the number of time steps in the open file fileName. The count is
+   * computed once, from the file index when there is one, and cached.
+   * The file has to be reinitialized after calling this method.
    */
-  int CountTimeSteps();
+  int GetNumberOfTimeStepsInFile(const char* fileName);
 
   //@{
   /**
@@ -228,6 +251,48 @@ protected:
    */
   void AddFileIndexToCache(const char* fileName);
 
+  /**
+   * Drop the cached time step offsets, count and part offsets of the open
+   * file fileName if it changed on disk since they were computed.
+   */
+  void CheckFileIndex(const char* fileName);
+
+  //@{
+  /**
+   * Part index of variable files. IndexVariableParts() walks the part
+   * headers of the time step that starts at the current position of the
+   * open variable file fileName (just after its description line), seeking
+   * over the values, and records where the values of each part start. The
+   * values of a part are numberOfArrays float arrays per node, or per
+   * element when perElement is set. FindVariableParts() returns the index
+   * built earlier for the time step, or nullptr. The readers then seek
+   * straight to the values of each part that has nodes or elements.
+   */
+  class PartIndexInternal;
+  const PartIndexInternal* FindVariableParts(const char* fileName, int timeStep);
+  const PartIndexInternal* IndexVariableParts(const char* fileName, int timeStep,
+    vtkMultiBlockDataSet *output, int numberOfArrays, int perElement);
+  //@}
+
+  /**
+   * Seek over a float array written by ReadFloatArray().
+   */
+  void SkipFloatArray(int numFloats);
+
+  //@{
+  /**
+   * Geometry reuse. CacheGeometry() keeps the parts just read from the open
+   * geometry file; RestoreCachedGeometry() adds them to output and returns
+   * true when the open file and the time step match the cached ones.
+   */
+  void CacheGeometry(const char* fileName, int timeStep,
+    vtkIdList *partIds, vtkMultiBlockDataSet *output);
+  bool RestoreCachedGeometry(const char* fileName, int timeStep,
+    vtkMultiBlockDataSet *output);
+  //@}
+
+  void ClearForNewCaseFileName() override;
+
   int NodeIdsListed;
   int ElementIdsListed;
   int Fortran;
@@ -235,12 +300,20 @@ protected:
   ifstream *GoldIFile;
   // The size of the file could be used to choose byte order.
   vtkTypeUInt64 FileSize;
+  vtkTypeInt64 FileModifiedTime;
+  // Stream buffer of GoldIFile.
+  char *FileBuffer;
 
   class FileOffsetMapInternal;
   FileOffsetMapInternal *FileOffsets;
 
+  class GeometryCacheInternal;
+  GeometryCacheInternal *GeometryCache;
+
 private:
   int SizeOfInt;
+  // Offset of the last time step found by SkipTimeStep().
+  vtkTypeInt64 LastTimeStepOffset;
   vtkEnSightGoldBinaryReader(const vtkEnSightGoldBinaryReader&) = delete;
   void operator=(const vtkEnSightGoldBinaryReader&) = delete;
 };
@@ -93,6 +93,8 @@ vtkGenericEnSightReader::vtkGenericEnSightReader()
 
   this->ParticleCoordinatesByIndex = 0;
 
+  this->ReuseGeometry = 0;
+
   this->EnSightVersion = -1;
 
   this->PointDataArraySelection = vtkDataArraySelection::New();
@@ -851,6 +853,7 @@ int vtkGenericEnSightReader::RequestInformation(
   this->Reader->SetByteOrder(this->ByteOrder);
   this->Reader->RequestInformation(request, inputVector, outputVector);
   this->Reader->SetParticleCoordinatesByIndex(this->ParticleCoordinatesByIndex);
+  this->Reader->SetReuseGeometry(this->ReuseGeometry);
 
   this->SetTimeSets(this->Reader->GetTimeSets());
   if(!this->TimeValueInitialized)
@@ -1458,6 +1461,7 @@ void vtkGenericEnSightReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ReadAllVariables: " << this->ReadAllVariables << endl;
   os << indent << "ByteOrder: " << this->ByteOrder << endl;
   os << indent << "ParticleCoordinatesByIndex: " << this->ParticleCoordinatesByIndex << endl;
+  os << indent << "ReuseGeometry: " << this->ReuseGeometry << endl;
   os << indent << "CellDataArraySelection: " << this->CellDataArraySelection
      << endl;
   os << indent << "PointDataArraySelection: " << this->PointDataArraySelection
@@ -265,6 +265,20 @@ public:
   vtkBooleanMacro(ParticleCoordinatesByIndex, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * When on, the parts read from a geometry file are kept and reused by
+   * later requests that resolve to the same file and time step, as long
+   * as the size and modification time of the file are unchanged. A file
+   * rewritten in place with the same size within the resolution of the
+   * file system timestamps is not noticed. Only the binary EnSight Gold
+   * reader honors it. Off by default.
+   */
+  vtkSetMacro(ReuseGeometry, vtkTypeBool);
+  vtkGetMacro(ReuseGeometry, vtkTypeBool);
+  vtkBooleanMacro(ReuseGeometry, vtkTypeBool);
+  //@}
+
   /**
    * Returns true if the file pointed to by casefilename appears to be a
    * valid EnSight case file.
@@ -416,6 +430,7 @@ protected:
 
   int ByteOrder;
   vtkTypeBool ParticleCoordinatesByIndex;
+  vtkTypeBool ReuseGeometry;
 
   // The EnSight file version being read.  Valid after
   // UpdateInformation.  Value is -1 for unknown version.
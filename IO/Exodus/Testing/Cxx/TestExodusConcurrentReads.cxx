@@ -0,0 +1,280 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusConcurrentReads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batched (ConcurrentReads) and prefetching
+// (PrefetchNextTimeStep) modes of vtkExodusIIReader produce the same
+// result arrays as the default reader, time step after time step.
+
+#include "vtkCellData.h"
+#include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
+#include "vtkExodusIIReader.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include "vtk_exodusII.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+const int NumBlocks = 3;
+const int NumSteps = 4;
+
+// A column of hexahedra per block, each block with its own nodes.
+bool WriteTestFile(const std::string& fname)
+{
+  int compWS = 8;
+  int ioWS = 8;
+  int exoid = ex_create(fname.c_str(), EX_CLOBBER, &compWS, &ioWS);
+  if (exoid < 0)
+  {
+    return false;
+  }
+
+  int numNodes = 0;
+  int numElems = 0;
+  for (int b = 0; b < NumBlocks; ++b)
+  {
+    numElems += 10 + b;
+    numNodes += 4 * (11 + b);
+  }
+  ex_put_init(exoid, "concurrent reads", 3, numNodes, numElems, NumBlocks, 0, 0);
+
+  std::vector<double> x, y, z;
+  for (int b = 0; b < NumBlocks; ++b)
+  {
+    for (int k = 0; k <= 10 + b; ++k)
+    {
+      for (int j = 0; j < 4; ++j)
+      {
+        x.push_back(3.0 * b + (j == 1 || j == 2 ? 1.0 : 0.0));
+        y.push_back(j >= 2 ? 1.0 : 0.0);
+        z.push_back(k);
+      }
+    }
+  }
+  ex_put_coord(exoid, &x[0], &y[0], &z[0]);
+
+  int firstNode = 1;
+  for (int b = 0; b < NumBlocks; ++b)
+  {
+    int nelem = 10 + b;
+    ex_put_block(exoid, EX_ELEM_BLOCK, 100 + b, "HEX8", nelem, 8, 0, 0, 0);
+    std::vector<int> conn;
+    for (int e = 0; e < nelem; ++e)
+    {
+      for (int layer = 0; layer < 2; ++layer)
+      {
+        for (int j = 0; j < 4; ++j)
+        {
+          conn.push_back(firstNode + 4 * (e + layer) + j);
+        }
+      }
+    }
+    ex_put_conn(exoid, EX_ELEM_BLOCK, 100 + b, &conn[0], nullptr, nullptr);
+    firstNode += 4 * (nelem + 1);
+  }
+
+  const char* nodalNames[] = { "temp", "vel_x", "vel_y", "vel_z" };
+  ex_put_variable_param(exoid, EX_NODAL, 4);
+  ex_put_variable_names(exoid, EX_NODAL, 4, const_cast<char**>(nodalNames));
+  const char* elemNames[] = { "pressure", "stress" };
+  ex_put_variable_param(exoid, EX_ELEM_BLOCK, 2);
+  ex_put_variable_names(exoid, EX_ELEM_BLOCK, 2, const_cast<char**>(elemNames));
+  // "stress" is only defined on the first and last blocks.
+  int truth[NumBlocks * 2] = { 1, 1, 1, 0, 1, 1 };
+  ex_put_truth_table(exoid, EX_ELEM_BLOCK, NumBlocks, 2, truth);
+
+  for (int step = 1; step <= NumSteps; ++step)
+  {
+    double t = 0.5 * step;
+    ex_put_time(exoid, step, &t);
+    std::vector<double> vals(numNodes);
+    for (int v = 0; v < 4; ++v)
+    {
+      for (int i = 0; i < numNodes; ++i)
+      {
+        vals[i] = 1000.0 * step + 100.0 * v + 0.25 * i;
+      }
+      ex_put_var(exoid, step, EX_NODAL, v + 1, 0, numNodes, &vals[0]);
+    }
+    for (int b = 0; b < NumBlocks; ++b)
+    {
+      int nelem = 10 + b;
+      for (int v = 0; v < 2; ++v)
+      {
+        if (!truth[2 * b + v])
+        {
+          continue;
+        }
+        std::vector<double> evals(nelem);
+        for (int e = 0; e < nelem; ++e)
+        {
+          evals[e] = -1000.0 * step - 10.0 * b - 0.5 * e - v;
+        }
+        ex_put_var(exoid, step, EX_ELEM_BLOCK, v + 1, 100 + b, nelem, &evals[0]);
+      }
+    }
+  }
+  ex_close(exoid);
+  return true;
+}
+
+bool CompareAttributes(vtkDataSetAttributes* a, vtkDataSetAttributes* b, const char* what)
+{
+  if (a->GetNumberOfArrays() != b->GetNumberOfArrays())
+  {
+    std::cerr << what << ": " << a->GetNumberOfArrays() << " arrays vs "
+              << b->GetNumberOfArrays() << std::endl;
+    return false;
+  }
+  for (int i = 0; i < a->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* arrA = a->GetArray(i);
+    vtkDataArray* arrB = arrA ? b->GetArray(arrA->GetName()) : nullptr;
+    if (!arrA)
+    {
+      continue;
+    }
+    if (!arrB || arrA->GetNumberOfTuples() != arrB->GetNumberOfTuples() ||
+      arrA->GetNumberOfComponents() != arrB->GetNumberOfComponents())
+    {
+      std::cerr << what << ": array " << arrA->GetName() << " missing or resized" << std::endl;
+      return false;
+    }
+    for (vtkIdType t = 0; t < arrA->GetNumberOfTuples(); ++t)
+    {
+      for (int c = 0; c < arrA->GetNumberOfComponents(); ++c)
+      {
+        if (arrA->GetComponent(t, c) != arrB->GetComponent(t, c))
+        {
+          std::cerr << what << ": array " << arrA->GetName() << " differs at tuple " << t
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareOutputs(vtkMultiBlockDataSet* a, vtkMultiBlockDataSet* b)
+{
+  vtkSmartPointer<vtkCompositeDataIterator> itA;
+  vtkSmartPointer<vtkCompositeDataIterator> itB;
+  itA.TakeReference(a->NewIterator());
+  itB.TakeReference(b->NewIterator());
+  int numLeaves = 0;
+  for (itA->InitTraversal(), itB->InitTraversal(); !itA->IsDoneWithTraversal();
+       itA->GoToNextItem(), itB->GoToNextItem())
+  {
+    if (itB->IsDoneWithTraversal())
+    {
+      std::cerr << "Outputs have different numbers of blocks" << std::endl;
+      return false;
+    }
+    vtkUnstructuredGrid* ugA = vtkUnstructuredGrid::SafeDownCast(itA->GetCurrentDataObject());
+    vtkUnstructuredGrid* ugB = vtkUnstructuredGrid::SafeDownCast(itB->GetCurrentDataObject());
+    if (!ugA || !ugB || ugA->GetNumberOfCells() != ugB->GetNumberOfCells())
+    {
+      std::cerr << "Block mismatch" << std::endl;
+      return false;
+    }
+    if (!CompareAttributes(ugA->GetPointData(), ugB->GetPointData(), "point data") ||
+      !CompareAttributes(ugA->GetCellData(), ugB->GetCellData(), "cell data"))
+    {
+      return false;
+    }
+    ++numLeaves;
+  }
+  if (numLeaves != NumBlocks)
+  {
+    std::cerr << "Expected " << NumBlocks << " blocks, got " << numLeaves << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void SetUpReader(vtkExodusIIReader* reader, const std::string& fname)
+{
+  reader->SetFileName(fname.c_str());
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+}
+
+}
+
+int TestExodusConcurrentReads(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fname = std::string(tempDir) + "/TestExodusConcurrentReads.exo";
+  delete[] tempDir;
+
+  if (!WriteTestFile(fname))
+  {
+    std::cerr << "Could not write " << fname << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkExodusIIReader> serial;
+  SetUpReader(serial, fname);
+
+  vtkNew<vtkExodusIIReader> concurrent;
+  concurrent->ConcurrentReadsOn();
+  SetUpReader(concurrent, fname);
+
+  vtkNew<vtkExodusIIReader> prefetch;
+  prefetch->PrefetchNextTimeStepOn();
+  prefetch->SetCacheSize(16.);
+  SetUpReader(prefetch, fname);
+
+  vtkNew<vtkExodusIIReader> both;
+  both->ConcurrentReadsOn();
+  both->PrefetchNextTimeStepOn();
+  both->SetCacheSize(16.);
+  SetUpReader(both, fname);
+
+  vtkExodusIIReader* readers[] = { concurrent, prefetch, both };
+  const char* names[] = { "ConcurrentReads", "PrefetchNextTimeStep", "both" };
+
+  // Step forward (the prefetch pattern), then jump backwards (a discarded prefetch).
+  int steps[] = { 0, 1, 2, 3, 1, 2 };
+  for (int s = 0; s < 6; ++s)
+  {
+    serial->SetTimeStep(steps[s]);
+    serial->Update();
+    for (int r = 0; r < 3; ++r)
+    {
+      readers[r]->SetTimeStep(steps[s]);
+      readers[r]->Update();
+      if (!CompareOutputs(serial->GetOutput(), readers[r]->GetOutput()))
+      {
+        std::cerr << names[r] << " differs from the serial reader at time step "
+                  << steps[s] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
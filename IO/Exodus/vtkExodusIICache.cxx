@@ -71,6 +71,7 @@ vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->PreferredTime = -1;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -85,6 +86,7 @@ void vtkExodusIICache::PrintSelf( ostream& os, vtkIndent indent )
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "PreferredTime: " << this->PreferredTime << "\n";
 }
 
 void vtkExodusIICache::Clear()
@@ -111,7 +113,24 @@ int vtkExodusIICache::ReduceToSize( double newSize )
   int deletedSomething = 0;
   while ( this->Size > newSize && ! this->LRU.empty() )
   {
-    vtkExodusIICacheRef cit( this->LRU.back() );
+    // The least recently used entry is at the back of the list. When a
+    // preferred time is set, skip over its entries as long as anything else
+    // is left to drop.
+    vtkExodusIICacheLRURef victim = --this->LRU.end();
+    if ( this->PreferredTime >= 0 )
+    {
+      vtkExodusIICacheLRURef lit = this->LRU.end();
+      while ( lit != this->LRU.begin() )
+      {
+        --lit;
+        if ( (*lit)->first.Time != this->PreferredTime )
+        {
+          victim = lit;
+          break;
+        }
+      }
+    }
+    vtkExodusIICacheRef cit( *victim );
     vtkDataArray* arr = cit->second->Value;
     if ( arr )
     {
@@ -138,7 +157,7 @@ int vtkExodusIICache::ReduceToSize( double newSize )
 
     delete cit->second;
     this->Cache.erase( cit );
-    this->LRU.pop_back();
+    this->LRU.erase( victim );
   }
 
   if ( this->Cache.empty() )
@@ -174,6 +174,16 @@ public:
     */
   int Invalidate( const vtkExodusIICacheKey& key, const vtkExodusIICacheKey& pattern );
 
+  /** Set/get the time step whose entries should be evicted last.
+    * When this is non-negative, entries of other time steps (including
+    * time-invariant entries) are dropped in LRU order before any entry
+    * with a matching key time is considered. The reader uses this to keep
+    * a prefetched time step resident while it is being consumed.
+    * The default (-1) gives plain LRU eviction.
+    */
+  vtkSetMacro(PreferredTime,int);
+  vtkGetMacro(PreferredTime,int);
+
 protected:
   /// Default constructor
   vtkExodusIICache();
@@ -202,6 +212,9 @@ protected:
   /// The actual LRU list (indices into the cache ordered least to most recently used).
   vtkExodusIICacheLRU LRU;
 
+  /// Entries with this key time are evicted last (see SetPreferredTime).
+  int PreferredTime;
+
 private:
   vtkExodusIICache( const vtkExodusIICache& ) = delete;
   void operator = ( const vtkExodusIICache& ) = delete;
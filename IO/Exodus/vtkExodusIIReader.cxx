@@ -31,12 +31,16 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkMutableDirectedGraph.h"
+#include "vtkMutexLock.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -382,6 +386,9 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
+  this->ConcurrentReads = 0;
+  this->PrefetchNextTimeStep = 0;
+  this->Prefetch = nullptr;
 
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
@@ -413,6 +420,8 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //-----------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->FinishPrefetch( -1, false );
+  this->ClearStagedArrays();
   this->CloseFile();
   this->Cache->Delete();
   this->CacheSize = 0;
@@ -1703,6 +1712,162 @@ void vtkExodusIIReaderPrivate::InsertSetSides(
   }
 }
 
+//-----------------------------------------------------------------------------
+// Reads a list of result arrays. Used as a vtkSMPTools functor, where each
+// worker reads through its own handle on the file, and by the prefetch
+// thread, which reads the whole list through one handle.
+class vtkExodusIIResultArrayReader
+{
+public:
+  typedef vtkExodusIIReaderPrivate::ResultArrayRequest Request;
+
+  vtkExodusIIResultArrayReader(
+    const std::string& fileName, int wordSize,
+    const std::vector<Request>& reqs, std::vector<vtkDataArray*>& arrays )
+    : FileName( fileName ), WordSize( wordSize ), Requests( reqs ), Arrays( arrays )
+  {
+  }
+
+  static int Open( const std::string& fileName, int wordSize )
+  {
+    int appWordSize = wordSize;
+    int diskWordSize = 8;
+    float version;
+    int exoid = ex_open( fileName.c_str(), EX_READ, &appWordSize, &diskWordSize, &version );
+#ifdef VTK_USE_64BIT_IDS
+    if ( exoid >= 0 )
+    {
+      ex_set_int64_status( exoid, EX_ALL_INT64_API );
+    }
+#endif
+    return exoid;
+  }
+
+  void Read( int exoid, vtkIdType i )
+  {
+    // Failures are not reported here; GetCacheOrRead will find nothing
+    // staged for the key and report the error when it tries again.
+    int failedComp;
+    this->Arrays[i] = vtkExodusIIReaderPrivate::ReadResultArray(
+      exoid, this->Requests[i], failedComp );
+  }
+
+  void Initialize()
+  {
+    this->Handle.Local() = -1;
+  }
+
+  void operator()( vtkIdType begin, vtkIdType end )
+  {
+    int& exoid = this->Handle.Local();
+    if ( exoid < 0 )
+    {
+      exoid = vtkExodusIIResultArrayReader::Open( this->FileName, this->WordSize );
+      if ( exoid < 0 )
+      {
+        return;
+      }
+    }
+    for ( vtkIdType i = begin; i < end; ++i )
+    {
+      this->Read( exoid, i );
+    }
+  }
+
+  void Reduce()
+  {
+    vtkSMPThreadLocal<int>::iterator it;
+    for ( it = this->Handle.begin(); it != this->Handle.end(); ++it )
+    {
+      if ( *it >= 0 )
+      {
+        ex_close( *it );
+      }
+    }
+  }
+
+protected:
+  const std::string& FileName;
+  int WordSize;
+  const std::vector<Request>& Requests;
+  std::vector<vtkDataArray*>& Arrays;
+  vtkSMPThreadLocal<int> Handle;
+};
+
+//-----------------------------------------------------------------------------
+// State shared between the reader and the thread prefetching a time step.
+// The thread only touches the members of this object.
+class vtkExodusIIPrefetchJob
+{
+public:
+  vtkExodusIIPrefetchJob()
+  {
+    this->TimeStep = -1;
+    this->WordSize = 8;
+    this->ThreadId = -1;
+    this->Cancelled = 0;
+    this->Threader = vtkMultiThreader::New();
+    this->Lock = vtkMutexLock::New();
+  }
+
+  ~vtkExodusIIPrefetchJob()
+  {
+    for ( size_t i = 0; i < this->Arrays.size(); ++i )
+    {
+      if ( this->Arrays[i] )
+      {
+        this->Arrays[i]->Delete();
+      }
+    }
+    this->Threader->Delete();
+    this->Lock->Delete();
+  }
+
+  bool IsCancelled()
+  {
+    this->Lock->Lock();
+    int cancelled = this->Cancelled;
+    this->Lock->Unlock();
+    return cancelled != 0;
+  }
+
+  void Cancel()
+  {
+    this->Lock->Lock();
+    this->Cancelled = 1;
+    this->Lock->Unlock();
+  }
+
+  static VTK_THREAD_RETURN_TYPE Run( void* arg )
+  {
+    vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>( arg );
+    vtkExodusIIPrefetchJob* self = static_cast<vtkExodusIIPrefetchJob*>( info->UserData );
+    int exoid = vtkExodusIIResultArrayReader::Open( self->FileName, self->WordSize );
+    if ( exoid >= 0 )
+    {
+      vtkExodusIIResultArrayReader reader(
+        self->FileName, self->WordSize, self->Requests, self->Arrays );
+      vtkIdType n = static_cast<vtkIdType>( self->Requests.size() );
+      for ( vtkIdType i = 0; i < n && ! self->IsCancelled(); ++i )
+      {
+        reader.Read( exoid, i );
+      }
+      ex_close( exoid );
+    }
+    return VTK_THREAD_RETURN_VALUE;
+  }
+
+  vtkIdType TimeStep;
+  std::string FileName;
+  int WordSize;
+  std::vector<vtkExodusIIReaderPrivate::ResultArrayRequest> Requests;
+  std::vector<vtkDataArray*> Arrays;
+  vtkMultiThreader* Threader;
+  int ThreadId;
+  vtkMutexLock* Lock;
+  int Cancelled;
+};
+
 //-----------------------------------------------------------------------------
 vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key )
 {
@@ -1723,6 +1888,18 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
     return arr;
   }
 
+  // Arrays read ahead of time (see ReadResultArraysConcurrently) only need to
+  // be handed over to the cache.
+  std::map<vtkExodusIICacheKey,vtkDataArray*>::iterator sit = this->StagedArrays.find( key );
+  if ( sit != this->StagedArrays.end() )
+  {
+    arr = sit->second;
+    this->StagedArrays.erase( sit );
+    this->Cache->Insert( key, arr );
+    arr->FastDelete();
+    return arr;
+  }
+
   int exoid = this->Exoid;
   int maxNameLength = this->Parent->GetMaxNameLength();
 
@@ -1753,76 +1930,14 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   {
     // read nodal array
     ArrayInfoType* ainfop = &this->ArrayInfo[vtkExodusIIReader::NODAL][key.ArrayId];
-    int ncomps = ( this->ModelParameters.num_dim == 2 && ainfop->Components == 2 ) ? 3 : ainfop->Components;
-    arr = vtkDataArray::CreateDataArray( ainfop->StorageType );
-    arr->SetName( ainfop->Name.c_str() );
-    arr->SetNumberOfComponents( ncomps );
-    arr->SetNumberOfTuples( this->ModelParameters.num_nodes );
-    if ( ncomps != ainfop->Components )
+    ResultArrayRequest req;
+    this->BuildResultArrayRequest( key, req );
+    int failedComp = 0;
+    arr = vtkExodusIIReaderPrivate::ReadResultArray( exoid, req, failedComp );
+    if ( ! arr )
     {
-      arr->FillComponent( 2, 0. );
-    }
-    if ( ncomps == 1 )
-    {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-          ainfop->OriginalIndices[0], 0, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0 )
-      {
-        vtkErrorMacro( "Could not read nodal result variable " << ainfop->Name.c_str() << "." );
-        arr->Delete();
-        arr = nullptr;
-      }
-    }
-    else
-    {
-      // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
-      std::vector<std::vector<double> > tmpVal;
-      tmpVal.resize( ainfop->Components );
-      int c;
-      for ( c = 0; c < ainfop->Components; ++c )
-      {
-        vtkIdType N = this->ModelParameters.num_nodes;
-        tmpVal[c].resize( N );
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-            ainfop->OriginalIndices[c], 0, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
-        {
-          vtkErrorMacro( "Could not read nodal result variable " << ainfop->OriginalNames[c].c_str() << "." );
-          arr->Delete();
-          arr = nullptr;
-          return nullptr;
-        }
-      }
-      int t;
-      std::vector<double> tmpTuple;
-      tmpTuple.resize( ncomps );
-      tmpTuple[ncomps - 1] = 0.; // In case we're embedding a 2-D vector in 3-D
-
-      //
-      // Lets unroll the most common case - components == 3.
-      //
-      if ( ainfop->Components == 3)
-      {
-        int maxTuples =  arr->GetNumberOfTuples();
-        for ( t = 0; t < maxTuples; ++t )
-        {
-          tmpTuple[0] = tmpVal[0][t];
-          tmpTuple[1] = tmpVal[1][t];
-          tmpTuple[2] = tmpVal[2][t];
-          arr->SetTuple( t, &tmpTuple[0] );
-        }
-      }
-      else
-      {
-        for ( t = 0; t < arr->GetNumberOfTuples(); ++t )
-        {
-          for ( c = 0; c < ainfop->Components; ++c )
-          {
-            tmpTuple[c] = tmpVal[c][t];
-          }
-          arr->SetTuple( t, &tmpTuple[0] );
-        }
-      }
+      vtkErrorMacro( "Could not read nodal result variable " << ( ainfop->Components == 1 ?
+          ainfop->Name.c_str() : ainfop->OriginalNames[failedComp].c_str() ) << "." );
     }
   }
   else if ( key.ObjectType == vtkExodusIIReader::GLOBAL_TEMPORAL )
@@ -1998,67 +2113,15 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   {
     int otypidx = this->GetObjectTypeIndexFromObjectType( key.ObjectType );
     ArrayInfoType* ainfop = &this->ArrayInfo[key.ObjectType][key.ArrayId];
-    ObjectInfoType* oinfop = this->GetObjectInfo( otypidx, key.ObjectId );
-
-    arr = vtkDataArray::CreateDataArray( ainfop->StorageType );
-    arr->SetName( ainfop->Name.c_str() );
-    if ( ainfop->Components == 2 && this->ModelParameters.num_dim == 2 )
-    {
-      // Promote 2-component arrays to 3-component arrays when we have 2-D coordinates
-      arr->SetNumberOfComponents( 3 );
-    }
-    else
-    {
-      arr->SetNumberOfComponents( ainfop->Components );
-    }
-    arr->SetNumberOfTuples( oinfop->Size );
-    if ( ainfop->Components == 1 )
-    {
-      if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-          ainfop->OriginalIndices[0], oinfop->Id, arr->GetNumberOfTuples(),
-          arr->GetVoidPointer( 0 ) ) < 0)
-      {
-        vtkErrorMacro( "Could not read result variable " << ainfop->Name.c_str() <<
-          " for " << objtype_names[otypidx] << " " << oinfop->Id << "." );
-        arr->Delete();
-        arr = nullptr;
-      }
-    }
-    else
+    ResultArrayRequest req;
+    this->BuildResultArrayRequest( key, req );
+    int failedComp = 0;
+    arr = vtkExodusIIReaderPrivate::ReadResultArray( exoid, req, failedComp );
+    if ( ! arr )
     {
-      // Exodus doesn't support reading with a stride, so we have to manually interleave the arrays. Bleh.
-      std::vector<std::vector<double> > tmpVal;
-      tmpVal.resize( ainfop->Components );
-      int c;
-      for ( c = 0; c < ainfop->Components; ++c )
-      {
-        vtkIdType N = arr->GetNumberOfTuples();
-        tmpVal[c].resize( N+1 ); // + 1 to avoid errors when N == 0.
-                                 // BUG #8746.
-        if ( ex_get_var( exoid, key.Time + 1, static_cast<ex_entity_type>( key.ObjectType ),
-            ainfop->OriginalIndices[c], oinfop->Id, arr->GetNumberOfTuples(),
-            &tmpVal[c][0] ) < 0)
-        {
-          vtkErrorMacro( "Could not read result variable " << ainfop->OriginalNames[c].c_str() <<
-            " for " << objtype_names[otypidx] << " " << oinfop->Id << "." );
-          arr->Delete();
-          arr = nullptr;
-        }
-      }
-      // Carefully use arr->GetNumberOfComponents() when sizing
-      // output as we may have promoted 2-D arrays to 3-D.
-      int t = arr->GetNumberOfComponents();
-      std::vector<double> tmpTuple;
-      tmpTuple.resize( t );
-      tmpTuple[t - 1] = 0.;
-      for ( t = 0; t < arr->GetNumberOfTuples(); ++t )
-      {
-        for ( c = 0; c < ainfop->Components; ++c )
-        {
-          tmpTuple[c] = tmpVal[c][t];
-        }
-        arr->SetTuple( t, &tmpTuple[0] );
-      }
+      vtkErrorMacro( "Could not read result variable " << ( ainfop->Components == 1 ?
+          ainfop->Name.c_str() : ainfop->OriginalNames[failedComp].c_str() ) <<
+        " for " << objtype_names[otypidx] << " " << req.EntityId << "." );
     }
   }
   else if (
@@ -2956,6 +3019,314 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead( vtkExodusIICacheKey key
   return arr;
 }
 
+//-----------------------------------------------------------------------------
+bool vtkExodusIIReaderPrivate::BuildResultArrayRequest(
+  const vtkExodusIICacheKey& key, ResultArrayRequest& req )
+{
+  ArrayInfoType* ainfop;
+  if ( key.ObjectType == vtkExodusIIReader::NODAL )
+  {
+    ainfop = &this->ArrayInfo[vtkExodusIIReader::NODAL][key.ArrayId];
+    req.EntityId = 0;
+    req.NumberOfTuples = this->ModelParameters.num_nodes;
+  }
+  else if (
+    key.ObjectType == vtkExodusIIReader::EDGE_BLOCK ||
+    key.ObjectType == vtkExodusIIReader::FACE_BLOCK ||
+    key.ObjectType == vtkExodusIIReader::ELEM_BLOCK ||
+    key.ObjectType == vtkExodusIIReader::NODE_SET ||
+    key.ObjectType == vtkExodusIIReader::EDGE_SET ||
+    key.ObjectType == vtkExodusIIReader::FACE_SET ||
+    key.ObjectType == vtkExodusIIReader::SIDE_SET ||
+    key.ObjectType == vtkExodusIIReader::ELEM_SET
+    )
+  {
+    int otypidx = this->GetObjectTypeIndexFromObjectType( key.ObjectType );
+    ObjectInfoType* oinfop = this->GetObjectInfo( otypidx, key.ObjectId );
+    ainfop = &this->ArrayInfo[key.ObjectType][key.ArrayId];
+    req.EntityId = oinfop->Id;
+    req.NumberOfTuples = oinfop->Size;
+  }
+  else
+  {
+    return false;
+  }
+
+  req.Key = key;
+  req.EntityType = key.ObjectType;
+  req.StorageType = ainfop->StorageType;
+  // Promote 2-component arrays to 3-component arrays when we have 2-D coordinates
+  req.NumberOfComponents =
+    ( ainfop->Components == 2 && this->ModelParameters.num_dim == 2 ) ? 3 : ainfop->Components;
+  req.OriginalIndices = ainfop->OriginalIndices;
+  req.Name = ainfop->Name;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+vtkDataArray* vtkExodusIIReaderPrivate::ReadResultArray(
+  int exoid, const ResultArrayRequest& req, int& failedComponent )
+{
+  failedComponent = 0;
+  ex_entity_type etype = static_cast<ex_entity_type>( req.EntityType );
+  int nFileComps = static_cast<int>( req.OriginalIndices.size() );
+  vtkIdType N = req.NumberOfTuples;
+
+  vtkDataArray* arr = vtkDataArray::CreateDataArray( req.StorageType );
+  arr->SetName( req.Name.c_str() );
+  arr->SetNumberOfComponents( req.NumberOfComponents );
+  arr->SetNumberOfTuples( N );
+  if ( nFileComps == 1 )
+  {
+    if ( ex_get_var( exoid, req.Key.Time + 1, etype,
+        req.OriginalIndices[0], req.EntityId, N, arr->GetVoidPointer( 0 ) ) < 0 )
+    {
+      arr->Delete();
+      return nullptr;
+    }
+    return arr;
+  }
+
+  if ( nFileComps < req.NumberOfComponents )
+  {
+    // In case we're embedding a 2-D vector in 3-D
+    arr->FillComponent( req.NumberOfComponents - 1, 0. );
+  }
+
+  // Exodus doesn't support reading with a stride, so we have to manually
+  // interleave the arrays, one component at a time.
+  std::vector<double> tmpVal( N + 1 ); // + 1 to avoid errors when N == 0. BUG #8746.
+  vtkDoubleArray* darr = vtkArrayDownCast<vtkDoubleArray>( arr );
+  int nc = req.NumberOfComponents;
+  for ( int c = 0; c < nFileComps; ++c )
+  {
+    if ( ex_get_var( exoid, req.Key.Time + 1, etype,
+        req.OriginalIndices[c], req.EntityId, N, &tmpVal[0] ) < 0 )
+    {
+      failedComponent = c;
+      arr->Delete();
+      return nullptr;
+    }
+    if ( darr )
+    {
+      double* dst = darr->GetPointer( 0 ) + c;
+      for ( vtkIdType t = 0; t < N; ++t, dst += nc )
+      {
+        *dst = tmpVal[t];
+      }
+    }
+    else
+    {
+      for ( vtkIdType t = 0; t < N; ++t )
+      {
+        arr->SetComponent( t, c, tmpVal[t] );
+      }
+    }
+  }
+  return arr;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::CollectResultArrayRequests(
+  vtkIdType timeStep, std::vector<ResultArrayRequest>& reqs )
+{
+  // Mirror the block and array selection logic of RequestData and
+  // AssembleOutputCellArrays/AssembleOutputPointArrays.
+  bool haveObjects = false;
+  for ( int conntypidx = 0; conntypidx < num_conn_types; ++conntypidx )
+  {
+    int otypidx = conn_obj_idx_cvt[conntypidx];
+    int otyp = obj_types[otypidx];
+    int numObj = this->GetNumberOfObjectsOfType( otyp );
+    std::map<int,std::vector<ArrayInfoType> >::iterator ami = this->ArrayInfo.find( otyp );
+    for ( int obj = 0; obj < numObj; ++obj )
+    {
+      BlockSetInfoType* bsinfop = static_cast<BlockSetInfoType*>( this->GetObjectInfo( otypidx, obj ) );
+      if ( ! bsinfop->Status )
+      {
+        continue;
+      }
+      haveObjects = true;
+      if ( ami == this->ArrayInfo.end() )
+      {
+        continue;
+      }
+      int aidx = 0;
+      std::vector<ArrayInfoType>::iterator ai;
+      for ( ai = ami->second.begin(); ai != ami->second.end(); ++ai, ++aidx )
+      {
+        if ( ! ai->Status || ! ai->ObjectTruth[obj] )
+        {
+          continue;
+        }
+        ResultArrayRequest req;
+        if ( this->BuildResultArrayRequest( vtkExodusIICacheKey( timeStep, otyp, obj, aidx ), req ) )
+        {
+          reqs.push_back( req );
+        }
+      }
+    }
+  }
+
+  if ( ! haveObjects )
+  {
+    return;
+  }
+  int aidx = 0;
+  std::vector<ArrayInfoType>::iterator ai;
+  for (
+    ai = this->ArrayInfo[ vtkExodusIIReader::NODAL ].begin();
+    ai != this->ArrayInfo[ vtkExodusIIReader::NODAL ].end();
+    ++ai, ++aidx )
+  {
+    if ( ! ai->Status )
+    {
+      continue;
+    }
+    ResultArrayRequest req;
+    if ( this->BuildResultArrayRequest(
+        vtkExodusIICacheKey( timeStep, vtkExodusIIReader::NODAL, 0, aidx ), req ) )
+    {
+      reqs.push_back( req );
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::ReadResultArraysConcurrently( vtkIdType timeStep )
+{
+  std::vector<ResultArrayRequest> all;
+  this->CollectResultArrayRequests( timeStep, all );
+  std::vector<ResultArrayRequest> reqs;
+  for ( size_t i = 0; i < all.size(); ++i )
+  {
+    if ( ! this->Cache->Find( all[i].Key ) &&
+      this->StagedArrays.find( all[i].Key ) == this->StagedArrays.end() )
+    {
+      reqs.push_back( all[i] );
+    }
+  }
+  if ( reqs.empty() )
+  {
+    return;
+  }
+
+  std::vector<vtkDataArray*> arrays( reqs.size(), nullptr );
+  std::string fileName = this->Parent->GetFileName();
+  vtkExodusIIResultArrayReader reader( fileName, this->AppWordSize, reqs, arrays );
+#if defined(EXODUS_THREADSAFE)
+  vtkSMPTools::For( 0, static_cast<vtkIdType>( reqs.size() ), reader );
+#else
+  // The Exodus library does not guard its own state: stay on the open handle.
+  for ( vtkIdType i = 0; i < static_cast<vtkIdType>( reqs.size() ); ++i )
+  {
+    reader.Read( this->Exoid, i );
+  }
+#endif
+
+  for ( size_t i = 0; i < reqs.size(); ++i )
+  {
+    if ( arrays[i] )
+    {
+      this->StagedArrays[reqs[i].Key] = arrays[i];
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::StartPrefetch( vtkIdType timeStep )
+{
+#if defined(EXODUS_THREADSAFE)
+  if ( this->Prefetch || timeStep < 0 || timeStep >= this->GetNumberOfTimeSteps() )
+  {
+    return;
+  }
+
+  std::vector<ResultArrayRequest> all;
+  this->CollectResultArrayRequests( timeStep, all );
+  vtkExodusIIPrefetchJob* job = new vtkExodusIIPrefetchJob;
+  double sizeInMiB = 0.;
+  for ( size_t i = 0; i < all.size(); ++i )
+  {
+    if ( this->Cache->Find( all[i].Key ) )
+    {
+      continue;
+    }
+    sizeInMiB += static_cast<double>( all[i].NumberOfTuples ) *
+      all[i].NumberOfComponents * sizeof( double ) / 1048576.;
+    job->Requests.push_back( all[i] );
+  }
+
+  // Prefetched arrays live in the cache until they are used, so the cache
+  // size is the memory budget of the prefetch.
+  if ( job->Requests.empty() || sizeInMiB > this->CacheSize )
+  {
+    delete job;
+    return;
+  }
+
+  job->TimeStep = timeStep;
+  job->FileName = this->Parent->GetFileName();
+  job->WordSize = this->AppWordSize;
+  job->Arrays.resize( job->Requests.size(), nullptr );
+  job->ThreadId = job->Threader->SpawnThread( vtkExodusIIPrefetchJob::Run, job );
+  if ( job->ThreadId < 0 )
+  {
+    delete job;
+    return;
+  }
+  this->Prefetch = job;
+#else
+  (void)timeStep;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::FinishPrefetch( vtkIdType timeStep, bool keep )
+{
+  this->Cache->SetPreferredTime( -1 );
+  vtkExodusIIPrefetchJob* job = this->Prefetch;
+  if ( ! job )
+  {
+    return;
+  }
+  this->Prefetch = nullptr;
+
+  keep = keep && job->TimeStep == timeStep;
+  if ( ! keep )
+  {
+    job->Cancel();
+  }
+  job->Threader->TerminateThread( job->ThreadId );
+
+  if ( keep )
+  {
+    // Keep the prefetched step in the cache while it is being assembled.
+    this->Cache->SetPreferredTime( static_cast<int>( timeStep ) );
+    for ( size_t i = 0; i < job->Arrays.size(); ++i )
+    {
+      if ( job->Arrays[i] )
+      {
+        this->Cache->Insert( job->Requests[i].Key, job->Arrays[i] );
+        job->Arrays[i]->Delete();
+        job->Arrays[i] = nullptr;
+      }
+    }
+  }
+  delete job;
+}
+
+//-----------------------------------------------------------------------------
+void vtkExodusIIReaderPrivate::ClearStagedArrays()
+{
+  std::map<vtkExodusIICacheKey,vtkDataArray*>::iterator it;
+  for ( it = this->StagedArrays.begin(); it != this->StagedArrays.end(); ++it )
+  {
+    it->second->Delete();
+  }
+  this->StagedArrays.clear();
+}
+
 //-----------------------------------------------------------------------------
 int vtkExodusIIReaderPrivate::GetConnTypeIndexFromConnType( int ctyp )
 {
@@ -3751,6 +4122,8 @@ void vtkExodusIIReaderPrivate::PrintData( ostream& os, vtkIndent indent )
   this->Cache->PrintSelf( os, inden2 );
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
+  os << indent << "ConcurrentReads: " << this->ConcurrentReads << "\n";
+  os << indent << "PrefetchNextTimeStep: " << this->PrefetchNextTimeStep << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
   os << indent << "DisplacementMagnitude: " << this->DisplacementMagnitude << "\n";
   os << indent << "GenerateObjectIdArray: " << this->GenerateObjectIdArray << "\n";
@@ -4419,6 +4792,14 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     vtkErrorMacro( "You must specify an output mesh" );
   }
 
+  // Pick up the arrays read ahead of time for this step, if any, then
+  // read what is still missing in one batch.
+  this->FinishPrefetch( timeStep, true );
+  if ( this->ConcurrentReads )
+  {
+    this->ReadResultArraysConcurrently( timeStep );
+  }
+
   // Iterate over all block and set types, creating a
   // multiblock dataset to hold objects of each type.
   int conntypidx;
@@ -4502,6 +4883,12 @@ int vtkExodusIIReaderPrivate::RequestData( vtkIdType timeStep, vtkMultiBlockData
     }
   }
 
+  this->ClearStagedArrays();
+  if ( this->PrefetchNextTimeStep )
+  {
+    this->StartPrefetch( timeStep + 1 );
+  }
+
   this->CloseFile();
 
   return 0;
@@ -4641,6 +5028,8 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid( vtkMultiBlockDataSet* output )
 
 void vtkExodusIIReaderPrivate::Reset()
 {
+  this->FinishPrefetch( -1, false );
+  this->ClearStagedArrays();
   this->CloseFile();
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
@@ -4682,6 +5071,9 @@ void vtkExodusIIReaderPrivate::ResetSettings()
 
   this->SqueezePoints = 1;
 
+  this->ConcurrentReads = 0;
+  this->PrefetchNextTimeStep = 0;
+
   this->InitialArrayInfo.clear();
   this->InitialObjectInfo.clear();
 }
@@ -6417,6 +6809,26 @@ double vtkExodusIIReader::GetCacheSize()
   return this->Metadata->GetCacheSize();
 }
 
+void vtkExodusIIReader::SetConcurrentReads( vtkTypeBool c )
+{
+  this->Metadata->SetConcurrentReads( c );
+}
+
+vtkTypeBool vtkExodusIIReader::GetConcurrentReads()
+{
+  return this->Metadata->GetConcurrentReads();
+}
+
+void vtkExodusIIReader::SetPrefetchNextTimeStep( vtkTypeBool p )
+{
+  this->Metadata->SetPrefetchNextTimeStep( p );
+}
+
+vtkTypeBool vtkExodusIIReader::GetPrefetchNextTimeStep()
+{
+  return this->Metadata->GetPrefetchNextTimeStep();
+}
+
 void vtkExodusIIReader::SetSqueezePoints(bool sp)
 {
   this->Metadata->SetSqueezePoints(sp ? 1 : 0);
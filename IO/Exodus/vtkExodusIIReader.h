@@ -751,6 +751,33 @@ public:
    */
   double GetCacheSize();
 
+  //@{
+  /**
+   * When on, the result variables of a time step are read as one batch,
+   * with the reads for independent blocks, sets and variables spread over
+   * vtkSMPTools workers that each open their own handle to the file.
+   * The Exodus library serializes its own calls, so this mostly overlaps
+   * the conversion and interleaving of values with the file access.
+   * Off by default.
+   */
+  void SetConcurrentReads( vtkTypeBool c );
+  vtkTypeBool GetConcurrentReads();
+  vtkBooleanMacro(ConcurrentReads, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * When on, the result variables of the next time step are read on a
+   * background thread once a time step has been produced, so that stepping
+   * forward through time finds them in the cache. The prefetch is skipped
+   * when it would not fit in the cache (see SetCacheSize()), and the cache
+   * evicts other entries before the prefetched ones. Off by default.
+   */
+  void SetPrefetchNextTimeStep( vtkTypeBool p );
+  vtkTypeBool GetPrefetchNextTimeStep();
+  vtkBooleanMacro(PrefetchNextTimeStep, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Should the reader output only points used by elements in the output mesh,
@@ -13,6 +13,7 @@
 
 #include "vtk_exodusII.h"
 #include "vtkIOExodusModule.h" // For export macro
+class vtkExodusIIPrefetchJob;
 class vtkExodusIIReaderParser;
 class vtkMutableDirectedGraph;
 class vtkTypeInt64Array;
@@ -78,6 +79,27 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /** Should the result variables of a time step be read as one batch, with
+    * the reads for independent blocks, sets and variables spread over
+    * vtkSMPTools workers that each open their own handle to the file?
+    * The Exodus library serializes its own calls when it is built thread-safe,
+    * so the overlap is in converting and interleaving the values rather than
+    * in the netCDF/HDF5 reads themselves. Without a thread-safe Exodus
+    * library the batch is read serially. Off by default.
+    */
+  vtkSetMacro(ConcurrentReads,vtkTypeBool);
+  vtkGetMacro(ConcurrentReads,vtkTypeBool);
+
+  /** Should the result variables of the next time step be read on a
+    * background thread after a time step has been produced?
+    * Prefetched arrays are handed to the cache when that step is requested,
+    * and the cache evicts other entries before them. A prefetch is only
+    * started when its estimated size fits in the cache (see SetCacheSize)
+    * and the Exodus library is thread-safe. Off by default.
+    */
+  vtkSetMacro(PrefetchNextTimeStep,vtkTypeBool);
+  vtkGetMacro(PrefetchNextTimeStep,vtkTypeBool);
+
   /** Return the number of time steps in the open file.
     * You must have called RequestInformation() before
     * invoking this member function.
@@ -411,6 +433,8 @@ public:
 
   friend class vtkExodusIIReader;
   friend class vtkPExodusIIReader;
+  friend class vtkExodusIIPrefetchJob;
+  friend class vtkExodusIIResultArrayReader;
 
   virtual void SetParser( vtkExodusIIReaderParser* );
   vtkGetObjectMacro(Parser,vtkExodusIIReaderParser);
@@ -638,6 +662,58 @@ protected:
     */
   vtkDataArray* GetCacheOrRead( vtkExodusIICacheKey );
 
+  /** Everything needed to read one time-varying result array (nodal, block or
+    * set variable) from a file handle, copied out of the metadata so that the
+    * read does not touch this object and may run on any thread.
+    */
+  struct ResultArrayRequest
+  {
+    vtkExodusIICacheKey Key;
+    int EntityType;
+    vtkIdType EntityId;
+    vtkIdType NumberOfTuples;
+    int StorageType;
+    int NumberOfComponents;
+    std::vector<int> OriginalIndices;
+    vtkStdString Name;
+  };
+
+  /** Fill \a req for a NODAL, block or set result key.
+    * Returns false for any other kind of key.
+    */
+  bool BuildResultArrayRequest(
+    const vtkExodusIICacheKey& key, ResultArrayRequest& req );
+
+  /** Read the array described by \a req from the open file \a exoid.
+    * Returns nullptr on failure and sets \a failedComponent to the index of
+    * the component that could not be read.
+    */
+  static vtkDataArray* ReadResultArray(
+    int exoid, const ResultArrayRequest& req, int& failedComponent );
+
+  /** Build the requests for every result array RequestData will use at
+    * \a timeStep given the current block, set and array selections.
+    */
+  void CollectResultArrayRequests(
+    vtkIdType timeStep, std::vector<ResultArrayRequest>& reqs );
+
+  /** Read the result arrays of \a timeStep that are not cached yet as a
+    * single batch (see ConcurrentReads) and stage them for GetCacheOrRead.
+    */
+  void ReadResultArraysConcurrently( vtkIdType timeStep );
+
+  /// Start reading \a timeStep on a background thread (see PrefetchNextTimeStep).
+  void StartPrefetch( vtkIdType timeStep );
+
+  /** Wait for the background prefetch to end. When \a keep is true and
+    * the prefetched step is \a timeStep, its arrays are inserted into the
+    * cache; otherwise the prefetch is cancelled and its arrays discarded.
+    */
+  void FinishPrefetch( vtkIdType timeStep, bool keep );
+
+  /// Release any staged arrays that were not consumed by GetCacheOrRead.
+  void ClearStagedArrays();
+
   /** Return the index of an object type (in a private list of all object types).
     * This returns a 0-based index if the object type was found and -1 if it
     * was not.
@@ -824,6 +900,17 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  vtkTypeBool ConcurrentReads;
+  vtkTypeBool PrefetchNextTimeStep;
+
+  /** Arrays read ahead of time by ReadResultArraysConcurrently, waiting to
+    * be handed to the cache by GetCacheOrRead.
+    */
+  std::map<vtkExodusIICacheKey,vtkDataArray*> StagedArrays;
+
+  /// State shared with the background prefetch thread (nullptr when idle).
+  vtkExodusIIPrefetchJob* Prefetch;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
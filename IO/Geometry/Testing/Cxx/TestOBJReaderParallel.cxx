@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBJReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that parallel parsing in vtkOBJReader gives the same output as
+// serial parsing, on a file large enough to be split into several chunks.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+bool CompareArrays(vtkDataArray* a, vtkDataArray* b, const char* what)
+{
+  if ((a == nullptr) != (b == nullptr))
+  {
+    std::cerr << what << ": presence differs" << std::endl;
+    return false;
+  }
+  if (!a)
+  {
+    return true;
+  }
+  if (a->GetNumberOfTuples() != b->GetNumberOfTuples() ||
+      a->GetNumberOfComponents() != b->GetNumberOfComponents())
+  {
+    std::cerr << what << ": size differs" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfTuples(); ++i)
+  {
+    for (int c = 0; c < a->GetNumberOfComponents(); ++c)
+    {
+      if (a->GetComponent(i, c) != b->GetComponent(i, c))
+      {
+        std::cerr << what << ": differs at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareCells(vtkCellArray* a, vtkCellArray* b, const char* what)
+{
+  if (a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    std::cerr << what << ": number of cells differs" << std::endl;
+    return false;
+  }
+  return CompareArrays(a->GetData(), b->GetData(), what);
+}
+
+bool CompareOutputs(vtkOBJReader* serial, vtkOBJReader* parallel)
+{
+  vtkPolyData* a = serial->GetOutput();
+  vtkPolyData* b = parallel->GetOutput();
+  bool ok = std::string(serial->GetComment()) == parallel->GetComment();
+  ok = ok && CompareArrays(a->GetPoints()->GetData(), b->GetPoints()->GetData(), "points");
+  ok = ok && CompareCells(a->GetPolys(), b->GetPolys(), "polys");
+  ok = ok && CompareCells(a->GetLines(), b->GetLines(), "lines");
+  ok = ok && CompareCells(a->GetVerts(), b->GetVerts(), "verts");
+  ok = ok && CompareArrays(a->GetPointData()->GetNormals(), b->GetPointData()->GetNormals(), "normals");
+  ok = ok && CompareArrays(a->GetPointData()->GetTCoords(), b->GetPointData()->GetTCoords(), "tcoords");
+  ok = ok && a->GetPointData()->GetNumberOfArrays() == b->GetPointData()->GetNumberOfArrays();
+  for (int i = 0; ok && i < a->GetPointData()->GetNumberOfArrays(); ++i)
+  {
+    ok = CompareArrays(a->GetPointData()->GetArray(i), b->GetPointData()->GetArray(i),
+                       a->GetPointData()->GetArrayName(i));
+  }
+  ok = ok && CompareArrays(a->GetCellData()->GetArray("GroupIds"),
+                           b->GetCellData()->GetArray("GroupIds"), "group ids");
+  ok = ok && CompareArrays(a->GetCellData()->GetArray("MaterialIds"),
+                           b->GetCellData()->GetArray("MaterialIds"), "material ids");
+  ok = ok && a->GetFieldData()->GetNumberOfArrays() == b->GetFieldData()->GetNumberOfArrays();
+  return ok;
+}
+
+} // end anon namespace
+
+int TestOBJReaderParallel(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  // A grid of quads split into bands, each with its own group and material.
+  // Faces use absolute and relative indices in all supported forms.
+  const int res = 400;
+  std::string fileName = testDirectory + "/TestOBJReaderParallel.obj";
+  {
+    std::ofstream out(fileName.c_str());
+    out << "# Generated by TestOBJReaderParallel\n#  second comment line\n";
+    for (int j = 0; j < res; ++j)
+    {
+      for (int i = 0; i < res; ++i)
+      {
+        out << "v " << i << " " << j << " " << ((i * j) % 7) * 0.125 << "\n";
+        out << "vt " << i / double(res) << " " << j / double(res) << "\n";
+        out << "vn 0 0 1\n";
+      }
+    }
+    for (int j = 0; j + 1 < res; ++j)
+    {
+      if (j % 50 == 0)
+      {
+        out << "g band" << j << "\n";
+        out << "usemtl mat" << (j / 50) % 3 << "\n";
+      }
+      for (int i = 0; i + 1 < res; ++i)
+      {
+        int a = j * res + i + 1;
+        int b = a + 1;
+        int c = a + res + 1;
+        int d = a + res;
+        switch ((i + j) % 4)
+        {
+          case 0:
+            out << "f " << a << " " << b << " " << c << " " << d << "\n";
+            break;
+          case 1:
+            out << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b
+                << " " << c << "/" << c << "/" << c << "\n";
+            break;
+          case 2:
+            out << "f " << a << "//" << a << " " << b << "//" << b << " \\\n"
+                << "  " << c << "//" << c << "\n";
+            break;
+          default:
+            out << "f " << a - res * res - 1 << "/" << b << " " << b << "/" << a
+                << " " << d << "/" << d << "\n";
+            break;
+        }
+      }
+      out << "l " << j * res + 1 << " " << -1 << "\n";
+    }
+    out << "p 1 2 3\n";
+  }
+
+  vtkNew<vtkOBJReader> serial;
+  serial->SetFileName(fileName.c_str());
+  serial->Update();
+
+  vtkNew<vtkOBJReader> parallel;
+  parallel->SetFileName(fileName.c_str());
+  parallel->ParallelParsingOn();
+  parallel->Update();
+
+  if (!CompareOutputs(serial, parallel))
+  {
+    std::cerr << "Parallel parsing differs from serial parsing" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel parsing and merging paths of vtkSTLReader produce
+// exactly the same output as the serial reader.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+bool ComparePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+      a->GetNumberOfPolys() != b->GetNumberOfPolys())
+  {
+    std::cerr << "Size mismatch: " << a->GetNumberOfPoints() << "/"
+              << a->GetNumberOfPolys() << " vs " << b->GetNumberOfPoints()
+              << "/" << b->GetNumberOfPolys() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    a->GetPoint(i, x);
+    b->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  vtkIdTypeArray* ca = a->GetPolys()->GetData();
+  vtkIdTypeArray* cb = b->GetPolys()->GetData();
+  if (ca->GetNumberOfValues() != cb->GetNumberOfValues())
+  {
+    std::cerr << "Connectivity size differs" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < ca->GetNumberOfValues(); ++i)
+  {
+    if (ca->GetValue(i) != cb->GetValue(i))
+    {
+      std::cerr << "Connectivity differs at " << i << std::endl;
+      return false;
+    }
+  }
+  vtkDataArray* sa = a->GetCellData()->GetScalars();
+  vtkDataArray* sb = b->GetCellData()->GetScalars();
+  if ((sa == nullptr) != (sb == nullptr))
+  {
+    std::cerr << "Scalars presence differs" << std::endl;
+    return false;
+  }
+  if (sa)
+  {
+    for (vtkIdType i = 0; i < sa->GetNumberOfTuples(); ++i)
+    {
+      if (sa->GetTuple1(i) != sb->GetTuple1(i))
+      {
+        std::cerr << "Scalars differ at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool CompareReaders(const std::string& fileName, bool merging, bool scalarTags)
+{
+  vtkNew<vtkSTLReader> serial;
+  serial->SetFileName(fileName.c_str());
+  serial->SetMerging(merging);
+  serial->SetScalarTags(scalarTags);
+  serial->Update();
+
+  vtkNew<vtkSTLReader> parallel;
+  parallel->SetFileName(fileName.c_str());
+  parallel->SetMerging(merging);
+  parallel->SetScalarTags(scalarTags);
+  parallel->ParallelParsingOn();
+  parallel->ParallelMergingOn();
+  parallel->Update();
+
+  const char* h1 = serial->GetHeader();
+  const char* h2 = parallel->GetHeader();
+  if (std::string(h1 ? h1 : "") != std::string(h2 ? h2 : ""))
+  {
+    std::cerr << "Header differs for " << fileName << std::endl;
+    return false;
+  }
+  if (!ComparePolyData(serial->GetOutput(), parallel->GetOutput()))
+  {
+    std::cerr << "Output differs for " << fileName << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // end anon namespace
+
+int TestSTLReaderParallel(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  if (!tempDir)
+  {
+    std::cout << "Could not determine temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  std::string testDirectory = tempDir;
+  delete[] tempDir;
+
+  // Large enough to be split into several chunks.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+
+  vtkNew<vtkSTLWriter> writer;
+  writer->SetInputConnection(sphere->GetOutputPort());
+
+  std::string asciiName = testDirectory + "/TestSTLReaderParallelASCII.stl";
+  writer->SetFileName(asciiName.c_str());
+  writer->SetFileTypeToASCII();
+  writer->Write();
+
+  std::string binaryName = testDirectory + "/TestSTLReaderParallelBinary.stl";
+  writer->SetFileName(binaryName.c_str());
+  writer->SetFileTypeToBinary();
+  writer->Write();
+
+  // Two solids, a degenerate triangle, a blank line and mixed case tokens.
+  std::string solidsName = testDirectory + "/TestSTLReaderParallelSolids.stl";
+  {
+    std::ofstream out(solidsName.c_str());
+    out << "solid first\n"
+           "facet normal 0 0 1\n outer loop\n"
+           "  vertex 0 0 0\n  vertex 1 0 0\n  vertex 0 1 0\n"
+           " endloop\nendfacet\n"
+           "\n"
+           "FACET normal 0 0 1\n OUTER loop\n"
+           "  VERTEX 0 0 0\n  vertex 1 0 0\n  vertex 0 0 0\n"
+           " endloop\nendfacet\n"
+           "endsolid first\n"
+           "solid second\n"
+           "color 1 0 0\n"
+           "facet normal 0 0 1\n outer loop\n"
+           "  vertex 1 0 0\n  vertex 1 1 0\n  vertex -0 1 0\n"
+           " endloop\nendfacet\n"
+           "endsolid second\n";
+  }
+
+  int status = EXIT_SUCCESS;
+  const std::string files[] = { asciiName, binaryName, solidsName };
+  for (const std::string& fileName : files)
+  {
+    if (!CompareReaders(fileName, true, true) ||
+        !CompareReaders(fileName, false, true) ||
+        !CompareReaders(fileName, true, false))
+    {
+      status = EXIT_FAILURE;
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,53 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkGeometryReaderInternals.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkGeometryReaderInternals
+ * @brief   private helpers of the geometry readers
+ *
+ * Helpers shared by the parallel parsing paths of vtkSTLReader and
+ * vtkOBJReader. This header is not installed.
+*/
+
+#ifndef vtkGeometryReaderInternals_h
+#define vtkGeometryReaderInternals_h
+
+#include <cstdio>
+#include <vector>
+
+// Read the remainder of an open file into memory. A terminating null is
+// appended so that strtod() and friends cannot run past the end of the
+// data; the size of the file data is buffer.size() - 1. Returns false on a
+// read error.
+inline bool vtkReadFileRemainder(FILE *fp, std::vector<char>& buffer)
+{
+  const size_t blockSize = 1 << 24;
+  size_t size = 0;
+  for (;;)
+  {
+    buffer.resize(size + blockSize);
+    size_t numRead = fread(buffer.data() + size, 1, blockSize, fp);
+    size += numRead;
+    if (numRead < blockSize)
+    {
+      break;
+    }
+  }
+  buffer.resize(size + 1);
+  buffer[size] = '\0';
+  return ferror(fp) == 0;
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkGeometryReaderInternals.h
@@ -16,13 +16,19 @@
 
 #include "vtkCellArray.h"
 #include "vtkFloatArray.h"
+#include "vtkGeometryReaderInternals.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "vtkCellData.h"
 #include "vtkStringArray.h"
@@ -35,6 +41,7 @@ vtkOBJReader::vtkOBJReader()
   this->FileName = nullptr;
   this->SetNumberOfInputPorts(0);
   this->Comment = nullptr;
+  this->ParallelParsing = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -108,6 +115,843 @@ p <v_a> <v_b> ...
 
 \*---------------------------------------------------------------------------*/
 
+//----------------------------------------------------------------------------
+// Parallel parsing. The file is loaded into memory and split into chunks of
+// whole lines (a backslash-newline continuation never ends a chunk). A first
+// parallel pass counts the commands of each chunk, which gives every chunk
+// the vertex, normal, texture coordinate, group and face counts that precede
+// it. A second parallel pass then parses each chunk with relative indices
+// resolved, writing vertices and normals directly into the output arrays.
+namespace
+{
+
+const size_t objChunkSize = 1 << 22;
+
+enum OBJErrorKind
+{
+  objNoError = 0,
+  objReadError,         // Error reading '<cmd>' at line N
+  objContinuationError, // Error reading continuation line at line N
+  objElementError       // Error reading file near line N while processing ...
+};
+
+// A parse error, located by the number of lines read so far in the chunk.
+struct OBJError
+{
+  OBJErrorKind Kind = objNoError;
+  vtkIdType Line = 0;
+  std::string Command;
+
+  void Set(OBJErrorKind kind, vtkIdType line, const char* cmd)
+  {
+    this->Kind = kind;
+    this->Line = line;
+    this->Command = cmd;
+  }
+
+  std::string Format(vtkIdType lineOffset) const
+  {
+    const std::string line = std::to_string(this->Line + lineOffset);
+    switch (this->Kind)
+    {
+      case objReadError:
+        return "Error reading '" + this->Command + "' at line " + line;
+      case objContinuationError:
+        return "Error reading continuation line at line " + line;
+      case objElementError:
+        return "Error reading file near line " + line +
+          " while processing the '" + this->Command + "' command";
+      default:
+        return std::string();
+    }
+  }
+};
+
+// Results of the counting pass over one chunk.
+struct OBJChunkCounts
+{
+  vtkIdType NumLines = 0;
+  vtkIdType NumPoints = 0;
+  vtkIdType NumNormals = 0;
+  vtkIdType NumTCoords = 0;
+  vtkIdType NumGroups = 0;
+  vtkIdType NumFaces = 0;
+  bool FaceBeforeGroup = false;
+  // "vt" lines that hold two floats, in order
+  std::vector<std::pair<float, float> > TCoordValues;
+  // "usemtl" names, in order
+  std::vector<std::string> MaterialNames;
+  // face count at each "usemtl", in order (parallel to MaterialNames)
+  std::vector<vtkIdType> MaterialStarts;
+  OBJError Error;
+};
+
+// Results of the parsing pass over one chunk. Cell arrays are stored in the
+// legacy vtkCellArray layout (count followed by ids).
+struct OBJChunkCells
+{
+  std::vector<vtkIdType> Polys;
+  std::vector<vtkIdType> TCoordPolys;
+  std::vector<vtkIdType> NormalPolys;
+  std::vector<vtkIdType> Lines;
+  std::vector<vtkIdType> Verts;
+  vtkIdType NumLines = 0;
+  vtkIdType NumVerts = 0;
+  std::vector<float> GroupIds;
+  std::vector<std::pair<vtkFloatArray*, vtkIdType> > TCoordWrites;
+  bool HasTCoords = false;
+  bool HasNormals = false;
+  bool TCoordsSameAsVerts = true;
+  bool NormalsSameAsVerts = true;
+  OBJError Error;
+};
+
+// A line of text in the file buffer.
+struct OBJLine
+{
+  const char* Begin; // first character
+  const char* End;   // newline or end of chunk
+  const char* Next;  // start of the following line
+
+  void Set(const char* p, const char* end)
+  {
+    this->Begin = p;
+    const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+    this->End = (eol ? eol : end);
+    this->Next = (eol ? eol + 1 : end);
+  }
+
+  // True when the line ends with a "\" token immediately followed by a
+  // newline, which joins the next line to this one.
+  bool IsContinued(const char* end) const
+  {
+    return this->End < end && this->End - this->Begin >= 2 &&
+      this->End[-1] == '\\' && isspace(this->End[-2]);
+  }
+};
+
+// Split the line into its command and the position of its arguments.
+inline void objSplitCommand(const OBJLine& line, const char*& cmd,
+                            size_t& cmdLen, const char*& args)
+{
+  cmd = line.Begin;
+  while (cmd < line.End && isspace(*cmd))
+  {
+    ++cmd;
+  }
+  args = cmd;
+  while (args < line.End && !isspace(*args))
+  {
+    ++args;
+  }
+  cmdLen = static_cast<size_t>(args - cmd);
+  if (args < line.End)
+  {
+    ++args;
+  }
+}
+
+inline bool objIsCommand(const char* cmd, size_t cmdLen, const char* name)
+{
+  return strlen(name) == cmdLen && strncmp(cmd, name, cmdLen) == 0;
+}
+
+// Parse up to n floats as sscanf("%f %f ...") would, without reading past
+// the end of the line. Returns the number of values parsed.
+inline int objReadFloats(const char* p, const char* end, int n, float* x)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    char* endptr = nullptr;
+    x[i] = strtof(p, &endptr);
+    if (endptr == p || endptr > end)
+    {
+      return i;
+    }
+    p = endptr;
+  }
+  return n;
+}
+
+// Parse one int as sscanf("%d") would, without reading past end.
+inline bool objReadInt(const char* p, const char* end, int& value,
+                       const char** next)
+{
+  char* endptr = nullptr;
+  long v = strtol(p, &endptr, 10);
+  if (endptr == p || endptr > end)
+  {
+    return false;
+  }
+  value = static_cast<int>(v);
+  *next = endptr;
+  return true;
+}
+
+// Parse a face, line or point vertex token in the forms v/t/n, v//n, v/t and
+// v, tried in the same order as the serial reader. Returns the number of
+// sscanf-style conversions of the matching form (3, 2, 2 or 1) and which
+// form matched, or 0 if the token does not start with an integer.
+enum OBJVertexForm
+{
+  objVTN,
+  objVN,
+  objVT,
+  objV
+};
+
+inline int objReadVertexToken(const char* p, const char* end, int& v, int& t,
+                              int& n, OBJVertexForm& form)
+{
+  const char* q;
+  if (!objReadInt(p, end, v, &q))
+  {
+    return 0;
+  }
+  const char* r;
+  if (q < end && *q == '/')
+  {
+    if (objReadInt(q + 1, end, t, &r))
+    {
+      const char* s;
+      if (r < end && *r == '/' && objReadInt(r + 1, end, n, &s))
+      {
+        form = objVTN;
+        return 3;
+      }
+      form = objVT;
+      return 2;
+    }
+    if (q + 1 < end && q[1] == '/' && objReadInt(q + 2, end, n, &r))
+    {
+      form = objVN;
+      return 2;
+    }
+  }
+  form = objV;
+  return 1;
+}
+
+// Find chunk boundaries at line starts, never splitting a continued line.
+std::vector<size_t> objSplitLines(const char* buf, size_t size)
+{
+  std::vector<size_t> offsets(1, 0);
+  size_t pos = objChunkSize;
+  while (pos < size)
+  {
+    const char* eol = static_cast<const char*>(memchr(buf + pos, '\n', size - pos));
+    while (eol && eol - buf >= 2 && eol[-1] == '\\' && isspace(eol[-2]))
+    {
+      const size_t next = static_cast<size_t>(eol - buf) + 1;
+      eol = static_cast<const char*>(memchr(buf + next, '\n', size - next));
+    }
+    if (eol == nullptr || static_cast<size_t>(eol - buf) + 1 >= size)
+    {
+      break;
+    }
+    pos = static_cast<size_t>(eol - buf) + 1;
+    offsets.push_back(pos);
+    pos += objChunkSize;
+  }
+  offsets.push_back(size);
+  return offsets;
+}
+
+// First pass: count commands and gather the texture coordinate values and
+// material names needed before any face can be processed.
+struct OBJCountChunks
+{
+  const char* Buffer;
+  const size_t* Offsets;
+  OBJChunkCounts* Counts;
+
+  void operator()(vtkIdType chunkId, vtkIdType endChunkId)
+  {
+    for ( ; chunkId < endChunkId; ++chunkId)
+    {
+      OBJChunkCounts& counts = this->Counts[chunkId];
+      const char* p = this->Buffer + this->Offsets[chunkId];
+      const char* end = this->Buffer + this->Offsets[chunkId + 1];
+      bool continuation = false;
+
+      OBJLine line;
+      for ( ; p < end && counts.Error.Kind == objNoError; p = line.Next)
+      {
+        line.Set(p, end);
+        ++counts.NumLines;
+
+        const char *cmd, *args;
+        size_t cmdLen;
+        objSplitCommand(line, cmd, cmdLen, args);
+
+        // Texture coordinates and material names are gathered line by line,
+        // continuation or not, like the first pass of the serial reader.
+        if (objIsCommand(cmd, cmdLen, "usemtl"))
+        {
+          const char* name = args;
+          while (name < line.End && isspace(*name))
+          {
+            ++name;
+          }
+          const char* nameEnd = name;
+          while (nameEnd < line.End && !isspace(*nameEnd))
+          {
+            ++nameEnd;
+          }
+          if (name == nameEnd)
+          {
+            counts.Error.Set(objReadError, counts.NumLines, "usemtl");
+            break;
+          }
+          if (!continuation)
+          {
+            counts.MaterialNames.emplace_back(name, nameEnd);
+            counts.MaterialStarts.push_back(counts.NumFaces);
+          }
+        }
+        else if (objIsCommand(cmd, cmdLen, "vt"))
+        {
+          float x[2];
+          if (objReadFloats(args, line.End, 2, x) == 2)
+          {
+            counts.TCoordValues.emplace_back(x[0], x[1]);
+          }
+        }
+
+        // Continuation lines belong to the preceding element.
+        const bool continued = line.IsContinued(end);
+        if (continuation)
+        {
+          continuation = continued;
+          continue;
+        }
+
+        if (objIsCommand(cmd, cmdLen, "v"))
+        {
+          ++counts.NumPoints;
+        }
+        else if (objIsCommand(cmd, cmdLen, "vn"))
+        {
+          ++counts.NumNormals;
+        }
+        else if (objIsCommand(cmd, cmdLen, "vt"))
+        {
+          ++counts.NumTCoords;
+        }
+        else if (objIsCommand(cmd, cmdLen, "g"))
+        {
+          ++counts.NumGroups;
+        }
+        else if (objIsCommand(cmd, cmdLen, "f"))
+        {
+          if (counts.NumGroups == 0)
+          {
+            counts.FaceBeforeGroup = true;
+          }
+          ++counts.NumFaces;
+          continuation = continued;
+        }
+        else if (objIsCommand(cmd, cmdLen, "l") || objIsCommand(cmd, cmdLen, "p"))
+        {
+          continuation = continued;
+        }
+      }
+    }
+  }
+};
+
+// Second pass: parse each chunk given the counts preceding it.
+struct OBJParseChunks
+{
+  const char* Buffer;
+  const size_t* Offsets;
+  OBJChunkCells* Cells;
+
+  // Per-chunk starting state
+  const vtkIdType* PointOffsets;
+  const vtkIdType* NormalOffsets;
+  const vtkIdType* TCoordOffsets;
+  const vtkIdType* GroupOffsets;
+  const std::string* StartMaterials;
+  int GroupShift;
+
+  const std::unordered_map<std::string, vtkFloatArray*>* TCoordsMap;
+  const std::vector<std::pair<float, float> >* TCoordValues;
+  float* Points;
+  float* Normals;
+
+  // Resolve a 1-based or negative (relative) index to a 0-based index.
+  static vtkIdType Resolve(int idx, vtkIdType count)
+  {
+    return (idx < 0 ? count + idx : idx - 1);
+  }
+
+  void operator()(vtkIdType chunkId, vtkIdType endChunkId)
+  {
+    for ( ; chunkId < endChunkId; ++chunkId)
+    {
+      this->ParseChunk(chunkId);
+    }
+  }
+
+  void ParseChunk(vtkIdType chunkId)
+  {
+    OBJChunkCells& cells = this->Cells[chunkId];
+    OBJError& error = cells.Error;
+    const char* p = this->Buffer + this->Offsets[chunkId];
+    const char* end = this->Buffer + this->Offsets[chunkId + 1];
+
+    const vtkIdType numPointsBefore = this->PointOffsets[chunkId];
+    const vtkIdType numNormalsBefore = this->NormalOffsets[chunkId];
+    vtkIdType numPoints = numPointsBefore;
+    vtkIdType numNormals = numNormalsBefore;
+    vtkIdType numTCoords = this->TCoordOffsets[chunkId];
+    int groupId = static_cast<int>(this->GroupOffsets[chunkId]) - this->GroupShift;
+    const vtkIdType numTCoordValues =
+      static_cast<vtkIdType>(this->TCoordValues->size());
+
+    vtkFloatArray* tcArray = nullptr;
+    auto iter = this->TCoordsMap->find(this->StartMaterials[chunkId]);
+    if (iter != this->TCoordsMap->end())
+    {
+      tcArray = iter->second;
+    }
+
+    vtkIdType lineNr = 0;
+    OBJLine line;
+    for ( ; p < end && error.Kind == objNoError; p = line.Next)
+    {
+      line.Set(p, end);
+      ++lineNr;
+
+      const char *cmd, *pLine;
+      size_t cmdLen;
+      objSplitCommand(line, cmd, cmdLen, pLine);
+
+      if (objIsCommand(cmd, cmdLen, "g"))
+      {
+        ++groupId;
+      }
+      else if (objIsCommand(cmd, cmdLen, "v"))
+      {
+        if (objReadFloats(pLine, line.End, 3, this->Points + 3*numPoints) == 3)
+        {
+          ++numPoints;
+        }
+        else
+        {
+          error.Set(objReadError, lineNr, "v");
+        }
+      }
+      else if (objIsCommand(cmd, cmdLen, "usemtl"))
+      {
+        const char* name = pLine;
+        while (name < line.End && isspace(*name))
+        {
+          ++name;
+        }
+        const char* nameEnd = name;
+        while (nameEnd < line.End && !isspace(*nameEnd))
+        {
+          ++nameEnd;
+        }
+        iter = this->TCoordsMap->find(std::string(name, nameEnd));
+        tcArray = (iter != this->TCoordsMap->end() ? iter->second : nullptr);
+      }
+      else if (objIsCommand(cmd, cmdLen, "vt"))
+      {
+        ++numTCoords;
+      }
+      else if (objIsCommand(cmd, cmdLen, "vn"))
+      {
+        if (objReadFloats(pLine, line.End, 3, this->Normals + 3*numNormals) == 3)
+        {
+          cells.HasNormals = true;
+          ++numNormals;
+        }
+        else
+        {
+          error.Set(objReadError, lineNr, "vn");
+        }
+      }
+      else if (objIsCommand(cmd, cmdLen, "p") || objIsCommand(cmd, cmdLen, "l") ||
+               objIsCommand(cmd, cmdLen, "f"))
+      {
+        const char type = *cmd;
+        std::vector<vtkIdType>& conn = (type == 'f' ? cells.Polys :
+          (type == 'l' ? cells.Lines : cells.Verts));
+        const size_t connStart = conn.size();
+        size_t tcoordStart = cells.TCoordPolys.size();
+        size_t normalStart = cells.NormalPolys.size();
+        conn.push_back(0);
+        if (type == 'f')
+        {
+          cells.TCoordPolys.push_back(0);
+          cells.NormalPolys.push_back(0);
+        }
+
+        vtkIdType nVerts = 0, nTCoords = 0, nNormals = 0;
+        const char* pEnd = line.End;
+        while (error.Kind == objNoError && pLine < pEnd)
+        {
+          while (pLine < pEnd && isspace(*pLine))
+          {
+            ++pLine;
+          }
+          if (pLine >= pEnd)
+          {
+            break;
+          }
+
+          int iVert = 0, iTCoord = 0, iNormal = 0;
+          OBJVertexForm form;
+          if (objReadVertexToken(pLine, pEnd, iVert, iTCoord, iNormal, form))
+          {
+            conn.push_back(Resolve(iVert, numPoints));
+            ++nVerts;
+
+            if (type == 'f' && (form == objVTN || form == objVT))
+            {
+              vtkIdType iTCoordAbs = Resolve(iTCoord, numTCoords);
+              if (iTCoordAbs < 0 || iTCoordAbs >= numTCoordValues)
+              {
+                error.Set(objReadError, lineNr, "f");
+                break;
+              }
+              cells.TCoordPolys.push_back(iTCoordAbs);
+              if (tcArray)
+              {
+                cells.TCoordWrites.emplace_back(tcArray, iTCoordAbs);
+              }
+              ++nTCoords;
+              if (iTCoord != iVert)
+              {
+                cells.TCoordsSameAsVerts = false;
+              }
+            }
+            if (type == 'f' && (form == objVTN || form == objVN))
+            {
+              cells.NormalPolys.push_back(Resolve(iNormal, numNormals));
+              ++nNormals;
+              if (iNormal != iVert)
+              {
+                cells.NormalsSameAsVerts = false;
+              }
+            }
+          }
+          else if (pEnd - pLine == 1 && *pLine == '\\' && line.Next > pEnd)
+          {
+            // handle backslash-newline continuation
+            if (line.Next < end)
+            {
+              line.Set(line.Next, end);
+              ++lineNr;
+              pLine = line.Begin;
+              pEnd = line.End;
+              continue;
+            }
+            error.Set(objContinuationError, lineNr, "");
+          }
+          else
+          {
+            const char name[2] = { type, '\0' };
+            error.Set(objReadError, lineNr, name);
+          }
+          // skip over what we just read
+          while (pLine < pEnd && !isspace(*pLine))
+          {
+            ++pLine;
+          }
+        }
+        if (error.Kind != objNoError)
+        {
+          break;
+        }
+
+        const vtkIdType minVerts = (type == 'f' ? 3 : (type == 'l' ? 2 : 1));
+        if (nVerts < minVerts ||
+            (nTCoords > 0 && nTCoords != nVerts) ||
+            (nNormals > 0 && nNormals != nVerts))
+        {
+          const char name[2] = { type, '\0' };
+          error.Set(objElementError, lineNr, name);
+          break;
+        }
+
+        conn[connStart] = nVerts;
+        if (type == 'f')
+        {
+          cells.TCoordPolys[tcoordStart] = nTCoords;
+          cells.NormalPolys[normalStart] = nNormals;
+          cells.HasTCoords = cells.HasTCoords || nTCoords > 0;
+          cells.HasNormals = cells.HasNormals || nNormals > 0;
+          cells.GroupIds.push_back(static_cast<float>(groupId < 0 ? 0 : groupId));
+        }
+        else if (type == 'l')
+        {
+          ++cells.NumLines;
+        }
+        else
+        {
+          ++cells.NumVerts;
+        }
+      }
+    }
+  }
+};
+
+// Where the parallel parser puts its results. These are the same structures
+// the serial parser fills in vtkOBJReader::RequestData().
+struct OBJParseTarget
+{
+  vtkPoints* Points;
+  vtkFloatArray* Normals;
+  vtkCellArray* Polys;
+  vtkCellArray* TCoordPolys;
+  vtkCellArray* NormalPolys;
+  vtkCellArray* PointElems;
+  vtkCellArray* LineElems;
+  vtkFloatArray* FaceScalars;
+  vtkStringArray* MatNames;
+  std::unordered_map<std::string, vtkFloatArray*>* TCoordsMap;
+  std::unordered_map<std::string, int>* MatNameToId;
+  std::unordered_map<vtkIdType, std::string>* StartCellToMatName;
+  int MatCount;
+  int GroupId;
+  bool HasTCoords;
+  bool HasNormals;
+  bool TCoordsSameAsVerts;
+  bool NormalsSameAsVerts;
+  std::string Comment;
+  std::string Error;
+};
+
+// Copy per-chunk connectivity into the final cell array.
+struct OBJGatherConn
+{
+  const OBJChunkCells* Cells;
+  std::vector<vtkIdType> OBJChunkCells::*Conn;
+  const vtkIdType* Offsets;
+  vtkIdType* Output;
+
+  void operator()(vtkIdType chunkId, vtkIdType endChunkId)
+  {
+    for ( ; chunkId < endChunkId; ++chunkId)
+    {
+      const std::vector<vtkIdType>& conn = this->Cells[chunkId].*(this->Conn);
+      std::copy(conn.begin(), conn.end(), this->Output + this->Offsets[chunkId]);
+    }
+  }
+};
+
+// Concatenate one kind of per-chunk connectivity into a cell array.
+void objGatherCells(const std::vector<OBJChunkCells>& cells,
+                    std::vector<vtkIdType> OBJChunkCells::*conn,
+                    const std::vector<vtkIdType>& numCells,
+                    vtkCellArray* output)
+{
+  const vtkIdType numChunks = static_cast<vtkIdType>(cells.size());
+  std::vector<vtkIdType> offsets(numChunks + 1, 0);
+  vtkIdType totalCells = 0;
+  for (vtkIdType i = 0; i < numChunks; ++i)
+  {
+    offsets[i + 1] = offsets[i] + static_cast<vtkIdType>((cells[i].*conn).size());
+    totalCells += numCells[i];
+  }
+  OBJGatherConn gather = { cells.data(), conn, offsets.data(),
+    output->WritePointer(totalCells, offsets[numChunks]) };
+  vtkSMPTools::For(0, numChunks, 1, gather);
+}
+
+//----------------------------------------------------------------------------
+bool objParseInParallel(FILE* in, OBJParseTarget& target)
+{
+  // Load the whole file. A terminating null keeps strtof() and strtol()
+  // from running past the end of the buffer.
+  std::vector<char> buffer;
+  if (!vtkReadFileRemainder(in, buffer))
+  {
+    target.Error = "Error while reading the file";
+    return false;
+  }
+  const char* buf = buffer.data();
+  const size_t size = buffer.size() - 1;
+
+  // The first comment is at the start of the file.
+  {
+    std::string firstComment;
+    OBJLine line;
+    for (const char* p = buf; p < buf + size; p = line.Next)
+    {
+      line.Set(p, buf + size);
+      const char* cmd = line.Begin;
+      while (cmd < line.End && isspace(*cmd))
+      {
+        ++cmd;
+      }
+      if (cmd == line.End || *cmd != '#')
+      {
+        break;
+      }
+      ++cmd;
+      while (cmd < line.Next && isspace(*cmd))
+      {
+        ++cmd;
+      }
+      firstComment.append(cmd, line.Next);
+    }
+    while (!firstComment.empty() &&
+           (firstComment.back() == '\r' || firstComment.back() == '\n'))
+    {
+      firstComment.pop_back();
+    }
+    target.Comment = firstComment;
+  }
+
+  std::vector<size_t> chunkOffsets = objSplitLines(buf, size);
+  const vtkIdType numChunks = static_cast<vtkIdType>(chunkOffsets.size()) - 1;
+
+  // First pass: counts, texture coordinates and materials.
+  std::vector<std::pair<float, float> > tcoordValues;
+  std::vector<OBJChunkCounts> counts(numChunks);
+  OBJCountChunks countChunks = { buf, chunkOffsets.data(), counts.data() };
+  vtkSMPTools::For(0, numChunks, 1, countChunks);
+
+  std::vector<vtkIdType> lineOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> pointOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> normalOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> tcoordOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> groupOffsets(numChunks + 1, 0);
+  std::vector<vtkIdType> faceOffsets(numChunks + 1, 0);
+  std::vector<std::string> startMaterials(numChunks);
+  bool faceBeforeGroup = false;
+  std::string lastMaterial;
+  for (vtkIdType i = 0; i < numChunks; ++i)
+  {
+    const OBJChunkCounts& c = counts[i];
+    if (c.Error.Kind != objNoError)
+    {
+      target.Error = c.Error.Format(lineOffsets[i]);
+      return false;
+    }
+    lineOffsets[i + 1] = lineOffsets[i] + c.NumLines;
+    pointOffsets[i + 1] = pointOffsets[i] + c.NumPoints;
+    normalOffsets[i + 1] = normalOffsets[i] + c.NumNormals;
+    tcoordOffsets[i + 1] = tcoordOffsets[i] + c.NumTCoords;
+    groupOffsets[i + 1] = groupOffsets[i] + c.NumGroups;
+    faceOffsets[i + 1] = faceOffsets[i] + c.NumFaces;
+    if (c.FaceBeforeGroup && groupOffsets[i] == 0)
+    {
+      faceBeforeGroup = true;
+    }
+
+    tcoordValues.insert(tcoordValues.end(),
+                               c.TCoordValues.begin(), c.TCoordValues.end());
+    for (const std::string& name : c.MaterialNames)
+    {
+      if (target.TCoordsMap->find(name) == target.TCoordsMap->end())
+      {
+        vtkFloatArray* tcoords = vtkFloatArray::New();
+        tcoords->SetNumberOfComponents(2);
+        tcoords->SetName(name.c_str());
+        target.TCoordsMap->emplace(name, tcoords);
+      }
+      lastMaterial = name;
+    }
+  }
+
+  // If no material texture coordinates are found, add default TCoords.
+  // Faces that precede the first "usemtl" use the last material named in
+  // the file, as in the serial reader.
+  if (target.TCoordsMap->empty())
+  {
+    vtkFloatArray* tcoords = vtkFloatArray::New();
+    tcoords->SetNumberOfComponents(2);
+    tcoords->SetName("TCoords");
+    target.TCoordsMap->emplace("TCoords", tcoords);
+    lastMaterial = "TCoords";
+  }
+  for (vtkIdType i = 0; i < numChunks; ++i)
+  {
+    startMaterials[i] = lastMaterial;
+    const OBJChunkCounts& c = counts[i];
+    for (size_t j = 0; j < c.MaterialNames.size(); ++j)
+    {
+      lastMaterial = c.MaterialNames[j];
+      if (target.MatNameToId->find(lastMaterial) == target.MatNameToId->end())
+      {
+        target.MatNameToId->emplace(lastMaterial, target.MatCount);
+        target.MatNames->InsertNextValue(lastMaterial);
+        target.MatCount++;
+      }
+      (*target.StartCellToMatName)[faceOffsets[i] + c.MaterialStarts[j]] = lastMaterial;
+    }
+  }
+
+  const vtkIdType numTCoordValues = static_cast<vtkIdType>(tcoordValues.size());
+  for (auto iter : *target.TCoordsMap)
+  {
+    vtkFloatArray* tcoords = iter.second;
+    tcoords->SetNumberOfTuples(numTCoordValues);
+    tcoords->FillValue(-1.0f);
+  }
+
+  // Second pass: parse elements.
+  target.Points->SetDataTypeToFloat();
+  target.Points->SetNumberOfPoints(pointOffsets[numChunks]);
+  target.Normals->SetNumberOfTuples(normalOffsets[numChunks]);
+
+  std::vector<OBJChunkCells> cells(numChunks);
+  OBJParseChunks parseChunks = { buf, chunkOffsets.data(), cells.data(), pointOffsets.data(), normalOffsets.data(),
+    tcoordOffsets.data(), groupOffsets.data(), startMaterials.data(),
+    (faceBeforeGroup ? 0 : 1), target.TCoordsMap, &tcoordValues,
+    static_cast<vtkFloatArray*>(target.Points->GetData())->GetPointer(0),
+    target.Normals->GetPointer(0) };
+  vtkSMPTools::For(0, numChunks, 1, parseChunks);
+
+  std::vector<vtkIdType> numFaces(numChunks), numLines(numChunks), numVerts(numChunks);
+  for (vtkIdType i = 0; i < numChunks; ++i)
+  {
+    const OBJChunkCells& c = cells[i];
+    if (c.Error.Kind != objNoError)
+    {
+      target.Error = c.Error.Format(lineOffsets[i]);
+      return false;
+    }
+    numFaces[i] = static_cast<vtkIdType>(c.GroupIds.size());
+    numLines[i] = c.NumLines;
+    numVerts[i] = c.NumVerts;
+    target.HasTCoords = target.HasTCoords || c.HasTCoords;
+    target.HasNormals = target.HasNormals || c.HasNormals;
+    target.TCoordsSameAsVerts = target.TCoordsSameAsVerts && c.TCoordsSameAsVerts;
+    target.NormalsSameAsVerts = target.NormalsSameAsVerts && c.NormalsSameAsVerts;
+    for (const auto& write : c.TCoordWrites)
+    {
+      const auto& tc = tcoordValues[write.second];
+      write.first->SetTuple2(write.second, tc.first, tc.second);
+    }
+  }
+
+  target.FaceScalars->SetNumberOfValues(faceOffsets[numChunks]);
+  for (vtkIdType i = 0; i < numChunks; ++i)
+  {
+    std::copy(cells[i].GroupIds.begin(), cells[i].GroupIds.end(),
+              target.FaceScalars->GetPointer(faceOffsets[i]));
+  }
+
+  objGatherCells(cells, &OBJChunkCells::Polys, numFaces, target.Polys);
+  objGatherCells(cells, &OBJChunkCells::TCoordPolys, numFaces, target.TCoordPolys);
+  objGatherCells(cells, &OBJChunkCells::NormalPolys, numFaces, target.NormalPolys);
+  objGatherCells(cells, &OBJChunkCells::Lines, numLines, target.LineElems);
+  objGatherCells(cells, &OBJChunkCells::Verts, numVerts, target.PointElems);
+
+  target.GroupId = static_cast<int>(groupOffsets[numChunks]) - (faceBeforeGroup ? 0 : 1);
+  return true;
+}
+
+} // end anon namespace
+
+//----------------------------------------------------------------------------
 int vtkOBJReader::RequestData(
   vtkInformation *vtkNotUsed(request),
   vtkInformationVector **vtkNotUsed(inputVector),
@@ -177,6 +1021,44 @@ int vtkOBJReader::RequestData(
 
   // -- work through the file line by line, assigning into the above 7 structures as appropriate --
 
+  if (this->ParallelParsing)
+  {
+    // (same structures, filled from chunks of lines parsed concurrently)
+    OBJParseTarget target;
+    target.Points = points;
+    target.Normals = normals;
+    target.Polys = polys;
+    target.TCoordPolys = tcoord_polys;
+    target.NormalPolys = normal_polys;
+    target.PointElems = pointElems;
+    target.LineElems = lineElems;
+    target.FaceScalars = faceScalars;
+    target.MatNames = matNames;
+    target.TCoordsMap = &tcoords_map;
+    target.MatNameToId = &matNameToId;
+    target.StartCellToMatName = &startCellToMatName;
+    target.MatCount = matcnt;
+    target.GroupId = groupId;
+    target.HasTCoords = hasTCoords;
+    target.HasNormals = hasNormals;
+    target.TCoordsSameAsVerts = tcoords_same_as_verts;
+    target.NormalsSameAsVerts = normals_same_as_verts;
+
+    everything_ok = objParseInParallel(in, target);
+    if (!everything_ok)
+    {
+      vtkErrorMacro(<< target.Error);
+    }
+    this->SetComment(target.Comment.c_str());
+
+    matcnt = target.MatCount;
+    groupId = target.GroupId;
+    hasTCoords = target.HasTCoords;
+    hasNormals = target.HasNormals;
+    tcoords_same_as_verts = target.TCoordsSameAsVerts;
+    normals_same_as_verts = target.NormalsSameAsVerts;
+  }
+  else
   { // (make a local scope section to emphasise that the variables below are only used here)
 
   const int MAX_LINE = 1024 * 256;
@@ -975,5 +1857,7 @@ void vtkOBJReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "File Name: "
      << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "ParallelParsing: "
+     << (this->ParallelParsing ? "On" : "Off") << "\n";
 
 }
@@ -18,6 +18,10 @@
  *
  * vtkOBJReader is a source object that reads Wavefront .obj
  * files. The output of this source object is polygonal data.
+ *
+ * Large files can be read faster by turning on ParallelParsing: the file is
+ * then loaded into memory and parsed in chunks of lines using vtkSMPTools.
+ * The output is the same as when parsing serially.
  * @sa
  * vtkOBJImporter
 */
@@ -43,6 +47,19 @@ public:
   vtkGetStringMacro(Comment);
   //@}
 
+  //@{
+  /**
+   * Turn on/off parallel parsing. When on, the whole file is read into
+   * memory, split into chunks at line boundaries and parsed concurrently
+   * using vtkSMPTools. Relative indices, groups and materials are resolved
+   * from per-chunk counts so the output is identical to serial parsing.
+   * Off by default.
+   */
+  vtkSetMacro(ParallelParsing, vtkTypeBool);
+  vtkGetMacro(ParallelParsing, vtkTypeBool);
+  vtkBooleanMacro(ParallelParsing, vtkTypeBool);
+  //@}
+
 protected:
   vtkOBJReader();
   ~vtkOBJReader() override;
@@ -55,6 +72,7 @@ protected:
   vtkSetStringMacro(Comment);
 
   char* Comment;
+  vtkTypeBool ParallelParsing;
 
 private:
   vtkOBJReader(const vtkOBJReader&) = delete;
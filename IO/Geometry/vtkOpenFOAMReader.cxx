@@ -63,6 +63,7 @@
 #include "vtk_zlib.h"
 
 #include "vtkAssume.h"
+#include "vtkAtomic.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
@@ -84,6 +85,8 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -104,6 +107,8 @@
 // for getuid()
 #include <unistd.h>
 #endif
+// for std::sort() / std::max()
+#include <algorithm>
 // for fabs()
 #include <cmath>
 // for isalnum() / isspace() / isdigit()
@@ -159,24 +164,6 @@ void SetLabelValue(vtkDataArray *array, vtkIdType idx, vtkTypeInt64 value,
   }
 }
 
-// Similar to above, but increments the specified value by one.
-void IncrementLabelValue(vtkDataArray *array, vtkIdType idx,
-                         bool use64BitLabels)
-{
-  if (!use64BitLabels)
-  {
-    vtkTypeInt32 val = static_cast<vtkTypeInt32Array*>(array)->GetValue(idx);
-    assert(val + 1 >= 0);
-    static_cast<vtkTypeInt32Array*>(array)->SetValue(idx, val + 1);
-  }
-  else
-  {
-    vtkTypeInt64 val = static_cast<vtkTypeInt64Array*>(array)->GetValue(idx);
-    assert(val + 1 >= 0);
-    static_cast<vtkTypeInt64Array*>(array)->SetValue(idx, val + 1);
-  }
-}
-
 // Another helper for appending an id to a list
 void AppendLabelValue(vtkDataArray *array, vtkTypeInt64 val,
                       bool use64BitLabels)
@@ -5446,6 +5433,167 @@ vtkOpenFOAMReaderPrivate::ReadFacesFile(const vtkStdString &facePathIn)
   return static_cast<vtkFoamLabelVectorVector *>(dict.Ptr());
 }
 
+//-----------------------------------------------------------------------------
+// Parallel construction of the cell-faces lists from the face owner and
+// neighbour lists. Faces are counted and scattered into their cells through
+// atomic counters; the faces of each cell are then sorted so that every list
+// is in ascending face order, exactly as the serial construction used to
+// produce it.
+namespace {
+
+// find the largest cell label referenced by owner or neighbour
+template <typename LabelT>
+class vtkFoamMaxCellLabel
+{
+  const LabelT *Owner;
+  const LabelT *Neighbor;
+  vtkIdType NNeiFaces;
+  vtkSMPThreadLocal<LabelT> LocalMax;
+
+public:
+  LabelT Max;
+
+  vtkFoamMaxCellLabel(const LabelT *owner, const LabelT *neighbor,
+    vtkIdType nNeiFaces) : Owner(owner), Neighbor(neighbor),
+    NNeiFaces(nNeiFaces), Max(-1)
+  {
+  }
+
+  void Initialize()
+  {
+    this->LocalMax.Local() = -1;
+  }
+
+  void operator()(vtkIdType faceI, vtkIdType endFaceI)
+  {
+    LabelT &localMax = this->LocalMax.Local();
+    for (; faceI < endFaceI; ++faceI)
+    {
+      localMax = std::max(localMax, this->Owner[faceI]);
+      // we do need to take neighbor faces into account since all the
+      // surrounding faces of a cell can be neighbors for a valid mesh
+      if (faceI < this->NNeiFaces)
+      {
+        localMax = std::max(localMax, this->Neighbor[faceI]);
+      }
+    }
+  }
+
+  void Reduce()
+  {
+    typename vtkSMPThreadLocal<LabelT>::iterator it;
+    for (it = this->LocalMax.begin(); it != this->LocalMax.end(); ++it)
+    {
+      this->Max = std::max(this->Max, *it);
+    }
+  }
+};
+
+// count the faces of each cell, or with Scatter set, store each face at
+// the next free slot of its cells
+template <typename LabelT>
+struct vtkFoamCellFacesCounter
+{
+  const LabelT *Owner;
+  const LabelT *Neighbor;
+  vtkIdType NNeiFaces;
+  vtkAtomic<LabelT> *Counters;
+  LabelT *Body;
+
+  void Add(LabelT cellI, vtkIdType faceI)
+  {
+    // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
+    if (cellI < 0)
+    {
+      return;
+    }
+    const LabelT slot = this->Counters[cellI]++;
+    if (this->Body)
+    {
+      this->Body[slot] = static_cast<LabelT>(faceI);
+    }
+  }
+
+  void operator()(vtkIdType faceI, vtkIdType endFaceI)
+  {
+    for (; faceI < endFaceI; ++faceI)
+    {
+      this->Add(this->Owner[faceI], faceI);
+      if (faceI < this->NNeiFaces)
+      {
+        this->Add(this->Neighbor[faceI], faceI);
+      }
+    }
+  }
+};
+
+template <typename LabelT>
+struct vtkFoamSortCellFaces
+{
+  const LabelT *Indices;
+  LabelT *Body;
+
+  void operator()(vtkIdType cellI, vtkIdType endCellI)
+  {
+    for (; cellI < endCellI; ++cellI)
+    {
+      std::sort(this->Body + this->Indices[cellI],
+        this->Body + this->Indices[cellI + 1]);
+    }
+  }
+};
+
+template <typename ArrayT>
+vtkFoamLabelVectorVector *vtkFoamBuildCellFaces(vtkDataArray &faceOwner,
+  vtkDataArray &faceNeighbor, vtkIdType &numCells)
+{
+  typedef typename ArrayT::ValueType LabelT;
+  const LabelT *owner = static_cast<ArrayT&>(faceOwner).GetPointer(0);
+  const LabelT *neighbor = static_cast<ArrayT&>(faceNeighbor).GetPointer(0);
+  const vtkIdType nFaces = faceOwner.GetNumberOfTuples();
+  const vtkIdType nNeiFaces = faceNeighbor.GetNumberOfTuples();
+
+  // find the number of cells
+  vtkFoamMaxCellLabel<LabelT> maxCell(owner, neighbor, nNeiFaces);
+  vtkSMPTools::For(0, nFaces, maxCell);
+  const LabelT nCells = maxCell.Max + 1;
+  numCells = static_cast<vtkIdType>(nCells);
+
+  // count number of faces for each cell
+  std::vector<vtkAtomic<LabelT> > counters(nCells);
+  vtkFoamCellFacesCounter<LabelT> counter = { owner, neighbor, nNeiFaces,
+    counters.empty() ? nullptr : &counters[0], nullptr };
+  vtkSMPTools::For(0, nFaces, counter);
+
+  // create cellFaces indices by accumulating the number of faces and reset
+  // the counters to the start of each cell. To reduce the numbers of
+  // new/delete operations we allocate memory space for all faces linearly
+  vtkFoamLabelVectorVectorImpl<ArrayT> *cells =
+    new vtkFoamLabelVectorVectorImpl<ArrayT>(nCells, 1);
+  LabelT *indices = static_cast<ArrayT*>(cells->GetIndices())->GetPointer(0);
+  LabelT nTotalCellFaces = 0;
+  for (LabelT cellI = 0; cellI < nCells; ++cellI)
+  {
+    indices[cellI] = nTotalCellFaces;
+    nTotalCellFaces += counters[cellI];
+    counters[cellI] = indices[cellI];
+  }
+  indices[nCells] = nTotalCellFaces;
+  cells->ResizeBody(nTotalCellFaces);
+
+  // add face numbers to cell-faces list
+  LabelT *body = static_cast<ArrayT*>(cells->GetBody())->GetPointer(0);
+  counter.Body = body;
+  vtkSMPTools::For(0, nFaces, counter);
+
+  vtkFoamSortCellFaces<LabelT> sorter = { indices, body };
+  vtkSMPTools::For(0, nCells, sorter);
+
+  return cells;
+}
+
+} // end anon namespace
+
 //-----------------------------------------------------------------------------
 // read the owner and neighbor file and create cellFaces
 vtkFoamLabelVectorVector *
@@ -5547,174 +5695,22 @@ vtkOpenFOAMReaderPrivate::ReadOwnerNeighborFiles(
 
     // add the face numbers to the correct cell cf. Terry's code and
     // src/OpenFOAM/meshes/primitiveMesh/primitiveMeshCells.C
-    // find the number of cells
-    vtkTypeInt64 nCells = -1;
-    for (int faceI = 0; faceI < nNeiFaces; faceI++)
-    {
-      const vtkTypeInt64 ownerCell = GetLabelValue(&faceOwner, faceI,
-                                                   use64BitLabels);
-      if (nCells < ownerCell) // max(nCells, faceOwner[i])
-      {
-        nCells = ownerCell;
-      }
-
-      // we do need to take neighbor faces into account since all the
-      // surrounding faces of a cell can be neighbors for a valid mesh
-      const vtkTypeInt64 neighborCell = GetLabelValue(&faceNeighbor, faceI,
-                                                      use64BitLabels);
-      if (nCells < neighborCell) // max(nCells, faceNeighbor[i])
-      {
-        nCells = neighborCell;
-      }
-    }
-
-    for (vtkIdType faceI = nNeiFaces; faceI < nFaces; faceI++)
-    {
-      const vtkTypeInt64 ownerCell = GetLabelValue(&faceOwner, faceI,
-                                                   use64BitLabels);
-      if (nCells < ownerCell) // max(nCells, faceOwner[i])
-      {
-        nCells = ownerCell;
-      }
-    }
-    nCells++;
-
-    if (nCells == 0)
-    {
-      vtkWarningMacro(<<"The mesh contains no cells");
-    }
-
-    // set the number of cells
-    this->NumCells = static_cast<vtkIdType>(nCells);
-
-    // create cellFaces with the length of the body undetermined
     vtkFoamLabelVectorVector *cells;
     if (use64BitLabels)
     {
-      cells = new vtkFoamLabel64VectorVector(nCells, 1);
-    }
-    else
-    {
-      cells = new vtkFoamLabel32VectorVector(nCells, 1);
-    }
-
-    // count number of faces for each cell
-    vtkDataArray *cellIndices = cells->GetIndices();
-    for (int cellI = 0; cellI <= nCells; cellI++)
-    {
-      SetLabelValue(cellIndices, cellI, 0, use64BitLabels);
-    }
-    vtkIdType nTotalCellFaces = 0;
-    vtkIdType cellIndexOffset = 1; // offset +1
-    for (int faceI = 0; faceI < nNeiFaces; faceI++)
-    {
-      const vtkTypeInt64 ownerCell = GetLabelValue(&faceOwner, faceI,
-                                                   use64BitLabels);
-      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
-      if (ownerCell >= 0)
-      {
-        IncrementLabelValue(cellIndices, cellIndexOffset + ownerCell,
-                            use64BitLabels);
-        nTotalCellFaces++;
-      }
-
-      const vtkTypeInt64 neighborCell = GetLabelValue(&faceNeighbor, faceI,
-                                                      use64BitLabels);
-      if (neighborCell >= 0)
-      {
-        IncrementLabelValue(cellIndices, cellIndexOffset + neighborCell,
-                            use64BitLabels);
-        nTotalCellFaces++;
-      }
-    }
-
-    for (vtkIdType faceI = nNeiFaces; faceI < nFaces; faceI++)
-    {
-      const vtkTypeInt64 ownerCell = GetLabelValue(&faceOwner, faceI,
-                                                   use64BitLabels);
-      if (ownerCell >= 0)
-      {
-        IncrementLabelValue(cellIndices, cellIndexOffset + ownerCell,
-                            use64BitLabels);
-        nTotalCellFaces++;
-      }
-    }
-    cellIndexOffset = 0; // revert offset +1
-
-    // allocate cellFaces. To reduce the numbers of new/delete operations we
-    // allocate memory space for all faces linearly
-    cells->ResizeBody(nTotalCellFaces);
-
-    // accumulate the number of cellFaces to create cellFaces indices
-    // and copy them to a temporary array
-    vtkDataArray *tmpFaceIndices;
-    if (use64BitLabels)
-    {
-      tmpFaceIndices = vtkTypeInt64Array::New();
+      cells = vtkFoamBuildCellFaces<vtkTypeInt64Array>(
+        faceOwner, faceNeighbor, this->NumCells);
     }
     else
     {
-      tmpFaceIndices = vtkTypeInt32Array::New();
-    }
-    tmpFaceIndices->SetNumberOfValues(nCells + 1);
-    SetLabelValue(tmpFaceIndices, 0, 0, use64BitLabels);
-    for (vtkIdType cellI = 1; cellI <= nCells; cellI++)
-    {
-      vtkTypeInt64 curCellSize = GetLabelValue(cellIndices, cellI,
-                                               use64BitLabels);
-      vtkTypeInt64 lastCellSize = GetLabelValue(cellIndices, cellI - 1,
-                                                use64BitLabels);
-      vtkTypeInt64 curCellOffset = lastCellSize + curCellSize;
-      SetLabelValue(cellIndices, cellI, curCellOffset, use64BitLabels);
-      SetLabelValue(tmpFaceIndices, cellI, curCellOffset, use64BitLabels);
-    }
-
-    // add face numbers to cell-faces list
-    vtkDataArray *cellFacesList = cells->GetBody();
-    for (vtkIdType faceI = 0; faceI < nNeiFaces; faceI++)
-    {
-      // must be a signed int
-      const vtkTypeInt64 ownerCell =
-          GetLabelValue(&faceOwner, faceI, use64BitLabels);
-
-      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
-      if (ownerCell >= 0)
-      {
-        vtkTypeInt64 tempFace = GetLabelValue(tmpFaceIndices, ownerCell,
-                                              use64BitLabels);
-        SetLabelValue(cellFacesList, tempFace, faceI, use64BitLabels);
-        ++tempFace;
-        SetLabelValue(tmpFaceIndices, ownerCell, tempFace, use64BitLabels);
-      }
-
-      vtkTypeInt64 neighborCell = GetLabelValue(&faceNeighbor, faceI,
-                                                use64BitLabels);
-      if (neighborCell >= 0)
-      {
-        vtkTypeInt64 tempFace = GetLabelValue(tmpFaceIndices, neighborCell,
-                                              use64BitLabels);
-        SetLabelValue(cellFacesList, tempFace, faceI, use64BitLabels);
-        ++tempFace;
-        SetLabelValue(tmpFaceIndices, neighborCell, tempFace, use64BitLabels);
-      }
+      cells = vtkFoamBuildCellFaces<vtkTypeInt32Array>(
+        faceOwner, faceNeighbor, this->NumCells);
     }
 
-    for (vtkIdType faceI = nNeiFaces; faceI < nFaces; faceI++)
+    if (this->NumCells == 0)
     {
-      // must be a signed int
-      vtkTypeInt64 ownerCell = GetLabelValue(&faceOwner, faceI, use64BitLabels);
-
-      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
-      if (ownerCell >= 0)
-      {
-        vtkTypeInt64 tempFace = GetLabelValue(tmpFaceIndices, ownerCell,
-                                              use64BitLabels);
-        SetLabelValue(cellFacesList, tempFace, faceI, use64BitLabels);
-        ++tempFace;
-        SetLabelValue(tmpFaceIndices, ownerCell, tempFace, use64BitLabels);
-      }
+      vtkWarningMacro(<<"The mesh contains no cells");
     }
-    tmpFaceIndices->Delete();
 
     return cells;
   }
@@ -9220,6 +9216,7 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   this->CurrentReaderIndex = 0;
   this->NumberOfReaders = 0;
+  this->ChildReadersExecuteConcurrently = false;
   this->Use64BitLabels = false;
   this->Use64BitFloats = true;
   this->Use64BitLabelsOld = false;
@@ -9480,7 +9477,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
   {
     ret = reader->RequestData(output, recreateInternalMesh,
         recreateBoundaryMesh, updateVariables);
-    this->Parent->CurrentReaderIndex++;
+    if (!this->Parent->ChildReadersExecuteConcurrently)
+    {
+      this->Parent->CurrentReaderIndex++;
+    }
   }
   else
   {
@@ -9507,7 +9507,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInfor
         ret = 0;
       }
       subOutput->Delete();
-      this->Parent->CurrentReaderIndex++;
+      if (!this->Parent->ChildReadersExecuteConcurrently)
+      {
+        this->Parent->CurrentReaderIndex++;
+      }
     }
   }
 
@@ -9768,6 +9771,11 @@ void vtkOpenFOAMReader::UpdateStatus()
 //-----------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  // the parent reports the progress of concurrently executing readers
+  if (this->Parent->ChildReadersExecuteConcurrently)
+  {
+    return;
+  }
   this->vtkAlgorithm::UpdateProgress((static_cast<double>(this->Parent->CurrentReaderIndex)
       + amount) / static_cast<double>(this->Parent->NumberOfReaders));
 }
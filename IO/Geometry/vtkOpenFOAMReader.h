@@ -394,6 +394,9 @@ protected:
   int NumberOfReaders;
   // index of the active reader
   int CurrentReaderIndex;
+  // set by vtkPOpenFOAMReader while its child readers execute on
+  // several threads, which then leave the progress to the parent
+  bool ChildReadersExecuteConcurrently;
 
   vtkOpenFOAMReader();
   ~vtkOpenFOAMReader() override;
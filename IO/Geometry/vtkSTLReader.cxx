@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkGeometryReaderInternals.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,13 +27,17 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 #include <string>
+#include <utility>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -50,6 +55,8 @@ vtkSTLReader::vtkSTLReader()
   this->FileName = nullptr;
   this->Merging = 1;
   this->ScalarTags = 0;
+  this->ParallelParsing = 0;
+  this->ParallelMerging = 0;
   this->Locator = nullptr;
   this->Header = nullptr;
   this->BinaryHeader = nullptr;
@@ -82,6 +89,451 @@ vtkMTimeType vtkSTLReader::GetMTime()
   return mTime1;
 }
 
+//------------------------------------------------------------------------------
+// Helpers for the parallel parsing and merging paths.
+namespace
+{
+
+// Number of bytes of ASCII text handed to a single parsing task.
+const size_t stlChunkSize = 1 << 22;
+
+// Split text into chunks of roughly chunkSize bytes, each starting at the
+// beginning of a line. Returns numChunks+1 offsets.
+std::vector<size_t> stlSplitLines(const char *buf, size_t size, size_t chunkSize)
+{
+  std::vector<size_t> offsets(1, 0);
+  size_t pos = chunkSize;
+  while (pos < size)
+  {
+    const char *eol = static_cast<const char*>(memchr(buf + pos, '\n', size - pos));
+    if (eol == nullptr || static_cast<size_t>(eol - buf) + 1 >= size)
+    {
+      break;
+    }
+    pos = static_cast<size_t>(eol - buf) + 1;
+    offsets.push_back(pos);
+    pos += chunkSize;
+  }
+  offsets.push_back(size);
+  return offsets;
+}
+
+// Decode binary facets straight into the point and cell arrays. The
+// attribute byte count trailing each facet is skipped.
+struct STLDecodeBinary
+{
+  const char *Facets;
+  float *Points;
+  vtkIdType *Conn;
+
+  void operator()(vtkIdType tri, vtkIdType endTri)
+  {
+    for ( ; tri < endTri; ++tri)
+    {
+      float *x = this->Points + 9*tri;
+      memcpy(x, this->Facets + 50*tri + 12, 9*sizeof(float));
+      vtkByteSwap::Swap4LERange(x, 9);
+
+      vtkIdType *c = this->Conn + 4*tri;
+      c[0] = 3;
+      c[1] = 3*tri;
+      c[2] = 3*tri + 1;
+      c[3] = 3*tri + 2;
+    }
+  }
+};
+
+// First token of an ASCII STL line, as classified by the tokenizer.
+enum STLLineCode
+{
+  stlEmpty = 0,
+  stlSolid,
+  stlColor,
+  stlFacet,
+  stlOuter,
+  stlVertex,
+  stlBadVertex,
+  stlEndLoop,
+  stlEndFacet,
+  stlEndSolid,
+  stlOther
+};
+
+// The result of tokenizing one chunk of an ASCII STL file.
+struct STLAsciiChunk
+{
+  std::vector<unsigned char> Codes;
+  std::vector<float> Coords;
+  std::vector<std::string> SolidNames;
+  std::vector<std::pair<size_t, std::string> > Others;
+};
+
+// Classify each line of a chunk and parse vertex coordinates. The state
+// machine itself is run afterwards, in file order, on the codes.
+struct STLTokenizeAscii
+{
+  const char *Buffer;
+  const size_t *Offsets;
+  STLAsciiChunk *Chunks;
+
+  static bool ReadVertex(const char *arg, const char *lineEnd, float x[3])
+  {
+    char *endptr = nullptr;
+    for (int i = 0; i < 3; ++i)
+    {
+      x[i] = static_cast<float>(std::strtod(arg, &endptr));
+      if (endptr == arg || endptr > lineEnd)
+      {
+        return false;
+      }
+      arg = endptr;
+    }
+    return true;
+  }
+
+  void operator()(vtkIdType chunkId, vtkIdType endChunkId)
+  {
+    for ( ; chunkId < endChunkId; ++chunkId)
+    {
+      STLAsciiChunk& chunk = this->Chunks[chunkId];
+      const char *line = this->Buffer + this->Offsets[chunkId];
+      const char *end = this->Buffer + this->Offsets[chunkId + 1];
+      chunk.Codes.reserve((end - line) / 24);
+      chunk.Coords.reserve((end - line) / 8);
+
+      while (line < end)
+      {
+        const char *eol = static_cast<const char*>(memchr(line, '\n', end - line));
+        const char *lineEnd = (eol ? eol : end);
+
+        const char *cmd = line;
+        while (cmd < lineEnd && isspace(*cmd))
+        {
+          ++cmd;
+        }
+        line = (eol ? eol + 1 : end);
+
+        if (cmd == lineEnd)
+        {
+          chunk.Codes.push_back(stlEmpty);
+          continue;
+        }
+
+        const char *arg = cmd;
+        std::string token;
+        while (arg < lineEnd && !isspace(*arg))
+        {
+          token += static_cast<char>(tolower(*arg));
+          ++arg;
+        }
+        while (arg < lineEnd && isspace(*arg))
+        {
+          ++arg;
+        }
+
+        float x[3];
+        if (token == "vertex")
+        {
+          if (ReadVertex(arg, lineEnd, x))
+          {
+            chunk.Codes.push_back(stlVertex);
+            chunk.Coords.insert(chunk.Coords.end(), x, x + 3);
+          }
+          else
+          {
+            chunk.Codes.push_back(stlBadVertex);
+          }
+        }
+        else if (token == "facet")
+        {
+          chunk.Codes.push_back(stlFacet);
+        }
+        else if (token == "outer")
+        {
+          chunk.Codes.push_back(stlOuter);
+        }
+        else if (token == "endloop")
+        {
+          chunk.Codes.push_back(stlEndLoop);
+        }
+        else if (token == "endfacet")
+        {
+          chunk.Codes.push_back(stlEndFacet);
+        }
+        else if (token == "solid")
+        {
+          chunk.Codes.push_back(stlSolid);
+          chunk.SolidNames.emplace_back(arg, lineEnd);
+        }
+        else if (token == "endsolid")
+        {
+          chunk.Codes.push_back(stlEndSolid);
+        }
+        else if (token == "color")
+        {
+          chunk.Codes.push_back(stlColor);
+        }
+        else
+        {
+          chunk.Others.emplace_back(chunk.Codes.size(), token);
+          chunk.Codes.push_back(stlOther);
+        }
+      }
+    }
+  }
+};
+
+// Copy the vertex coordinates of each tokenized chunk into place.
+struct STLGatherCoords
+{
+  const STLAsciiChunk *Chunks;
+  const vtkIdType *CoordOffsets;
+  float *Points;
+
+  void operator()(vtkIdType chunkId, vtkIdType endChunkId)
+  {
+    for ( ; chunkId < endChunkId; ++chunkId)
+    {
+      const std::vector<float>& coords = this->Chunks[chunkId].Coords;
+      std::copy(coords.begin(), coords.end(),
+                this->Points + this->CoordOffsets[chunkId]);
+    }
+  }
+};
+
+// Triangle connectivity for unmerged triangles: triangle t uses points
+// 3t, 3t+1 and 3t+2.
+struct STLFillTriangles
+{
+  vtkIdType *Conn;
+
+  void operator()(vtkIdType tri, vtkIdType endTri)
+  {
+    for ( ; tri < endTri; ++tri)
+    {
+      vtkIdType *c = this->Conn + 4*tri;
+      c[0] = 3;
+      c[1] = 3*tri;
+      c[2] = 3*tri + 1;
+      c[3] = 3*tri + 2;
+    }
+  }
+};
+
+// A point keyed on the bit pattern of its coordinates. Negative zero is
+// folded onto positive zero and a point with a NaN coordinate matches no
+// other point, so that two keys are equal exactly when the coordinates
+// compare equal, as they do in vtkMergePoints.
+template <typename TId>
+struct STLPointTuple
+{
+  vtkTypeUInt32 Key[3];
+  TId Id;
+
+  bool HasNaN() const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      if ((this->Key[i] & 0x7fffffff) > 0x7f800000)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool SameKey(const STLPointTuple& t) const
+  {
+    return this->Key[0] == t.Key[0] && this->Key[1] == t.Key[1] &&
+      this->Key[2] == t.Key[2] && !this->HasNaN();
+  }
+
+  bool operator<(const STLPointTuple& t) const
+  {
+    if (this->Key[0] != t.Key[0])
+    {
+      return this->Key[0] < t.Key[0];
+    }
+    if (this->Key[1] != t.Key[1])
+    {
+      return this->Key[1] < t.Key[1];
+    }
+    if (this->Key[2] != t.Key[2])
+    {
+      return this->Key[2] < t.Key[2];
+    }
+    return this->Id < t.Id;
+  }
+};
+
+template <typename TId>
+struct STLMakeTuples
+{
+  const float *Points;
+  STLPointTuple<TId> *Tuples;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      STLPointTuple<TId>& t = this->Tuples[ptId];
+      for (int i = 0; i < 3; ++i)
+      {
+        float x = this->Points[3*ptId + i];
+        if (x == 0.0f)
+        {
+          x = 0.0f;
+        }
+        memcpy(t.Key + i, &x, sizeof(float));
+      }
+      t.Id = static_cast<TId>(ptId);
+    }
+  }
+};
+
+// After sorting, every run of equal keys is a set of coincident points.
+// Map each point to the first (lowest id) point of its run.
+template <typename TId>
+struct STLFindRepresentatives
+{
+  const STLPointTuple<TId> *Tuples;
+  TId *Rep;
+
+  void operator()(vtkIdType i, vtkIdType end)
+  {
+    vtkIdType runStart = i;
+    while (runStart > 0 && this->Tuples[runStart - 1].SameKey(this->Tuples[i]))
+    {
+      --runStart;
+    }
+    for ( ; i < end; ++i)
+    {
+      if (!this->Tuples[runStart].SameKey(this->Tuples[i]))
+      {
+        runStart = i;
+      }
+      this->Rep[this->Tuples[i].Id] = this->Tuples[runStart].Id;
+    }
+  }
+};
+
+template <typename TId>
+struct STLCopyMergedPoints
+{
+  const float *InPoints;
+  const TId *Rep;
+  const vtkIdType *PointMap;
+  float *OutPoints;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    for ( ; ptId < endPtId; ++ptId)
+    {
+      if (this->Rep[ptId] == static_cast<TId>(ptId))
+      {
+        std::copy(this->InPoints + 3*ptId, this->InPoints + 3*ptId + 3,
+                  this->OutPoints + 3*this->PointMap[ptId]);
+      }
+    }
+  }
+};
+
+struct STLCopyMergedTriangles
+{
+  const vtkIdType *InConn;
+  const vtkIdType *PointMap;
+  const vtkIdType *CellMap;
+  const float *InScalars;
+  vtkIdType *OutConn;
+  float *OutScalars;
+
+  void operator()(vtkIdType tri, vtkIdType endTri)
+  {
+    for ( ; tri < endTri; ++tri)
+    {
+      const vtkIdType newTri = this->CellMap[tri];
+      if (newTri < 0)
+      {
+        continue;
+      }
+      const vtkIdType *c = this->InConn + 4*tri;
+      vtkIdType *outC = this->OutConn + 4*newTri;
+      outC[0] = 3;
+      outC[1] = this->PointMap[c[1]];
+      outC[2] = this->PointMap[c[2]];
+      outC[3] = this->PointMap[c[3]];
+      if (this->InScalars)
+      {
+        this->OutScalars[newTri] = this->InScalars[tri];
+      }
+    }
+  }
+};
+
+// Merge exactly coincident points using a parallel sort. Points are numbered
+// in order of first use and degenerate triangles are dropped, which gives
+// the same result as inserting them into a vtkMergePoints locator.
+template <typename TId>
+void stlMergeExact(vtkPoints *inPts, vtkCellArray *inPolys,
+                   vtkFloatArray *inScalars, vtkPoints *outPts,
+                   vtkCellArray *outPolys, vtkFloatArray *outScalars)
+{
+  const vtkIdType numPts = inPts->GetNumberOfPoints();
+  const vtkIdType numTris = inPolys->GetNumberOfCells();
+  const float *x = static_cast<vtkFloatArray*>(inPts->GetData())->GetPointer(0);
+
+  std::vector<TId> rep(numPts);
+  {
+    std::vector<STLPointTuple<TId> > tuples(numPts);
+    STLMakeTuples<TId> makeTuples = { x, tuples.data() };
+    vtkSMPTools::For(0, numPts, makeTuples);
+    vtkSMPTools::Sort(tuples.begin(), tuples.end());
+    STLFindRepresentatives<TId> findReps = { tuples.data(), rep.data() };
+    vtkSMPTools::For(0, numPts, findReps);
+  }
+
+  // A point's representative never has a larger id, so a single pass in
+  // id order numbers the merged points.
+  std::vector<vtkIdType> pointMap(numPts);
+  vtkIdType numMerged = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    pointMap[ptId] = (rep[ptId] == static_cast<TId>(ptId) ?
+                      numMerged++ : pointMap[rep[ptId]]);
+  }
+
+  const vtkIdType *inConn = inPolys->GetPointer();
+  std::vector<vtkIdType> cellMap(numTris);
+  vtkIdType numKept = 0;
+  for (vtkIdType tri = 0; tri < numTris; ++tri)
+  {
+    const vtkIdType *c = inConn + 4*tri;
+    const vtkIdType n0 = pointMap[c[1]];
+    const vtkIdType n1 = pointMap[c[2]];
+    const vtkIdType n2 = pointMap[c[3]];
+    cellMap[tri] = ((n0 != n1 && n0 != n2 && n1 != n2) ? numKept++ : -1);
+  }
+
+  outPts->SetDataTypeToFloat();
+  outPts->SetNumberOfPoints(numMerged);
+  STLCopyMergedPoints<TId> copyPoints = { x, rep.data(), pointMap.data(),
+    static_cast<vtkFloatArray*>(outPts->GetData())->GetPointer(0) };
+  vtkSMPTools::For(0, numPts, copyPoints);
+
+  float *outS = nullptr;
+  if (inScalars)
+  {
+    outScalars->SetNumberOfValues(numKept);
+    outS = outScalars->GetPointer(0);
+  }
+  STLCopyMergedTriangles copyTris = { inConn, pointMap.data(), cellMap.data(),
+    (inScalars ? inScalars->GetPointer(0) : nullptr),
+    outPolys->WritePointer(numKept, 4*numKept), outS };
+  vtkSMPTools::For(0, numTris, copyTris);
+}
+
+} // end of anonymous namespace
+
 //------------------------------------------------------------------------------
 int vtkSTLReader::RequestData(
   vtkInformation *vtkNotUsed(request),
@@ -128,7 +580,10 @@ int vtkSTLReader::RequestData(
       newScalars = vtkFloatArray::New();
       newScalars->Allocate(5000);
     }
-    if (!this->ReadASCIISTL(fp, newPts.Get(), newPolys.Get(), newScalars))
+    bool status = (this->ParallelParsing ?
+      this->ReadASCIISTLParallel(fp, newPts.Get(), newPolys.Get(), newScalars) :
+      this->ReadASCIISTL(fp, newPts.Get(), newPolys.Get(), newScalars));
+    if (!status)
     {
       fclose(fp);
       if(newScalars)
@@ -154,7 +609,10 @@ int vtkSTLReader::RequestData(
       return 0;
     }
 
-    if (!this->ReadBinarySTL(fp, newPts.Get(), newPolys.Get()))
+    bool status = (this->ParallelParsing ?
+      this->ReadBinarySTLParallel(fp, newPts.Get(), newPolys.Get()) :
+      this->ReadBinarySTL(fp, newPts.Get(), newPolys.Get()));
+    if (!status)
     {
       fclose(fp);
       if(newScalars)
@@ -187,37 +645,54 @@ int vtkSTLReader::RequestData(
       mergedScalars->Allocate(newPolys->GetSize());
     }
 
-    vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
-    if (this->Locator == nullptr)
+    if (this->ParallelMerging && this->Locator == nullptr &&
+        newPts->GetDataType() == VTK_FLOAT)
     {
-      locator.TakeReference(this->NewDefaultLocator());
+      if (newPts->GetNumberOfPoints() <= VTK_INT_MAX)
+      {
+        stlMergeExact<int>(newPts.Get(), newPolys.Get(), newScalars,
+                           mergedPts, mergedPolys, mergedScalars);
+      }
+      else
+      {
+        stlMergeExact<vtkIdType>(newPts.Get(), newPolys.Get(), newScalars,
+                                 mergedPts, mergedPolys, mergedScalars);
+      }
     }
-    locator->InitPointInsertion(mergedPts, newPts->GetBounds());
-
-    int nextCell = 0;
-    vtkIdType *pts = nullptr;
-    vtkIdType npts;
-    for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
+    else
     {
-      vtkIdType nodes[3];
-      for (int i = 0; i < 3; i++)
+      vtkSmartPointer<vtkIncrementalPointLocator> locator = this->Locator;
+      if (this->Locator == nullptr)
       {
-        double x[3];
-        newPts->GetPoint(pts[i], x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        locator.TakeReference(this->NewDefaultLocator());
       }
+      locator->InitPointInsertion(mergedPts, newPts->GetBounds());
 
-      if (nodes[0] != nodes[1] &&
-        nodes[0] != nodes[2] &&
-        nodes[1] != nodes[2])
+      int nextCell = 0;
+      vtkIdType *pts = nullptr;
+      vtkIdType npts;
+      for (newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts);)
       {
-        mergedPolys->InsertNextCell(3, nodes);
-        if (newScalars)
+        vtkIdType nodes[3];
+        for (int i = 0; i < 3; i++)
         {
-          mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          double x[3];
+          newPts->GetPoint(pts[i], x);
+          locator->InsertUniquePoint(x, nodes[i]);
         }
+
+        if (nodes[0] != nodes[1] &&
+          nodes[0] != nodes[2] &&
+          nodes[1] != nodes[2])
+        {
+          mergedPolys->InsertNextCell(3, nodes);
+          if (newScalars)
+          {
+            mergedScalars->InsertNextValue(newScalars->GetValue(nextCell));
+          }
+        }
+        nextCell++;
       }
-      nextCell++;
     }
 
     if (newScalars)
@@ -229,12 +704,18 @@ int vtkSTLReader::RequestData(
       << mergedPts->GetNumberOfPoints() << " points, "
       << mergedPolys->GetNumberOfCells() << " triangles");
   }
+  else
+  {
+    // The unmerged arrays are released below, like the merged ones.
+    mergedPts->Register(this);
+    mergedPolys->Register(this);
+  }
 
   output->SetPoints(mergedPts);
-  mergedPts->Delete();
+  mergedPts->UnRegister(this);
 
   output->SetPolys(mergedPolys);
-  mergedPolys->Delete();
+  mergedPolys->UnRegister(this);
 
   if (mergedScalars)
   {
@@ -254,13 +735,10 @@ int vtkSTLReader::RequestData(
 }
 
 //------------------------------------------------------------------------------
-bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
-                                 vtkCellArray *newPolys)
+// Read the header and the facet count of a binary STL file. The count is
+// corrected with the length of the file.
+bool vtkSTLReader::ReadBinarySTLHeader(FILE *fp, int &numTris)
 {
-  typedef struct { float  n[3], v1[3], v2[3], v3[3]; } facet_t;
-
-  vtkDebugMacro(<< "Reading BINARY STL file");
-
   //  File is read to obtain raw information as well as bounding box
   //
   if (!this->BinaryHeader)
@@ -293,7 +771,7 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
   // Many .stl files contain bogus count.  Hence we will ignore and read
   //   until end of file.
   //
-  int numTris = static_cast<int>(ulint);
+  numTris = static_cast<int>(ulint);
   if (numTris <= 0)
   {
     vtkDebugMacro(<< "Bad binary count: attempting to correct("
@@ -309,6 +787,22 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
   {
     numTris = static_cast<int>(ulFileLength);
   }
+  return true;
+}
+
+//------------------------------------------------------------------------------
+bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
+                                 vtkCellArray *newPolys)
+{
+  typedef struct { float  n[3], v1[3], v2[3], v3[3]; } facet_t;
+
+  vtkDebugMacro(<< "Reading BINARY STL file");
+
+  int numTris;
+  if (!this->ReadBinarySTLHeader(fp, numTris))
+  {
+    return false;
+  }
 
   // now we can allocate the memory we need for this STL file
   newPts->Allocate(numTris * 3);
@@ -358,6 +852,49 @@ bool vtkSTLReader::ReadBinarySTL(FILE *fp, vtkPoints *newPts,
   return true;
 }
 
+//------------------------------------------------------------------------------
+// Read all remaining facets with one read and decode them in parallel. As in
+// ReadBinarySTL() the facet count in the header is ignored and the file is
+// read up to its end.
+bool vtkSTLReader::ReadBinarySTLParallel(FILE *fp, vtkPoints *newPts,
+                                         vtkCellArray *newPolys)
+{
+  vtkDebugMacro(<< "Reading BINARY STL file in parallel");
+
+  int numTris;
+  if (!this->ReadBinarySTLHeader(fp, numTris))
+  {
+    return false;
+  }
+
+  std::vector<char> buffer;
+  if (!vtkReadFileRemainder(fp, buffer))
+  {
+    vtkErrorMacro("STLReader error reading file: " << this->FileName
+      << " Read error while reading facets.");
+    return false;
+  }
+  const size_t size = buffer.size() - 1;
+
+  const vtkIdType numFacets = static_cast<vtkIdType>(size / 50);
+  if (size % 50 >= 48)
+  {
+    vtkErrorMacro("STLReader error reading file: " << this->FileName
+      << " Premature EOF while reading extra junk.");
+    return false;
+  }
+  this->UpdateProgress(0.5);
+
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3*numFacets);
+  STLDecodeBinary decode = { buffer.data(),
+    static_cast<vtkFloatArray*>(newPts->GetData())->GetPointer(0),
+    newPolys->WritePointer(numFacets, 4*numFacets) };
+  vtkSMPTools::For(0, numFacets, decode);
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 
 // Local Functions
@@ -676,6 +1213,258 @@ bool vtkSTLReader::ReadASCIISTL(FILE *fp, vtkPoints *newPts,
 }
 
 
+//------------------------------------------------------------------------------
+// Parallel version of ReadASCIISTL(). The file is tokenized in chunks, then
+// the same state machine is run over the line codes in file order so that
+// the header, solid ids, line numbers and error messages all match the
+// serial reader.
+bool vtkSTLReader::ReadASCIISTLParallel(FILE *fp, vtkPoints *newPts,
+                                        vtkCellArray *newPolys,
+                                        vtkFloatArray *scalars)
+{
+  vtkDebugMacro(<< "Reading ASCII STL file in parallel");
+
+  this->SetHeader(nullptr);
+  this->SetBinaryHeader(nullptr);
+  std::string header;
+
+  std::vector<char> buffer;
+  if (!vtkReadFileRemainder(fp, buffer))
+  {
+    vtkErrorMacro("STLReader: error while reading file " << this->FileName);
+    return false;
+  }
+
+  std::vector<size_t> offsets =
+    stlSplitLines(buffer.data(), buffer.size() - 1, stlChunkSize);
+  const vtkIdType numChunks = static_cast<vtkIdType>(offsets.size()) - 1;
+  std::vector<STLAsciiChunk> chunks(numChunks);
+  STLTokenizeAscii tokenize = { buffer.data(), offsets.data(), chunks.data() };
+  vtkSMPTools::For(0, numChunks, 1, tokenize);
+  std::vector<char>().swap(buffer);
+  this->UpdateProgress(0.5);
+
+  enum StlAsciiScanState
+  {
+    scanSolid = 0,
+    scanFacet,
+    scanLoop,
+    scanVerts,
+    scanEndLoop,
+    scanEndFacet,
+    scanEndSolid
+  };
+
+  static const char* tokens[] = { "", "solid", "color", "facet", "outer",
+    "vertex", "vertex", "endloop", "endfacet", "endsolid" };
+
+  StlAsciiScanState state = scanSolid;
+  int vertOff = 0;
+  int solidId = -1;
+  int lineNum = 0;
+  vtkIdType numTris = 0;
+  std::string errorMessage;
+
+  for (vtkIdType chunkId = 0; chunkId < numChunks && errorMessage.empty(); ++chunkId)
+  {
+    const STLAsciiChunk& chunk = chunks[chunkId];
+    size_t nextSolid = 0;
+    size_t nextOther = 0;
+    for (size_t i = 0; i < chunk.Codes.size() && errorMessage.empty(); ++i)
+    {
+      const int code = chunk.Codes[i];
+      if (code == stlEmpty)
+      {
+        // Increment line-number, but not while still in the header
+        if (lineNum) ++lineNum;
+        continue;
+      }
+      ++lineNum;
+
+      std::string cmd;
+      if (code == stlOther)
+      {
+        while (chunk.Others[nextOther].first < i)
+        {
+          ++nextOther;
+        }
+        cmd = chunk.Others[nextOther].second;
+      }
+      else
+      {
+        cmd = tokens[code];
+      }
+
+      switch (state)
+      {
+        case scanSolid:
+        {
+          if (code == stlSolid)
+          {
+            ++solidId;
+            state = scanFacet;
+            if (!header.empty())
+            {
+              header += "\n";
+            }
+            header += chunk.SolidNames[nextSolid++];
+            // strip end-of-line character from the end
+            while (!header.empty() && (header.back() == '\r' || header.back() == '\n'))
+            {
+              header.pop_back();
+            }
+          }
+          else
+          {
+            errorMessage = stlParseExpected("solid", cmd);
+          }
+          break;
+        }
+        case scanFacet:
+        {
+          if (code == stlColor)
+          {
+            continue;
+          }
+          if (code == stlFacet)
+          {
+            state = scanLoop;
+          }
+          else if (code == stlEndSolid)
+          {
+            state = scanSolid;
+          }
+          else
+          {
+            errorMessage = stlParseExpected("facet", cmd);
+          }
+          break;
+        }
+        case scanLoop:
+        {
+          if (code == stlOuter)
+          {
+            state = scanVerts;
+          }
+          else
+          {
+            errorMessage = stlParseExpected("outer loop", cmd);
+          }
+          break;
+        }
+        case scanVerts:
+        {
+          if (code == stlVertex)
+          {
+            if (++vertOff >= 3)
+            {
+              vertOff = 0;
+              state = scanEndLoop;
+              ++numTris;
+              if (scalars)
+              {
+                scalars->InsertNextValue(solidId);
+              }
+            }
+          }
+          else if (code == stlBadVertex)
+          {
+            errorMessage = "Parse error reading STL vertex";
+          }
+          else
+          {
+            errorMessage = stlParseExpected("vertex", cmd);
+          }
+          break;
+        }
+        case scanEndLoop:
+        {
+          if (code == stlEndLoop)
+          {
+            state = scanEndFacet;
+          }
+          else
+          {
+            errorMessage = stlParseExpected("endloop", cmd);
+          }
+          break;
+        }
+        case scanEndFacet:
+        {
+          if (code == stlEndFacet)
+          {
+            state = scanFacet;
+          }
+          else
+          {
+            errorMessage = stlParseExpected("endfacet", cmd);
+          }
+          break;
+        }
+        case scanEndSolid:
+        {
+          if (code == stlEndSolid)
+          {
+            state = scanSolid;
+          }
+          else
+          {
+            errorMessage = stlParseExpected("endsolid", cmd);
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  if (errorMessage.empty())
+  {
+    switch (state)
+    {
+      case scanSolid:
+      {
+        if (solidId < 0) errorMessage = stlParseEof("solid");
+        break;
+      }
+      case scanFacet:    { errorMessage = stlParseEof("facet"); break; }
+      case scanLoop:     { errorMessage = stlParseEof("outer loop"); break; }
+      case scanVerts:    { errorMessage = stlParseEof("vertex"); break; }
+      case scanEndLoop:  { errorMessage = stlParseEof("endloop"); break; }
+      case scanEndFacet: { errorMessage = stlParseEof("endfacet"); break; }
+      case scanEndSolid: { errorMessage = stlParseEof("endsolid"); break; }
+    }
+  }
+
+  this->SetHeader(header.c_str());
+
+  if (!errorMessage.empty())
+  {
+    vtkErrorMacro("STLReader: error while reading file "
+                  << this->FileName << " at line " << lineNum << ": "
+                  << errorMessage);
+    return false;
+  }
+
+  // Every vertex line has been consumed in order, three per triangle.
+  std::vector<vtkIdType> coordOffsets(numChunks + 1, 0);
+  for (vtkIdType chunkId = 0; chunkId < numChunks; ++chunkId)
+  {
+    coordOffsets[chunkId + 1] = coordOffsets[chunkId] +
+      static_cast<vtkIdType>(chunks[chunkId].Coords.size());
+  }
+
+  newPts->SetDataTypeToFloat();
+  newPts->SetNumberOfPoints(3*numTris);
+  STLGatherCoords gather = { chunks.data(), coordOffsets.data(),
+    static_cast<vtkFloatArray*>(newPts->GetData())->GetPointer(0) };
+  vtkSMPTools::For(0, numChunks, 1, gather);
+
+  STLFillTriangles fill = { newPolys->WritePointer(numTris, 4*numTris) };
+  vtkSMPTools::For(0, numTris, fill);
+
+  return true;
+}
+
 //------------------------------------------------------------------------------
 int vtkSTLReader::GetSTLFileType(const char *filename)
 {
@@ -714,6 +1503,8 @@ void vtkSTLReader::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "Merging: " <<(this->Merging ? "On\n" : "Off\n");
   os << indent << "ScalarTags: " <<(this->ScalarTags ? "On\n" : "Off\n");
+  os << indent << "ParallelParsing: " <<(this->ParallelParsing ? "On\n" : "Off\n");
+  os << indent << "ParallelMerging: " <<(this->ParallelMerging ? "On\n" : "Off\n");
   os << indent << "Locator: ";
   if (this->Locator)
   {
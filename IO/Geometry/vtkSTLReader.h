@@ -27,6 +27,13 @@
  * however, merging requires a large amount of temporary storage since a
  * 3D hash table must be constructed.
  *
+ * Large files can be read faster by turning on ParallelParsing, which loads
+ * the file with a single read and decodes it in chunks using vtkSMPTools,
+ * and ParallelMerging, which replaces the incremental point locator with a
+ * parallel sort on exact point coordinates. Both produce the same output as
+ * the serial reader. As with vtkMergePoints, points with a NaN coordinate
+ * are never merged.
+ *
  * @warning
  * Binary files written on one system may not be readable on other systems.
  * vtkSTLWriter uses VAX or PC byte ordering and swaps bytes on other systems.
@@ -78,6 +85,34 @@ public:
   vtkBooleanMacro(ScalarTags,vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Turn on/off parallel parsing. When on, the whole file is loaded into
+   * memory and decoded in chunks using vtkSMPTools. Binary facets are
+   * converted concurrently; ASCII lines are tokenized concurrently and then
+   * validated in file order, so errors are reported exactly as in the
+   * serial reader. This requires enough memory to hold the file. Off by
+   * default.
+   */
+  vtkSetMacro(ParallelParsing,vtkTypeBool);
+  vtkGetMacro(ParallelParsing,vtkTypeBool);
+  vtkBooleanMacro(ParallelParsing,vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Turn on/off parallel merging of points. When on (and Merging is on),
+   * coincident points are found by sorting the triangle vertices on their
+   * exact coordinates in parallel rather than inserting them one at a time
+   * into an incremental locator. Point ordering and triangles are identical
+   * to what the default vtkMergePoints locator produces. This option is
+   * ignored if a Locator has been specified. Off by default.
+   */
+  vtkSetMacro(ParallelMerging,vtkTypeBool);
+  vtkGetMacro(ParallelMerging,vtkTypeBool);
+  vtkBooleanMacro(ParallelMerging,vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Specify a spatial locator for merging points. By
@@ -123,14 +158,20 @@ protected:
 
   vtkTypeBool Merging;
   vtkTypeBool ScalarTags;
+  vtkTypeBool ParallelParsing;
+  vtkTypeBool ParallelMerging;
   vtkIncrementalPointLocator *Locator;
   char* Header;
   vtkUnsignedCharArray* BinaryHeader;
 
   int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) override;
+  bool ReadBinarySTLHeader(FILE *fp, int &numTris);
   bool ReadBinarySTL(FILE *fp, vtkPoints*, vtkCellArray*);
   bool ReadASCIISTL(FILE *fp, vtkPoints*, vtkCellArray*,
                     vtkFloatArray* scalars=nullptr);
+  bool ReadBinarySTLParallel(FILE *fp, vtkPoints*, vtkCellArray*);
+  bool ReadASCIISTLParallel(FILE *fp, vtkPoints*, vtkCellArray*,
+                            vtkFloatArray* scalars=nullptr);
   int GetSTLFileType(const char *filename);
 private:
   vtkSTLReader(const vtkSTLReader&) = delete;
@@ -0,0 +1,291 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPOpenFOAMReaderConcurrentReads.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write a small decomposed case and check that reading its processor
+// directories concurrently gives the same result as reading them one after
+// the other.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkDirectory.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
+#include "vtkPOpenFOAMReader.h"
+#include "vtkPoints.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+const int NumProcs = 5;
+const int NX = 4;
+const int NY = 3;
+
+void WriteHeader(std::ofstream& os, const char* cls, const char* object)
+{
+  os << "FoamFile\n{\n    version 2.0;\n    format ascii;\n    class "
+     << cls << ";\n    object " << object << ";\n}\n";
+}
+
+int PointId(int i, int j, int k)
+{
+  return i + (NX + 1) * (j + (NY + 1) * k);
+}
+
+void WriteFace(std::ofstream& faces, std::ofstream& owner, int cell,
+  int a, int b, int c, int d)
+{
+  faces << "4(" << a << " " << b << " " << c << " " << d << ")\n";
+  owner << cell << "\n";
+}
+
+// An NX x NY x 1 block of hexahedra shifted along x by the processor number,
+// with all its boundary faces in a single patch.
+bool WriteProcessor(const std::string& caseDir, int proc)
+{
+  const std::string procDir = caseDir + "/processor" + std::to_string(proc);
+  const std::string meshDir = procDir + "/constant/polyMesh";
+  const std::string timeDir = procDir + "/1";
+  if (!vtkDirectory::MakeDirectory(meshDir.c_str()) ||
+    !vtkDirectory::MakeDirectory(timeDir.c_str()))
+  {
+    return false;
+  }
+
+  std::ofstream points((meshDir + "/points").c_str());
+  WriteHeader(points, "vectorField", "points");
+  points << 2 * (NX + 1) * (NY + 1) << "\n(\n";
+  for (int k = 0; k <= 1; ++k)
+  {
+    for (int j = 0; j <= NY; ++j)
+    {
+      for (int i = 0; i <= NX; ++i)
+      {
+        points << "(" << proc * NX + i << " " << j << " " << k << ")\n";
+      }
+    }
+  }
+  points << ")\n";
+
+  const int nInternal = (NX - 1) * NY + NX * (NY - 1);
+  const int nBoundary = 2 * NY + 2 * NX + 2 * NX * NY;
+  std::ofstream faces((meshDir + "/faces").c_str());
+  std::ofstream owner((meshDir + "/owner").c_str());
+  std::ofstream neighbour((meshDir + "/neighbour").c_str());
+  WriteHeader(faces, "faceList", "faces");
+  WriteHeader(owner, "labelList", "owner");
+  WriteHeader(neighbour, "labelList", "neighbour");
+  faces << nInternal + nBoundary << "\n(\n";
+  owner << nInternal + nBoundary << "\n(\n";
+  neighbour << nInternal << "\n(\n";
+
+  // internal faces in upper triangular order
+  for (int j = 0; j < NY; ++j)
+  {
+    for (int i = 0; i < NX; ++i)
+    {
+      const int cell = i + NX * j;
+      if (i < NX - 1)
+      {
+        WriteFace(faces, owner, cell, PointId(i + 1, j, 0),
+          PointId(i + 1, j + 1, 0), PointId(i + 1, j + 1, 1), PointId(i + 1, j, 1));
+        neighbour << cell + 1 << "\n";
+      }
+      if (j < NY - 1)
+      {
+        WriteFace(faces, owner, cell, PointId(i, j + 1, 0),
+          PointId(i, j + 1, 1), PointId(i + 1, j + 1, 1), PointId(i + 1, j + 1, 0));
+        neighbour << cell + NX << "\n";
+      }
+    }
+  }
+  neighbour << ")\n";
+
+  // boundary faces
+  for (int j = 0; j < NY; ++j)
+  {
+    WriteFace(faces, owner, NX * j, PointId(0, j, 0), PointId(0, j, 1),
+      PointId(0, j + 1, 1), PointId(0, j + 1, 0));
+    WriteFace(faces, owner, NX * j + NX - 1, PointId(NX, j, 0),
+      PointId(NX, j + 1, 0), PointId(NX, j + 1, 1), PointId(NX, j, 1));
+  }
+  for (int i = 0; i < NX; ++i)
+  {
+    WriteFace(faces, owner, i, PointId(i, 0, 0), PointId(i + 1, 0, 0),
+      PointId(i + 1, 0, 1), PointId(i, 0, 1));
+    WriteFace(faces, owner, i + NX * (NY - 1), PointId(i, NY, 0),
+      PointId(i, NY, 1), PointId(i + 1, NY, 1), PointId(i + 1, NY, 0));
+  }
+  for (int j = 0; j < NY; ++j)
+  {
+    for (int i = 0; i < NX; ++i)
+    {
+      WriteFace(faces, owner, i + NX * j, PointId(i, j, 0),
+        PointId(i, j + 1, 0), PointId(i + 1, j + 1, 0), PointId(i + 1, j, 0));
+      WriteFace(faces, owner, i + NX * j, PointId(i, j, 1),
+        PointId(i + 1, j, 1), PointId(i + 1, j + 1, 1), PointId(i, j + 1, 1));
+    }
+  }
+  faces << ")\n";
+  owner << ")\n";
+
+  std::ofstream boundary((meshDir + "/boundary").c_str());
+  WriteHeader(boundary, "polyBoundaryMesh", "boundary");
+  boundary << "1\n(\nwalls\n{\n    type wall;\n    nFaces " << nBoundary
+           << ";\n    startFace " << nInternal << ";\n}\n)\n";
+
+  std::ofstream p((timeDir + "/p").c_str());
+  WriteHeader(p, "volScalarField", "p");
+  p << "dimensions [0 2 -2 0 0 0 0];\ninternalField nonuniform List<scalar>\n"
+    << NX * NY << "\n(\n";
+  for (int cell = 0; cell < NX * NY; ++cell)
+  {
+    p << 100 * proc + cell << "\n";
+  }
+  p << ")\n;\nboundaryField\n{\n    walls\n    {\n        type zeroGradient;\n    }\n}\n";
+  return p.good();
+}
+
+bool WriteCase(const std::string& caseDir)
+{
+  if (!vtkDirectory::MakeDirectory((caseDir + "/system").c_str()))
+  {
+    return false;
+  }
+  std::ofstream controlDict((caseDir + "/system/controlDict").c_str());
+  WriteHeader(controlDict, "dictionary", "controlDict");
+  controlDict << "startTime 0;\nendTime 1;\ndeltaT 1;\nwriteInterval 1;\n";
+  controlDict.close();
+  for (int proc = 0; proc < NumProcs; ++proc)
+  {
+    if (!WriteProcessor(caseDir, proc))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+vtkUnstructuredGrid* GetInternalMesh(vtkPOpenFOAMReader* reader)
+{
+  return vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+}
+
+}
+
+int TestPOpenFOAMReaderConcurrentReads(int argc, char* argv[])
+{
+  char* tempDir = vtkTestUtilities::GetArgOrEnvOrDefault(
+    "-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string caseDir = std::string(tempDir) + "/POpenFOAMConcurrentReadsCase";
+  delete[] tempDir;
+
+  if (!WriteCase(caseDir))
+  {
+    std::cerr << "Could not write the case in " << caseDir << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // read with several threads even on a single core
+  vtkMultiThreader::SetGlobalDefaultNumberOfThreads(3);
+
+  const std::string fileName = caseDir + "/system/controlDict";
+  vtkNew<vtkPOpenFOAMReader> serial;
+  serial->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+  serial->SetFileName(fileName.c_str());
+  serial->Update();
+
+  vtkNew<vtkPOpenFOAMReader> concurrent;
+  concurrent->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+  concurrent->ConcurrentReadsOn();
+  concurrent->SetFileName(fileName.c_str());
+  concurrent->Update();
+
+  vtkUnstructuredGrid* a = GetInternalMesh(serial);
+  vtkUnstructuredGrid* b = GetInternalMesh(concurrent);
+  if (!a || !b)
+  {
+    std::cerr << "No internal mesh was read" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (a->GetNumberOfCells() != NumProcs * NX * NY ||
+    b->GetNumberOfCells() != a->GetNumberOfCells() ||
+    b->GetNumberOfPoints() != a->GetNumberOfPoints())
+  {
+    std::cerr << "Expected " << NumProcs * NX * NY << " cells, got "
+              << a->GetNumberOfCells() << " and " << b->GetNumberOfCells() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkDataArray* pA = a->GetCellData()->GetArray("p");
+  vtkDataArray* pB = b->GetCellData()->GetArray("p");
+  if (!pA || !pB)
+  {
+    std::cerr << "Missing cell array p" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType cellId = 0; cellId < a->GetNumberOfCells(); ++cellId)
+  {
+    if (a->GetCellType(cellId) != VTK_HEXAHEDRON ||
+      b->GetCellType(cellId) != VTK_HEXAHEDRON)
+    {
+      std::cerr << "Cell " << cellId << " is not a hexahedron" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (pA->GetTuple1(cellId) != pB->GetTuple1(cellId))
+    {
+      std::cerr << "p differs at cell " << cellId << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < a->GetNumberOfPoints(); ++ptId)
+  {
+    double xA[3], xB[3];
+    a->GetPoint(ptId, xA);
+    b->GetPoint(ptId, xB);
+    if (xA[0] != xB[0] || xA[1] != xB[1] || xA[2] != xB[2])
+    {
+      std::cerr << "Point " << ptId << " differs" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Changing a setting re-executes the child readers concurrently; with
+  // 64 bit labels the cells are built from 64 bit owner and neighbour lists.
+  concurrent->Use64BitLabelsOn();
+  concurrent->Update();
+  b = GetInternalMesh(concurrent);
+  if (!b || b->GetNumberOfCells() != NumProcs * NX * NY)
+  {
+    std::cerr << "Wrong internal mesh after re-execution" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType cellId = 0; cellId < b->GetNumberOfCells(); ++cellId)
+  {
+    if (b->GetCellType(cellId) != VTK_HEXAHEDRON)
+    {
+      std::cerr << "Cell " << cellId << " is not a hexahedron with 64 bit labels"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -29,15 +29,64 @@
 #include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkPOpenFOAMReader);
 vtkCxxSetObjectMacro(vtkPOpenFOAMReader, Controller, vtkMultiProcessController);
 
+namespace
+{
+// Work shared by the threads updating child readers: each thread takes the
+// next reader not yet taken until none is left.
+struct vtkPOpenFOAMReaderJob
+{
+  vtkAlgorithm *Parent;
+  vtkCollection *Readers;
+  int NextReader;
+  int NumberOfUpdatedReaders;
+  vtkMutexLock *Lock;
+};
+
+VTK_THREAD_RETURN_TYPE vtkPOpenFOAMReaderUpdateReaders(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info =
+    static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkPOpenFOAMReaderJob *job = static_cast<vtkPOpenFOAMReaderJob *>(info->UserData);
+  const int nReaders = job->Readers->GetNumberOfItems();
+  for (;;)
+  {
+    job->Lock->Lock();
+    const int readerI = job->NextReader++;
+    job->Lock->Unlock();
+    if (readerI >= nReaders)
+    {
+      break;
+    }
+
+    vtkOpenFOAMReader::SafeDownCast(job->Readers->GetItemAsObject(readerI))->Update();
+
+    job->Lock->Lock();
+    const int nUpdated = ++job->NumberOfUpdatedReaders;
+    job->Lock->Unlock();
+    // thread 0 is the calling thread, the only one allowed to invoke
+    // progress events
+    if (info->ThreadID == 0)
+    {
+      job->Parent->UpdateProgress(static_cast<double>(nUpdated) / nReaders);
+    }
+  }
+  return VTK_THREAD_RETURN_VALUE;
+}
+}
+
 //-----------------------------------------------------------------------------
 vtkPOpenFOAMReader::vtkPOpenFOAMReader()
 {
@@ -55,6 +104,7 @@ vtkPOpenFOAMReader::vtkPOpenFOAMReader()
   }
   this->CaseType = RECONSTRUCTED_CASE;
   this->MTimeOld = 0;
+  this->ConcurrentReads = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -72,6 +122,7 @@ void vtkPOpenFOAMReader::PrintSelf(ostream &os, vtkIndent indent)
   os << indent << "Number of Processes: " << this->NumProcesses << endl;
   os << indent << "Process Id: " << this->ProcessId << endl;
   os << indent << "Controller: " << this->Controller << endl;
+  os << indent << "Concurrent Reads: " << this->ConcurrentReads << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -335,6 +386,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     vtkAppendCompositeDataLeaves *append = vtkAppendCompositeDataLeaves::New();
     // append->AppendFieldDataOn();
 
+    vtkCollection *readers = vtkCollection::New();
     vtkOpenFOAMReader *reader;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
@@ -353,6 +405,7 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
       if (reader->MakeMetaDataAtTimeStep(false))
       {
         append->AddInputConnection(reader->GetOutputPort());
+        readers->AddItem(reader);
       }
     }
 
@@ -365,12 +418,18 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
     }
     else
     {
+      if (this->ConcurrentReads && readers->GetNumberOfItems() > 1)
+      {
+        // up-to-date readers are not executed again by append->Update()
+        this->UpdateReadersConcurrently(readers);
+      }
       // reader->RequestInformation() and RequestData() are called
       // for all reader instances without setting UPDATE_TIME_STEPS
       append->Update();
       output->ShallowCopy(append->GetOutput());
     }
     append->Delete();
+    readers->Delete();
 
     // known issue: output for process without sub-reader will not have CasePath
     output->GetFieldData()->AddArray(this->Superclass::CasePath);
@@ -388,6 +447,31 @@ int vtkPOpenFOAMReader::RequestData(vtkInformation *request,
   return ret;
 }
 
+//-----------------------------------------------------------------------------
+void vtkPOpenFOAMReader::UpdateReadersConcurrently(vtkCollection *readers)
+{
+  vtkPOpenFOAMReaderJob job;
+  job.Parent = this;
+  job.Readers = readers;
+  job.NextReader = 0;
+  job.NumberOfUpdatedReaders = 0;
+  job.Lock = vtkMutexLock::New();
+
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(
+    std::min(threader->GetNumberOfThreads(), readers->GetNumberOfItems()));
+  threader->SetSingleMethod(vtkPOpenFOAMReaderUpdateReaders, &job);
+
+  // the child readers refer to "this" for their settings, which are only
+  // read while they execute; progress is reported from here instead
+  this->Superclass::ChildReadersExecuteConcurrently = true;
+  threader->SingleMethodExecute();
+  this->Superclass::ChildReadersExecuteConcurrently = false;
+
+  threader->Delete();
+  job.Lock->Delete();
+}
+
 //-----------------------------------------------------------------------------
 void vtkPOpenFOAMReader::BroadcastStatus(int &status)
 {
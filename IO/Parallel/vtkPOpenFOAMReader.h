@@ -33,6 +33,7 @@
 #include "vtkIOParallelModule.h" // For export macro
 #include "vtkOpenFOAMReader.h"
 
+class vtkCollection;
 class vtkDataArraySelection;
 class vtkMultiProcessController;
 
@@ -61,6 +62,18 @@ public:
   virtual void SetController(vtkMultiProcessController *);
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   //@}
+  //@{
+  /**
+   * When reading a decomposed case, read the processor directories assigned
+   * to this process concurrently on a pool of threads instead of one after
+   * the other. The processor directories of a case are distributed over the
+   * processes of the controller first, so this mainly speeds up cases with
+   * more processor directories than processes. Off by default.
+   */
+  vtkSetMacro(ConcurrentReads, vtkTypeBool);
+  vtkGetMacro(ConcurrentReads, vtkTypeBool);
+  vtkBooleanMacro(ConcurrentReads, vtkTypeBool);
+  //@}
 
 protected:
   vtkPOpenFOAMReader();
@@ -71,6 +84,13 @@ protected:
   int RequestData(vtkInformation *, vtkInformationVector **,
     vtkInformationVector *) override;
 
+  /**
+   * Update the given child readers on several threads at once.
+   */
+  void UpdateReadersConcurrently(vtkCollection *readers);
+
+  vtkTypeBool ConcurrentReads;
+
 private:
   vtkMultiProcessController *Controller;
   caseType CaseType;